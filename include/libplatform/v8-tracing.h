@@ -114,6 +114,8 @@ class V8_PLATFORM_EXPORT TraceWriter {
   static TraceWriter* CreateJSONTraceWriter(std::ostream& stream);
   static TraceWriter* CreateJSONTraceWriter(std::ostream& stream,
                                             const std::string& tag);
+  // Writes a compact binary encoding of the events, see BinaryTraceWriter.
+  static TraceWriter* CreateBinaryTraceWriter(std::ostream& stream);
 
  private:
   // Disallow copy and assign
@@ -153,11 +155,18 @@ class V8_PLATFORM_EXPORT TraceBuffer {
   virtual TraceObject* AddTraceEvent(uint64_t* handle) = 0;
   virtual TraceObject* GetEventByHandle(uint64_t handle) = 0;
   virtual bool Flush() = 0;
+  // Called by the thread that added the event with {handle} once it has
+  // initialized the event, for buffers that write events concurrently.
+  virtual void CompleteTraceEvent(uint64_t handle) {}
 
   static const size_t kRingBufferChunks = 1024;
 
   static TraceBuffer* CreateTraceBufferRingBuffer(size_t max_chunks,
                                                   TraceWriter* trace_writer);
+  // Creates a buffer that records events into per-thread chunks without
+  // taking a lock and writes them to {trace_writer} on a background thread.
+  static TraceBuffer* CreateThreadLocalTraceBuffer(size_t max_chunks,
+                                                   TraceWriter* trace_writer);
 
  private:
   // Disallow copy and assign
@@ -0,0 +1,167 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_V8_FAST_API_CALLS_H_
+#define V8_V8_FAST_API_CALLS_H_
+
+#include <stdint.h>
+
+#include "v8config.h"  // NOLINT(build/include)
+
+/**
+ * Support for calling embedder C functions directly from optimized code.
+ *
+ * A FunctionTemplate can be created with a CFunction in addition to its
+ * regular FunctionCallback. When TurboFan optimizes a call to the resulting
+ * function and the arguments at the call site match the C signature, it calls
+ * the C function directly instead of going through the FunctionCallbackInfo
+ * and HandleScope setup of the regular callback. In all other cases the
+ * regular callback is used, so both must implement the same behavior.
+ *
+ * The first parameter of the C function is always the receiver of the call
+ * (or the holder, if the template has a signature), passed as ApiObject. The
+ * remaining parameters and the return value can have the following types:
+ *
+ *   int32_t   the argument must be a small integer at runtime
+ *   uint32_t  like int32_t, with ToUint32 semantics for negative values
+ *   double    the argument must be a number at runtime
+ *   void      (return value only) the call returns undefined
+ *
+ * Example:
+ * \code
+ *    int32_t FastMethod(v8::ApiObject receiver, int32_t param) {
+ *      v8::Object* receiver_obj = reinterpret_cast<v8::Object*>(&receiver);
+ *      Wrapper* wrapper = static_cast<Wrapper*>(
+ *          receiver_obj->GetAlignedPointerFromInternalField(0));
+ *      return wrapper->Method(param);
+ *    }
+ *
+ *    void SlowMethod(const v8::FunctionCallbackInfo<v8::Value>& info) { ... }
+ *
+ *    v8::CFunction fast_method = v8::CFunction::Make(FastMethod);
+ *    v8::Local<v8::FunctionTemplate> method_template =
+ *        v8::FunctionTemplate::New(
+ *            isolate, SlowMethod, v8::Local<v8::Value>(),
+ *            v8::Local<v8::Signature>(), 1, v8::ConstructorBehavior::kThrow,
+ *            v8::SideEffectType::kHasSideEffect, &fast_method);
+ * \endcode
+ *
+ * The C function runs without entering V8. It must not allocate on the
+ * JavaScript heap, call into JavaScript, throw exceptions or create handles,
+ * and the receiver must not be used after the function returns.
+ *
+ * Templates with a CFunction can be serialized into a snapshot if both
+ * CFunction::GetAddress() and CFunction::GetTypeInfo() are registered as
+ * external references.
+ *
+ * Signatures with double parameters or return values are only called
+ * directly on platforms whose C calling convention TurboFan supports for
+ * floating point values (currently x64). Elsewhere the regular callback is
+ * used for them.
+ */
+namespace v8 {
+
+/**
+ * The receiver of a fast API call. Can be reinterpreted as v8::Object* (see
+ * above) to read internal fields of the receiver.
+ */
+struct ApiObject {
+  uintptr_t address;
+};
+
+/**
+ * Describes the type of a parameter or the return value of a CFunction.
+ */
+class CTypeInfo {
+ public:
+  enum class Type : char {
+    kVoid,
+    kInt32,
+    kUint32,
+    kFloat64,
+    kV8Value,
+  };
+
+  explicit constexpr CTypeInfo(Type type) : type_(type) {}
+
+  constexpr Type GetType() const { return type_; }
+
+ private:
+  Type type_;
+};
+
+/**
+ * Describes the signature of a CFunction. The receiver is counted as the
+ * first argument.
+ */
+class CFunctionInfo {
+ public:
+  constexpr CFunctionInfo(CTypeInfo return_info, unsigned int arg_count,
+                          const CTypeInfo* arg_info)
+      : return_info_(return_info), arg_count_(arg_count), arg_info_(arg_info) {}
+
+  const CTypeInfo& ReturnInfo() const { return return_info_; }
+  unsigned int ArgumentCount() const { return arg_count_; }
+  const CTypeInfo& ArgumentInfo(unsigned int index) const {
+    return arg_info_[index];
+  }
+
+ private:
+  const CTypeInfo return_info_;
+  const unsigned int arg_count_;
+  const CTypeInfo* arg_info_;
+};
+
+namespace internal {
+
+template <typename T>
+struct GetCType;
+
+#define SPECIALIZE_GET_C_TYPE_FOR(ctype, ctypeinfo)      \
+  template <>                                            \
+  struct GetCType<ctype> {                               \
+    static constexpr CTypeInfo::Type kType =             \
+        CTypeInfo::Type::ctypeinfo;                      \
+  };
+
+SPECIALIZE_GET_C_TYPE_FOR(void, kVoid)
+SPECIALIZE_GET_C_TYPE_FOR(int32_t, kInt32)
+SPECIALIZE_GET_C_TYPE_FOR(uint32_t, kUint32)
+SPECIALIZE_GET_C_TYPE_FOR(double, kFloat64)
+
+#undef SPECIALIZE_GET_C_TYPE_FOR
+
+}  // namespace internal
+
+/**
+ * A C function together with its signature, to be passed to
+ * FunctionTemplate::New. Use CFunction::Make to create instances.
+ */
+class CFunction {
+ public:
+  const void* GetAddress() const { return address_; }
+  const CFunctionInfo* GetTypeInfo() const { return type_info_; }
+
+  template <typename R, typename... Args>
+  static CFunction Make(R (*func)(ApiObject, Args...)) {
+    static const CTypeInfo arg_info[] = {
+        CTypeInfo(CTypeInfo::Type::kV8Value),
+        CTypeInfo(internal::GetCType<Args>::kType)...};
+    static const CFunctionInfo type_info(
+        CTypeInfo(internal::GetCType<R>::kType), sizeof...(Args) + 1,
+        arg_info);
+    return CFunction(reinterpret_cast<const void*>(func), &type_info);
+  }
+
+ private:
+  CFunction(const void* address, const CFunctionInfo* type_info)
+      : address_(address), type_info_(type_info) {}
+
+  const void* address_;
+  const CFunctionInfo* type_info_;
+};
+
+}  // namespace v8
+
+#endif  // V8_V8_FAST_API_CALLS_H_
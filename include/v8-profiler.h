@@ -269,6 +269,83 @@ enum CpuProfilingMode {
   kCallerLineNumbers,
 };
 
+/**
+ * A function that appears in a continuous CPU profile. Corresponds to the
+ * Function message of the pprof profile format.
+ */
+struct ContinuousProfileFunction {
+  /**
+   * Identifies the function in samples. Ids are not reused, but a function
+   * can get a new id after the profile forgot it, see
+   * ContinuousProfilingOptions::memory_budget.
+   */
+  unsigned id;
+  const char* name;
+  const char* resource_name;
+  int script_id;
+  int line_number;
+  int column_number;
+};
+
+/**
+ * A call stack and the number of times it was sampled. Corresponds to the
+ * Sample message of the pprof profile format: the stack is given by the ids
+ * of its functions, starting at the leaf.
+ */
+struct ContinuousProfileSample {
+  const unsigned* function_ids;
+  size_t depth;
+  int64_t count;
+};
+
+/**
+ * The samples collected by a continuous CPU profile since the previous
+ * chunk, aggregated by call stack. A function is described in the first
+ * chunk that has samples referring to it under its id.
+ * Times are in microseconds, with the same starting point as
+ * CpuProfile::GetStartTime.
+ */
+struct ContinuousProfileChunk {
+  int64_t start_time;
+  int64_t end_time;
+  int64_t sampling_interval_us;
+  const ContinuousProfileFunction* new_functions;
+  size_t new_functions_count;
+  const ContinuousProfileSample* samples;
+  size_t samples_count;
+};
+
+/**
+ * Receives the chunks of a continuous CPU profile. OnChunk is called on the
+ * profiler thread, or on the thread that stops continuous profiling, but
+ * never concurrently. The chunk is only valid during the call.
+ */
+class V8_EXPORT ContinuousProfileSink {
+ public:
+  virtual ~ContinuousProfileSink() = default;
+  virtual void OnChunk(const ContinuousProfileChunk& chunk) = 0;
+};
+
+struct ContinuousProfilingOptions {
+  /**
+   * The sampling interval, in microseconds. Only used if the profiler is
+   * not already recording a profile.
+   */
+  int sampling_interval_us = 10000;
+  /**
+   * How often the aggregated samples are passed to the sink, whether or not
+   * there are new samples.
+   */
+  int flush_interval_ms = 10000;
+  /**
+   * The memory, in bytes, that the aggregated samples and the interned
+   * functions may use. The samples are passed to the sink early when they
+   * exceed it. When the functions take more than half of it, they are
+   * forgotten after the next chunk and get new ids when they are seen again.
+   */
+  size_t memory_budget = 1024 * 1024;
+};
+
 /**
  * Interface for controlling CPU profiling. Instance of the
  * profiler can be created using v8::CpuProfiler::New method.
@@ -327,6 +404,22 @@ class V8_EXPORT CpuProfiler {
    */
   CpuProfile* StopProfiling(Local<String> title);
 
+  /**
+   * Starts a continuous profile, which is cheap enough to stay enabled in
+   * production. Instead of building a profile tree, the samples are
+   * aggregated by call stack and periodically passed to the |sink|. Only one
+   * continuous profile can be recorded at a time; returns false if one is
+   * already being recorded.
+   */
+  bool StartContinuousProfiling(
+      ContinuousProfileSink* sink,
+      const ContinuousProfilingOptions& options = ContinuousProfilingOptions());
+
+  /**
+   * Stops the continuous profile, passing the remaining samples to its sink.
+   */
+  void StopContinuousProfiling();
+
   /**
    * Force collection of a sample. Must be called on the VM thread.
    * Recording the forced sample does not contribute to the aggregated
@@ -631,6 +724,56 @@ class V8_EXPORT AllocationProfile {
   static const int kNoColumnNumberInfo = Message::kNoColumnInfo;
 };
 
+/**
+ * The sampled allocations of one call stack and object type. Corresponds to
+ * the Sample message of a pprof heap profile: the stack is given by the ids
+ * of its functions, starting at the leaf. The counts and sizes are estimates
+ * of all allocations, scaled up from the samples.
+ */
+struct SampledAllocationSite {
+  /** Identifies the site in later chunks. */
+  unsigned id;
+  const unsigned* function_ids;
+  size_t depth;
+  /**
+   * The constructor name for JS objects, and the kind of object, e.g.
+   * "(string)", for the others.
+   */
+  const char* type_name;
+  /** The objects allocated since the profile started. */
+  int64_t allocated_count;
+  int64_t allocated_bytes;
+  /** The objects that were still alive at the most recent GC. */
+  int64_t live_count;
+  int64_t live_bytes;
+};
+
+/**
+ * The sites of a sampling heap profile whose counts changed since the
+ * previous chunk. As in ContinuousProfileChunk, the functions of a profile
+ * are only described once, in the first chunk that has sites referring to
+ * them.
+ */
+struct SampledAllocationsChunk {
+  /** The average number of bytes allocated between two samples. */
+  int64_t sampling_interval;
+  const ContinuousProfileFunction* new_functions;
+  size_t new_functions_count;
+  const SampledAllocationSite* sites;
+  size_t sites_count;
+};
+
+/**
+ * Receives the chunks of a sampling heap profile, see
+ * HeapProfiler::CollectSampledAllocations. The chunk is only valid during
+ * the call.
+ */
+class V8_EXPORT SampledAllocationsSink {
+ public:
+  virtual ~SampledAllocationsSink() = default;
+  virtual void OnChunk(const SampledAllocationsChunk& chunk) = 0;
+};
+
 /**
  * An object graph consisting of embedder objects and V8 objects.
  * Edges of the graph are strong references between the objects.
@@ -706,6 +849,13 @@ class V8_EXPORT HeapProfiler {
   enum SamplingFlags {
     kSamplingNoFlags = 0,
     kSamplingForceGC = 1 << 0,
+    /**
+     * Aggregates the samples by call stack and object type, and tracks
+     * which sampled objects are alive without a global handle per sample.
+     * The profile is retrieved with CollectSampledAllocations instead of
+     * GetAllocationProfile.
+     */
+    kSamplingAggregateStacks = 1 << 1,
   };
 
   typedef std::unordered_set<const v8::PersistentBase<v8::Value>*>
@@ -803,6 +953,25 @@ class V8_EXPORT HeapProfiler {
       ActivityControl* control = NULL,
       ObjectNameResolver* global_object_name_resolver = NULL);
 
+  /**
+   * Takes a heap snapshot and writes it to |stream| in the format of
+   * HeapSnapshot::Serialize, without keeping the snapshot in memory. The
+   * memory needed is a small fraction of the heap size, at the cost of
+   * traversing the heap several times. Unlike TakeHeapSnapshot, unreachable
+   * objects are included, and the node ids of objects that no previous
+   * snapshot has seen are only valid within the streamed snapshot.
+   *
+   * Returns false if the snapshot was aborted through |control| or
+   * |stream|, in which case the stream is left incomplete.
+   *
+   * The methods of |stream| and |control| are called while the heap is being
+   * traversed, when allocation on the V8 heap is not allowed. They must not
+   * allocate JavaScript objects or call into V8 in any other way.
+   */
+  bool StreamHeapSnapshot(
+      OutputStream* stream, ActivityControl* control = NULL,
+      ObjectNameResolver* global_object_name_resolver = NULL);
+
   /**
    * Starts tracking of heap objects population statistics. After calling
    * this method, all heap objects relocations done by the garbage collector
@@ -877,10 +1046,18 @@ class V8_EXPORT HeapProfiler {
    * Returns the sampled profile of allocations allocated (and still live) since
    * StartSamplingHeapProfiler was called. The ownership of the pointer is
    * transferred to the caller. Returns nullptr if sampling heap profiler is not
-   * active.
+   * active, or if it aggregates stacks (see kSamplingAggregateStacks).
    */
   AllocationProfile* GetAllocationProfile();
 
+  /**
+   * Passes the sites of the sampling heap profile whose counts changed since
+   * the previous call to the |sink|. Only available if the sampling heap
+   * profiler was started with kSamplingAggregateStacks; returns false
+   * otherwise.
+   */
+  bool CollectSampledAllocations(SampledAllocationsSink* sink);
+
   /**
    * Deletes all snapshots taken. All previously returned pointers to
    * snapshots and their contents become invalid after this call.
@@ -70,6 +70,7 @@ class BigInt;
 class BigIntObject;
 class Boolean;
 class BooleanObject;
+class CFunction;
 class Context;
 class Data;
 class Date;
@@ -5853,13 +5854,21 @@ typedef bool (*AccessCheckCallback)(Local<Context> accessing_context,
  */
 class V8_EXPORT FunctionTemplate : public Template {
  public:
-  /** Creates a function template.*/
+  /**
+   * Creates a function template.
+   *
+   * If |c_function| is provided, optimized code may call it directly instead
+   * of |callback| when the arguments match its signature. See
+   * v8-fast-api-calls.h for the restrictions on such functions. The
+   * |callback| must be provided as well and is used in all other cases.
+   */
   static Local<FunctionTemplate> New(
       Isolate* isolate, FunctionCallback callback = 0,
       Local<Value> data = Local<Value>(),
       Local<Signature> signature = Local<Signature>(), int length = 0,
       ConstructorBehavior behavior = ConstructorBehavior::kAllow,
-      SideEffectType side_effect_type = SideEffectType::kHasSideEffect);
+      SideEffectType side_effect_type = SideEffectType::kHasSideEffect,
+      const CFunction* c_function = nullptr);
 
   /** Get a template included in the snapshot by index. */
   static MaybeLocal<FunctionTemplate> FromSnapshot(Isolate* isolate,
@@ -8096,6 +8105,16 @@ class V8_EXPORT Isolate {
    */
   void RunMicrotasks();
 
+  /**
+   * Runs the Microtask Work Queue until it is empty or until roughly
+   * |time_budget_in_ms| milliseconds have passed. Microtasks run in small
+   * batches and the time is checked between batches, so at least one batch
+   * runs even with a budget of zero. Returns true if the queue is empty.
+   * The MicrotasksCompletedCallbacks are only called once the queue is empty.
+   * Any exceptions thrown by microtask callbacks are swallowed.
+   */
+  bool RunMicrotasks(double time_budget_in_ms);
+
   /**
    * Enqueues the callback to the Microtask Work Queue
    */
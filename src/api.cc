@@ -11,6 +11,7 @@
 
 #include "src/api-inl.h"
 
+#include "include/v8-fast-api-calls.h"
 #include "include/v8-profiler.h"
 #include "include/v8-testing.h"
 #include "include/v8-util.h"
@@ -1500,7 +1501,8 @@ static Local<FunctionTemplate> FunctionTemplateNew(
     i::Isolate* isolate, FunctionCallback callback, v8::Local<Value> data,
     v8::Local<Signature> signature, int length, bool do_not_cache,
     v8::Local<Private> cached_property_name = v8::Local<Private>(),
-    SideEffectType side_effect_type = SideEffectType::kHasSideEffect) {
+    SideEffectType side_effect_type = SideEffectType::kHasSideEffect,
+    const CFunction* c_function = nullptr) {
   i::Handle<i::Struct> struct_obj =
       isolate->factory()->NewStruct(i::FUNCTION_TEMPLATE_INFO_TYPE, i::TENURED);
   i::Handle<i::FunctionTemplateInfo> obj =
@@ -1515,6 +1517,12 @@ static Local<FunctionTemplate> FunctionTemplateNew(
   if (callback != 0) {
     Utils::ToLocal(obj)->SetCallHandler(callback, data, side_effect_type);
   }
+  if (c_function != nullptr) {
+    Utils::ApiCheck(callback != 0, "v8::FunctionTemplate::New",
+                    "A C function requires a regular callback as well");
+    obj->set_c_function(*FromCData(isolate, c_function->GetAddress()));
+    obj->set_c_signature(*FromCData(isolate, c_function->GetTypeInfo()));
+  }
   obj->set_length(length);
   obj->set_undetectable(false);
   obj->set_needs_access_check(false);
@@ -1532,14 +1540,15 @@ static Local<FunctionTemplate> FunctionTemplateNew(
 Local<FunctionTemplate> FunctionTemplate::New(
     Isolate* isolate, FunctionCallback callback, v8::Local<Value> data,
     v8::Local<Signature> signature, int length, ConstructorBehavior behavior,
-    SideEffectType side_effect_type) {
+    SideEffectType side_effect_type, const CFunction* c_function) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(isolate);
   // Changes to the environment cannot be captured in the snapshot. Expect no
   // function templates when the isolate is created for serialization.
   LOG_API(i_isolate, FunctionTemplate, New);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
-  auto templ = FunctionTemplateNew(i_isolate, callback, data, signature, length,
-                                   false, Local<Private>(), side_effect_type);
+  auto templ =
+      FunctionTemplateNew(i_isolate, callback, data, signature, length, false,
+                          Local<Private>(), side_effect_type, c_function);
   if (behavior == ConstructorBehavior::kThrow) templ->RemovePrototype();
   return templ;
 }
@@ -7149,6 +7158,9 @@ void v8::Date::DateTimeConfigurationChangeNotification(Isolate* isolate) {
   LOG_API(i_isolate, Date, DateTimeConfigurationChangeNotification);
   ENTER_V8_NO_SCRIPT_NO_EXCEPTION(i_isolate);
   i_isolate->date_cache()->ResetDateCache();
+#ifdef V8_INTL_SUPPORT
+  i_isolate->ClearCachedICUObjects();
+#endif  // V8_INTL_SUPPORT
   if (!i_isolate->eternal_handles()->Exists(
           i::EternalHandles::DATE_CACHE_VERSION)) {
     return;
@@ -8858,6 +8870,11 @@ void Isolate::RunMicrotasks() {
   reinterpret_cast<i::Isolate*>(this)->RunMicrotasks();
 }
 
+bool Isolate::RunMicrotasks(double time_budget_in_ms) {
+  DCHECK_NE(MicrotasksPolicy::kScoped, GetMicrotasksPolicy());
+  return reinterpret_cast<i::Isolate*>(this)->RunMicrotasks(time_budget_in_ms);
+}
+
 void Isolate::EnqueueMicrotask(Local<Function> function) {
   i::Isolate* isolate = reinterpret_cast<i::Isolate*>(this);
   i::Handle<i::CallableTask> microtask = isolate->factory()->NewCallableTask(
@@ -8998,7 +9015,6 @@ void Isolate::MemoryPressureNotification(MemoryPressureLevel level) {
           ? isolate->thread_manager()->IsLockedByCurrentThread()
           : i::ThreadId::Current().Equals(isolate->thread_id());
   isolate->heap()->MemoryPressureNotification(level, on_isolate_thread);
-  isolate->allocator()->MemoryPressureNotification(level);
   isolate->compiler_dispatcher()->MemoryPressureNotification(level,
                                                              on_isolate_thread);
 }
@@ -10381,6 +10397,18 @@ CpuProfile* CpuProfiler::StopProfiling(Local<String> title) {
           *Utils::OpenHandle(*title)));
 }
 
+bool CpuProfiler::StartContinuousProfiling(
+    ContinuousProfileSink* sink, const ContinuousProfilingOptions& options) {
+  DCHECK_NOT_NULL(sink);
+  DCHECK_GT(options.sampling_interval_us, 0);
+  return reinterpret_cast<i::CpuProfiler*>(this)->StartContinuousProfiling(
+      sink, options);
+}
+
+void CpuProfiler::StopContinuousProfiling() {
+  reinterpret_cast<i::CpuProfiler*>(this)->StopContinuousProfiling();
+}
+
 
 void CpuProfiler::SetIdle(bool is_idle) {
   i::CpuProfiler* profiler = reinterpret_cast<i::CpuProfiler*>(this);
@@ -10639,6 +10667,14 @@ const HeapSnapshot* HeapProfiler::TakeHeapSnapshot(
 }
 
 
+bool HeapProfiler::StreamHeapSnapshot(OutputStream* stream,
+                                      ActivityControl* control,
+                                      ObjectNameResolver* resolver) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->StreamSnapshot(
+      stream, control, resolver);
+}
+
+
 void HeapProfiler::StartTrackingHeapObjects(bool track_allocations) {
   reinterpret_cast<i::HeapProfiler*>(this)->StartHeapObjectsTracking(
       track_allocations);
@@ -10673,6 +10709,11 @@ AllocationProfile* HeapProfiler::GetAllocationProfile() {
   return reinterpret_cast<i::HeapProfiler*>(this)->GetAllocationProfile();
 }
 
+bool HeapProfiler::CollectSampledAllocations(SampledAllocationsSink* sink) {
+  return reinterpret_cast<i::HeapProfiler*>(this)->CollectSampledAllocations(
+      sink);
+}
+
 
 void HeapProfiler::DeleteAllHeapSnapshots() {
   reinterpret_cast<i::HeapProfiler*>(this)->DeleteAllSnapshots();
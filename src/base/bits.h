@@ -287,6 +287,31 @@ inline uint32_t UnsignedMod32(uint32_t lhs, uint32_t rhs) {
 }
 
 
+// UnsignedMul128(lhs, rhs, high) computes the full 128-bit product of |lhs|
+// and |rhs|, stores the most significant 64 bits into the variable pointed to
+// by |high| and returns the least significant 64 bits.
+inline uint64_t UnsignedMul128(uint64_t lhs, uint64_t rhs, uint64_t* high) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+  *high = static_cast<uint64_t>(product >> 64);
+  return static_cast<uint64_t>(product);
+#else
+  uint64_t lhs_low = lhs & 0xFFFFFFFFu;
+  uint64_t lhs_high = lhs >> 32;
+  uint64_t rhs_low = rhs & 0xFFFFFFFFu;
+  uint64_t rhs_high = rhs >> 32;
+  uint64_t low_low = lhs_low * rhs_low;
+  uint64_t low_high = lhs_low * rhs_high;
+  uint64_t high_low = lhs_high * rhs_low;
+  uint64_t high_high = lhs_high * rhs_high;
+  uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFu) +
+                    (high_low & 0xFFFFFFFFu);
+  *high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+  return (middle << 32) | (low_low & 0xFFFFFFFFu);
+#endif
+}
+
+
 // Clamp |value| on overflow and underflow conditions.
 V8_BASE_EXPORT int64_t
 FromCheckedNumeric(const internal::CheckedNumeric<int64_t> value);
@@ -1338,7 +1338,41 @@ void Thread::Join() {
 }
 
 
-Thread::LocalStorageKey Thread::CreateThreadLocalKey() {
+namespace {
+
+// Keys with a destructor are fiber-local storage indices, which Windows
+// calls back for when a thread exits. They are tagged to tell them apart from
+// thread-local storage indices.
+const Thread::LocalStorageKey kFlsKeyTag = 1 << 30;
+
+#ifndef FLS_MAXIMUM_AVAILABLE
+#define FLS_MAXIMUM_AVAILABLE 128
+#endif
+
+Thread::LocalStorageDestructor fls_destructors[FLS_MAXIMUM_AVAILABLE];
+
+// The fiber-local value, which the callback needs the destructor with.
+struct FlsValue {
+  Thread::LocalStorageDestructor destructor;
+  void* value;
+};
+
+void NTAPI FlsCallback(void* data) {
+  FlsValue* fls_value = static_cast<FlsValue*>(data);
+  if (fls_value->value != nullptr) fls_value->destructor(fls_value->value);
+  delete fls_value;
+}
+
+}  // namespace
+
+Thread::LocalStorageKey Thread::CreateThreadLocalKey(
+    LocalStorageDestructor destructor) {
+  if (destructor != nullptr) {
+    DWORD index = FlsAlloc(FlsCallback);
+    CHECK(index != FLS_OUT_OF_INDEXES && index < FLS_MAXIMUM_AVAILABLE);
+    fls_destructors[index] = destructor;
+    return static_cast<LocalStorageKey>(index) | kFlsKeyTag;
+  }
   DWORD result = TlsAlloc();
   DCHECK(result != TLS_OUT_OF_INDEXES);
   return static_cast<LocalStorageKey>(result);
@@ -1346,18 +1380,38 @@ Thread::LocalStorageKey Thread::CreateThreadLocalKey() {
 
 
 void Thread::DeleteThreadLocalKey(LocalStorageKey key) {
-  BOOL result = TlsFree(static_cast<DWORD>(key));
+  BOOL result = (key & kFlsKeyTag)
+                    ? FlsFree(static_cast<DWORD>(key & ~kFlsKeyTag))
+                    : TlsFree(static_cast<DWORD>(key));
   USE(result);
   DCHECK(result);
 }
 
 
 void* Thread::GetThreadLocal(LocalStorageKey key) {
+  if (key & kFlsKeyTag) {
+    FlsValue* fls_value = static_cast<FlsValue*>(
+        FlsGetValue(static_cast<DWORD>(key & ~kFlsKeyTag)));
+    return fls_value != nullptr ? fls_value->value : nullptr;
+  }
   return TlsGetValue(static_cast<DWORD>(key));
 }
 
 
 void Thread::SetThreadLocal(LocalStorageKey key, void* value) {
+  if (key & kFlsKeyTag) {
+    DWORD index = static_cast<DWORD>(key & ~kFlsKeyTag);
+    FlsValue* fls_value = static_cast<FlsValue*>(FlsGetValue(index));
+    if (fls_value == nullptr) {
+      if (value == nullptr) return;
+      fls_value = new FlsValue{fls_destructors[index], value};
+      BOOL result = FlsSetValue(index, fls_value);
+      USE(result);
+      DCHECK(result);
+    }
+    fls_value->value = value;
+    return;
+  }
   BOOL result = TlsSetValue(static_cast<DWORD>(key), value);
   USE(result);
   DCHECK(result);
@@ -306,6 +306,8 @@ class V8_BASE_EXPORT Thread {
  public:
   // Opaque data type for thread-local storage keys.
   typedef int32_t LocalStorageKey;
+  // Called with the value of a thread-local storage key when a thread exits.
+  typedef void (*LocalStorageDestructor)(void* value);
 
   class Options {
    public:
@@ -347,8 +349,12 @@ class V8_BASE_EXPORT Thread {
   // Abstract method for run handler.
   virtual void Run() = 0;
 
-  // Thread-local storage.
-  static LocalStorageKey CreateThreadLocalKey();
+  // Thread-local storage. If |destructor| is given, it is called on a thread
+  // that exits while its value of the key is not null. On Windows, it is also
+  // called for the remaining values when the key is deleted, and the key
+  // cannot be used with GetExistingThreadLocal().
+  static LocalStorageKey CreateThreadLocalKey(
+      LocalStorageDestructor destructor = nullptr);
   static void DeleteThreadLocalKey(LocalStorageKey key);
   static void* GetThreadLocal(LocalStorageKey key);
   static int GetThreadLocalInt(LocalStorageKey key) {
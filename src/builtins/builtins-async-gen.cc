@@ -33,10 +33,8 @@ Node* AsyncBuiltinsAssembler::Await(
   Node* const native_context = LoadNativeContext(context);
 
   static const int kWrappedPromiseOffset = FixedArray::SizeFor(context_length);
-  static const int kThrowawayPromiseOffset =
-      kWrappedPromiseOffset + JSPromise::kSizeWithEmbedderFields;
   static const int kResolveClosureOffset =
-      kThrowawayPromiseOffset + JSPromise::kSizeWithEmbedderFields;
+      kWrappedPromiseOffset + JSPromise::kSizeWithEmbedderFields;
   static const int kRejectClosureOffset =
       kResolveClosureOffset + JSFunction::kSizeWithoutPrototype;
   static const int kTotalSize =
@@ -71,16 +69,6 @@ Node* AsyncBuiltinsAssembler::Await(
     PromiseInit(wrapped_value);
   }
 
-  Node* const throwaway = InnerAllocate(base, kThrowawayPromiseOffset);
-  {
-    // Initialize throwawayPromise
-    StoreMapNoWriteBarrier(throwaway, promise_map);
-    InitializeJSObjectFromMap(
-        throwaway, promise_map,
-        IntPtrConstant(JSPromise::kSizeWithEmbedderFields));
-    PromiseInit(throwaway);
-  }
-
   Node* const on_resolve = InnerAllocate(base, kResolveClosureOffset);
   {
     // Initialize resolve handler
@@ -95,54 +83,15 @@ Node* AsyncBuiltinsAssembler::Await(
                             on_reject_context_index);
   }
 
-  {
-    // Add PromiseHooks if needed
-    Label next(this);
-    GotoIfNot(IsPromiseHookEnabledOrHasAsyncEventDelegate(), &next);
-    CallRuntime(Runtime::kAwaitPromisesInit, context, wrapped_value,
-                outer_promise, throwaway);
-    Goto(&next);
-    BIND(&next);
-  }
+  Node* const throwaway =
+      AllocateThrowawayPromiseIfNeeded(context, wrapped_value, outer_promise);
 
   // Perform ! Call(promiseCapability.[[Resolve]], undefined, « promise »).
   CallBuiltin(Builtins::kResolvePromise, context, wrapped_value, value);
 
-  // The Promise will be thrown away and not handled, but it shouldn't trigger
-  // unhandled reject events as its work is done
-  PromiseSetHasHandler(throwaway);
-
-  Label do_perform_promise_then(this);
-  GotoIfNot(IsDebugActive(), &do_perform_promise_then);
-  {
-    Label common(this);
-    GotoIf(TaggedIsSmi(value), &common);
-    GotoIfNot(HasInstanceType(value, JS_PROMISE_TYPE), &common);
-    {
-      // Mark the reject handler callback to be a forwarding edge, rather
-      // than a meaningful catch handler
-      Node* const key =
-          HeapConstant(factory()->promise_forwarding_handler_symbol());
-      SetPropertyStrict(CAST(context), CAST(on_reject), CAST(key),
-                        TrueConstant());
-
-      GotoIf(IsFalse(is_predicted_as_caught), &common);
-      PromiseSetHandledHint(value);
-    }
-
-    Goto(&common);
-    BIND(&common);
-    // Mark the dependency to outer Promise in case the throwaway Promise is
-    // found on the Promise stack
-    CSA_SLOW_ASSERT(this, HasInstanceType(outer_promise, JS_PROMISE_TYPE));
-
-    Node* const key = HeapConstant(factory()->promise_handled_by_symbol());
-    SetPropertyStrict(CAST(context), CAST(throwaway), CAST(key),
-                      CAST(outer_promise));
-  }
+  SetupDebuggerForAwait(context, value, outer_promise, throwaway, on_reject,
+                        is_predicted_as_caught);
 
-  Goto(&do_perform_promise_then);
-  BIND(&do_perform_promise_then);
   return CallBuiltin(Builtins::kPerformPromiseThen, context, wrapped_value,
                      on_resolve, on_reject, throwaway);
 }
@@ -160,16 +109,15 @@ Node* AsyncBuiltinsAssembler::AwaitOptimized(
   CSA_ASSERT(this, IsFunctionWithPrototypeSlotMap(LoadMap(promise_fun)));
   CSA_ASSERT(this, IsConstructor(promise_fun));
 
-  static const int kThrowawayPromiseOffset =
-      FixedArray::SizeFor(context_length);
-  static const int kResolveClosureOffset =
-      kThrowawayPromiseOffset + JSPromise::kSizeWithEmbedderFields;
+  static const int kResolveClosureOffset = FixedArray::SizeFor(context_length);
   static const int kRejectClosureOffset =
       kResolveClosureOffset + JSFunction::kSizeWithoutPrototype;
   static const int kTotalSize =
       kRejectClosureOffset + JSFunction::kSizeWithoutPrototype;
 
   // 2. Let promise be ? PromiseResolve(« promise »).
+  // This returns {value} itself if it's a native, unmodified JSPromise, in
+  // which case the async function resumes one tick after {value} settles.
   Node* const promise =
       CallBuiltin(Builtins::kPromiseResolve, context, promise_fun, value);
 
@@ -181,23 +129,6 @@ Node* AsyncBuiltinsAssembler::AwaitOptimized(
     init_closure_context(closure_context);
   }
 
-  Node* const promise_map =
-      LoadObjectField(promise_fun, JSFunction::kPrototypeOrInitialMapOffset);
-  // Assert that the JSPromise map has an instance size is
-  // JSPromise::kSizeWithEmbedderFields.
-  CSA_ASSERT(this, WordEqual(LoadMapInstanceSizeInWords(promise_map),
-                             IntPtrConstant(JSPromise::kSizeWithEmbedderFields /
-                                            kPointerSize)));
-  Node* const throwaway = InnerAllocate(base, kThrowawayPromiseOffset);
-  {
-    // Initialize throwawayPromise
-    StoreMapNoWriteBarrier(throwaway, promise_map);
-    InitializeJSObjectFromMap(
-        throwaway, promise_map,
-        IntPtrConstant(JSPromise::kSizeWithEmbedderFields));
-    PromiseInit(throwaway);
-  }
-
   Node* const on_resolve = InnerAllocate(base, kResolveClosureOffset);
   {
     // Initialize resolve handler
@@ -212,22 +143,55 @@ Node* AsyncBuiltinsAssembler::AwaitOptimized(
                             on_reject_context_index);
   }
 
+  Node* const throwaway =
+      AllocateThrowawayPromiseIfNeeded(context, promise, outer_promise);
+
+  SetupDebuggerForAwait(context, value, outer_promise, throwaway, on_reject,
+                        is_predicted_as_caught);
+
+  return CallBuiltin(Builtins::kPerformPromiseThen, native_context, promise,
+                     on_resolve, on_reject, throwaway);
+}
+
+Node* AsyncBuiltinsAssembler::AllocateThrowawayPromiseIfNeeded(
+    Node* context, Node* promise, Node* outer_promise) {
+  // The throwaway promise that the spec uses as the result of the
+  // PerformPromiseThen in Await is only observable through the promise
+  // hooks and the debugger, so don't bother allocating it otherwise.
+  VARIABLE(var_throwaway, MachineRepresentation::kTagged, UndefinedConstant());
+  Label if_needed(this, Label::kDeferred), done(this);
+  GotoIf(IsDebugActive(), &if_needed);
+  Branch(IsPromiseHookEnabledOrHasAsyncEventDelegate(), &if_needed, &done);
+
+  BIND(&if_needed);
   {
+    Node* const throwaway = AllocateJSPromise(context);
+    PromiseInit(throwaway);
+    var_throwaway.Bind(throwaway);
+
+    // The Promise will be thrown away and not handled, but it shouldn't
+    // trigger unhandled reject events as its work is done
+    PromiseSetHasHandler(throwaway);
+
     // Add PromiseHooks if needed
-    Label next(this);
-    GotoIfNot(IsPromiseHookEnabledOrHasAsyncEventDelegate(), &next);
+    GotoIfNot(IsPromiseHookEnabledOrHasAsyncEventDelegate(), &done);
     CallRuntime(Runtime::kAwaitPromisesInit, context, promise, outer_promise,
                 throwaway);
-    Goto(&next);
-    BIND(&next);
+    Goto(&done);
   }
 
-  // The Promise will be thrown away and not handled, but it shouldn't trigger
-  // unhandled reject events as its work is done
-  PromiseSetHasHandler(throwaway);
+  BIND(&done);
+  return var_throwaway.value();
+}
 
-  Label do_perform_promise_then(this);
-  GotoIfNot(IsDebugActive(), &do_perform_promise_then);
+void AsyncBuiltinsAssembler::SetupDebuggerForAwait(
+    Node* context, Node* value, Node* outer_promise, Node* throwaway,
+    Node* on_reject, Node* is_predicted_as_caught) {
+  Label done(this);
+  GotoIfNot(IsDebugActive(), &done);
+  // The debugger might have been activated after the throwaway promise was
+  // skipped.
+  GotoIf(IsUndefined(throwaway), &done);
   {
     Label common(this);
     GotoIf(TaggedIsSmi(value), &common);
@@ -255,10 +219,8 @@ Node* AsyncBuiltinsAssembler::AwaitOptimized(
                       CAST(outer_promise));
   }
 
-  Goto(&do_perform_promise_then);
-  BIND(&do_perform_promise_then);
-  return CallBuiltin(Builtins::kPerformPromiseThen, native_context, promise,
-                     on_resolve, on_reject, throwaway);
+  Goto(&done);
+  BIND(&done);
 }
 
 void AsyncBuiltinsAssembler::InitializeNativeClosure(Node* context,
@@ -15,6 +15,13 @@ class AsyncBuiltinsAssembler : public PromiseBuiltinsAssembler {
   explicit AsyncBuiltinsAssembler(compiler::CodeAssemblerState* state)
       : PromiseBuiltinsAssembler(state) {}
 
+  // Describe fields of Context associated with the AsyncFunctionAwait resume
+  // closures. TurboFan allocates these contexts too, when it inlines an await.
+  enum AwaitContextSlot {
+    kAwaitGeneratorSlot = Context::MIN_CONTEXT_SLOTS,
+    kAwaitContextLength
+  };
+
  protected:
   typedef std::function<void(Node*)> ContextInitializer;
 
@@ -84,6 +91,13 @@ class AsyncBuiltinsAssembler : public PromiseBuiltinsAssembler {
  private:
   void InitializeNativeClosure(Node* context, Node* native_context,
                                Node* function, Node* context_index);
+  // Returns the throwaway promise for an await on {promise} if the promise
+  // hooks or the debugger need to see it, and undefined otherwise.
+  Node* AllocateThrowawayPromiseIfNeeded(Node* context, Node* promise,
+                                         Node* outer_promise);
+  void SetupDebuggerForAwait(Node* context, Node* value, Node* outer_promise,
+                             Node* throwaway, Node* on_reject,
+                             Node* is_predicted_as_caught);
   Node* AllocateAsyncIteratorValueUnwrapContext(Node* native_context,
                                                 Node* done);
 };
@@ -713,6 +713,12 @@ class CollectionsBuiltinsAssembler : public BaseCollectionsAssembler {
                                       Label* if_not_found);
 
   Node* NormalizeNumberKey(Node* key);
+  // Returns the first unused bucket in the probe sequence for {hash}.
+  template <typename CollectionType>
+  Node* FindUnusedOrderedHashTableBucket(TNode<CollectionType> const table,
+                                         Node* const hash,
+                                         Node* const number_of_buckets);
+
   void StoreOrderedHashMapNewEntry(TNode<OrderedHashMap> const table,
                                    Node* const key, Node* const value,
                                    Node* const hash,
@@ -1251,8 +1257,10 @@ TF_BUILTIN(MapPrototypeSet, CollectionsBuiltinsAssembler) {
     number_of_buckets.Bind(SmiUntag(CAST(
         LoadFixedArrayElement(table, OrderedHashMap::kNumberOfBucketsIndex))));
 
-    STATIC_ASSERT(OrderedHashMap::kLoadFactor == 2);
-    Node* const capacity = WordShl(number_of_buckets.value(), 1);
+    // Three quarters of the buckets, see CapacityForBuckets().
+    Node* const capacity =
+        IntPtrSub(number_of_buckets.value(),
+                  WordShr(number_of_buckets.value(), 2));
     Node* const number_of_elements = SmiUntag(
         CAST(LoadObjectField(table, OrderedHashMap::kNumberOfElementsOffset)));
     Node* const number_of_deleted = SmiUntag(CAST(LoadObjectField(
@@ -1274,20 +1282,42 @@ TF_BUILTIN(MapPrototypeSet, CollectionsBuiltinsAssembler) {
     Goto(&store_new_entry);
   }
   BIND(&store_new_entry);
-  // Store the key, value and connect the element to the bucket chain.
+  // Store the key, value and point a bucket to the new entry.
   StoreOrderedHashMapNewEntry(table_var.value(), key, value,
                               entry_start_position_or_hash.value(),
                               number_of_buckets.value(), occupancy.value());
   Return(receiver);
 }
 
+template <typename CollectionType>
+Node* CollectionsBuiltinsAssembler::FindUnusedOrderedHashTableBucket(
+    TNode<CollectionType> const table, Node* const hash,
+    Node* const number_of_buckets) {
+  Node* const mask = IntPtrSub(number_of_buckets, IntPtrConstant(1));
+  VARIABLE(var_bucket, MachineType::PointerRepresentation(),
+           WordAnd(hash, mask));
+  Label loop(this, &var_bucket), done(this);
+  Goto(&loop);
+  BIND(&loop);
+  {
+    // Buckets of deleted entries are still in use, keep probing past them.
+    Node* const entry = LoadFixedArrayElement(
+        table, var_bucket.value(),
+        CollectionType::kHashTableStartIndex * kPointerSize);
+    GotoIf(WordEqual(entry, SmiConstant(CollectionType::kNotFound)), &done);
+    var_bucket.Bind(
+        WordAnd(IntPtrAdd(var_bucket.value(), IntPtrConstant(1)), mask));
+    Goto(&loop);
+  }
+  BIND(&done);
+  return var_bucket.value();
+}
+
 void CollectionsBuiltinsAssembler::StoreOrderedHashMapNewEntry(
     TNode<OrderedHashMap> const table, Node* const key, Node* const value,
     Node* const hash, Node* const number_of_buckets, Node* const occupancy) {
-  Node* const bucket =
-      WordAnd(hash, IntPtrSub(number_of_buckets, IntPtrConstant(1)));
-  Node* const bucket_entry = LoadFixedArrayElement(
-      table, bucket, OrderedHashMap::kHashTableStartIndex * kPointerSize);
+  Node* const bucket = FindUnusedOrderedHashTableBucket<OrderedHashMap>(
+      table, hash, number_of_buckets);
 
   // Store the entry elements.
   Node* const entry_start = IntPtrAdd(
@@ -1298,11 +1328,8 @@ void CollectionsBuiltinsAssembler::StoreOrderedHashMapNewEntry(
   StoreFixedArrayElement(table, entry_start, value, UPDATE_WRITE_BARRIER,
                          kPointerSize * (OrderedHashMap::kHashTableStartIndex +
                                          OrderedHashMap::kValueOffset));
-  StoreFixedArrayElement(table, entry_start, bucket_entry, SKIP_WRITE_BARRIER,
-                         kPointerSize * (OrderedHashMap::kHashTableStartIndex +
-                                         OrderedHashMap::kChainOffset));
 
-  // Update the bucket head.
+  // Point the bucket to the new entry.
   StoreFixedArrayElement(table, bucket, SmiTag(occupancy), SKIP_WRITE_BARRIER,
                          OrderedHashMap::kHashTableStartIndex * kPointerSize);
 
@@ -1361,11 +1388,12 @@ TF_BUILTIN(MapPrototypeDelete, CollectionsBuiltinsAssembler) {
   TNode<Smi> const number_of_buckets =
       CAST(LoadFixedArrayElement(table, OrderedHashMap::kNumberOfBucketsIndex));
 
-  // If there fewer elements than #buckets / 2, shrink the table.
+  // If there fewer elements than capacity / 4, shrink the table. The
+  // capacity is three quarters of the buckets, see CapacityForBuckets().
+  TNode<Smi> const capacity =
+      SmiSub(number_of_buckets, SmiShr(number_of_buckets, 2));
   Label shrink(this);
-  GotoIf(SmiLessThan(SmiAdd(number_of_elements, number_of_elements),
-                     number_of_buckets),
-         &shrink);
+  GotoIf(SmiLessThan(number_of_elements, SmiShr(capacity, 2)), &shrink);
   Return(TrueConstant());
 
   BIND(&shrink);
@@ -1419,8 +1447,10 @@ TF_BUILTIN(SetPrototypeAdd, CollectionsBuiltinsAssembler) {
     number_of_buckets.Bind(SmiUntag(CAST(
         LoadFixedArrayElement(table, OrderedHashSet::kNumberOfBucketsIndex))));
 
-    STATIC_ASSERT(OrderedHashSet::kLoadFactor == 2);
-    Node* const capacity = WordShl(number_of_buckets.value(), 1);
+    // Three quarters of the buckets, see CapacityForBuckets().
+    Node* const capacity =
+        IntPtrSub(number_of_buckets.value(),
+                  WordShr(number_of_buckets.value(), 2));
     Node* const number_of_elements = SmiUntag(
         CAST(LoadObjectField(table, OrderedHashSet::kNumberOfElementsOffset)));
     Node* const number_of_deleted = SmiUntag(CAST(LoadObjectField(
@@ -1442,7 +1472,7 @@ TF_BUILTIN(SetPrototypeAdd, CollectionsBuiltinsAssembler) {
     Goto(&store_new_entry);
   }
   BIND(&store_new_entry);
-  // Store the key, value and connect the element to the bucket chain.
+  // Store the key and point a bucket to the new entry.
   StoreOrderedHashSetNewEntry(table_var.value(), key,
                               entry_start_position_or_hash.value(),
                               number_of_buckets.value(), occupancy.value());
@@ -1452,10 +1482,8 @@ TF_BUILTIN(SetPrototypeAdd, CollectionsBuiltinsAssembler) {
 void CollectionsBuiltinsAssembler::StoreOrderedHashSetNewEntry(
     TNode<OrderedHashSet> const table, Node* const key, Node* const hash,
     Node* const number_of_buckets, Node* const occupancy) {
-  Node* const bucket =
-      WordAnd(hash, IntPtrSub(number_of_buckets, IntPtrConstant(1)));
-  Node* const bucket_entry = LoadFixedArrayElement(
-      table, bucket, OrderedHashSet::kHashTableStartIndex * kPointerSize);
+  Node* const bucket = FindUnusedOrderedHashTableBucket<OrderedHashSet>(
+      table, hash, number_of_buckets);
 
   // Store the entry elements.
   Node* const entry_start = IntPtrAdd(
@@ -1463,11 +1491,8 @@ void CollectionsBuiltinsAssembler::StoreOrderedHashSetNewEntry(
       number_of_buckets);
   StoreFixedArrayElement(table, entry_start, key, UPDATE_WRITE_BARRIER,
                          kPointerSize * OrderedHashSet::kHashTableStartIndex);
-  StoreFixedArrayElement(table, entry_start, bucket_entry, SKIP_WRITE_BARRIER,
-                         kPointerSize * (OrderedHashSet::kHashTableStartIndex +
-                                         OrderedHashSet::kChainOffset));
 
-  // Update the bucket head.
+  // Point the bucket to the new entry.
   StoreFixedArrayElement(table, bucket, SmiTag(occupancy), SKIP_WRITE_BARRIER,
                          OrderedHashSet::kHashTableStartIndex * kPointerSize);
 
@@ -1522,11 +1547,12 @@ TF_BUILTIN(SetPrototypeDelete, CollectionsBuiltinsAssembler) {
   TNode<Smi> const number_of_buckets =
       CAST(LoadFixedArrayElement(table, OrderedHashSet::kNumberOfBucketsIndex));
 
-  // If there fewer elements than #buckets / 2, shrink the table.
+  // If there fewer elements than capacity / 4, shrink the table. The
+  // capacity is three quarters of the buckets, see CapacityForBuckets().
+  TNode<Smi> const capacity =
+      SmiSub(number_of_buckets, SmiShr(number_of_buckets, 2));
   Label shrink(this);
-  GotoIf(SmiLessThan(SmiAdd(number_of_elements, number_of_elements),
-                     number_of_buckets),
-         &shrink);
+  GotoIf(SmiLessThan(number_of_elements, SmiShr(capacity, 2)), &shrink);
   Return(TrueConstant());
 
   BIND(&shrink);
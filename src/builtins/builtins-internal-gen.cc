@@ -10,8 +10,10 @@
 #include "src/ic/accessor-assembler.h"
 #include "src/ic/keyed-store-generic.h"
 #include "src/macro-assembler.h"
+#include "src/microtask-queue.h"
 #include "src/objects/debug-objects.h"
 #include "src/objects/shared-function-info.h"
+#include "src/objects/swiss-hash-table-helpers.h"
 #include "src/runtime/runtime.h"
 
 namespace v8 {
@@ -460,6 +462,8 @@ class DeletePropertyBaseAssembler : public AccessorAssembler {
                                          SKIP_WRITE_BARRIER);
     StoreDetailsByKeyIndex<NameDictionary>(properties, key_index,
                                            SmiConstant(0));
+    StoreNameDictionaryControlByte(properties, key_index,
+                                   Int32Constant(swiss_table::kDeleted));
 
     // Update bookkeeping information (see NameDictionary::ElementRemoved).
     TNode<Smi> nof = GetNumberOfElements<NameDictionary>(properties);
@@ -609,11 +613,24 @@ class InternalBuiltinsAssembler : public CodeStubAssembler {
   explicit InternalBuiltinsAssembler(compiler::CodeAssemblerState* state)
       : CodeStubAssembler(state) {}
 
-  TNode<IntPtrT> GetPendingMicrotaskCount();
-  void SetPendingMicrotaskCount(TNode<IntPtrT> count);
-
-  TNode<FixedArray> GetMicrotaskQueue();
-  void SetMicrotaskQueue(TNode<FixedArray> queue);
+  TNode<RawPtrT> GetDefaultMicrotaskQueue();
+  TNode<RawPtrT> GetMicrotaskRingBuffer(TNode<RawPtrT> microtask_queue);
+  TNode<IntPtrT> GetMicrotaskQueueCapacity(TNode<RawPtrT> microtask_queue);
+  TNode<IntPtrT> GetMicrotaskQueueSize(TNode<RawPtrT> microtask_queue);
+  void SetMicrotaskQueueSize(TNode<RawPtrT> microtask_queue,
+                             TNode<IntPtrT> new_size);
+  TNode<IntPtrT> GetMicrotaskQueueStart(TNode<RawPtrT> microtask_queue);
+  void SetMicrotaskQueueStart(TNode<RawPtrT> microtask_queue,
+                              TNode<IntPtrT> new_start);
+  TNode<IntPtrT> GetMicrotaskQueueBatchLimit(TNode<RawPtrT> microtask_queue);
+
+  // Returns the offset of the {index}th slot of the ring buffer.
+  TNode<IntPtrT> CalculateRingBufferOffset(TNode<IntPtrT> capacity,
+                                           TNode<IntPtrT> start,
+                                           TNode<IntPtrT> index);
+
+  void RunSingleMicrotask(TNode<Context> current_context,
+                          TNode<HeapObject> microtask);
 
   TNode<Context> GetCurrentContext();
   void SetCurrentContext(TNode<Context> context);
@@ -700,37 +717,63 @@ TF_BUILTIN(AdaptorWithBuiltinExitFrame, InternalBuiltinsAssembler) {
   GenerateAdaptorWithExitFrameType<Descriptor>(Builtins::BUILTIN_EXIT);
 }
 
-TNode<IntPtrT> InternalBuiltinsAssembler::GetPendingMicrotaskCount() {
-  auto ref = ExternalReference::pending_microtask_count_address(isolate());
-  if (kIntSize == 8) {
-    return TNode<IntPtrT>::UncheckedCast(
-        Load(MachineType::Int64(), ExternalConstant(ref)));
-  } else {
-    Node* const value = Load(MachineType::Int32(), ExternalConstant(ref));
-    return ChangeInt32ToIntPtr(value);
-  }
+TNode<RawPtrT> InternalBuiltinsAssembler::GetDefaultMicrotaskQueue() {
+  return ReinterpretCast<RawPtrT>(ExternalConstant(
+      ExternalReference::default_microtask_queue(isolate())));
 }
 
-void InternalBuiltinsAssembler::SetPendingMicrotaskCount(TNode<IntPtrT> count) {
-  auto ref = ExternalReference::pending_microtask_count_address(isolate());
-  auto rep = kIntSize == 8 ? MachineRepresentation::kWord64
-                           : MachineRepresentation::kWord32;
-  if (kIntSize == 4 && kPointerSize == 8) {
-    Node* const truncated_count =
-        TruncateInt64ToInt32(TNode<Int64T>::UncheckedCast(count));
-    StoreNoWriteBarrier(rep, ExternalConstant(ref), truncated_count);
-  } else {
-    StoreNoWriteBarrier(rep, ExternalConstant(ref), count);
-  }
+TNode<RawPtrT> InternalBuiltinsAssembler::GetMicrotaskRingBuffer(
+    TNode<RawPtrT> microtask_queue) {
+  return UncheckedCast<RawPtrT>(
+      Load(MachineType::Pointer(), microtask_queue,
+           IntPtrConstant(MicrotaskQueue::kRingBufferOffset)));
+}
+
+TNode<IntPtrT> InternalBuiltinsAssembler::GetMicrotaskQueueCapacity(
+    TNode<RawPtrT> microtask_queue) {
+  return UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(), microtask_queue,
+           IntPtrConstant(MicrotaskQueue::kCapacityOffset)));
+}
+
+TNode<IntPtrT> InternalBuiltinsAssembler::GetMicrotaskQueueSize(
+    TNode<RawPtrT> microtask_queue) {
+  return UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(), microtask_queue,
+           IntPtrConstant(MicrotaskQueue::kSizeOffset)));
+}
+
+void InternalBuiltinsAssembler::SetMicrotaskQueueSize(
+    TNode<RawPtrT> microtask_queue, TNode<IntPtrT> new_size) {
+  StoreNoWriteBarrier(MachineType::PointerRepresentation(), microtask_queue,
+                      IntPtrConstant(MicrotaskQueue::kSizeOffset), new_size);
+}
+
+TNode<IntPtrT> InternalBuiltinsAssembler::GetMicrotaskQueueStart(
+    TNode<RawPtrT> microtask_queue) {
+  return UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(), microtask_queue,
+           IntPtrConstant(MicrotaskQueue::kStartOffset)));
+}
+
+void InternalBuiltinsAssembler::SetMicrotaskQueueStart(
+    TNode<RawPtrT> microtask_queue, TNode<IntPtrT> new_start) {
+  StoreNoWriteBarrier(MachineType::PointerRepresentation(), microtask_queue,
+                      IntPtrConstant(MicrotaskQueue::kStartOffset), new_start);
 }
 
-TNode<FixedArray> InternalBuiltinsAssembler::GetMicrotaskQueue() {
-  return TNode<FixedArray>::UncheckedCast(
-      LoadRoot(Heap::kMicrotaskQueueRootIndex));
+TNode<IntPtrT> InternalBuiltinsAssembler::GetMicrotaskQueueBatchLimit(
+    TNode<RawPtrT> microtask_queue) {
+  return UncheckedCast<IntPtrT>(
+      Load(MachineType::IntPtr(), microtask_queue,
+           IntPtrConstant(MicrotaskQueue::kBatchLimitOffset)));
 }
 
-void InternalBuiltinsAssembler::SetMicrotaskQueue(TNode<FixedArray> queue) {
-  StoreRoot(Heap::kMicrotaskQueueRootIndex, queue);
+TNode<IntPtrT> InternalBuiltinsAssembler::CalculateRingBufferOffset(
+    TNode<IntPtrT> capacity, TNode<IntPtrT> start, TNode<IntPtrT> index) {
+  // The capacity is a power of two.
+  return TimesPointerSize(
+      WordAnd(IntPtrAdd(start, index), IntPtrSub(capacity, IntPtrConstant(1))));
 }
 
 TNode<Context> InternalBuiltinsAssembler::GetCurrentContext() {
@@ -802,300 +845,285 @@ void InternalBuiltinsAssembler::RunPromiseHook(
   Branch(IsPromiseHookEnabledOrHasAsyncEventDelegate(), &hook, &done_hook);
   BIND(&hook);
   {
-    // Get to the underlying JSPromise instance.
+    // Get to the underlying JSPromise instance. The reactions of an await
+    // that happened before the hooks were enabled have no promise at all.
     Node* const promise = Select<HeapObject>(
-        IsJSPromise(promise_or_capability),
-        [=] { return promise_or_capability; },
+        IsPromiseCapability(promise_or_capability),
         [=] {
           return CAST(LoadObjectField(promise_or_capability,
                                       PromiseCapability::kPromiseOffset));
-        });
+        },
+        [=] { return promise_or_capability; });
+    GotoIf(IsUndefined(promise), &done_hook);
     CallRuntime(id, context, promise);
     Goto(&done_hook);
   }
   BIND(&done_hook);
 }
 
-TF_BUILTIN(EnqueueMicrotask, InternalBuiltinsAssembler) {
-  Node* microtask = Parameter(Descriptor::kMicrotask);
+void InternalBuiltinsAssembler::RunSingleMicrotask(
+    TNode<Context> current_context, TNode<HeapObject> microtask) {
+  CSA_ASSERT(this, TaggedIsNotSmi(microtask));
+
+  TNode<Map> microtask_map = LoadMap(microtask);
+  TNode<Int32T> microtask_type = LoadMapInstanceType(microtask_map);
+
+  VARIABLE(var_exception, MachineRepresentation::kTagged, TheHoleConstant());
+  Label if_exception(this, Label::kDeferred), done(this);
+  Label is_callable(this), is_callback(this),
+      is_promise_fulfill_reaction_job(this),
+      is_promise_reject_reaction_job(this),
+      is_promise_resolve_thenable_job(this),
+      is_unreachable(this, Label::kDeferred);
+
+  // Promise reaction jobs, which include the continuations of await, are
+  // by far the most common microtasks, so check for them first.
+  int32_t case_values[] = {PROMISE_FULFILL_REACTION_JOB_TASK_TYPE,
+                           PROMISE_REJECT_REACTION_JOB_TASK_TYPE,
+                           PROMISE_RESOLVE_THENABLE_JOB_TASK_TYPE,
+                           CALLABLE_TASK_TYPE, CALLBACK_TASK_TYPE};
+  Label* case_labels[] = {
+      &is_promise_fulfill_reaction_job, &is_promise_reject_reaction_job,
+      &is_promise_resolve_thenable_job, &is_callable, &is_callback};
+  static_assert(arraysize(case_values) == arraysize(case_labels), "");
+  Switch(microtask_type, &is_unreachable, case_values, case_labels,
+         arraysize(case_labels));
+
+  BIND(&is_callable);
+  {
+    // Enter the context of the {microtask}.
+    TNode<Context> microtask_context =
+        LoadObjectField<Context>(microtask, CallableTask::kContextOffset);
+    TNode<Context> native_context = LoadNativeContext(microtask_context);
+
+    CSA_ASSERT(this, IsNativeContext(native_context));
+    EnterMicrotaskContext(microtask_context);
+    SetCurrentContext(native_context);
+
+    TNode<JSReceiver> callable = LoadObjectField<JSReceiver>(
+        microtask, CallableTask::kCallableOffset);
+    Node* const result = CallJS(
+        CodeFactory::Call(isolate(), ConvertReceiverMode::kNullOrUndefined),
+        microtask_context, callable, UndefinedConstant());
+    GotoIfException(result, &if_exception, &var_exception);
+    LeaveMicrotaskContext();
+    SetCurrentContext(current_context);
+    Goto(&done);
+  }
 
-  TNode<IntPtrT> num_tasks = GetPendingMicrotaskCount();
-  TNode<IntPtrT> new_num_tasks = IntPtrAdd(num_tasks, IntPtrConstant(1));
-  TNode<FixedArray> queue = GetMicrotaskQueue();
-  TNode<IntPtrT> queue_length = LoadAndUntagFixedArrayBaseLength(queue);
+  BIND(&is_callback);
+  {
+    Node* const microtask_callback =
+        LoadObjectField(microtask, CallbackTask::kCallbackOffset);
+    Node* const microtask_data =
+        LoadObjectField(microtask, CallbackTask::kDataOffset);
+
+    // If this turns out to become a bottleneck because of the calls
+    // to C++ via CEntry, we can choose to speed them up using a
+    // similar mechanism that we use for the CallApiFunction stub,
+    // except that calling the MicrotaskCallback is even easier, since
+    // it doesn't accept any tagged parameters, doesn't return a value
+    // and ignores exceptions.
+    //
+    // But from our current measurements it doesn't seem to be a
+    // serious performance problem, even if the microtask is full
+    // of CallHandlerTasks (which is not a realistic use case anyways).
+    Node* const result =
+        CallRuntime(Runtime::kRunMicrotaskCallback, current_context,
+                    microtask_callback, microtask_data);
+    GotoIfException(result, &if_exception, &var_exception);
+    Goto(&done);
+  }
 
-  Label if_append(this), if_grow(this), done(this);
-  Branch(WordEqual(num_tasks, queue_length), &if_grow, &if_append);
+  BIND(&is_promise_resolve_thenable_job);
+  {
+    // Enter the context of the {microtask}.
+    TNode<Context> microtask_context = LoadObjectField<Context>(
+        microtask, PromiseResolveThenableJobTask::kContextOffset);
+    TNode<Context> native_context = LoadNativeContext(microtask_context);
+    CSA_ASSERT(this, IsNativeContext(native_context));
+    EnterMicrotaskContext(microtask_context);
+    SetCurrentContext(native_context);
+
+    Node* const promise_to_resolve = LoadObjectField(
+        microtask, PromiseResolveThenableJobTask::kPromiseToResolveOffset);
+    Node* const then = LoadObjectField(
+        microtask, PromiseResolveThenableJobTask::kThenOffset);
+    Node* const thenable = LoadObjectField(
+        microtask, PromiseResolveThenableJobTask::kThenableOffset);
+
+    Node* const result =
+        CallBuiltin(Builtins::kPromiseResolveThenableJob, native_context,
+                    promise_to_resolve, thenable, then);
+    GotoIfException(result, &if_exception, &var_exception);
+    LeaveMicrotaskContext();
+    SetCurrentContext(current_context);
+    Goto(&done);
+  }
 
-  BIND(&if_grow);
+  BIND(&is_promise_fulfill_reaction_job);
   {
-    // Determine the new queue length and check if we need to allocate
-    // in large object space (instead of just going to new space, where
-    // we also know that we don't need any write barriers for setting
-    // up the new queue object).
-    Label if_newspace(this), if_lospace(this, Label::kDeferred);
-    TNode<IntPtrT> new_queue_length =
-        IntPtrMax(IntPtrConstant(8), IntPtrAdd(num_tasks, num_tasks));
-    Branch(IntPtrLessThanOrEqual(new_queue_length,
-                                 IntPtrConstant(FixedArray::kMaxRegularLength)),
-           &if_newspace, &if_lospace);
-
-    BIND(&if_newspace);
-    {
-      // This is the likely case where the new queue fits into new space,
-      // and thus we don't need any write barriers for initializing it.
-      TNode<FixedArray> new_queue =
-          CAST(AllocateFixedArray(PACKED_ELEMENTS, new_queue_length));
-      CopyFixedArrayElements(PACKED_ELEMENTS, queue, new_queue, num_tasks,
-                             SKIP_WRITE_BARRIER);
-      StoreFixedArrayElement(new_queue, num_tasks, microtask,
-                             SKIP_WRITE_BARRIER);
-      FillFixedArrayWithValue(PACKED_ELEMENTS, new_queue, new_num_tasks,
-                              new_queue_length, Heap::kUndefinedValueRootIndex);
-      SetMicrotaskQueue(new_queue);
-      Goto(&done);
-    }
+    // Enter the context of the {microtask}.
+    TNode<Context> microtask_context = LoadObjectField<Context>(
+        microtask, PromiseReactionJobTask::kContextOffset);
+    TNode<Context> native_context = LoadNativeContext(microtask_context);
+    CSA_ASSERT(this, IsNativeContext(native_context));
+    EnterMicrotaskContext(microtask_context);
+    SetCurrentContext(native_context);
+
+    Node* const argument =
+        LoadObjectField(microtask, PromiseReactionJobTask::kArgumentOffset);
+    Node* const handler =
+        LoadObjectField(microtask, PromiseReactionJobTask::kHandlerOffset);
+    Node* const promise_or_capability = LoadObjectField(
+        microtask, PromiseReactionJobTask::kPromiseOrCapabilityOffset);
+
+    // Run the promise before/debug hook if enabled.
+    RunPromiseHook(Runtime::kPromiseHookBefore, microtask_context,
+                   promise_or_capability);
+
+    Node* const result =
+        CallBuiltin(Builtins::kPromiseFulfillReactionJob, microtask_context,
+                    argument, handler, promise_or_capability);
+    GotoIfException(result, &if_exception, &var_exception);
+
+    // Run the promise after/debug hook if enabled.
+    RunPromiseHook(Runtime::kPromiseHookAfter, microtask_context,
+                   promise_or_capability);
+
+    LeaveMicrotaskContext();
+    SetCurrentContext(current_context);
+    Goto(&done);
+  }
 
-    BIND(&if_lospace);
-    {
-      // The fallback case where the new queue ends up in large object space.
-      TNode<FixedArray> new_queue = CAST(AllocateFixedArray(
-          PACKED_ELEMENTS, new_queue_length, INTPTR_PARAMETERS,
-          AllocationFlag::kAllowLargeObjectAllocation));
-      CopyFixedArrayElements(PACKED_ELEMENTS, queue, new_queue, num_tasks);
-      StoreFixedArrayElement(new_queue, num_tasks, microtask);
-      FillFixedArrayWithValue(PACKED_ELEMENTS, new_queue, new_num_tasks,
-                              new_queue_length, Heap::kUndefinedValueRootIndex);
-      SetMicrotaskQueue(new_queue);
-      Goto(&done);
-    }
+  BIND(&is_promise_reject_reaction_job);
+  {
+    // Enter the context of the {microtask}.
+    TNode<Context> microtask_context = LoadObjectField<Context>(
+        microtask, PromiseReactionJobTask::kContextOffset);
+    TNode<Context> native_context = LoadNativeContext(microtask_context);
+    CSA_ASSERT(this, IsNativeContext(native_context));
+    EnterMicrotaskContext(microtask_context);
+    SetCurrentContext(native_context);
+
+    Node* const argument =
+        LoadObjectField(microtask, PromiseReactionJobTask::kArgumentOffset);
+    Node* const handler =
+        LoadObjectField(microtask, PromiseReactionJobTask::kHandlerOffset);
+    Node* const promise_or_capability = LoadObjectField(
+        microtask, PromiseReactionJobTask::kPromiseOrCapabilityOffset);
+
+    // Run the promise before/debug hook if enabled.
+    RunPromiseHook(Runtime::kPromiseHookBefore, microtask_context,
+                   promise_or_capability);
+
+    Node* const result =
+        CallBuiltin(Builtins::kPromiseRejectReactionJob, microtask_context,
+                    argument, handler, promise_or_capability);
+    GotoIfException(result, &if_exception, &var_exception);
+
+    // Run the promise after/debug hook if enabled.
+    RunPromiseHook(Runtime::kPromiseHookAfter, microtask_context,
+                   promise_or_capability);
+
+    LeaveMicrotaskContext();
+    SetCurrentContext(current_context);
+    Goto(&done);
   }
 
-  BIND(&if_append);
+  BIND(&is_unreachable);
+  Unreachable();
+
+  BIND(&if_exception);
   {
-    StoreFixedArrayElement(queue, num_tasks, microtask);
+    // Report unhandled exceptions from microtasks.
+    CallRuntime(Runtime::kReportMessage, current_context,
+                var_exception.value());
+    LeaveMicrotaskContext();
+    SetCurrentContext(current_context);
     Goto(&done);
   }
 
   BIND(&done);
-  SetPendingMicrotaskCount(new_num_tasks);
-  Return(UndefinedConstant());
 }
 
-TF_BUILTIN(RunMicrotasks, InternalBuiltinsAssembler) {
-  // Load the current context from the isolate.
-  TNode<Context> current_context = GetCurrentContext();
+TF_BUILTIN(EnqueueMicrotask, InternalBuiltinsAssembler) {
+  Node* microtask = Parameter(Descriptor::kMicrotask);
 
-  Label init_queue_loop(this);
-  Goto(&init_queue_loop);
-  BIND(&init_queue_loop);
-  {
-    TVARIABLE(IntPtrT, index, IntPtrConstant(0));
-    Label loop(this, &index), loop_next(this);
+  TNode<RawPtrT> microtask_queue = GetDefaultMicrotaskQueue();
+  TNode<IntPtrT> capacity = GetMicrotaskQueueCapacity(microtask_queue);
+  TNode<IntPtrT> size = GetMicrotaskQueueSize(microtask_queue);
 
-    TNode<IntPtrT> num_tasks = GetPendingMicrotaskCount();
-    ReturnIf(IntPtrEqual(num_tasks, IntPtrConstant(0)), UndefinedConstant());
+  Label if_grow(this, Label::kDeferred);
+  GotoIf(IntPtrEqual(size, capacity), &if_grow);
 
-    TNode<FixedArray> queue = GetMicrotaskQueue();
+  // The ring buffer has a free slot for the {microtask}. It is visited as
+  // strong roots by the GC, so no write barrier is needed.
+  {
+    TNode<RawPtrT> ring_buffer = GetMicrotaskRingBuffer(microtask_queue);
+    TNode<IntPtrT> start = GetMicrotaskQueueStart(microtask_queue);
+    TNode<IntPtrT> offset = CalculateRingBufferOffset(capacity, start, size);
+    StoreNoWriteBarrier(MachineRepresentation::kTagged, ring_buffer, offset,
+                        microtask);
+    SetMicrotaskQueueSize(microtask_queue, IntPtrAdd(size, IntPtrConstant(1)));
+    Return(UndefinedConstant());
+  }
 
-    CSA_ASSERT(this, IntPtrGreaterThanOrEqual(
-                         LoadAndUntagFixedArrayBaseLength(queue), num_tasks));
-    CSA_ASSERT(this, IntPtrGreaterThan(num_tasks, IntPtrConstant(0)));
+  // Let the C++ side grow the ring buffer and enqueue the {microtask}.
+  BIND(&if_grow);
+  {
+    Node* const isolate_constant =
+        ExternalConstant(ExternalReference::isolate_address(isolate()));
+    Node* const function = ExternalConstant(
+        ExternalReference::call_enqueue_microtask_function());
+    CallCFunction3(MachineType::AnyTagged(), MachineType::Pointer(),
+                   MachineType::IntPtr(), MachineType::AnyTagged(), function,
+                   isolate_constant, microtask_queue, microtask);
+    Return(UndefinedConstant());
+  }
+}
 
-    SetPendingMicrotaskCount(IntPtrConstant(0));
-    SetMicrotaskQueue(EmptyFixedArrayConstant());
+TF_BUILTIN(RunMicrotasks, InternalBuiltinsAssembler) {
+  // Load the current context from the isolate.
+  TNode<Context> current_context = GetCurrentContext();
 
+  TNode<RawPtrT> microtask_queue = GetDefaultMicrotaskQueue();
+
+  // Run microtasks until the queue is empty or the batch limit is reached,
+  // whichever comes first. The queue fields are reloaded after every
+  // microtask, since running it can enqueue more microtasks and grow the
+  // ring buffer.
+  TVARIABLE(IntPtrT, var_remaining,
+            GetMicrotaskQueueBatchLimit(microtask_queue));
+  Label loop(this, &var_remaining), done(this);
+  Goto(&loop);
+  BIND(&loop);
+  {
+    TNode<IntPtrT> size = GetMicrotaskQueueSize(microtask_queue);
+    GotoIf(IntPtrEqual(size, IntPtrConstant(0)), &done);
+    GotoIf(IntPtrEqual(var_remaining.value(), IntPtrConstant(0)), &done);
+
+    // Dequeue the oldest microtask.
+    TNode<RawPtrT> ring_buffer = GetMicrotaskRingBuffer(microtask_queue);
+    TNode<IntPtrT> capacity = GetMicrotaskQueueCapacity(microtask_queue);
+    TNode<IntPtrT> start = GetMicrotaskQueueStart(microtask_queue);
+    TNode<IntPtrT> offset =
+        CalculateRingBufferOffset(capacity, start, IntPtrConstant(0));
+    TNode<HeapObject> microtask = TNode<HeapObject>::UncheckedCast(
+        Load(MachineType::AnyTagged(), ring_buffer, offset));
+    SetMicrotaskQueueStart(
+        microtask_queue,
+        WordAnd(IntPtrAdd(start, IntPtrConstant(1)),
+                IntPtrSub(capacity, IntPtrConstant(1))));
+    SetMicrotaskQueueSize(microtask_queue, IntPtrSub(size, IntPtrConstant(1)));
+    var_remaining = IntPtrSub(var_remaining.value(), IntPtrConstant(1));
+
+    RunSingleMicrotask(current_context, microtask);
     Goto(&loop);
-    BIND(&loop);
-    {
-      TNode<HeapObject> microtask =
-          CAST(LoadFixedArrayElement(queue, index.value()));
-      index = IntPtrAdd(index.value(), IntPtrConstant(1));
-
-      CSA_ASSERT(this, TaggedIsNotSmi(microtask));
-
-      TNode<Map> microtask_map = LoadMap(microtask);
-      TNode<Int32T> microtask_type = LoadMapInstanceType(microtask_map);
-
-      VARIABLE(var_exception, MachineRepresentation::kTagged,
-               TheHoleConstant());
-      Label if_exception(this, Label::kDeferred);
-      Label is_callable(this), is_callback(this),
-          is_promise_fulfill_reaction_job(this),
-          is_promise_reject_reaction_job(this),
-          is_promise_resolve_thenable_job(this),
-          is_unreachable(this, Label::kDeferred);
-
-      int32_t case_values[] = {CALLABLE_TASK_TYPE, CALLBACK_TASK_TYPE,
-                               PROMISE_FULFILL_REACTION_JOB_TASK_TYPE,
-                               PROMISE_REJECT_REACTION_JOB_TASK_TYPE,
-                               PROMISE_RESOLVE_THENABLE_JOB_TASK_TYPE};
-      Label* case_labels[] = {
-          &is_callable, &is_callback, &is_promise_fulfill_reaction_job,
-          &is_promise_reject_reaction_job, &is_promise_resolve_thenable_job};
-      static_assert(arraysize(case_values) == arraysize(case_labels), "");
-      Switch(microtask_type, &is_unreachable, case_values, case_labels,
-             arraysize(case_labels));
-
-      BIND(&is_callable);
-      {
-        // Enter the context of the {microtask}.
-        TNode<Context> microtask_context =
-            LoadObjectField<Context>(microtask, CallableTask::kContextOffset);
-        TNode<Context> native_context = LoadNativeContext(microtask_context);
-
-        CSA_ASSERT(this, IsNativeContext(native_context));
-        EnterMicrotaskContext(microtask_context);
-        SetCurrentContext(native_context);
-
-        TNode<JSReceiver> callable = LoadObjectField<JSReceiver>(
-            microtask, CallableTask::kCallableOffset);
-        Node* const result = CallJS(
-            CodeFactory::Call(isolate(), ConvertReceiverMode::kNullOrUndefined),
-            microtask_context, callable, UndefinedConstant());
-        GotoIfException(result, &if_exception, &var_exception);
-        LeaveMicrotaskContext();
-        SetCurrentContext(current_context);
-        Goto(&loop_next);
-      }
-
-      BIND(&is_callback);
-      {
-        Node* const microtask_callback =
-            LoadObjectField(microtask, CallbackTask::kCallbackOffset);
-        Node* const microtask_data =
-            LoadObjectField(microtask, CallbackTask::kDataOffset);
-
-        // If this turns out to become a bottleneck because of the calls
-        // to C++ via CEntry, we can choose to speed them up using a
-        // similar mechanism that we use for the CallApiFunction stub,
-        // except that calling the MicrotaskCallback is even easier, since
-        // it doesn't accept any tagged parameters, doesn't return a value
-        // and ignores exceptions.
-        //
-        // But from our current measurements it doesn't seem to be a
-        // serious performance problem, even if the microtask is full
-        // of CallHandlerTasks (which is not a realistic use case anyways).
-        Node* const result =
-            CallRuntime(Runtime::kRunMicrotaskCallback, current_context,
-                        microtask_callback, microtask_data);
-        GotoIfException(result, &if_exception, &var_exception);
-        Goto(&loop_next);
-      }
-
-      BIND(&is_promise_resolve_thenable_job);
-      {
-        // Enter the context of the {microtask}.
-        TNode<Context> microtask_context = LoadObjectField<Context>(
-            microtask, PromiseResolveThenableJobTask::kContextOffset);
-        TNode<Context> native_context = LoadNativeContext(microtask_context);
-        CSA_ASSERT(this, IsNativeContext(native_context));
-        EnterMicrotaskContext(microtask_context);
-        SetCurrentContext(native_context);
-
-        Node* const promise_to_resolve = LoadObjectField(
-            microtask, PromiseResolveThenableJobTask::kPromiseToResolveOffset);
-        Node* const then = LoadObjectField(
-            microtask, PromiseResolveThenableJobTask::kThenOffset);
-        Node* const thenable = LoadObjectField(
-            microtask, PromiseResolveThenableJobTask::kThenableOffset);
-
-        Node* const result =
-            CallBuiltin(Builtins::kPromiseResolveThenableJob, native_context,
-                        promise_to_resolve, thenable, then);
-        GotoIfException(result, &if_exception, &var_exception);
-        LeaveMicrotaskContext();
-        SetCurrentContext(current_context);
-        Goto(&loop_next);
-      }
-
-      BIND(&is_promise_fulfill_reaction_job);
-      {
-        // Enter the context of the {microtask}.
-        TNode<Context> microtask_context = LoadObjectField<Context>(
-            microtask, PromiseReactionJobTask::kContextOffset);
-        TNode<Context> native_context = LoadNativeContext(microtask_context);
-        CSA_ASSERT(this, IsNativeContext(native_context));
-        EnterMicrotaskContext(microtask_context);
-        SetCurrentContext(native_context);
-
-        Node* const argument =
-            LoadObjectField(microtask, PromiseReactionJobTask::kArgumentOffset);
-        Node* const handler =
-            LoadObjectField(microtask, PromiseReactionJobTask::kHandlerOffset);
-        Node* const promise_or_capability = LoadObjectField(
-            microtask, PromiseReactionJobTask::kPromiseOrCapabilityOffset);
-
-        // Run the promise before/debug hook if enabled.
-        RunPromiseHook(Runtime::kPromiseHookBefore, microtask_context,
-                       promise_or_capability);
-
-        Node* const result =
-            CallBuiltin(Builtins::kPromiseFulfillReactionJob, microtask_context,
-                        argument, handler, promise_or_capability);
-        GotoIfException(result, &if_exception, &var_exception);
-
-        // Run the promise after/debug hook if enabled.
-        RunPromiseHook(Runtime::kPromiseHookAfter, microtask_context,
-                       promise_or_capability);
-
-        LeaveMicrotaskContext();
-        SetCurrentContext(current_context);
-        Goto(&loop_next);
-      }
-
-      BIND(&is_promise_reject_reaction_job);
-      {
-        // Enter the context of the {microtask}.
-        TNode<Context> microtask_context = LoadObjectField<Context>(
-            microtask, PromiseReactionJobTask::kContextOffset);
-        TNode<Context> native_context = LoadNativeContext(microtask_context);
-        CSA_ASSERT(this, IsNativeContext(native_context));
-        EnterMicrotaskContext(microtask_context);
-        SetCurrentContext(native_context);
-
-        Node* const argument =
-            LoadObjectField(microtask, PromiseReactionJobTask::kArgumentOffset);
-        Node* const handler =
-            LoadObjectField(microtask, PromiseReactionJobTask::kHandlerOffset);
-        Node* const promise_or_capability = LoadObjectField(
-            microtask, PromiseReactionJobTask::kPromiseOrCapabilityOffset);
-
-        // Run the promise before/debug hook if enabled.
-        RunPromiseHook(Runtime::kPromiseHookBefore, microtask_context,
-                       promise_or_capability);
-
-        Node* const result =
-            CallBuiltin(Builtins::kPromiseRejectReactionJob, microtask_context,
-                        argument, handler, promise_or_capability);
-        GotoIfException(result, &if_exception, &var_exception);
-
-        // Run the promise after/debug hook if enabled.
-        RunPromiseHook(Runtime::kPromiseHookAfter, microtask_context,
-                       promise_or_capability);
-
-        LeaveMicrotaskContext();
-        SetCurrentContext(current_context);
-        Goto(&loop_next);
-      }
-
-      BIND(&is_unreachable);
-      Unreachable();
-
-      BIND(&if_exception);
-      {
-        // Report unhandled exceptions from microtasks.
-        CallRuntime(Runtime::kReportMessage, current_context,
-                    var_exception.value());
-        LeaveMicrotaskContext();
-        SetCurrentContext(current_context);
-        Goto(&loop_next);
-      }
-
-      BIND(&loop_next);
-      Branch(IntPtrLessThan(index.value(), num_tasks), &loop, &init_queue_loop);
-    }
   }
+
+  BIND(&done);
+  Return(UndefinedConstant());
 }
 
 TF_BUILTIN(AllocateInNewSpace, CodeStubAssembler) {
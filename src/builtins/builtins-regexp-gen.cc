@@ -228,7 +228,7 @@ TNode<JSRegExpResult> RegExpBuiltinsAssembler::ConstructNewResultFromMatchInfo(
     CSA_ASSERT(this, SmiGreaterThan(num_results, SmiConstant(1)));
 
     // We reach this point only if captures exist, implying that this is an
-    // IRREGEXP JSRegExp.
+    // IRREGEXP or NFA JSRegExp.
 
     TNode<JSRegExp> regexp = CAST(maybe_regexp);
 
@@ -237,9 +237,13 @@ TNode<JSRegExpResult> RegExpBuiltinsAssembler::ConstructNewResultFromMatchInfo(
 
     TNode<FixedArray> data =
         CAST(LoadObjectField(regexp, JSRegExp::kDataOffset));
-    CSA_ASSERT(this,
-               SmiEqual(CAST(LoadFixedArrayElement(data, JSRegExp::kTagIndex)),
-                        SmiConstant(JSRegExp::IRREGEXP)));
+    CSA_ASSERT(
+        this,
+        Word32Or(
+            SmiEqual(CAST(LoadFixedArrayElement(data, JSRegExp::kTagIndex)),
+                     SmiConstant(JSRegExp::IRREGEXP)),
+            SmiEqual(CAST(LoadFixedArrayElement(data, JSRegExp::kTagIndex)),
+                     SmiConstant(JSRegExp::NFA))));
 
     // The names fixed array associates names at even indices with a capture
     // index at odd indices.
@@ -334,7 +338,8 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
   ToDirectStringAssembler to_direct(state(), string);
 
   TVARIABLE(HeapObject, var_result);
-  Label out(this), atom(this), runtime(this, Label::kDeferred);
+  Label out(this), atom(this), runtime(this, Label::kDeferred),
+      fallback_to_nfa(this, Label::kDeferred);
 
   // External constants.
   TNode<ExternalReference> isolate_address =
@@ -374,8 +379,9 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
 
       int32_t values[] = {
           JSRegExp::IRREGEXP, JSRegExp::ATOM, JSRegExp::NOT_COMPILED,
+          JSRegExp::NFA,
       };
-      Label* labels[] = {&next, &atom, &runtime};
+      Label* labels[] = {&next, &atom, &runtime, &runtime};
 
       STATIC_ASSERT(arraysize(values) == arraysize(labels));
       Switch(tag, &unreachable, values, labels, arraysize(values));
@@ -542,6 +548,10 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
     GotoIf(IntPtrEqual(int_result,
                        IntPtrConstant(NativeRegExpMacroAssembler::EXCEPTION)),
            &if_exception);
+    GotoIf(IntPtrEqual(
+               int_result,
+               IntPtrConstant(NativeRegExpMacroAssembler::FALLBACK_TO_NFA)),
+           &fallback_to_nfa);
 
     CSA_ASSERT(this,
                IntPtrEqual(int_result,
@@ -628,6 +638,15 @@ TNode<HeapObject> RegExpBuiltinsAssembler::RegExpExecInternal(
     Goto(&out);
   }
 
+  BIND(&fallback_to_nfa);
+  {
+    // The regexp code exceeded its backtrack limit. Redo the match on the NFA
+    // engine rather than rerunning the backtracking code in the runtime.
+    var_result = CAST(CallRuntime(Runtime::kRegExpExecNfa, context, regexp,
+                                  string, last_index, match_info));
+    Goto(&out);
+  }
+
   BIND(&atom);
   {
     // TODO(jgruber): A call with 4 args stresses register allocation, this
@@ -10,6 +10,7 @@
 #include "src/objects/api-callbacks.h"
 #include "src/objects/descriptor-array.h"
 #include "src/objects/ordered-hash-table-inl.h"
+#include "src/objects/swiss-hash-table-helpers.h"
 #include "src/wasm/wasm-objects.h"
 
 namespace v8 {
@@ -362,6 +363,14 @@ TNode<BoolT> CodeStubAssembler::WordIsPowerOfTwo(SloppyTNode<IntPtrT> value) {
       IntPtrConstant(0));
 }
 
+TNode<IntPtrT> CodeStubAssembler::WordClz(SloppyTNode<WordT> value) {
+  if (Is64()) {
+    return ReinterpretCast<IntPtrT>(
+        Word64Clz(ReinterpretCast<Word64T>(value)));
+  }
+  return ChangeInt32ToIntPtr(Word32Clz(ReinterpretCast<Word32T>(value)));
+}
+
 TNode<Float64T> CodeStubAssembler::Float64Round(SloppyTNode<Float64T> x) {
   Node* one = Float64Constant(1.0);
   Node* one_half = Float64Constant(0.5);
@@ -3278,6 +3287,11 @@ TNode<NameDictionary> CodeStubAssembler::AllocateNameDictionaryWithCapacity(
   StoreFixedArrayElement(result, NameDictionary::kObjectHashIndex,
                          SmiConstant(PropertyArray::kNoHashSentinel),
                          SKIP_WRITE_BARRIER);
+  // Dictionaries allocated here start out without a control table, they get
+  // one when the runtime grows them beyond NameDictionary::
+  // kMinControlTableCapacity.
+  StoreFixedArrayElement(result, NameDictionary::kControlTableIndex, zero,
+                         SKIP_WRITE_BARRIER);
 
   // Initialize NameDictionary elements.
   TNode<WordT> result_word = BitcastTaggedToWord(result);
@@ -3299,6 +3313,10 @@ TNode<NameDictionary> CodeStubAssembler::CopyNameDictionary(
   GotoIf(UintPtrGreaterThan(
              capacity, IntPtrConstant(NameDictionary::kMaxRegularCapacity)),
          large_object_fallback);
+  // The control table would have to be copied as well.
+  GotoIfNot(TaggedIsSmi(LoadFixedArrayElement(
+                dictionary, NameDictionary::kControlTableIndex)),
+            large_object_fallback);
   TNode<NameDictionary> properties =
       AllocateNameDictionaryWithCapacity(capacity);
   TNode<IntPtrT> length = SmiUntag(LoadFixedArrayBaseLength(dictionary));
@@ -3310,14 +3328,15 @@ TNode<NameDictionary> CodeStubAssembler::CopyNameDictionary(
 template <typename CollectionType>
 Node* CodeStubAssembler::AllocateOrderedHashTable() {
   static const int kCapacity = CollectionType::kMinCapacity;
-  static const int kBucketCount = kCapacity / CollectionType::kLoadFactor;
+  static const int kBucketCount = CollectionType::kMinNumberOfBuckets;
   static const int kDataTableLength = kCapacity * CollectionType::kEntrySize;
   static const int kFixedArrayLength =
       CollectionType::kHashTableStartIndex + kBucketCount + kDataTableLength;
   static const int kDataTableStartIndex =
       CollectionType::kHashTableStartIndex + kBucketCount;
 
-  STATIC_ASSERT(base::bits::IsPowerOfTwo(kCapacity));
+  STATIC_ASSERT(base::bits::IsPowerOfTwo(kBucketCount));
+  STATIC_ASSERT(CollectionType::CapacityForBuckets(kBucketCount) == kCapacity);
   STATIC_ASSERT(kCapacity <= CollectionType::kMaxCapacity);
 
   // Allocate the table and add the proper map.
@@ -3448,34 +3467,34 @@ void CodeStubAssembler::FindOrderedHashTableEntry(
     Node* table, Node* hash,
     std::function<void(Node*, Label*, Label*)> key_compare,
     Variable* entry_start_position, Label* entry_found, Label* not_found) {
-  // Get the index of the bucket.
+  // Get the index of the first bucket of the probe sequence.
   Node* const number_of_buckets = SmiUntag(CAST(LoadFixedArrayElement(
       CAST(table), CollectionType::kNumberOfBucketsIndex)));
-  Node* const bucket =
-      WordAnd(hash, IntPtrSub(number_of_buckets, IntPtrConstant(1)));
-  Node* const first_entry = SmiUntag(CAST(LoadFixedArrayElement(
-      CAST(table), bucket,
-      CollectionType::kHashTableStartIndex * kPointerSize)));
+  Node* const mask = IntPtrSub(number_of_buckets, IntPtrConstant(1));
+  Node* const first_bucket = WordAnd(hash, mask);
 
-  // Walk the bucket chain.
+  // Probe the buckets until the key or an unused bucket is found.
   Node* entry_start;
   Label if_key_found(this);
   {
-    VARIABLE(var_entry, MachineType::PointerRepresentation(), first_entry);
-    Label loop(this, {&var_entry, entry_start_position}),
+    VARIABLE(var_bucket, MachineType::PointerRepresentation(), first_bucket);
+    Label loop(this, {&var_bucket, entry_start_position}),
         continue_next_entry(this);
     Goto(&loop);
     BIND(&loop);
 
-    // If the entry index is the not-found sentinel, we are done.
-    GotoIf(
-        WordEqual(var_entry.value(), IntPtrConstant(CollectionType::kNotFound)),
-        not_found);
+    Node* const entry = SmiUntag(CAST(LoadFixedArrayElement(
+        CAST(table), var_bucket.value(),
+        CollectionType::kHashTableStartIndex * kPointerSize)));
+
+    // If the bucket is unused, we are done.
+    GotoIf(WordEqual(entry, IntPtrConstant(CollectionType::kNotFound)),
+           not_found);
 
     // Make sure the entry index is within range.
     CSA_ASSERT(
         this, UintPtrLessThan(
-                  var_entry.value(),
+                  entry,
                   SmiUntag(SmiAdd(
                       CAST(LoadFixedArrayElement(
                           CAST(table), CollectionType::kNumberOfElementsIndex)),
@@ -3484,10 +3503,9 @@ void CodeStubAssembler::FindOrderedHashTableEntry(
                           CollectionType::kNumberOfDeletedElementsIndex))))));
 
     // Compute the index of the entry relative to kHashTableStartIndex.
-    entry_start =
-        IntPtrAdd(IntPtrMul(var_entry.value(),
-                            IntPtrConstant(CollectionType::kEntrySize)),
-                  number_of_buckets);
+    entry_start = IntPtrAdd(
+        IntPtrMul(entry, IntPtrConstant(CollectionType::kEntrySize)),
+        number_of_buckets);
 
     // Load the key from the entry.
     Node* const candidate_key = LoadFixedArrayElement(
@@ -3497,11 +3515,9 @@ void CodeStubAssembler::FindOrderedHashTableEntry(
     key_compare(candidate_key, &if_key_found, &continue_next_entry);
 
     BIND(&continue_next_entry);
-    // Load the index of the next entry in the bucket chain.
-    var_entry.Bind(SmiUntag(CAST(LoadFixedArrayElement(
-        CAST(table), entry_start,
-        (CollectionType::kHashTableStartIndex + CollectionType::kChainOffset) *
-            kPointerSize))));
+    // Move on to the next bucket of the probe sequence.
+    var_bucket.Bind(
+        WordAnd(IntPtrAdd(var_bucket.value(), IntPtrConstant(1)), mask));
 
     Goto(&loop);
   }
@@ -7503,6 +7519,17 @@ void CodeStubAssembler::NameDictionaryLookup(
                  inlined_probes == 0 && if_found == nullptr);
   Comment("NameDictionaryLookup");
 
+  if (std::is_same<Dictionary, NameDictionary>::value) {
+    Label if_no_control_table(this);
+    TNode<Object> control_table =
+        LoadFixedArrayElement(dictionary, NameDictionary::kControlTableIndex);
+    GotoIf(TaggedIsSmi(control_table), &if_no_control_table);
+    NameDictionaryLookupWithControlTable(
+        ReinterpretCast<NameDictionary>(dictionary), CAST(control_table),
+        unique_name, if_found, var_name_index, if_not_found, mode);
+    BIND(&if_no_control_table);
+  }
+
   TNode<IntPtrT> capacity = SmiUntag(GetCapacity<Dictionary>(dictionary));
   TNode<WordT> mask = IntPtrSub(capacity, IntPtrConstant(1));
   TNode<WordT> hash = ChangeUint32ToWord(LoadNameHash(unique_name));
@@ -7569,6 +7596,156 @@ template void CodeStubAssembler::NameDictionaryLookup<GlobalDictionary>(
     TNode<GlobalDictionary>, TNode<Name>, Label*, TVariable<IntPtrT>*, Label*,
     int, LookupMode);
 
+void CodeStubAssembler::NameDictionaryLookupWithControlTable(
+    TNode<NameDictionary> dictionary, TNode<ByteArray> control_table,
+    TNode<Name> unique_name, Label* if_found,
+    TVariable<IntPtrT>* var_name_index, Label* if_not_found,
+    LookupMode mode) {
+  DCHECK_EQ(mode == kFindInsertionIndex, if_found == nullptr);
+  Comment("NameDictionaryLookupWithControlTable");
+
+  // This is swiss_table::GroupPortableImpl with groups of one word, which
+  // visits the entries in the same order as the C++ implementation does.
+  const int kGroupWidth = kPointerSize;
+  TNode<IntPtrT> lsbs =
+      IntPtrConstant(static_cast<intptr_t>(~uintptr_t{0} / 0xFF));
+  TNode<IntPtrT> msbs =
+      IntPtrConstant(static_cast<intptr_t>(~uintptr_t{0} / 0xFF * 0x80));
+  TNode<IntPtrT> zero = IntPtrConstant(0);
+  TNode<IntPtrT> all_ones = IntPtrConstant(-1);
+
+  // The control bytes of the first entry of a group are in the least
+  // significant byte of the group on little-endian targets, and in the most
+  // significant byte on big-endian targets.
+  auto first_entry_in_mask = [=](TNode<WordT> mask) -> TNode<WordT> {
+#if defined(V8_TARGET_BIG_ENDIAN)
+    return WordShr(WordClz(mask), kBitsPerByteLog2);
+#else
+    TNode<WordT> lowest = WordAnd(mask, IntPtrSub(zero, mask));
+    return WordShr(IntPtrSub(IntPtrConstant(kBitsPerPointer - 1),
+                             WordClz(lowest)),
+                   kBitsPerByteLog2);
+#endif
+  };
+  auto clear_first_entry_in_mask = [=](TNode<WordT> mask) -> TNode<WordT> {
+#if defined(V8_TARGET_BIG_ENDIAN)
+    return WordXor(mask,
+                   WordShr(IntPtrConstant(std::numeric_limits<intptr_t>::min()),
+                           WordClz(mask)));
+#else
+    return WordAnd(mask, IntPtrSub(mask, IntPtrConstant(1)));
+#endif
+  };
+
+  TNode<IntPtrT> capacity = SmiUntag(GetCapacity<NameDictionary>(dictionary));
+  TNode<WordT> mask = IntPtrSub(capacity, IntPtrConstant(1));
+  TNode<WordT> hash = ChangeUint32ToWord(LoadNameHash(unique_name));
+  TNode<WordT> h2 =
+      WordAnd(WordShr(hash, swiss_table::kH2Shift),
+              IntPtrConstant((1 << swiss_table::kH2Bits) - 1));
+  TNode<WordT> h2_pattern = IntPtrMul(h2, lsbs);
+
+  // See swiss_table::ProbeSequence. The entries of the first group that come
+  // before the first probe are masked out.
+  TNode<WordT> start = WordAnd(hash, mask);
+  TNode<WordT> first_index_bits = WordShl(
+      WordAnd(start, IntPtrConstant(kGroupWidth - 1)), kBitsPerByteLog2);
+#if defined(V8_TARGET_BIG_ENDIAN)
+  TNode<WordT> first_group_mask = WordShr(all_ones, first_index_bits);
+#else
+  TNode<WordT> first_group_mask = WordShl(all_ones, first_index_bits);
+#endif
+
+  TVARIABLE(WordT, var_offset,
+            WordAnd(start, IntPtrConstant(~(kGroupWidth - 1))));
+  TVARIABLE(WordT, var_group_mask, first_group_mask);
+  // Appease the variable merging algorithm for "Goto(&loop)" below.
+  *var_name_index = IntPtrConstant(0);
+  Variable* loop_vars[] = {&var_offset, &var_group_mask, var_name_index};
+  Label loop(this, 3, loop_vars);
+  Goto(&loop);
+  BIND(&loop);
+  {
+    TNode<WordT> offset = var_offset.value();
+    TNode<WordT> group = UncheckedCast<WordT>(
+        Load(MachineType::Pointer(), control_table,
+             IntPtrAdd(offset, IntPtrConstant(ByteArray::kHeaderSize -
+                                              kHeapObjectTag))));
+    Label next_group(this);
+
+    if (mode == kFindExisting) {
+      // See swiss_table::GroupPortableImpl::Match().
+      TNode<WordT> x = WordXor(group, h2_pattern);
+      TVARIABLE(WordT, var_matches,
+                WordAnd(WordAnd(WordAnd(IntPtrSub(x, lsbs), WordNot(x)), msbs),
+                        var_group_mask.value()));
+      Variable* match_loop_vars[] = {&var_matches, var_name_index};
+      Label match_loop(this, 2, match_loop_vars), no_more_matches(this);
+      Goto(&match_loop);
+      BIND(&match_loop);
+      {
+        TNode<WordT> matches = var_matches.value();
+        GotoIf(WordEqual(matches, zero), &no_more_matches);
+        TNode<IntPtrT> entry =
+            Signed(IntPtrAdd(offset, first_entry_in_mask(matches)));
+        TNode<IntPtrT> index = EntryToIndex<NameDictionary>(entry);
+        *var_name_index = index;
+        // The entry can be a false positive of the group match, see
+        // swiss_table::GroupPortableImpl::Match(), so the key is only
+        // compared by identity, whatever it is.
+        TNode<Object> current = LoadFixedArrayElement(dictionary, index);
+        GotoIf(WordEqual(current, unique_name), if_found);
+        var_matches = clear_first_entry_in_mask(matches);
+        Goto(&match_loop);
+      }
+
+      // Stop at the first group that has an empty entry in the sequence, see
+      // swiss_table::GroupPortableImpl::MatchEmpty().
+      BIND(&no_more_matches);
+      TNode<WordT> empty = WordAnd(
+          WordAnd(WordAnd(group, WordShl(WordNot(group), 6)), msbs),
+          var_group_mask.value());
+      Branch(WordEqual(empty, zero), &next_group, if_not_found);
+    } else {
+      DCHECK_EQ(kFindInsertionIndex, mode);
+      // See swiss_table::GroupPortableImpl::MatchEmptyOrDeleted().
+      TNode<WordT> free =
+          WordAnd(WordAnd(group, msbs), var_group_mask.value());
+      GotoIf(WordEqual(free, zero), &next_group);
+      TNode<IntPtrT> entry =
+          Signed(IntPtrAdd(offset, first_entry_in_mask(free)));
+      *var_name_index = EntryToIndex<NameDictionary>(entry);
+      Goto(if_not_found);
+    }
+
+    BIND(&next_group);
+    var_offset = WordAnd(IntPtrAdd(offset, IntPtrConstant(kGroupWidth)), mask);
+    var_group_mask = all_ones;
+    Goto(&loop);
+  }
+}
+
+void CodeStubAssembler::StoreNameDictionaryControlByte(
+    TNode<NameDictionary> dictionary, TNode<IntPtrT> key_index,
+    TNode<Word32T> control) {
+  Label done(this);
+  TNode<Object> control_table =
+      LoadFixedArrayElement(dictionary, NameDictionary::kControlTableIndex);
+  GotoIf(TaggedIsSmi(control_table), &done);
+  // See NameDictionary::EntryToIndex().
+  TNode<Int32T> entry = Int32Div(
+      TruncateIntPtrToInt32(IntPtrSub(
+          key_index, IntPtrConstant(NameDictionary::kElementsStartIndex))),
+      Int32Constant(NameDictionary::kEntrySize));
+  StoreNoWriteBarrier(
+      MachineRepresentation::kWord8, control_table,
+      IntPtrAdd(ChangeInt32ToIntPtr(entry),
+                IntPtrConstant(ByteArray::kHeaderSize - kHeapObjectTag)),
+      control);
+  Goto(&done);
+  BIND(&done);
+}
+
 Node* CodeStubAssembler::ComputeIntegerHash(Node* key) {
   return ComputeIntegerHash(key, IntPtrConstant(kZeroHashSeed));
 }
@@ -7734,6 +7911,10 @@ void CodeStubAssembler::InsertEntry<NameDictionary>(
   // Store name and value.
   StoreFixedArrayElement(dictionary, index, name);
   StoreValueByKeyIndex<NameDictionary>(dictionary, index, value);
+  StoreNameDictionaryControlByte(
+      dictionary, index,
+      Word32And(Word32Shr(LoadNameHash(name), swiss_table::kH2Shift),
+                Int32Constant((1 << swiss_table::kH2Bits) - 1)));
 
   // Prepare details of the new property.
   PropertyDetails d(kData, NONE, PropertyCellType::kNoCell);
@@ -714,6 +714,8 @@ class V8_EXPORT_PRIVATE CodeStubAssembler : public compiler::CodeAssembler {
   // Check that a word has a word-aligned address.
   TNode<BoolT> WordIsWordAligned(SloppyTNode<WordT> word);
   TNode<BoolT> WordIsPowerOfTwo(SloppyTNode<IntPtrT> value);
+  // Counts the leading zero bits of a word.
+  TNode<IntPtrT> WordClz(SloppyTNode<WordT> value);
 
 #if DEBUG
   void Bind(Label* label, AssemblerDebugInfo debug_info);
@@ -2262,6 +2264,21 @@ class V8_EXPORT_PRIVATE CodeStubAssembler : public compiler::CodeAssembler {
                             int inlined_probes = kInlinedDictionaryProbes,
                             LookupMode mode = kFindExisting);
 
+  // Variant of NameDictionaryLookup for NameDictionaries that have a control
+  // table (see swiss-hash-table-helpers.h). Scans a word of control bytes at
+  // a time and only compares the keys of entries with matching hash bits.
+  void NameDictionaryLookupWithControlTable(
+      TNode<NameDictionary> dictionary, TNode<ByteArray> control_table,
+      TNode<Name> unique_name, Label* if_found,
+      TVariable<IntPtrT>* var_name_index, Label* if_not_found,
+      LookupMode mode);
+
+  // Stores {control} as the control byte of the entry whose key is at
+  // {key_index}, if {dictionary} has a control table.
+  void StoreNameDictionaryControlByte(TNode<NameDictionary> dictionary,
+                                      TNode<IntPtrT> key_index,
+                                      TNode<Word32T> control);
+
   Node* ComputeIntegerHash(Node* key);
   Node* ComputeIntegerHash(Node* key, Node* seed);
 
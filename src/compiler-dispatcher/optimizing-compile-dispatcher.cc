@@ -21,8 +21,13 @@ namespace {
 
 void DisposeCompilationJob(OptimizedCompilationJob* job,
                            bool restore_function_code) {
-  if (restore_function_code) {
-    Handle<JSFunction> function = job->compilation_info()->closure();
+  OptimizedCompilationInfo* info = job->compilation_info();
+  if (restore_function_code && info->is_osr()) {
+    // OSR jobs never touched the function's code, but the interpreter must not
+    // keep waiting for the result.
+    info->closure()->feedback_vector()->ClearOsrCode(info->osr_offset());
+  } else if (restore_function_code) {
+    Handle<JSFunction> function = info->closure();
     function->set_code(function->shared()->GetCode());
     if (function->IsInOptimizationQueue()) {
       function->ClearOptimizationMarker();
@@ -202,7 +207,8 @@ void OptimizingCompileDispatcher::InstallOptimizedFunctions() {
     }
     OptimizedCompilationInfo* info = job->compilation_info();
     Handle<JSFunction> function(*info->closure(), isolate_);
-    if (function->HasOptimizedCode()) {
+    // OSR code is still needed by activations that are stuck in the loop.
+    if (function->HasOptimizedCode() && !info->is_osr()) {
       if (FLAG_trace_concurrent_recompilation) {
         PrintF("  ** Aborting compilation for ");
         function->ShortPrint();
@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <sstream>
 
 #include "src/api-inl.h"
 #include "src/asmjs/asm-js.h"
@@ -23,6 +24,7 @@
 #include "src/frames-inl.h"
 #include "src/globals.h"
 #include "src/heap/heap.h"
+#include "src/interpreter/bytecode-array-accessor.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate-inl.h"
 #include "src/log-inl.h"
@@ -308,13 +310,28 @@ void InstallBytecodeArray(Handle<BytecodeArray> bytecode_array,
     return;
   }
 
-  Handle<Code> code;
-  {
-    CodeSpaceMemoryModificationScope code_allocation(isolate->heap());
+  Handle<Script> script = parse_info->script();
+  int line_num =
+      Script::GetLineNumber(script, shared_info->StartPosition()) + 1;
+  int column_num =
+      Script::GetColumnNumber(script, shared_info->StartPosition()) + 1;
+  Handle<String> script_name(script->name()->IsString()
+                                 ? String::cast(script->name())
+                                 : ReadOnlyRoots(isolate).empty_string(),
+                             isolate);
+  CodeEventListener::LogEventsAndTags log_tag = Logger::ToNativeByScript(
+      CodeEventListener::INTERPRETED_FUNCTION_TAG, *script);
 
-    code = isolate->factory()->CopyCode(
-        BUILTIN_CODE(isolate, InterpreterEntryTrampoline));
-  }
+  // The trampoline copy is shared by the functions whose code-creation
+  // events below would be the same.
+  std::ostringstream name;
+  name << log_tag << " " << shared_info->DebugName()->ToCString().get() << " "
+       << script_name->ToCString().get() << ":" << line_num << ":"
+       << column_num;
+  bool is_new;
+  Handle<Code> code =
+      isolate->interpreter()->GetInterpreterEntryTrampolineCopy(name.str(),
+                                                                &is_new);
 
   Handle<InterpreterData> interpreter_data = Handle<InterpreterData>::cast(
       isolate->factory()->NewStruct(INTERPRETER_DATA_TYPE, TENURED));
@@ -324,19 +341,11 @@ void InstallBytecodeArray(Handle<BytecodeArray> bytecode_array,
 
   shared_info->set_interpreter_data(*interpreter_data);
 
-  Handle<Script> script = parse_info->script();
+  // Listeners already know a shared copy under the same name.
+  if (!is_new) return;
   Handle<AbstractCode> abstract_code = Handle<AbstractCode>::cast(code);
-  int line_num =
-      Script::GetLineNumber(script, shared_info->StartPosition()) + 1;
-  int column_num =
-      Script::GetColumnNumber(script, shared_info->StartPosition()) + 1;
-  String* script_name = script->name()->IsString()
-                            ? String::cast(script->name())
-                            : ReadOnlyRoots(isolate).empty_string();
-  CodeEventListener::LogEventsAndTags log_tag = Logger::ToNativeByScript(
-      CodeEventListener::INTERPRETED_FUNCTION_TAG, *script);
   PROFILE(isolate, CodeCreateEvent(log_tag, *abstract_code, *shared_info,
-                                   script_name, line_num, column_num));
+                                   *script_name, line_num, column_num));
 }
 
 void InstallUnoptimizedCode(UnoptimizedCompilationInfo* compilation_info,
@@ -551,6 +560,12 @@ V8_WARN_UNUSED_RESULT MaybeHandle<Code> GetCodeFromOptimizedCodeCache(
         return Handle<Code>(code, feedback_vector->GetIsolate());
       }
     }
+  } else if (function->feedback_cell()->value()->IsFeedbackVector()) {
+    Code* code = function->feedback_vector()->GetOsrCode(osr_offset);
+    if (code != nullptr) {
+      DCHECK(!code->marked_for_deoptimization());
+      return Handle<Code>(code, function->GetIsolate());
+    }
   }
   return MaybeHandle<Code>();
 }
@@ -561,6 +576,8 @@ void ClearOptimizedCodeCache(OptimizedCompilationInfo* compilation_info) {
     Handle<FeedbackVector> vector =
         handle(function->feedback_vector(), function->GetIsolate());
     vector->ClearOptimizationMarker();
+  } else {
+    function->feedback_vector()->ClearOsrCode(compilation_info->osr_offset());
   }
 }
 
@@ -583,10 +600,28 @@ void InsertCodeIntoOptimizedCodeCache(
   Handle<SharedFunctionInfo> shared(function->shared(), function->GetIsolate());
   Handle<Context> native_context(function->context()->native_context(),
                                  function->GetIsolate());
+  Handle<FeedbackVector> vector =
+      handle(function->feedback_vector(), function->GetIsolate());
   if (compilation_info->osr_offset().IsNone()) {
-    Handle<FeedbackVector> vector =
-        handle(function->feedback_vector(), function->GetIsolate());
     FeedbackVector::SetOptimizedCode(vector, code);
+  } else {
+    FeedbackVector::SetOsrCode(vector, compilation_info->osr_offset(), code);
+  }
+}
+
+// Arms the back edges of the loop that |osr_offset| belongs to, so that the
+// next iteration of an interpreted activation enters the OSR code that was
+// just put into the cache.
+void ArmBackEdgesForOsrCode(Isolate* isolate,
+                            Handle<SharedFunctionInfo> shared,
+                            BailoutId osr_offset) {
+  Handle<BytecodeArray> bytecode(shared->GetBytecodeArray(), isolate);
+  interpreter::BytecodeArrayAccessor accessor(bytecode, osr_offset.ToInt());
+  DCHECK_EQ(accessor.current_bytecode(), interpreter::Bytecode::kJumpLoop);
+  int loop_depth = accessor.GetImmediateOperand(1);
+  int level = Min(loop_depth + 1, AbstractCode::kMaxLoopNestingMarker);
+  if (bytecode->osr_loop_nesting_level() < level) {
+    bytecode->set_osr_loop_nesting_level(level);
   }
 }
 
@@ -687,6 +722,12 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
     return cached_code;
   }
 
+  if (!osr_offset.IsNone() &&
+      function->feedback_vector()->IsOsrCompilationInProgress(osr_offset)) {
+    // The interpreter keeps running until the concurrent job is installed.
+    return MaybeHandle<Code>();
+  }
+
   // Reset profiler ticks, function is no longer considered hot.
   DCHECK(shared->is_compiled());
   function->feedback_vector()->set_profiler_ticks(0);
@@ -702,7 +743,9 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
       compiler::Pipeline::NewCompilationJob(isolate, function, has_script));
   OptimizedCompilationInfo* compilation_info = job->compilation_info();
 
-  compilation_info->SetOptimizingForOsr(osr_offset, osr_frame);
+  // The frame is only valid for the duration of this call.
+  compilation_info->SetOptimizingForOsr(
+      osr_offset, mode == ConcurrencyMode::kConcurrent ? nullptr : osr_frame);
 
   // Do not use TurboFan if we need to be able to set break points.
   if (compilation_info->shared_info()->HasBreakInfo()) {
@@ -745,7 +788,22 @@ MaybeHandle<Code> GetOptimizedCode(Handle<JSFunction> function,
   // Reopen handles in the new CompilationHandleScope.
   compilation_info->ReopenHandlesInNewHandleScope(isolate);
 
-  if (mode == ConcurrencyMode::kConcurrent) {
+  if (mode == ConcurrencyMode::kConcurrent && !osr_offset.IsNone()) {
+    // Mark the loop first, a flushed job clears the marker again.
+    Handle<FeedbackVector> vector(function->feedback_vector(), isolate);
+    FeedbackVector::SetOsrCompilationInProgress(vector, osr_offset);
+    if (GetOptimizedCodeLater(job.get(), isolate)) {
+      job.release();  // The background recompile job owns this now.
+      if (FLAG_trace_osr) {
+        PrintF("[OSR - Queued ");
+        function->PrintName();
+        PrintF(" at AST id %d for concurrent optimization]\n",
+               osr_offset.ToInt());
+      }
+      return MaybeHandle<Code>();
+    }
+    vector->ClearOsrCode(osr_offset);
+  } else if (mode == ConcurrencyMode::kConcurrent) {
     if (GetOptimizedCodeLater(job.get(), isolate)) {
       job.release();  // The background recompile job owns this now.
 
@@ -800,7 +858,12 @@ CompilationJob::Status FinalizeOptimizedCompilationJob(
         compilation_info->closure()->ShortPrint();
         PrintF("]\n");
       }
-      compilation_info->closure()->set_code(*compilation_info->code());
+      if (compilation_info->is_osr()) {
+        // The code is entered from the loop, not installed on the function.
+        ArmBackEdgesForOsrCode(isolate, shared, compilation_info->osr_offset());
+      } else {
+        compilation_info->closure()->set_code(*compilation_info->code());
+      }
       return CompilationJob::SUCCEEDED;
     }
   }
@@ -812,6 +875,11 @@ CompilationJob::Status FinalizeOptimizedCompilationJob(
     PrintF(" because: %s]\n",
            GetBailoutReason(compilation_info->bailout_reason()));
   }
+  if (compilation_info->is_osr()) {
+    compilation_info->closure()->feedback_vector()->ClearOsrCode(
+        compilation_info->osr_offset());
+    return CompilationJob::FAILED;
+  }
   compilation_info->closure()->set_code(shared->GetCode());
   // Clear the InOptimizationQueue marker, if it exists.
   if (compilation_info->closure()->IsInOptimizationQueue()) {
@@ -1853,8 +1921,15 @@ MaybeHandle<Code> Compiler::GetOptimizedCodeForOSR(Handle<JSFunction> function,
                                                    JavaScriptFrame* osr_frame) {
   DCHECK(!osr_offset.IsNone());
   DCHECK_NOT_NULL(osr_frame);
-  return GetOptimizedCode(function, ConcurrencyMode::kNotConcurrent, osr_offset,
-                          osr_frame);
+  // Concurrent OSR code has to be cached to reach the interpreter, which is
+  // not possible if it is specialized to the function context.
+  ConcurrencyMode mode = ConcurrencyMode::kNotConcurrent;
+  if (FLAG_concurrent_osr &&
+      function->GetIsolate()->concurrent_recompilation_enabled() &&
+      !FLAG_function_context_specialization) {
+    mode = ConcurrencyMode::kConcurrent;
+  }
+  return GetOptimizedCode(function, mode, osr_offset, osr_frame);
 }
 
 bool Compiler::FinalizeCompilationJob(OptimizedCompilationJob* raw_job,
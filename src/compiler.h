@@ -172,6 +172,9 @@ class V8_EXPORT_PRIVATE Compiler : public AllStatic {
   // instead of generating JIT code for a function at all.
 
   // Generate and return optimized code for OSR, or empty handle on failure.
+  // With --concurrent-osr the code is compiled in the background instead, and
+  // an empty handle is returned until the finished code has been put into the
+  // OSR code cache of the feedback vector.
   V8_WARN_UNUSED_RESULT static MaybeHandle<Code> GetOptimizedCodeForOSR(
       Handle<JSFunction> function, BailoutId osr_offset,
       JavaScriptFrame* osr_frame);
@@ -31,6 +31,10 @@ namespace {
 // == x64 windows ============================================================
 #define STACK_SHADOW_WORDS 4
 #define PARAM_REGISTERS rcx, rdx, r8, r9
+#define FP_PARAM_REGISTERS xmm0, xmm1, xmm2, xmm3
+#define FP_RETURN_REGISTER xmm0
+// The n-th parameter is passed in the n-th integer or floating point register.
+#define POSITIONAL_PARAM_REGISTERS 1
 #define CALLEE_SAVE_REGISTERS                                             \
   rbx.bit() | rdi.bit() | rsi.bit() | r12.bit() | r13.bit() | r14.bit() | \
       r15.bit()
@@ -42,6 +46,8 @@ namespace {
 #else
 // == x64 other ==============================================================
 #define PARAM_REGISTERS rdi, rsi, rdx, rcx, r8, r9
+#define FP_PARAM_REGISTERS xmm0, xmm1, xmm2, xmm3, xmm4, xmm5, xmm6, xmm7
+#define FP_RETURN_REGISTER xmm0
 #define CALLEE_SAVE_REGISTERS \
   rbx.bit() | r12.bit() | r13.bit() | r14.bit() | r15.bit()
 #endif
@@ -150,17 +156,19 @@ CallDescriptor* Linkage::GetSimplifiedCDescriptor(
   LocationSignature::Builder locations(zone, msig->return_count(),
                                        msig->parameter_count());
   // Check the types of the signature.
-  // Currently no floating point parameters or returns are allowed because
-  // on ia32, the FP top of stack is involved.
+  // Floating point parameters or returns are only allowed on platforms that
+  // define FP_PARAM_REGISTERS, because e.g. on ia32, the FP top of stack is
+  // involved.
   for (size_t i = 0; i < msig->return_count(); i++) {
     MachineRepresentation rep = msig->GetReturn(i).representation();
-    CHECK_NE(MachineRepresentation::kFloat32, rep);
-    CHECK_NE(MachineRepresentation::kFloat64, rep);
+    if (IsFloatingPoint(rep)) {
+      CHECK(SupportsFloatingPointCParameters());
+      CHECK_EQ(1u, msig->return_count());
+    }
   }
   for (size_t i = 0; i < msig->parameter_count(); i++) {
     MachineRepresentation rep = msig->GetParam(i).representation();
-    CHECK_NE(MachineRepresentation::kFloat32, rep);
-    CHECK_NE(MachineRepresentation::kFloat64, rep);
+    if (IsFloatingPoint(rep)) CHECK(SupportsFloatingPointCParameters());
   }
 
 #ifdef UNSUPPORTED_C_LINKAGE
@@ -173,8 +181,17 @@ CallDescriptor* Linkage::GetSimplifiedCDescriptor(
   CHECK_GE(2, locations.return_count_);
 
   if (locations.return_count_ > 0) {
-    locations.AddReturn(LinkageLocation::ForRegister(kReturnRegister0.code(),
-                                                     msig->GetReturn(0)));
+    MachineType type = msig->GetReturn(0);
+#ifdef FP_RETURN_REGISTER
+    if (IsFloatingPoint(type.representation())) {
+      locations.AddReturn(
+          LinkageLocation::ForRegister(FP_RETURN_REGISTER.code(), type));
+    }
+#endif
+    if (!IsFloatingPoint(type.representation())) {
+      locations.AddReturn(
+          LinkageLocation::ForRegister(kReturnRegister0.code(), type));
+    }
   }
   if (locations.return_count_ > 1) {
     locations.AddReturn(LinkageLocation::ForRegister(kReturnRegister1.code(),
@@ -191,21 +208,42 @@ CallDescriptor* Linkage::GetSimplifiedCDescriptor(
   const int kParamRegisterCount = 0;
 #endif
 
+#ifdef FP_PARAM_REGISTERS
+  const DoubleRegister kFPParamRegisters[] = {FP_PARAM_REGISTERS};
+  const int kFPParamRegisterCount =
+      static_cast<int>(arraysize(kFPParamRegisters));
+#else
+  const DoubleRegister* kFPParamRegisters = nullptr;
+  const int kFPParamRegisterCount = 0;
+#endif
+
 #ifdef STACK_SHADOW_WORDS
   int stack_offset = STACK_SHADOW_WORDS;
 #else
   int stack_offset = 0;
 #endif
   // Add register and/or stack parameter(s).
+  int gp_index = 0;
+  int fp_index = 0;
   for (int i = 0; i < parameter_count; i++) {
-    if (i < kParamRegisterCount) {
-      locations.AddParam(LinkageLocation::ForRegister(kParamRegisters[i].code(),
-                                                      msig->GetParam(i)));
-    } else {
-      locations.AddParam(LinkageLocation::ForCallerFrameSlot(
-          -1 - stack_offset, msig->GetParam(i)));
-      stack_offset++;
+    MachineType type = msig->GetParam(i);
+#ifdef POSITIONAL_PARAM_REGISTERS
+    gp_index = fp_index = i;
+#endif
+    if (IsFloatingPoint(type.representation())) {
+      if (fp_index < kFPParamRegisterCount) {
+        locations.AddParam(LinkageLocation::ForRegister(
+            kFPParamRegisters[fp_index++].code(), type));
+        continue;
+      }
+    } else if (gp_index < kParamRegisterCount) {
+      locations.AddParam(LinkageLocation::ForRegister(
+          kParamRegisters[gp_index++].code(), type));
+      continue;
     }
+    locations.AddParam(
+        LinkageLocation::ForCallerFrameSlot(-1 - stack_offset, type));
+    stack_offset++;
   }
 
 #ifdef CALLEE_SAVE_REGISTERS
@@ -240,6 +278,14 @@ CallDescriptor* Linkage::GetSimplifiedCDescriptor(
       flags, "c-call");
 }
 
+bool Linkage::SupportsFloatingPointCParameters() {
+#ifdef FP_PARAM_REGISTERS
+  return true;
+#else
+  return false;
+#endif
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
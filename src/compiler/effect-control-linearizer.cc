@@ -4790,19 +4790,21 @@ Node* EffectControlLinearizer::LowerFindOrderedHashMapEntryForInt32Key(
 
   Node* number_of_buckets = ChangeSmiToIntPtr(__ LoadField(
       AccessBuilder::ForOrderedHashTableBaseNumberOfBuckets(), table));
-  hash = __ WordAnd(hash, __ IntSub(number_of_buckets, __ IntPtrConstant(1)));
-  Node* first_entry = ChangeSmiToIntPtr(__ Load(
-      MachineType::TaggedSigned(), table,
-      __ IntAdd(__ WordShl(hash, __ IntPtrConstant(kPointerSizeLog2)),
-                __ IntPtrConstant(OrderedHashMap::kHashTableStartOffset -
-                                  kHeapObjectTag))));
+  Node* mask = __ IntSub(number_of_buckets, __ IntPtrConstant(1));
+  Node* first_bucket = __ WordAnd(hash, mask);
 
+  // Probe the buckets until the key or an unused bucket is found.
   auto loop = __ MakeLoopLabel(MachineType::PointerRepresentation());
   auto done = __ MakeLabel(MachineRepresentation::kWord32);
-  __ Goto(&loop, first_entry);
+  __ Goto(&loop, first_bucket);
   __ Bind(&loop);
   {
-    Node* entry = loop.PhiAt(0);
+    Node* bucket = loop.PhiAt(0);
+    Node* entry = ChangeSmiToIntPtr(__ Load(
+        MachineType::TaggedSigned(), table,
+        __ IntAdd(__ WordShl(bucket, __ IntPtrConstant(kPointerSizeLog2)),
+                  __ IntPtrConstant(OrderedHashMap::kHashTableStartOffset -
+                                    kHeapObjectTag))));
     Node* check =
         __ WordEqual(entry, __ IntPtrConstant(OrderedHashMap::kNotFound));
     __ GotoIf(check, &done, __ Int32Constant(-1));
@@ -4841,14 +4843,9 @@ Node* EffectControlLinearizer::LowerFindOrderedHashMapEntryForInt32Key(
 
     __ Bind(&if_notmatch);
     {
-      Node* next_entry = ChangeSmiToIntPtr(__ Load(
-          MachineType::TaggedSigned(), table,
-          __ IntAdd(
-              __ WordShl(entry, __ IntPtrConstant(kPointerSizeLog2)),
-              __ IntPtrConstant(OrderedHashMap::kHashTableStartOffset +
-                                OrderedHashMap::kChainOffset * kPointerSize -
-                                kHeapObjectTag))));
-      __ Goto(&loop, next_entry);
+      Node* next_bucket =
+          __ WordAnd(__ IntAdd(bucket, __ IntPtrConstant(1)), mask);
+      __ Goto(&loop, next_bucket);
     }
   }
 
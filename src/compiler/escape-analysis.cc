@@ -498,20 +498,76 @@ int OffsetOfFieldAccess(const Operator* op) {
   return access.offset;
 }
 
-Maybe<int> OffsetOfElementsAccess(const Operator* op, Node* index_node) {
+int OffsetOfElementsAccess(const Operator* op, int index) {
   DCHECK(op->opcode() == IrOpcode::kLoadElement ||
          op->opcode() == IrOpcode::kStoreElement);
+  ElementAccess access = ElementAccessOf(op);
+  DCHECK_GE(ElementSizeLog2Of(access.machine_type.representation()),
+            kPointerSizeLog2);
+  return access.header_size +
+         (index << ElementSizeLog2Of(access.machine_type.representation()));
+}
+
+Maybe<int> OffsetOfElementsAccess(const Operator* op, Node* index_node) {
   Type index_type = NodeProperties::GetType(index_node);
   if (!index_type.Is(Type::OrderedNumber())) return Nothing<int>();
   double max = index_type.Max();
   double min = index_type.Min();
   int index = static_cast<int>(min);
   if (!(index == min && index == max)) return Nothing<int>();
-  ElementAccess access = ElementAccessOf(op);
-  DCHECK_GE(ElementSizeLog2Of(access.machine_type.representation()),
-            kPointerSizeLog2);
-  return Just(access.header_size + (index << ElementSizeLog2Of(
-                                        access.machine_type.representation())));
+  return Just(OffsetOfElementsAccess(op, index));
+}
+
+// Maximum number of elements of a virtual object for which a LoadElement with
+// a non-constant index is turned into a chain of Select operations.
+const int kMaxElementsForVariableIndexLoad = 4;
+
+// Tries to reduce a LoadElement {op} with a non-constant {index} from the
+// virtual object {vobject}. The {index} has been bounds checked against the
+// length of the {vobject}, so the load must yield one of its elements. For
+// small objects we can therefore select the element based on the {index}
+// while keeping the {vobject} itself scalar replaced. Returns false if the
+// load cannot be reduced, in which case the object has to escape.
+bool ReduceLoadElementWithVariableIndex(const Operator* op, Node* index,
+                                        const VirtualObject* vobject,
+                                        EscapeAnalysisTracker::Scope* current,
+                                        JSGraph* jsgraph) {
+  ElementAccess const& access = ElementAccessOf(op);
+  int const length = (vobject->size() - access.header_size) >>
+                     ElementSizeLog2Of(access.machine_type.representation());
+  if (length < 1 || length > kMaxElementsForVariableIndexLoad) return false;
+  Node* values[kMaxElementsForVariableIndexLoad];
+  for (int i = 0; i < length; ++i) {
+    Variable var;
+    if (!vobject->FieldAt(OffsetOfElementsAccess(op, i)).To(&var) ||
+        !current->Get(var).To(&values[i])) {
+      return false;
+    }
+    // If the variable has no value, we have not reached the fixed-point yet.
+    if (values[i] == nullptr) return true;
+    if (values[i] == jsgraph->Dead() ||
+        !NodeProperties::GetType(values[i]).Is(access.type)) {
+      return false;
+    }
+  }
+  // Build {index} == 0 ? values[0] : ... : values[length - 1], where the
+  // last element needs no check since the {index} is known to be in bounds.
+  Node* replacement = values[length - 1];
+  for (int i = length - 2; i >= 0; --i) {
+    Node* check =
+        jsgraph->graph()->NewNode(jsgraph->simplified()->NumberEqual(), index,
+                                  jsgraph->Constant(i));
+    NodeProperties::SetType(check, Type::Boolean());
+    replacement = jsgraph->graph()->NewNode(
+        jsgraph->common()->Select(access.machine_type.representation()), check,
+        values[i], replacement);
+    NodeProperties::SetType(replacement, access.type);
+  }
+  current->SetReplacement(replacement);
+  // The elements are now used by the Select nodes, whose inputs we do not
+  // track, so they have to be materialized.
+  for (int i = 0; i < length; ++i) current->SetEscaped(values[i]);
+  return true;
 }
 
 Node* LowerCompareMapsWithoutLoad(Node* checked_map,
@@ -612,13 +668,19 @@ void ReduceNode(const Operator* op, EscapeAnalysisTracker::Scope* current,
       int offset;
       Variable var;
       Node* value;
-      if (vobject && !vobject->HasEscaped() &&
-          OffsetOfElementsAccess(op, index).To(&offset) &&
-          vobject->FieldAt(offset).To(&var) && current->Get(var).To(&value)) {
-        current->SetReplacement(value);
-      } else {
-        current->SetEscaped(object);
+      if (vobject && !vobject->HasEscaped()) {
+        if (OffsetOfElementsAccess(op, index).To(&offset)) {
+          if (vobject->FieldAt(offset).To(&var) &&
+              current->Get(var).To(&value)) {
+            current->SetReplacement(value);
+            break;
+          }
+        } else if (ReduceLoadElementWithVariableIndex(op, index, vobject,
+                                                      current, jsgraph)) {
+          break;
+        }
       }
+      current->SetEscaped(object);
       break;
     }
     case IrOpcode::kTypeGuard: {
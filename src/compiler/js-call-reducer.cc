@@ -4,7 +4,9 @@
 
 #include "src/compiler/js-call-reducer.h"
 
+#include "include/v8-fast-api-calls.h"
 #include "src/api-inl.h"
+#include "src/builtins/builtins-async-gen.h"
 #include "src/builtins/builtins-promise-gen.h"
 #include "src/builtins/builtins-utils.h"
 #include "src/code-factory.h"
@@ -2933,6 +2935,19 @@ Reduction JSCallReducer::ReduceCallApiFunction(
     }
   }
 
+  Node* holder = lookup == CallOptimization::kHolderFound
+                     ? jsgraph()->HeapConstant(api_holder)
+                     : receiver;
+
+  // Try to call the C function registered for the {function_template_info}
+  // directly, without going through the CallApiCallbackStub.
+  if (function_template_info->c_function()->IsForeign() &&
+      p.speculation_mode() == SpeculationMode::kAllowSpeculation) {
+    Reduction const reduction =
+        ReduceCallFastApiFunction(node, function_template_info, holder);
+    if (reduction.Changed()) return reduction;
+  }
+
   // Load the {target}s context.
   Node* context = effect = graph()->NewNode(
       simplified()->LoadField(AccessBuilder::ForJSFunctionContext()), target,
@@ -2953,9 +2968,6 @@ Reduction JSCallReducer::ReduceCallApiFunction(
       cid.GetStackParameterCount() + argc + 1 /* implicit receiver */,
       CallDescriptor::kNeedsFrameState);
   ApiFunction api_function(v8::ToCData<Address>(call_handler_info->callback()));
-  Node* holder = lookup == CallOptimization::kHolderFound
-                     ? jsgraph()->HeapConstant(api_holder)
-                     : receiver;
   ExternalReference function_reference = ExternalReference::Create(
       &api_function, ExternalReference::DIRECT_API_CALL);
   node->InsertInput(graph()->zone(), 0,
@@ -2974,6 +2986,124 @@ Reduction JSCallReducer::ReduceCallApiFunction(
 
 namespace {
 
+MachineType MachineTypeForCType(CTypeInfo::Type type) {
+  switch (type) {
+    case CTypeInfo::Type::kInt32:
+      return MachineType::Int32();
+    case CTypeInfo::Type::kUint32:
+      return MachineType::Uint32();
+    case CTypeInfo::Type::kFloat64:
+      return MachineType::Float64();
+    case CTypeInfo::Type::kV8Value:
+      return MachineType::AnyTagged();
+    case CTypeInfo::Type::kVoid:
+      break;
+  }
+  UNREACHABLE();
+}
+
+}  // namespace
+
+Reduction JSCallReducer::ReduceCallFastApiFunction(
+    Node* node, Handle<FunctionTemplateInfo> function_template_info,
+    Node* holder) {
+  DCHECK_EQ(IrOpcode::kJSCall, node->opcode());
+  CallParameters const& p = CallParametersOf(node->op());
+  int const argc = static_cast<int>(p.arity()) - 2;
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+
+  const CFunctionInfo* c_signature =
+      v8::ToCData<const CFunctionInfo*>(function_template_info->c_signature());
+
+  // The C function takes the {holder} plus exactly the arguments of the call.
+  if (static_cast<int>(c_signature->ArgumentCount()) != argc + 1) {
+    return NoChange();
+  }
+  DCHECK_EQ(CTypeInfo::Type::kV8Value,
+            c_signature->ArgumentInfo(0).GetType());
+
+  CTypeInfo::Type const return_type = c_signature->ReturnInfo().GetType();
+  if (!Linkage::SupportsFloatingPointCParameters()) {
+    if (return_type == CTypeInfo::Type::kFloat64) return NoChange();
+    for (int i = 0; i < argc; ++i) {
+      if (c_signature->ArgumentInfo(i + 1).GetType() ==
+          CTypeInfo::Type::kFloat64) {
+        return NoChange();
+      }
+    }
+  }
+  int const return_count = return_type == CTypeInfo::Type::kVoid ? 0 : 1;
+  MachineSignature::Builder builder(graph()->zone(), return_count, argc + 1);
+  if (return_count > 0) builder.AddReturn(MachineTypeForCType(return_type));
+  builder.AddParam(MachineTypeForCType(CTypeInfo::Type::kV8Value));
+
+  // Check that the arguments can be passed to the C function. Integer
+  // parameters are only passed Smis and double parameters only numbers,
+  // everything else deoptimizes, and the call site then uses the regular
+  // callback from now on, since it no longer allows speculation.
+  std::vector<Node*> inputs;
+  inputs.push_back(jsgraph()->ExternalConstant(ExternalReference::Create(
+      v8::ToCData<Address>(function_template_info->c_function()))));
+  inputs.push_back(holder);
+  for (int i = 0; i < argc; ++i) {
+    CTypeInfo::Type const type = c_signature->ArgumentInfo(i + 1).GetType();
+    Node* value = NodeProperties::GetValueInput(node, 2 + i);
+    switch (type) {
+      case CTypeInfo::Type::kInt32:
+      case CTypeInfo::Type::kUint32:
+        value = effect = graph()->NewNode(simplified()->CheckSmi(p.feedback()),
+                                          value, effect, control);
+        break;
+      case CTypeInfo::Type::kFloat64:
+        value = effect = graph()->NewNode(
+            simplified()->CheckNumber(p.feedback()), value, effect, control);
+        break;
+      case CTypeInfo::Type::kV8Value:
+      case CTypeInfo::Type::kVoid:
+        UNREACHABLE();
+    }
+    builder.AddParam(MachineTypeForCType(type));
+    inputs.push_back(value);
+  }
+
+  // The C function cannot throw or call back into JavaScript, so it doesn't
+  // need a frame state.
+  CallDescriptor* call_descriptor =
+      Linkage::GetSimplifiedCDescriptor(graph()->zone(), builder.Build());
+  inputs.push_back(effect);
+  inputs.push_back(control);
+  Node* value = effect =
+      graph()->NewNode(common()->Call(call_descriptor),
+                       static_cast<int>(inputs.size()), inputs.data());
+
+  // Tell the typer about the range of the result.
+  switch (return_type) {
+    case CTypeInfo::Type::kVoid:
+      value = jsgraph()->UndefinedConstant();
+      break;
+    case CTypeInfo::Type::kInt32:
+      value = effect = graph()->NewNode(common()->TypeGuard(Type::Signed32()),
+                                        value, effect, control);
+      break;
+    case CTypeInfo::Type::kUint32:
+      value = effect = graph()->NewNode(
+          common()->TypeGuard(Type::Unsigned32()), value, effect, control);
+      break;
+    case CTypeInfo::Type::kFloat64:
+      value = effect = graph()->NewNode(common()->TypeGuard(Type::Number()),
+                                        value, effect, control);
+      break;
+    case CTypeInfo::Type::kV8Value:
+      UNREACHABLE();
+  }
+
+  ReplaceWithValue(node, value, effect, control);
+  return Replace(value);
+}
+
+namespace {
+
 // Check whether elements aren't mutated; we play it extremely safe here by
 // explicitly checking that {node} is only used by {LoadField} or {LoadElement}.
 bool IsSafeArgumentsElements(Node* node) {
@@ -3658,6 +3788,9 @@ Reduction JSCallReducer::ReduceJSCall(Node* node,
       return ReduceArrayIterator(node, IterationKind::kKeys);
     case Builtins::kTypedArrayPrototypeValues:
       return ReduceArrayIterator(node, IterationKind::kValues);
+    case Builtins::kAsyncFunctionAwaitCaughtOptimized:
+    case Builtins::kAsyncFunctionAwaitUncaughtOptimized:
+      return ReduceAsyncFunctionAwait(node);
     case Builtins::kAsyncFunctionPromiseCreate:
       return ReduceAsyncFunctionPromiseCreate(node);
     case Builtins::kAsyncFunctionPromiseRelease:
@@ -5475,6 +5608,99 @@ Reduction JSCallReducer::ReduceStringPrototypeConcat(
   return Replace(value);
 }
 
+// ES section #await
+Reduction JSCallReducer::ReduceAsyncFunctionAwait(Node* node) {
+  DCHECK_EQ(IrOpcode::kJSCall, node->opcode());
+  CallParameters const& p = CallParametersOf(node->op());
+  if (p.arity() != 5) return NoChange();
+  Node* generator = NodeProperties::GetValueInput(node, 2);
+  Node* value = NodeProperties::GetValueInput(node, 3);
+  Node* outer_promise = NodeProperties::GetValueInput(node, 4);
+  Node* context = NodeProperties::GetContextInput(node);
+  Node* frame_state = NodeProperties::GetFrameStateInput(node);
+  Node* effect = NodeProperties::GetEffectInput(node);
+  Node* control = NodeProperties::GetControlInput(node);
+
+  // The caught and uncaught versions only differ in the catch prediction
+  // for the debugger, and the throwaway promise is only needed for the
+  // promise hooks and the debugger.
+  if (!isolate()->IsPromiseHookProtectorIntact()) return NoChange();
+
+  // Check if the @@species protector is intact. The @@species protector
+  // guards the "constructor" lookup on all JSPromise instances and the
+  // initial Promise.prototype.
+  if (!isolate()->IsPromiseSpeciesLookupChainIntact()) return NoChange();
+
+  // We only inline the await if {value} is known to be a native JSPromise,
+  // for which PromiseResolve(%Promise%, value) is just {value}. Otherwise the
+  // "constructor" or "then" lookups can call into user code. There's no
+  // CallIC feedback for the await builtins, so we don't speculate on the
+  // {value_maps} either.
+  ZoneHandleSet<Map> value_maps;
+  NodeProperties::InferReceiverMapsResult infer_value_maps_result =
+      NodeProperties::InferReceiverMaps(isolate(), value, effect, &value_maps);
+  if (infer_value_maps_result != NodeProperties::kReliableReceiverMaps) {
+    return NoChange();
+  }
+  DCHECK_NE(0, value_maps.size());
+
+  // Check whether all {value_maps} are JSPromise maps and
+  // have the initial Promise.prototype as their [[Prototype]].
+  for (Handle<Map> value_map : value_maps) {
+    if (!value_map->IsJSPromiseMap()) return NoChange();
+    if (value_map->prototype() != native_context()->promise_prototype()) {
+      return NoChange();
+    }
+  }
+
+  dependencies()->DependOnProtector(
+      PropertyCellRef(js_heap_broker(), factory()->promise_hook_protector()));
+  dependencies()->DependOnProtector(PropertyCellRef(
+      js_heap_broker(), factory()->promise_species_protector()));
+
+  // Allocate the context for the closures that resume the {generator}.
+  Node* await_context = effect =
+      graph()->NewNode(javascript()->CreateFunctionContext(
+                           handle(native_context()->scope_info(), isolate()),
+                           AsyncBuiltinsAssembler::kAwaitContextLength -
+                               Context::MIN_CONTEXT_SLOTS,
+                           FUNCTION_SCOPE),
+                       context, effect, control);
+  effect =
+      graph()->NewNode(simplified()->StoreField(AccessBuilder::ForContextSlot(
+                           AsyncBuiltinsAssembler::kAwaitGeneratorSlot)),
+                       await_context, generator, effect, control);
+
+  // Allocate the closure for the resolve case.
+  Handle<SharedFunctionInfo> resolve_shared(
+      native_context()->async_function_await_resolve_shared_fun(), isolate());
+  Node* on_resolve = effect =
+      graph()->NewNode(javascript()->CreateClosure(
+                           resolve_shared, factory()->many_closures_cell(),
+                           handle(resolve_shared->GetCode(), isolate())),
+                       await_context, effect, control);
+
+  // Allocate the closure for the reject case.
+  Handle<SharedFunctionInfo> reject_shared(
+      native_context()->async_function_await_reject_shared_fun(), isolate());
+  Node* on_reject = effect =
+      graph()->NewNode(javascript()->CreateClosure(
+                           reject_shared, factory()->many_closures_cell(),
+                           handle(reject_shared->GetCode(), isolate())),
+                       await_context, effect, control);
+
+  // Chain the closures onto {value} directly, without a throwaway promise.
+  effect = graph()->NewNode(javascript()->PerformPromiseThen(), value,
+                            on_resolve, on_reject,
+                            jsgraph()->UndefinedConstant(), context,
+                            frame_state, effect, control);
+
+  // The await builtins return the {outer_promise}, so that it doesn't have
+  // to be reloaded before suspending.
+  ReplaceWithValue(node, outer_promise, effect, control);
+  return Replace(outer_promise);
+}
+
 Reduction JSCallReducer::ReduceAsyncFunctionPromiseCreate(Node* node) {
   DCHECK_EQ(IrOpcode::kJSCall, node->opcode());
   Node* context = NodeProperties::GetContextInput(node);
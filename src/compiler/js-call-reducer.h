@@ -60,6 +60,9 @@ class V8_EXPORT_PRIVATE JSCallReducer final : public AdvancedReducer {
   Reduction ReduceBooleanConstructor(Node* node);
   Reduction ReduceCallApiFunction(Node* node,
                                   Handle<SharedFunctionInfo> shared);
+  Reduction ReduceCallFastApiFunction(
+      Node* node, Handle<FunctionTemplateInfo> function_template_info,
+      Node* holder);
   Reduction ReduceFunctionPrototypeApply(Node* node);
   Reduction ReduceFunctionPrototypeBind(Node* node);
   Reduction ReduceFunctionPrototypeCall(Node* node);
@@ -134,6 +137,7 @@ class V8_EXPORT_PRIVATE JSCallReducer final : public AdvancedReducer {
   Reduction ReduceStringPrototypeConcat(Node* node,
                                         Handle<SharedFunctionInfo> shared);
 
+  Reduction ReduceAsyncFunctionAwait(Node* node);
   Reduction ReduceAsyncFunctionPromiseCreate(Node* node);
   Reduction ReduceAsyncFunctionPromiseRelease(Node* node);
   Reduction ReducePromiseConstructor(Node* node);
@@ -1386,10 +1386,16 @@ Reduction JSCreateLowering::ReduceJSCreateObject(Node* node) {
             jsgraph()->SmiConstant(PropertyDetails::kInitialIndex));
     a.Store(AccessBuilder::ForDictionaryObjectHashIndex(),
             jsgraph()->SmiConstant(PropertyArray::kNoHashSentinel));
+    // The initial capacity is too small for a control table.
+    STATIC_ASSERT(NameDictionary::kControlTableIndex ==
+                  NameDictionary::kObjectHashIndex + 1);
+    a.Store(AccessBuilder::ForFixedArraySlot(
+                NameDictionary::kControlTableIndex, kNoWriteBarrier),
+            jsgraph()->SmiConstant(0));
     // Initialize the Properties fields.
     Node* undefined = jsgraph()->UndefinedConstant();
     STATIC_ASSERT(NameDictionary::kElementsStartIndex ==
-                  NameDictionary::kObjectHashIndex + 1);
+                  NameDictionary::kControlTableIndex + 1);
     for (int index = NameDictionary::kElementsStartIndex; index < length;
          index++) {
       a.Store(AccessBuilder::ForFixedArraySlot(index, kNoWriteBarrier),
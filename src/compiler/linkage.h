@@ -399,12 +399,16 @@ class V8_EXPORT_PRIVATE Linkage : public NON_EXPORTED_BASE(ZoneObject) {
 
   // Creates a call descriptor for simplified C calls that is appropriate
   // for the host platform. This simplified calling convention only supports
-  // integers and pointers of one word size each, i.e. no floating point,
-  // structs, pointers to members, etc.
+  // integers and pointers of one word size each, i.e. no structs, pointers to
+  // members, etc., and floating point values only where
+  // SupportsFloatingPointCParameters() is true.
   static CallDescriptor* GetSimplifiedCDescriptor(
       Zone* zone, const MachineSignature* sig,
       bool set_initialize_root_flag = false);
 
+  // Whether simplified C calls can pass and return floating point values.
+  static bool SupportsFloatingPointCParameters();
+
   // Get the location of an (incoming) parameter to this function.
   LinkageLocation GetParameterLocation(int index) const {
     return incoming_->GetInputLocation(index + 1);  // + 1 to skip target.
@@ -0,0 +1,738 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/compiler/loop-vectorizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "src/base/v8-fallthrough.h"
+#include "src/compiler/common-operator.h"
+#include "src/compiler/graph.h"
+#include "src/compiler/js-graph.h"
+#include "src/compiler/machine-operator.h"
+#include "src/compiler/node-matchers.h"
+#include "src/compiler/node-properties.h"
+#include "src/compiler/node.h"
+#include "src/compiler/simplified-operator.h"
+#include "src/conversions-inl.h"
+#include "src/zone/zone-containers.h"
+
+// The vectorizer turns a loop that has been peeled and lowered into
+//
+//             E
+//             |
+//      ((=====P'=================))      peeled iteration
+//             |
+//           guard ---------------+       i0 >= 0, n <= lengths, no
+//             |                  |       partial overlaps
+//   +----> ( Loop )              |
+//   |         |                  |
+//   |    vi < n - 3 ----------+  |       vector loop, with the stack
+//   |         |               |  |       check and 128-bit loads and
+//   +---- vector body         |  |       stores at vi, vi + 1, ...
+//                             |  |
+//                            Merge       i = phi(i0, vi)
+//                              |
+//                   +----> ( Loop )      original loop, which does the
+//                   |         |          remaining iterations
+//                   +---- scalar body
+//
+// The original loop keeps all of its checks, so it can still deoptimize as
+// before. The vector loop has no checks other than the stack check, whose
+// frame state is the one of the original loop for the current vi, i.e. a
+// lazy deoptimization there resumes the interpreter right before the first
+// element that the vector loop hasn't done yet.
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+#define TRACE(...)                                  \
+  do {                                              \
+    if (FLAG_trace_turbo_loop) PrintF(__VA_ARGS__); \
+  } while (false)
+
+struct LoopVectorizer::Candidate {
+  explicit Candidate(Zone* zone)
+      : loop(nullptr),
+        loop_node(nullptr),
+        phi(nullptr),
+        effect_phi(nullptr),
+        stack_check(nullptr),
+        bound(nullptr),
+        lane(MachineRepresentation::kNone),
+        chain(zone),
+        lengths(zone),
+        accesses(zone),
+        known(zone),
+        values(zone),
+        checks(zone),
+        vectors(zone) {}
+
+  LoopTree::Loop* loop;
+  Node* loop_node;
+  Node* phi;          // The induction variable.
+  Node* effect_phi;
+  Node* stack_check;  // The start of the loop body.
+  Node* bound;        // The upper bound of the induction variable.
+  MachineRepresentation lane;
+  ZoneVector<Node*> chain;     // The effect chain of the loop, in order.
+  ZoneVector<Node*> lengths;   // The lengths checked against the phi.
+  ZoneVector<Node*> accesses;  // The typed element loads and stores.
+  ZoneSet<Node*> known;        // Control, effect and index nodes.
+  ZoneSet<Node*> values;       // Nodes computing the stored values.
+  ZoneMap<Node*, Node*> checks;  // Checks repeating one before the loop.
+  ZoneMap<Node*, Node*> vectors;
+};
+
+namespace {
+
+bool IsSameArray(Node* a, Node* b) {
+  // The buffer, base and external inputs of a typed element access.
+  for (int i = 0; i < 3; ++i) {
+    if (a->InputAt(i) != b->InputAt(i)) return false;
+  }
+  return true;
+}
+
+bool IsFloat32Operand(Node* node) {
+  // A float64 constant that converts to float32 and back without loss.
+  if (node->opcode() != IrOpcode::kFloat64Constant) return false;
+  double value = OpParameter<double>(node->op());
+  return std::isnan(value) || DoubleToFloat32(value) == value;
+}
+
+}  // namespace
+
+void LoopVectorizer::VectorizeInnerLoopsOfTree() {
+  for (LoopTree::Loop* loop : loop_tree_->outer_loops()) {
+    VectorizeInnerLoops(loop);
+  }
+}
+
+void LoopVectorizer::VectorizeInnerLoops(LoopTree::Loop* loop) {
+  // Vectorize only innermost loops.
+  if (!loop->children().empty()) {
+    for (LoopTree::Loop* inner_loop : loop->children()) {
+      VectorizeInnerLoops(inner_loop);
+    }
+    return;
+  }
+  Candidate candidate(tmp_zone_);
+  if (Match(loop, &candidate)) Vectorize(&candidate);
+}
+
+bool LoopVectorizer::IsInvariant(Node* node, Candidate* c) {
+  return !loop_tree_->Contains(c->loop, node);
+}
+
+Node* LoopVectorizer::FindCheckBeforeLoop(Node* check, Candidate* c) {
+  // Look for the same check of the same value on the effect chain leading
+  // into the loop, which is usually the one of the peeled iteration. For the
+  // Smi conversion any Smi check will do.
+  Node* value = check->InputAt(0);
+  Node* effect = NodeProperties::GetEffectInput(c->effect_phi);
+  while (effect->op()->EffectInputCount() == 1) {
+    if (effect->op()->ValueInputCount() > 0 && effect->InputAt(0) == value) {
+      if (effect->op()->Equals(check->op())) return effect;
+      if (check->opcode() == IrOpcode::kCheckedTaggedSignedToInt32) {
+        switch (effect->opcode()) {
+          case IrOpcode::kCheckSmi:
+          case IrOpcode::kCheckedTaggedToTaggedSigned:
+            return effect;
+          default:
+            break;
+        }
+      }
+    }
+    effect = NodeProperties::GetEffectInput(effect);
+  }
+  return nullptr;
+}
+
+bool LoopVectorizer::Match(LoopTree::Loop* loop, Candidate* c) {
+  if (loop->TotalSize() > kMaxLoopNodes) return false;
+  c->loop = loop;
+  Node* loop_node = c->loop_node = loop_tree_->GetLoopControl(loop);
+  if (loop_node->InputCount() != 2) return false;
+
+  // The header has to consist of a word32 induction variable and the effect
+  // phi.
+  for (Node* node : loop_tree_->HeaderNodes(loop)) {
+    switch (node->opcode()) {
+      case IrOpcode::kLoop:
+        break;
+      case IrOpcode::kPhi:
+        if (c->phi != nullptr ||
+            PhiRepresentationOf(node->op()) != MachineRepresentation::kWord32) {
+          return false;
+        }
+        c->phi = node;
+        break;
+      case IrOpcode::kEffectPhi:
+        if (c->effect_phi != nullptr) return false;
+        c->effect_phi = node;
+        break;
+      default:
+        return false;
+    }
+    c->known.insert(node);
+  }
+  if (c->phi == nullptr || c->effect_phi == nullptr) return false;
+
+  // The body starts with the stack check on the true branch of the loop
+  // condition, and has no further control flow.
+  Node* stack_check = c->stack_check = loop_node->InputAt(1);
+  if (stack_check->opcode() != IrOpcode::kJSStackCheck) return false;
+  Node* if_true = NodeProperties::GetControlInput(stack_check);
+  if (if_true->opcode() != IrOpcode::kIfTrue) return false;
+  Node* branch = NodeProperties::GetControlInput(if_true);
+  if (branch->opcode() != IrOpcode::kBranch ||
+      NodeProperties::GetControlInput(branch) != loop_node) {
+    return false;
+  }
+  c->known.insert(if_true);
+  c->known.insert(branch);
+
+  // Collect the effect chain, which has to be linear.
+  for (Node* effect = NodeProperties::GetEffectInput(c->effect_phi, 1);
+       effect != c->effect_phi;
+       effect = NodeProperties::GetEffectInput(effect)) {
+    if (effect->op()->EffectInputCount() != 1 || IsInvariant(effect, c)) {
+      return false;
+    }
+    c->chain.push_back(effect);
+  }
+  std::reverse(c->chain.begin(), c->chain.end());
+
+  bool in_body = false;
+  bool has_store = false;
+  for (Node* node : c->chain) {
+    if (node == stack_check) {
+      if (!IsInvariant(NodeProperties::GetContextInput(node), c) ||
+          !MatchState(NodeProperties::GetFrameStateInput(node), c)) {
+        return false;
+      }
+      c->known.insert(node);
+      in_body = true;
+      continue;
+    }
+    if (node->op()->ControlInputCount() != 1 ||
+        NodeProperties::GetControlInput(node) !=
+            (in_body ? stack_check : loop_node)) {
+      return false;
+    }
+    switch (node->opcode()) {
+      case IrOpcode::kCheckpoint:
+      case IrOpcode::kTypeGuard:
+        break;
+      case IrOpcode::kCheckedTaggedSignedToInt32:
+      case IrOpcode::kCheckedTaggedToFloat64: {
+        // Loop invariant values whose type isn't known in the loop are
+        // checked again in there, which is fine if they were already checked
+        // before the loop. These checks can't fail, and the vector loop just
+        // reuses or repeats the conversion.
+        Node* before = FindCheckBeforeLoop(node, c);
+        if (!IsInvariant(node->InputAt(0), c) || before == nullptr) {
+          return false;
+        }
+        c->checks[node] = before;
+        break;
+      }
+      case IrOpcode::kCheckBounds: {
+        Node* length = node->InputAt(1);
+        if (!in_body || node->InputAt(0) != c->phi ||
+            !IsInvariant(length, c)) {
+          return false;
+        }
+        if (std::find(c->lengths.begin(), c->lengths.end(), length) ==
+            c->lengths.end()) {
+          c->lengths.push_back(length);
+        }
+        break;
+      }
+      case IrOpcode::kStoreTypedElement:
+        has_store = true;
+        V8_FALLTHROUGH;
+      case IrOpcode::kLoadTypedElement: {
+        MachineRepresentation lane;
+        switch (ExternalArrayTypeOf(node->op())) {
+          case kExternalFloat32Array:
+            lane = MachineRepresentation::kFloat32;
+            break;
+          case kExternalInt32Array:
+          case kExternalUint32Array:
+            lane = MachineRepresentation::kWord32;
+            break;
+          default:
+            return false;
+        }
+        if (!in_body || (c->lane != MachineRepresentation::kNone &&
+                         c->lane != lane)) {
+          return false;
+        }
+        c->lane = lane;
+        for (int i = 0; i < 3; ++i) {
+          if (!IsInvariant(node->InputAt(i), c)) return false;
+        }
+        // The index has to be bounds checked before.
+        Node* index = node->InputAt(3);
+        if (index->opcode() != IrOpcode::kCheckBounds ||
+            c->known.count(index) == 0) {
+          return false;
+        }
+        c->accesses.push_back(node);
+        break;
+      }
+      default:
+        return false;
+    }
+    c->known.insert(node);
+  }
+  if (!in_body || !has_store) return false;
+
+  // The loop condition is i < n for some loop invariant n.
+  Node* condition = branch->InputAt(0);
+  if ((condition->opcode() != IrOpcode::kInt32LessThan &&
+       condition->opcode() != IrOpcode::kUint32LessThan) ||
+      condition->InputAt(0) != c->phi) {
+    return false;
+  }
+  Node* bound = c->bound = condition->InputAt(1);
+  if (!IsInvariant(bound, c) &&
+      (bound->opcode() != IrOpcode::kCheckedTaggedSignedToInt32 ||
+       c->checks.count(bound) == 0)) {
+    return false;
+  }
+  c->known.insert(condition);
+
+  // The induction variable is incremented by one, possibly after its bounds
+  // check.
+  Node* increment = c->phi->InputAt(1);
+  if (increment->opcode() == IrOpcode::kTypeGuard) {
+    increment = increment->InputAt(0);
+  }
+  Int32BinopMatcher m(increment);
+  if (!m.IsInt32Add() || !m.right().Is(1)) return false;
+  Node* index = m.left().node();
+  if (index != c->phi && (index->opcode() != IrOpcode::kCheckBounds ||
+                          c->known.count(index) == 0)) {
+    return false;
+  }
+  c->known.insert(increment);
+
+  for (Node* access : c->accesses) {
+    if (access->opcode() == IrOpcode::kStoreTypedElement &&
+        !MatchValue(access->InputAt(4), c)) {
+      return false;
+    }
+  }
+
+  // Everything else in the loop has to be a frame state.
+  for (Node* node : loop_tree_->LoopNodes(loop)) {
+    if (c->known.count(node) != 0 || c->values.count(node) != 0) continue;
+    switch (node->opcode()) {
+      case IrOpcode::kFrameState:
+      case IrOpcode::kStateValues:
+      case IrOpcode::kTypedStateValues:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+bool LoopVectorizer::MatchValue(Node* node, Candidate* c) {
+  if (c->values.count(node) != 0 || IsInvariant(node, c)) return true;
+  switch (node->opcode()) {
+    case IrOpcode::kLoadTypedElement:
+      return c->known.count(node) != 0;
+    case IrOpcode::kCheckedTaggedSignedToInt32:
+      return c->lane == MachineRepresentation::kWord32 &&
+             c->checks.count(node) != 0;
+    case IrOpcode::kTruncateFloat64ToWord32:
+      // A loop invariant number truncated for an int32 operation.
+      if (c->lane != MachineRepresentation::kWord32 ||
+          c->checks.count(node->InputAt(0)) == 0) {
+        return false;
+      }
+      break;
+    case IrOpcode::kTruncateFloat64ToFloat32: {
+      // The float32 arithmetic has been done in float64 and rounded back to
+      // float32. For a single addition, subtraction or multiplication this
+      // gives the same result as the float32 operation.
+      if (c->lane != MachineRepresentation::kFloat32) return false;
+      Node* input = node->InputAt(0);
+      switch (input->opcode()) {
+        case IrOpcode::kFloat64Add:
+        case IrOpcode::kFloat64Sub:
+        case IrOpcode::kFloat64Mul:
+          if (!MatchOperand(input->InputAt(0), c) ||
+              !MatchOperand(input->InputAt(1), c)) {
+            return false;
+          }
+          c->values.insert(input);
+          break;
+        default:
+          // A float32 operand or a loop invariant number rounded to float32.
+          if (c->checks.count(input) == 0 && !MatchOperand(input, c)) {
+            return false;
+          }
+          break;
+      }
+      break;
+    }
+    case IrOpcode::kInt32Add:
+    case IrOpcode::kInt32Sub:
+    case IrOpcode::kInt32Mul:
+    case IrOpcode::kWord32And:
+    case IrOpcode::kWord32Or:
+    case IrOpcode::kWord32Xor:
+      if (c->lane != MachineRepresentation::kWord32 ||
+          !MatchValue(node->InputAt(0), c) ||
+          !MatchValue(node->InputAt(1), c)) {
+        return false;
+      }
+      break;
+    case IrOpcode::kWord32Shl:
+    case IrOpcode::kWord32Sar:
+    case IrOpcode::kWord32Shr: {
+      Int32Matcher m(node->InputAt(1));
+      if (c->lane != MachineRepresentation::kWord32 || !m.IsInRange(0, 31) ||
+          !MatchValue(node->InputAt(0), c)) {
+        return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+  c->values.insert(node);
+  return true;
+}
+
+bool LoopVectorizer::MatchOperand(Node* node, Candidate* c) {
+  // A float64 operand has to be a float32 value converted to float64.
+  if (IsFloat32Operand(node)) return true;
+  if (node->opcode() != IrOpcode::kChangeFloat32ToFloat64) return false;
+  Node* input = node->InputAt(0);
+  if (!IsInvariant(input, c) &&
+      (input->opcode() != IrOpcode::kLoadTypedElement ||
+       c->known.count(input) == 0)) {
+    return false;
+  }
+  c->values.insert(node);
+  return true;
+}
+
+bool LoopVectorizer::MatchState(Node* node, Candidate* c) {
+  // The frame state of the stack check must only depend on the loop through
+  // the induction variable, so that it can be rebuilt for the vector loop.
+  if (node == c->phi || IsInvariant(node, c)) return true;
+  switch (node->opcode()) {
+    case IrOpcode::kFrameState:
+    case IrOpcode::kStateValues:
+    case IrOpcode::kTypedStateValues:
+      for (Node* input : node->inputs()) {
+        if (!MatchState(input, c)) return false;
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+void LoopVectorizer::Vectorize(Candidate* c) {
+  TRACE("Vectorizing loop %i\n", c->loop_node->id());
+
+  Node* control = NodeProperties::GetControlInput(c->loop_node, 0);
+  Node* effect = NodeProperties::GetEffectInput(c->effect_phi, 0);
+  Node* initial = c->phi->InputAt(0);
+  Node* bound = c->bound;
+  if (!IsInvariant(bound, c)) bound = BuildCheckedValue(bound, c);
+
+  // Check that the vector loop only accesses elements that the scalar loop
+  // would have checked to be in bounds, i.e. i0 >= 0 and n <= length.
+  Node* check = graph()->NewNode(machine()->Int32LessThanOrEqual(),
+                                 jsgraph()->Int32Constant(0), initial);
+  for (Node* length : c->lengths) {
+    check = graph()->NewNode(
+        machine()->Word32And(), check,
+        graph()->NewNode(machine()->Uint32LessThanOrEqual(), bound, length));
+  }
+
+  // Check that every array that is stored to is either the same as or at
+  // least a vector apart from every other array accessed in the loop. This
+  // stays true if the GC moves on-heap backing stores, as only views on the
+  // same backing store can overlap.
+  ZoneVector<Node*> storages(c->accesses.size(), nullptr, tmp_zone_);
+  auto storage = [&](size_t i) {
+    if (storages[i] == nullptr) {
+      for (size_t j = 0; j < i; ++j) {
+        if (IsSameArray(c->accesses[i], c->accesses[j]) &&
+            storages[j] != nullptr) {
+          return storages[i] = storages[j];
+        }
+      }
+      storages[i] = BuildStorage(c->accesses[i], &effect, control, false);
+    }
+    return storages[i];
+  };
+  for (size_t i = 0; i < c->accesses.size(); ++i) {
+    Node* store = c->accesses[i];
+    if (store->opcode() != IrOpcode::kStoreTypedElement) continue;
+    for (size_t j = 0; j < c->accesses.size(); ++j) {
+      Node* other = c->accesses[j];
+      if (IsSameArray(store, other) ||
+          (other->opcode() == IrOpcode::kStoreTypedElement && j < i)) {
+        continue;
+      }
+      Node* left = storage(i);
+      Node* right = storage(j);
+      Node* delta = graph()->NewNode(machine()->IntSub(), left, right);
+      check = graph()->NewNode(
+          machine()->Word32And(), check,
+          graph()->NewNode(
+              machine()->Word32Or(),
+              graph()->NewNode(machine()->WordEqual(), delta,
+                               jsgraph()->IntPtrConstant(0)),
+              graph()->NewNode(
+                  machine()->UintLessThan(),
+                  jsgraph()->IntPtrConstant(2 * kSimd128Size - 2),
+                  graph()->NewNode(
+                      machine()->IntAdd(), delta,
+                      jsgraph()->IntPtrConstant(kSimd128Size - 1)))));
+    }
+  }
+
+  // The branches guarding the vector accesses are critical safety checks, so
+  // that the storage pointers are poisoned on misspeculation.
+  Node* branch = graph()->NewNode(
+      common()->Branch(BranchHint::kNone, IsSafetyCheck::kCriticalSafetyCheck),
+      check, control);
+  Node* if_scalar = graph()->NewNode(common()->IfFalse(), branch);
+  Node* entry_effect = effect;
+  control = graph()->NewNode(common()->IfTrue(), branch);
+
+  // Build the vector loop.
+  Node* vloop = control =
+      graph()->NewNode(common()->Loop(2), control, control);
+  Node* veffect = effect =
+      graph()->NewNode(common()->EffectPhi(2), effect, effect, vloop);
+  Node* vindex = graph()->NewNode(
+      common()->Phi(MachineRepresentation::kWord32, 2), initial, initial,
+      vloop);
+  Node* terminate = graph()->NewNode(common()->Terminate(), veffect, vloop);
+  NodeProperties::MergeControlToEnd(graph(), common(), terminate);
+
+  Node* vcheck = graph()->NewNode(
+      machine()->Int32LessThan(), vindex,
+      graph()->NewNode(machine()->Int32Sub(), bound,
+                       jsgraph()->Int32Constant(kLanes - 1)));
+  Node* vbranch = graph()->NewNode(
+      common()->Branch(BranchHint::kNone, IsSafetyCheck::kCriticalSafetyCheck),
+      vcheck, vloop);
+  Node* vexit = graph()->NewNode(common()->IfFalse(), vbranch);
+  control = graph()->NewNode(common()->IfTrue(), vbranch);
+
+  Node* stack_check = c->stack_check;
+  effect = control = graph()->NewNode(
+      stack_check->op(), NodeProperties::GetContextInput(stack_check),
+      BuildState(NodeProperties::GetFrameStateInput(stack_check), c, vindex),
+      effect, control);
+
+  Node* offset = vindex;
+  if (machine()->Is64()) {
+    offset = graph()->NewNode(machine()->ChangeUint32ToUint64(), offset);
+  }
+  offset = graph()->NewNode(
+      machine()->WordShl(), offset,
+      jsgraph()->IntPtrConstant(ElementSizeLog2Of(c->lane)));
+
+  // The storage pointers have to be computed after the stack check, which
+  // might move on-heap backing stores.
+  std::fill(storages.begin(), storages.end(), nullptr);
+  bool const poison = poisoning_level_ != PoisoningMitigationLevel::kDontPoison;
+  for (size_t i = 0; i < c->accesses.size(); ++i) {
+    Node* access = c->accesses[i];
+    for (size_t j = 0; j < i && storages[i] == nullptr; ++j) {
+      if (IsSameArray(access, c->accesses[j])) storages[i] = storages[j];
+    }
+    if (storages[i] == nullptr) {
+      storages[i] = BuildStorage(access, &effect, control, poison);
+    }
+    if (access->opcode() == IrOpcode::kLoadTypedElement) {
+      effect = c->vectors[access] = graph()->NewNode(
+          machine()->Load(MachineType::Simd128()), storages[i], offset,
+          effect, control);
+    } else {
+      effect = graph()->NewNode(
+          machine()->Store(StoreRepresentation(
+              MachineRepresentation::kSimd128, kNoWriteBarrier)),
+          storages[i], offset, BuildValue(access->InputAt(4), c), effect,
+          control);
+    }
+  }
+
+  vloop->ReplaceInput(1, control);
+  veffect->ReplaceInput(1, effect);
+  vindex->ReplaceInput(
+      1, graph()->NewNode(machine()->Int32Add(), vindex,
+                          jsgraph()->Int32Constant(kLanes)));
+
+  // Continue with the original loop, from where the vector loop stopped.
+  control = graph()->NewNode(common()->Merge(2), if_scalar, vexit);
+  effect = graph()->NewNode(common()->EffectPhi(2), entry_effect, veffect,
+                            control);
+  Node* index =
+      graph()->NewNode(common()->Phi(MachineRepresentation::kWord32, 2),
+                       initial, vindex, control);
+  c->loop_node->ReplaceInput(0, control);
+  c->effect_phi->ReplaceInput(0, effect);
+  c->phi->ReplaceInput(0, index);
+}
+
+Node* LoopVectorizer::BuildStorage(Node* access, Node** effect, Node* control,
+                                   bool poison) {
+  Node* buffer = access->InputAt(0);
+  Node* base = access->InputAt(1);
+  Node* external = access->InputAt(2);
+
+  // Like the effect control linearizer does for the scalar accesses, keep the
+  // {buffer} alive and handle the case where the {base} is Smi zero.
+  Node* storage = external;
+  if (!IntPtrMatcher(base).Is(0)) {
+    *effect = graph()->NewNode(common()->Retain(), buffer, *effect);
+    storage = *effect = graph()->NewNode(machine()->UnsafePointerAdd(), base,
+                                         external, *effect, control);
+  }
+  if (poison) {
+    storage = *effect = graph()->NewNode(machine()->WordPoisonOnSpeculation(),
+                                         storage, *effect, control);
+  }
+  return storage;
+}
+
+Node* LoopVectorizer::BuildCheckedValue(Node* node, Candidate* c) {
+  // Reuse the result of the check before the loop, or convert the Smi that
+  // it checked.
+  Node* before = c->checks[node];
+  if (before->op()->Equals(node->op())) return before;
+  DCHECK_EQ(IrOpcode::kCheckedTaggedSignedToInt32, node->opcode());
+  return graph()->NewNode(simplified()->ChangeTaggedSignedToInt32(),
+                          node->InputAt(0));
+}
+
+Node* LoopVectorizer::BuildValue(Node* node, Candidate* c) {
+  auto it = c->vectors.find(node);
+  if (it != c->vectors.end()) return it->second;
+
+  Node* vector;
+  if (IsFloat32Operand(node)) {
+    vector = graph()->NewNode(
+        machine()->F32x4Splat(),
+        jsgraph()->Float32Constant(
+            DoubleToFloat32(OpParameter<double>(node->op()))));
+  } else if (node->opcode() == IrOpcode::kChangeFloat32ToFloat64) {
+    vector = BuildValue(node->InputAt(0), c);
+  } else if (c->checks.count(node) != 0) {
+    vector = graph()->NewNode(machine()->I32x4Splat(),
+                              BuildCheckedValue(node, c));
+  } else if ((node->opcode() == IrOpcode::kTruncateFloat64ToWord32 ||
+              node->opcode() == IrOpcode::kTruncateFloat64ToFloat32) &&
+             c->checks.count(node->InputAt(0)) != 0) {
+    // A truncation of a loop invariant number.
+    vector = graph()->NewNode(
+        c->lane == MachineRepresentation::kFloat32 ? machine()->F32x4Splat()
+                                                   : machine()->I32x4Splat(),
+        graph()->NewNode(node->op(), BuildCheckedValue(node->InputAt(0), c)));
+  } else if (IsInvariant(node, c)) {
+    vector = graph()->NewNode(c->lane == MachineRepresentation::kFloat32
+                                  ? machine()->F32x4Splat()
+                                  : machine()->I32x4Splat(),
+                              node);
+  } else if (node->opcode() == IrOpcode::kTruncateFloat64ToFloat32) {
+    vector = BuildValue(node->InputAt(0), c);
+  } else {
+    const Operator* op;
+    switch (node->opcode()) {
+      case IrOpcode::kFloat64Add:
+        op = machine()->F32x4Add();
+        break;
+      case IrOpcode::kFloat64Sub:
+        op = machine()->F32x4Sub();
+        break;
+      case IrOpcode::kFloat64Mul:
+        op = machine()->F32x4Mul();
+        break;
+      case IrOpcode::kInt32Add:
+        op = machine()->I32x4Add();
+        break;
+      case IrOpcode::kInt32Sub:
+        op = machine()->I32x4Sub();
+        break;
+      case IrOpcode::kInt32Mul:
+        op = machine()->I32x4Mul();
+        break;
+      case IrOpcode::kWord32And:
+        op = machine()->S128And();
+        break;
+      case IrOpcode::kWord32Or:
+        op = machine()->S128Or();
+        break;
+      case IrOpcode::kWord32Xor:
+        op = machine()->S128Xor();
+        break;
+      case IrOpcode::kWord32Shl:
+      case IrOpcode::kWord32Sar:
+      case IrOpcode::kWord32Shr: {
+        int32_t shift = OpParameter<int32_t>(node->InputAt(1)->op());
+        op = node->opcode() == IrOpcode::kWord32Shl
+                 ? machine()->I32x4Shl(shift)
+                 : node->opcode() == IrOpcode::kWord32Sar
+                       ? machine()->I32x4ShrS(shift)
+                       : machine()->I32x4ShrU(shift);
+        vector = graph()->NewNode(op, BuildValue(node->InputAt(0), c));
+        return c->vectors[node] = vector;
+      }
+      default:
+        UNREACHABLE();
+    }
+    vector = graph()->NewNode(op, BuildValue(node->InputAt(0), c),
+                              BuildValue(node->InputAt(1), c));
+  }
+  return c->vectors[node] = vector;
+}
+
+Node* LoopVectorizer::BuildState(Node* node, Candidate* c, Node* index) {
+  if (node == c->phi) return index;
+  if (IsInvariant(node, c)) return node;
+  Node* copy = graph()->CloneNode(node);
+  for (int i = 0; i < node->InputCount(); ++i) {
+    copy->ReplaceInput(i, BuildState(node->InputAt(i), c, index));
+  }
+  return copy;
+}
+
+Graph* LoopVectorizer::graph() const { return jsgraph()->graph(); }
+
+CommonOperatorBuilder* LoopVectorizer::common() const {
+  return jsgraph()->common();
+}
+
+MachineOperatorBuilder* LoopVectorizer::machine() const {
+  return jsgraph()->machine();
+}
+
+SimplifiedOperatorBuilder* LoopVectorizer::simplified() const {
+  return jsgraph()->simplified();
+}
+
+#undef TRACE
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,81 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_COMPILER_LOOP_VECTORIZER_H_
+#define V8_COMPILER_LOOP_VECTORIZER_H_
+
+#include "src/compiler/loop-analysis.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+namespace compiler {
+
+class CommonOperatorBuilder;
+class JSGraph;
+class MachineOperatorBuilder;
+class SimplifiedOperatorBuilder;
+
+// Vectorizes simple counted loops over typed arrays, i.e. innermost loops
+// like
+//
+//   for (let i = i0; i < n; ++i) c[i] = a[i] + b[i];
+//
+// where all accesses are unit-stride loads and stores of Float32Array or
+// (U)Int32Array elements. Runs on the graph after simplified lowering. The
+// loop is versioned: a guard on the loop entry checks that the vector loop
+// stays within all the bounds checked by the scalar loop and that the
+// arrays it writes don't partially overlap the arrays it reads, and if it
+// holds a loop using 128-bit SIMD machine operators handles four
+// iterations at a time. The original loop runs the remaining iterations,
+// or all of them if the guard fails, with all its checks intact.
+class V8_EXPORT_PRIVATE LoopVectorizer {
+ public:
+  LoopVectorizer(JSGraph* jsgraph, LoopTree* loop_tree, Zone* tmp_zone,
+                 PoisoningMitigationLevel poisoning_level)
+      : jsgraph_(jsgraph),
+        loop_tree_(loop_tree),
+        tmp_zone_(tmp_zone),
+        poisoning_level_(poisoning_level) {}
+
+  void VectorizeInnerLoopsOfTree();
+
+  static const int kLanes = 4;
+  static const size_t kMaxLoopNodes = 200;
+
+ private:
+  struct Candidate;
+
+  void VectorizeInnerLoops(LoopTree::Loop* loop);
+  bool Match(LoopTree::Loop* loop, Candidate* candidate);
+  bool MatchValue(Node* node, Candidate* candidate);
+  bool MatchOperand(Node* node, Candidate* candidate);
+  bool MatchState(Node* node, Candidate* candidate);
+  bool IsInvariant(Node* node, Candidate* candidate);
+  Node* FindCheckBeforeLoop(Node* check, Candidate* candidate);
+
+  void Vectorize(Candidate* candidate);
+  Node* BuildStorage(Node* access, Node** effect, Node* control,
+                     bool poison);
+  Node* BuildCheckedValue(Node* node, Candidate* candidate);
+  Node* BuildValue(Node* node, Candidate* candidate);
+  Node* BuildState(Node* node, Candidate* candidate, Node* index);
+
+  Graph* graph() const;
+  CommonOperatorBuilder* common() const;
+  MachineOperatorBuilder* machine() const;
+  SimplifiedOperatorBuilder* simplified() const;
+  JSGraph* jsgraph() const { return jsgraph_; }
+
+  JSGraph* const jsgraph_;
+  LoopTree* const loop_tree_;
+  Zone* const tmp_zone_;
+  PoisoningMitigationLevel const poisoning_level_;
+};
+
+}  // namespace compiler
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_COMPILER_LOOP_VECTORIZER_H_
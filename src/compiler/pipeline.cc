@@ -51,6 +51,7 @@
 #include "src/compiler/loop-analysis.h"
 #include "src/compiler/loop-peeling.h"
 #include "src/compiler/loop-variable-optimizer.h"
+#include "src/compiler/loop-vectorizer.h"
 #include "src/compiler/machine-graph-verifier.h"
 #include "src/compiler/machine-operator-reducer.h"
 #include "src/compiler/memory-optimizer.h"
@@ -918,8 +919,11 @@ PipelineCompilationJob::Status PipelineCompilationJob::PrepareJobImpl(
     compilation_info()->MarkAsAllocationFoldingEnabled();
   }
 
+  // OSR code is cached in the feedback vector, which can be shared with
+  // closures created later, so it must not depend on the function context.
   if (compilation_info()->closure()->feedback_cell()->map() ==
-      ReadOnlyRoots(isolate).one_closure_cell_map()) {
+          ReadOnlyRoots(isolate).one_closure_cell_map() &&
+      !(compilation_info()->is_osr() && FLAG_concurrent_osr)) {
     compilation_info()->MarkAsFunctionContextSpecializing();
   }
 
@@ -1385,6 +1389,23 @@ struct LoopPeelingPhase {
   }
 };
 
+struct LoopVectorizationPhase {
+  static const char* phase_name() { return "loop vectorization"; }
+
+  void Run(PipelineData* data, Zone* temp_zone) {
+    GraphTrimmer trimmer(temp_zone, data->graph());
+    NodeVector roots(temp_zone);
+    data->jsgraph()->GetCachedNodes(&roots);
+    trimmer.TrimGraph(roots.begin(), roots.end());
+
+    LoopTree* loop_tree =
+        LoopFinder::BuildLoopTree(data->jsgraph()->graph(), temp_zone);
+    LoopVectorizer(data->jsgraph(), loop_tree, temp_zone,
+                   data->info()->GetPoisoningMitigationLevel())
+        .VectorizeInnerLoopsOfTree();
+  }
+};
+
 struct LoopExitEliminationPhase {
   static const char* phase_name() { return "loop exit elimination"; }
 
@@ -2092,6 +2113,14 @@ bool PipelineImpl::OptimizeGraph(Linkage* linkage) {
   Run<SimplifiedLoweringPhase>();
   RunPrintAndVerify(SimplifiedLoweringPhase::phase_name(), true);
 
+  // Vectorize simple typed array loops. This needs the machine
+  // representations chosen by simplified lowering, and has to run before
+  // the typed element accesses are lowered to machine loads and stores.
+  if (FLAG_turbo_loop_vectorization && CpuFeatures::SupportsWasmSimd128()) {
+    Run<LoopVectorizationPhase>();
+    RunPrintAndVerify(LoopVectorizationPhase::phase_name(), true);
+  }
+
   // From now on it is invalid to look at types on the nodes, because the types
   // on the nodes might not make sense after representation selection due to the
   // way we handle truncations; if we'd want to look at types afterwards we'd
@@ -2548,7 +2548,7 @@ void InstructionSelector::VisitS128Zero(Node* node) {
   void InstructionSelector::Visit##Type##Splat(Node* node) { \
     X64OperandGenerator g(this);                             \
     Emit(kX64##Type##Splat, g.DefineAsRegister(node),        \
-         g.Use(node->InputAt(0)));                           \
+         g.UseRegister(node->InputAt(0)));                   \
   }
 SIMD_TYPES(VISIT_SIMD_SPLAT)
 #undef VISIT_SIMD_SPLAT
@@ -7,6 +7,7 @@
 #include <limits.h>
 #include <stdarg.h>
 #include <cmath>
+#include <vector>
 
 #include "src/allocation.h"
 #include "src/assert-scope.h"
@@ -902,6 +903,10 @@ class StringToBigIntHelper : public StringToIntHelper {
                   isolate()->has_pending_exception());
         return MaybeHandle<BigInt>();
       case kDone:
+        if (!parts_.empty()) {
+          BigInt::AssignFromChunks(result_, multipliers_.data(), parts_.data(),
+                                   static_cast<int>(parts_.size()));
+        }
         return BigInt::Finalize(result_, negative());
       case kEmpty:
       case kRunning:
@@ -925,10 +930,19 @@ class StringToBigIntHelper : public StringToIntHelper {
         isolate(), radix(), charcount, should_throw(), pretenure);
     if (!maybe.ToHandle(&result_)) {
       set_state(kError);
+      return;
     }
+    collect_chunks_ = BigInt::UseChunkedParsing(result_);
   }
 
   virtual void ResultMultiplyAdd(uint32_t multiplier, uint32_t part) {
+    if (collect_chunks_) {
+      // Combining all chunks at the end is much faster than multiplying
+      // the (growing) result with each of them.
+      multipliers_.push_back(multiplier);
+      parts_.push_back(part);
+      return;
+    }
     BigInt::InplaceMultiplyAdd(result_, static_cast<uintptr_t>(multiplier),
                                static_cast<uintptr_t>(part));
   }
@@ -938,6 +952,9 @@ class StringToBigIntHelper : public StringToIntHelper {
 
   Handle<FreshlyAllocatedBigInt> result_;
   Behavior behavior_;
+  bool collect_chunks_ = false;
+  std::vector<uint32_t> multipliers_;
+  std::vector<uint32_t> parts_;
 };
 
 MaybeHandle<BigInt> StringToBigInt(Isolate* isolate, Handle<String> string) {
@@ -5,6 +5,7 @@
 #include "src/counters.h"
 
 #include <iomanip>
+#include <sstream>
 
 #include "src/base/platform/platform.h"
 #include "src/builtins/builtins-definitions.h"
@@ -28,6 +29,101 @@ int* StatsCounterBase::FindLocationInStatsTable() const {
   return counters_->FindLocation(name_);
 }
 
+HotPathCounters::HotPathCounters(Counters* counters) : counters_(counters) {}
+
+size_t HotPathCounters::KeyHash::operator()(const Key& key) const {
+  return base::hash_combine(key.script_id, key.start_position, key.slot);
+}
+
+void HotPathCounters::CountInterpreterTick(SharedFunctionInfo* shared) {
+  Count("c:V8.InterpreterTicks:", shared, -1);
+}
+
+void HotPathCounters::CountICMiss(SharedFunctionInfo* shared, int slot) {
+  DCHECK_LE(0, slot);
+  Count("c:V8.ICMisses:", shared, slot);
+}
+
+void HotPathCounters::CountDeopt(DeoptimizeReason reason) {
+  if (!deopt_locations_found_) {
+    static const char* const kNames[] = {
+#define DEOPTIMIZE_REASON(Name, message) "c:V8.Deopts:" #Name,
+        DEOPTIMIZE_REASON_LIST(DEOPTIMIZE_REASON)
+#undef DEOPTIMIZE_REASON
+    };
+    for (size_t i = 0; i < kDeoptimizeReasonCount; i++) {
+      deopt_locations_[i] = counters_->FindLocation(kNames[i]);
+      if (deopt_locations_[i] == nullptr) {
+        deopt_locations_[i] = DroppedLocation();
+      }
+    }
+    deopt_locations_found_ = true;
+  }
+  size_t index = static_cast<size_t>(reason);
+  DCHECK_LT(index, kDeoptimizeReasonCount);
+  Increment(deopt_locations_[index]);
+}
+
+void HotPathCounters::Reset() {
+  locations_.clear();
+  deopt_locations_found_ = false;
+  dropped_location_found_ = false;
+}
+
+void HotPathCounters::Count(const char* prefix, SharedFunctionInfo* shared,
+                            int slot) {
+  int script_id = v8::UnboundScript::kNoScriptId;
+  if (shared->script()->IsScript()) {
+    script_id = Script::cast(shared->script())->id();
+  }
+  Key key = {script_id, shared->StartPosition(), slot};
+  auto it = locations_.find(key);
+  if (it != locations_.end()) {
+    Increment(it->second);
+    return;
+  }
+
+  // Look up the dropped counter before the embedder runs out of counters.
+  int* dropped_location = DroppedLocation();
+  if (locations_.size() >= static_cast<size_t>(FLAG_hot_path_counters_max)) {
+    Increment(dropped_location);
+    return;
+  }
+
+  std::ostringstream name;
+  name << prefix;
+  String* debug_name = shared->DebugName();
+  if (debug_name->length() == 0) {
+    name << "(anonymous)";
+  } else {
+    name << debug_name
+                ->ToCString(DISALLOW_NULLS, ROBUST_STRING_TRAVERSAL, 0,
+                            std::min(debug_name->length(),
+                                     kMaxFunctionNameLength))
+                .get();
+  }
+  name << "@" << key.script_id << ":" << key.start_position;
+  if (slot >= 0) name << "#" << slot;
+  names_.push_back(name.str());
+  int* location = counters_->FindLocation(names_.back().c_str());
+  if (location == nullptr) {
+    // The embedder has no counter left for the name, d8 for example has a
+    // fixed number of them. The events of this key are counted as dropped.
+    names_.pop_back();
+    location = dropped_location;
+  }
+  locations_.emplace(key, location);
+  Increment(location);
+}
+
+int* HotPathCounters::DroppedLocation() {
+  if (!dropped_location_found_) {
+    dropped_location_ = counters_->FindLocation("c:V8.HotPathCountersDropped");
+    dropped_location_found_ = true;
+  }
+  return dropped_location_;
+}
+
 StatsCounterThreadSafe::StatsCounterThreadSafe(Counters* counters,
                                                const char* name)
     : StatsCounterBase(counters, name) {}
@@ -118,7 +214,8 @@ Counters::Counters(Isolate* isolate)
       STATS_COUNTER_TS_LIST(SC)
 #undef SC
       // clang format on
-      runtime_call_stats_() {
+      runtime_call_stats_(),
+      hot_path_counters_(this) {
   static const struct {
     Histogram Counters::*member;
     const char* caption;
@@ -251,6 +348,7 @@ Counters::Counters(Isolate* isolate)
 
 void Counters::ResetCounterFunction(CounterLookupCallback f) {
   stats_table_.SetCounterFunction(f);
+  hot_path_counters_.Reset();
 
 #define SC(name, caption) name##_.Reset();
   STATS_COUNTER_LIST_1(SC)
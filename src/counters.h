@@ -5,11 +5,16 @@
 #ifndef V8_COUNTERS_H_
 #define V8_COUNTERS_H_
 
+#include <deque>
+#include <string>
+#include <unordered_map>
+
 #include "include/v8.h"
 #include "src/allocation.h"
 #include "src/base/atomic-utils.h"
 #include "src/base/platform/elapsed-timer.h"
 #include "src/base/platform/time.h"
+#include "src/deoptimize-reason.h"
 #include "src/globals.h"
 #include "src/heap-symbols.h"
 #include "src/isolate.h"
@@ -1343,6 +1348,11 @@ class RuntimeCallTimerScope {
   SC(total_stubs_code_size, V8.TotalStubsCodeSize)                             \
   /* Amount of (JS) compiled code. */                                          \
   SC(total_compiled_code_size, V8.TotalCompiledCodeSize)                       \
+  /* Copies of the InterpreterEntryTrampoline, their size and the number */    \
+  /* of functions that reuse an existing copy. */                              \
+  SC(interpreter_trampoline_copies, V8.InterpreterTrampolineCopies)            \
+  SC(interpreter_trampoline_copies_size, V8.InterpreterTrampolineCopiesSize)   \
+  SC(interpreter_trampolines_shared, V8.InterpreterTrampolinesShared)          \
   SC(gc_compactor_caused_by_request, V8.GCCompactorCausedByRequest)            \
   SC(gc_compactor_caused_by_promoted_data, V8.GCCompactorCausedByPromotedData) \
   SC(gc_compactor_caused_by_oldspace_exhaustion,                               \
@@ -1420,6 +1430,75 @@ class RuntimeCallTimerScope {
   SC(liftoff_compiled_functions, V8.LiftoffCompiledFunctions)        \
   SC(liftoff_unsupported_functions, V8.LiftoffUnsupportedFunctions)
 
+// Counts how often the interpreter, the ICs and the deoptimizer take their
+// slow paths, see --hot-path-counters:
+// - "c:V8.InterpreterTicks:<function>" counts the interrupt budget
+//   expirations of an interpreted function, i.e. about FLAG_interrupt_budget
+//   bytes of its bytecode were executed per tick. Warm functions that are
+//   not optimized keep ticking.
+// - "c:V8.ICMisses:<function>#<slot>" counts the misses of an IC site.
+// - "c:V8.Deopts:<reason>" counts the deopts of optimized code by reason.
+// Functions are named "<name>@<script id>:<start position>". The counters
+// live in the StatsTable, so an embedder whose counter function returns
+// locations in shared memory can read them while the isolate runs. Only the
+// first FLAG_hot_path_counters_max functions and sites get counters, and the
+// events of the others are counted by "c:V8.HotPathCountersDropped". So are
+// the events of counters the embedder has no location for.
+class HotPathCounters {
+ public:
+  explicit HotPathCounters(Counters* counters);
+
+  void CountInterpreterTick(SharedFunctionInfo* shared);
+  void CountICMiss(SharedFunctionInfo* shared, int slot);
+  void CountDeopt(DeoptimizeReason reason);
+
+  // Forgets the locations of the counters, e.g. after the counter function
+  // changed.
+  void Reset();
+
+ private:
+  // Identifies a function or an IC site.
+  struct Key {
+    int script_id;
+    int start_position;
+    // -1 for functions.
+    int slot;
+
+    bool operator==(const Key& other) const {
+      return script_id == other.script_id &&
+             start_position == other.start_position && slot == other.slot;
+    }
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key& key) const;
+  };
+
+  static const size_t kDeoptimizeReasonCount =
+#define DEOPTIMIZE_REASON(Name, message) +1
+      DEOPTIMIZE_REASON_LIST(DEOPTIMIZE_REASON);
+#undef DEOPTIMIZE_REASON
+  static const int kMaxFunctionNameLength = 32;
+
+  void Count(const char* prefix, SharedFunctionInfo* shared, int slot);
+  int* DroppedLocation();
+  void Increment(int* location) {
+    if (location != nullptr) (*location)++;
+  }
+
+  Counters* const counters_;
+  std::unordered_map<Key, int*, KeyHash> locations_;
+  // Embedders may hold on to the names passed to the counter function, so
+  // they live as long as the isolate.
+  std::deque<std::string> names_;
+  int* deopt_locations_[kDeoptimizeReasonCount];
+  bool deopt_locations_found_ = false;
+  int* dropped_location_ = nullptr;
+  bool dropped_location_found_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(HotPathCounters);
+};
+
 // This file contains all the v8 counters that are in use.
 class Counters : public std::enable_shared_from_this<Counters> {
  public:
@@ -1520,7 +1599,10 @@ class Counters : public std::enable_shared_from_this<Counters> {
 
   RuntimeCallStats* runtime_call_stats() { return &runtime_call_stats_; }
 
+  HotPathCounters* hot_path_counters() { return &hot_path_counters_; }
+
  private:
+  friend class HotPathCounters;
   friend class StatsTable;
   friend class StatsCounterBase;
   friend class Histogram;
@@ -1599,6 +1681,7 @@ class Counters : public std::enable_shared_from_this<Counters> {
 #undef SC
 
   RuntimeCallStats runtime_call_stats_;
+  HotPathCounters hot_path_counters_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(Counters);
 };
@@ -874,4 +874,14 @@ void Shell::AddOSMethods(Isolate* isolate, Local<ObjectTemplate> os_templ) {
                 FunctionTemplate::New(isolate, RemoveDirectory));
 }
 
+void Shell::AddOSExternalReferences(std::vector<intptr_t>* references) {
+  references->push_back(reinterpret_cast<intptr_t>(System));
+  references->push_back(reinterpret_cast<intptr_t>(ChangeDirectory));
+  references->push_back(reinterpret_cast<intptr_t>(SetEnvironment));
+  references->push_back(reinterpret_cast<intptr_t>(UnsetEnvironment));
+  references->push_back(reinterpret_cast<intptr_t>(SetUMask));
+  references->push_back(reinterpret_cast<intptr_t>(MakeDirectory));
+  references->push_back(reinterpret_cast<intptr_t>(RemoveDirectory));
+}
+
 }  // namespace v8
@@ -10,6 +10,8 @@ namespace v8 {
 
 void Shell::AddOSMethods(Isolate* isolate, Local<ObjectTemplate> os_templ) {}
 
+void Shell::AddOSExternalReferences(std::vector<intptr_t>* references) {}
+
 char* Shell::ReadCharsFromTcpPort(const char* name, int* size_out) {
   // TODO(leszeks): No reason this shouldn't exist on windows.
   return nullptr;
@@ -23,9 +23,12 @@
 
 #include "include/libplatform/libplatform.h"
 #include "include/libplatform/v8-tracing.h"
+#include "include/v8-fast-api-calls.h"
 #include "include/v8-inspector.h"
+#include "include/v8-profiler.h"
 #include "src/api-inl.h"
 #include "src/base/cpu.h"
+#include "src/base/format-macros.h"
 #include "src/base/logging.h"
 #include "src/base/platform/platform.h"
 #include "src/base/platform/time.h"
@@ -232,6 +235,11 @@ class PredictablePlatform : public Platform {
 
 std::unique_ptr<v8::Platform> g_platform;
 
+// The snapshot of --startup-snapshot-blob, see Shell::CreateStartupSnapshot.
+StartupData g_startup_snapshot = {nullptr, 0};
+// The index of the d8 context in the startup snapshot.
+const size_t kStartupSnapshotContextIndex = 0;
+
 v8::Platform* GetDefaultPlatform() {
   return i::FLAG_verify_predictable
              ? static_cast<PredictablePlatform*>(g_platform.get())->platform()
@@ -260,6 +268,18 @@ Worker* GetWorkerFromInternalField(Isolate* isolate, Local<Object> object) {
   return worker;
 }
 
+// The only d8 objects with internal fields are Workers. Their Worker* does
+// not outlive the process that created the startup snapshot, so it is not
+// serialized, and deserialized Workers are defunct.
+StartupData SerializeWorkerField(Local<Object> holder, int index, void* data) {
+  return {nullptr, 0};
+}
+
+void DeserializeWorkerField(Local<Object> holder, int index,
+                            StartupData payload, void* data) {
+  holder->SetAlignedPointerInInternalField(index, nullptr);
+}
+
 base::Thread::Options GetThreadOptions(const char* name) {
   // On some systems (OSX 10.6) the stack size default is 0.5Mb or less
   // which is not enough to parse the big literal expressions used in tests.
@@ -1090,9 +1110,7 @@ MaybeLocal<Context> Shell::CreateRealm(
     }
     delete[] old_realms;
   }
-  Local<ObjectTemplate> global_template = CreateGlobalTemplate(isolate);
-  Local<Context> context =
-      Context::New(isolate, nullptr, global_template, global_object);
+  Local<Context> context = NewContext(isolate, global_object);
   DCHECK(!try_catch.HasCaught());
   if (context.IsEmpty()) return MaybeLocal<Context>();
   InitializeModuleEmbedderData(context);
@@ -1707,6 +1725,65 @@ Local<String> Shell::Stringify(Isolate* isolate, Local<Value> value) {
 }
 
 
+namespace {
+
+// The methods of the fastApi object, see --expose-fast-api. Each method is
+// installed once with a C function for fast API calls and once without, so
+// that benchmarks can compare the two.
+int32_t AddInt32(int32_t a, int32_t b) {
+  return static_cast<int32_t>(static_cast<uint32_t>(a) +
+                              static_cast<uint32_t>(b));
+}
+
+int32_t FastApiAdd(ApiObject receiver, int32_t a, int32_t b) {
+  return AddInt32(a, b);
+}
+
+void SlowApiAdd(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Local<Context> context = args.GetIsolate()->GetCurrentContext();
+  int32_t a = args[0]->Int32Value(context).FromMaybe(0);
+  int32_t b = args[1]->Int32Value(context).FromMaybe(0);
+  args.GetReturnValue().Set(AddInt32(a, b));
+}
+
+double MultiplyAdd(double a, double b, double c) { return a * b + c; }
+
+double FastApiMultiplyAdd(ApiObject receiver, double a, double b, double c) {
+  return MultiplyAdd(a, b, c);
+}
+
+void SlowApiMultiplyAdd(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  Local<Context> context = args.GetIsolate()->GetCurrentContext();
+  double a = args[0]->NumberValue(context).FromMaybe(0);
+  double b = args[1]->NumberValue(context).FromMaybe(0);
+  double c = args[2]->NumberValue(context).FromMaybe(0);
+  args.GetReturnValue().Set(MultiplyAdd(a, b, c));
+}
+
+const CFunction* FastApiAddCFunction() {
+  static const CFunction c_function = CFunction::Make(FastApiAdd);
+  return &c_function;
+}
+
+const CFunction* FastApiMultiplyAddCFunction() {
+  static const CFunction c_function = CFunction::Make(FastApiMultiplyAdd);
+  return &c_function;
+}
+
+void AddFastApiMethod(Isolate* isolate, Local<ObjectTemplate> templ,
+                      const char* name, FunctionCallback callback, int length,
+                      const CFunction* c_function) {
+  templ->Set(
+      String::NewFromUtf8(isolate, name, NewStringType::kNormal)
+          .ToLocalChecked(),
+      FunctionTemplate::New(isolate, callback, Local<Value>(),
+                            Local<Signature>(), length,
+                            ConstructorBehavior::kThrow,
+                            SideEffectType::kHasSideEffect, c_function));
+}
+
+}  // namespace
+
 Local<ObjectTemplate> Shell::CreateGlobalTemplate(Isolate* isolate) {
   Local<ObjectTemplate> global_template = ObjectTemplate::New(isolate);
   global_template->Set(
@@ -1886,9 +1963,96 @@ Local<ObjectTemplate> Shell::CreateGlobalTemplate(Isolate* isolate) {
         async_hooks_templ);
   }
 
+  if (options.expose_fast_api) {
+    Local<ObjectTemplate> fast_api_templ = ObjectTemplate::New(isolate);
+    AddFastApiMethod(isolate, fast_api_templ, "add", SlowApiAdd, 2,
+                     FastApiAddCFunction());
+    AddFastApiMethod(isolate, fast_api_templ, "slowAdd", SlowApiAdd, 2,
+                     nullptr);
+    AddFastApiMethod(isolate, fast_api_templ, "multiplyAdd",
+                     SlowApiMultiplyAdd, 3, FastApiMultiplyAddCFunction());
+    AddFastApiMethod(isolate, fast_api_templ, "slowMultiplyAdd",
+                     SlowApiMultiplyAdd, 3, nullptr);
+    global_template->Set(
+        String::NewFromUtf8(isolate, "fastApi", NewStringType::kNormal)
+            .ToLocalChecked(),
+        fast_api_templ);
+  }
+
   return global_template;
 }
 
+// Creates a context with the d8 globals. With a startup snapshot, the context
+// is deserialized in the state that the scripts left it in when the snapshot
+// was created.
+Local<Context> Shell::NewContext(Isolate* isolate,
+                                 MaybeLocal<Value> global_object) {
+  Local<Context> context;
+  if (g_startup_snapshot.data != nullptr &&
+      Context::FromSnapshot(isolate, kStartupSnapshotContextIndex,
+                            DeserializeInternalFieldsCallback(
+                                DeserializeWorkerField),
+                            nullptr, global_object)
+          .ToLocal(&context)) {
+    return context;
+  }
+  Local<ObjectTemplate> global_template = CreateGlobalTemplate(isolate);
+  return Context::New(isolate, nullptr, global_template, global_object);
+}
+
+const intptr_t* Shell::GetExternalReferences() {
+  static std::vector<intptr_t>* references = nullptr;
+  if (references != nullptr) return references->data();
+  references = new std::vector<intptr_t>{
+      reinterpret_cast<intptr_t>(Print),
+      reinterpret_cast<intptr_t>(PrintErr),
+      reinterpret_cast<intptr_t>(Write),
+      reinterpret_cast<intptr_t>(Read),
+      reinterpret_cast<intptr_t>(ReadBuffer),
+      reinterpret_cast<intptr_t>(ReadLine),
+      reinterpret_cast<intptr_t>(Load),
+      reinterpret_cast<intptr_t>(SetTimeout),
+      reinterpret_cast<intptr_t>(Quit),
+      reinterpret_cast<intptr_t>(NotifyDone),
+      reinterpret_cast<intptr_t>(WaitUntilDone),
+      reinterpret_cast<intptr_t>(Version),
+      reinterpret_cast<intptr_t>(RealmCurrent),
+      reinterpret_cast<intptr_t>(RealmOwner),
+      reinterpret_cast<intptr_t>(RealmGlobal),
+      reinterpret_cast<intptr_t>(RealmCreate),
+      reinterpret_cast<intptr_t>(RealmCreateAllowCrossRealmAccess),
+      reinterpret_cast<intptr_t>(RealmNavigate),
+      reinterpret_cast<intptr_t>(RealmDispose),
+      reinterpret_cast<intptr_t>(RealmSwitch),
+      reinterpret_cast<intptr_t>(RealmEval),
+      reinterpret_cast<intptr_t>(RealmSharedGet),
+      reinterpret_cast<intptr_t>(RealmSharedSet),
+      reinterpret_cast<intptr_t>(PerformanceNow),
+      reinterpret_cast<intptr_t>(WorkerNew),
+      reinterpret_cast<intptr_t>(WorkerTerminate),
+      reinterpret_cast<intptr_t>(WorkerPostMessage),
+      reinterpret_cast<intptr_t>(WorkerGetMessage),
+      reinterpret_cast<intptr_t>(AsyncHooksCreateHook),
+      reinterpret_cast<intptr_t>(AsyncHooksExecutionAsyncId),
+      reinterpret_cast<intptr_t>(AsyncHooksTriggerAsyncId),
+      reinterpret_cast<intptr_t>(SlowApiAdd),
+      reinterpret_cast<intptr_t>(SlowApiMultiplyAdd),
+      reinterpret_cast<intptr_t>(FastApiAddCFunction()->GetAddress()),
+      reinterpret_cast<intptr_t>(FastApiAddCFunction()->GetTypeInfo()),
+      reinterpret_cast<intptr_t>(FastApiMultiplyAddCFunction()->GetAddress()),
+      reinterpret_cast<intptr_t>(
+          FastApiMultiplyAddCFunction()->GetTypeInfo())};
+  AddOSExternalReferences(references);
+  references->push_back(0);
+  return references->data();
+}
+
+void Shell::UseStartupSnapshot(Isolate::CreateParams* create_params) {
+  if (g_startup_snapshot.data == nullptr) return;
+  create_params->snapshot_blob = &g_startup_snapshot;
+  create_params->external_references = GetExternalReferences();
+}
+
 static void PrintNonErrorsMessageCallback(Local<Message> message,
                                           Local<Value> error) {
   // Nothing to do here for errors, exceptions thrown up to the shell will be
@@ -1945,10 +2109,8 @@ void Shell::Initialize(Isolate* isolate) {
 Local<Context> Shell::CreateEvaluationContext(Isolate* isolate) {
   // This needs to be a critical section since this is not thread-safe
   base::LockGuard<base::Mutex> lock_guard(context_mutex_.Pointer());
-  // Initialize the global objects
-  Local<ObjectTemplate> global_template = CreateGlobalTemplate(isolate);
   EscapableHandleScope handle_scope(isolate);
-  Local<Context> context = Context::New(isolate, nullptr, global_template);
+  Local<Context> context = NewContext(isolate, MaybeLocal<Value>());
   DCHECK(!context.IsEmpty());
   InitializeModuleEmbedderData(context);
   Context::Scope scope(context);
@@ -2197,6 +2359,133 @@ static char* ReadChars(const char* name, int* size_out) {
   return chars;
 }
 
+// Prints the size of the V8 log file, see --print-log-size. Only the log of
+// the main isolate is measured, which requires --no-logfile-per-isolate.
+static void PrintLogSize() {
+  FILE* file = FOpen(i::FLAG_logfile, "rb");
+  if (file == nullptr) {
+    printf("Cannot open log file %s.\n", i::FLAG_logfile);
+    return;
+  }
+  fseek(file, 0, SEEK_END);
+  printf("LogSize: %ld\n", ftell(file));
+  fclose(file);
+}
+
+// Creates a context with the d8 globals and runs the scripts of the main
+// isolate in it.
+Local<Context> Shell::CreateStartupContext(Isolate* isolate) {
+  EscapableHandleScope handle_scope(isolate);
+  Local<ObjectTemplate> global_template = CreateGlobalTemplate(isolate);
+  Local<Context> context = Context::New(isolate, nullptr, global_template);
+  InitializeModuleEmbedderData(context);
+  {
+    Context::Scope context_scope(context);
+    PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
+    options.isolate_sources[0].Execute(isolate);
+    CompleteMessageLoop(isolate);
+  }
+  // The module map lives in the embedder data, which is not serialized.
+  DisposeModuleEmbedderData(context);
+  return handle_scope.Escape(context);
+}
+
+// Creates a startup snapshot which, next to the default context, holds a d8
+// context in the state that the scripts of the main isolate left it in. The
+// options that shape the d8 globals, e.g. --omit-quit, are baked in.
+StartupData Shell::CreateStartupSnapshotBlob() {
+  SnapshotCreator creator(GetExternalReferences());
+  Isolate* isolate = creator.GetIsolate();
+  isolate->SetHostImportModuleDynamicallyCallback(
+      Shell::HostImportModuleDynamically);
+  isolate->SetHostInitializeImportMetaObjectCallback(
+      Shell::HostInitializeImportMetaObject);
+  {
+    // The per-isolate data has to be gone before serialization, which does
+    // not allow for global handles.
+    D8Console console(isolate);
+    debug::SetConsoleDelegate(isolate, &console);
+    PerIsolateData data(isolate);
+    HandleScope scope(isolate);
+    creator.SetDefaultContext(Context::New(isolate));
+    Local<Context> context = CreateStartupContext(isolate);
+    // Workers started by the scripts do not make it into the snapshot.
+    CleanupWorkers();
+    size_t index = creator.AddContext(
+        context, SerializeInternalFieldsCallback(SerializeWorkerField));
+    CHECK_EQ(kStartupSnapshotContextIndex, index);
+    debug::SetConsoleDelegate(isolate, nullptr);
+  }
+  return creator.CreateBlob(SnapshotCreator::FunctionCodeHandling::kKeep);
+}
+
+// Writes the snapshot of --create-startup-snapshot-blob to {file_name}.
+bool Shell::CreateStartupSnapshot(const char* file_name) {
+  StartupData blob = CreateStartupSnapshotBlob();
+  FILE* file = FOpen(file_name, "wb");
+  bool success = file != nullptr &&
+                 fwrite(blob.data, 1, blob.raw_size, file) ==
+                     static_cast<size_t>(blob.raw_size);
+  if (file != nullptr) fclose(file);
+  delete[] blob.data;
+  if (!success) printf("Error writing '%s'\n", file_name);
+  return success;
+}
+
+// Compares the time it takes to bootstrap a d8 context and run the scripts of
+// the main isolate in it with the time it takes to deserialize the same
+// context from a startup snapshot, see --context-creation-benchmark.
+void Shell::BenchmarkContextCreation() {
+  const int kContexts = 100;
+  StartupData blob = CreateStartupSnapshotBlob();
+  printf("ContextCreation(SnapshotSize): %d\n", blob.raw_size);
+
+  Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+  {
+    Isolate* isolate = Isolate::New(create_params);
+    {
+      Isolate::Scope isolate_scope(isolate);
+      D8Console console(isolate);
+      debug::SetConsoleDelegate(isolate, &console);
+      PerIsolateData data(isolate);
+      base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+      for (int i = 0; i < kContexts; i++) {
+        HandleScope scope(isolate);
+        CreateStartupContext(isolate);
+      }
+      base::TimeDelta time = base::TimeTicks::HighResolutionNow() - start;
+      printf("ContextCreation(Bootstrap): %.3f\n",
+             time.InMillisecondsF() / kContexts);
+      debug::SetConsoleDelegate(isolate, nullptr);
+    }
+    isolate->Dispose();
+  }
+
+  create_params.snapshot_blob = &blob;
+  create_params.external_references = GetExternalReferences();
+  {
+    Isolate* isolate = Isolate::New(create_params);
+    {
+      Isolate::Scope isolate_scope(isolate);
+      PerIsolateData data(isolate);
+      base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+      for (int i = 0; i < kContexts; i++) {
+        HandleScope scope(isolate);
+        Context::FromSnapshot(
+            isolate, kStartupSnapshotContextIndex,
+            DeserializeInternalFieldsCallback(DeserializeWorkerField))
+            .ToLocalChecked();
+      }
+      base::TimeDelta time = base::TimeTicks::HighResolutionNow() - start;
+      printf("ContextCreation(Snapshot): %.3f\n",
+             time.InMillisecondsF() / kContexts);
+    }
+    isolate->Dispose();
+  }
+  delete[] blob.data;
+}
+
 
 struct DataAndPersistent {
   uint8_t* data;
@@ -2511,6 +2800,7 @@ SourceGroup::IsolateThread::IsolateThread(SourceGroup* group)
 void SourceGroup::ExecuteInThread() {
   Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+  Shell::UseStartupSnapshot(&create_params);
   Isolate* isolate = Isolate::New(create_params);
   isolate->SetHostImportModuleDynamicallyCallback(
       Shell::HostImportModuleDynamically);
@@ -2661,6 +2951,7 @@ void Worker::WaitForThread() {
 void Worker::ExecuteInThread() {
   Isolate::CreateParams create_params;
   create_params.array_buffer_allocator = Shell::array_buffer_allocator;
+  Shell::UseStartupSnapshot(&create_params);
   Isolate* isolate = Isolate::New(create_params);
   isolate->SetHostImportModuleDynamicallyCallback(
       Shell::HostImportModuleDynamically);
@@ -2883,6 +3174,28 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strncmp(argv[i], "--trace-config=", 15) == 0) {
       options.trace_config = argv[i] + 15;
       argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--trace-buffer=", 15) == 0) {
+      const char* value = argv[i] + 15;
+      if (strcmp(value, "ring") == 0) {
+        options.trace_thread_local_buffer = false;
+      } else if (strcmp(value, "thread-local") == 0) {
+        options.trace_thread_local_buffer = true;
+      } else {
+        printf("Unknown option to --trace-buffer.\n");
+        return false;
+      }
+      argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--trace-format=", 15) == 0) {
+      const char* value = argv[i] + 15;
+      if (strcmp(value, "json") == 0) {
+        options.trace_binary_format = false;
+      } else if (strcmp(value, "binary") == 0) {
+        options.trace_binary_format = true;
+      } else {
+        printf("Unknown option to --trace-format.\n");
+        return false;
+      }
+      argv[i] = nullptr;
     } else if (strcmp(argv[i], "--enable-inspector") == 0) {
       options.enable_inspector = true;
       argv[i] = nullptr;
@@ -2900,6 +3213,43 @@ bool Shell::SetOptions(int argc, char* argv[]) {
     } else if (strcmp(argv[i], "--enable-os-system") == 0) {
       options.enable_os_system = true;
       argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--continuous-cpu-profile") == 0) {
+      options.continuous_cpu_profile = true;
+      argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--sampling-heap-profile=", 24) == 0) {
+      const char* value = argv[i] + 24;
+      options.sampling_heap_profile = true;
+      if (strcmp(value, "tree") == 0) {
+        options.sampling_heap_profile_aggregate = false;
+      } else if (strcmp(value, "aggregate") == 0) {
+        options.sampling_heap_profile_aggregate = true;
+      } else {
+        printf("Unknown option to --sampling-heap-profile.\n");
+        return false;
+      }
+      argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--sampling-heap-profile-interval=", 33) ==
+               0) {
+      options.sampling_heap_profile_interval = atoi(argv[i] + 33);
+      argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--print-log-size") == 0) {
+      options.print_log_size = true;
+      argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--heap-snapshot-benchmark") == 0) {
+      options.heap_snapshot_benchmark = true;
+      argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--startup-snapshot-blob=", 24) == 0) {
+      options.startup_snapshot_blob = argv[i] + 24;
+      argv[i] = nullptr;
+    } else if (strncmp(argv[i], "--create-startup-snapshot-blob=", 31) == 0) {
+      options.create_startup_snapshot_blob = argv[i] + 31;
+      argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--context-creation-benchmark") == 0) {
+      options.context_creation_benchmark = true;
+      argv[i] = nullptr;
+    } else if (strcmp(argv[i], "--expose-fast-api") == 0) {
+      options.expose_fast_api = true;
+      argv[i] = nullptr;
     } else if (strcmp(argv[i], "--quiet-load") == 0) {
       options.quiet_load = true;
       argv[i] = nullptr;
@@ -2941,6 +3291,107 @@ bool Shell::SetOptions(int argc, char* argv[]) {
   return true;
 }
 
+namespace {
+
+// Counts the samples of a continuous CPU profile. Used to measure the
+// overhead of leaving the profiler on, see --continuous-cpu-profile.
+class CountingProfileSink : public ContinuousProfileSink {
+ public:
+  void OnChunk(const ContinuousProfileChunk& chunk) override {
+    chunks_++;
+    functions_ += chunk.new_functions_count;
+    for (size_t i = 0; i < chunk.samples_count; i++) {
+      samples_ += chunk.samples[i].count;
+    }
+  }
+
+  void Print() {
+    printf("Continuous CPU profile: %" PRId64 " samples, %" PRIuS
+           " functions, %d chunks\n",
+           samples_, functions_, chunks_);
+  }
+
+ private:
+  int chunks_ = 0;
+  size_t functions_ = 0;
+  int64_t samples_ = 0;
+};
+
+// Counts the sites of a sampling heap profile that aggregates stacks, see
+// --sampling-heap-profile=aggregate.
+class CountingSampledAllocationsSink : public SampledAllocationsSink {
+ public:
+  void OnChunk(const SampledAllocationsChunk& chunk) override {
+    functions_ += chunk.new_functions_count;
+    sites_ += chunk.sites_count;
+    for (size_t i = 0; i < chunk.sites_count; i++) {
+      allocated_bytes_ += chunk.sites[i].allocated_bytes;
+      live_bytes_ += chunk.sites[i].live_bytes;
+    }
+  }
+
+  void Print() {
+    printf("Sampling heap profile: %" PRIuS " sites, %" PRIuS
+           " functions, %" PRId64 " bytes allocated, %" PRId64
+           " bytes live\n",
+           sites_, functions_, allocated_bytes_, live_bytes_);
+  }
+
+ private:
+  size_t functions_ = 0;
+  size_t sites_ = 0;
+  int64_t allocated_bytes_ = 0;
+  int64_t live_bytes_ = 0;
+};
+
+size_t CountAllocationProfileNodes(AllocationProfile::Node* node,
+                                   int64_t* live_bytes) {
+  size_t count = 1;
+  for (const AllocationProfile::Allocation& allocation : node->allocations) {
+    *live_bytes += static_cast<int64_t>(allocation.size) * allocation.count;
+  }
+  for (AllocationProfile::Node* child : node->children) {
+    count += CountAllocationProfileNodes(child, live_bytes);
+  }
+  return count;
+}
+
+// Prints a summary of the sampling heap profile, see --sampling-heap-profile.
+// The whole profile is collected, which is part of the overhead measured.
+void StopSamplingHeapProfile(Isolate* isolate, bool aggregate) {
+  HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+  if (aggregate) {
+    CountingSampledAllocationsSink sink;
+    heap_profiler->CollectSampledAllocations(&sink);
+    sink.Print();
+  } else {
+    HandleScope scope(isolate);
+    std::unique_ptr<AllocationProfile> profile(
+        heap_profiler->GetAllocationProfile());
+    int64_t live_bytes = 0;
+    size_t nodes = CountAllocationProfileNodes(profile->GetRootNode(),
+                                               &live_bytes);
+    printf("Sampling heap profile: %" PRIuS " nodes, %" PRId64
+           " bytes live\n",
+           nodes, live_bytes);
+  }
+  heap_profiler->StopSamplingHeapProfiler();
+}
+
+// Takes a heap snapshot of what the scripts left behind and prints how long
+// it took, see --heap-snapshot-benchmark.
+void BenchmarkHeapSnapshot(Isolate* isolate) {
+  HeapProfiler* heap_profiler = isolate->GetHeapProfiler();
+  base::TimeTicks start = base::TimeTicks::HighResolutionNow();
+  const HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  base::TimeDelta time = base::TimeTicks::HighResolutionNow() - start;
+  printf("HeapSnapshot(Nodes): %d\n", snapshot->GetNodesCount());
+  printf("HeapSnapshot(WallTime): %.3f\n", time.InMillisecondsF());
+  heap_profiler->DeleteAllHeapSnapshots();
+}
+
+}  // namespace
+
 int Shell::RunMain(Isolate* isolate, int argc, char* argv[], bool last_run) {
   for (int i = 1; i < options.num_isolates; ++i) {
     options.isolate_sources[i].StartExecuteInThread();
@@ -2950,6 +3401,19 @@ int Shell::RunMain(Isolate* isolate, int argc, char* argv[], bool last_run) {
     if (options.lcov_file) {
       debug::Coverage::SelectMode(isolate, debug::Coverage::kBlockCount);
     }
+    CpuProfiler* cpu_profiler = nullptr;
+    CountingProfileSink profile_sink;
+    if (options.continuous_cpu_profile) {
+      cpu_profiler = CpuProfiler::New(isolate);
+      cpu_profiler->StartContinuousProfiling(&profile_sink);
+    }
+    if (options.sampling_heap_profile) {
+      isolate->GetHeapProfiler()->StartSamplingHeapProfiler(
+          options.sampling_heap_profile_interval, 16,
+          options.sampling_heap_profile_aggregate
+              ? HeapProfiler::kSamplingAggregateStacks
+              : HeapProfiler::kSamplingNoFlags);
+    }
     HandleScope scope(isolate);
     Local<Context> context = CreateEvaluationContext(isolate);
     bool use_existing_context = last_run && use_interactive_shell();
@@ -2963,11 +3427,21 @@ int Shell::RunMain(Isolate* isolate, int argc, char* argv[], bool last_run) {
       PerIsolateData::RealmScope realm_scope(PerIsolateData::Get(isolate));
       options.isolate_sources[0].Execute(isolate);
       CompleteMessageLoop(isolate);
+      if (options.heap_snapshot_benchmark) BenchmarkHeapSnapshot(isolate);
     }
     if (!use_existing_context) {
       DisposeModuleEmbedderData(context);
     }
     WriteLcovData(isolate, options.lcov_file);
+    if (cpu_profiler) {
+      cpu_profiler->StopContinuousProfiling();
+      cpu_profiler->Dispose();
+      profile_sink.Print();
+    }
+    if (options.sampling_heap_profile) {
+      StopSamplingHeapProfile(isolate,
+                              options.sampling_heap_profile_aggregate);
+    }
   }
   CollectGarbage(isolate);
   for (int i = 1; i < options.num_isolates; ++i) {
@@ -3334,11 +3808,28 @@ int Shell::Main(int argc, char* argv[]) {
   if (options.trace_enabled && !i::FLAG_verify_predictable) {
     tracing = base::make_unique<platform::tracing::TracingController>();
 
-    trace_file.open(options.trace_path ? options.trace_path : "v8_trace.json");
-    platform::tracing::TraceBuffer* trace_buffer =
-        platform::tracing::TraceBuffer::CreateTraceBufferRingBuffer(
-            platform::tracing::TraceBuffer::kRingBufferChunks,
-            platform::tracing::TraceWriter::CreateJSONTraceWriter(trace_file));
+    platform::tracing::TraceWriter* trace_writer;
+    if (options.trace_binary_format) {
+      trace_file.open(options.trace_path ? options.trace_path : "v8_trace.bin",
+                      std::ios::out | std::ios::binary);
+      trace_writer =
+          platform::tracing::TraceWriter::CreateBinaryTraceWriter(trace_file);
+    } else {
+      trace_file.open(options.trace_path ? options.trace_path
+                                         : "v8_trace.json");
+      trace_writer =
+          platform::tracing::TraceWriter::CreateJSONTraceWriter(trace_file);
+    }
+    platform::tracing::TraceBuffer* trace_buffer;
+    if (options.trace_thread_local_buffer) {
+      trace_buffer =
+          platform::tracing::TraceBuffer::CreateThreadLocalTraceBuffer(
+              platform::tracing::TraceBuffer::kRingBufferChunks, trace_writer);
+    } else {
+      trace_buffer =
+          platform::tracing::TraceBuffer::CreateTraceBufferRingBuffer(
+              platform::tracing::TraceBuffer::kRingBufferChunks, trace_writer);
+    }
     tracing->Initialize(trace_buffer);
   }
 
@@ -3381,6 +3872,33 @@ int Shell::Main(int argc, char* argv[]) {
       base::SysInfo::AmountOfPhysicalMemory(),
       base::SysInfo::AmountOfVirtualMemory());
 
+  // Creating a startup snapshot and benchmarking context creation run the
+  // scripts in isolates of their own, after which d8 exits.
+  if (options.create_startup_snapshot_blob != nullptr ||
+      options.context_creation_benchmark) {
+    if (options.create_startup_snapshot_blob != nullptr &&
+        !CreateStartupSnapshot(options.create_startup_snapshot_blob)) {
+      result = 1;
+    } else if (options.context_creation_benchmark) {
+      BenchmarkContextCreation();
+    }
+    V8::Dispose();
+    V8::ShutdownPlatform();
+    g_platform.reset();
+    return result;
+  }
+  if (options.startup_snapshot_blob != nullptr) {
+    int size = 0;
+    char* data = ReadChars(options.startup_snapshot_blob, &size);
+    if (data == nullptr) {
+      printf("Error reading '%s'\n", options.startup_snapshot_blob);
+      return 1;
+    }
+    g_startup_snapshot.data = data;
+    g_startup_snapshot.raw_size = size;
+  }
+  UseStartupSnapshot(&create_params);
+
   Shell::counter_map_ = new CounterMap();
   if (i::FLAG_dump_counters || i::FLAG_dump_counters_nvp || i::FLAG_gc_stats) {
     create_params.counter_lookup_callback = LookupCounter;
@@ -3452,6 +3970,7 @@ int Shell::Main(int argc, char* argv[]) {
       Isolate::CreateParams create_params;
       create_params.array_buffer_allocator = Shell::array_buffer_allocator;
       i::FLAG_hash_seed ^= 1337;  // Use a different hash seed.
+      UseStartupSnapshot(&create_params);
       Isolate* isolate2 = Isolate::New(create_params);
       i::FLAG_hash_seed ^= 1337;  // Restore old hash seed.
       isolate2->SetHostImportModuleDynamicallyCallback(
@@ -3500,12 +4019,15 @@ int Shell::Main(int argc, char* argv[]) {
     CollectGarbage(isolate);
   }
   OnExit(isolate);
+  // The log is only complete once the isolate is disposed.
+  if (options.print_log_size) PrintLogSize();
   V8::Dispose();
   V8::ShutdownPlatform();
 
   // Delete the platform explicitly here to write the tracing output to the
   // tracing file.
   g_platform.reset();
+  delete[] g_startup_snapshot.data;
   return result;
 }
 
@@ -378,7 +378,19 @@ class ShellOptions {
   bool disable_in_process_stack_traces;
   int read_from_tcp_port;
   bool enable_os_system = false;
+  bool continuous_cpu_profile = false;
+  bool heap_snapshot_benchmark = false;
+  bool print_log_size = false;
+  bool sampling_heap_profile = false;
+  bool sampling_heap_profile_aggregate = false;
+  int sampling_heap_profile_interval = 512 * 1024;
+  bool trace_thread_local_buffer = false;
+  bool trace_binary_format = false;
   bool quiet_load = false;
+  const char* startup_snapshot_blob = nullptr;
+  const char* create_startup_snapshot_blob = nullptr;
+  bool context_creation_benchmark = false;
+  bool expose_fast_api = false;
   int thread_pool_size = 0;
 };
 
@@ -515,6 +527,14 @@ class Shell : public i::AllStatic {
   static void DoHostImportModuleDynamically(void* data);
   static void AddOSMethods(v8::Isolate* isolate,
                            Local<ObjectTemplate> os_template);
+  static void AddOSExternalReferences(std::vector<intptr_t>* references);
+
+  // The addresses of the callbacks of the d8 globals, which snapshots of d8
+  // contexts refer to. The list ends with 0.
+  static const intptr_t* GetExternalReferences();
+  // Makes the isolates created with {create_params} start from the snapshot
+  // of --startup-snapshot-blob, if there is one.
+  static void UseStartupSnapshot(Isolate::CreateParams* create_params);
 
   static const char* kPrompt;
   static ShellOptions options;
@@ -560,6 +580,12 @@ class Shell : public i::AllStatic {
   static void RunShell(Isolate* isolate);
   static bool SetOptions(int argc, char* argv[]);
   static Local<ObjectTemplate> CreateGlobalTemplate(Isolate* isolate);
+  static Local<Context> NewContext(Isolate* isolate,
+                                   MaybeLocal<Value> global_object);
+  static Local<Context> CreateStartupContext(Isolate* isolate);
+  static StartupData CreateStartupSnapshotBlob();
+  static bool CreateStartupSnapshot(const char* file_name);
+  static void BenchmarkContextCreation();
   static MaybeLocal<Context> CreateRealm(
       const v8::FunctionCallbackInfo<v8::Value>& args, int index,
       v8::MaybeLocal<Value> global_object);
@@ -4,6 +4,8 @@
 
 #include "src/date.h"
 
+#include <algorithm>
+
 #include "src/conversions.h"
 #include "src/objects-inl.h"
 #include "src/objects.h"
@@ -53,6 +55,9 @@ void DateCache::ResetDateCache() {
   dst_usage_counter_ = 0;
   before_ = &dst_[0];
   after_ = &dst_[1];
+  for (int i = 0; i < kTransitionBlockCount; ++i) {
+    transition_blocks_[i].index = kInvalidTransitionBlockIndex;
+  }
   ymd_valid_ = false;
 #ifdef V8_INTL_SUPPORT
   if (!FLAG_icu_timezone_data) {
@@ -220,6 +225,108 @@ void DateCache::BreakDownTime(int64_t time_ms, int* year, int* month, int* day,
   *ms = time_in_day_ms % 1000;
 }
 
+int DateCache::LocalOffsetInMs(int64_t time_ms, bool is_utc) {
+#ifdef V8_INTL_SUPPORT
+  // Without ICU the DST offsets are already cached in the DST segments.
+  if (FLAG_icu_timezone_data) {
+    return LocalOffsetFromTransitions(time_ms, is_utc);
+  }
+#endif
+  return GetLocalOffsetFromOS(time_ms, is_utc);
+}
+
+DateCache::TransitionBlock* DateCache::GetTransitionBlock(int64_t index) {
+  TransitionBlock* block =
+      &transition_blocks_[index & (kTransitionBlockCount - 1)];
+  if (block->index != index) FillTransitionBlock(block, index);
+  return block;
+}
+
+void DateCache::FillTransitionBlock(TransitionBlock* block, int64_t index) {
+  int64_t const start_ms = index * kTransitionBlockMs;
+  int64_t const last_ms = start_ms + kTransitionBlockMs - 1;
+  block->index = index;
+  block->offset_ms = GetLocalOffsetFromOS(start_ms, true);
+  block->transition_count = 0;
+
+  // Like the DST segments, this relies on the offset not changing more than
+  // once per kDefaultDSTDeltaInSec.
+  int64_t before_ms = start_ms;
+  int before_offset_ms = block->offset_ms;
+  while (before_ms < last_ms) {
+    int64_t after_ms =
+        std::min(before_ms + kDefaultDSTDeltaInSec * 1000, last_ms);
+    int after_offset_ms = GetLocalOffsetFromOS(after_ms, true);
+    if (after_offset_ms != before_offset_ms) {
+      // Find the first millisecond after before_ms with a different offset.
+      while (after_ms - before_ms > 1) {
+        int64_t middle_ms = before_ms + (after_ms - before_ms) / 2;
+        int middle_offset_ms = GetLocalOffsetFromOS(middle_ms, true);
+        if (middle_offset_ms == before_offset_ms) {
+          before_ms = middle_ms;
+        } else {
+          after_ms = middle_ms;
+          after_offset_ms = middle_offset_ms;
+        }
+      }
+      if (block->transition_count == kMaxTransitionsPerBlock) {
+        block->transition_count = -1;
+        return;
+      }
+      Transition& transition = block->transitions[block->transition_count++];
+      transition.time_ms = after_ms;
+      transition.offset_ms = after_offset_ms;
+      before_offset_ms = after_offset_ms;
+    }
+    before_ms = after_ms;
+  }
+}
+
+int DateCache::LocalOffsetFromTransitions(int64_t time_ms, bool is_utc) {
+  if (is_utc) {
+    TransitionBlock* block = GetTransitionBlock(TransitionBlockIndex(time_ms));
+    if (block->transition_count < 0) return GetLocalOffsetFromOS(time_ms, true);
+    // Find the last transition at or before time_ms.
+    Transition* end = block->transitions + block->transition_count;
+    Transition* next = std::upper_bound(
+        block->transitions, end, time_ms,
+        [](int64_t time_ms, const Transition& transition) {
+          return time_ms < transition.time_ms;
+        });
+    return next == block->transitions ? block->offset_ms
+                                      : (next - 1)->offset_ms;
+  }
+
+  // The UTC time of the local time_ms is within a day of it. Start with the
+  // offset a day earlier and apply the transitions up to a day later that
+  // took effect before time_ms in local time. Local times that are skipped
+  // or repeated by a transition get the offset from before it, like ICU's
+  // BasicTimeZone::getOffsetFromLocal with kFormer does.
+  int64_t const first_ms = time_ms - kMaxLocalOffsetInMs;
+  int64_t const last_ms = time_ms + kMaxLocalOffsetInMs;
+  int offset_ms = kInvalidLocalOffsetInMs;
+  for (int64_t index = TransitionBlockIndex(first_ms);
+       index <= TransitionBlockIndex(last_ms); index++) {
+    TransitionBlock* block = GetTransitionBlock(index);
+    if (block->transition_count < 0) {
+      return GetLocalOffsetFromOS(time_ms, false);
+    }
+    if (offset_ms == kInvalidLocalOffsetInMs) offset_ms = block->offset_ms;
+    for (int i = 0; i < block->transition_count; i++) {
+      const Transition& transition = block->transitions[i];
+      if (transition.time_ms > last_ms) break;
+      if (transition.time_ms > first_ms &&
+          time_ms < transition.time_ms +
+                        std::max(offset_ms, transition.offset_ms)) {
+        return offset_ms;
+      }
+      offset_ms = transition.offset_ms;
+    }
+  }
+  DCHECK_NE(kInvalidLocalOffsetInMs, offset_ms);
+  return offset_ms;
+}
+
 // Implements LocalTimeZonedjustment(t, isUTC)
 // ECMA 262 - ES#sec-local-time-zone-adjustment
 int DateCache::GetLocalOffsetFromOS(int64_t time_ms, bool is_utc) {
@@ -5,6 +5,8 @@
 #ifndef V8_DATE_H_
 #define V8_DATE_H_
 
+#include <limits>
+
 #include "src/base/timezone-cache.h"
 #include "src/globals.h"
 
@@ -78,9 +80,7 @@ class DateCache {
   }
 
   // ECMA 262 - ES#sec-local-time-zone-adjustment
-  int LocalOffsetInMs(int64_t time, bool is_utc) {
-    return GetLocalOffsetFromOS(time, is_utc);
-  }
+  int LocalOffsetInMs(int64_t time, bool is_utc);
 
 
   const char* LocalTimezone(int64_t time_ms) {
@@ -191,6 +191,51 @@ class DateCache {
     int last_used;
   };
 
+  // When the local offset comes from ICU, the UTC offset transitions of the
+  // local time zone are cached in blocks of about a year. A block holds the
+  // offset at its start and the transitions within it, which are found by
+  // sampling the OS offset every kDefaultDSTDeltaInSec and bisecting every
+  // change down to the millisecond. Blocks are filled lazily and kept in a
+  // direct-mapped table indexed by the block index.
+  static const int64_t kTransitionBlockMs = 365 * kMsPerDay;
+  static const int kTransitionBlockCount = 64;
+  static const int kMaxTransitionsPerBlock = 8;
+  static const int64_t kInvalidTransitionBlockIndex =
+      std::numeric_limits<int64_t>::min();
+
+  // The local time of any time differs from it by at most a day.
+  static const int64_t kMaxLocalOffsetInMs = kMsPerDay;
+
+  // A transition to {offset_ms} at the UTC time {time_ms}.
+  struct Transition {
+    int64_t time_ms;
+    int offset_ms;
+  };
+
+  struct TransitionBlock {
+    int64_t index;
+    int offset_ms;
+    // The number of transitions, or -1 if the block has more than
+    // kMaxTransitionsPerBlock of them, in which case the OS is queried
+    // directly.
+    int transition_count;
+    Transition transitions[kMaxTransitionsPerBlock];
+  };
+
+  // Computes floor(time_ms / kTransitionBlockMs).
+  static int64_t TransitionBlockIndex(int64_t time_ms) {
+    if (time_ms < 0) time_ms -= (kTransitionBlockMs - 1);
+    return time_ms / kTransitionBlockMs;
+  }
+
+  // Returns the block with the given index, filling it if needed.
+  TransitionBlock* GetTransitionBlock(int64_t index);
+
+  void FillTransitionBlock(TransitionBlock* block, int64_t index);
+
+  // Computes LocalTZA from the transition blocks.
+  int LocalOffsetFromTransitions(int64_t time_ms, bool is_utc);
+
   // Computes the daylight savings offset for the given time.
   // ECMA 262 - 15.9.1.8
   int DaylightSavingsOffsetInMs(int64_t time_ms);
@@ -227,6 +272,9 @@ class DateCache {
 
   int local_offset_ms_;
 
+  // UTC offset transition cache.
+  TransitionBlock transition_blocks_[kTransitionBlockCount];
+
   // Year/Month/Day cache.
   bool ymd_valid_;
   int ymd_days_;
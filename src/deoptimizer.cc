@@ -531,6 +531,10 @@ Deoptimizer::Deoptimizer(Isolate* isolate, JSFunction* function,
     compiled_code_->set_deopt_already_counted(true);
     PROFILE(isolate_,
             CodeDeoptEvent(compiled_code_, kind, from_, fp_to_sp_delta_));
+    if (V8_UNLIKELY(FLAG_hot_path_counters)) {
+      DeoptInfo info = GetDeoptInfo(compiled_code_, from_);
+      isolate->counters()->hot_path_counters()->CountDeopt(info.deopt_reason);
+    }
   }
   unsigned size = ComputeInputFrameSize();
   int parameter_count =
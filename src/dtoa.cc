@@ -13,10 +13,15 @@
 #include "src/double.h"
 #include "src/fast-dtoa.h"
 #include "src/fixed-dtoa.h"
+#include "src/ryu-dtoa.h"
 
 namespace v8 {
 namespace internal {
 
+// The number of requested digits up to which DTOA_FIXED and DTOA_PRECISION
+// can be answered from the shortest representation.
+static const int kShortestFastPathMaxDigits = 15;
+
 static BignumDtoaMode DtoaToBignumDtoaMode(DtoaMode dtoa_mode) {
   switch (dtoa_mode) {
     case DTOA_SHORTEST:  return BIGNUM_DTOA_SHORTEST;
@@ -54,11 +59,38 @@ void DoubleToAscii(double v, DtoaMode mode, int requested_digits,
     return;
   }
 
+  if (mode == DTOA_SHORTEST) {
+    RyuDtoa(v, buffer, length, point);
+    return;
+  }
+
+  // If the shortest representation doesn't need more digits than requested,
+  // it is also the correctly rounded result, as long as the requested
+  // precision is coarser than the double's own (half an ulp is less than
+  // 2^-53 relative, half a unit in the 15th digit at least 5 * 10^-16). The
+  // shortest representation is cheap to compute, so try it first.
+  if (requested_digits <= kShortestFastPathMaxDigits &&
+      !Double(v).IsDenormal()) {
+    char shortest_container[kRyuDtoaMaximalLength + 1];
+    Vector<char> shortest(shortest_container, kRyuDtoaMaximalLength + 1);
+    int shortest_length;
+    int shortest_point;
+    RyuDtoa(v, shortest, &shortest_length, &shortest_point);
+    bool fits = mode == DTOA_PRECISION
+                    ? shortest_length <= requested_digits
+                    : shortest_length - shortest_point <= requested_digits &&
+                          shortest_point + requested_digits <=
+                              kShortestFastPathMaxDigits;
+    if (fits) {
+      for (int i = 0; i <= shortest_length; i++) buffer[i] = shortest[i];
+      *length = shortest_length;
+      *point = shortest_point;
+      return;
+    }
+  }
+
   bool fast_worked;
   switch (mode) {
-    case DTOA_SHORTEST:
-      fast_worked = FastDtoa(v, FAST_DTOA_SHORTEST, 0, buffer, length, point);
-      break;
     case DTOA_FIXED:
       fast_worked = FastFixedDtoa(v, requested_digits, buffer, length, point);
       break;
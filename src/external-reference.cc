@@ -16,6 +16,7 @@
 #include "src/ic/stub-cache.h"
 #include "src/interpreter/interpreter.h"
 #include "src/isolate.h"
+#include "src/microtask-queue.h"
 #include "src/objects-inl.h"
 #include "src/regexp/regexp-stack.h"
 #include "src/simulator-base.h"
@@ -134,9 +135,10 @@ ExternalReference ExternalReference::handle_scope_implementer_address(
   return ExternalReference(isolate->handle_scope_implementer_address());
 }
 
-ExternalReference ExternalReference::pending_microtask_count_address(
+ExternalReference ExternalReference::default_microtask_queue(
     Isolate* isolate) {
-  return ExternalReference(isolate->pending_microtask_count_address());
+  return ExternalReference(
+      reinterpret_cast<Address>(isolate->default_microtask_queue()));
 }
 
 ExternalReference ExternalReference::interpreter_dispatch_table_address(
@@ -751,6 +753,11 @@ ExternalReference ExternalReference::orderedhashmap_gethash_raw() {
   return ExternalReference(Redirect(FUNCTION_ADDR(f)));
 }
 
+ExternalReference ExternalReference::call_enqueue_microtask_function() {
+  return ExternalReference(
+      Redirect(FUNCTION_ADDR(MicrotaskQueue::CallEnqueueMicrotask)));
+}
+
 ExternalReference ExternalReference::get_or_create_hash_raw(Isolate* isolate) {
   typedef Smi* (*GetOrCreateHash)(Isolate * isolate, Object * key);
   GetOrCreateHash f = Object::GetOrCreateHash;
@@ -352,6 +352,91 @@ void FeedbackVector::EvictOptimizedCodeMarkedForDeoptimization(
   }
 }
 
+int FeedbackVector::FindOsrCodeCacheEntry(BailoutId osr_offset) {
+  WeakFixedArray* cache = osr_code_cache();
+  for (int i = 0; i < cache->length(); i += kOsrCodeCacheEntrySize) {
+    Smi* offset = cache->Get(i + kOsrCodeCacheOffsetIndex)->ToSmi();
+    if (offset->value() == osr_offset.ToInt()) return i;
+  }
+  return -1;
+}
+
+Code* FeedbackVector::GetOsrCode(BailoutId osr_offset) {
+  int entry = FindOsrCodeCacheEntry(osr_offset);
+  if (entry < 0) return nullptr;
+  MaybeObject* slot = osr_code_cache()->Get(entry + kOsrCodeCacheCodeIndex);
+  HeapObject* heap_object;
+  if (!slot->ToWeakHeapObject(&heap_object)) return nullptr;
+  Code* code = Code::cast(heap_object);
+  if (code->marked_for_deoptimization()) {
+    ClearOsrCode(osr_offset);
+    return nullptr;
+  }
+  return code;
+}
+
+bool FeedbackVector::IsOsrCompilationInProgress(BailoutId osr_offset) {
+  int entry = FindOsrCodeCacheEntry(osr_offset);
+  if (entry < 0) return false;
+  MaybeObject* slot = osr_code_cache()->Get(entry + kOsrCodeCacheCodeIndex);
+  return slot == MaybeObject::FromSmi(
+                     Smi::FromEnum(OptimizationMarker::kInOptimizationQueue));
+}
+
+// static
+void FeedbackVector::SetOsrCode(Handle<FeedbackVector> vector,
+                                BailoutId osr_offset, Handle<Code> code) {
+  DCHECK_EQ(code->kind(), Code::OPTIMIZED_FUNCTION);
+  SetOsrCodeCacheEntry(vector, osr_offset, HeapObjectReference::Weak(*code));
+}
+
+// static
+void FeedbackVector::SetOsrCompilationInProgress(Handle<FeedbackVector> vector,
+                                                 BailoutId osr_offset) {
+  SetOsrCodeCacheEntry(
+      vector, osr_offset,
+      MaybeObject::FromSmi(
+          Smi::FromEnum(OptimizationMarker::kInOptimizationQueue)));
+}
+
+void FeedbackVector::ClearOsrCode(BailoutId osr_offset) {
+  int entry = FindOsrCodeCacheEntry(osr_offset);
+  if (entry < 0) return;
+  osr_code_cache()->Set(
+      entry + kOsrCodeCacheCodeIndex,
+      MaybeObject::FromSmi(Smi::FromEnum(OptimizationMarker::kNone)));
+}
+
+// static
+void FeedbackVector::SetOsrCodeCacheEntry(Handle<FeedbackVector> vector,
+                                          BailoutId osr_offset,
+                                          MaybeObject* value) {
+  Isolate* isolate = vector->GetIsolate();
+  int entry = vector->FindOsrCodeCacheEntry(osr_offset);
+  if (entry < 0) {
+    // Reuse an entry whose code was collected or cleared, or grow the cache.
+    Handle<WeakFixedArray> cache(vector->osr_code_cache(), isolate);
+    for (int i = 0; i < cache->length(); i += kOsrCodeCacheEntrySize) {
+      MaybeObject* slot = cache->Get(i + kOsrCodeCacheCodeIndex);
+      if (slot->IsClearedWeakHeapObject() ||
+          slot == MaybeObject::FromSmi(
+                      Smi::FromEnum(OptimizationMarker::kNone))) {
+        entry = i;
+        break;
+      }
+    }
+    if (entry < 0) {
+      entry = cache->length();
+      cache = isolate->factory()->CopyWeakFixedArrayAndGrow(
+          cache, kOsrCodeCacheEntrySize, TENURED);
+      vector->set_osr_code_cache(*cache);
+    }
+    cache->Set(entry + kOsrCodeCacheOffsetIndex,
+               MaybeObject::FromSmi(Smi::FromInt(osr_offset.ToInt())));
+  }
+  vector->osr_code_cache()->Set(entry + kOsrCodeCacheCodeIndex, value);
+}
+
 bool FeedbackVector::ClearSlots(Isolate* isolate) {
   MaybeObject* uninitialized_sentinel = MaybeObject::FromObject(
       FeedbackVector::RawUninitializedSentinel(isolate));
@@ -170,6 +170,11 @@ class FeedbackVector : public HeapObject, public NeverReadOnlySpaceObject {
   // marker defining optimization behaviour.
   DECL_ACCESSORS(optimized_code_weak_or_smi, MaybeObject)
 
+  // [osr_code_cache]: optimized code for on-stack replacement, as pairs of
+  // the bytecode offset of a loop's back edge and a weak reference to the
+  // code, or a Smi marker while the code is being compiled concurrently.
+  DECL_ACCESSORS(osr_code_cache, WeakFixedArray)
+
   // [length]: The length of the feedback vector (not including the header, i.e.
   // the number of feedback slots).
   DECL_INT32_ACCESSORS(length)
@@ -201,6 +206,18 @@ class FeedbackVector : public HeapObject, public NeverReadOnlySpaceObject {
   // Clears the optimization marker in the feedback vector.
   void ClearOptimizationMarker();
 
+  // OSR code is cached per loop, so that later activations spinning in the
+  // same loop can enter it without recompiling, and so that a concurrent OSR
+  // job can hand its result back to the interpreter.
+  Code* GetOsrCode(BailoutId osr_offset);
+  bool IsOsrCompilationInProgress(BailoutId osr_offset);
+  static void SetOsrCode(Handle<FeedbackVector> vector, BailoutId osr_offset,
+                         Handle<Code> code);
+  static void SetOsrCompilationInProgress(Handle<FeedbackVector> vector,
+                                          BailoutId osr_offset);
+  // Does not allocate, so it can be used when disposing compilation jobs.
+  void ClearOsrCode(BailoutId osr_offset);
+
   // Conversion from a slot to an integer index to the underlying array.
   static int GetIndex(FeedbackSlot slot) { return slot.ToInt(); }
 
@@ -284,6 +301,7 @@ class FeedbackVector : public HeapObject, public NeverReadOnlySpaceObject {
   /* Header fields. */                       \
   V(kSharedFunctionInfoOffset, kPointerSize) \
   V(kOptimizedCodeOffset, kPointerSize)      \
+  V(kOsrCodeCacheOffset, kPointerSize)       \
   V(kLengthOffset, kInt32Size)               \
   V(kInvocationCountOffset, kInt32Size)      \
   V(kProfilerTicksOffset, kInt32Size)        \
@@ -307,6 +325,15 @@ class FeedbackVector : public HeapObject, public NeverReadOnlySpaceObject {
   }
 
  private:
+  static const int kOsrCodeCacheEntrySize = 2;
+  static const int kOsrCodeCacheOffsetIndex = 0;
+  static const int kOsrCodeCacheCodeIndex = 1;
+
+  // Returns the index of the entry for |osr_offset|, or -1.
+  int FindOsrCodeCacheEntry(BailoutId osr_offset);
+  static void SetOsrCodeCacheEntry(Handle<FeedbackVector> vector,
+                                   BailoutId osr_offset, MaybeObject* value);
+
   static void AddToVectorsForProfilingTools(Isolate* isolate,
                                             Handle<FeedbackVector> vector);
 
@@ -420,6 +420,7 @@ Handle<FeedbackVector> Factory::NewFeedbackVector(
   vector->set_optimized_code_weak_or_smi(MaybeObject::FromSmi(Smi::FromEnum(
       FLAG_log_function_events ? OptimizationMarker::kLogFirstExecution
                                : OptimizationMarker::kNone)));
+  vector->set_osr_code_cache(*empty_weak_fixed_array(), SKIP_WRITE_BARRIER);
   vector->set_length(length);
   vector->set_invocation_count(0);
   vector->set_profiler_ticks(0);
@@ -1936,9 +1937,11 @@ Handle<JSObject> Factory::CopyJSObjectWithAllocationSite(
       clone->set_raw_properties_or_hash(*prop);
     }
   } else {
-    Handle<FixedArray> properties(
-        FixedArray::cast(source->property_dictionary()), isolate());
-    Handle<FixedArray> prop = CopyFixedArray(properties);
+    Handle<NameDictionary> properties(source->property_dictionary(),
+                                      isolate());
+    Handle<NameDictionary> prop =
+        Handle<NameDictionary>::cast(CopyFixedArray(properties));
+    NameDictionary::CopyControlTable(isolate(), prop);
     clone->set_raw_properties_or_hash(*prop);
   }
   return clone;
@@ -3810,7 +3813,8 @@ void Factory::SetRegExpAtomData(Handle<JSRegExp> regexp, JSRegExp::Type type,
 
 void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
                                     JSRegExp::Type type, Handle<String> source,
-                                    JSRegExp::Flags flags, int capture_count) {
+                                    JSRegExp::Flags flags, int capture_count,
+                                    int backtrack_limit) {
   Handle<FixedArray> store = NewFixedArray(JSRegExp::kIrregexpDataSize);
   Smi* uninitialized = Smi::FromInt(JSRegExp::kUninitializedValue);
   store->set(JSRegExp::kTagIndex, Smi::FromInt(type));
@@ -3821,6 +3825,9 @@ void Factory::SetRegExpIrregexpData(Handle<JSRegExp> regexp,
   store->set(JSRegExp::kIrregexpMaxRegisterCountIndex, Smi::kZero);
   store->set(JSRegExp::kIrregexpCaptureCountIndex, Smi::FromInt(capture_count));
   store->set(JSRegExp::kIrregexpCaptureNameMapIndex, uninitialized);
+  store->set(JSRegExp::kIrregexpBacktrackLimitIndex,
+             Smi::FromInt(backtrack_limit));
+  store->set(JSRegExp::kIrregexpNfaProgramIndex, uninitialized);
   regexp->set_data(*store);
 }
 
@@ -49,6 +49,7 @@
 #include "src/heap/sweeper.h"
 #include "src/instruction-stream.h"
 #include "src/interpreter/interpreter.h"
+#include "src/microtask-queue.h"
 #include "src/objects/data-handler.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/maybe-object.h"
@@ -754,6 +755,19 @@ void Heap::AddAllocationObserversToAllSpaces(
   }
 }
 
+void Heap::AddWeakObjectTable(WeakObjectTable* table) {
+  DCHECK(std::find(weak_object_tables_.begin(), weak_object_tables_.end(),
+                   table) == weak_object_tables_.end());
+  weak_object_tables_.push_back(table);
+}
+
+void Heap::RemoveWeakObjectTable(WeakObjectTable* table) {
+  auto it =
+      std::find(weak_object_tables_.begin(), weak_object_tables_.end(), table);
+  DCHECK(it != weak_object_tables_.end());
+  weak_object_tables_.erase(it);
+}
+
 void Heap::RemoveAllocationObserversFromAllSpaces(
     AllocationObserver* observer, AllocationObserver* new_space_observer) {
   DCHECK(observer && new_space_observer);
@@ -2450,11 +2464,13 @@ void Heap::UpdateReferencesInExternalStringTable(
 void Heap::ProcessAllWeakReferences(WeakObjectRetainer* retainer) {
   ProcessNativeContexts(retainer);
   ProcessAllocationSites(retainer);
+  ProcessWeakObjectTables(retainer, false);
 }
 
 
 void Heap::ProcessYoungWeakReferences(WeakObjectRetainer* retainer) {
   ProcessNativeContexts(retainer);
+  ProcessWeakObjectTables(retainer, true);
 }
 
 
@@ -2474,6 +2490,14 @@ void Heap::ProcessAllocationSites(WeakObjectRetainer* retainer) {
 void Heap::ProcessWeakListRoots(WeakObjectRetainer* retainer) {
   set_native_contexts_list(retainer->RetainAs(native_contexts_list()));
   set_allocation_sites_list(retainer->RetainAs(allocation_sites_list()));
+  ProcessWeakObjectTables(retainer, false);
+}
+
+void Heap::ProcessWeakObjectTables(WeakObjectRetainer* retainer,
+                                   bool young_only) {
+  for (WeakObjectTable* table : weak_object_tables_) {
+    table->ProcessWeakReferences(retainer, young_only);
+  }
 }
 
 void Heap::ForeachAllocationSite(Object* list,
@@ -2687,7 +2711,6 @@ bool Heap::RootCanBeWrittenAfterInitialization(Heap::RootListIndex root_index) {
     case kCodeStubsRootIndex:
     case kScriptListRootIndex:
     case kMaterializedObjectsRootIndex:
-    case kMicrotaskQueueRootIndex:
     case kDetachedContextsRootIndex:
     case kRetainedMapsRootIndex:
     case kRetainingPathTargetsRootIndex:
@@ -3609,6 +3632,9 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                                       bool is_isolate_locked) {
   MemoryPressureLevel previous = memory_pressure_level_;
   memory_pressure_level_ = level;
+  // Zone segments are pooled across compilations; release them right away
+  // instead of waiting for the GC. The allocator is thread-safe.
+  isolate()->allocator()->MemoryPressureNotification(level);
   if ((previous != MemoryPressureLevel::kCritical &&
        level == MemoryPressureLevel::kCritical) ||
       (previous == MemoryPressureLevel::kNone &&
@@ -4176,6 +4202,10 @@ void Heap::IterateStrongRoots(RootVisitor* v, VisitMode mode) {
   isolate_->IterateDeferredHandles(v);
   v->Synchronize(VisitorSynchronization::kHandleScope);
 
+  // Iterate over pending microtasks.
+  isolate_->default_microtask_queue()->IterateMicrotasks(v);
+  v->Synchronize(VisitorSynchronization::kMicroTasks);
+
   // Iterate over the builtin code objects and code stubs in the
   // heap. Note that it is not necessary to iterate over code objects
   // on scavenge collections.
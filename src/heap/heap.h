@@ -165,6 +165,7 @@ using v8::MemoryPressureLevel;
   PRIVATE_SYMBOL_LIST(V)
 
 class AllocationObserver;
+class WeakObjectTable;
 class ArrayBufferCollector;
 class ArrayBufferTracker;
 class ConcurrentMarking;
@@ -1399,6 +1400,11 @@ class Heap {
   void RemoveAllocationObserversFromAllSpaces(
       AllocationObserver* observer, AllocationObserver* new_space_observer);
 
+  // Adds a {table} of weak references that the GC keeps up to date, see
+  // WeakObjectTable.
+  void AddWeakObjectTable(WeakObjectTable* table);
+  void RemoveWeakObjectTable(WeakObjectTable* table);
+
   bool allocation_step_in_progress() { return allocation_step_in_progress_; }
   void set_allocation_step_in_progress(bool val) {
     allocation_step_in_progress_ = val;
@@ -1794,6 +1800,7 @@ class Heap {
   void ProcessNativeContexts(WeakObjectRetainer* retainer);
   void ProcessAllocationSites(WeakObjectRetainer* retainer);
   void ProcessWeakListRoots(WeakObjectRetainer* retainer);
+  void ProcessWeakObjectTables(WeakObjectRetainer* retainer, bool young_only);
 
   // ===========================================================================
   // GC statistics. ============================================================
@@ -2112,6 +2119,8 @@ class Heap {
   std::vector<GCCallbackTuple> gc_epilogue_callbacks_;
   std::vector<GCCallbackTuple> gc_prologue_callbacks_;
 
+  std::vector<WeakObjectTable*> weak_object_tables_;
+
   GetExternallyAllocatedMemoryInBytesCallback external_memory_callback_;
 
   int deferred_counters_[v8::Isolate::kUseCounterFeatureCount];
@@ -2491,6 +2500,21 @@ class WeakObjectRetainer {
   virtual Object* RetainAs(Object* object) = 0;
 };
 
+// A table of weak references to heap objects that lives outside of the heap.
+// Unlike weak global handles, the references cost nothing until the GC
+// processes the table, which it does once per GC, see
+// Heap::AddWeakObjectTable().
+class WeakObjectTable {
+ public:
+  virtual ~WeakObjectTable() {}
+
+  // Updates the references with {retainer}, which returns nullptr for dead
+  // objects and the current location of the others. If {young_only} is set,
+  // only the references into new space need to be processed.
+  virtual void ProcessWeakReferences(WeakObjectRetainer* retainer,
+                                     bool young_only) = 0;
+};
+
 // -----------------------------------------------------------------------------
 // Allows observation of allocations.
 class AllocationObserver {
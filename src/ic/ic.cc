@@ -82,6 +82,14 @@ const char* GetModifier(KeyedAccessStoreMode mode) {
 }  // namespace
 
 void IC::TraceIC(const char* type, Handle<Object> name) {
+  if (V8_UNLIKELY(FLAG_hot_path_counters) && !AddressIsDeoptimizedCode()) {
+    // Read the function from the frame, walking the stack is too slow here.
+    Object* maybe_function =
+        Memory::Object_at(fp_ + JavaScriptFrameConstants::kFunctionOffset);
+    DCHECK(maybe_function->IsJSFunction());
+    isolate()->counters()->hot_path_counters()->CountICMiss(
+        JSFunction::cast(maybe_function)->shared(), nexus()->slot().ToInt());
+  }
   if (FLAG_ic_stats) {
     if (AddressIsDeoptimizedCode()) return;
     State new_state = nexus()->StateFromFeedback();
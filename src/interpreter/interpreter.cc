@@ -11,6 +11,7 @@
 #include "src/bootstrapper.h"
 #include "src/compiler.h"
 #include "src/counters-inl.h"
+#include "src/global-handles.h"
 #include "src/interpreter/bytecode-generator.h"
 #include "src/interpreter/bytecodes.h"
 #include "src/log.h"
@@ -59,6 +60,59 @@ Interpreter::Interpreter(Isolate* isolate) : isolate_(isolate) {
   }
 }
 
+Interpreter::~Interpreter() {
+  for (auto& copy : trampoline_copies_) {
+    if (copy.second != nullptr) GlobalHandles::Destroy(copy.second);
+  }
+}
+
+Handle<Code> Interpreter::GetInterpreterEntryTrampolineCopy(
+    const std::string& name, bool* is_new) {
+  DCHECK(FLAG_interpreted_frames_native_stack);
+  auto it = trampoline_copies_.find(name);
+  if (it != trampoline_copies_.end() && it->second != nullptr) {
+    isolate_->counters()->interpreter_trampolines_shared()->Increment();
+    *is_new = false;
+    return Handle<Code>(Code::cast(*it->second), isolate_);
+  }
+
+  Handle<Code> code;
+  {
+    CodeSpaceMemoryModificationScope code_allocation(isolate_->heap());
+    code = isolate_->factory()->CopyCode(
+        BUILTIN_CODE(isolate_, InterpreterEntryTrampoline));
+  }
+  isolate_->counters()->interpreter_trampoline_copies()->Increment();
+  isolate_->counters()->interpreter_trampoline_copies_size()->Increment(
+      code->Size());
+
+  if (it == trampoline_copies_.end()) {
+    if (trampoline_copies_.size() >= trampoline_copies_to_prune_) {
+      PruneInterpreterEntryTrampolineCopies();
+    }
+    it = trampoline_copies_.emplace(name, nullptr).first;
+  }
+  Handle<Object> global = isolate_->global_handles()->Create(*code);
+  it->second = global.location();
+  GlobalHandles::MakeWeak(&it->second);
+  *is_new = true;
+  return code;
+}
+
+void Interpreter::PruneInterpreterEntryTrampolineCopies() {
+  for (auto it = trampoline_copies_.begin(); it != trampoline_copies_.end();) {
+    if (it->second == nullptr) {
+      it = trampoline_copies_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  trampoline_copies_to_prune_ = 2 * trampoline_copies_.size();
+  if (trampoline_copies_to_prune_ < kMinTrampolineCopiesToPrune) {
+    trampoline_copies_to_prune_ = kMinTrampolineCopiesToPrune;
+  }
+}
+
 Code* Interpreter::GetAndMaybeDeserializeBytecodeHandler(
     Bytecode bytecode, OperandScale operand_scale) {
   Code* code = GetBytecodeHandler(bytecode, operand_scale);
@@ -6,6 +6,8 @@
 #define V8_INTERPRETER_INTERPRETER_H_
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 // Clients of this interface shouldn't depend on lots of interpreter internals.
 // Do not include anything from src/interpreter other than
@@ -36,7 +38,7 @@ class InterpreterAssembler;
 class Interpreter {
  public:
   explicit Interpreter(Isolate* isolate);
-  virtual ~Interpreter() {}
+  virtual ~Interpreter();
 
   // Returns the interrupt budget which should be used for the profiler counter.
   static int InterruptBudget();
@@ -61,6 +63,15 @@ class Interpreter {
   void SetBytecodeHandler(Bytecode bytecode, OperandScale operand_scale,
                           Code* handler);
 
+  // Returns the copy of the InterpreterEntryTrampoline for the functions
+  // named {name} by the code-creation events, see
+  // --interpreted-frames-native-stack. Functions with the same name, e.g. the
+  // ones of a script that is loaded again, share their copy since external
+  // profilers could not tell their frames apart anyway. Sets {is_new} if the
+  // copy was created by this call.
+  Handle<Code> GetInterpreterEntryTrampolineCopy(const std::string& name,
+                                                 bool* is_new);
+
   // GC support.
   void IterateDispatchTable(RootVisitor* v);
 
@@ -86,6 +97,9 @@ class Interpreter {
 
   uintptr_t GetDispatchCounter(Bytecode from, Bytecode to) const;
 
+  // Removes the copies of the InterpreterEntryTrampoline that died.
+  void PruneInterpreterEntryTrampolineCopies();
+
   // Get dispatch table index of bytecode.
   static size_t GetDispatchTableIndex(Bytecode bytecode,
                                       OperandScale operand_scale);
@@ -93,10 +107,15 @@ class Interpreter {
   static const int kNumberOfWideVariants = BytecodeOperands::kOperandScaleCount;
   static const int kDispatchTableSize = kNumberOfWideVariants * (kMaxUInt8 + 1);
   static const int kNumberOfBytecodes = static_cast<int>(Bytecode::kLast) + 1;
+  static const size_t kMinTrampolineCopiesToPrune = 64;
 
   Isolate* isolate_;
   Address dispatch_table_[kDispatchTableSize];
   std::unique_ptr<uintptr_t[]> bytecode_dispatch_counters_table_;
+  // Weak global handles to the copies of the InterpreterEntryTrampoline, by
+  // name. The GC clears the handles of the copies that die.
+  std::unordered_map<std::string, Object**> trampoline_copies_;
+  size_t trampoline_copies_to_prune_ = kMinTrampolineCopiesToPrune;
 
   DISALLOW_COPY_AND_ASSIGN(Interpreter);
 };
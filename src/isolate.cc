@@ -7,7 +7,9 @@
 #include <stdlib.h>
 
 #include <atomic>
+#include <cmath>
 #include <fstream>  // NOLINT(readability/streams)
+#include <limits>
 #include <sstream>
 #include <unordered_map>
 
@@ -39,6 +41,7 @@
 #include "src/libsampler/sampler.h"
 #include "src/log.h"
 #include "src/messages.h"
+#include "src/microtask-queue.h"
 #include "src/objects/frame-array-inl.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/js-array-inl.h"
@@ -63,6 +66,7 @@
 #include "src/wasm/wasm-objects.h"
 #include "src/zone/accounting-allocator.h"
 #ifdef V8_INTL_SUPPORT
+#include "src/objects/intl-objects.h"
 #include "unicode/regex.h"
 #endif  // V8_INTL_SUPPORT
 
@@ -2102,21 +2106,25 @@ bool InternalPromiseHasUserDefinedRejectHandler(Isolate* isolate,
       Handle<PromiseReaction> reaction = Handle<PromiseReaction>::cast(current);
       Handle<HeapObject> promise_or_capability(
           reaction->promise_or_capability(), isolate);
-      Handle<JSPromise> promise = Handle<JSPromise>::cast(
-          promise_or_capability->IsJSPromise()
-              ? promise_or_capability
-              : handle(Handle<PromiseCapability>::cast(promise_or_capability)
-                           ->promise(),
-                       isolate));
-      if (reaction->reject_handler()->IsUndefined(isolate)) {
-        if (InternalPromiseHasUserDefinedRejectHandler(isolate, promise)) {
-          return true;
-        }
-      } else {
-        Handle<JSReceiver> current_handler(
-            JSReceiver::cast(reaction->reject_handler()), isolate);
-        if (PromiseHandlerCheck(isolate, current_handler, promise)) {
-          return true;
+      // Reactions registered by an await while the debugger was inactive
+      // have no result promise to follow.
+      if (!promise_or_capability->IsUndefined(isolate)) {
+        Handle<JSPromise> promise = Handle<JSPromise>::cast(
+            promise_or_capability->IsJSPromise()
+                ? promise_or_capability
+                : handle(Handle<PromiseCapability>::cast(promise_or_capability)
+                             ->promise(),
+                         isolate));
+        if (reaction->reject_handler()->IsUndefined(isolate)) {
+          if (InternalPromiseHasUserDefinedRejectHandler(isolate, promise)) {
+            return true;
+          }
+        } else {
+          Handle<JSReceiver> current_handler(
+              JSReceiver::cast(reaction->reject_handler()), isolate);
+          if (PromiseHandlerCheck(isolate, current_handler, promise)) {
+            return true;
+          }
         }
       }
       current = handle(reaction->next(), isolate);
@@ -2461,6 +2469,7 @@ Isolate::Isolate()
       deoptimizer_data_(nullptr),
       deoptimizer_lazy_throw_(false),
       materialized_object_store_(nullptr),
+      default_microtask_queue_(nullptr),
       capture_stack_trace_for_uncaught_exceptions_(false),
       stack_trace_for_uncaught_exceptions_frame_limit_(0),
       stack_trace_for_uncaught_exceptions_options_(StackTrace::kOverview),
@@ -2495,6 +2504,7 @@ Isolate::Isolate()
       language_tag_regexp_matcher_(nullptr),
       language_variant_regexp_matcher_(nullptr),
       default_locale_(""),
+      icu_object_cache_(nullptr),
 #endif  // V8_INTL_SUPPORT
       serializer_enabled_(false),
       has_fatal_error_(false),
@@ -2610,6 +2620,13 @@ void Isolate::ClearSerializerData() {
   external_reference_map_ = nullptr;
 }
 
+#ifdef V8_INTL_SUPPORT
+void Isolate::ClearCachedICUObjects() {
+  if (icu_object_cache_ != nullptr) icu_object_cache_->Clear();
+  default_locale_.clear();
+}
+#endif  // V8_INTL_SUPPORT
+
 
 void Isolate::Deinit() {
   TRACE_ISOLATE(deinit);
@@ -2726,6 +2743,9 @@ Isolate::~Isolate() {
 
   delete language_variant_regexp_matcher_;
   language_variant_regexp_matcher_ = nullptr;
+
+  delete icu_object_cache_;
+  icu_object_cache_ = nullptr;
 #endif  // V8_INTL_SUPPORT
 
   delete regexp_stack_;
@@ -2744,6 +2764,9 @@ Isolate::~Isolate() {
   delete materialized_object_store_;
   materialized_object_store_ = nullptr;
 
+  delete default_microtask_queue_;
+  default_microtask_queue_ = nullptr;
+
   delete logger_;
   logger_ = nullptr;
 
@@ -2948,6 +2971,7 @@ bool Isolate::Init(StartupDeserializer* des) {
   load_stub_cache_ = new StubCache(this);
   store_stub_cache_ = new StubCache(this);
   materialized_object_store_ = new MaterializedObjectStore(this);
+  default_microtask_queue_ = new MicrotaskQueue();
   regexp_stack_ = new RegExpStack();
   regexp_stack_->isolate_ = this;
   date_cache_ = new DateCache();
@@ -3716,7 +3740,7 @@ void Isolate::FireCallCompletedCallback() {
   if (!handle_scope_implementer()->CallDepthIsZero()) return;
 
   bool run_microtasks =
-      pending_microtask_count() &&
+      default_microtask_queue()->size() &&
       !handle_scope_implementer()->HasMicrotasksSuppressions() &&
       handle_scope_implementer()->microtasks_policy() ==
           v8::MicrotasksPolicy::kAuto;
@@ -3934,47 +3958,56 @@ void Isolate::ReportPromiseReject(Handle<JSPromise> promise,
 }
 
 void Isolate::EnqueueMicrotask(Handle<Microtask> microtask) {
-  Handle<FixedArray> queue(heap()->microtask_queue(), this);
-  int num_tasks = pending_microtask_count();
-  DCHECK_LE(num_tasks, queue->length());
-  if (num_tasks == queue->length()) {
-    queue = factory()->CopyFixedArrayAndGrow(queue, std::max(num_tasks, 8));
-    heap()->set_microtask_queue(*queue);
-  }
-  DCHECK_LE(8, queue->length());
-  DCHECK_LT(num_tasks, queue->length());
-  DCHECK(queue->get(num_tasks)->IsUndefined(this));
-  queue->set(num_tasks, *microtask);
-  set_pending_microtask_count(num_tasks + 1);
+  default_microtask_queue()->EnqueueMicrotask(*microtask);
 }
 
-
 void Isolate::RunMicrotasks() {
+  RunMicrotasks(std::numeric_limits<double>::infinity());
+}
+
+bool Isolate::RunMicrotasks(double time_budget_in_ms) {
   // Increase call depth to prevent recursive callbacks.
   v8::Isolate::SuppressMicrotaskExecutionScope suppress(
       reinterpret_cast<v8::Isolate*>(this));
-  if (pending_microtask_count()) {
+  MicrotaskQueue* queue = default_microtask_queue();
+  if (queue->size()) {
     is_running_microtasks_ = true;
     TRACE_EVENT0("v8.execute", "RunMicrotasks");
     TRACE_EVENT_CALL_STATS_SCOPED(this, "v8", "V8.RunMicrotasks");
 
+    // Without a time budget, a single call to the RunMicrotasks builtin
+    // drains the queue. Otherwise the builtin returns after every batch of
+    // microtasks, so that the time can be checked in between.
+    bool has_time_budget = std::isfinite(time_budget_in_ms);
+    double deadline =
+        heap()->MonotonicallyIncreasingTimeInMs() + time_budget_in_ms;
+    queue->set_batch_limit(has_time_budget ? MicrotaskQueue::kBatchSize
+                                           : MicrotaskQueue::kNoBatchLimit);
+
     HandleScope scope(this);
-    MaybeHandle<Object> maybe_exception;
-    MaybeHandle<Object> maybe_result = Execution::RunMicrotasks(
-        this, Execution::MessageHandling::kReport, &maybe_exception);
-    // If execution is terminating, bail out, clean up, and propagate to
-    // TryCatch scope.
-    if (maybe_result.is_null() && maybe_exception.is_null()) {
-      heap()->set_microtask_queue(ReadOnlyRoots(heap()).empty_fixed_array());
-      set_pending_microtask_count(0);
-      handle_scope_implementer()->LeaveMicrotaskContext();
-      SetTerminationOnExternalTryCatch();
-    }
-    CHECK_EQ(0, pending_microtask_count());
-    CHECK_EQ(0, heap()->microtask_queue()->length());
+    do {
+      MaybeHandle<Object> maybe_exception;
+      MaybeHandle<Object> maybe_result = Execution::RunMicrotasks(
+          this, Execution::MessageHandling::kReport, &maybe_exception);
+      // If execution is terminating, bail out, clean up, and propagate to
+      // TryCatch scope.
+      if (maybe_result.is_null() && maybe_exception.is_null()) {
+        queue->Clear();
+        handle_scope_implementer()->LeaveMicrotaskContext();
+        SetTerminationOnExternalTryCatch();
+        break;
+      }
+    } while (queue->size() &&
+             heap()->MonotonicallyIncreasingTimeInMs() < deadline);
+
+    queue->set_batch_limit(MicrotaskQueue::kNoBatchLimit);
+    if (!has_time_budget) CHECK_EQ(0, queue->size());
+    queue->Shrink();
     is_running_microtasks_ = false;
   }
+  if (queue->size()) return false;
   FireMicrotasksCompletedCallback();
+  return true;
 }
 
 void Isolate::SetUseCounterCallback(v8::Isolate::UseCounterCallback callback) {
@@ -85,12 +85,14 @@ class ExternalCallbackScope;
 class HandleScopeImplementer;
 class HeapObjectToIndexHashMap;
 class HeapProfiler;
+class ICUObjectCache;
 class InlineRuntimeFunctionsTable;
 class InnerPointerToCodeCache;
 class InstructionStream;
 class Logger;
 class MaterializedObjectStore;
 class Microtask;
+class MicrotaskQueue;
 class OptimizingCompileDispatcher;
 class PromiseOnStack;
 class Redirection;
@@ -531,7 +533,6 @@ typedef std::vector<HeapObject*> DebugObjectCache;
   V(const intptr_t*, api_external_references, nullptr)                        \
   V(AddressToIndexHashMap*, external_reference_map, nullptr)                  \
   V(HeapObjectToIndexHashMap*, root_index_map, nullptr)                       \
-  V(int, pending_microtask_count, 0)                                          \
   V(CompilationStatistics*, turbo_statistics, nullptr)                        \
   V(CodeTracer*, code_tracer, nullptr)                                        \
   V(uint32_t, per_isolate_assert_data, 0xFFFFFFFFu)                           \
@@ -1031,6 +1032,10 @@ class Isolate : private HiddenFactory {
     return materialized_object_store_;
   }
 
+  MicrotaskQueue* default_microtask_queue() const {
+    return default_microtask_queue_;
+  }
+
   ContextSlotCache* context_slot_cache() {
     return context_slot_cache_;
   }
@@ -1210,6 +1215,17 @@ class Isolate : private HiddenFactory {
 
   const std::string& default_locale() { return default_locale_; }
 
+  ICUObjectCache* icu_object_cache() { return icu_object_cache_; }
+
+  void set_icu_object_cache(ICUObjectCache* icu_object_cache) {
+    DCHECK_NULL(icu_object_cache_);
+    icu_object_cache_ = icu_object_cache;
+  }
+
+  // Drops the cached ICU objects and the default locale, e.g. after the
+  // embedder changed the time zone.
+  void ClearCachedICUObjects();
+
   void set_default_locale(const std::string& locale) {
     DCHECK_EQ(default_locale_.length(), 0);
     default_locale_ = locale;
@@ -1375,6 +1391,10 @@ class Isolate : private HiddenFactory {
 
   void EnqueueMicrotask(Handle<Microtask> microtask);
   void RunMicrotasks();
+  // Runs microtasks until the queue is empty or {time_budget_in_ms} have
+  // passed. The time is checked after every MicrotaskQueue::kBatchSize
+  // microtasks. Returns true if the queue is empty.
+  bool RunMicrotasks(double time_budget_in_ms);
   bool IsRunningMicrotasks() const { return is_running_microtasks_; }
 
   Handle<Symbol> SymbolFor(Heap::RootListIndex dictionary_index,
@@ -1401,10 +1421,6 @@ class Isolate : private HiddenFactory {
     return reinterpret_cast<Address>(&promise_hook_or_async_event_delegate_);
   }
 
-  Address pending_microtask_count_address() {
-    return reinterpret_cast<Address>(&pending_microtask_count_);
-  }
-
   Address handle_scope_implementer_address() {
     return reinterpret_cast<Address>(&handle_scope_implementer_);
   }
@@ -1684,6 +1700,7 @@ class Isolate : private HiddenFactory {
   DeoptimizerData* deoptimizer_data_;
   bool deoptimizer_lazy_throw_;
   MaterializedObjectStore* materialized_object_store_;
+  MicrotaskQueue* default_microtask_queue_;
   ThreadLocalTop thread_local_top_;
   bool capture_stack_trace_for_uncaught_exceptions_;
   int stack_trace_for_uncaught_exceptions_frame_limit_;
@@ -1725,6 +1742,7 @@ class Isolate : private HiddenFactory {
   icu::RegexMatcher* language_tag_regexp_matcher_;
   icu::RegexMatcher* language_variant_regexp_matcher_;
   std::string default_locale_;
+  ICUObjectCache* icu_object_cache_;
 #endif  // V8_INTL_SUPPORT
 
   // Whether the isolate has been created for snapshotting.
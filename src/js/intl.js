@@ -1450,6 +1450,8 @@ var defaultObjects = {
 };
 
 function clearDefaultObjects() {
+  defaultObjects['collator'] = UNDEFINED;
+  defaultObjects['numberformat'] = UNDEFINED;
   defaultObjects['dateformatall'] = UNDEFINED;
   defaultObjects['dateformatdate'] = UNDEFINED;
   defaultObjects['dateformattime'] = UNDEFINED;
@@ -4,6 +4,8 @@
 
 #include "src/libplatform/tracing/trace-buffer.h"
 
+#include <algorithm>
+
 namespace v8 {
 namespace platform {
 namespace tracing {
@@ -87,6 +89,258 @@ size_t TraceBufferRingBuffer::NextChunkIndex(size_t index) const {
   return index;
 }
 
+ThreadLocalTraceBuffer::ThreadLocalTraceBuffer(size_t max_chunks,
+                                               TraceWriter* trace_writer)
+    : max_chunks_(max_chunks),
+      high_water_mark_(std::max<size_t>(1, max_chunks * 3 / 4)),
+      low_water_mark_(max_chunks / 4),
+      slots_(new Slot[max_chunks]),
+      thread_state_key_(
+          base::Thread::CreateThreadLocalKey(&ReleaseThreadState)),
+      trace_writer_(trace_writer),
+      flusher_semaphore_(0),
+      flusher_thread_(this) {
+  flusher_thread_.Start();
+}
+
+ThreadLocalTraceBuffer::~ThreadLocalTraceBuffer() {
+  base::Release_Store(&flusher_stopped_, 1);
+  flusher_semaphore_.Signal();
+  flusher_thread_.Join();
+  base::Thread::DeleteThreadLocalKey(thread_state_key_);
+  // The threads that are still alive will not release their state anymore.
+  base::LockGuard<base::Mutex> guard(&thread_states_mutex_);
+  for (ThreadState* state : thread_states_) delete state;
+}
+
+TraceObject* ThreadLocalTraceBuffer::AddTraceEvent(uint64_t* handle) {
+  ThreadState* state = GetThreadState();
+  Unpin(state);
+  Slot* slot = state->owned;
+  // A full chunk is only published when the thread adds the next event, so
+  // that the last event has been initialized by the time it is written.
+  if (slot != nullptr && slot->chunk->IsFull()) {
+    PublishSlot(slot);
+    slot = nullptr;
+  }
+  if (slot == nullptr) {
+    slot = state->owned = AcquireSlot();
+    if (slot == nullptr) {
+      *handle = 0;
+      return nullptr;
+    }
+  }
+  size_t event_index;
+  TraceObject* trace_object = slot->chunk->AddTraceEvent(&event_index);
+  // The caller initializes the new event after this returns, but it has
+  // initialized the previous ones.
+  base::Release_Store(&slot->size, static_cast<base::Atomic32>(event_index));
+  *handle = MakeHandle(slot - slots_.get(),
+                       static_cast<uint32_t>(base::Relaxed_Load(&slot->seq)),
+                       event_index);
+  return trace_object;
+}
+
+TraceObject* ThreadLocalTraceBuffer::GetEventByHandle(uint64_t handle) {
+  ThreadState* state = GetThreadState();
+  Unpin(state);
+  uint32_t chunk_seq = static_cast<uint32_t>(handle / Capacity());
+  size_t indices = handle % Capacity();
+  size_t slot_index = indices / TraceBufferChunk::kChunkSize;
+  size_t event_index = indices % TraceBufferChunk::kChunkSize;
+  Slot* slot = &slots_[slot_index];
+  // The slot is pinned before it is checked, so that it is either seen to be
+  // free, or FreeSlot() sees the pin and keeps the chunk until it is unpinned.
+  base::Barrier_AtomicIncrement(&slot->readers, 1);
+  base::Atomic32 slot_state = base::Acquire_Load(&slot->state);
+  if ((slot_state != kOwned && slot_state != kPublished) ||
+      static_cast<uint32_t>(base::Relaxed_Load(&slot->seq)) != chunk_seq) {
+    base::Barrier_AtomicIncrement(&slot->readers, -1);
+    return nullptr;
+  }
+  state->pinned = slot;
+  return slot->chunk->GetEventAt(event_index);
+}
+
+void ThreadLocalTraceBuffer::CompleteTraceEvent(uint64_t handle) {
+  ThreadState* state = GetThreadState();
+  Slot* slot = state->owned;
+  if (slot == nullptr) return;
+  size_t indices = handle % Capacity();
+  size_t event_index = indices % TraceBufferChunk::kChunkSize;
+  // Only the owner stores the size, and only events of its own chunk can be
+  // completed.
+  if (static_cast<size_t>(slot - slots_.get()) !=
+          indices / TraceBufferChunk::kChunkSize ||
+      static_cast<uint32_t>(base::Relaxed_Load(&slot->seq)) !=
+          static_cast<uint32_t>(handle / Capacity()) ||
+      static_cast<size_t>(base::Relaxed_Load(&slot->size)) > event_index) {
+    return;
+  }
+  base::Release_Store(&slot->size,
+                      static_cast<base::Atomic32>(event_index + 1));
+}
+
+bool ThreadLocalTraceBuffer::Flush() {
+  base::LockGuard<base::Mutex> guard(&writer_mutex_);
+  // The events of the current thread have all been initialized.
+  ThreadState* current = static_cast<ThreadState*>(
+      base::Thread::GetThreadLocal(thread_state_key_));
+  if (current != nullptr && current->owned != nullptr) {
+    base::Release_Store(
+        &current->owned->size,
+        static_cast<base::Atomic32>(current->owned->chunk->size()));
+  }
+  // Owned chunks are written up to their last initialized event but stay
+  // with their thread, which continues to fill them.
+  std::vector<Slot*> slots;
+  for (size_t i = 0; i < max_chunks_; ++i) {
+    base::Atomic32 state = base::Acquire_Load(&slots_[i].state);
+    if (state == kOwned || state == kPublished) slots.push_back(&slots_[i]);
+  }
+  std::sort(slots.begin(), slots.end(), [](Slot* a, Slot* b) {
+    return static_cast<uint32_t>(a->seq) < static_cast<uint32_t>(b->seq);
+  });
+  for (Slot* slot : slots) {
+    bool published = base::Acquire_Load(&slot->state) == kPublished;
+    WriteSlot(slot);
+    if (published) FreeSlot(slot);
+  }
+  trace_writer_->Flush();
+  return true;
+}
+
+ThreadLocalTraceBuffer::ThreadState* ThreadLocalTraceBuffer::GetThreadState() {
+  ThreadState* state = static_cast<ThreadState*>(
+      base::Thread::GetThreadLocal(thread_state_key_));
+  if (state != nullptr) return state;
+  state = new ThreadState{this, nullptr, nullptr};
+  {
+    base::LockGuard<base::Mutex> guard(&thread_states_mutex_);
+    thread_states_.insert(state);
+  }
+  base::Thread::SetThreadLocal(thread_state_key_, state);
+  return state;
+}
+
+// Called when a thread exits. It no longer initializes or updates events, so
+// its chunk can be published in full.
+void ThreadLocalTraceBuffer::ReleaseThreadState(void* data) {
+  ThreadState* state = static_cast<ThreadState*>(data);
+  ThreadLocalTraceBuffer* buffer = state->buffer;
+  buffer->Unpin(state);
+  if (state->owned != nullptr) buffer->PublishSlot(state->owned);
+  {
+    base::LockGuard<base::Mutex> guard(&buffer->thread_states_mutex_);
+    buffer->thread_states_.erase(state);
+  }
+  delete state;
+}
+
+void ThreadLocalTraceBuffer::Unpin(ThreadState* state) {
+  if (state->pinned == nullptr) return;
+  base::Barrier_AtomicIncrement(&state->pinned->readers, -1);
+  state->pinned = nullptr;
+}
+
+ThreadLocalTraceBuffer::Slot* ThreadLocalTraceBuffer::AcquireSlot() {
+  // Start at a different slot for every thread to keep the compare-and-swaps
+  // from contending.
+  size_t start = static_cast<uint32_t>(
+      base::Relaxed_AtomicIncrement(&next_slot_, 1));
+  for (size_t i = 0; i < max_chunks_; ++i) {
+    Slot* slot = &slots_[(start + i) % max_chunks_];
+    if (base::Acquire_CompareAndSwap(&slot->state, kFree, kAcquiring) !=
+        kFree) {
+      continue;
+    }
+    uint32_t seq = static_cast<uint32_t>(
+        base::Relaxed_AtomicIncrement(&next_chunk_seq_, 1));
+    if (slot->chunk) {
+      slot->chunk->Reset(seq);
+    } else {
+      slot->chunk.reset(new TraceBufferChunk(seq));
+    }
+    slot->written = 0;
+    base::Relaxed_Store(&slot->size, 0);
+    base::Relaxed_Store(&slot->seq, static_cast<base::Atomic32>(seq));
+    base::Release_Store(&slot->state, kOwned);
+    return slot;
+  }
+  return nullptr;
+}
+
+void ThreadLocalTraceBuffer::PublishSlot(Slot* slot) {
+  base::Release_Store(&slot->size,
+                      static_cast<base::Atomic32>(slot->chunk->size()));
+  base::Release_Store(&slot->state, kPublished);
+  if (base::Barrier_AtomicIncrement(&published_count_, 1) ==
+      static_cast<base::Atomic32>(high_water_mark_)) {
+    flusher_semaphore_.Signal();
+  }
+}
+
+void ThreadLocalTraceBuffer::WritePublishedChunks(size_t max_published) {
+  std::vector<Slot*> published;
+  for (size_t i = 0; i < max_chunks_; ++i) {
+    if (base::Acquire_Load(&slots_[i].state) == kPublished) {
+      published.push_back(&slots_[i]);
+    }
+  }
+  if (published.size() <= max_published) return;
+  size_t count = published.size() - max_published;
+  std::partial_sort(published.begin(), published.begin() + count,
+                    published.end(), [](Slot* a, Slot* b) {
+                      return static_cast<uint32_t>(a->seq) <
+                             static_cast<uint32_t>(b->seq);
+                    });
+  for (size_t i = 0; i < count; ++i) {
+    WriteSlot(published[i]);
+    FreeSlot(published[i]);
+  }
+}
+
+bool ThreadLocalTraceBuffer::FreeSlot(Slot* slot) {
+  if (base::Acquire_CompareAndSwap(&slot->state, kPublished, kRetiring) !=
+      kPublished) {
+    return false;
+  }
+  // Pairs with the barrier between pinning and checking the slot in
+  // GetEventByHandle().
+  base::SeqCst_MemoryFence();
+  if (base::Relaxed_Load(&slot->readers) != 0) {
+    base::Release_Store(&slot->state, kPublished);
+    return false;
+  }
+  base::Release_Store(&slot->state, kFree);
+  base::Barrier_AtomicIncrement(&published_count_, -1);
+  return true;
+}
+
+void ThreadLocalTraceBuffer::WriteSlot(Slot* slot) {
+  size_t size = static_cast<size_t>(base::Acquire_Load(&slot->size));
+  for (size_t i = slot->written; i < size; ++i) {
+    trace_writer_->AppendTraceEvent(slot->chunk->GetEventAt(i));
+  }
+  slot->written = size;
+}
+
+uint64_t ThreadLocalTraceBuffer::MakeHandle(size_t slot_index,
+                                            uint32_t chunk_seq,
+                                            size_t event_index) const {
+  return static_cast<uint64_t>(chunk_seq) * Capacity() +
+         slot_index * TraceBufferChunk::kChunkSize + event_index;
+}
+
+void ThreadLocalTraceBuffer::FlusherThread::Run() {
+  while (true) {
+    buffer_->flusher_semaphore_.Wait();
+    if (base::Acquire_Load(&buffer_->flusher_stopped_)) return;
+    base::LockGuard<base::Mutex> guard(&buffer_->writer_mutex_);
+    buffer_->WritePublishedChunks(buffer_->low_water_mark_);
+  }
+}
+
 TraceBufferChunk::TraceBufferChunk(uint32_t seq) : seq_(seq) {}
 
 void TraceBufferChunk::Reset(uint32_t new_seq) {
@@ -104,6 +358,11 @@ TraceBuffer* TraceBuffer::CreateTraceBufferRingBuffer(
   return new TraceBufferRingBuffer(max_chunks, trace_writer);
 }
 
+TraceBuffer* TraceBuffer::CreateThreadLocalTraceBuffer(
+    size_t max_chunks, TraceWriter* trace_writer) {
+  return new ThreadLocalTraceBuffer(max_chunks, trace_writer);
+}
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
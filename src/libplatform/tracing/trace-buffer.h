@@ -6,10 +6,14 @@
 #define V8_LIBPLATFORM_TRACING_TRACE_BUFFER_H_
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "include/libplatform/v8-tracing.h"
+#include "src/base/atomicops.h"
 #include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/base/platform/semaphore.h"
 
 namespace v8 {
 namespace platform {
@@ -41,6 +45,111 @@ class TraceBufferRingBuffer : public TraceBuffer {
   uint32_t current_chunk_seq_ = 1;
 };
 
+// A trace buffer in which every thread records events into a chunk it owns,
+// so that adding an event takes no lock. A thread claims a free slot of the
+// ring with a compare-and-swap and publishes the chunk in it once the chunk
+// is full, or when the thread exits. A background thread writes the oldest
+// published chunks to the trace writer when the ring fills up, and Flush()
+// writes whatever remains, including the completed events in chunks that are
+// still owned by a thread. An event is complete once CompleteTraceEvent() has
+// been called for it, or once its thread has added another event.
+//
+// An event returned by GetEventByHandle() is pinned until the thread calls
+// into the buffer again: its chunk may be written meanwhile, but it is not
+// reused for another chunk.
+//
+// Unlike TraceBufferRingBuffer, events are dropped rather than overwritten
+// when no slot is free, and complete events whose chunk is written before
+// they end are written without their duration.
+class ThreadLocalTraceBuffer : public TraceBuffer {
+ public:
+  ThreadLocalTraceBuffer(size_t max_chunks, TraceWriter* trace_writer);
+  ~ThreadLocalTraceBuffer();
+
+  TraceObject* AddTraceEvent(uint64_t* handle) override;
+  TraceObject* GetEventByHandle(uint64_t handle) override;
+  bool Flush() override;
+  void CompleteTraceEvent(uint64_t handle) override;
+
+ private:
+  enum SlotState : base::Atomic32 {
+    kFree,
+    kAcquiring,
+    kOwned,
+    kPublished,
+    // Being freed, unless a thread turns out to have pinned it.
+    kRetiring
+  };
+
+  struct Slot {
+    base::Atomic32 state = kFree;
+    base::Atomic32 seq = 0;
+    // The number of initialized events in the chunk, published by the owner.
+    base::Atomic32 size = 0;
+    // The number of threads that have pinned an event of the chunk.
+    base::Atomic32 readers = 0;
+    // The number of events already written, guarded by writer_mutex_.
+    size_t written = 0;
+    std::unique_ptr<TraceBufferChunk> chunk;
+  };
+
+  // The slots that a thread uses. Released when the thread exits.
+  struct ThreadState {
+    ThreadLocalTraceBuffer* buffer;
+    // The slot whose chunk the thread adds events to.
+    Slot* owned;
+    // The slot of the last event returned by GetEventByHandle().
+    Slot* pinned;
+  };
+
+  class FlusherThread : public base::Thread {
+   public:
+    explicit FlusherThread(ThreadLocalTraceBuffer* buffer)
+        : base::Thread(base::Thread::Options("TraceBufferFlusher")),
+          buffer_(buffer) {}
+    void Run() override;
+
+   private:
+    ThreadLocalTraceBuffer* buffer_;
+  };
+
+  ThreadState* GetThreadState();
+  static void ReleaseThreadState(void* state);
+  void Unpin(ThreadState* state);
+
+  Slot* AcquireSlot();
+  void PublishSlot(Slot* slot);
+  // Frees a published slot, unless it is pinned. Returns false if it is.
+  bool FreeSlot(Slot* slot);
+  // Writes the published chunks, oldest first, until at most {max_published}
+  // remain. Must be called with writer_mutex_ held.
+  void WritePublishedChunks(size_t max_published);
+  void WriteSlot(Slot* slot);
+
+  uint64_t MakeHandle(size_t slot_index, uint32_t chunk_seq,
+                      size_t event_index) const;
+  size_t Capacity() const { return max_chunks_ * TraceBufferChunk::kChunkSize; }
+
+  const size_t max_chunks_;
+  const size_t high_water_mark_;
+  const size_t low_water_mark_;
+  std::unique_ptr<Slot[]> slots_;
+  base::Atomic32 next_chunk_seq_ = 1;
+  base::Atomic32 next_slot_ = 0;
+  base::Atomic32 published_count_ = 0;
+  // The ThreadState of the current thread.
+  base::Thread::LocalStorageKey thread_state_key_;
+  base::Mutex thread_states_mutex_;
+  std::unordered_set<ThreadState*> thread_states_;
+
+  base::Mutex writer_mutex_;
+  std::unique_ptr<TraceWriter> trace_writer_;
+
+  base::Semaphore flusher_semaphore_;
+  base::Atomic32 flusher_stopped_ = 0;
+  FlusherThread flusher_thread_;
+};
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
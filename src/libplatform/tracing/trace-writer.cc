@@ -5,6 +5,7 @@
 #include "src/libplatform/tracing/trace-writer.h"
 
 #include <cmath>
+#include <cstring>
 
 #include "base/trace_event/common/trace_event_common.h"
 #include "include/v8-platform.h"
@@ -171,6 +172,130 @@ void JSONTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
 
 void JSONTraceWriter::Flush() {}
 
+const char BinaryTraceWriter::kMagic[4] = {'V', '8', 'T', 'B'};
+
+BinaryTraceWriter::BinaryTraceWriter(std::ostream& stream) : stream_(stream) {
+  stream_.write(kMagic, sizeof(kMagic));
+  stream_.put(static_cast<char>(kVersion));
+}
+
+void BinaryTraceWriter::AppendTraceEvent(TraceObject* trace_event) {
+  // Intern the strings first, so that their kString records precede the
+  // event.
+  uint32_t category_id =
+      InternString(TracingController::GetCategoryGroupName(
+          trace_event->category_enabled_flag()));
+  uint32_t name_id = InternString(trace_event->name());
+  bool has_id = trace_event->flags() & TRACE_EVENT_FLAG_HAS_ID;
+  uint32_t scope_id = has_id ? InternString(trace_event->scope()) : 0;
+  const char** arg_names = trace_event->arg_names();
+  uint32_t arg_name_ids[kTraceMaxNumArgs];
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    arg_name_ids[i] = InternString(arg_names[i]);
+  }
+
+  WriteByte(kEvent);
+  WriteByte(static_cast<uint8_t>(trace_event->phase()));
+  WriteVarint(category_id);
+  WriteVarint(name_id);
+  WriteSignedVarint(trace_event->pid());
+  WriteSignedVarint(trace_event->tid());
+  WriteSignedVarint(trace_event->ts());
+  WriteSignedVarint(trace_event->tts());
+  WriteVarint(trace_event->duration());
+  WriteVarint(trace_event->cpu_duration());
+  WriteVarint(trace_event->flags());
+  if (has_id) {
+    WriteVarint(scope_id);
+    WriteVarint(trace_event->id());
+  }
+  WriteVarint(trace_event->num_args());
+  const uint8_t* arg_types = trace_event->arg_types();
+  TraceObject::ArgValue* arg_values = trace_event->arg_values();
+  std::unique_ptr<v8::ConvertableToTraceFormat>* arg_convertables =
+      trace_event->arg_convertables();
+  for (int i = 0; i < trace_event->num_args(); ++i) {
+    WriteVarint(arg_name_ids[i]);
+    WriteByte(arg_types[i]);
+    TraceObject::ArgValue value = arg_values[i];
+    switch (arg_types[i]) {
+      case TRACE_VALUE_TYPE_BOOL:
+        WriteByte(value.as_bool ? 1 : 0);
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        WriteVarint(value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        WriteSignedVarint(value.as_int);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE: {
+        uint64_t bits;
+        memcpy(&bits, &value.as_double, sizeof(bits));
+        for (int shift = 0; shift < 64; shift += 8) {
+          WriteByte(static_cast<uint8_t>(bits >> shift));
+        }
+        break;
+      }
+      case TRACE_VALUE_TYPE_POINTER:
+        WriteVarint(reinterpret_cast<uintptr_t>(value.as_pointer));
+        break;
+      case TRACE_VALUE_TYPE_STRING:
+      case TRACE_VALUE_TYPE_COPY_STRING:
+        if (value.as_string == nullptr) {
+          WriteString("nullptr", 7);
+        } else {
+          WriteString(value.as_string, strlen(value.as_string));
+        }
+        break;
+      case TRACE_VALUE_TYPE_CONVERTABLE: {
+        std::string arg_stringified;
+        arg_convertables[i]->AppendAsTraceFormat(&arg_stringified);
+        WriteString(arg_stringified.data(), arg_stringified.size());
+        break;
+      }
+      default:
+        UNREACHABLE();
+        break;
+    }
+  }
+  stream_.write(buffer_.data(), buffer_.size());
+  buffer_.clear();
+}
+
+void BinaryTraceWriter::Flush() { stream_.flush(); }
+
+uint32_t BinaryTraceWriter::InternString(const char* str) {
+  if (str == nullptr) return 0;
+  auto result = string_ids_.insert(
+      std::make_pair(std::string(str),
+                     static_cast<uint32_t>(string_ids_.size() + 1)));
+  uint32_t id = result.first->second;
+  if (result.second) {
+    WriteByte(kString);
+    WriteVarint(id);
+    WriteString(str, result.first->first.size());
+  }
+  return id;
+}
+
+void BinaryTraceWriter::WriteString(const char* str, size_t length) {
+  WriteVarint(length);
+  buffer_.append(str, length);
+}
+
+void BinaryTraceWriter::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    WriteByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  WriteByte(static_cast<uint8_t>(value));
+}
+
+void BinaryTraceWriter::WriteSignedVarint(int64_t value) {
+  WriteVarint((static_cast<uint64_t>(value) << 1) ^
+              static_cast<uint64_t>(value >> 63));
+}
+
 TraceWriter* TraceWriter::CreateJSONTraceWriter(std::ostream& stream) {
   return new JSONTraceWriter(stream);
 }
@@ -180,6 +305,10 @@ TraceWriter* TraceWriter::CreateJSONTraceWriter(std::ostream& stream,
   return new JSONTraceWriter(stream, tag);
 }
 
+TraceWriter* TraceWriter::CreateBinaryTraceWriter(std::ostream& stream) {
+  return new BinaryTraceWriter(stream);
+}
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
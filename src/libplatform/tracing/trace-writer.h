@@ -5,6 +5,9 @@
 #ifndef V8_LIBPLATFORM_TRACING_TRACE_WRITER_H_
 #define V8_LIBPLATFORM_TRACING_TRACE_WRITER_H_
 
+#include <string>
+#include <unordered_map>
+
 #include "include/libplatform/v8-tracing.h"
 
 namespace v8 {
@@ -27,6 +30,44 @@ class JSONTraceWriter : public TraceWriter {
   bool append_comma_ = false;
 };
 
+// Writes events in a compact binary format that is cheaper to produce than
+// JSON. The stream starts with kMagic and kVersion, followed by records that
+// each start with a RecordTag byte. Integers are written as LEB128 varints,
+// signed ones zigzag-encoded first, and doubles as 8 little-endian bytes.
+//
+//   kString: id, length, bytes
+//   kEvent:  phase byte, category id, name id, pid, tid, ts, tts, dur, tdur,
+//            flags, [scope id, id if TRACE_EVENT_FLAG_HAS_ID], number of
+//            arguments, and for each argument its name id, type byte and value
+//
+// Categories, names, scopes and argument names are interned: a kString record
+// defines each of them before its id is first used. Id 0 stands for nullptr.
+// String argument values are written inline as length and bytes, and
+// convertable arguments as their trace format string.
+class BinaryTraceWriter : public TraceWriter {
+ public:
+  enum RecordTag : uint8_t { kString = 1, kEvent = 2 };
+
+  static const char kMagic[4];
+  static const uint8_t kVersion = 1;
+
+  explicit BinaryTraceWriter(std::ostream& stream);
+  void AppendTraceEvent(TraceObject* trace_event) override;
+  void Flush() override;
+
+ private:
+  uint32_t InternString(const char* str);
+  void WriteString(const char* str, size_t length);
+  void WriteVarint(uint64_t value);
+  void WriteSignedVarint(int64_t value);
+  void WriteByte(uint8_t value) { buffer_.push_back(static_cast<char>(value)); }
+
+  std::ostream& stream_;
+  // Records are assembled here and written to the stream in one go.
+  std::string buffer_;
+  std::unordered_map<std::string, uint32_t> string_ids_;
+};
+
 }  // namespace tracing
 }  // namespace platform
 }  // namespace v8
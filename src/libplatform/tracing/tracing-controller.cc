@@ -71,6 +71,7 @@ uint64_t TracingController::AddTraceEvent(
         phase, category_enabled_flag, name, scope, id, bind_id, num_args,
         arg_names, arg_types, arg_values, arg_convertables, flags,
         CurrentTimestampMicroseconds(), CurrentCpuTimestampMicroseconds());
+    trace_buffer_->CompleteTraceEvent(handle);
   }
   return handle;
 }
@@ -89,6 +90,7 @@ uint64_t TracingController::AddTraceEventWithTimestamp(
                              bind_id, num_args, arg_names, arg_types,
                              arg_values, arg_convertables, flags, timestamp,
                              CurrentCpuTimestampMicroseconds());
+    trace_buffer_->CompleteTraceEvent(handle);
   }
   return handle;
 }
@@ -6,6 +6,7 @@
 
 #include "src/assert-scope.h"
 #include "src/base/platform/platform.h"
+#include "src/char-predicates-inl.h"
 #include "src/objects-inl.h"
 #include "src/string-stream.h"
 #include "src/utils.h"
@@ -53,6 +54,10 @@ Log::Log(Logger* logger, const char* file_name)
   if (FLAG_prof) FLAG_log_code = true;
 
   if (output_handle_ == nullptr) return;
+  if (FLAG_log_binary) {
+    binary_buffer_.reset(new BinaryLogStreamBuffer(output_handle_));
+    os_.rdbuf(binary_buffer_.get());
+  }
   Log::MessageBuilder msg(this);
   LogSeparator kNext = LogSeparator::kSeparator;
   msg << "v8-version" << kNext << Version::GetMajor() << kNext
@@ -67,6 +72,7 @@ Log::Log(Logger* logger, const char* file_name)
 
 FILE* Log::Close() {
   FILE* result = nullptr;
+  if (binary_buffer_) binary_buffer_->Flush();
   if (output_handle_ != nullptr) {
     if (strcmp(FLAG_logfile, kLogToTemporaryFile) != 0) {
       fclose(output_handle_);
@@ -210,6 +216,152 @@ void Log::MessageBuilder::AppendRawCharacter(char c) { log_->os_ << c; }
 
 void Log::MessageBuilder::WriteToLogFile() { log_->os_ << std::endl; }
 
+const char BinaryLogStreamBuffer::kMagic[] = "V8LB";
+
+BinaryLogStreamBuffer::BinaryLogStreamBuffer(FILE* file)
+    : file_(file), buffer_(new char[kBufferSize]) {
+  WriteBytes(kMagic, strlen(kMagic));
+  WriteVarint(kVersion);
+}
+
+void BinaryLogStreamBuffer::Flush() {
+  if (buffer_size_ == 0) return;
+  size_t written = fwrite(buffer_.get(), 1, buffer_size_, file_);
+  DCHECK_EQ(buffer_size_, written);
+  USE(written);
+  buffer_size_ = 0;
+}
+
+int BinaryLogStreamBuffer::sync() {
+  // The text log is flushed after every line, which is what makes it slow.
+  // The buffer is only flushed when it is full or the log is closed.
+  return 0;
+}
+
+BinaryLogStreamBuffer::int_type BinaryLogStreamBuffer::overflow(int_type c) {
+  if (c != EOF) Put(static_cast<char>(c));
+  return c;
+}
+
+std::streamsize BinaryLogStreamBuffer::xsputn(const char* s,
+                                              std::streamsize n) {
+  for (std::streamsize i = 0; i < n; i++) Put(s[i]);
+  return n;
+}
+
+void BinaryLogStreamBuffer::Put(char c) {
+  // Commas and newlines in the logged strings are escaped, so these are
+  // always separators.
+  if (c == ',') {
+    EndField();
+  } else if (c == '\n') {
+    EndField();
+    WriteByte(kEndOfRecord);
+  } else {
+    field_.push_back(c);
+  }
+}
+
+namespace {
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+// The values are limited so that the decoder, which is written in
+// JavaScript, can represent them exactly.
+
+// Parses integers that are printed as {field}, i.e. without leading zeros.
+bool ParseInteger(const std::string& field, int64_t* value) {
+  const size_t kMaxDigits = 15;
+  size_t start = (!field.empty() && field[0] == '-') ? 1 : 0;
+  size_t digits = field.size() - start;
+  if (digits == 0 || digits > kMaxDigits) return false;
+  if (field[start] == '0' && (digits > 1 || start == 1)) return false;
+  int64_t result = 0;
+  for (size_t i = start; i < field.size(); i++) {
+    if (!IsDecimalDigit(field[i])) return false;
+    result = result * 10 + (field[i] - '0');
+  }
+  *value = start == 1 ? -result : result;
+  return true;
+}
+
+// Parses addresses that are printed as {field}, see the operator<< for void*
+// below.
+bool ParseAddress(const std::string& field, uint64_t* value) {
+  const size_t kMaxDigits = 12;
+  if (field.size() < 3 || field[0] != '0' || field[1] != 'x') return false;
+  size_t digits = field.size() - 2;
+  if (digits > kMaxDigits) return false;
+  if (field[2] == '0' && digits > 1) return false;
+  uint64_t result = 0;
+  for (size_t i = 2; i < field.size(); i++) {
+    char c = field[i];
+    if (IsDecimalDigit(c)) {
+      result = result * 16 + (c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      result = result * 16 + (c - 'a' + 10);
+    } else {
+      return false;
+    }
+  }
+  *value = result;
+  return true;
+}
+
+}  // namespace
+
+void BinaryLogStreamBuffer::EndField() {
+  int64_t integer;
+  uint64_t address;
+  if (ParseInteger(field_, &integer)) {
+    WriteByte(kInteger);
+    WriteVarint(ZigZagEncode(integer));
+  } else if (ParseAddress(field_, &address)) {
+    WriteByte(kAddress);
+    int64_t delta = static_cast<int64_t>(address - previous_address_);
+    WriteVarint(ZigZagEncode(delta));
+    previous_address_ = address;
+  } else {
+    auto it = string_ids_.end();
+    bool intern = field_.size() <= kMaxInternedLength;
+    if (intern) it = string_ids_.find(field_);
+    if (it != string_ids_.end()) {
+      WriteByte(kString);
+      WriteVarint(it->second);
+    } else {
+      if (intern && string_ids_.size() < kMaxStrings) {
+        uint32_t id = static_cast<uint32_t>(string_ids_.size());
+        string_ids_.emplace(field_, id);
+        WriteByte(kNewString);
+      } else {
+        WriteByte(kLiteralString);
+      }
+      WriteVarint(field_.size());
+      WriteBytes(field_.data(), field_.size());
+    }
+  }
+  field_.clear();
+}
+
+void BinaryLogStreamBuffer::WriteByte(uint8_t byte) {
+  if (buffer_size_ == kBufferSize) Flush();
+  buffer_[buffer_size_++] = static_cast<char>(byte);
+}
+
+void BinaryLogStreamBuffer::WriteVarint(uint64_t value) {
+  while (value >= 0x80) {
+    WriteByte(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  WriteByte(static_cast<uint8_t>(value));
+}
+
+void BinaryLogStreamBuffer::WriteBytes(const char* bytes, size_t length) {
+  for (size_t i = 0; i < length; i++) WriteByte(bytes[i]);
+}
+
 template <>
 Log::MessageBuilder& Log::MessageBuilder::operator<<<const char*>(
     const char* string) {
@@ -8,6 +8,9 @@
 #include <stdio.h>
 
 #include <cstdarg>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 #include "src/allocation.h"
 #include "src/base/compiler-specific.h"
@@ -25,6 +28,69 @@ class Vector;
 
 enum class LogSeparator { kSeparator };
 
+// Encodes the text log into a compact binary format, see --log-binary. Each
+// line of the text log becomes a record, and each comma-separated field of
+// the line is written as a varint if it is an integer or an address, and as
+// the id of an interned string otherwise. Decoding the records gives back the
+// text log, see BinaryLogDecoder in tools/logreader.js. Unlike the text log,
+// which is flushed after every line, the output is buffered until Flush().
+//
+// The log starts with kMagic and the varint kVersion. Each field starts with
+// a FieldTag, and each record ends with kEndOfRecord.
+class BinaryLogStreamBuffer : public std::streambuf {
+ public:
+  enum FieldTag : uint8_t {
+    kEndOfRecord = 0,
+    // A string that gets the next string id, starting at 0: length, bytes.
+    kNewString = 1,
+    // A string that was already written: id.
+    kString = 2,
+    // A string that is not interned: length, bytes.
+    kLiteralString = 3,
+    // A decimal integer: zigzag value.
+    kInteger = 4,
+    // A hexadecimal address starting with "0x": zigzag difference to the
+    // previous address.
+    kAddress = 5,
+  };
+
+  static const char kMagic[];
+  static const uint32_t kVersion = 1;
+
+  explicit BinaryLogStreamBuffer(FILE* file);
+
+  // Writes the encoded records to the file.
+  void Flush();
+
+ protected:
+  int sync() override;
+  int_type overflow(int_type c) override;
+  std::streamsize xsputn(const char* s, std::streamsize n) override;
+
+ private:
+  static const size_t kBufferSize = 64 * KB;
+  // Longer strings, and the strings after the first kMaxStrings, are written
+  // as literals.
+  static const size_t kMaxInternedLength = 256;
+  static const size_t kMaxStrings = 64 * KB;
+
+  void Put(char c);
+  void EndField();
+  void WriteByte(uint8_t byte);
+  void WriteVarint(uint64_t value);
+  void WriteBytes(const char* bytes, size_t length);
+
+  FILE* const file_;
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_size_ = 0;
+  // The text of the current field.
+  std::string field_;
+  std::unordered_map<std::string, uint32_t> string_ids_;
+  uint64_t previous_address_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BinaryLogStreamBuffer);
+};
+
 // Functions and data for performing output of log messages.
 class Log {
  public:
@@ -118,6 +184,8 @@ class Log {
   // destination.  mutex_ should be acquired before using output_handle_.
   FILE* output_handle_;
   OFStream os_;
+  // Replaces the stream buffer of {os_} with --log-binary.
+  std::unique_ptr<BinaryLogStreamBuffer> binary_buffer_;
 
   // mutex_ is a Mutex used for enforcing exclusive
   // access to the formatting buffer and the log file or log memory buffer.
@@ -0,0 +1,103 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/microtask-queue.h"
+
+#include <algorithm>
+
+#include "src/base/bits.h"
+#include "src/objects-inl.h"
+#include "src/objects/microtask-inl.h"
+#include "src/roots-inl.h"
+#include "src/visitors.h"
+
+namespace v8 {
+namespace internal {
+
+const size_t MicrotaskQueue::kRingBufferOffset =
+    OFFSET_OF(MicrotaskQueue, ring_buffer_);
+const size_t MicrotaskQueue::kCapacityOffset =
+    OFFSET_OF(MicrotaskQueue, capacity_);
+const size_t MicrotaskQueue::kSizeOffset = OFFSET_OF(MicrotaskQueue, size_);
+const size_t MicrotaskQueue::kStartOffset = OFFSET_OF(MicrotaskQueue, start_);
+const size_t MicrotaskQueue::kBatchLimitOffset =
+    OFFSET_OF(MicrotaskQueue, batch_limit_);
+
+const intptr_t MicrotaskQueue::kMinimumCapacity;
+const intptr_t MicrotaskQueue::kNoBatchLimit;
+const intptr_t MicrotaskQueue::kBatchSize;
+
+MicrotaskQueue::MicrotaskQueue() {}
+
+MicrotaskQueue::~MicrotaskQueue() { delete[] ring_buffer_; }
+
+// static
+Object* MicrotaskQueue::CallEnqueueMicrotask(Isolate* isolate,
+                                             intptr_t microtask_queue_pointer,
+                                             Microtask* microtask) {
+  reinterpret_cast<MicrotaskQueue*>(microtask_queue_pointer)
+      ->EnqueueMicrotask(microtask);
+  return ReadOnlyRoots(isolate).undefined_value();
+}
+
+void MicrotaskQueue::EnqueueMicrotask(Microtask* microtask) {
+  if (size_ == capacity_) {
+    ResizeBuffer(std::max(kMinimumCapacity, capacity_ << 1));
+  }
+  DCHECK_LT(size_, capacity_);
+  ring_buffer_[(start_ + size_) & (capacity_ - 1)] = microtask;
+  ++size_;
+}
+
+void MicrotaskQueue::Clear() {
+  size_ = 0;
+  start_ = 0;
+}
+
+Microtask* MicrotaskQueue::get(intptr_t index) const {
+  DCHECK_LT(index, size_);
+  return Microtask::cast(ring_buffer_[(start_ + index) & (capacity_ - 1)]);
+}
+
+void MicrotaskQueue::IterateMicrotasks(RootVisitor* visitor) {
+  if (size_ > 0) {
+    // The pending microtasks wrap around the end of the ring buffer if
+    // start_ + size_ > capacity_.
+    intptr_t first_end = std::min(start_ + size_, capacity_);
+    visitor->VisitRootPointers(Root::kMicroTasks, nullptr,
+                               ring_buffer_ + start_,
+                               ring_buffer_ + first_end);
+    intptr_t second_end = start_ + size_ - first_end;
+    if (second_end > 0) {
+      visitor->VisitRootPointers(Root::kMicroTasks, nullptr, ring_buffer_,
+                                 ring_buffer_ + second_end);
+    }
+  }
+}
+
+void MicrotaskQueue::Shrink() {
+  // Give back the memory of a large ring buffer once the spike of
+  // microtasks that made it grow has been processed.
+  intptr_t new_capacity = capacity_;
+  while (new_capacity > kMinimumCapacity && new_capacity > 4 * size_) {
+    new_capacity >>= 1;
+  }
+  if (new_capacity < capacity_) ResizeBuffer(new_capacity);
+}
+
+void MicrotaskQueue::ResizeBuffer(intptr_t new_capacity) {
+  DCHECK_LE(size_, new_capacity);
+  DCHECK(base::bits::IsPowerOfTwo(new_capacity));
+  Object** new_ring_buffer = new Object*[new_capacity];
+  for (intptr_t i = 0; i < size_; ++i) {
+    new_ring_buffer[i] = ring_buffer_[(start_ + i) & (capacity_ - 1)];
+  }
+  delete[] ring_buffer_;
+  ring_buffer_ = new_ring_buffer;
+  capacity_ = new_capacity;
+  start_ = 0;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,93 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_MICROTASK_QUEUE_H_
+#define V8_MICROTASK_QUEUE_H_
+
+#include <stdint.h>
+
+#include <limits>
+
+#include "src/base/macros.h"
+#include "src/globals.h"
+
+namespace v8 {
+namespace internal {
+
+class Microtask;
+class Object;
+class RootVisitor;
+
+// A queue of pending microtasks, stored in an off-heap ring buffer. The
+// EnqueueMicrotask and RunMicrotasks builtins access the fields directly, so
+// enqueuing a microtask neither allocates nor needs a write barrier: the
+// pending microtasks are visited as strong roots instead.
+class V8_EXPORT_PRIVATE MicrotaskQueue {
+ public:
+  MicrotaskQueue();
+  ~MicrotaskQueue();
+
+  // Called by the EnqueueMicrotask builtin when the ring buffer is full.
+  static Object* CallEnqueueMicrotask(Isolate* isolate,
+                                      intptr_t microtask_queue_pointer,
+                                      Microtask* microtask);
+
+  void EnqueueMicrotask(Microtask* microtask);
+
+  // Drops all pending microtasks, e.g. when execution is terminating.
+  void Clear();
+
+  // Visits the pending microtasks as strong roots.
+  void IterateMicrotasks(RootVisitor* visitor);
+
+  // Shrinks the ring buffer if most of it is unused. Must not be called
+  // while the RunMicrotasks builtin runs, which caches the ring buffer.
+  void Shrink();
+
+  intptr_t capacity() const { return capacity_; }
+  intptr_t size() const { return size_; }
+  intptr_t start() const { return start_; }
+
+  // Returns the pending microtask at {index}, counted from the oldest one.
+  Microtask* get(intptr_t index) const;
+
+  // The RunMicrotasks builtin returns after running this many microtasks,
+  // even if there are more pending ones.
+  intptr_t batch_limit() const { return batch_limit_; }
+  void set_batch_limit(intptr_t batch_limit) { batch_limit_ = batch_limit; }
+
+  static const size_t kRingBufferOffset;
+  static const size_t kCapacityOffset;
+  static const size_t kSizeOffset;
+  static const size_t kStartOffset;
+  static const size_t kBatchLimitOffset;
+
+  // The capacity is always a power of two, so the builtins can wrap indices
+  // into the ring buffer with a mask.
+  static const intptr_t kMinimumCapacity = 8;
+
+  static const intptr_t kNoBatchLimit =
+      std::numeric_limits<intptr_t>::max();
+
+  // The batch limit used when running microtasks with a time budget.
+  static const intptr_t kBatchSize = 128;
+
+ private:
+  void ResizeBuffer(intptr_t new_capacity);
+
+  // The pending microtasks are ring_buffer_[start_], ...,
+  // ring_buffer_[(start_ + size_ - 1) & (capacity_ - 1)], oldest first.
+  Object** ring_buffer_ = nullptr;
+  intptr_t capacity_ = 0;
+  intptr_t size_ = 0;
+  intptr_t start_ = 0;
+  intptr_t batch_limit_ = kNoBatchLimit;
+
+  DISALLOW_COPY_AND_ASSIGN(MicrotaskQueue);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_MICROTASK_QUEUE_H_
@@ -436,6 +436,8 @@ void FeedbackVector::FeedbackVectorVerify(Isolate* isolate) {
   MaybeObject::VerifyMaybeObjectPointer(isolate, code);
   CHECK(code->IsSmi() || code->IsClearedWeakHeapObject() ||
         code->IsWeakHeapObject());
+  CHECK(osr_code_cache()->IsWeakFixedArray());
+  CHECK_EQ(0, osr_code_cache()->length() % kOsrCodeCacheEntrySize);
 }
 
 template <class Traits>
@@ -1267,7 +1269,8 @@ void PromiseReactionJobTask::PromiseReactionJobTaskVerify(Isolate* isolate) {
   CHECK(handler()->IsUndefined(isolate) || handler()->IsCallable());
   VerifyHeapPointer(isolate, promise_or_capability());
   CHECK(promise_or_capability()->IsJSPromise() ||
-        promise_or_capability()->IsPromiseCapability());
+        promise_or_capability()->IsPromiseCapability() ||
+        promise_or_capability()->IsUndefined(isolate));
 }
 
 void PromiseFulfillReactionJobTask::PromiseFulfillReactionJobTaskVerify(
@@ -1319,7 +1322,8 @@ void PromiseReaction::PromiseReactionVerify(Isolate* isolate) {
         fulfill_handler()->IsCallable());
   VerifyHeapPointer(isolate, promise_or_capability());
   CHECK(promise_or_capability()->IsJSPromise() ||
-        promise_or_capability()->IsPromiseCapability());
+        promise_or_capability()->IsPromiseCapability() ||
+        promise_or_capability()->IsUndefined(isolate));
 }
 
 void JSPromise::JSPromiseVerify(Isolate* isolate) {
@@ -1411,6 +1415,19 @@ void JSRegExp::JSRegExpVerify(Isolate* isolate) {
 
       CHECK(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
       CHECK(arr->get(JSRegExp::kIrregexpMaxRegisterCountIndex)->IsSmi());
+      CHECK(arr->get(JSRegExp::kIrregexpBacktrackLimitIndex)->IsSmi());
+      // Smi : Not compiled yet (-1).
+      // ByteArray: The NFA program, compiled on the first bailout.
+      Object* nfa_program = arr->get(JSRegExp::kIrregexpNfaProgramIndex);
+      CHECK((nfa_program->IsSmi() &&
+             Smi::ToInt(nfa_program) == JSRegExp::kUninitializedValue) ||
+            nfa_program->IsByteArray());
+      break;
+    }
+    case JSRegExp::NFA: {
+      FixedArray* arr = FixedArray::cast(data());
+      CHECK(arr->get(JSRegExp::kIrregexpCaptureCountIndex)->IsSmi());
+      CHECK(arr->get(JSRegExp::kIrregexpNfaProgramIndex)->IsByteArray());
       break;
     }
     default:
@@ -1774,6 +1791,8 @@ void FunctionTemplateInfo::FunctionTemplateInfoVerify(Isolate* isolate) {
   VerifyPointer(isolate, signature());
   VerifyPointer(isolate, access_check_info());
   VerifyPointer(isolate, cached_property_name());
+  CHECK(c_function()->IsUndefined(isolate) || c_function()->IsForeign());
+  CHECK(c_signature()->IsUndefined(isolate) || c_signature()->IsForeign());
 }
 
 void ObjectTemplateInfo::ObjectTemplateInfoVerify(Isolate* isolate) {
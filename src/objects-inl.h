@@ -33,6 +33,7 @@
 #include "src/maybe-handles-inl.h"
 #include "src/objects/bigint.h"
 #include "src/objects/descriptor-array.h"
+#include "src/objects/hash-table-inl.h"
 #include "src/objects/js-proxy-inl.h"
 #include "src/objects/literal-objects.h"
 #include "src/objects/maybe-object-inl.h"
@@ -2931,6 +2932,13 @@ void Dictionary<Derived, Shape>::SetEntry(Isolate* isolate, int entry,
   this->set(index + Derived::kEntryKeyIndex, key, mode);
   this->set(index + Derived::kEntryValueIndex, value, mode);
   if (Shape::kHasDetails) DetailsAtPut(isolate, entry, details);
+  if (this->HasControlTable()) {
+    uint8_t control =
+        key->IsTheHole(isolate)
+            ? swiss_table::kDeleted
+            : swiss_table::H2(Shape::HashForObject(isolate, key));
+    this->SetControl(entry, control);
+  }
 }
 
 Object* GlobalDictionaryShape::Unwrap(Object* object) {
@@ -1045,6 +1045,7 @@ void FeedbackVector::FeedbackVectorPrint(std::ostream& os) {  // NOLINT
   } else {
     os << optimization_marker();
   }
+  os << "\n - osr code cache: " << Brief(osr_code_cache());
   os << "\n - invocation count: " << invocation_count();
   os << "\n - profiler ticks: " << profiler_ticks();
 
@@ -1874,6 +1875,8 @@ void FunctionTemplateInfo::FunctionTemplateInfoPrint(
   os << "\n - signature: " << Brief(signature());
   os << "\n - access_check_info: " << Brief(access_check_info());
   os << "\n - cached_property_name: " << Brief(cached_property_name());
+  os << "\n - c_function: " << Brief(c_function());
+  os << "\n - c_signature: " << Brief(c_signature());
   os << "\n - hidden_prototype: " << (hidden_prototype() ? "true" : "false");
   os << "\n - undetectable: " << (undetectable() ? "true" : "false");
   os << "\n - need_access_check: " << (needs_access_check() ? "true" : "false");
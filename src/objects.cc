@@ -80,6 +80,7 @@
 #include "src/objects/microtask-inl.h"
 #include "src/objects/module-inl.h"
 #include "src/objects/promise-inl.h"
+#include "src/objects/swiss-hash-table-helpers.h"
 #include "src/parsing/preparsed-scope-data.h"
 #include "src/property-descriptor.h"
 #include "src/prototype.h"
@@ -16712,6 +16713,17 @@ Handle<Derived> HashTable<Derived, Shape>::NewInternal(
   table->SetNumberOfElements(0);
   table->SetNumberOfDeletedElements(0);
   table->SetCapacity(capacity);
+  if (Shape::kHasControlTable) {
+    if (FLAG_swiss_name_dictionary && capacity >= kMinControlTableCapacity) {
+      STATIC_ASSERT(kMinControlTableCapacity % swiss_table::Group::kWidth ==
+                    0);
+      Handle<ByteArray> control = factory->NewByteArray(capacity, pretenure);
+      memset(control->GetDataStartAddress(), swiss_table::kEmpty, capacity);
+      table->set(kControlTableIndex, *control);
+    } else {
+      table->set(kControlTableIndex, Smi::kZero);
+    }
+  }
   return table;
 }
 
@@ -16722,24 +16734,30 @@ void HashTable<Derived, Shape>::Rehash(Isolate* isolate, Derived* new_table) {
 
   DCHECK_LT(NumberOfElements(), new_table->Capacity());
 
-  // Copy prefix to new array.
-  for (int i = kPrefixStartIndex; i < kElementsStartIndex; i++) {
+  // Copy prefix to new array. The control table belongs to the new table.
+  int prefix_end =
+      Shape::kHasControlTable ? kControlTableIndex : kElementsStartIndex;
+  for (int i = kPrefixStartIndex; i < prefix_end; i++) {
     new_table->set(i, get(i), mode);
   }
 
   // Rehash the elements.
   int capacity = this->Capacity();
   ReadOnlyRoots roots(isolate);
+  bool new_table_has_control_table = new_table->HasControlTable();
   for (int i = 0; i < capacity; i++) {
     uint32_t from_index = EntryToIndex(i);
     Object* k = this->get(from_index);
     if (!Shape::IsLive(roots, k)) continue;
     uint32_t hash = Shape::HashForObject(isolate, k);
-    uint32_t insertion_index =
-        EntryToIndex(new_table->FindInsertionEntry(hash));
+    uint32_t insertion_entry = new_table->FindInsertionEntry(hash);
+    uint32_t insertion_index = EntryToIndex(insertion_entry);
     for (int j = 0; j < Shape::kEntrySize; j++) {
       new_table->set(insertion_index + j, get(from_index + j), mode);
     }
+    if (new_table_has_control_table) {
+      new_table->SetControl(insertion_entry, swiss_table::H2(hash));
+    }
   }
   new_table->SetNumberOfElements(NumberOfElements());
   new_table->SetNumberOfDeletedElements(0);
@@ -16778,6 +16796,7 @@ void HashTable<Derived, Shape>::Swap(uint32_t entry1, uint32_t entry2,
 
 template <typename Derived, typename Shape>
 void HashTable<Derived, Shape>::Rehash(Isolate* isolate) {
+  if (HasControlTable()) return RehashWithControlTable(isolate);
   DisallowHeapAllocation no_gc;
   WriteBarrierMode mode = GetWriteBarrierMode(no_gc);
   ReadOnlyRoots roots(isolate);
@@ -16817,6 +16836,56 @@ void HashTable<Derived, Shape>::Rehash(Isolate* isolate) {
   SetNumberOfDeletedElements(0);
 }
 
+template <typename Derived, typename Shape>
+void HashTable<Derived, Shape>::CopyControlTable(Isolate* isolate,
+                                                 Handle<Derived> table) {
+  if (!table->HasControlTable()) return;
+  Handle<ByteArray> control(table->ControlTable(), isolate);
+  Handle<ByteArray> copy = isolate->factory()->NewByteArray(
+      control->length(), Heap::InNewSpace(*table) ? NOT_TENURED : TENURED);
+  control->copy_out(0, copy->GetDataStartAddress(), control->length());
+  table->set(kControlTableIndex, *copy);
+}
+
+template <typename Derived, typename Shape>
+void HashTable<Derived, Shape>::RehashWithControlTable(Isolate* isolate) {
+  DisallowHeapAllocation no_gc;
+  WriteBarrierMode mode = GetWriteBarrierMode(no_gc);
+  ReadOnlyRoots roots(isolate);
+  Object* undefined = roots.undefined_value();
+  uint32_t capacity = Capacity();
+
+  // With linear probing, moving entries around in place is not worth the
+  // complexity. Take all live entries out of the table and insert them
+  // again; nothing can move while allocation is disallowed.
+  std::vector<Object*> entries;
+  entries.reserve(NumberOfElements() * Shape::kEntrySize);
+  for (uint32_t current = 0; current < capacity; current++) {
+    int index = EntryToIndex(current);
+    if (Shape::IsLive(roots, get(index))) {
+      for (int j = 0; j < Shape::kEntrySize; j++) {
+        entries.push_back(get(index + j));
+      }
+    }
+    for (int j = 0; j < Shape::kEntrySize; j++) {
+      set(index + j, undefined, SKIP_WRITE_BARRIER);
+    }
+  }
+  memset(ControlTable()->GetDataStartAddress(), swiss_table::kEmpty,
+         capacity);
+
+  for (size_t i = 0; i < entries.size(); i += Shape::kEntrySize) {
+    uint32_t hash = Shape::HashForObject(isolate, entries[i]);
+    uint32_t entry = FindInsertionEntryWithControlTable(hash);
+    int index = EntryToIndex(entry);
+    for (int j = 0; j < Shape::kEntrySize; j++) {
+      set(index + j, entries[i + j], mode);
+    }
+    SetControl(entry, swiss_table::H2(hash));
+  }
+  SetNumberOfDeletedElements(0);
+}
+
 template <typename Derived, typename Shape>
 Handle<Derived> HashTable<Derived, Shape>::EnsureCapacity(
     Isolate* isolate, Handle<Derived> table, int n, PretenureFlag pretenure) {
@@ -16887,6 +16956,7 @@ Handle<Derived> HashTable<Derived, Shape>::Shrink(Isolate* isolate,
 
 template <typename Derived, typename Shape>
 uint32_t HashTable<Derived, Shape>::FindInsertionEntry(uint32_t hash) {
+  if (HasControlTable()) return FindInsertionEntryWithControlTable(hash);
   uint32_t capacity = Capacity();
   uint32_t entry = FirstProbe(hash, capacity);
   uint32_t count = 1;
@@ -16899,6 +16969,22 @@ uint32_t HashTable<Derived, Shape>::FindInsertionEntry(uint32_t hash) {
   return entry;
 }
 
+template <typename Derived, typename Shape>
+uint32_t HashTable<Derived, Shape>::FindInsertionEntryWithControlTable(
+    uint32_t hash) {
+  using swiss_table::Group;
+  const swiss_table::ctrl_t* control = ControlTable()->GetDataStartAddress();
+  swiss_table::ProbeSequence<Group::kWidth> seq(hash, Capacity() - 1);
+  // EnsureCapacity will guarantee the hash table is never full.
+  while (true) {
+    auto free = Group(control + seq.offset())
+                    .MatchEmptyOrDeleted()
+                    .ClearBelow(seq.first_index());
+    if (free.HasAny()) return seq.offset(free.LowestBitSet());
+    seq.Next();
+  }
+}
+
 void JSGlobalObject::InvalidatePropertyCell(Handle<JSGlobalObject> global,
                                             Handle<Name> name) {
   // Regardless of whether the property is there or not invalidate
@@ -18799,6 +18885,9 @@ template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
 template class EXPORT_TEMPLATE_DEFINE(V8_EXPORT_PRIVATE)
     Dictionary<SimpleNumberDictionary, SimpleNumberDictionaryShape>;
 
+template void HashTable<NameDictionary, NameDictionaryShape>::CopyControlTable(
+    Isolate* isolate, Handle<NameDictionary> table);
+
 template Handle<NameDictionary>
 BaseNameDictionary<NameDictionary, NameDictionaryShape>::New(
     Isolate*, int n, PretenureFlag pretenure, MinimumCapacity capacity_option);
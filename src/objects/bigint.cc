@@ -19,6 +19,10 @@
 
 #include "src/objects/bigint.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "src/double.h"
 #include "src/objects-inl.h"
 
@@ -179,6 +183,62 @@ class MutableBigInt : public FreshlyAllocatedBigInt,
     return static_cast<digit_t>(~x) == 0;
   }
 
+  // Sub-quadratic algorithms for very large BigInts. They operate on raw,
+  // little-endian digit arrays (see RawDigits below), so callers must make
+  // sure that no GC can happen while they run.
+  // Operand lengths (in digits) from which the fast algorithms are used.
+  static const int kKaratsubaThreshold = 34;
+  static const int kBurnikelThreshold = 57;
+  static const int kToStringFastThreshold = 43;
+  static const int kFromStringFastThreshold = 50;
+
+  static int CompareDigits(const digit_t* x, const digit_t* y, int length);
+  static digit_t AddDigits(digit_t* z, const digit_t* x, int x_length,
+                           const digit_t* y, int y_length);
+  static digit_t InplaceAddDigits(digit_t* z, int z_length, const digit_t* y,
+                                  int y_length);
+  static digit_t InplaceSubDigits(digit_t* z, int z_length, const digit_t* y,
+                                  int y_length);
+  static digit_t LeftShiftDigits(digit_t* z, const digit_t* x, int x_length,
+                                 int shift);
+  static void RightShiftDigits(digit_t* z, const digit_t* x, int x_length,
+                               int shift);
+  static void MultiplyDigits(digit_t* z, const digit_t* x, int x_length,
+                             const digit_t* y, int y_length);
+  static void MultiplySchoolbook(digit_t* z, const digit_t* x, int x_length,
+                                 const digit_t* y, int y_length);
+  static void MultiplyKaratsuba(digit_t* z, const digit_t* x, int x_length,
+                                const digit_t* y, int y_length);
+  static void DivideDigits(digit_t* quotient, digit_t* remainder,
+                           const digit_t* dividend, int dividend_length,
+                           const digit_t* divisor, int divisor_length);
+  static void DivideSchoolbook(digit_t* quotient, digit_t* remainder,
+                               const digit_t* dividend, int dividend_length,
+                               const digit_t* divisor, int divisor_length);
+  static void DivideBurnikelZiegler(digit_t* quotient, digit_t* remainder,
+                                    const digit_t* dividend,
+                                    int dividend_length,
+                                    const digit_t* divisor,
+                                    int divisor_length);
+  static void BurnikelD2n1n(digit_t* quotient, digit_t* remainder,
+                            const digit_t* dividend, const digit_t* divisor,
+                            int n);
+  static void BurnikelD3n2n(digit_t* quotient, digit_t* remainder,
+                            const digit_t* dividend, const digit_t* divisor,
+                            int n);
+  static void ToStringDivideAndConquer(
+      uint8_t* out, const digit_t* x, int x_length, int level,
+      const std::vector<std::vector<digit_t>>& powers, int radix,
+      int chunk_chars);
+  static void CombineChunks(digit_t* result, int result_length,
+                            const uint32_t* multipliers,
+                            const uint32_t* parts, int count);
+
+  static void AbsoluteDivFast(Isolate* isolate, Handle<BigIntBase> dividend,
+                              Handle<BigIntBase> divisor,
+                              Handle<MutableBigInt>* quotient,
+                              Handle<MutableBigInt>* remainder);
+
 // Internal field setters. Non-mutable BigInts don't have these.
 #include "src/objects/object-macros.h"
   inline void set_sign(bool new_sign) {
@@ -200,6 +260,9 @@ class MutableBigInt : public FreshlyAllocatedBigInt,
     Address address = FIELD_ADDR(this, kDigitsOffset + n * kDigitSize);
     (*reinterpret_cast<digit_t*>(address)) = value;
   }
+  static inline digit_t* RawDigits(BigIntBase* x) {
+    return reinterpret_cast<digit_t*>(FIELD_ADDR(x, kDigitsOffset));
+  }
 #include "src/objects/object-macros-undef.h"
 
   void set_64_bits(uint64_t bits);
@@ -462,9 +525,17 @@ MaybeHandle<BigInt> BigInt::Multiply(Isolate* isolate, Handle<BigInt> x,
   if (!MutableBigInt::New(isolate, result_length).ToHandle(&result)) {
     return MaybeHandle<BigInt>();
   }
-  result->InitializeDigits(result_length);
-  for (int i = 0; i < x->length(); i++) {
-    MutableBigInt::MultiplyAccumulate(y, x->digit(i), result, i);
+  if (std::min(x->length(), y->length()) >=
+      MutableBigInt::kKaratsubaThreshold) {
+    DisallowHeapAllocation no_gc;
+    MutableBigInt::MultiplyDigits(
+        MutableBigInt::RawDigits(*result), MutableBigInt::RawDigits(*x),
+        x->length(), MutableBigInt::RawDigits(*y), y->length());
+  } else {
+    result->InitializeDigits(result_length);
+    for (int i = 0; i < x->length(); i++) {
+      MutableBigInt::MultiplyAccumulate(y, x->digit(i), result, i);
+    }
   }
   result->set_sign(x->sign() != y->sign());
   return MutableBigInt::MakeImmutable(result);
@@ -492,6 +563,9 @@ MaybeHandle<BigInt> BigInt::Divide(Isolate* isolate, Handle<BigInt> x,
     }
     digit_t remainder;
     MutableBigInt::AbsoluteDivSmall(isolate, x, divisor, &quotient, &remainder);
+  } else if (y->length() >= MutableBigInt::kBurnikelThreshold &&
+             x->length() - y->length() >= MutableBigInt::kBurnikelThreshold) {
+    MutableBigInt::AbsoluteDivFast(isolate, x, y, &quotient, nullptr);
   } else {
     if (!MutableBigInt::AbsoluteDivLarge(isolate, x, y, &quotient, nullptr)) {
       return MaybeHandle<BigInt>();
@@ -523,6 +597,9 @@ MaybeHandle<BigInt> BigInt::Remainder(Isolate* isolate, Handle<BigInt> x,
     }
     remainder = MutableBigInt::New(isolate, 1).ToHandleChecked();
     remainder->set_digit(0, remainder_digit);
+  } else if (y->length() >= MutableBigInt::kBurnikelThreshold &&
+             x->length() - y->length() >= MutableBigInt::kBurnikelThreshold) {
+    MutableBigInt::AbsoluteDivFast(isolate, x, y, nullptr, &remainder);
   } else {
     if (!MutableBigInt::AbsoluteDivLarge(isolate, x, y, nullptr, &remainder)) {
       return MaybeHandle<BigInt>();
@@ -1426,6 +1503,21 @@ void BigInt::InplaceMultiplyAdd(Handle<FreshlyAllocatedBigInt> x,
                                      *bigint);
 }
 
+// Sets {x} to the value of the given sequence of chunks, as if InplaceMultiplyAdd
+// had been called for each of them. Used for parsing long strings.
+void BigInt::AssignFromChunks(Handle<FreshlyAllocatedBigInt> x,
+                              const uint32_t* multipliers,
+                              const uint32_t* parts, int count) {
+  Handle<MutableBigInt> bigint = MutableBigInt::Cast(x);
+  DisallowHeapAllocation no_gc;
+  MutableBigInt::CombineChunks(MutableBigInt::RawDigits(*bigint),
+                               bigint->length(), multipliers, parts, count);
+}
+
+bool BigInt::UseChunkedParsing(Handle<FreshlyAllocatedBigInt> x) {
+  return x->length() >= MutableBigInt::kFromStringFastThreshold;
+}
+
 // Divides {x} by {divisor}, returning the result in {quotient} and {remainder}.
 // Mathematically, the contract is:
 // quotient = (x - remainder) / divisor, with 0 <= remainder < divisor.
@@ -2035,48 +2127,78 @@ MaybeHandle<String> MutableBigInt::ToStringGeneric(Isolate* isolate,
   // left-shifting it if the length estimate was too large.
   int pos = 0;
 
-  digit_t last_digit;
-  if (length == 1) {
-    last_digit = x->digit(0);
+  int chunk_chars =
+      kDigitBits * kBitsPerCharTableMultiplier / max_bits_per_char;
+  digit_t chunk_divisor = digit_pow(radix, chunk_chars);
+  // By construction of chunk_chars, there can't have been overflow.
+  DCHECK_NE(chunk_divisor, 0);
+
+  if (length >= kToStringFastThreshold) {
+    // Divide and conquer: split {x} by radix^(chunk_chars << i) for
+    // suitable i, so that the divisions can use Burnikel-Ziegler.
+    // {powers}[i] holds radix^(chunk_chars << i); the last power's square
+    // is larger than {x}.
+    std::vector<std::vector<digit_t>> powers;
+    powers.push_back(std::vector<digit_t>(1, chunk_divisor));
+    while (2 * (static_cast<int>(powers.back().size()) - 1) < length) {
+      const std::vector<digit_t>& power = powers.back();
+      int power_length = static_cast<int>(power.size());
+      std::vector<digit_t> square(2 * power_length);
+      MultiplyDigits(square.data(), power.data(), power_length, power.data(),
+                     power_length);
+      while (square.back() == 0) square.pop_back();
+      powers.push_back(std::move(square));
+    }
+    int level = static_cast<int>(powers.size());
+    std::unique_ptr<uint8_t[]> buffer(new uint8_t[chunk_chars << level]);
+    DisallowHeapAllocation no_gc;
+    ToStringDivideAndConquer(buffer.get(), RawDigits(*x), length, level,
+                             powers, radix, chunk_chars);
+    pos = chunk_chars << level;
+    while (pos > 1 && buffer[pos - 1] == '0') pos--;
+    DCHECK_LE(pos + sign, static_cast<int>(chars_required));
+    std::copy(buffer.get(), buffer.get() + pos, result->GetChars());
   } else {
-    int chunk_chars =
-        kDigitBits * kBitsPerCharTableMultiplier / max_bits_per_char;
-    digit_t chunk_divisor = digit_pow(radix, chunk_chars);
-    // By construction of chunk_chars, there can't have been overflow.
-    DCHECK_NE(chunk_divisor, 0);
-    int nonzero_digit = length - 1;
-    DCHECK_NE(x->digit(nonzero_digit), 0);
-    // {rest} holds the part of the BigInt that we haven't looked at yet.
-    // Not to be confused with "remainder"!
-    Handle<MutableBigInt> rest;
-    // In the first round, divide the input, allocating a new BigInt for
-    // the result == rest; from then on divide the rest in-place.
-    Handle<BigIntBase>* dividend = &x;
+    digit_t last_digit;
+    if (length == 1) {
+      last_digit = x->digit(0);
+    } else {
+      int nonzero_digit = length - 1;
+      DCHECK_NE(x->digit(nonzero_digit), 0);
+      // {rest} holds the part of the BigInt that we haven't looked at yet.
+      // Not to be confused with "remainder"!
+      Handle<MutableBigInt> rest;
+      // In the first round, divide the input, allocating a new BigInt for
+      // the result == rest; from then on divide the rest in-place.
+      Handle<BigIntBase>* dividend = &x;
+      do {
+        digit_t chunk;
+        AbsoluteDivSmall(isolate, *dividend, chunk_divisor, &rest, &chunk);
+        DCHECK(!rest.is_null());
+        dividend = reinterpret_cast<Handle<BigIntBase>*>(&rest);
+        DisallowHeapAllocation no_gc;
+        uint8_t* chars = result->GetChars();
+        for (int i = 0; i < chunk_chars; i++) {
+          chars[pos++] = kConversionChars[chunk % radix];
+          chunk /= radix;
+        }
+        DCHECK_EQ(chunk, 0);
+        if (rest->digit(nonzero_digit) == 0) nonzero_digit--;
+        // We can never clear more than one digit per iteration, because
+        // chunk_divisor is smaller than max digit value.
+        DCHECK_GT(rest->digit(nonzero_digit), 0);
+      } while (nonzero_digit > 0);
+      last_digit = rest->digit(0);
+    }
+    DisallowHeapAllocation no_gc;
+    uint8_t* chars = result->GetChars();
     do {
-      digit_t chunk;
-      AbsoluteDivSmall(isolate, *dividend, chunk_divisor, &rest, &chunk);
-      DCHECK(!rest.is_null());
-      dividend = reinterpret_cast<Handle<BigIntBase>*>(&rest);
-      DisallowHeapAllocation no_gc;
-      uint8_t* chars = result->GetChars();
-      for (int i = 0; i < chunk_chars; i++) {
-        chars[pos++] = kConversionChars[chunk % radix];
-        chunk /= radix;
-      }
-      DCHECK_EQ(chunk, 0);
-      if (rest->digit(nonzero_digit) == 0) nonzero_digit--;
-      // We can never clear more than one digit per iteration, because
-      // chunk_divisor is smaller than max digit value.
-      DCHECK_GT(rest->digit(nonzero_digit), 0);
-    } while (nonzero_digit > 0);
-    last_digit = rest->digit(0);
+      chars[pos++] = kConversionChars[last_digit % radix];
+      last_digit /= radix;
+    } while (last_digit > 0);
   }
   DisallowHeapAllocation no_gc;
   uint8_t* chars = result->GetChars();
-  do {
-    chars[pos++] = kConversionChars[last_digit % radix];
-    last_digit /= radix;
-  } while (last_digit > 0);
   DCHECK_GE(pos, 1);
   DCHECK(pos <= static_cast<int>(chars_required));
   // Remove leading zeroes.
@@ -2389,6 +2511,573 @@ uint64_t BigInt::AsUint64(bool* lossless) {
   return result;
 }
 
+// Sub-quadratic algorithms on raw digit arrays.
+// Schoolbook multiplication and division are quadratic in the number of
+// digits, which makes them prohibitively slow for BigInts with tens of
+// thousands of digits. The functions below implement Karatsuba
+// multiplication, Burnikel-Ziegler division and divide-and-conquer
+// conversions on top of it, falling back to the schoolbook algorithms for
+// small inputs (and for the base cases of the recursions).
+
+// Returns -1, 0 or 1 depending on whether {x} is smaller than, equal to or
+// greater than {y}. Both have {length} digits.
+int MutableBigInt::CompareDigits(const digit_t* x, const digit_t* y,
+                                 int length) {
+  int i = length - 1;
+  while (i >= 0 && x[i] == y[i]) i--;
+  if (i < 0) return 0;
+  return x[i] > y[i] ? 1 : -1;
+}
+
+// Computes {z} = {x} + {y}, where {z} has room for {x_length} digits, and
+// returns the carry. Requires {x_length} >= {y_length}.
+BigInt::digit_t MutableBigInt::AddDigits(digit_t* z, const digit_t* x,
+                                         int x_length, const digit_t* y,
+                                         int y_length) {
+  DCHECK_GE(x_length, y_length);
+  digit_t carry = 0;
+  int i = 0;
+  for (; i < y_length; i++) {
+    digit_t new_carry = 0;
+    digit_t sum = digit_add(x[i], y[i], &new_carry);
+    sum = digit_add(sum, carry, &new_carry);
+    z[i] = sum;
+    carry = new_carry;
+  }
+  for (; i < x_length; i++) {
+    digit_t new_carry = 0;
+    z[i] = digit_add(x[i], carry, &new_carry);
+    carry = new_carry;
+  }
+  return carry;
+}
+
+// Adds {y} onto {z} and returns the carry out of {z}'s most significant
+// digit. Stops early once there is nothing left to propagate, so adding a
+// short {y} to a long {z} only costs O({y_length}) in the common case.
+BigInt::digit_t MutableBigInt::InplaceAddDigits(digit_t* z, int z_length,
+                                                const digit_t* y,
+                                                int y_length) {
+  DCHECK_GE(z_length, y_length);
+  digit_t carry = 0;
+  int i = 0;
+  for (; i < y_length; i++) {
+    digit_t new_carry = 0;
+    digit_t sum = digit_add(z[i], y[i], &new_carry);
+    sum = digit_add(sum, carry, &new_carry);
+    z[i] = sum;
+    carry = new_carry;
+  }
+  for (; carry != 0 && i < z_length; i++) {
+    digit_t new_carry = 0;
+    z[i] = digit_add(z[i], carry, &new_carry);
+    carry = new_carry;
+  }
+  return carry;
+}
+
+// Subtracts {y} from {z} and returns the borrow out of {z}'s most significant
+// digit. Like InplaceAddDigits, stops as soon as the borrow is absorbed.
+BigInt::digit_t MutableBigInt::InplaceSubDigits(digit_t* z, int z_length,
+                                                const digit_t* y,
+                                                int y_length) {
+  DCHECK_GE(z_length, y_length);
+  digit_t borrow = 0;
+  int i = 0;
+  for (; i < y_length; i++) {
+    digit_t new_borrow = 0;
+    digit_t difference = digit_sub(z[i], y[i], &new_borrow);
+    difference = digit_sub(difference, borrow, &new_borrow);
+    z[i] = difference;
+    borrow = new_borrow;
+  }
+  for (; borrow != 0 && i < z_length; i++) {
+    digit_t new_borrow = 0;
+    z[i] = digit_sub(z[i], borrow, &new_borrow);
+    borrow = new_borrow;
+  }
+  return borrow;
+}
+
+// Computes {z} = {x} << {shift} and returns the bits shifted out of the most
+// significant digit. {shift} must be less than kDigitBits.
+BigInt::digit_t MutableBigInt::LeftShiftDigits(digit_t* z, const digit_t* x,
+                                               int x_length, int shift) {
+  DCHECK_GE(shift, 0);
+  DCHECK_LT(shift, kDigitBits);
+  if (shift == 0) {
+    std::copy(x, x + x_length, z);
+    return 0;
+  }
+  digit_t carry = 0;
+  for (int i = 0; i < x_length; i++) {
+    digit_t d = x[i];
+    z[i] = (d << shift) | carry;
+    carry = d >> (kDigitBits - shift);
+  }
+  return carry;
+}
+
+// Computes {z} = {x} >> {shift}. {shift} must be less than kDigitBits.
+void MutableBigInt::RightShiftDigits(digit_t* z, const digit_t* x,
+                                     int x_length, int shift) {
+  DCHECK_GE(shift, 0);
+  DCHECK_LT(shift, kDigitBits);
+  DCHECK_GT(x_length, 0);
+  if (shift == 0) {
+    std::copy(x, x + x_length, z);
+    return;
+  }
+  for (int i = 0; i < x_length - 1; i++) {
+    z[i] = (x[i] >> shift) | (x[i + 1] << (kDigitBits - shift));
+  }
+  z[x_length - 1] = x[x_length - 1] >> shift;
+}
+
+// Computes {z} = {x} * {y}. {z} must have room for {x_length} + {y_length}
+// digits and must not overlap with the inputs.
+void MutableBigInt::MultiplyDigits(digit_t* z, const digit_t* x, int x_length,
+                                   const digit_t* y, int y_length) {
+  if (x_length < y_length) {
+    std::swap(x, y);
+    std::swap(x_length, y_length);
+  }
+  if (y_length < kKaratsubaThreshold) {
+    return MultiplySchoolbook(z, x, x_length, y, y_length);
+  }
+  if (x_length < 2 * y_length) {
+    return MultiplyKaratsuba(z, x, x_length, y, y_length);
+  }
+  // Unbalanced inputs: multiply {y} with {y_length}-sized chunks of {x}, so
+  // that each partial product is balanced again.
+  std::fill(z, z + x_length + y_length, 0);
+  std::unique_ptr<digit_t[]> product(new digit_t[2 * y_length]);
+  for (int i = 0; i < x_length; i += y_length) {
+    int chunk_length = std::min(y_length, x_length - i);
+    MultiplyDigits(product.get(), x + i, chunk_length, y, y_length);
+    digit_t carry =
+        InplaceAddDigits(z + i, x_length + y_length - i, product.get(),
+                         chunk_length + y_length);
+    DCHECK_EQ(carry, 0);
+    USE(carry);
+  }
+}
+
+void MutableBigInt::MultiplySchoolbook(digit_t* z, const digit_t* x,
+                                       int x_length, const digit_t* y,
+                                       int y_length) {
+  std::fill(z, z + x_length + y_length, 0);
+  for (int i = 0; i < x_length; i++) {
+    digit_t multiplier = x[i];
+    if (multiplier == 0) continue;
+    digit_t carry = 0;
+    digit_t high = 0;
+    for (int j = 0; j < y_length; j++) {
+      digit_t new_carry = 0;
+      digit_t acc = digit_add(z[i + j], high, &new_carry);
+      acc = digit_add(acc, carry, &new_carry);
+      digit_t low = digit_mul(multiplier, y[j], &high);
+      acc = digit_add(acc, low, &new_carry);
+      z[i + j] = acc;
+      carry = new_carry;
+    }
+    // z[i + y_length] hasn't been written yet, and the sum can't overflow.
+    z[i + y_length] = carry + high;
+  }
+}
+
+// Karatsuba multiplication for inputs where {y_length} <= {x_length} <
+// 2 * {y_length}. With x = x1 * B^m + x0 and y = y1 * B^m + y0:
+//   x * y = x1*y1 * B^2m + ((x0+x1)*(y0+y1) - x0*y0 - x1*y1) * B^m + x0*y0,
+// which needs three instead of four half-sized multiplications.
+void MutableBigInt::MultiplyKaratsuba(digit_t* z, const digit_t* x,
+                                      int x_length, const digit_t* y,
+                                      int y_length) {
+  DCHECK_LE(y_length, x_length);
+  DCHECK_LT(x_length, 2 * y_length);
+  // {m} < {y_length}, so both high halves are non-empty.
+  int m = x_length / 2;
+  int x1_length = x_length - m;
+  int y1_length = y_length - m;
+  const digit_t* x0 = x;
+  const digit_t* x1 = x + m;
+  const digit_t* y0 = y;
+  const digit_t* y1 = y + m;
+  // The outer products are written straight into their final positions.
+  MultiplyDigits(z, x0, m, y0, m);
+  MultiplyDigits(z + 2 * m, x1, x1_length, y1, y1_length);
+
+  int sum_x_length = x1_length + 1;
+  int sum_y_length = std::max(m, y1_length) + 1;
+  int middle_length = sum_x_length + sum_y_length;
+  std::unique_ptr<digit_t[]> scratch(
+      new digit_t[sum_x_length + sum_y_length + middle_length]);
+  digit_t* sum_x = scratch.get();
+  digit_t* sum_y = sum_x + sum_x_length;
+  digit_t* middle = sum_y + sum_y_length;
+  sum_x[x1_length] = AddDigits(sum_x, x1, x1_length, x0, m);
+  if (y1_length >= m) {
+    sum_y[y1_length] = AddDigits(sum_y, y1, y1_length, y0, m);
+  } else {
+    sum_y[m] = AddDigits(sum_y, y0, m, y1, y1_length);
+  }
+  MultiplyDigits(middle, sum_x, sum_x_length, sum_y, sum_y_length);
+  digit_t borrow = InplaceSubDigits(middle, middle_length, z, 2 * m);
+  borrow += InplaceSubDigits(middle, middle_length, z + 2 * m,
+                             x1_length + y1_length);
+  DCHECK_EQ(borrow, 0);
+  USE(borrow);
+  while (middle_length > 0 && middle[middle_length - 1] == 0) middle_length--;
+  digit_t carry = InplaceAddDigits(z + m, x_length + y_length - m, middle,
+                                   middle_length);
+  DCHECK_EQ(carry, 0);
+  USE(carry);
+}
+
+// Divides {dividend} by {divisor}, whose most significant digit must be
+// non-zero. Writes {dividend_length} - {divisor_length} + 1 digits to
+// {quotient} and {divisor_length} digits to {remainder}; either may be
+// nullptr if the caller is not interested in it.
+void MutableBigInt::DivideDigits(digit_t* quotient, digit_t* remainder,
+                                 const digit_t* dividend, int dividend_length,
+                                 const digit_t* divisor, int divisor_length) {
+  DCHECK_GE(dividend_length, divisor_length);
+  DCHECK_NE(divisor[divisor_length - 1], 0);
+  if (divisor_length >= kBurnikelThreshold &&
+      dividend_length - divisor_length >= kBurnikelThreshold) {
+    return DivideBurnikelZiegler(quotient, remainder, dividend,
+                                 dividend_length, divisor, divisor_length);
+  }
+  return DivideSchoolbook(quotient, remainder, dividend, dividend_length,
+                          divisor, divisor_length);
+}
+
+// Same contract as DivideDigits. This is the same Knuth algorithm D as in
+// AbsoluteDivLarge, just operating on raw digits.
+void MutableBigInt::DivideSchoolbook(digit_t* quotient, digit_t* remainder,
+                                     const digit_t* dividend,
+                                     int dividend_length,
+                                     const digit_t* divisor,
+                                     int divisor_length) {
+  int n = divisor_length;
+  int m = dividend_length - n;
+  if (n == 1) {
+    digit_t rem = 0;
+    for (int j = dividend_length - 1; j >= 0; j--) {
+      digit_t q = digit_div(rem, dividend[j], divisor[0], &rem);
+      if (quotient != nullptr) quotient[j] = q;
+    }
+    if (remainder != nullptr) remainder[0] = rem;
+    return;
+  }
+  // D1: normalize, so that the divisor's most significant bit is set.
+  std::unique_ptr<digit_t[]> scratch(new digit_t[n + dividend_length + 1]);
+  digit_t* v = scratch.get();
+  digit_t* u = v + n;
+  int shift = base::bits::CountLeadingZeros(divisor[n - 1]);
+  LeftShiftDigits(v, divisor, n, shift);
+  u[dividend_length] = LeftShiftDigits(u, dividend, dividend_length, shift);
+
+  digit_t vn1 = v[n - 1];
+  digit_t vn2 = v[n - 2];
+  for (int j = m; j >= 0; j--) {
+    // D3: estimate the quotient digit.
+    digit_t qhat = std::numeric_limits<digit_t>::max();
+    digit_t ujn = u[j + n];
+    if (ujn != vn1) {
+      digit_t rhat = 0;
+      qhat = digit_div(ujn, u[j + n - 1], vn1, &rhat);
+      digit_t ujn2 = u[j + n - 2];
+      while (ProductGreaterThan(qhat, vn2, rhat, ujn2)) {
+        qhat--;
+        digit_t prev_rhat = rhat;
+        rhat += vn1;
+        if (rhat < prev_rhat) break;
+      }
+    }
+    // D4: subtract qhat * v from u, adding v back if that went negative.
+    digit_t borrow = 0;
+    digit_t high = 0;
+    for (int i = 0; i < n; i++) {
+      digit_t new_high;
+      digit_t product = digit_mul(qhat, v[i], &new_high);
+      digit_t carry = 0;
+      product = digit_add(product, high, &carry);
+      high = new_high + carry;
+      digit_t new_borrow = 0;
+      digit_t difference = digit_sub(u[j + i], product, &new_borrow);
+      difference = digit_sub(difference, borrow, &new_borrow);
+      u[j + i] = difference;
+      borrow = new_borrow;
+    }
+    digit_t new_borrow = 0;
+    digit_t difference = digit_sub(u[j + n], high, &new_borrow);
+    u[j + n] = digit_sub(difference, borrow, &new_borrow);
+    if (new_borrow != 0) {
+      digit_t carry = InplaceAddDigits(u + j, n, v, n);
+      u[j + n] += carry;
+      qhat--;
+    }
+    if (quotient != nullptr) quotient[j] = qhat;
+  }
+  if (remainder != nullptr) RightShiftDigits(remainder, u, n, shift);
+}
+
+// Burnikel and Ziegler, "Fast Recursive Division", MPI-I-98-1-022.
+// Same contract as DivideDigits. The divisor is padded and shifted to
+// n = j * 2^k digits with its most significant bit set, the dividend is split
+// into blocks of n digits, and each two-block window is divided with the
+// recursive D2n1n, which reduces division to Karatsuba multiplication.
+void MutableBigInt::DivideBurnikelZiegler(digit_t* quotient,
+                                          digit_t* remainder,
+                                          const digit_t* dividend,
+                                          int dividend_length,
+                                          const digit_t* divisor,
+                                          int divisor_length) {
+  int m = 1;
+  while (m * kBurnikelThreshold < divisor_length) m <<= 1;
+  int j = (divisor_length + m - 1) / m;
+  int n = j * m;
+  int shift_digits = n - divisor_length;
+  int shift_bits = base::bits::CountLeadingZeros(divisor[divisor_length - 1]);
+  // The extra digit guarantees that the top block is smaller than the
+  // normalized divisor.
+  int a_length = dividend_length + shift_digits + 1;
+  int t = (a_length + n - 1) / n;
+  DCHECK_GE(t, 2);
+
+  std::unique_ptr<digit_t[]> scratch(
+      new digit_t[n + t * n + 2 * n + (t - 1) * n + n]);
+  digit_t* b = scratch.get();
+  digit_t* a = b + n;
+  digit_t* z = a + t * n;
+  digit_t* q = z + 2 * n;
+  digit_t* r = q + (t - 1) * n;
+  std::fill(b, b + shift_digits, 0);
+  digit_t carry =
+      LeftShiftDigits(b + shift_digits, divisor, divisor_length, shift_bits);
+  DCHECK_EQ(carry, 0);
+  USE(carry);
+  std::fill(a, a + t * n, 0);
+  a[shift_digits + dividend_length] = LeftShiftDigits(
+      a + shift_digits, dividend, dividend_length, shift_bits);
+
+  // Each step divides the window {z} = [R, A_i] by {b}.
+  std::copy(a + (t - 2) * n, a + t * n, z);
+  for (int i = t - 2; i >= 0; i--) {
+    BurnikelD2n1n(q + i * n, r, z, b, n);
+    if (i > 0) {
+      std::copy(a + (i - 1) * n, a + i * n, z);
+      std::copy(r, r + n, z + n);
+    }
+  }
+  if (quotient != nullptr) {
+    int quotient_length = dividend_length - divisor_length + 1;
+    DCHECK_GE((t - 1) * n, quotient_length);
+    std::copy(q, q + quotient_length, quotient);
+#if DEBUG
+    for (int i = quotient_length; i < (t - 1) * n; i++) DCHECK_EQ(q[i], 0);
+#endif
+  }
+  if (remainder != nullptr) {
+    RightShiftDigits(remainder, r + shift_digits, divisor_length, shift_bits);
+  }
+}
+
+// Divides the 2n-digit {dividend} by the normalized n-digit {divisor},
+// writing n digits each to {quotient} and {remainder}. Requires
+// {dividend} < {divisor} * B^n.
+void MutableBigInt::BurnikelD2n1n(digit_t* quotient, digit_t* remainder,
+                                  const digit_t* dividend,
+                                  const digit_t* divisor, int n) {
+  if (n % 2 != 0 || n < kBurnikelThreshold) {
+    std::unique_ptr<digit_t[]> q(new digit_t[n + 1]);
+    DivideSchoolbook(q.get(), remainder, dividend, 2 * n, divisor, n);
+    DCHECK_EQ(q[n], 0);
+    std::copy(q.get(), q.get() + n, quotient);
+    return;
+  }
+  int half = n / 2;
+  // Holds [A4, R1]: the dividend's lowest quarter below the remainder of
+  // the first step.
+  std::unique_ptr<digit_t[]> scratch(new digit_t[3 * half]);
+  BurnikelD3n2n(quotient + half, scratch.get() + half, dividend + half,
+                divisor, half);
+  std::copy(dividend, dividend + half, scratch.get());
+  BurnikelD3n2n(quotient, remainder, scratch.get(), divisor, half);
+}
+
+// Divides the 3n-digit {dividend} by the normalized 2n-digit {divisor},
+// writing n digits to {quotient} and 2n digits to {remainder}. Requires
+// {dividend} < {divisor} * B^n.
+void MutableBigInt::BurnikelD3n2n(digit_t* quotient, digit_t* remainder,
+                                  const digit_t* dividend,
+                                  const digit_t* divisor, int n) {
+  const digit_t* a1 = dividend + 2 * n;
+  const digit_t* a2 = dividend + n;
+  const digit_t* a3 = dividend;
+  const digit_t* b1 = divisor + n;
+  const digit_t* b2 = divisor;
+  // {r} = [R1, A3] with room for a carry; {d} = Q * B2.
+  std::unique_ptr<digit_t[]> scratch(new digit_t[2 * n + 1 + 2 * n]);
+  digit_t* r = scratch.get();
+  digit_t* d = r + 2 * n + 1;
+  std::copy(a3, a3 + n, r);
+  if (CompareDigits(a1, b1, n) < 0) {
+    BurnikelD2n1n(quotient, r + n, a2, b1, n);
+    r[2 * n] = 0;
+  } else {
+    // A1 == B1 by the precondition. Q = B^n - 1, and
+    // R1 = [A1, A2] - Q * B1 = A2 + B1.
+    DCHECK_EQ(CompareDigits(a1, b1, n), 0);
+    std::fill(quotient, quotient + n, std::numeric_limits<digit_t>::max());
+    r[2 * n] = AddDigits(r + n, a2, n, b1, n);
+  }
+  MultiplyDigits(d, quotient, n, b2, n);
+  digit_t borrow = InplaceSubDigits(r, 2 * n + 1, d, 2 * n);
+  // The estimate is at most two too large.
+  const digit_t one = 1;
+  while (borrow != 0) {
+    digit_t carry = InplaceAddDigits(r, 2 * n + 1, divisor, 2 * n);
+    InplaceSubDigits(quotient, n, &one, 1);
+    if (carry != 0) borrow = 0;
+  }
+  DCHECK_EQ(r[2 * n], 0);
+  std::copy(r, r + 2 * n, remainder);
+}
+
+// Writes exactly ({chunk_chars} << {level}) characters representing {x} in
+// base {radix} to {out}, least significant character first, padded with
+// '0's. {powers}[i] must hold radix^(chunk_chars << i), and {x} must be less
+// than radix^(chunk_chars << level).
+void MutableBigInt::ToStringDivideAndConquer(
+    uint8_t* out, const digit_t* x, int x_length, int level,
+    const std::vector<std::vector<digit_t>>& powers, int radix,
+    int chunk_chars) {
+  while (x_length > 0 && x[x_length - 1] == 0) x_length--;
+  uint8_t* end = out + (chunk_chars << level);
+  if (x_length == 0) {
+    std::fill(out, end, '0');
+    return;
+  }
+  if (level == 0 || x_length < kToStringFastThreshold) {
+    // Base case: the classic loop, chopping off one chunk at a time.
+    digit_t chunk_divisor = powers[0][0];
+    std::unique_ptr<digit_t[]> rest(new digit_t[x_length]);
+    std::copy(x, x + x_length, rest.get());
+    while (x_length > 0) {
+      digit_t chunk = 0;
+      for (int i = x_length - 1; i >= 0; i--) {
+        rest[i] = digit_div(chunk, rest[i], chunk_divisor, &chunk);
+      }
+      for (int i = 0; i < chunk_chars; i++) {
+        *out++ = kConversionChars[chunk % radix];
+        chunk /= radix;
+      }
+      if (rest[x_length - 1] == 0) x_length--;
+    }
+    DCHECK_LE(out, end);
+    std::fill(out, end, '0');
+    return;
+  }
+  const std::vector<digit_t>& divisor = powers[level - 1];
+  int divisor_length = static_cast<int>(divisor.size());
+  uint8_t* upper_half = out + (chunk_chars << (level - 1));
+  if (x_length < divisor_length) {
+    ToStringDivideAndConquer(out, x, x_length, level - 1, powers, radix,
+                             chunk_chars);
+    std::fill(upper_half, end, '0');
+    return;
+  }
+  int quotient_length = x_length - divisor_length + 1;
+  std::unique_ptr<digit_t[]> scratch(new digit_t[x_length + 1]);
+  digit_t* quotient = scratch.get();
+  digit_t* remainder = quotient + quotient_length;
+  DivideDigits(quotient, remainder, x, x_length, divisor.data(),
+               divisor_length);
+  ToStringDivideAndConquer(out, remainder, divisor_length, level - 1, powers,
+                           radix, chunk_chars);
+  ToStringDivideAndConquer(upper_half, quotient, quotient_length, level - 1,
+                           powers, radix, chunk_chars);
+}
+
+// Computes the value of the chunk sequence that StringToBigIntHelper would
+// otherwise feed to InplaceMultiplyAdd one by one, i.e.
+//   (...((parts[0] * multipliers[1] + parts[1]) * multipliers[2] + ...)
+// by combining neighboring chunks pairwise. Every multiplier except the last
+// one is the same, so the multiplier of each combined chunk on a given level
+// is a single power that is squared from level to level.
+void MutableBigInt::CombineChunks(digit_t* result, int result_length,
+                                  const uint32_t* multipliers,
+                                  const uint32_t* parts, int count) {
+  typedef std::vector<digit_t> Digits;
+  DCHECK_GT(count, 0);
+  auto multiply = [](const Digits& x, const Digits& y) {
+    Digits product(x.size() + y.size());
+    MultiplyDigits(product.data(), x.data(), static_cast<int>(x.size()),
+                   y.data(), static_cast<int>(y.size()));
+    while (!product.empty() && product.back() == 0) product.pop_back();
+    return product;
+  };
+
+  std::vector<Digits> values(count);
+  for (int i = 0; i < count; i++) {
+    DCHECK(i == count - 1 || multipliers[i] == multipliers[0]);
+    if (parts[i] != 0) values[i].push_back(parts[i]);
+  }
+  Digits power(1, multipliers[0]);
+  Digits last_power(1, multipliers[count - 1]);
+  while (values.size() > 1) {
+    size_t n = values.size();
+    std::vector<Digits> next((n + 1) / 2);
+    for (size_t i = 0; i + 1 < n; i += 2) {
+      const Digits& factor = i + 2 == n ? last_power : power;
+      Digits value = multiply(values[i], factor);
+      value.resize(std::max(value.size(), values[i + 1].size()) + 1);
+      InplaceAddDigits(value.data(), static_cast<int>(value.size()),
+                       values[i + 1].data(),
+                       static_cast<int>(values[i + 1].size()));
+      while (!value.empty() && value.back() == 0) value.pop_back();
+      next[i / 2] = std::move(value);
+    }
+    if (n % 2 != 0) {
+      next[n / 2] = std::move(values[n - 1]);
+    } else if (next.size() > 1) {
+      last_power = multiply(power, last_power);
+    }
+    if (next.size() > 1) power = multiply(power, power);
+    values.swap(next);
+  }
+  const Digits& value = values[0];
+  CHECK_LE(value.size(), static_cast<size_t>(result_length));
+  std::copy(value.begin(), value.end(), result);
+  std::fill(result + value.size(), result + result_length, 0);
+}
+
+// Divides {dividend} by {divisor} using the fast algorithms above.
+// Same contract as AbsoluteDivLarge (which cannot fail here, as the results
+// are never longer than the inputs).
+void MutableBigInt::AbsoluteDivFast(Isolate* isolate,
+                                    Handle<BigIntBase> dividend,
+                                    Handle<BigIntBase> divisor,
+                                    Handle<MutableBigInt>* quotient,
+                                    Handle<MutableBigInt>* remainder) {
+  int dividend_length = dividend->length();
+  int divisor_length = divisor->length();
+  if (quotient != nullptr) {
+    *quotient =
+        New(isolate, dividend_length - divisor_length + 1).ToHandleChecked();
+  }
+  if (remainder != nullptr) {
+    *remainder = New(isolate, divisor_length).ToHandleChecked();
+  }
+  DisallowHeapAllocation no_gc;
+  DivideDigits(quotient != nullptr ? RawDigits(**quotient) : nullptr,
+               remainder != nullptr ? RawDigits(**remainder) : nullptr,
+               RawDigits(*dividend), dividend_length, RawDigits(*divisor),
+               divisor_length);
+}
+
 // Digit arithmetic helpers.
 
 #if V8_TARGET_ARCH_32_BIT
@@ -200,6 +200,12 @@ class V8_EXPORT_PRIVATE BigInt : public BigIntBase {
       PretenureFlag pretenure);
   static void InplaceMultiplyAdd(Handle<FreshlyAllocatedBigInt> x,
                                  uintptr_t factor, uintptr_t summand);
+  // For long inputs, StringToBigIntHelper collects all chunks first and then
+  // combines them in one go, which is sub-quadratic.
+  static bool UseChunkedParsing(Handle<FreshlyAllocatedBigInt> x);
+  static void AssignFromChunks(Handle<FreshlyAllocatedBigInt> x,
+                               const uint32_t* multipliers,
+                               const uint32_t* parts, int count);
   static Handle<BigInt> Finalize(Handle<FreshlyAllocatedBigInt> x, bool sign);
 
   // Special functions for ValueSerializer/ValueDeserializer:
@@ -114,10 +114,12 @@ class NameDictionaryShape : public BaseDictionaryShape<Handle<Name>> {
   static inline uint32_t HashForObject(Isolate* isolate, Object* object);
   static inline Handle<Object> AsHandle(Isolate* isolate, Handle<Name> key);
   static inline int GetMapRootIndex();
-  static const int kPrefixSize = 2;
+  // The next enumeration index, the object hash and the control table.
+  static const int kPrefixSize = 3;
   static const int kEntrySize = 3;
   static const int kEntryValueIndex = 1;
   static const bool kNeedsHoleCheck = false;
+  static const bool kHasControlTable = true;
 };
 
 template <typename Derived, typename Shape>
@@ -186,11 +188,14 @@ class BaseNameDictionary : public Dictionary<Derived, Shape> {
       Handle<Object> value, PropertyDetails details, int* entry_out = nullptr);
 };
 
+// Large NameDictionaries use linear probing with a control table when
+// --swiss-name-dictionary is enabled, see HashTable.
 class NameDictionary
     : public BaseNameDictionary<NameDictionary, NameDictionaryShape> {
  public:
   DECL_CAST(NameDictionary)
 
+  STATIC_ASSERT(kControlTableIndex == kObjectHashIndex + 1);
   static const int kEntryDetailsIndex = 2;
   static const int kInitialCapacity = 2;
 
@@ -204,7 +209,9 @@ class GlobalDictionaryShape : public NameDictionaryShape {
   static inline bool IsMatch(Handle<Name> key, Object* other);
   static inline uint32_t HashForObject(Isolate* isolate, Object* object);
 
+  static const int kPrefixSize = 2;  // No control table.
   static const int kEntrySize = 1;  // Overrides NameDictionaryShape::kEntrySize
+  static const bool kHasControlTable = false;
 
   template <typename Dictionary>
   static inline PropertyDetails DetailsAt(Dictionary* dict, int entry);
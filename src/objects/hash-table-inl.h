@@ -10,6 +10,7 @@
 #include "src/heap/heap.h"
 #include "src/objects-inl.h"
 #include "src/objects/fixed-array-inl.h"
+#include "src/objects/swiss-hash-table-helpers.h"
 #include "src/roots-inl.h"
 
 namespace v8 {
@@ -75,6 +76,7 @@ int HashTable<Derived, Shape>::FindEntry(Isolate* isolate, Key key) {
 template <typename Derived, typename Shape>
 int HashTable<Derived, Shape>::FindEntry(ReadOnlyRoots roots, Key key,
                                          int32_t hash) {
+  if (HasControlTable()) return FindEntryWithControlTable(key, hash);
   uint32_t capacity = Capacity();
   uint32_t entry = FirstProbe(hash, capacity);
   uint32_t count = 1;
@@ -95,6 +97,46 @@ int HashTable<Derived, Shape>::FindEntry(ReadOnlyRoots roots, Key key,
   return kNotFound;
 }
 
+template <typename Derived, typename Shape>
+int HashTable<Derived, Shape>::FindEntryWithControlTable(Key key,
+                                                         int32_t hash) {
+  using swiss_table::Group;
+  const swiss_table::ctrl_t* control = ControlTable()->GetDataStartAddress();
+  swiss_table::ctrl_t h2 = swiss_table::H2(hash);
+  swiss_table::ProbeSequence<Group::kWidth> seq(hash, Capacity() - 1);
+  // EnsureCapacity will guarantee that there is always an empty entry.
+  while (true) {
+    Group group(control + seq.offset());
+    for (auto match = group.Match(h2).ClearBelow(seq.first_index());
+         match.HasAny(); match.ClearLowestBit()) {
+      int entry = seq.offset(match.LowestBitSet());
+      // Only entries in use have a matching control byte, but the portable
+      // group implementation can report false positives.
+      if (Shape::IsMatch(key, KeyAt(entry))) return entry;
+    }
+    if (group.MatchEmpty().ClearBelow(seq.first_index()).HasAny()) break;
+    seq.Next();
+  }
+  return kNotFound;
+}
+
+template <typename Derived, typename Shape>
+bool HashTable<Derived, Shape>::HasControlTable() const {
+  return Shape::kHasControlTable && get(kControlTableIndex)->IsByteArray();
+}
+
+template <typename Derived, typename Shape>
+ByteArray* HashTable<Derived, Shape>::ControlTable() const {
+  DCHECK(HasControlTable());
+  return ByteArray::cast(get(kControlTableIndex));
+}
+
+template <typename Derived, typename Shape>
+void HashTable<Derived, Shape>::SetControl(int entry, uint8_t control) {
+  DCHECK(HasControlTable());
+  ControlTable()->set(entry, control);
+}
+
 template <typename Derived, typename Shape>
 bool HashTable<Derived, Shape>::IsKey(ReadOnlyRoots roots, Object* k) {
   return Shape::IsKey(roots, k);
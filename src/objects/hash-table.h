@@ -26,6 +26,13 @@ namespace internal {
 // - Elements with key == undefined have not been used yet.
 // - Elements with key == the_hole have been deleted.
 //
+// Tables whose Shape has kHasControlTable can instead use linear probing
+// together with a control table, a ByteArray with one byte of metadata per
+// entry (see swiss-hash-table-helpers.h). The ByteArray is stored in the
+// last prefix slot, which holds Smi zero for tables using quadratic
+// probing. The keys still use undefined and the_hole as described above, so
+// the control table can always be recomputed from the entries.
+//
 // The hash table class is parameterized with a Shape.
 // Shape must be a class with the following interface:
 //   class ExampleShape {
@@ -46,6 +53,9 @@ namespace internal {
 //     // Indicates whether IsMatch can deal with other being the_hole (a
 //     // deleted entry).
 //     static const bool kNeedsHoleCheck = ..;
+//     // Indicates whether the last prefix slot is reserved for a control
+//     // table.
+//     static const bool kHasControlTable = ..;
 //   };
 // The prefix size indicates an amount of memory in the
 // beginning of the backing storage that can be used for non-element
@@ -57,6 +67,7 @@ class BaseShape {
   typedef KeyT Key;
   static inline int GetMapRootIndex();
   static const bool kNeedsHoleCheck = true;
+  static const bool kHasControlTable = false;
   static Object* Unwrap(Object* key) { return key; }
   static inline bool IsKey(ReadOnlyRoots roots, Object* key);
   static inline bool IsLive(ReadOnlyRoots roots, Object* key);
@@ -159,7 +170,20 @@ class HashTable : public HashTableBase {
   // Returns the key at entry.
   Object* KeyAt(int entry) { return get(EntryToIndex(entry) + kEntryKeyIndex); }
 
+  // Returns whether this table uses linear probing with a control table.
+  inline bool HasControlTable() const;
+  inline ByteArray* ControlTable() const;
+
+  // Copies of the backing store made with Factory::CopyFixedArray share the
+  // control table with the original. This gives {table} its own copy.
+  static void CopyControlTable(Isolate* isolate, Handle<Derived> table);
+
   static const int kElementsStartIndex = kPrefixStartIndex + Shape::kPrefixSize;
+  // Only used if Shape::kHasControlTable.
+  static const int kControlTableIndex = kElementsStartIndex - 1;
+  // Tables smaller than this keep using quadratic probing. Must be a multiple
+  // of the widest group.
+  static const int kMinControlTableCapacity = 64;
   static const int kEntrySize = Shape::kEntrySize;
   STATIC_ASSERT(kEntrySize > 0);
   static const int kEntryKeyIndex = 0;
@@ -200,6 +224,10 @@ class HashTable : public HashTableBase {
   // has the given hash value.
   uint32_t FindInsertionEntry(uint32_t hash);
 
+  // Sets the control byte of entry, see swiss_table::ctrl_t. Must be called
+  // whenever the key of an entry changes, if the table has a control table.
+  inline void SetControl(int entry, uint8_t control);
+
   // Attempt to shrink hash table after removal of key.
   V8_WARN_UNUSED_RESULT static Handle<Derived> Shrink(
       Isolate* isolate, Handle<Derived> table, int additionalCapacity = 0);
@@ -233,6 +261,12 @@ class HashTable : public HashTableBase {
 
   // Rehashes this hash-table into the new table.
   void Rehash(Isolate* isolate, Derived* new_table);
+
+  // Variants of FindEntry, FindInsertionEntry and Rehash for tables with a
+  // control table.
+  inline int FindEntryWithControlTable(Key key, int32_t hash);
+  uint32_t FindInsertionEntryWithControlTable(uint32_t hash);
+  void RehashWithControlTable(Isolate* isolate);
 };
 
 // HashTableKey is an abstract superclass for virtual key behavior.
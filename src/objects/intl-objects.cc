@@ -98,6 +98,38 @@ bool ExtractBooleanSetting(Isolate* isolate, Handle<JSObject> options,
   return false;
 }
 
+// Appends the value of the setting {key} to {cache_key}. Like the Extract*
+// functions above, this only looks at strings, integers and booleans.
+void AppendSettingToCacheKey(Isolate* isolate, Handle<JSObject> options,
+                             const char* key, std::string* cache_key) {
+  Handle<String> str = isolate->factory()->NewStringFromAsciiChecked(key);
+  Handle<Object> object =
+      JSReceiver::GetProperty(isolate, options, str).ToHandleChecked();
+  int32_t value;
+  cache_key->push_back('|');
+  if (object->IsString()) {
+    cache_key->push_back('s');
+    cache_key->append(Handle<String>::cast(object)->ToCString().get());
+  } else if (object->IsNumber() && object->ToInt32(&value)) {
+    cache_key->push_back('i');
+    cache_key->append(std::to_string(value));
+  } else if (object->IsBoolean()) {
+    cache_key->push_back(object->BooleanValue(isolate) ? 't' : 'f');
+  }
+}
+
+// Returns the ICUObjectCache key for an object created for {icu_locale} from
+// the given {settings} of {options}.
+std::string ICUObjectCacheKey(Isolate* isolate, const icu::Locale& icu_locale,
+                              Handle<JSObject> options,
+                              std::initializer_list<const char*> settings) {
+  std::string cache_key(icu_locale.getName());
+  for (const char* setting : settings) {
+    AppendSettingToCacheKey(isolate, options, setting, &cache_key);
+  }
+  return cache_key;
+}
+
 icu::SimpleDateFormat* CreateICUDateFormat(Isolate* isolate,
                                            const icu::Locale& icu_locale,
                                            Handle<JSObject> options) {
@@ -572,6 +604,35 @@ MaybeHandle<JSObject> CachedOrNewService(Isolate* isolate,
 
 }  // namespace
 
+ICUObjectCache::ICUObjectCache()
+    : default_locale_(icu::Locale::getDefault().getName()) {}
+
+ICUObjectCache::~ICUObjectCache() {}
+
+icu::UObject* ICUObjectCache::Get(Type type, const std::string& key) {
+  auto& entries = entries_[static_cast<int>(type)];
+  auto it = entries.find(key);
+  return it == entries.end() ? nullptr : it->second.get();
+}
+
+void ICUObjectCache::Set(Type type, const std::string& key,
+                         icu::UObject* object) {
+  auto& entries = entries_[static_cast<int>(type)];
+  if (entries.size() >= kMaxEntriesPerType) entries.clear();
+  entries[key].reset(object);
+}
+
+void ICUObjectCache::Clear() {
+  for (auto& entries : entries_) entries.clear();
+}
+
+bool ICUObjectCache::CheckDefaultLocale() {
+  const char* default_locale = icu::Locale::getDefault().getName();
+  if (default_locale_ == default_locale) return false;
+  default_locale_ = default_locale;
+  return true;
+}
+
 icu::Locale Intl::CreateICULocale(Isolate* isolate,
                                   Handle<String> bcp47_locale_str) {
   v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate);
@@ -608,6 +669,21 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
   icu::Locale icu_locale = Intl::CreateICULocale(isolate, locale);
   DCHECK(!icu_locale.isBogus());
 
+  // Formats that do not specify a time zone use the default one; the cache
+  // is cleared when that changes.
+  ICUObjectCache* cache = Intl::GetICUObjectCache(isolate);
+  std::string cache_key =
+      ICUObjectCacheKey(isolate, icu_locale, options, {"timeZone", "skeleton"});
+  icu::UObject* cached =
+      cache->Get(ICUObjectCache::Type::kDateFormat, cache_key);
+  if (cached != nullptr) {
+    icu::SimpleDateFormat* date_format = static_cast<icu::SimpleDateFormat*>(
+        static_cast<icu::SimpleDateFormat*>(cached)->clone());
+    CHECK_NOT_NULL(date_format);
+    SetResolvedDateSettings(isolate, icu_locale, date_format, resolved);
+    return date_format;
+  }
+
   icu::SimpleDateFormat* date_format =
       CreateICUDateFormat(isolate, icu_locale, options);
   if (!date_format) {
@@ -623,6 +699,10 @@ icu::SimpleDateFormat* DateFormat::InitializeDateTimeFormat(
     SetResolvedDateSettings(isolate, no_extension_locale, date_format,
                             resolved);
   } else {
+    // Only cache formats created for the requested locale, so the resolved
+    // settings of a cache hit can be computed from that locale.
+    cache->Set(ICUObjectCache::Type::kDateFormat, cache_key,
+               date_format->clone());
     SetResolvedDateSettings(isolate, icu_locale, date_format, resolved);
   }
 
@@ -750,6 +830,22 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
   icu::Locale icu_locale = Intl::CreateICULocale(isolate, locale);
   DCHECK(!icu_locale.isBogus());
 
+  ICUObjectCache* cache = Intl::GetICUObjectCache(isolate);
+  std::string cache_key = ICUObjectCacheKey(
+      isolate, icu_locale, options,
+      {"style", "currency", "currencyDisplay", "minimumIntegerDigits",
+       "minimumFractionDigits", "maximumFractionDigits",
+       "minimumSignificantDigits", "maximumSignificantDigits", "useGrouping"});
+  icu::UObject* cached =
+      cache->Get(ICUObjectCache::Type::kNumberFormat, cache_key);
+  if (cached != nullptr) {
+    icu::DecimalFormat* number_format = static_cast<icu::DecimalFormat*>(
+        static_cast<icu::DecimalFormat*>(cached)->clone());
+    CHECK_NOT_NULL(number_format);
+    SetResolvedNumberSettings(isolate, icu_locale, number_format, resolved);
+    return number_format;
+  }
+
   icu::DecimalFormat* number_format =
       CreateICUNumberFormat(isolate, icu_locale, options);
   if (!number_format) {
@@ -766,6 +862,8 @@ icu::DecimalFormat* NumberFormat::InitializeNumberFormat(
     SetResolvedNumberSettings(isolate, no_extension_locale, number_format,
                               resolved);
   } else {
+    cache->Set(ICUObjectCache::Type::kNumberFormat, cache_key,
+               number_format->clone());
     SetResolvedNumberSettings(isolate, icu_locale, number_format, resolved);
   }
 
@@ -1157,6 +1255,14 @@ std::string Intl::DefaultLocale(Isolate* isolate) {
   return isolate->default_locale();
 }
 
+// static
+ICUObjectCache* Intl::GetICUObjectCache(Isolate* isolate) {
+  if (isolate->icu_object_cache() == nullptr) {
+    isolate->set_icu_object_cache(new ICUObjectCache());
+  }
+  return isolate->icu_object_cache();
+}
+
 bool Intl::IsObjectOfType(Isolate* isolate, Handle<Object> input,
                           Intl::Type expected_type) {
   if (!input->IsJSObject()) return false;
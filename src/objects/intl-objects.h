@@ -10,8 +10,10 @@
 #define V8_OBJECTS_INTL_OBJECTS_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 
 #include "src/contexts.h"
 #include "src/intl.h"
@@ -25,6 +27,7 @@ class Collator;
 class DecimalFormat;
 class PluralRules;
 class SimpleDateFormat;
+class UObject;
 class UnicodeString;
 }
 
@@ -193,6 +196,43 @@ class V8BreakIterator {
   V8BreakIterator();
 };
 
+// An isolate-wide cache of ICU collators and formatters. Instantiating one of
+// these loads and parses locale data, which costs far more than cloning an
+// existing instance, and the implicit paths (e.g. Number.prototype.
+// toLocaleString with a locales argument) construct a new service object on
+// every call. Entries are keyed by the ICU locale name and the options that
+// affect the ICU object; users always clone the cached objects.
+class ICUObjectCache {
+ public:
+  enum class Type { kCollator, kNumberFormat, kDateFormat, kCount };
+
+  ICUObjectCache();
+  ~ICUObjectCache();
+
+  // Returns the object cached under {key}, or nullptr.
+  icu::UObject* Get(Type type, const std::string& key);
+
+  // Caches {object} under {key}, taking ownership of it.
+  void Set(Type type, const std::string& key, icu::UObject* object);
+
+  // Drops all entries, e.g. because the default time zone changed.
+  void Clear();
+
+  // Returns true if ICU's default locale changed since the last call.
+  bool CheckDefaultLocale();
+
+ private:
+  // The cache is meant for the handful of locales and option sets a page
+  // actually uses; when a type overflows, its entries are dropped.
+  static const size_t kMaxEntriesPerType = 32;
+
+  std::unordered_map<std::string, std::unique_ptr<icu::UObject>>
+      entries_[static_cast<int>(Type::kCount)];
+  std::string default_locale_;
+
+  DISALLOW_COPY_AND_ASSIGN(ICUObjectCache);
+};
+
 class Intl {
  public:
   enum Type {
@@ -235,6 +275,9 @@ class Intl {
 
   static std::string DefaultLocale(Isolate* isolate);
 
+  // Returns the isolate's ICU object cache, creating it on first use.
+  static ICUObjectCache* GetICUObjectCache(Isolate* isolate);
+
   static void DefineWEProperty(Isolate* isolate, Handle<JSObject> target,
                                Handle<Name> key, Handle<Object> value);
 
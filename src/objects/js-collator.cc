@@ -398,19 +398,31 @@ MaybeHandle<JSCollator> JSCollator::InitializeCollator(
   // here. The collation value can be looked up from icu::Collator on
   // demand, as part of Intl.Collator.prototype.resolvedOptions.
 
+  // Only instantiating the collator for a locale is expensive; setting the
+  // attributes below is cheap, so the cache holds collators with the default
+  // attributes of their locale.
+  ICUObjectCache* cache = Intl::GetICUObjectCache(isolate);
+  std::string cache_key(icu_locale.getName());
+  icu::UObject* cached = cache->Get(ICUObjectCache::Type::kCollator, cache_key);
+  std::unique_ptr<icu::Collator> icu_collator;
   UErrorCode status = U_ZERO_ERROR;
-  std::unique_ptr<icu::Collator> icu_collator(
-      icu::Collator::createInstance(icu_locale, status));
-  if (U_FAILURE(status) || icu_collator.get() == nullptr) {
-    status = U_ZERO_ERROR;
-    // Remove extensions and try again.
-    icu::Locale no_extension_locale(icu_locale.getBaseName());
-    icu_collator.reset(
-        icu::Collator::createInstance(no_extension_locale, status));
-
+  if (cached != nullptr) {
+    icu_collator.reset(static_cast<icu::Collator*>(cached)->clone());
+  } else {
+    icu_collator.reset(icu::Collator::createInstance(icu_locale, status));
     if (U_FAILURE(status) || icu_collator.get() == nullptr) {
-      FATAL("Failed to create ICU collator, are ICU data files missing?");
+      status = U_ZERO_ERROR;
+      // Remove extensions and try again.
+      icu::Locale no_extension_locale(icu_locale.getBaseName());
+      icu_collator.reset(
+          icu::Collator::createInstance(no_extension_locale, status));
+
+      if (U_FAILURE(status) || icu_collator.get() == nullptr) {
+        FATAL("Failed to create ICU collator, are ICU data files missing?");
+      }
     }
+    cache->Set(ICUObjectCache::Type::kCollator, cache_key,
+               icu_collator->clone());
   }
   DCHECK(U_SUCCESS(status));
   CHECK_NOT_NULL(icu_collator.get());
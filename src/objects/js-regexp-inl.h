@@ -35,6 +35,7 @@ int JSRegExp::CaptureCount() {
     case ATOM:
       return 0;
     case IRREGEXP:
+    case NFA:
       return Smi::ToInt(DataAt(kIrregexpCaptureCountIndex));
     default:
       UNREACHABLE();
@@ -57,7 +58,7 @@ String* JSRegExp::Pattern() {
 
 Object* JSRegExp::CaptureNameMap() {
   DCHECK(this->data()->IsFixedArray());
-  DCHECK_EQ(TypeTag(), IRREGEXP);
+  DCHECK(TypeSupportsCaptures(TypeTag()));
   Object* value = DataAt(kIrregexpCaptureNameMapIndex);
   DCHECK_NE(value, Smi::FromInt(JSRegExp::kUninitializedValue));
   return value;
@@ -29,13 +29,17 @@ namespace internal {
 // used for tracking the last usage (used for regexp code flushing).
 // - max number of registers used by irregexp implementations.
 // - number of capture registers (output values) of the regexp.
+// - the backtrack limit and the program for the NFA engine (see
+// src/regexp/regexp-nfa.h). NFA regexps use the same layout.
 class JSRegExp : public JSObject {
  public:
   // Meaning of Type:
   // NOT_COMPILED: Initial value. No data has been stored in the JSRegExp yet.
   // ATOM: A simple string to match against using an indexOf operation.
   // IRREGEXP: Compiled with Irregexp.
-  enum Type { NOT_COMPILED, ATOM, IRREGEXP };
+  // NFA: Executed by the linear-time NFA engine. Uses the Irregexp data
+  //      layout, but never has any Irregexp code.
+  enum Type { NOT_COMPILED, ATOM, IRREGEXP, NFA };
   enum Flag {
     kNone = 0,
     kGlobal = 1 << 0,
@@ -67,6 +71,10 @@ class JSRegExp : public JSObject {
                                           Handle<String> flags_string);
 
   inline Type TypeTag();
+  // Whether regexps of this type have capture groups and Irregexp data.
+  static bool TypeSupportsCaptures(Type t) {
+    return t == IRREGEXP || t == NFA;
+  }
   // Number of captures (without the match itself).
   inline int CaptureCount();
   inline Flags GetFlags();
@@ -124,8 +132,14 @@ class JSRegExp : public JSObject {
   // Maps names of named capture groups (at indices 2i) to their corresponding
   // (1-based) capture group indices (at indices 2i + 1).
   static const int kIrregexpCaptureNameMapIndex = kDataIndex + 4;
+  // Number of backtracks after which the Irregexp code gives up and the
+  // match is retried on the NFA engine, or kNoBacktrackLimit.
+  static const int kIrregexpBacktrackLimitIndex = kDataIndex + 5;
+  // Program for the NFA engine (a ByteArray), or the uninitialized value if
+  // it has not been compiled yet.
+  static const int kIrregexpNfaProgramIndex = kDataIndex + 6;
 
-  static const int kIrregexpDataSize = kIrregexpCaptureNameMapIndex + 1;
+  static const int kIrregexpDataSize = kIrregexpNfaProgramIndex + 1;
 
   // In-object fields.
   static const int kLastIndexFieldIndex = 0;
@@ -133,6 +147,8 @@ class JSRegExp : public JSObject {
 
   // The uninitialized value for a regexp code object.
   static const int kUninitializedValue = -1;
+
+  static const int kNoBacktrackLimit = 0;
 };
 
 DEFINE_OPERATORS_FOR_FLAGS(JSRegExp::Flags)
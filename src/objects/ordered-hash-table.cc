@@ -15,16 +15,16 @@ namespace internal {
 template <class Derived, int entrysize>
 Handle<Derived> OrderedHashTable<Derived, entrysize>::Allocate(
     Isolate* isolate, int capacity, PretenureFlag pretenure) {
-  // Capacity must be a power of two, since we depend on being able
-  // to divide and multiple by 2 (kLoadFactor) to derive capacity
-  // from number of buckets. If we decide to change kLoadFactor
-  // to something other than 2, capacity should be stored as another
-  // field of this object.
-  capacity = base::bits::RoundUpToPowerOfTwo32(Max(kMinCapacity, capacity));
+  // The number of buckets must be a power of two, and large enough that at
+  // most three quarters of them are in use once |capacity| entries are added.
+  STATIC_ASSERT(CapacityForBuckets(kMinNumberOfBuckets) == kMinCapacity);
+  capacity = Max(kMinCapacity, capacity);
+  int num_buckets = static_cast<int>(
+      base::bits::RoundUpToPowerOfTwo32(capacity + (capacity + 2) / 3));
+  capacity = CapacityForBuckets(num_buckets);
   if (capacity > kMaxCapacity) {
     isolate->heap()->FatalProcessOutOfMemory("invalid table size");
   }
-  int num_buckets = capacity / kLoadFactor;
   Handle<FixedArray> backing_store = isolate->factory()->NewFixedArrayWithMap(
       static_cast<Heap::RootListIndex>(Derived::GetMapRootIndex()),
       kHashTableStartIndex + num_buckets + (capacity * kEntrySize), pretenure);
@@ -93,28 +93,12 @@ Handle<OrderedHashSet> OrderedHashSet::Add(Isolate* isolate,
                                            Handle<OrderedHashSet> table,
                                            Handle<Object> key) {
   int hash = key->GetOrCreateHash(isolate)->value();
-  int entry = table->HashToEntry(hash);
-  // Walk the chain of the bucket and try finding the key.
-  while (entry != kNotFound) {
-    Object* candidate_key = table->KeyAt(entry);
-    // Do not add if we have the key already
-    if (candidate_key->SameValueZero(*key)) return table;
-    entry = table->NextChainEntry(entry);
-  }
+  // Do not add if we have the key already
+  if (table->FindEntry(*key, hash) != kNotFound) return table;
 
   table = OrderedHashSet::EnsureGrowable(isolate, table);
-  // Read the existing bucket values.
-  int bucket = table->HashToBucket(hash);
-  int previous_entry = table->HashToEntry(hash);
-  int nof = table->NumberOfElements();
-  // Insert a new entry at the end,
-  int new_entry = nof + table->NumberOfDeletedElements();
-  int new_index = table->EntryToIndex(new_entry);
+  int new_index = table->AddEntry(hash);
   table->set(new_index, *key);
-  table->set(new_index + kChainOffset, Smi::FromInt(previous_entry));
-  // and point the bucket to the new entry.
-  table->set(kHashTableStartIndex + bucket, Smi::FromInt(new_entry));
-  table->SetNumberOfElements(nof + 1);
   return table;
 }
 
@@ -159,7 +143,6 @@ Handle<Derived> OrderedHashTable<Derived, entrysize>::Rehash(
       isolate, new_capacity, Heap::InNewSpace(*table) ? NOT_TENURED : TENURED);
   int nof = table->NumberOfElements();
   int nod = table->NumberOfDeletedElements();
-  int new_buckets = new_table->NumberOfBuckets();
   int new_entry = 0;
   int removed_holes_index = 0;
 
@@ -172,8 +155,10 @@ Handle<Derived> OrderedHashTable<Derived, entrysize>::Rehash(
     }
 
     Object* hash = key->GetHash();
-    int bucket = Smi::ToInt(hash) & (new_buckets - 1);
-    Object* chain_entry = new_table->get(kHashTableStartIndex + bucket);
+    int bucket = new_table->HashToBucket(Smi::ToInt(hash));
+    while (new_table->EntryAtBucket(bucket) != kNotFound) {
+      bucket = new_table->NextBucket(bucket);
+    }
     new_table->set(kHashTableStartIndex + bucket, Smi::FromInt(new_entry));
     int new_index = new_table->EntryToIndex(new_entry);
     int old_index = table->EntryToIndex(old_entry);
@@ -181,7 +166,6 @@ Handle<Derived> OrderedHashTable<Derived, entrysize>::Rehash(
       Object* value = table->get(old_index + i);
       new_table->set(new_index + i, value);
     }
-    new_table->set(new_index + kChainOffset, chain_entry);
     ++new_entry;
   }
 
@@ -231,33 +215,13 @@ Handle<OrderedHashMap> OrderedHashMap::Add(Isolate* isolate,
                                            Handle<Object> key,
                                            Handle<Object> value) {
   int hash = key->GetOrCreateHash(isolate)->value();
-  int entry = table->HashToEntry(hash);
-  // Walk the chain of the bucket and try finding the key.
-  {
-    DisallowHeapAllocation no_gc;
-    Object* raw_key = *key;
-    while (entry != kNotFound) {
-      Object* candidate_key = table->KeyAt(entry);
-      // Do not add if we have the key already
-      if (candidate_key->SameValueZero(raw_key)) return table;
-      entry = table->NextChainEntry(entry);
-    }
-  }
+  // Do not add if we have the key already
+  if (table->FindEntry(*key, hash) != kNotFound) return table;
 
   table = OrderedHashMap::EnsureGrowable(isolate, table);
-  // Read the existing bucket values.
-  int bucket = table->HashToBucket(hash);
-  int previous_entry = table->HashToEntry(hash);
-  int nof = table->NumberOfElements();
-  // Insert a new entry at the end,
-  int new_entry = nof + table->NumberOfDeletedElements();
-  int new_index = table->EntryToIndex(new_entry);
+  int new_index = table->AddEntry(hash);
   table->set(new_index, *key);
   table->set(new_index + kValueOffset, *value);
-  table->set(new_index + kChainOffset, Smi::FromInt(previous_entry));
-  // and point the bucket to the new entry.
-  table->set(kHashTableStartIndex + bucket, Smi::FromInt(new_entry));
-  table->SetNumberOfElements(nof + 1);
   return table;
 }
 
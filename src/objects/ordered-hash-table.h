@@ -19,7 +19,8 @@ namespace internal {
 class OrderedHashTableBase : public FixedArray {
  public:
   static const int kNotFound = -1;
-  static const int kMinCapacity = 4;
+  static const int kMinNumberOfBuckets = 8;
+  static const int kMinCapacity = 6;
 
   static const int kNumberOfElementsIndex = 0;
   // The next table is stored at the same index as the nof elements.
@@ -40,7 +41,12 @@ class OrderedHashTableBase : public FixedArray {
   static constexpr const int kHashTableStartOffset =
       FixedArray::OffsetOfElementAt(kHashTableStartIndex);
 
-  static const int kLoadFactor = 2;
+  // The data table has three entries for every four buckets, so at least a
+  // quarter of the buckets is unused and every probe sequence ends at one.
+  // The number of buckets is a power of two, so it can be used as a mask.
+  static constexpr int CapacityForBuckets(int number_of_buckets) {
+    return number_of_buckets - (number_of_buckets >> 2);
+  }
 
   // NumberOfDeletedElements is set to kClearedTableSentinel when
   // the table is cleared, which allows iterator transitions to
@@ -57,21 +63,24 @@ class OrderedHashTableBase : public FixedArray {
 //
 // Based on the "Deterministic Hash Table" as described by Jason Orendorff at
 // https://wiki.mozilla.org/User:Jorend/Deterministic_hash_tables
-// Originally attributed to Tyler Close.
+// Originally attributed to Tyler Close. Instead of chaining the entries of a
+// bucket through the data table, the hash table uses open addressing with
+// linear probing: a lookup scans consecutive buckets, starting at the one
+// selected by the hash, until it finds the key or an unused bucket. The data
+// table stays a compact array of entries in insertion order. Deleting an
+// entry only replaces its key with the hole, its bucket stays in use until
+// the next rehash.
 //
 // Memory layout:
 //   [0]: element count
 //   [1]: deleted element count
 //   [2]: bucket count
-//   [3..(3 + NumberOfBuckets() - 1)]: "hash table", where each item is an
-//                            offset into the data table (see below) where the
-//                            first item in this bucket is stored.
+//   [3..(3 + NumberOfBuckets() - 1)]: "hash table", where each item is either
+//                            kNotFound for an unused bucket or an offset into
+//                            the data table (see below).
 //   [3 + NumberOfBuckets()..length]: "data table", an array of length
-//                            Capacity() * kEntrySize, where the first entrysize
-//                            items are handled by the derived class and the
-//                            item at kChainOffset is another entry into the
-//                            data table indicating the next entry in this hash
-//                            bucket.
+//                            Capacity() * kEntrySize, where the entrysize
+//                            items are handled by the derived class.
 //
 // When we transition the table to a new version we obsolete it and reuse parts
 // of the memory to store information how to transition an iterator to the new
@@ -134,41 +143,43 @@ class OrderedHashTable : public OrderedHashTableBase {
 
   int HashToBucket(int hash) { return hash & (NumberOfBuckets() - 1); }
 
-  int HashToEntry(int hash) {
-    int bucket = HashToBucket(hash);
-    Object* entry = this->get(kHashTableStartIndex + bucket);
-    return Smi::ToInt(entry);
+  // Returns the bucket after {bucket} in a probe sequence.
+  int NextBucket(int bucket) { return (bucket + 1) & (NumberOfBuckets() - 1); }
+
+  // Returns the entry stored in {bucket}, or kNotFound if it is unused.
+  int EntryAtBucket(int bucket) {
+    return Smi::ToInt(get(kHashTableStartIndex + bucket));
   }
 
-  int KeyToFirstEntry(Isolate* isolate, Object* key) {
+  // Returns the hash of {key}, or kNotFound if the object does not have an
+  // identity hash, in which case it was never used as a key.
+  int KeyToHash(Isolate* isolate, Object* key) {
     // This special cases for Smi, so that we avoid the HandleScope
     // creation below.
     if (key->IsSmi()) {
       uint32_t hash = ComputeIntegerHash(Smi::ToInt(key));
-      return HashToEntry(hash & Smi::kMaxValue);
+      return hash & Smi::kMaxValue;
     }
     HandleScope scope(isolate);
     Object* hash = key->GetHash();
-    // If the object does not have an identity hash, it was never used as a key
     if (hash->IsUndefined(isolate)) return kNotFound;
-    return HashToEntry(Smi::ToInt(hash));
+    return Smi::ToInt(hash);
   }
 
   int FindEntry(Isolate* isolate, Object* key) {
-    int entry = KeyToFirstEntry(isolate, key);
-    // Walk the chain in the bucket to find the key.
-    while (entry != kNotFound) {
-      Object* candidate_key = KeyAt(entry);
-      if (candidate_key->SameValueZero(key)) break;
-      entry = NextChainEntry(entry);
+    int hash = KeyToHash(isolate, key);
+    if (hash == kNotFound) return kNotFound;
+    return FindEntry(key, hash);
+  }
+
+  int FindEntry(Object* key, int hash) {
+    // Probe the buckets until the key or an unused bucket is found. Buckets
+    // of deleted entries are still in use, their keys are the hole.
+    for (int bucket = HashToBucket(hash);; bucket = NextBucket(bucket)) {
+      int entry = EntryAtBucket(bucket);
+      if (entry == kNotFound) return kNotFound;
+      if (KeyAt(entry)->SameValueZero(key)) return entry;
     }
-
-    return entry;
-  }
-
-  int NextChainEntry(int entry) {
-    Object* next_entry = get(EntryToIndex(entry) + kChainOffset);
-    return Smi::ToInt(next_entry);
   }
 
   // use KeyAt(i)->IsTheHole(isolate) to determine if this is a deleted entry.
@@ -187,12 +198,13 @@ class OrderedHashTable : public OrderedHashTableBase {
     return Smi::ToInt(get(kRemovedHolesIndex + index));
   }
 
-  static const int kEntrySize = entrysize + 1;
-  static const int kChainOffset = entrysize;
+  static const int kEntrySize = entrysize;
 
+  // Every entry takes kEntrySize words in the data table and 4/3 of a word
+  // in the hash table.
   static const int kMaxCapacity =
-      (FixedArray::kMaxLength - kHashTableStartIndex) /
-      (1 + (kEntrySize * kLoadFactor));
+      3 * (FixedArray::kMaxLength - kHashTableStartIndex) /
+      (4 + 3 * kEntrySize);
 
  protected:
   static Handle<Derived> Rehash(Isolate* isolate, Handle<Derived> table,
@@ -211,7 +223,21 @@ class OrderedHashTable : public OrderedHashTableBase {
   }
 
   // Returns the number elements that can fit into the allocated buffer.
-  int Capacity() { return NumberOfBuckets() * kLoadFactor; }
+  int Capacity() { return CapacityForBuckets(NumberOfBuckets()); }
+
+  // Adds a new entry at the end of the data table and stores it in the first
+  // unused bucket of the probe sequence for {hash}. Returns the index of the
+  // new entry; the caller has to fill in its fields.
+  int AddEntry(int hash) {
+    DCHECK_LT(UsedCapacity(), Capacity());
+    int bucket = HashToBucket(hash);
+    while (EntryAtBucket(bucket) != kNotFound) bucket = NextBucket(bucket);
+    int nof = NumberOfElements();
+    int new_entry = nof + NumberOfDeletedElements();
+    set(kHashTableStartIndex + bucket, Smi::FromInt(new_entry));
+    SetNumberOfElements(nof + 1);
+    return EntryToIndex(new_entry);
+  }
 
   void SetNextTable(Derived* next_table) { set(kNextTableIndex, next_table); }
 
@@ -27,7 +27,8 @@ class PromiseReactionJobTask : public Microtask {
   DECL_ACCESSORS(argument, Object)
   DECL_ACCESSORS(context, Context)
   DECL_ACCESSORS(handler, HeapObject)
-  // [promise_or_capability]: Either a JSPromise or a PromiseCapability.
+  // [promise_or_capability]: Either a JSPromise, a PromiseCapability or
+  // undefined (see PromiseReaction below).
   DECL_ACCESSORS(promise_or_capability, HeapObject)
 
   static const int kArgumentOffset = Microtask::kHeaderSize;
@@ -122,7 +123,9 @@ class PromiseCapability : public Struct {
 //
 // The PromiseReaction::promise_or_capability field can either hold a JSPromise
 // instance (in the fast case of a native promise) or a PromiseCapability in
-// case of a Promise subclass.
+// case of a Promise subclass. It is undefined for the reactions that resume an
+// async function or generator after an await, as the resulting promise would
+// never be observable (unless promise hooks or the debugger are active).
 //
 // We need to keep the context in the PromiseReaction so that we can run
 // the default handlers (in case they are undefined) in the proper context.
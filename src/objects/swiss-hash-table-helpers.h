@@ -0,0 +1,185 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Helpers for hash tables that keep a byte of metadata per entry in a
+// separate control table, in the style of Abseil's "Swiss tables". Probing
+// reads a whole group of control bytes at once and only loads the keys of
+// the entries whose control byte matches 7 bits of the hash.
+
+#ifndef V8_OBJECTS_SWISS_HASH_TABLE_HELPERS_H_
+#define V8_OBJECTS_SWISS_HASH_TABLE_HELPERS_H_
+
+#include <stdint.h>
+
+#include "src/base/bits.h"
+#include "src/base/build_config.h"
+#include "src/base/logging.h"
+#include "src/utils.h"
+#include "src/v8memory.h"
+
+#if V8_HOST_ARCH_X64 || V8_HOST_ARCH_IA32
+#define V8_SWISS_TABLE_HAVE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace v8 {
+namespace internal {
+namespace swiss_table {
+
+// A control byte is either kEmpty, kDeleted or, for entries that are in use,
+// the seven H2 bits of the key's hash. Only the special values have the most
+// significant bit set.
+typedef uint8_t ctrl_t;
+const ctrl_t kEmpty = 0x80;
+const ctrl_t kDeleted = 0xFE;
+
+// The hash tables using control tables only ever start probing at
+// {hash & (capacity - 1)}, so H2 is taken from the most significant bits
+// of the 30-bit name hashes, which are unlikely to also select the entry.
+const int kH2Bits = 7;
+const int kH2Shift = 30 - kH2Bits;
+
+inline ctrl_t H2(uint32_t hash) {
+  return static_cast<ctrl_t>((hash >> kH2Shift) & ((1 << kH2Bits) - 1));
+}
+
+inline bool IsFull(ctrl_t control) { return (control & 0x80) == 0; }
+
+// An abstraction over a bitmask with one (possibly wider) bit per entry of a
+// group. {Shift} is log2 of the number of bits per entry.
+template <class T, int Shift>
+class BitMask {
+ public:
+  explicit BitMask(T mask) : mask_(mask) {}
+
+  bool HasAny() const { return mask_ != 0; }
+
+  // Returns the index of the first entry in the mask.
+  int LowestBitSet() const {
+    DCHECK(HasAny());
+    return static_cast<int>(base::bits::CountTrailingZeros(mask_)) >> Shift;
+  }
+
+  // Removes the first entry from the mask.
+  void ClearLowestBit() { mask_ &= mask_ - 1; }
+
+  // Removes all entries below {index}.
+  BitMask ClearBelow(int index) const {
+    return BitMask(static_cast<T>(mask_ & (~T{0} << (index << Shift))));
+  }
+
+ private:
+  T mask_;
+};
+
+#ifdef V8_SWISS_TABLE_HAVE_SSE2
+// Looks at 16 control bytes at once.
+class GroupSse2Impl {
+ public:
+  static const int kWidth = 16;
+  typedef BitMask<uint32_t, 0> Mask;
+
+  explicit GroupSse2Impl(const ctrl_t* pos)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+  // Returns the entries whose control byte is {h2}.
+  Mask Match(ctrl_t h2) const {
+    __m128i match = _mm_set1_epi8(static_cast<char>(h2));
+    return Mask(_mm_movemask_epi8(_mm_cmpeq_epi8(match, ctrl_)));
+  }
+
+  Mask MatchEmpty() const { return Match(kEmpty); }
+
+  // Only kEmpty and kDeleted have the sign bit set.
+  Mask MatchEmptyOrDeleted() const { return Mask(_mm_movemask_epi8(ctrl_)); }
+
+ private:
+  __m128i ctrl_;
+};
+#endif  // V8_SWISS_TABLE_HAVE_SSE2
+
+// Looks at 8 control bytes at once, using bit tricks on a 64-bit word.
+class GroupPortableImpl {
+ public:
+  static const int kWidth = 8;
+  typedef BitMask<uint64_t, 3> Mask;
+
+  explicit GroupPortableImpl(const ctrl_t* pos)
+      : ctrl_(ReadUnalignedValue<uint64_t>(reinterpret_cast<Address>(pos))) {
+#if defined(V8_TARGET_BIG_ENDIAN)
+    // The lowest bit of a mask has to correspond to the first entry.
+    ctrl_ = ByteReverse(ctrl_);
+#endif
+  }
+
+  // Returns the entries whose control byte is {h2}. This can also report
+  // an entry right after a matching one, so the keys have to be compared
+  // anyway.
+  Mask Match(ctrl_t h2) const {
+    uint64_t x = ctrl_ ^ (kLsbs * h2);
+    return Mask((x - kLsbs) & ~x & kMsbs);
+  }
+
+  // kEmpty is the only control byte with the most significant bit set and
+  // the second-least significant bit cleared.
+  Mask MatchEmpty() const { return Mask((ctrl_ & (~ctrl_ << 6)) & kMsbs); }
+
+  Mask MatchEmptyOrDeleted() const { return Mask(ctrl_ & kMsbs); }
+
+ private:
+  static const uint64_t kMsbs = V8_2PART_UINT64_C(0x80808080, 80808080);
+  static const uint64_t kLsbs = V8_2PART_UINT64_C(0x01010101, 01010101);
+
+  uint64_t ctrl_;
+};
+
+#ifdef V8_SWISS_TABLE_HAVE_SSE2
+typedef GroupSse2Impl Group;
+#else
+typedef GroupPortableImpl Group;
+#endif
+
+// Tables with a control table use linear probing: the probe sequence for a
+// hash visits the entries {hash & mask}, {(hash + 1) & mask}, ... in order.
+// This sequence is independent of the group width, so code generated for
+// another group width (e.g. a word at a time in the CodeStubAssembler) can
+// operate on the same tables. Groups are aligned to their width, so the
+// first group of a probe sequence includes some entries before the start,
+// which are excluded via {first_index()}. The capacity must be a multiple
+// of the group width.
+template <int kWidth>
+class ProbeSequence {
+ public:
+  ProbeSequence(uint32_t hash, uint32_t mask)
+      : mask_(mask),
+        offset_(hash & mask & ~(kWidth - 1)),
+        first_index_((hash & mask) & (kWidth - 1)) {
+    DCHECK_EQ(0, (mask + 1) % kWidth);
+  }
+
+  // The first entry of the current group.
+  uint32_t offset() const { return offset_; }
+  uint32_t offset(int i) const { return (offset_ + i) & mask_; }
+
+  // The first entry of the current group that belongs to the sequence.
+  int first_index() const { return first_index_; }
+
+  void Next() {
+    offset_ = (offset_ + kWidth) & mask_;
+    // After wrapping around, the entries skipped in the first group are the
+    // last ones of the sequence.
+    first_index_ = 0;
+  }
+
+ private:
+  uint32_t mask_;
+  uint32_t offset_;
+  int first_index_;
+};
+
+}  // namespace swiss_table
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_OBJECTS_SWISS_HASH_TABLE_HELPERS_H_
@@ -44,6 +44,8 @@ ACCESSORS(FunctionTemplateInfo, shared_function_info, Object,
           kSharedFunctionInfoOffset)
 ACCESSORS(FunctionTemplateInfo, cached_property_name, Object,
           kCachedPropertyNameOffset)
+ACCESSORS(FunctionTemplateInfo, c_function, Object, kCFunctionOffset)
+ACCESSORS(FunctionTemplateInfo, c_signature, Object, kCSignatureOffset)
 SMI_ACCESSORS(FunctionTemplateInfo, length, kLengthOffset)
 BOOL_ACCESSORS(FunctionTemplateInfo, flag, hidden_prototype,
                kHiddenPrototypeBit)
@@ -106,6 +106,13 @@ class FunctionTemplateInfo : public TemplateInfo {
   // FunctionTemplateInfo is used as a getter.
   DECL_ACCESSORS(cached_property_name, Object)
 
+  // Either a Foreign with the address of a C function that can be called
+  // directly from optimized code instead of the call_code, or Undefined.
+  DECL_ACCESSORS(c_function, Object)
+  // Either a Foreign with the address of the v8::CFunctionInfo describing the
+  // signature of the c_function, or Undefined.
+  DECL_ACCESSORS(c_signature, Object)
+
   // Begin flag bits ---------------------
   DECL_BOOLEAN_ACCESSORS(hidden_prototype)
   DECL_BOOLEAN_ACCESSORS(undetectable)
@@ -159,7 +166,9 @@ class FunctionTemplateInfo : public TemplateInfo {
   static const int kFlagOffset = kSharedFunctionInfoOffset + kPointerSize;
   static const int kLengthOffset = kFlagOffset + kPointerSize;
   static const int kCachedPropertyNameOffset = kLengthOffset + kPointerSize;
-  static const int kSize = kCachedPropertyNameOffset + kPointerSize;
+  static const int kCFunctionOffset = kCachedPropertyNameOffset + kPointerSize;
+  static const int kCSignatureOffset = kCFunctionOffset + kPointerSize;
+  static const int kSize = kCSignatureOffset + kPointerSize;
 
   static Handle<SharedFunctionInfo> GetOrCreateSharedFunctionInfo(
       Isolate* isolate, Handle<FunctionTemplateInfo> info,
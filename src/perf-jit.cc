@@ -198,9 +198,13 @@ uint64_t PerfJitLogger::GetTimestamp() {
 void PerfJitLogger::LogRecordedBuffer(AbstractCode* abstract_code,
                                       SharedFunctionInfo* shared,
                                       const char* name, int length) {
+  // With --interpreted-frames-native-stack, interpreted functions run on
+  // copies of the interpreter entry trampoline, which are builtins.
   if (FLAG_perf_basic_prof_only_functions &&
       (abstract_code->kind() != AbstractCode::INTERPRETED_FUNCTION &&
-       abstract_code->kind() != AbstractCode::OPTIMIZED_FUNCTION)) {
+       abstract_code->kind() != AbstractCode::OPTIMIZED_FUNCTION &&
+       !(abstract_code->IsCode() &&
+         abstract_code->GetCode()->is_interpreter_trampoline_builtin()))) {
     return;
   }
 
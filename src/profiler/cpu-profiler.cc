@@ -165,6 +165,7 @@ void ProfilerEventsProcessor::Run() {
       }
       now = base::TimeTicks::HighResolutionNow();
     } while (result != NoSamplesInQueue && now < nextSampleTime);
+    generator_->FlushContinuousProfileIfDue(now);
 
     if (nextSampleTime > now) {
 #if V8_OS_WIN
@@ -216,6 +217,7 @@ CpuProfile* CpuProfiler::GetProfile(int index) {
 
 
 void CpuProfiler::DeleteAllProfiles() {
+  StopContinuousProfiling();
   if (is_profiling_) StopProcessor();
   ResetProfiles();
 }
@@ -405,9 +407,37 @@ CpuProfile* CpuProfiler::StopProfiling(String* title) {
 
 void CpuProfiler::StopProcessorIfLastProfile(const char* title) {
   if (!profiles_->IsLastProfile(title)) return;
+  if (profiles_->is_continuous_profiling()) return;
   StopProcessor();
 }
 
+bool CpuProfiler::StartContinuousProfiling(
+    v8::ContinuousProfileSink* sink,
+    const v8::ContinuousProfilingOptions& options) {
+  if (!is_profiling_) {
+    sampling_interval_ =
+        base::TimeDelta::FromMicroseconds(options.sampling_interval_us);
+  }
+  std::unique_ptr<ContinuousProfile> profile(new ContinuousProfile(
+      sink, sampling_interval_,
+      base::TimeDelta::FromMilliseconds(options.flush_interval_ms),
+      options.memory_budget));
+  if (!profiles_->StartContinuousProfiling(std::move(profile))) return false;
+  TRACE_EVENT0("v8", "CpuProfiler::StartContinuousProfiling");
+  StartProcessorIfNotStarted();
+  return true;
+}
+
+void CpuProfiler::StopContinuousProfiling() {
+  if (!profiles_->is_continuous_profiling()) return;
+  // Stopping the processor processes the remaining samples, so they are
+  // part of the last chunk.
+  if (!profiles_->has_current_profiles()) StopProcessor();
+  std::unique_ptr<ContinuousProfile> profile =
+      profiles_->StopContinuousProfiling();
+  profile->Flush(base::TimeTicks::HighResolutionNow());
+}
+
 void CpuProfiler::StopProcessor() {
   Logger* logger = isolate_->logger();
   is_profiling_ = false;
@@ -208,6 +208,9 @@ class CpuProfiler : public CodeEventObserver {
   void StartProfiling(String* title, bool record_samples, ProfilingMode mode);
   CpuProfile* StopProfiling(const char* title);
   CpuProfile* StopProfiling(String* title);
+  bool StartContinuousProfiling(v8::ContinuousProfileSink* sink,
+                                const v8::ContinuousProfilingOptions& options);
+  void StopContinuousProfiling();
   int GetProfilesCount();
   CpuProfile* GetProfile(int index);
   void DeleteAllProfiles();
@@ -112,6 +112,23 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
   return result;
 }
 
+bool HeapProfiler::StreamSnapshot(
+    v8::OutputStream* stream, v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver) {
+  bool result;
+  {
+    HeapSnapshotStreamer streamer(this, control, resolver, heap());
+    result = streamer.StreamSnapshot(stream);
+  }
+  ids_->RemoveDeadEntries();
+  is_tracking_object_moves_ = true;
+
+  heap()->isolate()->debug()->feature_tracker()->Track(
+      DebugFeatureTracker::kHeapSnapshot);
+
+  return result;
+}
+
 bool HeapProfiler::StartSamplingHeapProfiler(
     uint64_t sample_interval, int stack_depth,
     v8::HeapProfiler::SamplingFlags flags) {
@@ -137,6 +154,12 @@ v8::AllocationProfile* HeapProfiler::GetAllocationProfile() {
   }
 }
 
+bool HeapProfiler::CollectSampledAllocations(
+    v8::SampledAllocationsSink* sink) {
+  if (!sampling_heap_profiler_) return false;
+  return sampling_heap_profiler_->CollectSampledAllocations(sink);
+}
+
 
 void HeapProfiler::StartHeapObjectsTracking(bool track_allocations) {
   ids_->UpdateHeapObjectsMap();
@@ -32,12 +32,15 @@ class HeapProfiler : public HeapObjectAllocationTracker {
   HeapSnapshot* TakeSnapshot(
       v8::ActivityControl* control,
       v8::HeapProfiler::ObjectNameResolver* resolver);
+  bool StreamSnapshot(v8::OutputStream* stream, v8::ActivityControl* control,
+                      v8::HeapProfiler::ObjectNameResolver* resolver);
 
   bool StartSamplingHeapProfiler(uint64_t sample_interval, int stack_depth,
                                  v8::HeapProfiler::SamplingFlags);
   void StopSamplingHeapProfiler();
   bool is_sampling_allocations() { return !!sampling_heap_profiler_; }
   AllocationProfile* GetAllocationProfile();
+  bool CollectSampledAllocations(v8::SampledAllocationsSink* sink);
 
   void StartHeapObjectsTracking(bool track_allocations);
   void StopHeapObjectsTracking();
@@ -4,13 +4,19 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "src/api-inl.h"
+#include "src/base/bits.h"
+#include "src/base/platform/semaphore.h"
 #include "src/code-stubs.h"
 #include "src/conversions.h"
 #include "src/debug/debug.h"
 #include "src/global-handles.h"
+#include "src/heap/item-parallel-job.h"
+#include "src/heap/spaces.h"
 #include "src/layout-descriptor.h"
 #include "src/objects-body-descriptors.h"
 #include "src/objects-inl.h"
@@ -28,6 +34,7 @@
 #include "src/profiler/heap-snapshot-generator-inl.h"
 #include "src/prototype.h"
 #include "src/transitions.h"
+#include "src/v8.h"
 #include "src/visitors.h"
 
 namespace v8 {
@@ -177,8 +184,9 @@ const char* HeapEntry::TypeAsString() {
 }
 
 
-HeapSnapshot::HeapSnapshot(HeapProfiler* profiler)
+HeapSnapshot::HeapSnapshot(HeapProfiler* profiler, StringsStorage* names)
     : profiler_(profiler),
+      names_(names != nullptr ? names : profiler->names()),
       root_index_(HeapEntry::kNoEntry),
       gc_roots_index_(HeapEntry::kNoEntry),
       max_snapshot_js_object_id_(0) {
@@ -391,6 +399,13 @@ SnapshotObjectId HeapObjectsMap::FindEntry(Address addr) {
 }
 
 
+SnapshotObjectId HeapObjectsMap::ReserveIds(int count) {
+  SnapshotObjectId first_id = next_id_;
+  next_id_ += count * kObjectIdStep;
+  return first_id;
+}
+
+
 SnapshotObjectId HeapObjectsMap::FindOrAddEntry(Address addr,
                                                 unsigned int size,
                                                 bool accessed) {
@@ -592,16 +607,149 @@ V8_NOINLINE void HeapObjectsSet::SetTag(Object* obj, const char* tag) {
   cache_entry->value = const_cast<char*>(tag);
 }
 
+namespace {
+
+// Estimates the memory used by a std::unordered_map, whose nodes hold a value
+// and a pointer to the next node.
+template <typename Map>
+size_t UnorderedMapMemoryUsage(const Map& map) {
+  return map.size() * (sizeof(typename Map::value_type) + sizeof(void*)) +
+         map.bucket_count() * sizeof(void*);
+}
+
+}  // namespace
+
+HeapObjectsIndex::HeapObjectsIndex(Heap* heap, HeapObjectsMap* ids,
+                                   int first_index)
+    : first_index_(first_index), size_(0) {
+  MemoryChunk* chunk = nullptr;
+  std::vector<uint32_t> offsets;
+  HeapIterator iterator(heap);
+  for (HeapObject* obj = iterator.next(); obj != nullptr;
+       obj = iterator.next()) {
+    MemoryChunk* obj_chunk = MemoryChunk::FromAddress(obj->address());
+    if (obj_chunk != chunk) {
+      if (chunk != nullptr) AddPage(chunk, offsets);
+      chunk = obj_chunk;
+      offsets.clear();
+    }
+    offsets.push_back(static_cast<uint32_t>(
+        (obj->address() - chunk->area_start()) >> kPointerSizeLog2));
+  }
+  if (chunk != nullptr) AddPage(chunk, offsets);
+  first_id_ = ids->ReserveIds(size_);
+}
+
+
+void HeapObjectsIndex::AddPage(MemoryChunk* chunk,
+                               const std::vector<uint32_t>& offsets) {
+  DCHECK_EQ(0, pages_by_chunk_.count(chunk->address()));
+  pages_by_chunk_[chunk->address()] = pages_.size();
+  pages_.emplace_back();
+  PageIndex& page = pages_.back();
+  page.area_start = chunk->area_start();
+  page.first_index = first_index_ + size_;
+  size_t length = offsets.back() / 64 + 1;
+  page.starts.resize(length, 0);
+  page.counts.resize(length);
+  for (uint32_t offset : offsets) {
+    page.starts[offset / 64] |= uint64_t{1} << (offset % 64);
+  }
+  uint32_t count = 0;
+  for (size_t i = 0; i < length; i++) {
+    page.counts[i] = count;
+    count += base::bits::CountPopulation(page.starts[i]);
+  }
+  DCHECK_EQ(offsets.size(), count);
+  size_ += static_cast<int>(offsets.size());
+}
+
+
+const HeapObjectsIndex::PageIndex* HeapObjectsIndex::FindPage(
+    Address address) const {
+  auto it = pages_by_chunk_.find(address & ~MemoryChunk::kAlignmentMask);
+  return it != pages_by_chunk_.end() ? &pages_[it->second] : nullptr;
+}
+
+
+int HeapObjectsIndex::Lookup(Address address) const {
+  const PageIndex* page = FindPage(address);
+  if (page == nullptr || address < page->area_start ||
+      (address & kPointerAlignmentMask) != 0) {
+    return HeapEntry::kNoEntry;
+  }
+  size_t offset = (address - page->area_start) >> kPointerSizeLog2;
+  size_t i = offset / 64;
+  if (i >= page->starts.size()) return HeapEntry::kNoEntry;
+  uint64_t bit = uint64_t{1} << (offset % 64);
+  if ((page->starts[i] & bit) == 0) return HeapEntry::kNoEntry;
+  return page->first_index + page->counts[i] +
+         base::bits::CountPopulation(page->starts[i] & (bit - 1));
+}
+
+
+Address HeapObjectsIndex::Get(int index) const {
+  DCHECK(first_index_ <= index && index < first_index_ + size_);
+  auto page = std::upper_bound(pages_.begin(), pages_.end(), index,
+                               [](int index, const PageIndex& page) {
+                                 return index < page.first_index;
+                               }) -
+              1;
+  uint32_t rank = static_cast<uint32_t>(index - page->first_index);
+  // The last element counting at most |rank| objects before it holds the
+  // start of the object.
+  size_t i = std::upper_bound(page->counts.begin(), page->counts.end(), rank) -
+             page->counts.begin() - 1;
+  uint64_t starts = page->starts[i];
+  for (uint32_t n = rank - page->counts[i]; n > 0; n--) {
+    starts &= starts - 1;
+  }
+  size_t offset = i * 64 + base::bits::CountTrailingZeros(starts);
+  return page->area_start + (offset << kPointerSizeLog2);
+}
+
+
+SnapshotObjectId HeapObjectsIndex::GetObjectId(Address address) const {
+  int index = Lookup(address);
+  if (index == HeapEntry::kNoEntry) return 0;
+  return first_id_ + (index - first_index_) * HeapObjectsMap::kObjectIdStep;
+}
+
+
+size_t HeapObjectsIndex::memory_usage() const {
+  size_t size = sizeof(*this) + pages_.capacity() * sizeof(PageIndex);
+  for (const PageIndex& page : pages_) {
+    size += page.starts.capacity() * sizeof(uint64_t) +
+            page.counts.capacity() * sizeof(uint32_t);
+  }
+  return size + UnorderedMapMemoryUsage(pages_by_chunk_);
+}
+
+
 V8HeapExplorer::V8HeapExplorer(HeapSnapshot* snapshot,
                                SnapshottingProgressReportingInterface* progress,
                                v8::HeapProfiler::ObjectNameResolver* resolver)
     : heap_(snapshot->profiler()->heap_object_map()->heap()),
       snapshot_(snapshot),
-      names_(snapshot_->profiler()->names()),
+      names_(snapshot_->names()),
       heap_object_map_(snapshot_->profiler()->heap_object_map()),
       progress_(progress),
       filler_(nullptr),
-      global_object_name_resolver_(resolver) {}
+      global_object_name_resolver_(resolver),
+      objects_index_(nullptr),
+      string_names_budget_(std::numeric_limits<size_t>::max()) {}
+
+V8HeapExplorer::V8HeapExplorer(V8HeapExplorer* explorer,
+                               HeapSnapshot* scratch)
+    : heap_(explorer->heap_),
+      snapshot_(scratch),
+      names_(explorer->names_),
+      heap_object_map_(nullptr),
+      progress_(nullptr),
+      filler_(nullptr),
+      global_object_name_resolver_(nullptr),
+      objects_index_(nullptr),
+      string_names_budget_(explorer->string_names_budget_) {}
 
 V8HeapExplorer::~V8HeapExplorer() {
 }
@@ -645,6 +793,10 @@ HeapEntry* V8HeapExplorer::AddEntry(HeapObject* object) {
       return AddEntry(object,
                       HeapEntry::kSlicedString,
                       "(sliced string)");
+    if (string_names_budget_ != std::numeric_limits<size_t>::max() &&
+        names_->GetUsedMemorySize() >= string_names_budget_) {
+      return AddEntry(object, HeapEntry::kString, "(string)");
+    }
     return AddEntry(object,
                     HeapEntry::kString,
                     names_->GetName(String::cast(object)));
@@ -694,8 +846,21 @@ HeapEntry* V8HeapExplorer::AddEntry(Address address,
                                     HeapEntry::Type type,
                                     const char* name,
                                     size_t size) {
-  SnapshotObjectId object_id = heap_object_map_->FindOrAddEntry(
-      address, static_cast<unsigned int>(size));
+  if (heap_object_map_ == nullptr) {
+    // Worker explorers only name the entries, see ReferencesExtractionTask.
+    return snapshot_->AddEntry(type, name, 0, size, 0);
+  }
+  SnapshotObjectId object_id = 0;
+  if (objects_index_ != nullptr &&
+      heap_object_map_->FindEntry(address) == 0) {
+    // Streamed snapshots don't add their objects to the ids map, which would
+    // take more memory than the rest of the snapshot.
+    object_id = objects_index_->GetObjectId(address);
+  }
+  if (object_id == 0) {
+    object_id = heap_object_map_->FindOrAddEntry(
+        address, static_cast<unsigned int>(size));
+  }
   unsigned trace_node_id = 0;
   if (AllocationTracker* allocation_tracker =
       snapshot_->profiler()->allocation_tracker()) {
@@ -706,56 +871,72 @@ HeapEntry* V8HeapExplorer::AddEntry(Address address,
 }
 
 
-class SnapshotFiller {
+void SnapshotFiller::SetEphemeronReference(StringsStorage* names, int key,
+                                           int value) {
+  const char* edge_name =
+      names->GetFormatted("key %s in WeakMap", GetEntryName(key));
+  SetNamedAutoIndexReference(HeapGraphEdge::kInternal, key, edge_name, value);
+}
+
+
+// A SnapshotFiller that builds the graph of a HeapSnapshot.
+class HeapSnapshotFiller : public SnapshotFiller {
  public:
-  explicit SnapshotFiller(HeapSnapshot* snapshot, HeapEntriesMap* entries)
+  explicit HeapSnapshotFiller(HeapSnapshot* snapshot, HeapEntriesMap* entries)
       : snapshot_(snapshot),
-        names_(snapshot->profiler()->names()),
+        names_(snapshot->names()),
         entries_(entries) { }
-  HeapEntry* AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
-    HeapEntry* entry = allocator->AllocateEntry(ptr);
-    entries_->Pair(ptr, entry->index());
+  int AddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
+    int entry = allocator->AllocateEntry(ptr)->index();
+    entries_->Pair(ptr, entry);
     return entry;
   }
-  HeapEntry* FindEntry(HeapThing ptr) {
-    int index = entries_->Map(ptr);
-    return index != HeapEntry::kNoEntry ? &snapshot_->entries()[index]
-                                        : nullptr;
+  int FindEntry(HeapThing ptr) override { return entries_->Map(ptr); }
+  int FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) override {
+    int entry = FindEntry(ptr);
+    return entry != HeapEntry::kNoEntry ? entry : AddEntry(ptr, allocator);
+  }
+  const char* GetEntryName(int entry) override {
+    return snapshot_->entries()[entry].name();
   }
-  HeapEntry* FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) {
-    HeapEntry* entry = FindEntry(ptr);
-    return entry != nullptr ? entry : AddEntry(ptr, allocator);
+  void TagEntry(int entry, const char* tag) override {
+    HeapEntry* heap_entry = &snapshot_->entries()[entry];
+    if (heap_entry->name()[0] == '\0') heap_entry->set_name(tag);
   }
-  void SetIndexedReference(HeapGraphEdge::Type type,
-                           int parent,
-                           int index,
-                           HeapEntry* child_entry) {
+  void SetEntryNameAndType(int entry, const char* name,
+                           HeapEntry::Type type) override {
+    HeapEntry* heap_entry = &snapshot_->entries()[entry];
+    heap_entry->set_name(name);
+    heap_entry->set_type(type);
+  }
+  void SetIndexedReference(HeapGraphEdge::Type type, int parent, int index,
+                           int child) override {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    parent_entry->SetIndexedReference(type, index, child_entry);
+    parent_entry->SetIndexedReference(type, index,
+                                      &snapshot_->entries()[child]);
   }
-  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
-                                    int parent,
-                                    HeapEntry* child_entry) {
+  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                    int child) override {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
     int index = parent_entry->children_count() + 1;
-    parent_entry->SetIndexedReference(type, index, child_entry);
+    parent_entry->SetIndexedReference(type, index,
+                                      &snapshot_->entries()[child]);
   }
-  void SetNamedReference(HeapGraphEdge::Type type,
-                         int parent,
-                         const char* reference_name,
-                         HeapEntry* child_entry) {
+  void SetNamedReference(HeapGraphEdge::Type type, int parent,
+                         const char* reference_name, int child) override {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
-    parent_entry->SetNamedReference(type, reference_name, child_entry);
+    parent_entry->SetNamedReference(type, reference_name,
+                                    &snapshot_->entries()[child]);
   }
   void SetNamedAutoIndexReference(HeapGraphEdge::Type type, int parent,
                                   const char* description,
-                                  HeapEntry* child_entry) {
+                                  int child) override {
     HeapEntry* parent_entry = &snapshot_->entries()[parent];
     int index = parent_entry->children_count() + 1;
     const char* name = description
                            ? names_->GetFormatted("%d / %s", index, description)
                            : names_->GetName(index);
-    parent_entry->SetNamedReference(type, name, child_entry);
+    parent_entry->SetNamedReference(type, name, &snapshot_->entries()[child]);
   }
 
  private:
@@ -1049,14 +1230,11 @@ void V8HeapExplorer::ExtractEphemeronHashTableReferences(
                      table->OffsetOfElementAt(key_index));
     SetInternalReference(table, entry, value_index, value,
                          table->OffsetOfElementAt(value_index));
-    HeapEntry* key_entry = GetEntry(key);
-    int key_entry_index = key_entry->index();
-    HeapEntry* value_entry = GetEntry(value);
-    if (key_entry && value_entry) {
-      const char* edge_name =
-          names_->GetFormatted("key %s in WeakMap", key_entry->name());
-      filler_->SetNamedAutoIndexReference(
-          HeapGraphEdge::kInternal, key_entry_index, edge_name, value_entry);
+    int key_entry = GetEntry(key);
+    int value_entry = GetEntry(value);
+    if (key_entry != HeapEntry::kNoEntry &&
+        value_entry != HeapEntry::kNoEntry) {
+      filler_->SetEphemeronReference(names_, key_entry, value_entry);
     }
   }
 }
@@ -1339,8 +1517,7 @@ void V8HeapExplorer::ExtractJSArrayBufferReferences(
     return;
   size_t data_size = NumberToSize(buffer->byte_length());
   JSArrayBufferDataEntryAllocator allocator(data_size, this);
-  HeapEntry* data_entry =
-      filler_->FindOrAddEntry(buffer->backing_store(), &allocator);
+  int data_entry = filler_->FindOrAddEntry(buffer->backing_store(), &allocator);
   filler_->SetNamedReference(HeapGraphEdge::kInternal,
                              entry, "backing_store", data_entry);
 }
@@ -1380,6 +1557,9 @@ void V8HeapExplorer::ExtractFeedbackVectorReferences(
     SetWeakReference(feedback_vector, entry, "optimized code", code_heap_object,
                      FeedbackVector::kOptimizedCodeOffset);
   }
+  SetInternalReference(feedback_vector, entry, "osr_code_cache",
+                       feedback_vector->osr_code_cache(),
+                       FeedbackVector::kOsrCodeCacheOffset);
 }
 
 template <typename T>
@@ -1524,8 +1704,8 @@ String* V8HeapExplorer::GetConstructorName(JSObject* object) {
 }
 
 
-HeapEntry* V8HeapExplorer::GetEntry(Object* obj) {
-  if (!obj->IsHeapObject()) return nullptr;
+int V8HeapExplorer::GetEntry(Object* obj) {
+  if (!obj->IsHeapObject()) return HeapEntry::kNoEntry;
   return filler_->FindOrAddEntry(obj, this);
 }
 
@@ -1556,9 +1736,275 @@ class RootsReferencesExtractor : public RootVisitor {
   bool visiting_weak_roots_;
 };
 
+// The objects of a page, and the entries and references that a worker thread
+// found for them. The worker records the calls that its explorer makes to the
+// filler, and the main thread replays them in page order. This adds the
+// entries and references to the snapshot in the same order as extracting the
+// references on the main thread does, so the snapshots are the same.
+class ObjectsBatch final : public ItemParallelJob::Item {
+ public:
+  enum RecordKind : uint8_t {
+    kEntry,
+    kTag,
+    kIndexed,
+    kIndexedAutoIndex,
+    kNamed,
+    kNamedAutoIndex,
+    kEphemeron
+  };
+
+  // The entries of a batch are numbered from 0 in the order in which the
+  // worker first looked them up. The main thread names the entries of heap
+  // objects, the other ones carry what their allocator gave them.
+  struct Entry {
+    HeapThing thing;
+    bool is_heap_object;
+    HeapEntry::Type type;
+    const char* name;
+    size_t size;
+  };
+
+  struct Record {
+    RecordKind kind;
+    HeapGraphEdge::Type type;
+    int parent;
+    int child;
+    // The index of indexed references, the name of named references, or the
+    // tag of tags.
+    union {
+      int index;
+      const char* name;
+    };
+  };
+
+  void AddObject(HeapObject* object) { objects_.push_back(object); }
+  const std::vector<HeapObject*>& objects() const { return objects_; }
+  std::vector<Entry>* entries() { return &entries_; }
+  std::vector<Record>* records() { return &records_; }
+
+  void Replay(SnapshotFiller* filler, V8HeapExplorer* explorer,
+              StringsStorage* names);
+  // Frees the entries and references once they are replayed.
+  void Release();
+
+ private:
+  std::vector<HeapObject*> objects_;
+  std::vector<Entry> entries_;
+  std::vector<Record> records_;
+};
+
+// Adds the entries that a worker explorer allocated for things other than
+// heap objects to the snapshot.
+class RecordedEntriesAllocator : public HeapEntriesAllocator {
+ public:
+  RecordedEntriesAllocator(V8HeapExplorer* explorer,
+                           const ObjectsBatch::Entry* entry)
+      : explorer_(explorer), entry_(entry) {}
+  HeapEntry* AllocateEntry(HeapThing ptr) override {
+    return explorer_->AddEntry(reinterpret_cast<Address>(ptr), entry_->type,
+                               entry_->name, entry_->size);
+  }
+
+ private:
+  V8HeapExplorer* explorer_;
+  const ObjectsBatch::Entry* entry_;
+};
+
+void ObjectsBatch::Replay(SnapshotFiller* filler, V8HeapExplorer* explorer,
+                          StringsStorage* names) {
+  std::vector<int> entries(entries_.size(), HeapEntry::kNoEntry);
+  for (const Record& record : records_) {
+    if (record.kind == kEntry) {
+      const Entry* entry = &entries_[record.child];
+      HeapEntriesAllocator* allocator = explorer;
+      RecordedEntriesAllocator recorded_allocator(explorer, entry);
+      if (!entry->is_heap_object) allocator = &recorded_allocator;
+      entries[record.child] = filler->FindOrAddEntry(entry->thing, allocator);
+      continue;
+    }
+    int parent = entries[record.parent];
+    if (record.kind == kTag) {
+      filler->TagEntry(parent, record.name);
+      continue;
+    }
+    int child = entries[record.child];
+    switch (record.kind) {
+      case kIndexed:
+        filler->SetIndexedReference(record.type, parent, record.index, child);
+        break;
+      case kIndexedAutoIndex:
+        filler->SetIndexedAutoIndexReference(record.type, parent, child);
+        break;
+      case kNamed:
+        filler->SetNamedReference(record.type, parent, record.name, child);
+        break;
+      case kNamedAutoIndex:
+        filler->SetNamedAutoIndexReference(record.type, parent, record.name,
+                                           child);
+        break;
+      case kEphemeron:
+        filler->SetEphemeronReference(names, parent, child);
+        break;
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+void ObjectsBatch::Release() {
+  std::vector<Entry>().swap(entries_);
+  std::vector<Record>().swap(records_);
+}
+
+// A SnapshotFiller that records the entries and references of the objects of
+// a batch, see ObjectsBatch.
+class RecordingSnapshotFiller : public SnapshotFiller {
+ public:
+  explicit RecordingSnapshotFiller(V8HeapExplorer* explorer)
+      : explorer_(explorer), batch_(nullptr) {}
+
+  void set_batch(ObjectsBatch* batch) {
+    batch_ = batch;
+    entries_.clear();
+  }
+
+  int FindEntry(HeapThing ptr) override { UNREACHABLE(); }
+  int FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) override {
+    auto it = entries_.find(ptr);
+    if (it != entries_.end()) return it->second;
+    ObjectsBatch::Entry entry = {ptr, true, HeapEntry::kHidden, nullptr, 0};
+    if (allocator != explorer_) {
+      // The allocators of other things only live while their references are
+      // extracted, so the entry is allocated right away.
+      HeapEntry* allocated = allocator->AllocateEntry(ptr);
+      entry.is_heap_object = false;
+      entry.type = allocated->type();
+      entry.name = allocated->name();
+      entry.size = allocated->self_size();
+    }
+    int index = static_cast<int>(batch_->entries()->size());
+    batch_->entries()->push_back(entry);
+    AddRecord(ObjectsBatch::kEntry, HeapGraphEdge::kInternal,
+              HeapEntry::kNoEntry, index);
+    entries_[ptr] = index;
+    return index;
+  }
+  // The names of heap objects are only known on the main thread.
+  const char* GetEntryName(int entry) override { UNREACHABLE(); }
+  void TagEntry(int entry, const char* tag) override {
+    AddRecord(ObjectsBatch::kTag, HeapGraphEdge::kInternal, entry,
+              HeapEntry::kNoEntry)
+        ->name = tag;
+  }
+  void SetEntryNameAndType(int entry, const char* name,
+                           HeapEntry::Type type) override {
+    UNREACHABLE();
+  }
+  void SetIndexedReference(HeapGraphEdge::Type type, int parent, int index,
+                           int child) override {
+    AddRecord(ObjectsBatch::kIndexed, type, parent, child)->index = index;
+  }
+  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                    int child) override {
+    AddRecord(ObjectsBatch::kIndexedAutoIndex, type, parent, child);
+  }
+  void SetNamedReference(HeapGraphEdge::Type type, int parent,
+                         const char* reference_name, int child) override {
+    AddRecord(ObjectsBatch::kNamed, type, parent, child)->name =
+        reference_name;
+  }
+  void SetNamedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                  const char* description,
+                                  int child) override {
+    AddRecord(ObjectsBatch::kNamedAutoIndex, type, parent, child)->name =
+        description;
+  }
+  void SetEphemeronReference(StringsStorage* names, int key,
+                             int value) override {
+    AddRecord(ObjectsBatch::kEphemeron, HeapGraphEdge::kInternal, key, value);
+  }
+
+ private:
+  ObjectsBatch::Record* AddRecord(ObjectsBatch::RecordKind kind,
+                                  HeapGraphEdge::Type type, int parent,
+                                  int child) {
+    batch_->records()->emplace_back();
+    ObjectsBatch::Record* record = &batch_->records()->back();
+    record->kind = kind;
+    record->type = type;
+    record->parent = parent;
+    record->child = child;
+    record->name = nullptr;
+    return record;
+  }
+
+  V8HeapExplorer* explorer_;
+  ObjectsBatch* batch_;
+  std::unordered_map<HeapThing, int> entries_;
+};
+
+// Extracts the references of batches of objects, on a worker thread or on
+// the main thread.
+class ReferencesExtractionTask : public ItemParallelJob::Task {
+ public:
+  explicit ReferencesExtractionTask(V8HeapExplorer* explorer)
+      : ItemParallelJob::Task(explorer->heap_->isolate()),
+        scratch_(explorer->snapshot_->profiler()),
+        explorer_(explorer, &scratch_),
+        filler_(&explorer_) {}
+
+  void RunInParallel() override {
+    // Naming heap objects needs handles, so the main thread names them when
+    // it replays the batches.
+    DisallowHeapAllocation no_allocation;
+    DisallowHandleAllocation no_handles;
+    explorer_.filler_ = &filler_;
+    ObjectsBatch* batch = nullptr;
+    while ((batch = GetItem<ObjectsBatch>()) != nullptr) {
+      filler_.set_batch(batch);
+      for (HeapObject* obj : batch->objects()) {
+        explorer_.ExtractObjectReferences(obj);
+      }
+      batch->MarkFinished();
+    }
+    explorer_.filler_ = nullptr;
+  }
+
+ private:
+  HeapSnapshot scratch_;
+  V8HeapExplorer explorer_;
+  RecordingSnapshotFiller filler_;
+};
+
 bool V8HeapExplorer::IterateAndExtractReferences(SnapshotFiller* filler) {
   filler_ = filler;
 
+  ExtractRootReferences();
+
+  if (FLAG_heap_snapshot_threads > 0) {
+    bool completed = ExtractReferencesInParallel();
+    filler_ = nullptr;
+    return completed && progress_->ProgressReport(true);
+  }
+
+  bool interrupted = false;
+
+  HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+  // Heap iteration with filtering must be finished in any case.
+  for (HeapObject *obj = iterator.next(); obj != nullptr;
+       obj = iterator.next(), progress_->ProgressStep()) {
+    if (interrupted) continue;
+
+    ExtractObjectReferences(obj);
+
+    if (!progress_->ProgressReport(false)) interrupted = true;
+  }
+
+  filler_ = nullptr;
+  return interrupted ? false : progress_->ProgressReport(true);
+}
+
+void V8HeapExplorer::ExtractRootReferences() {
   // Create references to the synthetic roots.
   SetRootGcRootsReference();
   for (int root = 0; root < static_cast<int>(Root::kNumberOfRoots); root++) {
@@ -1572,42 +2018,71 @@ bool V8HeapExplorer::IterateAndExtractReferences(SnapshotFiller* filler) {
   heap_->IterateRoots(&extractor, VISIT_ONLY_STRONG);
   extractor.SetVisitingWeakRoots();
   heap_->IterateWeakGlobalHandles(&extractor);
+}
 
-  bool interrupted = false;
+void V8HeapExplorer::ExtractObjectReferences(HeapObject* obj) {
+  size_t max_pointer = obj->Size() / kPointerSize;
+  if (max_pointer > visited_fields_.size()) {
+    // Clear the current bits.
+    std::vector<bool>().swap(visited_fields_);
+    // Reallocate to right size.
+    visited_fields_.resize(max_pointer, false);
+  }
 
-  HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
-  // Heap iteration with filtering must be finished in any case.
-  for (HeapObject *obj = iterator.next(); obj != nullptr;
-       obj = iterator.next(), progress_->ProgressStep()) {
-    if (interrupted) continue;
+  int entry = GetEntry(obj);
+  ExtractReferences(entry, obj);
+  SetInternalReference(obj, entry, "map", obj->map(), HeapObject::kMapOffset);
+  // Extract unvisited fields as hidden references and restore tags
+  // of visited fields.
+  IndexedReferencesExtractor refs_extractor(this, obj, entry);
+  obj->Iterate(&refs_extractor);
 
-    size_t max_pointer = obj->Size() / kPointerSize;
-    if (max_pointer > visited_fields_.size()) {
-      // Clear the current bits.
-      std::vector<bool>().swap(visited_fields_);
-      // Reallocate to right size.
-      visited_fields_.resize(max_pointer, false);
-    }
+  // Ensure visited_fields_ doesn't leak to the next object.
+  for (size_t i = 0; i < max_pointer; ++i) {
+    DCHECK(!visited_fields_[i]);
+  }
+}
 
-    HeapEntry* heap_entry = GetEntry(obj);
-    int entry = heap_entry->index();
-    ExtractReferences(entry, obj);
-    SetInternalReference(obj, entry, "map", obj->map(), HeapObject::kMapOffset);
-    // Extract unvisited fields as hidden references and restore tags
-    // of visited fields.
-    IndexedReferencesExtractor refs_extractor(this, obj, entry);
-    obj->Iterate(&refs_extractor);
-
-    // Ensure visited_fields_ doesn't leak to the next object.
-    for (size_t i = 0; i < max_pointer; ++i) {
-      DCHECK(!visited_fields_[i]);
+bool V8HeapExplorer::ExtractReferencesInParallel() {
+  DisallowHeapAllocation no_allocation;
+  base::Semaphore pending_tasks(0);
+  ItemParallelJob job(heap_->isolate()->cancelable_task_manager(),
+                      &pending_tasks);
+  // The job owns the batches, which are kept in heap iteration order here.
+  std::vector<ObjectsBatch*> batches;
+  {
+    HeapIterator iterator(heap_, HeapIterator::kFilterUnreachable);
+    MemoryChunk* chunk = nullptr;
+    for (HeapObject* obj = iterator.next(); obj != nullptr;
+         obj = iterator.next()) {
+      MemoryChunk* obj_chunk = MemoryChunk::FromAddress(obj->address());
+      if (obj_chunk != chunk) {
+        chunk = obj_chunk;
+        batches.push_back(new ObjectsBatch());
+        job.AddItem(batches.back());
+      }
+      batches.back()->AddObject(obj);
     }
+  }
 
-    if (!progress_->ProgressReport(false)) interrupted = true;
+  static int num_cores = V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1;
+  int num_tasks = Max(
+      1, Min(Min(FLAG_heap_snapshot_threads, num_cores), job.NumberOfItems()));
+  for (int i = 0; i < num_tasks; i++) {
+    job.AddTask(new ReferencesExtractionTask(this));
   }
+  job.Run(heap_->isolate()->async_counters());
 
-  filler_ = nullptr;
-  return interrupted ? false : progress_->ProgressReport(true);
+  bool interrupted = false;
+  for (ObjectsBatch* batch : batches) {
+    if (!interrupted) batch->Replay(filler_, this, names_);
+    batch->Release();
+    for (size_t i = 0; i < batch->objects().size(); i++) {
+      if (!interrupted && !progress_->ProgressReport(false)) interrupted = true;
+      progress_->ProgressStep();
+    }
+  }
+  return !interrupted;
 }
 
 
@@ -1645,9 +2120,9 @@ void V8HeapExplorer::SetContextReference(HeapObject* parent_obj,
                                          String* reference_name,
                                          Object* child_obj,
                                          int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   filler_->SetNamedReference(HeapGraphEdge::kContextVariable, parent_entry,
                              names_->GetName(reference_name), child_entry);
   MarkVisitedField(field_offset);
@@ -1665,9 +2140,9 @@ void V8HeapExplorer::SetNativeBindReference(HeapObject* parent_obj,
                                             int parent_entry,
                                             const char* reference_name,
                                             Object* child_obj) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   filler_->SetNamedReference(HeapGraphEdge::kShortcut, parent_entry,
                              reference_name, child_entry);
 }
@@ -1677,9 +2152,9 @@ void V8HeapExplorer::SetElementReference(HeapObject* parent_obj,
                                          int parent_entry,
                                          int index,
                                          Object* child_obj) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   filler_->SetIndexedReference(HeapGraphEdge::kElement, parent_entry, index,
                                child_entry);
 }
@@ -1690,9 +2165,9 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           const char* reference_name,
                                           Object* child_obj,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kInternal,
                                parent_entry,
@@ -1708,9 +2183,9 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
                                           int index,
                                           Object* child_obj,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kInternal,
                                parent_entry,
@@ -1723,9 +2198,9 @@ void V8HeapExplorer::SetInternalReference(HeapObject* parent_obj,
 void V8HeapExplorer::SetHiddenReference(HeapObject* parent_obj,
                                         int parent_entry, int index,
                                         Object* child_obj, int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry != nullptr && IsEssentialObject(child_obj) &&
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry != HeapEntry::kNoEntry && IsEssentialObject(child_obj) &&
       IsEssentialHiddenReference(parent_obj, field_offset)) {
     filler_->SetIndexedReference(HeapGraphEdge::kHidden, parent_entry, index,
                                  child_entry);
@@ -1738,9 +2213,9 @@ void V8HeapExplorer::SetWeakReference(HeapObject* parent_obj,
                                       const char* reference_name,
                                       Object* child_obj,
                                       int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kWeak,
                                parent_entry,
@@ -1756,9 +2231,9 @@ void V8HeapExplorer::SetWeakReference(HeapObject* parent_obj,
                                       int index,
                                       Object* child_obj,
                                       int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   if (IsEssentialObject(child_obj)) {
     filler_->SetNamedReference(HeapGraphEdge::kWeak,
                                parent_entry,
@@ -1788,9 +2263,9 @@ void V8HeapExplorer::SetPropertyReference(HeapObject* parent_obj,
                                           Object* child_obj,
                                           const char* name_format_string,
                                           int field_offset) {
-  DCHECK(parent_entry == GetEntry(parent_obj)->index());
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  DCHECK_EQ(parent_entry, GetEntry(parent_obj));
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   HeapGraphEdge::Type type =
       reference_name->IsSymbol() || String::cast(reference_name)->length() > 0
           ? HeapGraphEdge::kProperty
@@ -1809,30 +2284,29 @@ void V8HeapExplorer::SetPropertyReference(HeapObject* parent_obj,
 }
 
 void V8HeapExplorer::SetRootGcRootsReference() {
-  filler_->SetIndexedAutoIndexReference(
-      HeapGraphEdge::kElement,
-      snapshot_->root()->index(),
-      snapshot_->gc_roots());
+  filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement,
+                                        snapshot_->root()->index(),
+                                        snapshot_->gc_roots()->index());
 }
 
 void V8HeapExplorer::SetUserGlobalReference(Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  DCHECK_NOT_NULL(child_entry);
+  int child_entry = GetEntry(child_obj);
+  DCHECK_NE(child_entry, HeapEntry::kNoEntry);
   filler_->SetNamedAutoIndexReference(HeapGraphEdge::kShortcut,
                                       snapshot_->root()->index(), nullptr,
                                       child_entry);
 }
 
 void V8HeapExplorer::SetGcRootsReference(Root root) {
-  filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement,
-                                        snapshot_->gc_roots()->index(),
-                                        snapshot_->gc_subroot(root));
+  filler_->SetIndexedAutoIndexReference(
+      HeapGraphEdge::kElement, snapshot_->gc_roots()->index(),
+      snapshot_->gc_subroot(root)->index());
 }
 
 void V8HeapExplorer::SetGcSubrootReference(Root root, const char* description,
                                            bool is_weak, Object* child_obj) {
-  HeapEntry* child_entry = GetEntry(child_obj);
-  if (child_entry == nullptr) return;
+  int child_entry = GetEntry(child_obj);
+  if (child_entry == HeapEntry::kNoEntry) return;
   const char* name = GetStrongGcSubrootName(child_obj);
   HeapGraphEdge::Type edge_type =
       is_weak ? HeapGraphEdge::kWeak : HeapGraphEdge::kInternal;
@@ -1903,12 +2377,7 @@ const char* V8HeapExplorer::GetStrongGcSubrootName(Object* object) {
 }
 
 void V8HeapExplorer::TagObject(Object* obj, const char* tag) {
-  if (IsEssentialObject(obj)) {
-    HeapEntry* entry = GetEntry(obj);
-    if (entry->name()[0] == '\0') {
-      entry->set_name(tag);
-    }
-  }
+  if (IsEssentialObject(obj)) filler_->TagEntry(GetEntry(obj), tag);
 }
 
 class GlobalObjectsEnumerator : public RootVisitor {
@@ -2029,7 +2498,7 @@ class BasicHeapEntriesAllocator : public HeapEntriesAllocator {
       HeapSnapshot* snapshot,
       HeapEntry::Type entries_type)
     : snapshot_(snapshot),
-      names_(snapshot_->profiler()->names()),
+      names_(snapshot_->names()),
       heap_object_map_(snapshot_->profiler()->heap_object_map()),
       entries_type_(entries_type) {
   }
@@ -2062,7 +2531,7 @@ class EmbedderGraphEntriesAllocator : public HeapEntriesAllocator {
  public:
   explicit EmbedderGraphEntriesAllocator(HeapSnapshot* snapshot)
       : snapshot_(snapshot),
-        names_(snapshot_->profiler()->names()),
+        names_(snapshot_->names()),
         heap_object_map_(snapshot_->profiler()->heap_object_map()) {}
   virtual HeapEntry* AllocateEntry(HeapThing ptr);
 
@@ -2141,7 +2610,7 @@ NativeObjectsExplorer::NativeObjectsExplorer(
     HeapSnapshot* snapshot, SnapshottingProgressReportingInterface* progress)
     : isolate_(snapshot->profiler()->heap_object_map()->heap()->isolate()),
       snapshot_(snapshot),
-      names_(snapshot_->profiler()->names()),
+      names_(snapshot_->names()),
       embedder_queried_(false),
       native_groups_(0, SeededStringHasher(isolate_->heap()->HashSeed())),
       synthetic_entries_allocator_(
@@ -2209,13 +2678,12 @@ void NativeObjectsExplorer::FillEdges() {
         *pair.first->Get(reinterpret_cast<v8::Isolate*>(isolate_)));
     HeapObject* parent = HeapObject::cast(*parent_object);
     int parent_entry =
-        filler_->FindOrAddEntry(parent, native_entries_allocator_.get())
-            ->index();
+        filler_->FindOrAddEntry(parent, native_entries_allocator_.get());
     DCHECK_NE(parent_entry, HeapEntry::kNoEntry);
     Handle<Object> child_object = v8::Utils::OpenHandle(
         *pair.second->Get(reinterpret_cast<v8::Isolate*>(isolate_)));
     HeapObject* child = HeapObject::cast(*child_object);
-    HeapEntry* child_entry =
+    int child_entry =
         filler_->FindOrAddEntry(child, native_entries_allocator_.get());
     filler_->SetNamedReference(HeapGraphEdge::kInternal, parent_entry, "native",
                                child_entry);
@@ -2234,7 +2702,7 @@ std::vector<HeapObject*>* NativeObjectsExplorer::GetVectorMaybeDisposeInfo(
   return objects_by_info_[info];
 }
 
-HeapEntry* NativeObjectsExplorer::EntryForEmbedderGraphNode(
+int NativeObjectsExplorer::EntryForEmbedderGraphNode(
     EmbedderGraphImpl::Node* node) {
   EmbedderGraphImpl::Node* wrapper = node->WrapperNode();
   if (wrapper) {
@@ -2247,9 +2715,8 @@ HeapEntry* NativeObjectsExplorer::EntryForEmbedderGraphNode(
     EmbedderGraphImpl::V8NodeImpl* v8_node =
         static_cast<EmbedderGraphImpl::V8NodeImpl*>(node);
     Object* object = v8_node->GetObject();
-    if (object->IsSmi()) return nullptr;
-    HeapEntry* entry = filler_->FindEntry(HeapObject::cast(object));
-    return entry;
+    if (object->IsSmi()) return HeapEntry::kNoEntry;
+    return filler_->FindEntry(HeapObject::cast(object));
   }
 }
 
@@ -2272,24 +2739,22 @@ bool NativeObjectsExplorer::IterateAndExtractReferences(
       // Adjust the name and the type of the V8 wrapper node.
       auto wrapper = node->WrapperNode();
       if (wrapper) {
-        HeapEntry* wrapper_entry = EntryForEmbedderGraphNode(wrapper);
-        wrapper_entry->set_name(
+        int wrapper_entry = EntryForEmbedderGraphNode(wrapper);
+        filler_->SetEntryNameAndType(
+            wrapper_entry,
             MergeNames(names_, EmbedderGraphNodeName(names_, node.get()),
-                       wrapper_entry->name()));
-        wrapper_entry->set_type(EmbedderGraphNodeType(node.get()));
+                       filler_->GetEntryName(wrapper_entry)),
+            EmbedderGraphNodeType(node.get()));
       }
     }
     // Fill edges of the graph.
     for (const auto& edge : graph.edges()) {
-      HeapEntry* from = EntryForEmbedderGraphNode(edge.from);
-      // The |from| and |to| can nullptr if the corrsponding node is a V8 node
-      // pointing to a Smi.
-      if (!from) continue;
-      // Adding an entry for |edge.to| can invalidate the |from| entry because
-      // it is an address in std::vector. Use index instead of pointer.
-      int from_index = from->index();
-      HeapEntry* to = EntryForEmbedderGraphNode(edge.to);
-      if (to) {
+      int from_index = EntryForEmbedderGraphNode(edge.from);
+      // The |from| and |to| can be kNoEntry if the corrsponding node is a V8
+      // node pointing to a Smi.
+      if (from_index == HeapEntry::kNoEntry) continue;
+      int to = EntryForEmbedderGraphNode(edge.to);
+      if (to != HeapEntry::kNoEntry) {
         if (edge.name == nullptr) {
           filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement,
                                                 from_index, to);
@@ -2330,34 +2795,28 @@ NativeGroupRetainedObjectInfo* NativeObjectsExplorer::FindOrAddGroupInfo(
 
 void NativeObjectsExplorer::SetNativeRootReference(
     v8::RetainedObjectInfo* info) {
-  HeapEntry* child_entry =
+  int child_entry =
       filler_->FindOrAddEntry(info, native_entries_allocator_.get());
-  DCHECK_NOT_NULL(child_entry);
+  DCHECK_NE(child_entry, HeapEntry::kNoEntry);
   NativeGroupRetainedObjectInfo* group_info =
       FindOrAddGroupInfo(info->GetGroupLabel());
-  HeapEntry* group_entry =
+  int group_entry =
       filler_->FindOrAddEntry(group_info, synthetic_entries_allocator_.get());
-  // |FindOrAddEntry| can move and resize the entries backing store. Reload
-  // potentially-stale pointer.
-  child_entry = filler_->FindEntry(info);
-  filler_->SetNamedAutoIndexReference(
-      HeapGraphEdge::kInternal, group_entry->index(), nullptr, child_entry);
+  filler_->SetNamedAutoIndexReference(HeapGraphEdge::kInternal, group_entry,
+                                      nullptr, child_entry);
 }
 
 
 void NativeObjectsExplorer::SetWrapperNativeReferences(
     HeapObject* wrapper, v8::RetainedObjectInfo* info) {
-  HeapEntry* wrapper_entry = filler_->FindEntry(wrapper);
-  DCHECK_NOT_NULL(wrapper_entry);
-  HeapEntry* info_entry =
+  int wrapper_entry = filler_->FindEntry(wrapper);
+  DCHECK_NE(wrapper_entry, HeapEntry::kNoEntry);
+  int info_entry =
       filler_->FindOrAddEntry(info, native_entries_allocator_.get());
-  DCHECK_NOT_NULL(info_entry);
-  filler_->SetNamedReference(HeapGraphEdge::kInternal,
-                             wrapper_entry->index(),
-                             "native",
+  DCHECK_NE(info_entry, HeapEntry::kNoEntry);
+  filler_->SetNamedReference(HeapGraphEdge::kInternal, wrapper_entry, "native",
                              info_entry);
-  filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement,
-                                        info_entry->index(),
+  filler_->SetIndexedAutoIndexReference(HeapGraphEdge::kElement, info_entry,
                                         wrapper_entry);
 }
 
@@ -2365,13 +2824,11 @@ void NativeObjectsExplorer::SetWrapperNativeReferences(
 void NativeObjectsExplorer::SetRootNativeRootsReference() {
   for (auto map_entry : native_groups_) {
     NativeGroupRetainedObjectInfo* group_info = map_entry.second;
-    HeapEntry* group_entry =
+    int group_entry =
         filler_->FindOrAddEntry(group_info, native_entries_allocator_.get());
-    DCHECK_NOT_NULL(group_entry);
+    DCHECK_NE(group_entry, HeapEntry::kNoEntry);
     filler_->SetIndexedAutoIndexReference(
-        HeapGraphEdge::kElement,
-        snapshot_->root()->index(),
-        group_entry);
+        HeapGraphEdge::kElement, snapshot_->root()->index(), group_entry);
   }
 }
 
@@ -2481,7 +2938,7 @@ void HeapSnapshotGenerator::InitProgressCounter() {
 }
 
 bool HeapSnapshotGenerator::FillReferences() {
-  SnapshotFiller filler(snapshot_, &entries_);
+  HeapSnapshotFiller filler(snapshot_, &entries_);
   return v8_heap_explorer_.IterateAndExtractReferences(&filler) &&
          dom_explorer_.IterateAndExtractReferences(&filler);
 }
@@ -2603,18 +3060,30 @@ void HeapSnapshotJSONSerializer::Serialize(v8::OutputStream* stream) {
 
 void HeapSnapshotJSONSerializer::SerializeImpl() {
   DCHECK_EQ(0, snapshot_->root()->index());
-  writer_->AddCharacter('{');
-  writer_->AddString("\"snapshot\":{");
-  SerializeSnapshot();
+  SerializeHead(snapshot_->entries().size(), snapshot_->edges().size());
   if (writer_->aborted()) return;
-  writer_->AddString("},\n");
-  writer_->AddString("\"nodes\":[");
   SerializeNodes();
   if (writer_->aborted()) return;
   writer_->AddString("],\n");
   writer_->AddString("\"edges\":[");
   SerializeEdges();
   if (writer_->aborted()) return;
+  SerializeTail();
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeHead(size_t node_count,
+                                               size_t edge_count) {
+  writer_->AddCharacter('{');
+  writer_->AddString("\"snapshot\":{");
+  SerializeSnapshot(node_count, edge_count);
+  if (writer_->aborted()) return;
+  writer_->AddString("},\n");
+  writer_->AddString("\"nodes\":[");
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeTail() {
   writer_->AddString("],\n");
 
   writer_->AddString("\"trace_function_infos\":[");
@@ -2640,7 +3109,13 @@ void HeapSnapshotJSONSerializer::SerializeImpl() {
 }
 
 
+void HeapSnapshotJSONSerializer::UseStringCache() {
+  string_cache_.reset(new CachedString[kStringCacheSize]());
+}
+
+
 int HeapSnapshotJSONSerializer::GetStringId(const char* s) {
+  if (string_cache_) return GetCachedStringId(s);
   base::HashMap::Entry* cache_entry =
       strings_.LookupOrInsert(const_cast<char*>(s), StringHash(s));
   if (cache_entry->value == nullptr) {
@@ -2650,6 +3125,19 @@ int HeapSnapshotJSONSerializer::GetStringId(const char* s) {
 }
 
 
+int HeapSnapshotJSONSerializer::GetCachedStringId(const char* s) {
+  CachedString& cached =
+      string_cache_[StringHash(s) & (kStringCacheSize - 1)];
+  if (cached.string == nullptr ||
+      (cached.string != s && strcmp(cached.string, s) != 0)) {
+    cached.string = s;
+    cached.id = next_string_id_++;
+    cached_strings_.push_back(s);
+  }
+  return cached.id;
+}
+
+
 namespace {
 
 template<size_t size> struct ToUnsigned;
@@ -2695,22 +3183,30 @@ static int utoa(T value, const Vector<char>& buffer, int buffer_pos) {
 
 void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge* edge,
                                                bool first_edge) {
+  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
+      || edge->type() == HeapGraphEdge::kHidden
+      ? edge->index() : GetStringId(edge->name());
+  SerializeEdge(edge->type(), edge_name_or_index, edge->to()->index(),
+                first_edge);
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeEdge(HeapGraphEdge::Type type,
+                                               int name_or_index, int to,
+                                               bool first_edge) {
   // The buffer needs space for 3 unsigned ints, 3 commas, \n and \0
   static const int kBufferSize =
       MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned * 3 + 3 + 2;  // NOLINT
   EmbeddedVector<char, kBufferSize> buffer;
-  int edge_name_or_index = edge->type() == HeapGraphEdge::kElement
-      || edge->type() == HeapGraphEdge::kHidden
-      ? edge->index() : GetStringId(edge->name());
   int buffer_pos = 0;
   if (!first_edge) {
     buffer[buffer_pos++] = ',';
   }
-  buffer_pos = utoa(edge->type(), buffer, buffer_pos);
+  buffer_pos = utoa(type, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(edge_name_or_index, buffer, buffer_pos);
+  buffer_pos = utoa(name_or_index, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry_index(edge->to()), buffer, buffer_pos);
+  buffer_pos = utoa(to * kNodeFieldsCount, buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
   buffer[buffer_pos++] = '\0';
   writer_->AddString(buffer.start());
@@ -2728,6 +3224,13 @@ void HeapSnapshotJSONSerializer::SerializeEdges() {
 }
 
 void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
+  SerializeNode(entry, entry->children_count(), entry_index(entry) == 0);
+}
+
+
+void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry,
+                                               int edge_count,
+                                               bool first_node) {
   // The buffer needs space for 4 unsigned ints, 1 size_t, 5 commas, \n and \0
   static const int kBufferSize =
       5 * MaxDecimalDigitsIn<sizeof(unsigned)>::kUnsigned  // NOLINT
@@ -2735,7 +3238,7 @@ void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
       + 6 + 1 + 1;
   EmbeddedVector<char, kBufferSize> buffer;
   int buffer_pos = 0;
-  if (entry_index(entry) != 0) {
+  if (!first_node) {
     buffer[buffer_pos++] = ',';
   }
   buffer_pos = utoa(entry->type(), buffer, buffer_pos);
@@ -2746,7 +3249,7 @@ void HeapSnapshotJSONSerializer::SerializeNode(const HeapEntry* entry) {
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->self_size(), buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
-  buffer_pos = utoa(entry->children_count(), buffer, buffer_pos);
+  buffer_pos = utoa(edge_count, buffer, buffer_pos);
   buffer[buffer_pos++] = ',';
   buffer_pos = utoa(entry->trace_node_id(), buffer, buffer_pos);
   buffer[buffer_pos++] = '\n';
@@ -2764,7 +3267,8 @@ void HeapSnapshotJSONSerializer::SerializeNodes() {
 }
 
 
-void HeapSnapshotJSONSerializer::SerializeSnapshot() {
+void HeapSnapshotJSONSerializer::SerializeSnapshot(size_t node_count,
+                                                   size_t edge_count) {
   writer_->AddString("\"meta\":");
   // The object describing node serialization layout.
   // We use a set of macros to improve readability.
@@ -2836,9 +3340,9 @@ void HeapSnapshotJSONSerializer::SerializeSnapshot() {
 #undef JSON_O
 #undef JSON_A
   writer_->AddString(",\"node_count\":");
-  writer_->AddNumber(static_cast<unsigned>(snapshot_->entries().size()));
+  writer_->AddNumber(static_cast<unsigned>(node_count));
   writer_->AddString(",\"edge_count\":");
-  writer_->AddNumber(static_cast<double>(snapshot_->edges().size()));
+  writer_->AddNumber(static_cast<double>(edge_count));
   writer_->AddString(",\"trace_function_count\":");
   uint32_t count = 0;
   AllocationTracker* tracker = snapshot_->profiler()->allocation_tracker();
@@ -3023,6 +3527,15 @@ void HeapSnapshotJSONSerializer::SerializeString(const unsigned char* s) {
 
 
 void HeapSnapshotJSONSerializer::SerializeStrings() {
+  if (string_cache_) {
+    writer_->AddString("\"<dummy>\"");
+    for (const char* s : cached_strings_) {
+      writer_->AddCharacter(',');
+      SerializeString(reinterpret_cast<const unsigned char*>(s));
+      if (writer_->aborted()) return;
+    }
+    return;
+  }
   ScopedVector<const unsigned char*> sorted_strings(
       strings_.occupancy() + 1);
   for (base::HashMap::Entry* entry = strings_.Start(); entry != nullptr;
@@ -3039,5 +3552,337 @@ void HeapSnapshotJSONSerializer::SerializeStrings() {
 }
 
 
+HeapSnapshotStreamer::HeapSnapshotStreamer(
+    HeapProfiler* profiler, v8::ActivityControl* control,
+    v8::HeapProfiler::ObjectNameResolver* resolver, Heap* heap)
+    : snapshot_(profiler, &names_),
+      control_(control),
+      v8_heap_explorer_(&snapshot_, this, resolver),
+      dom_explorer_(&snapshot_, this),
+      serializer_(&snapshot_),
+      next_reference_(0),
+      pass_(Pass::kCollect),
+      current_entry_(HeapEntry::kNoEntry),
+      current_references_count_(0),
+      edge_count_(0),
+      written_edge_count_(0),
+      progress_counter_(0),
+      progress_total_(0),
+      heap_(heap) {}
+
+HeapSnapshotStreamer::~HeapSnapshotStreamer() {}
+
+bool HeapSnapshotStreamer::StreamSnapshot(v8::OutputStream* stream) {
+  DCHECK(!objects_index_);
+  v8_heap_explorer_.TagGlobalObjects();
+
+  // See HeapSnapshotGenerator::GenerateSnapshot().
+  heap_->CollectAllGarbage(Heap::kMakeHeapIterableMask,
+                           GarbageCollectionReason::kHeapProfiler);
+  heap_->CollectAllGarbage(Heap::kMakeHeapIterableMask,
+                           GarbageCollectionReason::kHeapProfiler);
+
+  NullContextScope null_context_scope(heap_->isolate());
+
+  // The embedder is queried for its objects, and the allocation traces are
+  // resolved, before the heap is indexed, as both can allocate.
+  int native_objects_count = dom_explorer_.EstimateObjectsCount();
+  if (AllocationTracker* allocation_tracker =
+          snapshot_.profiler()->allocation_tracker()) {
+    allocation_tracker->PrepareForSerialization();
+  }
+
+  DisallowHeapAllocation no_allocation;
+  snapshot_.AddSyntheticRootEntries();
+  objects_index_.reset(new HeapObjectsIndex(
+      heap_, snapshot_.profiler()->heap_object_map(),
+      static_cast<int>(snapshot_.entries().size())));
+  // The +1 ensures that only the final ProgressReport() signals that the work
+  // is finished, see HeapSnapshotGenerator::InitProgressCounter().
+  progress_total_ = 3 * objects_index_->size() + native_objects_count + 1;
+  v8_heap_explorer_.filler_ = this;
+  v8_heap_explorer_.objects_index_ = objects_index_.get();
+  v8_heap_explorer_.string_names_budget_ =
+      heap_->SizeOfObjects() / kNamesHeapFraction;
+
+  OutputStreamWriter writer(stream);
+  serializer_.writer_ = &writer;
+  serializer_.UseStringCache();
+  bool completed = WriteSnapshot();
+  serializer_.writer_ = nullptr;
+  v8_heap_explorer_.filler_ = nullptr;
+  v8_heap_explorer_.objects_index_ = nullptr;
+  if (!completed) return false;
+
+  progress_counter_ = progress_total_;
+  return ProgressReport(true);
+}
+
+bool HeapSnapshotStreamer::WriteSnapshot() {
+  // Count the edges, and collect the references that are not found while
+  // their parent is being extracted.
+  v8_heap_explorer_.ExtractRootReferences();
+  if (!IterateHeap(Pass::kCollect)) return false;
+  if (!dom_explorer_.IterateAndExtractReferences(this)) return false;
+  std::stable_sort(references_.begin(), references_.end(),
+                   [](const Reference& a, const Reference& b) {
+                     return a.parent < b.parent;
+                   });
+  edge_count_ += references_.size();
+
+  int heap_start = objects_index_->first_index();
+  int heap_end = heap_start + objects_index_->size();
+  int entries_end = static_cast<int>(snapshot_.entries().size()) +
+                    objects_index_->size();
+  serializer_.SerializeHead(entries_end, edge_count_);
+  if (serializer_.writer_->aborted()) return false;
+
+  next_reference_ = 0;
+  for (int entry = 0; entry < heap_start; entry++) {
+    WriteNode(GetOtherEntry(entry), entry, CountCollectedReferences(entry));
+  }
+  if (!IterateHeap(Pass::kWriteNodes)) return false;
+  for (int entry = heap_end; entry < entries_end; entry++) {
+    WriteNode(GetOtherEntry(entry), entry, CountCollectedReferences(entry));
+  }
+  if (serializer_.writer_->aborted()) return false;
+  serializer_.writer_->AddString("],\n");
+  serializer_.writer_->AddString("\"edges\":[");
+
+  next_reference_ = 0;
+  for (int entry = 0; entry < heap_start; entry++) {
+    WriteCollectedReferences(entry);
+  }
+  if (!IterateHeap(Pass::kWriteEdges)) return false;
+  for (int entry = heap_end; entry < entries_end; entry++) {
+    WriteCollectedReferences(entry);
+  }
+  DCHECK_EQ(references_.size(), next_reference_);
+  DCHECK_EQ(edge_count_, written_edge_count_);
+  if (serializer_.writer_->aborted()) return false;
+
+  serializer_.SerializeTail();
+  return !serializer_.writer_->aborted();
+}
+
+bool HeapSnapshotStreamer::IterateHeap(Pass pass) {
+  pass_ = pass;
+  int entry = objects_index_->first_index();
+  HeapIterator iterator(heap_);
+  for (HeapObject* obj = iterator.next(); obj != nullptr;
+       obj = iterator.next(), entry++, ProgressStep()) {
+    DCHECK_EQ(entry, objects_index_->Lookup(obj->address()));
+    current_entry_ = entry;
+    current_references_count_ = 0;
+    v8_heap_explorer_.ExtractObjectReferences(obj);
+    if (pass == Pass::kWriteNodes) {
+      HeapEntry* heap_entry = AddHeapEntry(entry);
+      WriteNode(heap_entry, entry,
+                current_references_count_ + CountCollectedReferences(entry));
+      snapshot_.entries().pop_back();
+    } else if (pass == Pass::kWriteEdges) {
+      WriteCollectedReferences(entry);
+    }
+    if (pass != Pass::kCollect && serializer_.writer_->aborted()) break;
+    if (!ProgressReport()) break;
+  }
+  current_entry_ = HeapEntry::kNoEntry;
+  return entry == objects_index_->first_index() + objects_index_->size();
+}
+
+bool HeapSnapshotStreamer::IsHeapEntry(int entry) const {
+  return entry >= objects_index_->first_index() &&
+         entry < objects_index_->first_index() + objects_index_->size();
+}
+
+HeapEntry* HeapSnapshotStreamer::GetOtherEntry(int entry) {
+  DCHECK(!IsHeapEntry(entry));
+  if (entry >= objects_index_->first_index()) entry -= objects_index_->size();
+  return &snapshot_.entries()[entry];
+}
+
+HeapEntry* HeapSnapshotStreamer::AddHeapEntry(int entry) {
+  HeapEntry* heap_entry = v8_heap_explorer_.AllocateEntry(
+      HeapObject::FromAddress(objects_index_->Get(entry)));
+  auto name_and_type = names_and_types_.find(entry);
+  if (name_and_type != names_and_types_.end()) {
+    heap_entry->set_name(name_and_type->second.first);
+    heap_entry->set_type(name_and_type->second.second);
+  }
+  auto tag = tags_.find(entry);
+  if (tag != tags_.end() && heap_entry->name()[0] == '\0') {
+    heap_entry->set_name(tag->second);
+  }
+  return heap_entry;
+}
+
+int HeapSnapshotStreamer::FindEntry(HeapThing ptr) {
+  int entry =
+      objects_index_->Lookup(reinterpret_cast<Address>(ptr) - kHeapObjectTag);
+  return entry != HeapEntry::kNoEntry ? entry : entries_.Map(ptr);
+}
+
+int HeapSnapshotStreamer::FindOrAddEntry(HeapThing ptr,
+                                         HeapEntriesAllocator* allocator) {
+  int entry = FindEntry(ptr);
+  if (entry != HeapEntry::kNoEntry) return entry;
+  // All heap objects are in the index, and the other entries are added in
+  // the first pass.
+  DCHECK(allocator != &v8_heap_explorer_);
+  DCHECK(pass_ == Pass::kCollect);
+  entry = allocator->AllocateEntry(ptr)->index() + objects_index_->size();
+  entries_.Pair(ptr, entry);
+  return entry;
+}
+
+const char* HeapSnapshotStreamer::GetEntryName(int entry) {
+  if (!IsHeapEntry(entry)) return GetOtherEntry(entry)->name();
+  const char* name = AddHeapEntry(entry)->name();
+  snapshot_.entries().pop_back();
+  return name;
+}
+
+void HeapSnapshotStreamer::TagEntry(int entry, const char* tag) {
+  if (!IsHeapEntry(entry)) {
+    HeapEntry* other_entry = GetOtherEntry(entry);
+    if (other_entry->name()[0] == '\0') other_entry->set_name(tag);
+    return;
+  }
+  // The heap objects are written in heap order, so only the tags given
+  // before the heap is traversed can be applied.
+  if (pass_ == Pass::kCollect && current_entry_ == HeapEntry::kNoEntry) {
+    tags_.emplace(entry, tag);
+  }
+}
+
+void HeapSnapshotStreamer::SetEntryNameAndType(int entry, const char* name,
+                                               HeapEntry::Type type) {
+  if (!IsHeapEntry(entry)) {
+    HeapEntry* other_entry = GetOtherEntry(entry);
+    other_entry->set_name(name);
+    other_entry->set_type(type);
+    return;
+  }
+  DCHECK(pass_ == Pass::kCollect);
+  names_and_types_[entry] = std::make_pair(name, type);
+}
+
+void HeapSnapshotStreamer::SetIndexedReference(HeapGraphEdge::Type type,
+                                               int parent, int index,
+                                               int child) {
+  AddReference(type, parent, index, nullptr, child);
+}
+
+void HeapSnapshotStreamer::SetIndexedAutoIndexReference(
+    HeapGraphEdge::Type type, int parent, int child) {
+  AddReference(type, parent, NextAutoIndex(parent), nullptr, child);
+}
+
+void HeapSnapshotStreamer::SetNamedReference(HeapGraphEdge::Type type,
+                                             int parent,
+                                             const char* reference_name,
+                                             int child) {
+  AddReference(type, parent, 0, reference_name, child);
+}
+
+void HeapSnapshotStreamer::SetNamedAutoIndexReference(HeapGraphEdge::Type type,
+                                                      int parent,
+                                                      const char* description,
+                                                      int child) {
+  StringsStorage* names = snapshot_.names();
+  int index = NextAutoIndex(parent);
+  const char* name = description
+                         ? names->GetFormatted("%d / %s", index, description)
+                         : names->GetName(index);
+  AddReference(type, parent, 0, name, child);
+}
+
+int HeapSnapshotStreamer::NextAutoIndex(int parent) {
+  if (parent == current_entry_) return current_references_count_ + 1;
+  auto count = references_counts_.find(parent);
+  return (count != references_counts_.end() ? count->second : 0) + 1;
+}
+
+void HeapSnapshotStreamer::AddReference(HeapGraphEdge::Type type, int parent,
+                                        int index, const char* name,
+                                        int child) {
+  if (parent == current_entry_) {
+    current_references_count_++;
+    if (pass_ == Pass::kCollect) edge_count_++;
+    if (pass_ == Pass::kWriteEdges) WriteEdge(type, index, name, child);
+    return;
+  }
+  // The other references are collected in the first pass and written along
+  // with their parent.
+  if (pass_ != Pass::kCollect) return;
+  references_.push_back({parent, child, type, index, name});
+  references_counts_[parent]++;
+}
+
+void HeapSnapshotStreamer::WriteNode(HeapEntry* entry, int index,
+                                     int edge_count) {
+  serializer_.SerializeNode(entry, edge_count, index == 0);
+}
+
+void HeapSnapshotStreamer::WriteEdge(HeapGraphEdge::Type type, int index,
+                                     const char* name, int child) {
+  int name_or_index =
+      type == HeapGraphEdge::kElement || type == HeapGraphEdge::kHidden
+          ? index
+          : serializer_.GetStringId(name);
+  serializer_.SerializeEdge(type, name_or_index, child,
+                            written_edge_count_++ == 0);
+}
+
+int HeapSnapshotStreamer::CountCollectedReferences(int parent) {
+  int count = 0;
+  for (; next_reference_ < references_.size() &&
+         references_[next_reference_].parent == parent;
+       next_reference_++) {
+    count++;
+  }
+  return count;
+}
+
+void HeapSnapshotStreamer::WriteCollectedReferences(int parent) {
+  for (; next_reference_ < references_.size() &&
+         references_[next_reference_].parent == parent;
+       next_reference_++) {
+    const Reference& reference = references_[next_reference_];
+    WriteEdge(reference.type, reference.index, reference.name,
+              reference.child);
+  }
+}
+
+void HeapSnapshotStreamer::ProgressStep() { ++progress_counter_; }
+
+bool HeapSnapshotStreamer::ProgressReport(bool force) {
+  const int kProgressReportGranularity = 10000;
+  if (control_ != nullptr &&
+      (force || progress_counter_ % kProgressReportGranularity == 0)) {
+    return control_->ReportProgressValue(progress_counter_, progress_total_) ==
+           v8::ActivityControl::kContinue;
+  }
+  return true;
+}
+
+size_t HeapSnapshotStreamer::memory_usage() {
+  size_t size = sizeof(*this) +
+                snapshot_.entries().capacity() * sizeof(HeapEntry) +
+                entries_.memory_usage() +
+                references_.capacity() * sizeof(Reference) +
+                UnorderedMapMemoryUsage(references_counts_) +
+                UnorderedMapMemoryUsage(tags_) +
+                UnorderedMapMemoryUsage(names_and_types_) +
+                serializer_.cached_strings_.capacity() * sizeof(const char*) +
+                names_.GetUsedMemorySize();
+  if (objects_index_) size += objects_index_->memory_usage();
+  if (serializer_.string_cache_) {
+    size += HeapSnapshotJSONSerializer::kStringCacheSize *
+            sizeof(HeapSnapshotJSONSerializer::CachedString);
+  }
+  return size;
+}
+
 }  // namespace internal
 }  // namespace v8
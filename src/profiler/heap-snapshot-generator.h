@@ -6,6 +6,7 @@
 #define V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
 
 #include <deque>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
@@ -31,7 +32,7 @@ class HeapSnapshot;
 class JSArrayBuffer;
 class JSCollection;
 class JSWeakCollection;
-class SnapshotFiller;
+class MemoryChunk;
 
 class HeapGraphEdge BASE_EMBEDDED {
  public:
@@ -161,10 +162,14 @@ class HeapEntry BASE_EMBEDDED {
 // HeapSnapshotGenerator fills in a HeapSnapshot.
 class HeapSnapshot {
  public:
-  explicit HeapSnapshot(HeapProfiler* profiler);
+  // The names of the entries and edges are kept in |names|, by default in the
+  // storage of the heap profiler, which keeps them until it is torn down.
+  explicit HeapSnapshot(HeapProfiler* profiler,
+                        StringsStorage* names = nullptr);
   void Delete();
 
   HeapProfiler* profiler() { return profiler_; }
+  StringsStorage* names() { return names_; }
   HeapEntry* root() { return &entries_[root_index_]; }
   HeapEntry* gc_roots() { return &entries_[gc_roots_index_]; }
   HeapEntry* gc_subroot(Root root) {
@@ -196,6 +201,7 @@ class HeapSnapshot {
   HeapEntry* AddGcSubrootEntry(Root root, SnapshotObjectId id);
 
   HeapProfiler* profiler_;
+  StringsStorage* names_;
   int root_index_;
   int gc_roots_index_;
   int gc_subroot_indexes_[static_cast<int>(Root::kNumberOfRoots)];
@@ -236,6 +242,9 @@ class HeapObjectsMap {
   SnapshotObjectId last_assigned_id() const {
     return next_id_ - kObjectIdStep;
   }
+  // Reserves ids for {count} objects without adding them to the map and
+  // returns the first one.
+  SnapshotObjectId ReserveIds(int count);
 
   void StopHeapObjectsTracking();
   SnapshotObjectId PushHeapObjectsStats(OutputStream* stream,
@@ -285,6 +294,34 @@ class HeapEntriesAllocator {
   virtual HeapEntry* AllocateEntry(HeapThing ptr) = 0;
 };
 
+// An interface through which the explorers add entries and references to a
+// snapshot. Entries are identified by their index in the snapshot.
+class SnapshotFiller {
+ public:
+  virtual ~SnapshotFiller() {}
+  virtual int FindEntry(HeapThing ptr) = 0;
+  virtual int FindOrAddEntry(HeapThing ptr,
+                             HeapEntriesAllocator* allocator) = 0;
+  virtual const char* GetEntryName(int entry) = 0;
+  // Names the entry with {tag} unless it already has a name.
+  virtual void TagEntry(int entry, const char* tag) = 0;
+  virtual void SetEntryNameAndType(int entry, const char* name,
+                                   HeapEntry::Type type) = 0;
+  virtual void SetIndexedReference(HeapGraphEdge::Type type, int parent,
+                                   int index, int child) = 0;
+  virtual void SetIndexedAutoIndexReference(HeapGraphEdge::Type type,
+                                            int parent, int child) = 0;
+  virtual void SetNamedReference(HeapGraphEdge::Type type, int parent,
+                                 const char* reference_name, int child) = 0;
+  virtual void SetNamedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                          const char* description,
+                                          int child) = 0;
+  // Adds the internal reference from the key of a WeakMap entry to its value.
+  // The reference is named after the key, which needs to be tagged by then.
+  virtual void SetEphemeronReference(StringsStorage* names, int key,
+                                     int value);
+};
+
 // The HeapEntriesMap instance is used to track a mapping between
 // real heap objects and their representations in heap snapshots.
 class HeapEntriesMap {
@@ -293,6 +330,9 @@ class HeapEntriesMap {
 
   int Map(HeapThing thing);
   void Pair(HeapThing thing, int entry);
+  size_t memory_usage() const {
+    return entries_.capacity() * sizeof(base::HashMap::Entry);
+  }
 
  private:
   static uint32_t Hash(HeapThing thing) {
@@ -333,6 +373,52 @@ class SnapshottingProgressReportingInterface {
 };
 
 
+// Numbers the objects of the heap densely in heap iteration order. The index
+// keeps one bit per word of every page that holds objects, plus a running
+// count of the objects before every 64 words, i.e. about 1/40 of the heap
+// size on 64-bit platforms.
+class HeapObjectsIndex {
+ public:
+  // Indexes the objects that are in the heap now. The objects get the
+  // indexes starting with {first_index}, and the ids reserved in {ids}.
+  HeapObjectsIndex(Heap* heap, HeapObjectsMap* ids, int first_index);
+
+  int first_index() const { return first_index_; }
+  int size() const { return size_; }
+
+  // Returns the index of the object starting at {address}, or
+  // HeapEntry::kNoEntry if no object of the heap starts there.
+  int Lookup(Address address) const;
+  // Returns the address of the object with the given index.
+  Address Get(int index) const;
+  // Returns the id reserved for the object starting at {address}, or 0.
+  SnapshotObjectId GetObjectId(Address address) const;
+
+  size_t memory_usage() const;
+
+ private:
+  struct PageIndex {
+    Address area_start;
+    int first_index;
+    // One bit per word of the page, set for the words that start an object.
+    std::vector<uint64_t> starts;
+    // The number of objects that start before each element of {starts}.
+    std::vector<uint32_t> counts;
+  };
+
+  void AddPage(MemoryChunk* chunk, const std::vector<uint32_t>& offsets);
+  const PageIndex* FindPage(Address address) const;
+
+  int first_index_;
+  int size_;
+  SnapshotObjectId first_id_;
+  std::vector<PageIndex> pages_;
+  std::unordered_map<Address, size_t> pages_by_chunk_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapObjectsIndex);
+};
+
+
 // An implementation of V8 heap graph extractor.
 class V8HeapExplorer : public HeapEntriesAllocator {
  public:
@@ -354,6 +440,14 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   static String* GetConstructorName(JSObject* object);
 
  private:
+  // Creates an explorer that extracts references on a worker thread for
+  // {explorer}. It adds the entries of non-heap things to {scratch}, without
+  // ids, so that they can be copied to the snapshot of {explorer}.
+  V8HeapExplorer(V8HeapExplorer* explorer, HeapSnapshot* scratch);
+
+  void ExtractRootReferences();
+  void ExtractObjectReferences(HeapObject* obj);
+  bool ExtractReferencesInParallel();
   void MarkVisitedField(int offset);
 
   HeapEntry* AddEntry(HeapObject* object);
@@ -457,7 +551,7 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   const char* GetStrongGcSubrootName(Object* object);
   void TagObject(Object* obj, const char* tag);
 
-  HeapEntry* GetEntry(Object* obj);
+  int GetEntry(Object* obj);
 
   Heap* heap_;
   HeapSnapshot* snapshot_;
@@ -469,10 +563,17 @@ class V8HeapExplorer : public HeapEntriesAllocator {
   HeapObjectsSet strong_gc_subroot_names_;
   HeapObjectsSet user_roots_;
   v8::HeapProfiler::ObjectNameResolver* global_object_name_resolver_;
+  // Set while streaming a snapshot, see HeapSnapshotStreamer.
+  const HeapObjectsIndex* objects_index_;
+  // Strings are named by their contents only while |names_| takes less
+  // memory than this.
+  size_t string_names_budget_;
 
   std::vector<bool> visited_fields_;
 
+  friend class HeapSnapshotStreamer;
   friend class IndexedReferencesExtractor;
+  friend class ReferencesExtractionTask;
   friend class RootsReferencesExtractor;
 
   DISALLOW_COPY_AND_ASSIGN(V8HeapExplorer);
@@ -516,7 +617,7 @@ class NativeObjectsExplorer {
 
   NativeGroupRetainedObjectInfo* FindOrAddGroupInfo(const char* label);
 
-  HeapEntry* EntryForEmbedderGraphNode(EmbedderGraph::Node* node);
+  int EntryForEmbedderGraphNode(EmbedderGraph::Node* node);
 
   Isolate* isolate_;
   HeapSnapshot* snapshot_;
@@ -592,14 +693,24 @@ class HeapSnapshotJSONSerializer {
 
   V8_INLINE static uint32_t StringHash(const void* string);
 
+  // Makes GetStringId() deduplicate the strings with a fixed-size cache
+  // rather than a map of all strings, so the same string can get several
+  // ids.
+  void UseStringCache();
   int GetStringId(const char* s);
+  int GetCachedStringId(const char* s);
   V8_INLINE int entry_index(const HeapEntry* e);
   void SerializeEdge(HeapGraphEdge* edge, bool first_edge);
+  void SerializeEdge(HeapGraphEdge::Type type, int name_or_index, int to,
+                     bool first_edge);
   void SerializeEdges();
   void SerializeImpl();
+  void SerializeHead(size_t node_count, size_t edge_count);
+  void SerializeTail();
   void SerializeNode(const HeapEntry* entry);
+  void SerializeNode(const HeapEntry* entry, int edge_count, bool first_node);
   void SerializeNodes();
-  void SerializeSnapshot();
+  void SerializeSnapshot(size_t node_count, size_t edge_count);
   void SerializeTraceTree();
   void SerializeTraceNode(AllocationTraceNode* node);
   void SerializeTraceNodeInfos();
@@ -610,19 +721,154 @@ class HeapSnapshotJSONSerializer {
   static const int kEdgeFieldsCount;
   static const int kNodeFieldsCount;
 
+  struct CachedString {
+    const char* string;
+    int id;
+  };
+  static const int kStringCacheSize = 1 << 16;
+
   HeapSnapshot* snapshot_;
   base::CustomMatcherHashMap strings_;
   int next_node_id_;
   int next_string_id_;
   OutputStreamWriter* writer_;
+  std::unique_ptr<CachedString[]> string_cache_;
+  // The strings of the cache by id, starting with id 1.
+  std::vector<const char*> cached_strings_;
 
   friend class HeapSnapshotJSONSerializerEnumerator;
   friend class HeapSnapshotJSONSerializerIterator;
+  friend class HeapSnapshotStreamer;
 
   DISALLOW_COPY_AND_ASSIGN(HeapSnapshotJSONSerializer);
 };
 
 
+// Generates a heap snapshot and writes it to a stream in the format of
+// HeapSnapshotJSONSerializer, without building the graph in memory.
+//
+// The format lists all nodes before all edges, so the heap is traversed three
+// times: to count the edges, to write the nodes, and to write the edges. The
+// heap objects are numbered by a HeapObjectsIndex. The references that are
+// not found while their parent is being extracted, i.e. the references from
+// the synthetic and native entries and the ephemeron edges, are collected in
+// the first traversal. Strings are deduplicated by a fixed-size cache. The
+// memory needed besides the index thus grows with the number of roots and
+// native objects rather than with the size of the heap.
+//
+// Unlike HeapSnapshotGenerator, the streamer includes unreachable objects,
+// and names the heap objects only by what they are rather than by what
+// refers to them, e.g. "(object properties)", except for the names given
+// while extracting the roots and the native objects. The names are kept by
+// the streamer rather than the heap profiler, and once they reach their
+// share of the heap size, strings are named "(string)" instead of by their
+// contents.
+class HeapSnapshotStreamer : public SnapshottingProgressReportingInterface,
+                             public SnapshotFiller {
+ public:
+  HeapSnapshotStreamer(HeapProfiler* profiler, v8::ActivityControl* control,
+                       v8::HeapProfiler::ObjectNameResolver* resolver,
+                       Heap* heap);
+  ~HeapSnapshotStreamer() override;
+
+  // Returns false if the snapshot was aborted, in which case the stream is
+  // left incomplete.
+  bool StreamSnapshot(v8::OutputStream* stream);
+
+  // The memory used for the last snapshot, including the names.
+  size_t memory_usage();
+
+  // SnapshotFiller implementation.
+  int FindEntry(HeapThing ptr) override;
+  int FindOrAddEntry(HeapThing ptr, HeapEntriesAllocator* allocator) override;
+  const char* GetEntryName(int entry) override;
+  void TagEntry(int entry, const char* tag) override;
+  void SetEntryNameAndType(int entry, const char* name,
+                           HeapEntry::Type type) override;
+  void SetIndexedReference(HeapGraphEdge::Type type, int parent, int index,
+                           int child) override;
+  void SetIndexedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                    int child) override;
+  void SetNamedReference(HeapGraphEdge::Type type, int parent,
+                         const char* reference_name, int child) override;
+  void SetNamedAutoIndexReference(HeapGraphEdge::Type type, int parent,
+                                  const char* description,
+                                  int child) override;
+
+ private:
+  enum class Pass { kCollect, kWriteNodes, kWriteEdges };
+
+  // The names are given at most 1/kNamesHeapFraction of the heap size. Past
+  // that, strings are no longer named by their contents.
+  static const size_t kNamesHeapFraction = 32;
+
+  struct Reference {
+    int parent;
+    int child;
+    HeapGraphEdge::Type type;
+    int index;
+    const char* name;
+  };
+
+  void ProgressStep() override;
+  bool ProgressReport(bool force = false) override;
+
+  bool WriteSnapshot();
+  // Extracts the references of all heap objects.
+  bool IterateHeap(Pass pass);
+  bool IsHeapEntry(int entry) const;
+  // Returns the synthetic or native entry from |snapshot_|.
+  HeapEntry* GetOtherEntry(int entry);
+  // Adds the entry of a heap object to the end of |snapshot_|, where it has
+  // to be removed from after use.
+  HeapEntry* AddHeapEntry(int entry);
+  int NextAutoIndex(int parent);
+  void AddReference(HeapGraphEdge::Type type, int parent, int index,
+                    const char* name, int child);
+  void WriteNode(HeapEntry* entry, int index, int edge_count);
+  void WriteEdge(HeapGraphEdge::Type type, int index, const char* name,
+                 int child);
+  // The collected references of |parent| must be counted or written in the
+  // order of the parents.
+  int CountCollectedReferences(int parent);
+  void WriteCollectedReferences(int parent);
+
+  // The names of the snapshot. They have to live until the strings are
+  // written at the end, but not longer.
+  StringsStorage names_;
+  // Holds the synthetic and the native entries. The native entries come
+  // after the heap objects in the snapshot.
+  HeapSnapshot snapshot_;
+  v8::ActivityControl* control_;
+  V8HeapExplorer v8_heap_explorer_;
+  NativeObjectsExplorer dom_explorer_;
+  HeapSnapshotJSONSerializer serializer_;
+  std::unique_ptr<HeapObjectsIndex> objects_index_;
+  // Mapping from the native HeapThing pointers to their entries.
+  HeapEntriesMap entries_;
+  // The collected references, sorted by parent after the first pass.
+  std::vector<Reference> references_;
+  size_t next_reference_;
+  std::unordered_map<int, int> references_counts_;
+  // The names given to heap objects while extracting the roots and the
+  // native objects.
+  std::unordered_map<int, const char*> tags_;
+  std::unordered_map<int, std::pair<const char*, HeapEntry::Type>>
+      names_and_types_;
+  Pass pass_;
+  // The heap object whose references are being extracted, if any.
+  int current_entry_;
+  int current_references_count_;
+  size_t edge_count_;
+  size_t written_edge_count_;
+  int progress_counter_;
+  int progress_total_;
+  Heap* heap_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStreamer);
+};
+
+
 }  // namespace internal
 }  // namespace v8
 
@@ -4,6 +4,8 @@
 
 #include "src/profiler/profile-generator.h"
 
+#include <algorithm>
+
 #include "src/base/adapters.h"
 #include "src/debug/debug.h"
 #include "src/deoptimizer.h"
@@ -511,6 +513,139 @@ void CpuProfile::Print() {
   top_down_.Print();
 }
 
+namespace {
+
+// The approximate memory used by a distinct stack: the hash map node, the
+// vector and the count, besides the function ids.
+const size_t kStackOverhead =
+    sizeof(std::vector<unsigned>) + sizeof(int64_t) + 4 * sizeof(void*);
+
+}  // namespace
+
+ContinuousProfile::FunctionKey::FunctionKey(const CodeEntry* entry)
+    : script_id(entry->script_id()),
+      position(entry->position()),
+      name(entry->name()),
+      resource_name(entry->resource_name()),
+      line_number(entry->line_number()) {}
+
+bool ContinuousProfile::FunctionKey::operator==(
+    const FunctionKey& other) const {
+  if (script_id != v8::UnboundScript::kNoScriptId) {
+    return script_id == other.script_id && position == other.position;
+  }
+  return other.script_id == v8::UnboundScript::kNoScriptId &&
+         name == other.name && resource_name == other.resource_name &&
+         line_number == other.line_number;
+}
+
+std::size_t ContinuousProfile::FunctionKeyHasher::operator()(
+    const FunctionKey& key) const {
+  if (key.script_id != v8::UnboundScript::kNoScriptId) {
+    return ComputeIntegerHash(static_cast<uint32_t>(key.script_id)) ^
+           ComputeIntegerHash(static_cast<uint32_t>(key.position));
+  }
+  return ComputeIntegerHash(static_cast<uint32_t>(
+             reinterpret_cast<uintptr_t>(key.name))) ^
+         ComputeIntegerHash(static_cast<uint32_t>(
+             reinterpret_cast<uintptr_t>(key.resource_name))) ^
+         ComputeIntegerHash(key.line_number);
+}
+
+std::size_t ContinuousProfile::StackHasher::operator()(
+    const std::vector<unsigned>& stack) const {
+  uint32_t hash = static_cast<uint32_t>(stack.size());
+  for (unsigned id : stack) hash = ComputeIntegerHash(hash ^ id);
+  return hash;
+}
+
+ContinuousProfile::ContinuousProfile(v8::ContinuousProfileSink* sink,
+                                     base::TimeDelta sampling_interval,
+                                     base::TimeDelta flush_interval,
+                                     size_t memory_budget)
+    : sink_(sink),
+      sampling_interval_(sampling_interval),
+      flush_interval_(flush_interval),
+      memory_budget_(memory_budget),
+      chunk_start_(base::TimeTicks::HighResolutionNow()),
+      memory_usage_(0),
+      functions_memory_usage_(0),
+      next_function_id_(1),
+      names_(new StringsStorage()) {}
+
+unsigned ContinuousProfile::GetFunctionId(const CodeEntry* entry) {
+  FunctionKey key(entry);
+  auto it = function_ids_.find(key);
+  if (it != function_ids_.end()) return it->second;
+  unsigned id = next_function_id_++;
+  function_ids_.emplace(key, id);
+  new_functions_.push_back({id, names_->GetCopy(entry->name()),
+                            names_->GetCopy(entry->resource_name()),
+                            entry->script_id(), entry->line_number(),
+                            entry->column_number()});
+  memory_usage_ += sizeof(v8::ContinuousProfileFunction);
+  // The hash map node holds the key and the id, next to the names.
+  functions_memory_usage_ =
+      function_ids_.size() *
+          (sizeof(FunctionKey) + sizeof(unsigned) + 2 * sizeof(void*)) +
+      names_->GetUsedMemorySize();
+  return id;
+}
+
+void ContinuousProfile::AddPath(base::TimeTicks timestamp,
+                                const ProfileStackTrace& path) {
+  current_stack_.clear();
+  for (const CodeEntryAndLineNumber& frame : path) {
+    if (frame.code_entry == nullptr) continue;
+    current_stack_.push_back(GetFunctionId(frame.code_entry));
+  }
+
+  auto it = stacks_.find(current_stack_);
+  if (it != stacks_.end()) {
+    it->second++;
+    return;
+  }
+  stacks_.emplace(current_stack_, 1);
+  memory_usage_ += kStackOverhead + current_stack_.size() * sizeof(unsigned);
+  if (memory_usage() > memory_budget_) Flush(timestamp);
+}
+
+void ContinuousProfile::Flush(base::TimeTicks now) {
+  std::vector<v8::ContinuousProfileSample> samples;
+  samples.reserve(stacks_.size());
+  for (const auto& stack : stacks_) {
+    samples.push_back({stack.first.data(), stack.first.size(), stack.second});
+  }
+  v8::ContinuousProfileChunk chunk;
+  chunk.start_time = (chunk_start_ - base::TimeTicks()).InMicroseconds();
+  chunk.end_time = (now - base::TimeTicks()).InMicroseconds();
+  chunk.sampling_interval_us = sampling_interval_.InMicroseconds();
+  chunk.new_functions = new_functions_.data();
+  chunk.new_functions_count = new_functions_.size();
+  chunk.samples = samples.data();
+  chunk.samples_count = samples.size();
+  sink_->OnChunk(chunk);
+
+  new_functions_.clear();
+  stacks_.clear();
+  memory_usage_ = 0;
+  chunk_start_ = now;
+
+  // Keeping the functions interned means that they are only described once,
+  // but they have to leave room for the stacks.
+  if (functions_memory_usage_ > memory_budget_ / 2) {
+    function_ids_.clear();
+    names_.reset(new StringsStorage());
+    functions_memory_usage_ = 0;
+  }
+}
+
+void ContinuousProfile::FlushIfDue(base::TimeTicks now) {
+  if (now - chunk_start_ >= flush_interval_) Flush(now);
+}
+
+const size_t CodeMap::kMinPendingUpdates;
+
 CodeMap::CodeMap() = default;
 
 CodeMap::~CodeMap() {
@@ -528,51 +663,130 @@ CodeMap::~CodeMap() {
 void CodeMap::AddCode(Address addr, CodeEntry* entry, unsigned size) {
   ClearCodesInRange(addr, addr + size);
   unsigned index = AddCodeEntry(addr, entry);
-  code_map_.emplace(addr, CodeEntryMapInfo{index, size});
+  InsertRange(CodeRange{addr, size, index});
   DCHECK(entry->instruction_start() == kNullAddress ||
          addr == entry->instruction_start());
 }
 
 void CodeMap::ClearCodesInRange(Address start, Address end) {
-  auto left = code_map_.upper_bound(start);
-  if (left != code_map_.begin()) {
-    --left;
-    if (left->first + left->second.size <= start) ++left;
+  InvalidateLookupCache();
+  ClearCodesInRange(&pending_ranges_, start, end);
+  ClearCodesInRange(&main_ranges_, start, end);
+}
+
+void CodeMap::ClearCodesInRange(std::vector<CodeRange>* ranges, Address start,
+                                Address end) {
+  auto left = std::upper_bound(ranges->begin(), ranges->end(),
+                               CodeRange{start, 0, kNoFreeSlot});
+  // Only the closest live range below {start} can extend into the cleared
+  // range, as live ranges don't overlap.
+  for (auto it = left; it != ranges->begin();) {
+    --it;
+    if (it->is_deleted()) continue;
+    if (it->end() > start) left = it;
+    break;
   }
   auto right = left;
-  for (; right != code_map_.end() && right->first < end; ++right) {
-    if (!entry(right->second.index)->used()) {
-      DeleteCodeEntry(right->second.index);
+  for (; right != ranges->end() && right->start < end; ++right) {
+    if (right->is_deleted()) continue;
+    if (!entry(right->index)->used()) DeleteCodeEntry(right->index);
+    if (ranges == &main_ranges_) {
+      right->index = kNoFreeSlot;
+      deleted_main_ranges_++;
     }
   }
-  code_map_.erase(left, right);
+  if (ranges == &pending_ranges_) ranges->erase(left, right);
+}
+
+const CodeMap::CodeRange* CodeMap::FindRange(
+    const std::vector<CodeRange>& ranges, Address addr) const {
+  auto it = std::upper_bound(ranges.begin(), ranges.end(),
+                             CodeRange{addr, 0, kNoFreeSlot});
+  while (it != ranges.begin()) {
+    --it;
+    if (it->is_deleted()) continue;
+    return addr < it->end() ? &*it : nullptr;
+  }
+  return nullptr;
+}
+
+void CodeMap::InsertRange(const CodeRange& range) {
+  InvalidateLookupCache();
+  pending_ranges_.insert(std::upper_bound(pending_ranges_.begin(),
+                                          pending_ranges_.end(), range),
+                         range);
+  size_t max_pending_updates =
+      std::max(kMinPendingUpdates, main_ranges_.size() / 64);
+  if (pending_ranges_.size() + deleted_main_ranges_ > max_pending_updates) {
+    MergePendingRanges();
+  }
+}
+
+void CodeMap::MergePendingRanges() {
+  if (deleted_main_ranges_ > 0) {
+    main_ranges_.erase(std::remove_if(main_ranges_.begin(), main_ranges_.end(),
+                                      [](const CodeRange& range) {
+                                        return range.is_deleted();
+                                      }),
+                       main_ranges_.end());
+    deleted_main_ranges_ = 0;
+  }
+  size_t main_size = main_ranges_.size();
+  main_ranges_.insert(main_ranges_.end(), pending_ranges_.begin(),
+                      pending_ranges_.end());
+  std::inplace_merge(main_ranges_.begin(), main_ranges_.begin() + main_size,
+                     main_ranges_.end());
+  pending_ranges_.clear();
+}
+
+void CodeMap::InvalidateLookupCache() {
+  if (++lookup_cache_epoch_ != 0) return;
+  // The epoch wrapped around, so stale entries could appear valid again.
+  memset(lookup_cache_, 0, sizeof(lookup_cache_));
+  lookup_cache_epoch_ = 1;
 }
 
 CodeEntry* CodeMap::FindEntry(Address addr) {
-  auto it = code_map_.upper_bound(addr);
-  if (it == code_map_.begin()) return nullptr;
-  --it;
-  Address start_address = it->first;
-  Address end_address = start_address + it->second.size;
-  CodeEntry* ret = addr < end_address ? entry(it->second.index) : nullptr;
+  LookupCacheEntry& cached =
+      lookup_cache_[(addr >> kLookupCacheShift) & (kLookupCacheSize - 1)];
+  if (cached.addr == addr && cached.epoch == lookup_cache_epoch_) {
+    return cached.entry;
+  }
+  const CodeRange* range = FindRange(pending_ranges_, addr);
+  if (range == nullptr) range = FindRange(main_ranges_, addr);
+  CodeEntry* ret = range ? entry(range->index) : nullptr;
   if (ret && ret->instruction_start() != kNullAddress) {
-    DCHECK_EQ(start_address, ret->instruction_start());
-    DCHECK(addr >= start_address && addr < end_address);
+    DCHECK_EQ(range->start, ret->instruction_start());
+    DCHECK(addr >= range->start && addr < range->end());
   }
+  cached = LookupCacheEntry{addr, ret, lookup_cache_epoch_};
   return ret;
 }
 
 void CodeMap::MoveCode(Address from, Address to) {
   if (from == to) return;
-  auto it = code_map_.find(from);
-  if (it == code_map_.end()) return;
-  CodeEntryMapInfo info = it->second;
-  code_map_.erase(it);
-  DCHECK(from + info.size <= to || to + info.size <= from);
-  ClearCodesInRange(to, to + info.size);
-  code_map_.emplace(to, info);
-
-  CodeEntry* entry = code_entries_[info.index].entry;
+  CodeRange range;
+  auto it = std::lower_bound(pending_ranges_.begin(), pending_ranges_.end(),
+                             CodeRange{from, 0, kNoFreeSlot});
+  if (it != pending_ranges_.end() && it->start == from) {
+    range = *it;
+    pending_ranges_.erase(it);
+  } else {
+    it = std::lower_bound(main_ranges_.begin(), main_ranges_.end(),
+                          CodeRange{from, 0, kNoFreeSlot});
+    if (it == main_ranges_.end() || it->start != from || it->is_deleted()) {
+      return;
+    }
+    range = *it;
+    it->index = kNoFreeSlot;
+    deleted_main_ranges_++;
+  }
+  DCHECK(from + range.size <= to || to + range.size <= from);
+  ClearCodesInRange(to, to + range.size);
+  range.start = to;
+  InsertRange(range);
+
+  CodeEntry* entry = code_entries_[range.index].entry;
   entry->set_instruction_start(to);
 }
 
@@ -594,9 +808,10 @@ void CodeMap::DeleteCodeEntry(unsigned index) {
 }
 
 void CodeMap::Print() {
-  for (const auto& pair : code_map_) {
-    base::OS::Print("%p %5d %s\n", reinterpret_cast<void*>(pair.first),
-                    pair.second.size, entry(pair.second.index)->name());
+  MergePendingRanges();
+  for (const CodeRange& range : main_ranges_) {
+    base::OS::Print("%p %5d %s\n", reinterpret_cast<void*>(range.start),
+                    range.size, entry(range.index)->name());
   }
 }
 
@@ -670,6 +885,29 @@ void CpuProfilesCollection::RemoveProfile(CpuProfile* profile) {
   finished_profiles_.erase(pos);
 }
 
+bool CpuProfilesCollection::StartContinuousProfiling(
+    std::unique_ptr<ContinuousProfile> profile) {
+  current_profiles_semaphore_.Wait();
+  bool started = !continuous_profile_;
+  if (started) continuous_profile_ = std::move(profile);
+  current_profiles_semaphore_.Signal();
+  return started;
+}
+
+std::unique_ptr<ContinuousProfile>
+CpuProfilesCollection::StopContinuousProfiling() {
+  current_profiles_semaphore_.Wait();
+  std::unique_ptr<ContinuousProfile> profile = std::move(continuous_profile_);
+  current_profiles_semaphore_.Signal();
+  return profile;
+}
+
+void CpuProfilesCollection::FlushContinuousProfileIfDue(base::TimeTicks now) {
+  current_profiles_semaphore_.Wait();
+  if (continuous_profile_) continuous_profile_->FlushIfDue(now);
+  current_profiles_semaphore_.Signal();
+}
+
 void CpuProfilesCollection::AddPathToCurrentProfiles(
     base::TimeTicks timestamp, const ProfileStackTrace& path, int src_line,
     bool update_stats) {
@@ -680,6 +918,11 @@ void CpuProfilesCollection::AddPathToCurrentProfiles(
   for (const std::unique_ptr<CpuProfile>& profile : current_profiles_) {
     profile->AddPath(timestamp, path, src_line, update_stats);
   }
+  // Forced samples only add nodes to profile trees, so they are not counted
+  // by the continuous profile.
+  if (continuous_profile_ && update_stats) {
+    continuous_profile_->AddPath(timestamp, path);
+  }
   current_profiles_semaphore_.Signal();
 }
 
@@ -802,6 +1045,10 @@ void ProfileGenerator::RecordTickSample(const TickSample& sample) {
                                       sample.update_stats);
 }
 
+void ProfileGenerator::FlushContinuousProfileIfDue(base::TimeTicks now) {
+  profiles_->FlushContinuousProfileIfDue(now);
+}
+
 CodeEntry* ProfileGenerator::EntryForVMState(StateTag tag) {
   switch (tag) {
     case GC:
@@ -363,6 +363,90 @@ class CpuProfile {
   DISALLOW_COPY_AND_ASSIGN(CpuProfile);
 };
 
+// A profile that can be left on for a long time. Samples are not kept
+// individually or in a tree: every distinct call stack is counted once, and
+// the counts are handed to the embedder's sink when the flush interval has
+// passed or they use more memory than the budget allows. Functions are
+// interned, so a chunk only describes the functions it sees first. The
+// interned functions count against the budget too: once they take half of
+// it, they are forgotten at the next flush and described again under new
+// ids.
+class ContinuousProfile {
+ public:
+  ContinuousProfile(v8::ContinuousProfileSink* sink,
+                    base::TimeDelta sampling_interval,
+                    base::TimeDelta flush_interval, size_t memory_budget);
+
+  // Called from the profile generator thread.
+  void AddPath(base::TimeTicks timestamp, const ProfileStackTrace& path);
+
+  // Passes the samples since the previous flush to the sink.
+  void Flush(base::TimeTicks now);
+  // Flushes if the flush interval has passed since the previous flush.
+  // Called periodically from the profile generator thread, so that chunks
+  // are passed on time even when there are no samples.
+  void FlushIfDue(base::TimeTicks now);
+
+  size_t memory_usage() const {
+    return memory_usage_ + functions_memory_usage_;
+  }
+
+ private:
+  // Identifies a function the way CodeEntry::IsSameFunctionAs does, without
+  // keeping the CodeEntry alive.
+  struct FunctionKey {
+    explicit FunctionKey(const CodeEntry* entry);
+    bool operator==(const FunctionKey& other) const;
+
+    int script_id;
+    int position;
+    const char* name;
+    const char* resource_name;
+    int line_number;
+  };
+  struct FunctionKeyHasher {
+    std::size_t operator()(const FunctionKey& key) const;
+  };
+  struct StackHasher {
+    std::size_t operator()(const std::vector<unsigned>& stack) const;
+  };
+
+  unsigned GetFunctionId(const CodeEntry* entry);
+
+  v8::ContinuousProfileSink* const sink_;
+  const base::TimeDelta sampling_interval_;
+  const base::TimeDelta flush_interval_;
+  const size_t memory_budget_;
+
+  base::TimeTicks chunk_start_;
+  // The memory used by the stacks and the new functions of this chunk.
+  size_t memory_usage_;
+  // The memory used by function_ids_ and names_.
+  size_t functions_memory_usage_;
+
+  std::unordered_map<FunctionKey, unsigned, FunctionKeyHasher> function_ids_;
+  unsigned next_function_id_;
+  // The functions interned since the previous flush. Their names are copied
+  // to names_, so they stay valid after the code is collected.
+  std::vector<v8::ContinuousProfileFunction> new_functions_;
+  std::unique_ptr<StringsStorage> names_;
+
+  std::unordered_map<std::vector<unsigned>, int64_t, StackHasher> stacks_;
+  // Reused for every sample, to avoid allocating.
+  std::vector<unsigned> current_stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(ContinuousProfile);
+};
+
+// Maps code addresses to code entries. Every tick symbolizes each frame of
+// the sampled stack through FindEntry(), so lookups dominate: the ranges are
+// kept in flat sorted arrays, and recently looked up addresses are cached.
+//
+// The ranges live in two levels. Code creation and moves insert into a small
+// sorted array of pending ranges, while ranges removed from the large main
+// array are only marked as deleted. Once enough updates have accumulated,
+// the levels are merged. The merge threshold grows with the main array, so
+// updates stay cheap for large maps while lookups touch only two arrays.
 class CodeMap {
  public:
   CodeMap();
@@ -373,12 +457,10 @@ class CodeMap {
   CodeEntry* FindEntry(Address addr);
   void Print();
 
- private:
-  struct CodeEntryMapInfo {
-    unsigned index;
-    unsigned size;
-  };
+  // The minimum number of updates after which the levels are merged.
+  static const size_t kMinPendingUpdates = 256;
 
+ private:
   union CodeEntrySlotInfo {
     CodeEntry* entry;
     unsigned next_free_slot;
@@ -386,16 +468,58 @@ class CodeMap {
 
   static constexpr unsigned kNoFreeSlot = std::numeric_limits<unsigned>::max();
 
+  struct CodeRange {
+    Address start;
+    unsigned size;
+    // The index of the entry in code_entries_, or kNoFreeSlot for a range
+    // that has been removed from the main array.
+    unsigned index;
+
+    Address end() const { return start + size; }
+    bool is_deleted() const { return index == kNoFreeSlot; }
+    bool operator<(const CodeRange& other) const {
+      return start < other.start;
+    }
+  };
+
+  struct LookupCacheEntry {
+    Address addr;
+    CodeEntry* entry;
+    unsigned epoch;
+  };
+
+  static const int kLookupCacheSize = 1024;
+  static const int kLookupCacheShift = 3;
+
   void ClearCodesInRange(Address start, Address end);
+  void ClearCodesInRange(std::vector<CodeRange>* ranges, Address start,
+                         Address end);
+  // Returns the live range containing {addr}, or nullptr.
+  const CodeRange* FindRange(const std::vector<CodeRange>& ranges,
+                             Address addr) const;
+  void InsertRange(const CodeRange& range);
+  void MergePendingRanges();
+  void InvalidateLookupCache();
+
   unsigned AddCodeEntry(Address start, CodeEntry*);
   void DeleteCodeEntry(unsigned index);
 
   CodeEntry* entry(unsigned index) { return code_entries_[index].entry; }
 
   std::deque<CodeEntrySlotInfo> code_entries_;
-  std::map<Address, CodeEntryMapInfo> code_map_;
   unsigned free_list_head_ = kNoFreeSlot;
 
+  // Both arrays are sorted by start address, and live ranges never overlap,
+  // neither within nor across the arrays.
+  std::vector<CodeRange> main_ranges_;
+  std::vector<CodeRange> pending_ranges_;
+  size_t deleted_main_ranges_ = 0;
+
+  // Direct-mapped cache of FindEntry() results. An entry is only valid if
+  // its epoch matches lookup_cache_epoch_, which every update increments.
+  LookupCacheEntry lookup_cache_[kLookupCacheSize] = {};
+  unsigned lookup_cache_epoch_ = 1;
+
   DISALLOW_COPY_AND_ASSIGN(CodeMap);
 };
 
@@ -416,6 +540,15 @@ class CpuProfilesCollection {
   bool IsLastProfile(const char* title);
   void RemoveProfile(CpuProfile* profile);
 
+  // Returns false if a continuous profile is already being recorded.
+  bool StartContinuousProfiling(std::unique_ptr<ContinuousProfile> profile);
+  std::unique_ptr<ContinuousProfile> StopContinuousProfiling();
+  // Called from the profile generator thread.
+  void FlushContinuousProfileIfDue(base::TimeTicks now);
+  // Called from VM thread, and only it can start or stop profiles.
+  bool is_continuous_profiling() const { return !!continuous_profile_; }
+  bool has_current_profiles() const { return !current_profiles_.empty(); }
+
   // Called from profile generator thread.
   void AddPathToCurrentProfiles(base::TimeTicks timestamp,
                                 const ProfileStackTrace& path, int src_line,
@@ -431,6 +564,7 @@ class CpuProfilesCollection {
 
   // Accessed by VM thread and profile generator thread.
   std::vector<std::unique_ptr<CpuProfile>> current_profiles_;
+  std::unique_ptr<ContinuousProfile> continuous_profile_;
   base::Semaphore current_profiles_semaphore_;
 
   DISALLOW_COPY_AND_ASSIGN(CpuProfilesCollection);
@@ -441,6 +575,8 @@ class ProfileGenerator {
   explicit ProfileGenerator(CpuProfilesCollection* profiles);
 
   void RecordTickSample(const TickSample& sample);
+  // Gives the continuous profile, if any, a chance to flush on time.
+  void FlushContinuousProfileIfDue(base::TimeTicks now);
 
   CodeMap* code_map() { return &code_map_; }
 
@@ -10,7 +10,7 @@
 #include "src/base/ieee754.h"
 #include "src/base/utils/random-number-generator.h"
 #include "src/frames-inl.h"
-#include "src/heap/heap.h"
+#include "src/heap/heap-inl.h"
 #include "src/isolate.h"
 #include "src/profiler/strings-storage.h"
 
@@ -67,6 +67,10 @@ SamplingHeapProfiler::SamplingHeapProfiler(
       flags_(flags) {
   CHECK_GT(rate_, 0u);
 
+  if (flags_ & v8::HeapProfiler::kSamplingAggregateStacks) {
+    sampled_allocations_.reset(
+        new SampledAllocations(isolate_, names_, rate_, stack_depth_));
+  }
   heap_->AddAllocationObserversToAllSpaces(other_spaces_observer_.get(),
                                            new_space_observer_.get());
 }
@@ -75,6 +79,7 @@ SamplingHeapProfiler::SamplingHeapProfiler(
 SamplingHeapProfiler::~SamplingHeapProfiler() {
   heap_->RemoveAllocationObserversFromAllSpaces(other_spaces_observer_.get(),
                                                 new_space_observer_.get());
+  sampled_allocations_.reset();
 
   samples_.clear();
 }
@@ -83,15 +88,20 @@ SamplingHeapProfiler::~SamplingHeapProfiler() {
 void SamplingHeapProfiler::SampleObject(Address soon_object, size_t size) {
   DisallowHeapAllocation no_allocation;
 
-  HandleScope scope(isolate_);
-  HeapObject* heap_object = HeapObject::FromAddress(soon_object);
-  Handle<Object> obj(heap_object, isolate_);
-
   // Mark the new block as FreeSpace to make sure the heap is iterable while we
   // are taking the sample.
   heap()->CreateFillerObjectAt(soon_object, static_cast<int>(size),
                                ClearRecordedSlots::kNo);
 
+  if (sampled_allocations_) {
+    sampled_allocations_->AddSample(soon_object, size);
+    return;
+  }
+
+  HandleScope scope(isolate_);
+  HeapObject* heap_object = HeapObject::FromAddress(soon_object);
+  Handle<Object> obj(heap_object, isolate_);
+
   Local<v8::Value> loc = v8::Utils::ToLocal(obj);
 
   AllocationNode* node = AddStack();
@@ -281,6 +291,7 @@ v8::AllocationProfile::Node* SamplingHeapProfiler::TranslateAllocationNode(
 }
 
 v8::AllocationProfile* SamplingHeapProfiler::GetAllocationProfile() {
+  if (sampled_allocations_) return nullptr;
   if (flags_ & v8::HeapProfiler::kSamplingForceGC) {
     isolate_->heap()->CollectAllGarbage(
         Heap::kNoGCFlags, GarbageCollectionReason::kSamplingProfiler);
@@ -299,6 +310,311 @@ v8::AllocationProfile* SamplingHeapProfiler::GetAllocationProfile() {
   return profile;
 }
 
+bool SamplingHeapProfiler::CollectSampledAllocations(
+    v8::SampledAllocationsSink* sink) {
+  if (!sampled_allocations_) return false;
+  if (flags_ & v8::HeapProfiler::kSamplingForceGC) {
+    isolate_->heap()->CollectAllGarbage(
+        Heap::kNoGCFlags, GarbageCollectionReason::kSamplingProfiler);
+  }
+  sampled_allocations_->Collect(sink);
+  return true;
+}
+
+SampledAllocations::SampledAllocations(Isolate* isolate,
+                                       StringsStorage* names, uint64_t rate,
+                                       int stack_depth)
+    : isolate_(isolate),
+      names_(names),
+      rate_(rate),
+      stack_depth_(stack_depth) {
+  stacks_.push_back({0, 0});
+  isolate_->heap()->AddWeakObjectTable(this);
+  isolate_->heap()->AddGCPrologueCallback(OnGCPrologue, kGCTypeAll, this);
+}
+
+SampledAllocations::~SampledAllocations() {
+  isolate_->heap()->RemoveGCPrologueCallback(OnGCPrologue, this);
+  isolate_->heap()->RemoveWeakObjectTable(this);
+}
+
+// static
+void SampledAllocations::OnGCPrologue(v8::Isolate* isolate, v8::GCType type,
+                                      v8::GCCallbackFlags flags, void* data) {
+  reinterpret_cast<SampledAllocations*>(data)->ResolvePendingSample();
+}
+
+void SampledAllocations::AddSample(Address soon_object, size_t size) {
+  ResolvePendingSample();
+  pending_sample_ = {HeapObject::FromAddress(soon_object), 0,
+                     static_cast<uint32_t>(size)};
+  pending_stack_id_ = CaptureStack();
+  has_pending_sample_ = true;
+}
+
+unsigned SampledAllocations::AddFunction(uint64_t key, const char* name,
+                                         int script_id, int start_position) {
+  unsigned id = static_cast<unsigned>(functions_.size()) + 1;
+  functions_.push_back({name, script_id, start_position});
+  function_ids_.emplace(key, id);
+  return id;
+}
+
+unsigned SampledAllocations::GetFunctionId(SharedFunctionInfo* shared) {
+  if (!shared->script()->IsScript()) {
+    return GetFunctionId(names_->GetName(shared->DebugName()));
+  }
+  // Same ids as AllocationNode::function_id(): the low bit tells script
+  // functions from pseudo functions.
+  int script_id = Script::cast(shared->script())->id();
+  int start_position = shared->StartPosition();
+  DCHECK_LT(static_cast<unsigned>(start_position), 1u << 31);
+  uint64_t key =
+      (static_cast<uint64_t>(script_id) << 32) + (start_position << 1);
+  auto it = function_ids_.find(key);
+  if (it != function_ids_.end()) return it->second;
+  return AddFunction(key, names_->GetName(shared->DebugName()), script_id,
+                     start_position);
+}
+
+unsigned SampledAllocations::GetFunctionId(const char* name) {
+  uint64_t key = reinterpret_cast<intptr_t>(name) | 1;
+  auto it = function_ids_.find(key);
+  if (it != function_ids_.end()) return it->second;
+  return AddFunction(key, name, v8::UnboundScript::kNoScriptId, 0);
+}
+
+unsigned SampledAllocations::GetStackId(unsigned caller_stack_id,
+                                        unsigned function_id) {
+  uint64_t key = (static_cast<uint64_t>(caller_stack_id) << 32) | function_id;
+  auto it = stack_ids_.find(key);
+  if (it != stack_ids_.end()) return it->second;
+  unsigned id = static_cast<unsigned>(stacks_.size());
+  stacks_.push_back({caller_stack_id, function_id});
+  stack_ids_.emplace(key, id);
+  return id;
+}
+
+unsigned SampledAllocations::CaptureStack() {
+  // The stack is walked from the leaf, but interned from the root, so the
+  // functions are collected first. See SamplingHeapProfiler::AddStack().
+  stack_function_ids_.clear();
+  int frames_captured = 0;
+  bool found_arguments_marker_frames = false;
+  JavaScriptFrameIterator it(isolate_);
+  while (!it.done() && frames_captured < stack_depth_) {
+    JavaScriptFrame* frame = it.frame();
+    if (frame->unchecked_function()->IsJSFunction()) {
+      stack_function_ids_.push_back(
+          GetFunctionId(frame->function()->shared()));
+      frames_captured++;
+    } else {
+      found_arguments_marker_frames = true;
+    }
+    it.Advance();
+  }
+
+  if (frames_captured == 0) {
+    const char* name = nullptr;
+    switch (isolate_->current_vm_state()) {
+      case GC:
+        name = "(GC)";
+        break;
+      case PARSER:
+        name = "(PARSER)";
+        break;
+      case COMPILER:
+        name = "(COMPILER)";
+        break;
+      case BYTECODE_COMPILER:
+        name = "(BYTECODE_COMPILER)";
+        break;
+      case OTHER:
+        name = "(V8 API)";
+        break;
+      case EXTERNAL:
+        name = "(EXTERNAL)";
+        break;
+      case IDLE:
+        name = "(IDLE)";
+        break;
+      case JS:
+        name = "(JS)";
+        break;
+    }
+    return GetStackId(0, GetFunctionId(name));
+  }
+
+  unsigned stack_id = 0;
+  for (auto it = stack_function_ids_.rbegin();
+       it != stack_function_ids_.rend(); ++it) {
+    stack_id = GetStackId(stack_id, *it);
+  }
+  if (found_arguments_marker_frames) {
+    stack_id = GetStackId(stack_id, GetFunctionId("(deopt)"));
+  }
+  return stack_id;
+}
+
+const char* SampledAllocations::GetTypeName(HeapObject* object) {
+  if (object->IsJSObject()) {
+    Object* constructor = object->map()->GetConstructor();
+    if (constructor->IsJSFunction()) {
+      String* name = JSFunction::cast(constructor)->shared()->DebugName();
+      if (name->length() > 0) return names_->GetName(name);
+    }
+    return names_->GetName(JSObject::cast(object)->class_name());
+  }
+  if (object->IsString()) return "(string)";
+  if (object->IsCode()) return "(code)";
+  if (object->IsFixedArrayBase()) return "(array)";
+  if (object->IsHeapNumber()) return "(number)";
+  if (object->IsSymbol()) return "(symbol)";
+  return "(system)";
+}
+
+unsigned SampledAllocations::GetSiteId(unsigned stack_id,
+                                       const char* type_name) {
+  auto key = std::make_pair(stack_id, type_name);
+  auto it = site_ids_.find(key);
+  if (it != site_ids_.end()) return it->second;
+  unsigned id = static_cast<unsigned>(sites_.size()) + 1;
+  sites_.push_back({id, stack_id, type_name, 0, 0, 0, 0, false});
+  site_ids_.emplace(key, id);
+  return id;
+}
+
+double SampledAllocations::ScaleSample(size_t size) const {
+  // See SamplingHeapProfiler::ScaleSample().
+  return 1.0 / (1.0 - std::exp(-static_cast<double>(size) / rate_));
+}
+
+void SampledAllocations::ResolvePendingSample(const char* type_name) {
+  if (!has_pending_sample_) return;
+  has_pending_sample_ = false;
+  SampledObject sample = pending_sample_;
+  if (type_name == nullptr) type_name = GetTypeName(sample.object);
+  sample.site_id = GetSiteId(pending_stack_id_, type_name);
+
+  Site& site = sites_[sample.site_id - 1];
+  double count = ScaleSample(sample.size);
+  site.allocated_count += count;
+  site.allocated_bytes += count * sample.size;
+  site.live_count += count;
+  site.live_bytes += count * sample.size;
+  site.changed = true;
+
+  if (Heap::InNewSpace(sample.object)) {
+    young_objects_.push_back(sample);
+  } else {
+    old_objects_.push_back(sample);
+  }
+}
+
+void SampledAllocations::ProcessWeakReferences(WeakObjectRetainer* retainer,
+                                               bool young_only) {
+  // The pending sample is normally resolved by the GC prologue, unless the GC
+  // was triggered from a GC callback. Its type is unknown then, since its map
+  // may have moved already.
+  ResolvePendingSample("(unknown)");
+  if (!young_only) ProcessObjects(&old_objects_, retainer, nullptr);
+  ProcessObjects(&young_objects_, retainer, &old_objects_);
+}
+
+void SampledAllocations::ProcessObjects(
+    std::vector<SampledObject>* objects, WeakObjectRetainer* retainer,
+    std::vector<SampledObject>* old_objects) {
+  size_t i = 0;
+  while (i < objects->size()) {
+    SampledObject& sample = (*objects)[i];
+    Object* retained = retainer->RetainAs(sample.object);
+    if (retained == nullptr) {
+      // Left-trimmed objects end up here too, since their start is a filler.
+      Site& site = sites_[sample.site_id - 1];
+      double count = ScaleSample(sample.size);
+      site.live_count -= count;
+      site.live_bytes -= count * sample.size;
+      site.changed = true;
+    } else {
+      sample.object = HeapObject::cast(retained);
+      if (old_objects == nullptr || Heap::InNewSpace(sample.object)) {
+        i++;
+        continue;
+      }
+      old_objects->push_back(sample);
+    }
+    (*objects)[i] = objects->back();
+    objects->pop_back();
+  }
+}
+
+void SampledAllocations::Collect(v8::SampledAllocationsSink* sink) {
+  ResolvePendingSample();
+
+  HandleScope scope(isolate_);
+  // Resolving positions allocates, which may add samples and functions.
+  std::vector<v8::ContinuousProfileFunction> new_functions;
+  if (reported_functions_ < functions_.size()) {
+    std::map<int, Handle<Script>> scripts;
+    {
+      Script::Iterator iterator(isolate_);
+      while (Script* script = iterator.Next()) {
+        scripts[script->id()] = handle(script, isolate_);
+      }
+    }
+    for (; reported_functions_ < functions_.size(); reported_functions_++) {
+      // Copied, since resolving the position below can grow {functions_}.
+      const Function function = functions_[reported_functions_];
+      const char* resource_name = "";
+      int line = v8::AllocationProfile::kNoLineNumberInfo;
+      int column = v8::AllocationProfile::kNoColumnNumberInfo;
+      auto it = scripts.find(function.script_id);
+      if (it != scripts.end()) {
+        Handle<Script> script = it->second;
+        if (script->name()->IsName()) {
+          resource_name = names_->GetName(Name::cast(script->name()));
+        }
+        line = 1 + Script::GetLineNumber(script, function.start_position);
+        column = 1 + Script::GetColumnNumber(script, function.start_position);
+      }
+      new_functions.push_back(
+          {static_cast<unsigned>(reported_functions_) + 1, function.name,
+           resource_name, function.script_id, line, column});
+    }
+  }
+
+  DisallowHeapAllocation no_allocation;
+  std::vector<v8::SampledAllocationSite> sites;
+  std::vector<unsigned> function_ids;
+  for (const Site& site : sites_) {
+    if (!site.changed) continue;
+    size_t depth = 0;
+    for (unsigned stack_id = site.stack_id; stack_id != 0;
+         stack_id = stacks_[stack_id].caller_stack_id) {
+      function_ids.push_back(stacks_[stack_id].function_id);
+      depth++;
+    }
+    sites.push_back({site.id, nullptr, depth, site.type_name,
+                     static_cast<int64_t>(site.allocated_count + 0.5),
+                     static_cast<int64_t>(site.allocated_bytes + 0.5),
+                     static_cast<int64_t>(site.live_count + 0.5),
+                     static_cast<int64_t>(site.live_bytes + 0.5)});
+  }
+  // {function_ids} is complete now, so pointers into it stay valid.
+  size_t offset = 0;
+  for (v8::SampledAllocationSite& site : sites) {
+    site.function_ids = function_ids.data() + offset;
+    offset += site.depth;
+  }
+
+  v8::SampledAllocationsChunk chunk = {static_cast<int64_t>(rate_),
+                                       new_functions.data(),
+                                       new_functions.size(), sites.data(),
+                                       sites.size()};
+  sink->OnChunk(chunk);
+  for (Site& site : sites_) site.changed = false;
+}
+
 
 }  // namespace internal
 }  // namespace v8
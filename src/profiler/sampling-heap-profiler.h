@@ -9,6 +9,8 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
+#include <vector>
 #include "include/v8-profiler.h"
 #include "src/heap/heap.h"
 #include "src/profiler/strings-storage.h"
@@ -21,6 +23,7 @@ class RandomNumberGenerator;
 
 namespace internal {
 
+class SampledAllocations;
 class SamplingAllocationObserver;
 
 class AllocationProfile : public v8::AllocationProfile {
@@ -46,6 +49,7 @@ class SamplingHeapProfiler {
   ~SamplingHeapProfiler();
 
   v8::AllocationProfile* GetAllocationProfile();
+  bool CollectSampledAllocations(v8::SampledAllocationsSink* sink);
 
   StringsStorage* names() const { return names_; }
 
@@ -144,6 +148,9 @@ class SamplingHeapProfiler {
   Heap* const heap_;
   std::unique_ptr<SamplingAllocationObserver> new_space_observer_;
   std::unique_ptr<SamplingAllocationObserver> other_spaces_observer_;
+  // Only used with kSamplingAggregateStacks, instead of the allocation nodes
+  // and samples.
+  std::unique_ptr<SampledAllocations> sampled_allocations_;
   StringsStorage* const names_;
   AllocationNode profile_root_;
   std::set<std::unique_ptr<Sample>> samples_;
@@ -156,6 +163,110 @@ class SamplingHeapProfiler {
   DISALLOW_COPY_AND_ASSIGN(SamplingHeapProfiler);
 };
 
+// The samples of a sampling heap profile that aggregates stacks. The sampled
+// stacks are interned, and the samples are counted per site, i.e. per stack
+// and object type. Instead of holding a weak global handle, the sampled
+// objects are kept in a WeakObjectTable, whose entries the GC updates in
+// bulk. The profile is read incrementally by Collect().
+class SampledAllocations : public WeakObjectTable {
+ public:
+  SampledAllocations(Isolate* isolate, StringsStorage* names, uint64_t rate,
+                     int stack_depth);
+  ~SampledAllocations() override;
+
+  void AddSample(Address soon_object, size_t size);
+
+  // Passes the sites that changed since the previous call to {sink}.
+  void Collect(v8::SampledAllocationsSink* sink);
+
+  void ProcessWeakReferences(WeakObjectRetainer* retainer,
+                             bool young_only) override;
+
+ private:
+  struct Function {
+    const char* name;
+    int script_id;
+    int start_position;
+  };
+
+  // Stacks are interned leaf first: a stack is its leaf-most function and
+  // the id of the stack of its callers.
+  struct StackNode {
+    unsigned caller_stack_id;
+    unsigned function_id;
+  };
+
+  struct Site {
+    unsigned id;
+    unsigned stack_id;
+    const char* type_name;
+    double allocated_count;
+    double allocated_bytes;
+    double live_count;
+    double live_bytes;
+    bool changed;
+  };
+
+  struct SampledObject {
+    HeapObject* object;
+    unsigned site_id;
+    uint32_t size;
+  };
+
+  static void OnGCPrologue(v8::Isolate* isolate, v8::GCType type,
+                           v8::GCCallbackFlags flags, void* data);
+
+  // The functions of scripts are identified by their script and position, so
+  // their names are only looked up once. Pseudo functions, like "(deopt)",
+  // are identified by their name, which must be a literal.
+  unsigned GetFunctionId(SharedFunctionInfo* shared);
+  unsigned GetFunctionId(const char* name);
+  unsigned AddFunction(uint64_t key, const char* name, int script_id,
+                       int start_position);
+  unsigned GetStackId(unsigned caller_stack_id, unsigned function_id);
+  unsigned CaptureStack();
+
+  // The latest sampled object is not initialized yet when it is sampled, so
+  // its type is only looked up before the next sample, GC or Collect().
+  // {type_name} is used instead if given.
+  void ResolvePendingSample(const char* type_name = nullptr);
+  const char* GetTypeName(HeapObject* object);
+  unsigned GetSiteId(unsigned stack_id, const char* type_name);
+  // Drops the dead objects in {objects} and updates the moved ones. The
+  // objects that are no longer in new space are moved to {old_objects} when
+  // it is given.
+  void ProcessObjects(std::vector<SampledObject>* objects,
+                      WeakObjectRetainer* retainer,
+                      std::vector<SampledObject>* old_objects);
+  double ScaleSample(size_t size) const;
+
+  Isolate* const isolate_;
+  StringsStorage* const names_;
+  const uint64_t rate_;
+  const int stack_depth_;
+
+  std::unordered_map<uint64_t, unsigned> function_ids_;
+  // Function ids start at 1, so the id of a function is its index + 1.
+  std::vector<Function> functions_;
+  size_t reported_functions_ = 0;
+
+  std::unordered_map<uint64_t, unsigned> stack_ids_;
+  // The empty stack has id 0.
+  std::vector<StackNode> stacks_;
+  std::vector<unsigned> stack_function_ids_;
+
+  std::map<std::pair<unsigned, const char*>, unsigned> site_ids_;
+  std::vector<Site> sites_;
+
+  std::vector<SampledObject> young_objects_;
+  std::vector<SampledObject> old_objects_;
+  bool has_pending_sample_ = false;
+  SampledObject pending_sample_;
+  unsigned pending_stack_id_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SampledAllocations);
+};
+
 class SamplingAllocationObserver : public AllocationObserver {
  public:
   SamplingAllocationObserver(Heap* heap, intptr_t step_size, uint64_t rate,
@@ -17,7 +17,7 @@ bool StringsStorage::StringsMatch(void* key1, void* key2) {
          0;
 }
 
-StringsStorage::StringsStorage() : names_(StringsMatch) {}
+StringsStorage::StringsStorage() : names_(StringsMatch), strings_size_(0) {}
 
 StringsStorage::~StringsStorage() {
   for (base::HashMap::Entry* p = names_.Start(); p != nullptr;
@@ -28,6 +28,7 @@ StringsStorage::~StringsStorage() {
 
 const char* StringsStorage::GetCopy(const char* src) {
   int len = static_cast<int>(strlen(src));
+  base::LockGuard<base::Mutex> guard(&mutex_);
   base::HashMap::Entry* entry = GetEntry(src, len);
   if (entry->value == nullptr) {
     Vector<char> dst = Vector<char>::New(len + 1);
@@ -35,6 +36,7 @@ const char* StringsStorage::GetCopy(const char* src) {
     dst[len] = '\0';
     entry->key = dst.start();
     entry->value = entry->key;
+    strings_size_ += len + 1;
   }
   return reinterpret_cast<const char*>(entry->value);
 }
@@ -48,11 +50,13 @@ const char* StringsStorage::GetFormatted(const char* format, ...) {
 }
 
 const char* StringsStorage::AddOrDisposeString(char* str, int len) {
+  base::LockGuard<base::Mutex> guard(&mutex_);
   base::HashMap::Entry* entry = GetEntry(str, len);
   if (entry->value == nullptr) {
     // New entry added.
     entry->key = str;
     entry->value = str;
+    strings_size_ += len + 1;
   } else {
     DeleteArray(str);
   }
@@ -60,13 +64,11 @@ const char* StringsStorage::AddOrDisposeString(char* str, int len) {
 }
 
 const char* StringsStorage::GetVFormatted(const char* format, va_list args) {
-  Vector<char> str = Vector<char>::New(1024);
+  // Format on the stack so that the stored copy is no longer than needed.
+  EmbeddedVector<char, 1024> str;
   int len = VSNPrintF(str, format, args);
-  if (len == -1) {
-    DeleteArray(str.start());
-    return GetCopy(format);
-  }
-  return AddOrDisposeString(str.start(), len);
+  if (len == -1) return GetCopy(format);
+  return GetCopy(str.start());
 }
 
 const char* StringsStorage::GetName(Name* name) {
@@ -106,6 +108,12 @@ const char* StringsStorage::GetConsName(const char* prefix, Name* name) {
   return "";
 }
 
+size_t StringsStorage::GetUsedMemorySize() {
+  base::LockGuard<base::Mutex> guard(&mutex_);
+  return strings_size_ +
+         names_.capacity() * sizeof(base::CustomMatcherHashMap::Entry);
+}
+
 base::HashMap::Entry* StringsStorage::GetEntry(const char* str, int len) {
   uint32_t hash = StringHasher::HashSequentialString(str, len, kZeroHashSeed);
   return names_.LookupOrInsert(const_cast<char*>(str), hash);
@@ -9,6 +9,7 @@
 
 #include "src/base/compiler-specific.h"
 #include "src/base/hashmap.h"
+#include "src/base/platform/mutex.h"
 #include "src/globals.h"
 
 namespace v8 {
@@ -18,6 +19,7 @@ class Name;
 
 // Provides a storage of strings allocated in C++ heap, to hold them
 // forever, even if they disappear from JS heap or external storage.
+// The storage can be used from several threads at once.
 class V8_EXPORT_PRIVATE StringsStorage {
  public:
   StringsStorage();
@@ -35,6 +37,8 @@ class V8_EXPORT_PRIVATE StringsStorage {
   // Appends string resulting from name to prefix, then returns the stored
   // result.
   const char* GetConsName(const char* prefix, Name* name);
+  // Returns the number of bytes taken by the stored strings and the table.
+  size_t GetUsedMemorySize();
 
  private:
   static bool StringsMatch(void* key1, void* key2);
@@ -46,6 +50,9 @@ class V8_EXPORT_PRIVATE StringsStorage {
   const char* GetVFormatted(const char* format, va_list args);
 
   base::CustomMatcherHashMap names_;
+  // The total length of the stored strings, including the terminators.
+  size_t strings_size_;
+  base::Mutex mutex_;
 
   DISALLOW_COPY_AND_ASSIGN(StringsStorage);
 };
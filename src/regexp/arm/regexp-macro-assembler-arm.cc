@@ -150,6 +150,17 @@ void RegExpMacroAssemblerARM::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerARM::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    Label next;
+    __ ldr(r0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ add(r0, r0, Operand(1));
+    __ str(r0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ cmp(r0, Operand(backtrack_limit()));
+    __ b(ne, &next);
+    // Exceeded the limit; retry the match on the NFA engine.
+    __ jmp(&fallback_label_);
+    __ bind(&next);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r0);
   __ add(pc, r0, Operand(code_pointer()));
@@ -643,6 +654,7 @@ Handle<HeapObject> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
   __ mov(r0, Operand::Zero());
   __ push(r0);  // Make room for success counter and initialize it to 0.
   __ push(r0);  // Make room for "string start - 1" constant.
+  __ push(r0);  // The backtrack counter.
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
   Label stack_ok;
@@ -703,6 +715,11 @@ Handle<HeapObject> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
   // Load previous char as initial value of current character register.
   LoadCurrentCharacterUnchecked(-1, 1);
   __ bind(&start_regexp);
+  // Every match attempt of a global regexp gets the full backtrack limit.
+  if (has_backtrack_limit()) {
+    __ mov(r1, Operand::Zero());
+    __ str(r1, MemOperand(frame_pointer(), kBacktrackCount));
+  }
 
   // Initialize on-stack registers.
   if (num_saved_registers_ > 0) {  // Always is, if generated from a regexp.
@@ -884,6 +901,12 @@ Handle<HeapObject> RegExpMacroAssemblerARM::GetCode(Handle<String> source) {
     __ jmp(&return_r0);
   }
 
+  if (fallback_label_.is_linked()) {
+    __ bind(&fallback_label_);
+    __ mov(r0, Operand(FALLBACK_TO_NFA));
+    __ jmp(&return_r0);
+  }
+
   CodeDesc code_desc;
   masm_->GetCode(isolate(), &code_desc);
   Handle<Code> code = isolate()->factory()->NewCode(code_desc, Code::REGEXP,
@@ -180,6 +180,17 @@ void RegExpMacroAssemblerARM64::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerARM64::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    Label next;
+    __ Ldr(w10, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Add(w10, w10, 1);
+    __ Str(w10, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Cmp(w10, backtrack_limit());
+    __ B(ne, &next);
+    // Exceeded the limit; retry the match on the NFA engine.
+    __ B(&fallback_label_);
+    __ Bind(&next);
+  }
   Pop(w10);
   __ Add(x10, code_pointer(), Operand(w10, UXTW));
   __ Br(x10);
@@ -732,12 +743,13 @@ Handle<HeapObject> RegExpMacroAssemblerARM64::GetCode(Handle<String> source) {
 
   // Set the number of registers we will need to allocate, that is:
   //   - success_counter (X register)
+  //   - backtrack_count (X register)
   //   - (num_registers_ - kNumCachedRegisters) (W registers)
   int num_wreg_to_allocate = num_registers_ - kNumCachedRegisters;
   // Do not allocate registers on the stack if they can all be cached.
   if (num_wreg_to_allocate < 0) { num_wreg_to_allocate = 0; }
-  // Make room for the success_counter.
-  num_wreg_to_allocate += 2;
+  // Make room for the success_counter and the backtrack_count.
+  num_wreg_to_allocate += 4;
 
   // Make sure the stack alignment will be respected.
   int alignment = masm_->ActivationFrameAlignment();
@@ -778,8 +790,9 @@ Handle<HeapObject> RegExpMacroAssemblerARM64::GetCode(Handle<String> source) {
   // Allocate space on stack.
   __ Claim(num_wreg_to_allocate, kWRegSize);
 
-  // Initialize success_counter with 0.
+  // Initialize success_counter and backtrack_count with 0.
   __ Str(wzr, MemOperand(frame_pointer(), kSuccessCounter));
+  __ Str(wzr, MemOperand(frame_pointer(), kBacktrackCount));
 
   // Find negative length (offset of start relative to end).
   __ Sub(x10, input_start(), input_end());
@@ -816,6 +829,10 @@ Handle<HeapObject> RegExpMacroAssemblerARM64::GetCode(Handle<String> source) {
   // Load previous char as initial value of current character register.
   LoadCurrentCharacterUnchecked(-1, 1);
   __ Bind(&start_regexp);
+  // Every match attempt of a global regexp gets the full backtrack limit.
+  if (has_backtrack_limit()) {
+    __ Str(wzr, MemOperand(frame_pointer(), kBacktrackCount));
+  }
   // Initialize on-stack registers.
   if (num_saved_registers_ > 0) {
     ClearRegisters(0, num_saved_registers_ - 1);
@@ -1072,6 +1089,12 @@ Handle<HeapObject> RegExpMacroAssemblerARM64::GetCode(Handle<String> source) {
     __ B(&return_w0);
   }
 
+  if (fallback_label_.is_linked()) {
+    __ Bind(&fallback_label_);
+    __ Mov(w0, FALLBACK_TO_NFA);
+    __ B(&return_w0);
+  }
+
   CodeDesc code_desc;
   masm_->GetCode(isolate(), &code_desc);
   Handle<Code> code = isolate()->factory()->NewCode(code_desc, Code::REGEXP,
@@ -121,11 +121,12 @@ class RegExpMacroAssemblerARM64: public NativeRegExpMacroAssembler {
   // When adding local variables remember to push space for them in
   // the frame in GetCode.
   static const int kSuccessCounter = kInput - kPointerSize;
+  static const int kBacktrackCount = kSuccessCounter - kPointerSize;
   // First position register address on the stack. Following positions are
   // below it. A position is a 32 bit value.
-  static const int kFirstRegisterOnStack = kSuccessCounter - kWRegSize;
+  static const int kFirstRegisterOnStack = kBacktrackCount - kWRegSize;
   // A capture is a 64 bit value holding two position.
-  static const int kFirstCaptureOnStack = kSuccessCounter - kXRegSize;
+  static const int kFirstCaptureOnStack = kBacktrackCount - kXRegSize;
 
   // Initial size of code buffer.
   static const size_t kRegExpCodeSize = 1024;
@@ -284,6 +285,7 @@ class RegExpMacroAssemblerARM64: public NativeRegExpMacroAssembler {
   Label exit_label_;
   Label check_preempt_label_;
   Label stack_overflow_label_;
+  Label fallback_label_;
 };
 
 #endif  // V8_INTERPRETED_REGEXP
@@ -16,11 +16,14 @@ namespace internal {
 
 class IrregexpInterpreter {
  public:
+  // Returns RE_FALLBACK_TO_NFA if the match backtracks more than
+  // {backtrack_limit} times, unless that is JSRegExp::kNoBacktrackLimit.
   static RegExpImpl::IrregexpResult Match(Isolate* isolate,
                                           Handle<ByteArray> code,
                                           Handle<String> subject,
                                           int* captures,
-                                          int start_position);
+                                          int start_position,
+                                          int backtrack_limit);
 };
 
 
@@ -21,6 +21,7 @@
 #include "src/regexp/regexp-macro-assembler-irregexp.h"
 #include "src/regexp/regexp-macro-assembler-tracer.h"
 #include "src/regexp/regexp-macro-assembler.h"
+#include "src/regexp/regexp-nfa.h"
 #include "src/regexp/regexp-parser.h"
 #include "src/regexp/regexp-stack.h"
 #include "src/runtime/runtime.h"
@@ -175,7 +176,23 @@ MaybeHandle<Object> RegExpImpl::Compile(Isolate* isolate, Handle<JSRegExp> re,
     }
   }
   if (!has_been_compiled) {
-    IrregexpInitialize(isolate, re, pattern, flags, parse_result.capture_count);
+    if ((FLAG_regexp_nfa || FLAG_regexp_nfa_on_excessive_backtracks) &&
+        RegExpNfa::CanBeHandled(parse_result.tree, flags,
+                                parse_result.capture_count, &zone)) {
+      if (FLAG_regexp_nfa) {
+        NfaInitialize(isolate, re, pattern, flags, &parse_result);
+      } else {
+        int backtrack_limit = static_cast<int>(
+            Min(FLAG_regexp_backtracks_before_fallback,
+                static_cast<unsigned>(Smi::kMaxValue)));
+        IrregexpInitialize(isolate, re, pattern, flags,
+                           parse_result.capture_count, backtrack_limit);
+      }
+    } else {
+      IrregexpInitialize(isolate, re, pattern, flags,
+                         parse_result.capture_count,
+                         JSRegExp::kNoBacktrackLimit);
+    }
   }
   DCHECK(re->data()->IsFixedArray());
   // Compilation succeeded so the data is set on the regexp
@@ -195,6 +212,8 @@ MaybeHandle<Object> RegExpImpl::Exec(Isolate* isolate, Handle<JSRegExp> regexp,
     case JSRegExp::IRREGEXP: {
       return IrregexpExec(isolate, regexp, subject, index, last_match_info);
     }
+    case JSRegExp::NFA:
+      return NfaExec(isolate, regexp, subject, index, last_match_info);
     default:
       UNREACHABLE();
   }
@@ -336,9 +355,9 @@ bool RegExpImpl::CompileIrregexp(Isolate* isolate, Handle<JSRegExp> re,
     USE(ThrowRegExpException(isolate, re, pattern, compile_data.error));
     return false;
   }
-  RegExpEngine::CompilationResult result =
-      RegExpEngine::Compile(isolate, &zone, &compile_data, flags, pattern,
-                            sample_subject, is_one_byte);
+  RegExpEngine::CompilationResult result = RegExpEngine::Compile(
+      isolate, &zone, &compile_data, flags, pattern, sample_subject,
+      is_one_byte, IrregexpBacktrackLimit(FixedArray::cast(re->data())));
   if (result.error_message != nullptr) {
     // Unable to compile regexp.
     if (FLAG_abort_on_stack_or_string_length_overflow &&
@@ -402,18 +421,71 @@ Code* RegExpImpl::IrregexpNativeCode(FixedArray* re, bool is_one_byte) {
   return Code::cast(re->get(JSRegExp::code_index(is_one_byte)));
 }
 
+int RegExpImpl::IrregexpBacktrackLimit(FixedArray* re) {
+  return Smi::ToInt(re->get(JSRegExp::kIrregexpBacktrackLimitIndex));
+}
+
 void RegExpImpl::IrregexpInitialize(Isolate* isolate, Handle<JSRegExp> re,
                                     Handle<String> pattern,
-                                    JSRegExp::Flags flags, int capture_count) {
+                                    JSRegExp::Flags flags, int capture_count,
+                                    int backtrack_limit) {
   // Initialize compiled code entries to null.
   isolate->factory()->SetRegExpIrregexpData(re, JSRegExp::IRREGEXP, pattern,
-                                            flags, capture_count);
+                                            flags, capture_count,
+                                            backtrack_limit);
+}
+
+void RegExpImpl::NfaInitialize(Isolate* isolate, Handle<JSRegExp> re,
+                               Handle<String> pattern, JSRegExp::Flags flags,
+                               RegExpCompileData* parse_result) {
+  Zone zone(isolate->allocator(), ZONE_NAME);
+  isolate->factory()->SetRegExpIrregexpData(re, JSRegExp::NFA, pattern, flags,
+                                            parse_result->capture_count,
+                                            JSRegExp::kNoBacktrackLimit);
+  Handle<ByteArray> program =
+      RegExpNfa::Compile(isolate, parse_result->tree, &zone);
+  FixedArray* data = FixedArray::cast(re->data());
+  data->set(JSRegExp::kIrregexpNfaProgramIndex, *program);
+  SetIrregexpCaptureNameMap(data, parse_result->capture_name_map);
+}
+
+bool RegExpImpl::EnsureCompiledNfa(Isolate* isolate, Handle<JSRegExp> re) {
+  if (re->DataAt(JSRegExp::kIrregexpNfaProgramIndex)->IsByteArray()) {
+    return true;
+  }
+  // Only Irregexp regexps with a backtrack limit compile the program lazily,
+  // when their code first bails out.
+  DCHECK_EQ(JSRegExp::IRREGEXP, re->TypeTag());
+  DCHECK_NE(JSRegExp::kNoBacktrackLimit,
+            IrregexpBacktrackLimit(FixedArray::cast(re->data())));
+  Zone zone(isolate->allocator(), ZONE_NAME);
+  PostponeInterruptsScope postpone(isolate);
+  Handle<String> pattern(re->Pattern(), isolate);
+  pattern = String::Flatten(isolate, pattern);
+  RegExpCompileData compile_data;
+  FlatStringReader reader(isolate, pattern);
+  if (!RegExpParser::ParseRegExp(isolate, &zone, &reader, re->GetFlags(),
+                                 &compile_data)) {
+    // THIS SHOULD NOT HAPPEN. We already pre-parsed it successfully once.
+    USE(ThrowRegExpException(isolate, re, pattern, compile_data.error));
+    return false;
+  }
+  Handle<ByteArray> program =
+      RegExpNfa::Compile(isolate, compile_data.tree, &zone);
+  re->SetDataAt(JSRegExp::kIrregexpNfaProgramIndex, *program);
+  return true;
 }
 
 int RegExpImpl::IrregexpPrepare(Isolate* isolate, Handle<JSRegExp> regexp,
                                 Handle<String> subject) {
   DCHECK(subject->IsFlat());
 
+  if (regexp->TypeTag() == JSRegExp::NFA) {
+    // The NFA engine only needs room to output captures.
+    return (IrregexpNumberOfCaptures(FixedArray::cast(regexp->data())) + 1) *
+           2;
+  }
+
   // Check representation of the underlying storage.
   bool is_one_byte = subject->IsOneByteRepresentationUnderneath();
   if (!EnsureCompiledIrregexp(isolate, regexp, subject, is_one_byte)) return -1;
@@ -435,6 +507,10 @@ int RegExpImpl::IrregexpPrepare(Isolate* isolate, Handle<JSRegExp> regexp,
 int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
                                 Handle<String> subject, int index,
                                 int32_t* output, int output_size) {
+  if (regexp->TypeTag() == JSRegExp::NFA) {
+    return NfaExecRaw(isolate, regexp, subject, index, output, output_size);
+  }
+
   Handle<FixedArray> irregexp(FixedArray::cast(regexp->data()), isolate);
 
   DCHECK_LE(0, index);
@@ -459,6 +535,10 @@ int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
                                           output_size,
                                           index,
                                           isolate);
+    if (res == NativeRegExpMacroAssembler::FALLBACK_TO_NFA) {
+      // The code exceeded the backtrack limit of the regexp.
+      return NfaExecRaw(isolate, regexp, subject, index, output, output_size);
+    }
     if (res != NativeRegExpMacroAssembler::RETRY) {
       DCHECK(res != NativeRegExpMacroAssembler::EXCEPTION ||
              isolate->has_pending_exception());
@@ -497,11 +577,15 @@ int RegExpImpl::IrregexpExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
   Handle<ByteArray> byte_codes(IrregexpByteCode(*irregexp, is_one_byte),
                                isolate);
 
-  IrregexpResult result = IrregexpInterpreter::Match(isolate,
-                                                     byte_codes,
-                                                     subject,
-                                                     raw_output,
-                                                     index);
+  IrregexpResult result =
+      IrregexpInterpreter::Match(isolate, byte_codes, subject, raw_output,
+                                 index, IrregexpBacktrackLimit(*irregexp));
+  if (result == RE_FALLBACK_TO_NFA) {
+    // The bytecode exceeded the backtrack limit of the regexp. Like the
+    // interpreter, only look for a single match.
+    return NfaExecRaw(isolate, regexp, subject, index, output,
+                      number_of_capture_registers);
+  }
   if (result == RE_SUCCESS) {
     // Copy capture results to the start of the registers array.
     MemCopy(output, raw_output, number_of_capture_registers * sizeof(int32_t));
@@ -563,6 +647,52 @@ MaybeHandle<Object> RegExpImpl::IrregexpExec(
   return isolate->factory()->null_value();
 }
 
+int RegExpImpl::NfaExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
+                           Handle<String> subject, int index, int32_t* output,
+                           int output_size) {
+  DCHECK(JSRegExp::TypeSupportsCaptures(regexp->TypeTag()));
+  DCHECK_LE(0, index);
+  DCHECK_LE(index, subject->length());
+  DCHECK(subject->IsFlat());
+
+  if (!EnsureCompiledNfa(isolate, regexp)) return RE_EXCEPTION;
+
+  FixedArray* data = FixedArray::cast(regexp->data());
+  ByteArray* program =
+      ByteArray::cast(data->get(JSRegExp::kIrregexpNfaProgramIndex));
+  return RegExpNfa::Match(program, *subject, index,
+                          IrregexpNumberOfCaptures(data), regexp->GetFlags(),
+                          output, output_size);
+}
+
+MaybeHandle<Object> RegExpImpl::NfaExec(
+    Isolate* isolate, Handle<JSRegExp> regexp, Handle<String> subject,
+    int previous_index, Handle<RegExpMatchInfo> last_match_info) {
+  subject = String::Flatten(isolate, subject);
+
+  int capture_count =
+      IrregexpNumberOfCaptures(FixedArray::cast(regexp->data()));
+  int required_registers = (capture_count + 1) * 2;
+  int32_t* output_registers = nullptr;
+  if (required_registers > Isolate::kJSRegexpStaticOffsetsVectorSize) {
+    output_registers = NewArray<int32_t>(required_registers);
+  }
+  std::unique_ptr<int32_t[]> auto_release(output_registers);
+  if (output_registers == nullptr) {
+    output_registers = isolate->jsregexp_static_offsets_vector();
+  }
+
+  int res = NfaExecRaw(isolate, regexp, subject, previous_index,
+                       output_registers, required_registers);
+  if (res == RE_EXCEPTION) {
+    DCHECK(isolate->has_pending_exception());
+    return MaybeHandle<Object>();
+  }
+  if (res == RE_FAILURE) return isolate->factory()->null_value();
+  return SetLastMatchInfo(isolate, last_match_info, subject, capture_count,
+                          output_registers);
+}
+
 Handle<RegExpMatchInfo> RegExpImpl::SetLastMatchInfo(
     Isolate* isolate, Handle<RegExpMatchInfo> last_match_info,
     Handle<String> subject, int capture_count, int32_t* match) {
@@ -623,6 +753,8 @@ RegExpImpl::GlobalCache::GlobalCache(Handle<JSRegExp> regexp,
       num_matches_ = -1;  // Signal exception.
       return;
     }
+    // The NFA engine finds several matches at once, like native code.
+    if (regexp_->TypeTag() == JSRegExp::NFA) interpreted = false;
   }
 
   DCHECK(IsGlobal(regexp->GetFlags()));
@@ -6630,7 +6762,7 @@ RegExpNode* OptionallyStepBackToLeadSurrogate(RegExpCompiler* compiler,
 RegExpEngine::CompilationResult RegExpEngine::Compile(
     Isolate* isolate, Zone* zone, RegExpCompileData* data,
     JSRegExp::Flags flags, Handle<String> pattern,
-    Handle<String> sample_subject, bool is_one_byte) {
+    Handle<String> sample_subject, bool is_one_byte, int backtrack_limit) {
   if ((data->capture_count + 1) * 2 - 1 > RegExpMacroAssembler::kMaxRegister) {
     return IrregexpRegExpTooBig(isolate);
   }
@@ -6748,6 +6880,7 @@ RegExpEngine::CompilationResult RegExpEngine::Compile(
 #endif  // V8_INTERPRETED_REGEXP
 
   macro_assembler.set_slow_safe(TooMuchRegExpCode(isolate, pattern));
+  macro_assembler.set_backtrack_limit(backtrack_limit);
 
   // Inserted here, instead of in Assembler, because it depends on information
   // in the AST that isn't replicated in the Node structure.
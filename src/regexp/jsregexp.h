@@ -21,6 +21,7 @@ class RegExpMacroAssembler;
 class RegExpNode;
 class RegExpTree;
 class BoyerMooreLookahead;
+struct RegExpCompileData;
 
 inline bool IgnoreCase(JSRegExp::Flags flags) {
   return (flags & JSRegExp::kIgnoreCase) != 0;
@@ -85,7 +86,13 @@ class RegExpImpl {
   // Prepares a JSRegExp object with Irregexp-specific data.
   static void IrregexpInitialize(Isolate* isolate, Handle<JSRegExp> re,
                                  Handle<String> pattern, JSRegExp::Flags flags,
-                                 int capture_register_count);
+                                 int capture_register_count,
+                                 int backtrack_limit);
+
+  // Prepares a JSRegExp object for the NFA engine.
+  static void NfaInitialize(Isolate* isolate, Handle<JSRegExp> re,
+                            Handle<String> pattern, JSRegExp::Flags flags,
+                            RegExpCompileData* parse_result);
 
   static void AtomCompile(Isolate* isolate, Handle<JSRegExp> re,
                           Handle<String> pattern, JSRegExp::Flags flags,
@@ -99,7 +106,14 @@ class RegExpImpl {
                                  Handle<String> subject, int index,
                                  Handle<RegExpMatchInfo> last_match_info);
 
-  enum IrregexpResult { RE_FAILURE = 0, RE_SUCCESS = 1, RE_EXCEPTION = -1 };
+  // RE_FALLBACK_TO_NFA is only used internally, when the Irregexp bytecode
+  // exceeds the backtrack limit of the regexp.
+  enum IrregexpResult {
+    RE_FAILURE = 0,
+    RE_SUCCESS = 1,
+    RE_EXCEPTION = -1,
+    RE_FALLBACK_TO_NFA = -2
+  };
 
   // Prepare a RegExp for being executed one or more times (using
   // IrregexpExecOnce) on the subject.
@@ -129,6 +143,17 @@ class RegExpImpl {
       Isolate* isolate, Handle<JSRegExp> regexp, Handle<String> subject,
       int index, Handle<RegExpMatchInfo> last_match_info);
 
+  // Execute a regular expression on the NFA engine. Besides NFA regexps,
+  // this also works for Irregexp regexps with a backtrack limit, whose code
+  // bails out to the NFA engine.
+  static int NfaExecRaw(Isolate* isolate, Handle<JSRegExp> regexp,
+                        Handle<String> subject, int index, int32_t* output,
+                        int output_size);
+
+  V8_WARN_UNUSED_RESULT static MaybeHandle<Object> NfaExec(
+      Isolate* isolate, Handle<JSRegExp> regexp, Handle<String> subject,
+      int index, Handle<RegExpMatchInfo> last_match_info);
+
   // Set last match info.  If match is nullptr, then setting captures is
   // omitted.
   static Handle<RegExpMatchInfo> SetLastMatchInfo(
@@ -177,6 +202,7 @@ class RegExpImpl {
   static int IrregexpNumberOfRegisters(FixedArray* re);
   static ByteArray* IrregexpByteCode(FixedArray* re, bool is_one_byte);
   static Code* IrregexpNativeCode(FixedArray* re, bool is_one_byte);
+  static int IrregexpBacktrackLimit(FixedArray* re);
 
   // Limit the space regexps take up on the heap.  In order to limit this we
   // would like to keep track of the amount of regexp code on the heap.  This
@@ -194,6 +220,7 @@ class RegExpImpl {
                                             Handle<JSRegExp> re,
                                             Handle<String> sample_subject,
                                             bool is_one_byte);
+  static bool EnsureCompiledNfa(Isolate* isolate, Handle<JSRegExp> re);
 };
 
 
@@ -1528,7 +1555,7 @@ class RegExpEngine: public AllStatic {
                                    JSRegExp::Flags flags,
                                    Handle<String> pattern,
                                    Handle<String> sample_subject,
-                                   bool is_one_byte);
+                                   bool is_one_byte, int backtrack_limit);
 
   static bool TooMuchRegExpCode(Isolate* isolate, Handle<String> pattern);
 
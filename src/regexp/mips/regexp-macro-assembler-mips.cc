@@ -156,6 +156,16 @@ void RegExpMacroAssemblerMIPS::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerMIPS::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    Label next;
+    __ lw(a0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Addu(a0, a0, Operand(1));
+    __ sw(a0, MemOperand(frame_pointer(), kBacktrackCount));
+    __ Branch(&next, ne, a0, Operand(backtrack_limit()));
+    // Exceeded the limit; retry the match on the NFA engine.
+    __ jmp(&fallback_label_);
+    __ bind(&next);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(a0);
   __ Addu(a0, a0, code_pointer());
@@ -642,6 +652,7 @@ Handle<HeapObject> RegExpMacroAssemblerMIPS::GetCode(Handle<String> source) {
     __ mov(a0, zero_reg);
     __ push(a0);  // Make room for success counter and initialize it to 0.
     __ push(a0);  // Make room for "string start - 1" constant.
+    __ push(a0);  // The backtrack counter.
 
     // Check if we have space on the stack for registers.
     Label stack_limit_hit;
@@ -700,6 +711,10 @@ Handle<HeapObject> RegExpMacroAssemblerMIPS::GetCode(Handle<String> source) {
     // Load previous char as initial value of current character register.
     LoadCurrentCharacterUnchecked(-1, 1);
     __ bind(&start_regexp);
+    // Every match attempt of a global regexp gets the full backtrack limit.
+    if (has_backtrack_limit()) {
+      __ sw(zero_reg, MemOperand(frame_pointer(), kBacktrackCount));
+    }
 
     // Initialize on-stack registers.
     if (num_saved_registers_ > 0) {  // Always is, if generated from a regexp.
@@ -896,6 +911,12 @@ Handle<HeapObject> RegExpMacroAssemblerMIPS::GetCode(Handle<String> source) {
       __ li(v0, Operand(EXCEPTION));
       __ jmp(&return_v0);
     }
+
+    if (fallback_label_.is_linked()) {
+      __ bind(&fallback_label_);
+      __ li(v0, Operand(FALLBACK_TO_NFA));
+      __ jmp(&return_v0);
+    }
   }
 
   CodeDesc code_desc;
@@ -162,6 +162,17 @@ void RegExpMacroAssemblerPPC::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerPPC::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    Label next;
+    __ LoadP(r3, MemOperand(frame_pointer(), kBacktrackCount), r0);
+    __ addi(r3, r3, Operand(1));
+    __ StoreP(r3, MemOperand(frame_pointer(), kBacktrackCount), r0);
+    __ Cmpi(r3, Operand(backtrack_limit()), r0);
+    __ bne(&next);
+    // Exceeded the limit; retry the match on the NFA engine.
+    __ b(&fallback_label_);
+    __ bind(&next);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r3);
   __ add(r3, r3, code_pointer());
@@ -679,6 +690,7 @@ Handle<HeapObject> RegExpMacroAssemblerPPC::GetCode(Handle<String> source) {
     __ li(r3, Operand::Zero());
     __ push(r3);  // Make room for success counter and initialize it to 0.
     __ push(r3);  // Make room for "string start - 1" constant.
+    __ push(r3);  // The backtrack counter.
     // Check if we have space on the stack for registers.
     Label stack_limit_hit;
     Label stack_ok;
@@ -744,6 +756,11 @@ Handle<HeapObject> RegExpMacroAssemblerPPC::GetCode(Handle<String> source) {
     // Load previous char as initial value of current character register.
     LoadCurrentCharacterUnchecked(-1, 1);
     __ bind(&start_regexp);
+    // Every match attempt of a global regexp gets the full backtrack limit.
+    if (has_backtrack_limit()) {
+      __ li(r4, Operand::Zero());
+      __ StoreP(r4, MemOperand(frame_pointer(), kBacktrackCount), r0);
+    }
 
     // Initialize on-stack registers.
     if (num_saved_registers_ > 0) {  // Always is, if generated from a regexp.
@@ -931,6 +948,12 @@ Handle<HeapObject> RegExpMacroAssemblerPPC::GetCode(Handle<String> source) {
       __ li(r3, Operand(EXCEPTION));
       __ b(&return_r3);
     }
+
+    if (fallback_label_.is_linked()) {
+      __ bind(&fallback_label_);
+      __ li(r3, Operand(FALLBACK_TO_NFA));
+      __ b(&return_r3);
+    }
   }
 
   CodeDesc code_desc;
@@ -20,6 +20,7 @@ namespace internal {
 RegExpMacroAssembler::RegExpMacroAssembler(Isolate* isolate, Zone* zone)
     : slow_safe_compiler_(false),
       global_mode_(NOT_GLOBAL),
+      backtrack_limit_(JSRegExp::kNoBacktrackLimit),
       isolate_(isolate),
       zone_(zone) {}
 
@@ -295,7 +296,7 @@ NativeRegExpMacroAssembler::Result NativeRegExpMacroAssembler::Execute(
   auto fn = GeneratedCode<RegexpMatcherSig>::FromCode(code);
   int result = fn.Call(input, start_offset, input_start, input_end, output,
                        output_size, stack_base, direct_call, isolate);
-  DCHECK(result >= RETRY);
+  DCHECK(result >= FALLBACK_TO_NFA);
 
   if (result == EXCEPTION && !isolate->has_pending_exception()) {
     // We detected a stack overflow (on the backtrack stack) in RegExp code,
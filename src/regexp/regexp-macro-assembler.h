@@ -182,12 +182,21 @@ class RegExpMacroAssembler {
   }
   inline bool global_unicode() { return global_mode_ == GLOBAL_UNICODE; }
 
+  // Code that backtracks more often than this gives up, so the match can be
+  // retried on the NFA engine.
+  void set_backtrack_limit(int limit) { backtrack_limit_ = limit; }
+  int backtrack_limit() const { return backtrack_limit_; }
+  bool has_backtrack_limit() const {
+    return backtrack_limit_ != JSRegExp::kNoBacktrackLimit;
+  }
+
   Isolate* isolate() const { return isolate_; }
   Zone* zone() const { return zone_; }
 
  private:
   bool slow_safe_compiler_;
   GlobalMode global_mode_;
+  int backtrack_limit_;
   Isolate* isolate_;
   Zone* zone_;
 };
@@ -209,7 +218,15 @@ class NativeRegExpMacroAssembler: public RegExpMacroAssembler {
   // FAILURE: Matching failed.
   // SUCCESS: Matching succeeded, and the output array has been filled with
   //        capture positions.
-  enum Result { RETRY = -2, EXCEPTION = -1, FAILURE = 0, SUCCESS = 1 };
+  // FALLBACK_TO_NFA: The backtrack limit was exceeded, and the matching
+  //        should be retried on the NFA engine.
+  enum Result {
+    FALLBACK_TO_NFA = -3,
+    RETRY = -2,
+    EXCEPTION = -1,
+    FAILURE = 0,
+    SUCCESS = 1
+  };
 
   NativeRegExpMacroAssembler(Isolate* isolate, Zone* zone);
   virtual ~NativeRegExpMacroAssembler();
@@ -0,0 +1,721 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/regexp/regexp-nfa.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "src/char-predicates-inl.h"
+#include "src/heap/factory.h"
+#include "src/isolate.h"
+#include "src/objects-inl.h"
+#include "src/regexp/regexp-ast.h"
+#include "src/unicode.h"
+#include "src/zone/zone-list-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+// The program of the NFA engine is an array of instructions, stored in a
+// ByteArray. Every thread of the simulated automaton has a program counter
+// and its own copy of the capture registers.
+struct NfaInstruction {
+  enum Opcode : int32_t {
+    // The thread has found a match.
+    ACCEPT,
+    // The thread continues only if the assertion holds at the current
+    // position.
+    ASSERTION,
+    // Sets a register to -1, i.e. makes the capture undefined.
+    CLEAR_REGISTER,
+    // Consumes the current character if it is in one of the {range_count}
+    // RANGE instructions that follow, and kills the thread otherwise.
+    CONSUME_RANGES,
+    // Continues at the next instruction, and starts a new thread at {pc}
+    // which has a lower priority than the current one.
+    FORK,
+    // Continues at {pc}.
+    JMP,
+    // An operand of CONSUME_RANGES. Never executed.
+    RANGE,
+    // Stores the current position in a register.
+    SET_REGISTER_TO_CP,
+  };
+
+  static NfaInstruction Accept() { return NfaInstruction(ACCEPT); }
+
+  static NfaInstruction Assertion(RegExpAssertion::AssertionType type) {
+    NfaInstruction result(ASSERTION);
+    result.payload.assertion_type = type;
+    return result;
+  }
+
+  static NfaInstruction ClearRegister(int register_index) {
+    NfaInstruction result(CLEAR_REGISTER);
+    result.payload.register_index = register_index;
+    return result;
+  }
+
+  static NfaInstruction ConsumeRanges(int range_count) {
+    NfaInstruction result(CONSUME_RANGES);
+    result.payload.range_count = range_count;
+    return result;
+  }
+
+  static NfaInstruction Fork(int pc) {
+    NfaInstruction result(FORK);
+    result.payload.pc = pc;
+    return result;
+  }
+
+  static NfaInstruction Jmp(int pc) {
+    NfaInstruction result(JMP);
+    result.payload.pc = pc;
+    return result;
+  }
+
+  static NfaInstruction Range(uc16 from, uc16 to) {
+    NfaInstruction result(RANGE);
+    result.payload.range.from = from;
+    result.payload.range.to = to;
+    return result;
+  }
+
+  static NfaInstruction SetRegisterToCp(int register_index) {
+    NfaInstruction result(SET_REGISTER_TO_CP);
+    result.payload.register_index = register_index;
+    return result;
+  }
+
+  Opcode opcode;
+  union {
+    // FORK and JMP.
+    int32_t pc;
+    // CLEAR_REGISTER and SET_REGISTER_TO_CP.
+    int32_t register_index;
+    // CONSUME_RANGES.
+    int32_t range_count;
+    // ASSERTION.
+    RegExpAssertion::AssertionType assertion_type;
+    // RANGE.
+    struct {
+      uc16 from;
+      uc16 to;
+    } range;
+  } payload;
+
+ private:
+  explicit NfaInstruction(Opcode opcode) : opcode(opcode) { payload.pc = 0; }
+};
+
+STATIC_ASSERT(sizeof(NfaInstruction) == 2 * kInt32Size);
+
+// Unrolling bounded quantifiers can make the program much longer than the
+// pattern, e.g. for /(a{100}){100}/. Longer programs are not supported.
+const int kMaxProgramLength = 1 << 14;
+
+// Every thread has its own copy of the capture registers, and there can be
+// a thread for every instruction. This bounds the memory that takes.
+const int kMaxThreadRegisters = 1 << 22;
+
+class CanBeHandledVisitor final : private RegExpVisitor {
+ public:
+  static bool Check(RegExpTree* tree, JSRegExp::Flags flags) {
+    if (!AreSupported(flags)) return false;
+    CanBeHandledVisitor visitor;
+    tree->Accept(&visitor, nullptr);
+    return visitor.result_;
+  }
+
+ private:
+  CanBeHandledVisitor() : result_(true) {}
+
+  // Case-insensitive matching would need the canonicalization of Irregexp,
+  // and unicode regexps would need to match surrogate pairs as one
+  // character.
+  static bool AreSupported(JSRegExp::Flags flags) {
+    return (flags & (JSRegExp::kIgnoreCase | JSRegExp::kUnicode)) == 0;
+  }
+
+  void VisitAll(ZoneList<RegExpTree*>* trees) {
+    for (int i = 0; i < trees->length() && result_; i++) {
+      trees->at(i)->Accept(this, nullptr);
+    }
+  }
+
+  void* VisitDisjunction(RegExpDisjunction* node, void*) override {
+    VisitAll(node->alternatives());
+    return nullptr;
+  }
+
+  void* VisitAlternative(RegExpAlternative* node, void*) override {
+    VisitAll(node->nodes());
+    return nullptr;
+  }
+
+  void* VisitAssertion(RegExpAssertion* node, void*) override {
+    return nullptr;
+  }
+
+  void* VisitCharacterClass(RegExpCharacterClass* node, void*) override {
+    result_ = result_ && AreSupported(node->flags());
+    return nullptr;
+  }
+
+  void* VisitAtom(RegExpAtom* node, void*) override {
+    result_ = result_ && AreSupported(node->flags());
+    return nullptr;
+  }
+
+  void* VisitText(RegExpText* node, void*) override {
+    for (int i = 0; i < node->elements()->length() && result_; i++) {
+      node->elements()->at(i).tree()->Accept(this, nullptr);
+    }
+    return nullptr;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* node, void*) override {
+    if (node->is_possessive()) {
+      result_ = false;
+      return nullptr;
+    }
+    // An iteration beyond the minimum fails if it matches the empty string.
+    // Whether a thread is killed by that check depends on its registers, so
+    // threads at the same instruction could no longer be merged.
+    if (node->max() > node->min() && node->body()->min_match() == 0) {
+      result_ = false;
+      return nullptr;
+    }
+    node->body()->Accept(this, nullptr);
+    return nullptr;
+  }
+
+  void* VisitCapture(RegExpCapture* node, void*) override {
+    node->body()->Accept(this, nullptr);
+    return nullptr;
+  }
+
+  void* VisitGroup(RegExpGroup* node, void*) override {
+    node->body()->Accept(this, nullptr);
+    return nullptr;
+  }
+
+  void* VisitLookaround(RegExpLookaround* node, void*) override {
+    result_ = false;
+    return nullptr;
+  }
+
+  void* VisitBackReference(RegExpBackReference* node, void*) override {
+    result_ = false;
+    return nullptr;
+  }
+
+  void* VisitEmpty(RegExpEmpty* node, void*) override { return nullptr; }
+
+  bool result_;
+};
+
+class NfaCompiler final : private RegExpVisitor {
+ public:
+  // Returns nullptr if the program would be longer than kMaxProgramLength.
+  static ZoneList<NfaInstruction>* Compile(RegExpTree* tree, Zone* zone) {
+    NfaCompiler compiler(zone);
+    compiler.Emit(NfaInstruction::SetRegisterToCp(
+        RegExpCapture::StartRegister(0)));
+    tree->Accept(&compiler, nullptr);
+    compiler.Emit(
+        NfaInstruction::SetRegisterToCp(RegExpCapture::EndRegister(0)));
+    compiler.Emit(NfaInstruction::Accept());
+    if (compiler.too_long_) return nullptr;
+    return compiler.code_;
+  }
+
+ private:
+  explicit NfaCompiler(Zone* zone)
+      : code_(new (zone) ZoneList<NfaInstruction>(16, zone)),
+        too_long_(false),
+        zone_(zone) {}
+
+  int pc() const { return code_->length(); }
+
+  void Emit(NfaInstruction instruction) {
+    if (pc() >= kMaxProgramLength) {
+      too_long_ = true;
+      return;
+    }
+    code_->Add(instruction, zone_);
+  }
+
+  // Sets the target of the FORK or JMP instruction at {pc}.
+  void Patch(int pc, int target) {
+    if (pc >= code_->length()) return;
+    DCHECK(code_->at(pc).opcode == NfaInstruction::FORK ||
+           code_->at(pc).opcode == NfaInstruction::JMP);
+    code_->at(pc).payload.pc = target;
+  }
+
+  void EmitConsumeRanges(ZoneList<CharacterRange>* ranges) {
+    DCHECK(CharacterRange::IsCanonical(ranges));
+    // Only non-unicode regexps are supported, which match code units.
+    int count = 0;
+    while (count < ranges->length() &&
+           ranges->at(count).from() <= String::kMaxUtf16CodeUnit) {
+      count++;
+    }
+    Emit(NfaInstruction::ConsumeRanges(count));
+    for (int i = 0; i < count; i++) {
+      CharacterRange range = ranges->at(i);
+      uc32 to = std::min(range.to(), String::kMaxUtf16CodeUnit);
+      Emit(NfaInstruction::Range(static_cast<uc16>(range.from()),
+                                 static_cast<uc16>(to)));
+    }
+  }
+
+  void EmitCharacter(uc16 c) {
+    Emit(NfaInstruction::ConsumeRanges(1));
+    Emit(NfaInstruction::Range(c, c));
+  }
+
+  // Emits one iteration of a quantifier. Captures within the body are reset
+  // at the start of every iteration.
+  void EmitIteration(RegExpTree* body) {
+    Interval registers = body->CaptureRegisters();
+    if (!registers.is_empty()) {
+      for (int i = registers.from(); i <= registers.to(); i++) {
+        Emit(NfaInstruction::ClearRegister(i));
+      }
+    }
+    body->Accept(this, nullptr);
+  }
+
+  void* VisitDisjunction(RegExpDisjunction* node, void*) override {
+    // Alternatives are tried in order: the FORK before each alternative
+    // starts a thread for the remaining ones with a lower priority.
+    ZoneList<RegExpTree*>* alternatives = node->alternatives();
+    ZoneList<int> jumps_to_end(alternatives->length(), zone_);
+    for (int i = 0; i < alternatives->length() - 1; i++) {
+      int fork = pc();
+      Emit(NfaInstruction::Fork(-1));
+      alternatives->at(i)->Accept(this, nullptr);
+      jumps_to_end.Add(pc(), zone_);
+      Emit(NfaInstruction::Jmp(-1));
+      Patch(fork, pc());
+    }
+    alternatives->last()->Accept(this, nullptr);
+    for (int i = 0; i < jumps_to_end.length(); i++) {
+      Patch(jumps_to_end[i], pc());
+    }
+    return nullptr;
+  }
+
+  void* VisitAlternative(RegExpAlternative* node, void*) override {
+    for (int i = 0; i < node->nodes()->length(); i++) {
+      node->nodes()->at(i)->Accept(this, nullptr);
+    }
+    return nullptr;
+  }
+
+  void* VisitAssertion(RegExpAssertion* node, void*) override {
+    Emit(NfaInstruction::Assertion(node->assertion_type()));
+    return nullptr;
+  }
+
+  void* VisitCharacterClass(RegExpCharacterClass* node, void*) override {
+    ZoneList<CharacterRange>* ranges =
+        new (zone_) ZoneList<CharacterRange>(*node->ranges(zone_), zone_);
+    CharacterRange::Canonicalize(ranges);
+    if (node->is_negated()) {
+      ZoneList<CharacterRange>* negated =
+          new (zone_) ZoneList<CharacterRange>(ranges->length() + 1, zone_);
+      CharacterRange::Negate(ranges, negated, zone_);
+      ranges = negated;
+    }
+    EmitConsumeRanges(ranges);
+    return nullptr;
+  }
+
+  void* VisitAtom(RegExpAtom* node, void*) override {
+    Vector<const uc16> data = node->data();
+    for (int i = 0; i < data.length() && !too_long_; i++) {
+      EmitCharacter(data[i]);
+    }
+    return nullptr;
+  }
+
+  void* VisitText(RegExpText* node, void*) override {
+    for (int i = 0; i < node->elements()->length(); i++) {
+      node->elements()->at(i).tree()->Accept(this, nullptr);
+    }
+    return nullptr;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* node, void*) override {
+    RegExpTree* body = node->body();
+    for (int i = 0; i < node->min() && !too_long_; i++) {
+      EmitIteration(body);
+    }
+    // A greedy quantifier prefers another iteration, so the thread that
+    // continues after the FORK does the iteration. A non-greedy quantifier
+    // prefers to stop, and its FORK starts the iteration in a new thread.
+    if (node->max() == RegExpTree::kInfinity) {
+      int loop = pc();
+      int fork = pc();
+      Emit(NfaInstruction::Fork(-1));
+      int jump_to_end = -1;
+      if (node->is_non_greedy()) {
+        jump_to_end = pc();
+        Emit(NfaInstruction::Jmp(-1));
+        Patch(fork, pc());
+      }
+      EmitIteration(body);
+      Emit(NfaInstruction::Jmp(loop));
+      Patch(node->is_non_greedy() ? jump_to_end : fork, pc());
+    } else {
+      ZoneList<int> exits(node->max() - node->min(), zone_);
+      for (int i = node->min(); i < node->max() && !too_long_; i++) {
+        int fork = pc();
+        Emit(NfaInstruction::Fork(-1));
+        if (node->is_non_greedy()) {
+          exits.Add(pc(), zone_);
+          Emit(NfaInstruction::Jmp(-1));
+          Patch(fork, pc());
+        } else {
+          exits.Add(fork, zone_);
+        }
+        EmitIteration(body);
+      }
+      for (int i = 0; i < exits.length(); i++) Patch(exits[i], pc());
+    }
+    return nullptr;
+  }
+
+  void* VisitCapture(RegExpCapture* node, void*) override {
+    Emit(NfaInstruction::SetRegisterToCp(
+        RegExpCapture::StartRegister(node->index())));
+    node->body()->Accept(this, nullptr);
+    Emit(NfaInstruction::SetRegisterToCp(
+        RegExpCapture::EndRegister(node->index())));
+    return nullptr;
+  }
+
+  void* VisitGroup(RegExpGroup* node, void*) override {
+    node->body()->Accept(this, nullptr);
+    return nullptr;
+  }
+
+  void* VisitLookaround(RegExpLookaround* node, void*) override {
+    UNREACHABLE();
+  }
+
+  void* VisitBackReference(RegExpBackReference* node, void*) override {
+    UNREACHABLE();
+  }
+
+  void* VisitEmpty(RegExpEmpty* node, void*) override { return nullptr; }
+
+  ZoneList<NfaInstruction>* code_;
+  bool too_long_;
+  Zone* zone_;
+};
+
+// Simulates the automaton on a subject. Threads are processed in priority
+// order, which is the order in which a backtracking engine would try them.
+// Only the first thread to reach an instruction at a position survives:
+// registers never influence control flow, so the other threads would
+// behave the same, and their matches have a lower priority.
+template <typename Char>
+class NfaInterpreter {
+ public:
+  NfaInterpreter(Vector<const NfaInstruction> program,
+                 Vector<const Char> input, int register_count, bool sticky)
+      : program_(program),
+        input_(input),
+        register_count_(register_count),
+        sticky_(sticky),
+        visited_(program.length()),
+        best_match_(register_count),
+        found_match_(false),
+        step_(0) {}
+
+  ~NfaInterpreter() {
+    for (int32_t* registers : allocated_registers_) delete[] registers;
+  }
+
+  // Finds the highest-priority match that starts at or after {start}, and
+  // copies its registers to {output}.
+  bool FindMatch(int start, int32_t* output) {
+    DCHECK(active_.empty() && blocked_.empty());
+    std::fill(visited_.begin(), visited_.end(), -1);
+    step_ = -1;
+    found_match_ = false;
+
+    for (int position = start;; position++) {
+      step_++;
+      // Follow the non-consuming instructions of the threads that consumed
+      // the previous character. After a thread has found a match, all
+      // threads with a lower priority are dropped.
+      bool accepted = false;
+      for (const Thread& thread : active_) {
+        if (accepted) {
+          Release(thread);
+        } else {
+          accepted = RunUntilBlocked(thread, position);
+        }
+      }
+      active_.clear();
+
+      // Matches that start earlier are preferred, so the thread that starts
+      // a match at this position has the lowest priority.
+      if (!found_match_ && (position == start || !sticky_)) {
+        Thread thread = {0, NewRegisters()};
+        std::fill(thread.registers, thread.registers + register_count_, -1);
+        RunUntilBlocked(thread, position);
+      }
+
+      if (blocked_.empty() && (found_match_ || sticky_)) break;
+      if (position == input_.length()) break;
+
+      uc16 c = input_[position];
+      for (Thread thread : blocked_) {
+        const NfaInstruction& consume = program_[thread.pc];
+        if (Consumes(thread.pc, c)) {
+          thread.pc += 1 + consume.payload.range_count;
+          active_.push_back(thread);
+        } else {
+          Release(thread);
+        }
+      }
+      blocked_.clear();
+    }
+
+    for (const Thread& thread : blocked_) Release(thread);
+    blocked_.clear();
+    if (found_match_) {
+      std::copy(best_match_.begin(), best_match_.end(), output);
+    }
+    return found_match_;
+  }
+
+ private:
+  struct Thread {
+    int pc;
+    int32_t* registers;
+  };
+
+  int32_t* NewRegisters() {
+    if (!free_registers_.empty()) {
+      int32_t* registers = free_registers_.back();
+      free_registers_.pop_back();
+      return registers;
+    }
+    int32_t* registers = new int32_t[register_count_];
+    allocated_registers_.push_back(registers);
+    return registers;
+  }
+
+  void Release(const Thread& thread) {
+    free_registers_.push_back(thread.registers);
+  }
+
+  bool Consumes(int pc, uc16 c) const {
+    DCHECK_EQ(NfaInstruction::CONSUME_RANGES, program_[pc].opcode);
+    int range_count = program_[pc].payload.range_count;
+    for (int i = 1; i <= range_count; i++) {
+      const NfaInstruction& range = program_[pc + i];
+      DCHECK_EQ(NfaInstruction::RANGE, range.opcode);
+      if (c < range.payload.range.from) return false;
+      if (c <= range.payload.range.to) return true;
+    }
+    return false;
+  }
+
+  bool IsWordCharacterAt(int position) const {
+    return position >= 0 && position < input_.length() &&
+           IsRegExpWord(static_cast<uc16>(input_[position]));
+  }
+
+  bool AssertionHolds(RegExpAssertion::AssertionType type,
+                      int position) const {
+    switch (type) {
+      case RegExpAssertion::START_OF_INPUT:
+        return position == 0;
+      case RegExpAssertion::END_OF_INPUT:
+        return position == input_.length();
+      case RegExpAssertion::START_OF_LINE:
+        return position == 0 ||
+               unibrow::IsLineTerminator(input_[position - 1]);
+      case RegExpAssertion::END_OF_LINE:
+        return position == input_.length() ||
+               unibrow::IsLineTerminator(input_[position]);
+      case RegExpAssertion::BOUNDARY:
+        return IsWordCharacterAt(position - 1) != IsWordCharacterAt(position);
+      case RegExpAssertion::NON_BOUNDARY:
+        return IsWordCharacterAt(position - 1) == IsWordCharacterAt(position);
+    }
+    UNREACHABLE();
+  }
+
+  // Runs {thread} and the threads it forks, in priority order, until they
+  // are blocked on a CONSUME_RANGES instruction or die. Returns true if one
+  // of them found a match, in which case the remaining ones were dropped.
+  bool RunUntilBlocked(Thread thread, int position) {
+    DCHECK(stack_.empty());
+    stack_.push_back(thread);
+    while (!stack_.empty()) {
+      Thread t = stack_.back();
+      stack_.pop_back();
+      bool alive = true;
+      while (alive) {
+        if (visited_[t.pc] == step_) {
+          Release(t);
+          break;
+        }
+        visited_[t.pc] = step_;
+        const NfaInstruction& instruction = program_[t.pc];
+        switch (instruction.opcode) {
+          case NfaInstruction::ACCEPT:
+            std::copy(t.registers, t.registers + register_count_,
+                      best_match_.begin());
+            found_match_ = true;
+            Release(t);
+            for (const Thread& rest : stack_) Release(rest);
+            stack_.clear();
+            return true;
+          case NfaInstruction::ASSERTION:
+            if (AssertionHolds(instruction.payload.assertion_type,
+                               position)) {
+              t.pc++;
+            } else {
+              Release(t);
+              alive = false;
+            }
+            break;
+          case NfaInstruction::CLEAR_REGISTER:
+            t.registers[instruction.payload.register_index] = -1;
+            t.pc++;
+            break;
+          case NfaInstruction::CONSUME_RANGES:
+            blocked_.push_back(t);
+            alive = false;
+            break;
+          case NfaInstruction::FORK: {
+            Thread forked = {instruction.payload.pc, NewRegisters()};
+            std::copy(t.registers, t.registers + register_count_,
+                      forked.registers);
+            stack_.push_back(forked);
+            t.pc++;
+            break;
+          }
+          case NfaInstruction::JMP:
+            t.pc = instruction.payload.pc;
+            break;
+          case NfaInstruction::RANGE:
+            UNREACHABLE();
+          case NfaInstruction::SET_REGISTER_TO_CP:
+            t.registers[instruction.payload.register_index] = position;
+            t.pc++;
+            break;
+        }
+      }
+    }
+    return false;
+  }
+
+  Vector<const NfaInstruction> program_;
+  Vector<const Char> input_;
+  const int register_count_;
+  const bool sticky_;
+
+  // Threads that consumed the previous character, in priority order.
+  std::vector<Thread> active_;
+  // Threads waiting to consume the current character, in priority order.
+  std::vector<Thread> blocked_;
+  // Forked threads that still have to run at the current position.
+  std::vector<Thread> stack_;
+
+  // The step in which each instruction was last reached by a thread.
+  std::vector<int> visited_;
+
+  std::vector<int32_t> best_match_;
+  bool found_match_;
+  int step_;
+
+  std::vector<int32_t*> free_registers_;
+  std::vector<int32_t*> allocated_registers_;
+
+  DISALLOW_COPY_AND_ASSIGN(NfaInterpreter);
+};
+
+template <typename Char>
+int MatchAll(Vector<const NfaInstruction> program, Vector<const Char> input,
+             int index, int register_count, int max_matches, bool sticky,
+             int32_t* output) {
+  NfaInterpreter<Char> interpreter(program, input, register_count, sticky);
+  int matches = 0;
+  while (matches < max_matches) {
+    int32_t* match = output + matches * register_count;
+    if (!interpreter.FindMatch(index, match)) break;
+    matches++;
+    // Like Irregexp code, global regexps advance by one character after an
+    // empty match.
+    index = match[1] == match[0] ? match[1] + 1 : match[1];
+    if (index > input.length()) break;
+  }
+  return matches;
+}
+
+Vector<const NfaInstruction> ProgramFromByteArray(ByteArray* program) {
+  return Vector<const NfaInstruction>(
+      reinterpret_cast<const NfaInstruction*>(program->GetDataStartAddress()),
+      program->length() / static_cast<int>(sizeof(NfaInstruction)));
+}
+
+}  // namespace
+
+bool RegExpNfa::CanBeHandled(RegExpTree* tree, JSRegExp::Flags flags,
+                             int capture_count, Zone* zone) {
+  if (!CanBeHandledVisitor::Check(tree, flags)) return false;
+  ZoneList<NfaInstruction>* code = NfaCompiler::Compile(tree, zone);
+  if (code == nullptr) return false;
+  int register_count = (capture_count + 1) * 2;
+  return code->length() <= kMaxThreadRegisters / register_count;
+}
+
+Handle<ByteArray> RegExpNfa::Compile(Isolate* isolate, RegExpTree* tree,
+                                     Zone* zone) {
+  ZoneList<NfaInstruction>* code = NfaCompiler::Compile(tree, zone);
+  CHECK_NOT_NULL(code);
+  int length = code->length() * static_cast<int>(sizeof(NfaInstruction));
+  Handle<ByteArray> program =
+      isolate->factory()->NewByteArray(length, TENURED);
+  program->copy_in(0, reinterpret_cast<const byte*>(&code->first()), length);
+  return program;
+}
+
+int RegExpNfa::Match(ByteArray* program, String* subject, int index,
+                     int capture_count, JSRegExp::Flags flags,
+                     int32_t* output, int output_size) {
+  DisallowHeapAllocation no_gc;
+  int register_count = (capture_count + 1) * 2;
+  int max_matches =
+      (flags & JSRegExp::kGlobal) ? output_size / register_count : 1;
+  DCHECK_LE(1, max_matches);
+  bool sticky = (flags & JSRegExp::kSticky) != 0;
+
+  String::FlatContent content = subject->GetFlatContent();
+  DCHECK(content.IsFlat());
+  if (content.IsOneByte()) {
+    return MatchAll(ProgramFromByteArray(program), content.ToOneByteVector(),
+                    index, register_count, max_matches, sticky, output);
+  } else {
+    return MatchAll(ProgramFromByteArray(program), content.ToUC16Vector(),
+                    index, register_count, max_matches, sticky, output);
+  }
+}
+
+}  // namespace internal
+}  // namespace v8
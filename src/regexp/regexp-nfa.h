@@ -0,0 +1,54 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_REGEXP_REGEXP_NFA_H_
+#define V8_REGEXP_REGEXP_NFA_H_
+
+#include "src/objects.h"
+#include "src/objects/js-regexp.h"
+
+namespace v8 {
+namespace internal {
+
+class RegExpTree;
+class Zone;
+
+// An engine for the regexps that can be matched without backtracking, i.e.
+// those without backreferences and lookarounds, whose running time is linear
+// in the length of the subject. The regexp is compiled to a program for a
+// nondeterministic automaton, and all paths through the automaton are
+// simulated in lockstep (a "Pike VM"). The threads are kept in the order in
+// which a backtracking engine would try them, so the match found is the one
+// Irregexp would find.
+//
+// Unlike Irregexp, the NFA engine never takes exponential time on patterns
+// like /(a+)+$/, which makes it a safe fallback for regexps that backtrack
+// excessively (see --regexp-nfa-on-excessive-backtracks).
+class RegExpNfa : public AllStatic {
+ public:
+  // Whether the NFA engine supports the regexp with the given parse tree.
+  // Besides backreferences and lookarounds, this rules out ignore-case and
+  // unicode regexps, quantified subexpressions that can match the empty
+  // string, and regexps whose program would be too large.
+  static bool CanBeHandled(RegExpTree* tree, JSRegExp::Flags flags,
+                           int capture_count, Zone* zone);
+
+  // Compiles a regexp that CanBeHandled() to a program for Match().
+  static Handle<ByteArray> Compile(Isolate* isolate, RegExpTree* tree,
+                                   Zone* zone);
+
+  // Searches the flat {subject} for matches starting at or after {index}
+  // and stores their capture registers in {output}. Like Irregexp code,
+  // global regexps store as many matches as fit into the {output_size}
+  // registers. Only the registers of successful matches are written.
+  // Returns the number of matches.
+  static int Match(ByteArray* program, String* subject, int index,
+                   int capture_count, JSRegExp::Flags flags, int32_t* output,
+                   int output_size);
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_REGEXP_REGEXP_NFA_H_
@@ -159,6 +159,17 @@ void RegExpMacroAssemblerS390::AdvanceRegister(int reg, int by) {
 
 void RegExpMacroAssemblerS390::Backtrack() {
   CheckPreemption();
+  if (has_backtrack_limit()) {
+    Label next;
+    __ LoadP(r2, MemOperand(frame_pointer(), kBacktrackCount));
+    __ AddP(r2, Operand(1));
+    __ StoreP(r2, MemOperand(frame_pointer(), kBacktrackCount));
+    __ CmpP(r2, Operand(backtrack_limit()));
+    __ bne(&next);
+    // Exceeded the limit; retry the match on the NFA engine.
+    __ b(&fallback_label_);
+    __ bind(&next);
+  }
   // Pop Code* offset from backtrack stack, add Code* and jump to location.
   Pop(r2);
   __ AddP(r2, code_pointer());
@@ -653,10 +664,11 @@ Handle<HeapObject> RegExpMacroAssemblerS390::GetCode(Handle<String> source) {
   // Set frame pointer in space for it if this is not a direct call
   // from generated code.
   __ LoadRR(frame_pointer(), sp);
-  __ lay(sp, MemOperand(sp, -10 * kPointerSize));
+  __ lay(sp, MemOperand(sp, -11 * kPointerSize));
   __ mov(r1, Operand::Zero());  // success counter
   __ LoadRR(r0, r1);            // offset of location
-  __ StoreMultipleP(r0, r9, MemOperand(sp, 0));
+  __ StoreMultipleP(r0, r9, MemOperand(sp, kPointerSize));
+  __ StoreP(r1, MemOperand(sp, 0));  // backtrack counter
 
   // Check if we have space on the stack for registers.
   Label stack_limit_hit;
@@ -724,6 +736,11 @@ Handle<HeapObject> RegExpMacroAssemblerS390::GetCode(Handle<String> source) {
   // Load previous char as initial value of current character register.
   LoadCurrentCharacterUnchecked(-1, 1);
   __ bind(&start_regexp);
+  // Every match attempt of a global regexp gets the full backtrack limit.
+  if (has_backtrack_limit()) {
+    __ LoadImmP(r3, Operand::Zero());
+    __ StoreP(r3, MemOperand(frame_pointer(), kBacktrackCount));
+  }
 
   // Initialize on-stack registers.
   if (num_saved_registers_ > 0) {  // Always is, if generated from a regexp.
@@ -929,6 +946,12 @@ Handle<HeapObject> RegExpMacroAssemblerS390::GetCode(Handle<String> source) {
     __ b(&return_r2);
   }
 
+  if (fallback_label_.is_linked()) {
+    __ bind(&fallback_label_);
+    __ LoadImmP(r2, Operand(FALLBACK_TO_NFA));
+    __ b(&return_r2);
+  }
+
   CodeDesc code_desc;
   masm_->GetCode(isolate(), &code_desc);
   Handle<Code> code = isolate()->factory()->NewCode(code_desc, Code::REGEXP,
@@ -248,6 +248,11 @@ void RuntimeProfiler::MarkCandidatesForOptimization() {
     DCHECK(function->shared()->is_compiled());
     if (!function->shared()->IsInterpreted()) continue;
 
+    if (V8_UNLIKELY(FLAG_hot_path_counters)) {
+      isolate_->counters()->hot_path_counters()->CountInterpreterTick(
+          function->shared());
+    }
+
     MaybeOptimize(function, frame);
 
     // TODO(leszeks): Move this increment to before the maybe optimize checks,
@@ -207,6 +207,7 @@ Handle<Dictionary> ShallowCopyDictionaryTemplate(
   Handle<Dictionary> dictionary =
       Handle<Dictionary>::cast(isolate->factory()->CopyFixedArrayWithMap(
           dictionary_template, dictionary_map));
+  Dictionary::CopyControlTable(isolate, dictionary);
   // Clone all AccessorPairs in the dictionary.
   int capacity = dictionary->Capacity();
   for (int i = 0; i < capacity; i++) {
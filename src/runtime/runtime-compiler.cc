@@ -279,6 +279,12 @@ RUNTIME_FUNCTION(Runtime_CompileForOnStackReplacement) {
     }
   }
 
+  // A concurrent job re-arms the back edges once the code is ready, continue
+  // in the interpreter until then.
+  if (function->feedback_vector()->IsOsrCompilationInProgress(ast_id)) {
+    return nullptr;
+  }
+
   // Failed.
   if (FLAG_trace_osr) {
     PrintF("[OSR - Failed: ");
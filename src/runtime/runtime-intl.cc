@@ -528,6 +528,13 @@ RUNTIME_FUNCTION(Runtime_DateCacheVersion) {
   Handle<FixedArray> date_cache_version =
       Handle<FixedArray>::cast(isolate->eternal_handles()->GetSingleton(
           EternalHandles::DATE_CACHE_VERSION));
+  // The default instances cached by intl.js also depend on the default
+  // locale, which the embedder can change through ICU.
+  if (Intl::GetICUObjectCache(isolate)->CheckDefaultLocale()) {
+    isolate->ClearCachedICUObjects();
+    date_cache_version->set(
+        0, Smi::FromInt(Smi::ToInt(date_cache_version->get(0)) + 1));
+  }
   return date_cache_version->get(0);
 }
 
@@ -15,6 +15,7 @@
 #include "src/deoptimizer.h"
 #include "src/frames-inl.h"
 #include "src/isolate-inl.h"
+#include "src/objects/js-regexp-inl.h"
 #include "src/runtime-profiler.h"
 #include "src/snapshot/natives.h"
 #include "src/trap-handler/trap-handler.h"
@@ -834,6 +835,19 @@ RUNTIME_FUNCTION(Runtime_IsWasmCode) {
   return isolate->heap()->ToBoolean(is_js_to_wasm);
 }
 
+// Returns whether the regexp has an NFA program, i.e. whether it uses the NFA
+// engine or has fallen back to it.
+RUNTIME_FUNCTION(Runtime_RegExpHasNfaProgram) {
+  SealHandleScope shs(isolate);
+  DCHECK_EQ(1, args.length());
+  CONVERT_ARG_CHECKED(JSRegExp, regexp, 0);
+  JSRegExp::Type type = regexp->TypeTag();
+  bool has_program = (type == JSRegExp::IRREGEXP || type == JSRegExp::NFA) &&
+                     regexp->DataAt(JSRegExp::kIrregexpNfaProgramIndex)
+                         ->IsByteArray();
+  return isolate->heap()->ToBoolean(has_program);
+}
+
 RUNTIME_FUNCTION(Runtime_IsWasmTrapHandlerEnabled) {
   DisallowHeapAllocation no_gc;
   DCHECK_EQ(0, args.length());
@@ -0,0 +1,36 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_RYU_DTOA_H_
+#define V8_RYU_DTOA_H_
+
+#include "src/vector.h"
+
+namespace v8 {
+namespace internal {
+
+// RyuDtoa will produce at most kRyuDtoaMaximalLength digits. This does not
+// include the terminating '\0' character.
+const int kRyuDtoaMaximalLength = 17;
+
+// Computes the shortest decimal representation of v, using Ulf Adams' Ryu
+// algorithm ("Ryu: Fast Float-to-String Conversion", PLDI 2018).
+// The result should be interpreted as buffer * 10^(point - length).
+//
+// Precondition:
+//   * v must be a strictly positive finite double.
+//
+// Unlike FastDtoa, this always succeeds. The result satisfies
+//     v == (double) (buffer * 10^(point - length)),
+// the digits in the buffer are the shortest representation possible, and of
+// all representations of that length the buffer contains the one closest to
+// v (ties are broken towards an even last digit, like in BignumDtoa).
+// There will be *length digits inside the buffer followed by a null
+// terminator, and the last digit is never '0'.
+void RyuDtoa(double v, Vector<char> buffer, int* length, int* decimal_point);
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_RYU_DTOA_H_
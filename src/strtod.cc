@@ -7,6 +7,7 @@
 #include <stdarg.h>
 #include <cmath>
 
+#include "src/base/bits.h"
 #include "src/bignum.h"
 #include "src/cached-powers.h"
 #include "src/double.h"
@@ -65,6 +66,1324 @@ static const double exact_powers_of_ten[] = {
 // clang-format on
 static const int kExactPowersOfTenSize = arraysize(exact_powers_of_ten);
 
+// The exponent bias of an IEEE double, without the significand size.
+static const int kDoubleExponentBias = 0x3FF;
+
+// 128-bit approximations of the powers of ten needed by EiselLemireStrtod.
+// Each power is normalized so that its most significant bit is set, and then
+// truncated (rounded down) to 128 bits. The values are stored as {low, high}
+// pairs, starting with 10^kMinPowerOfTen128Exponent.
+static const int kMinPowerOfTen128Exponent = -342;
+static const int kMaxPowerOfTen128Exponent = 308;
+// clang-format off
+static const uint64_t kPowersOfTen128[][2] = {
+    {V8_2PART_UINT64_C(0x113faa29, 06a13b3f),
+     V8_2PART_UINT64_C(0xeef453d6, 923bd65a)},
+    {V8_2PART_UINT64_C(0x4ac7ca59, a424c507),
+     V8_2PART_UINT64_C(0x9558b466, 1b6565f8)},
+    {V8_2PART_UINT64_C(0x5d79bcf0, 0d2df649),
+     V8_2PART_UINT64_C(0xbaaee17f, a23ebf76)},  // 10^-340
+    {V8_2PART_UINT64_C(0xf4d82c2c, 107973dc),
+     V8_2PART_UINT64_C(0xe95a99df, 8ace6f53)},
+    {V8_2PART_UINT64_C(0x79071b9b, 8a4be869),
+     V8_2PART_UINT64_C(0x91d8a02b, b6c10594)},
+    {V8_2PART_UINT64_C(0x9748e282, 6cdee284),
+     V8_2PART_UINT64_C(0xb64ec836, a47146f9)},
+    {V8_2PART_UINT64_C(0xfd1b1b23, 08169b25),
+     V8_2PART_UINT64_C(0xe3e27a44, 4d8d98b7)},
+    {V8_2PART_UINT64_C(0xfe30f0f5, e50e20f7),
+     V8_2PART_UINT64_C(0x8e6d8c6a, b0787f72)},
+    {V8_2PART_UINT64_C(0xbdbd2d33, 5e51a935),
+     V8_2PART_UINT64_C(0xb208ef85, 5c969f4f)},
+    {V8_2PART_UINT64_C(0xad2c7880, 35e61382),
+     V8_2PART_UINT64_C(0xde8b2b66, b3bc4723)},
+    {V8_2PART_UINT64_C(0x4c3bcb50, 21afcc31),
+     V8_2PART_UINT64_C(0x8b16fb20, 3055ac76)},
+    {V8_2PART_UINT64_C(0xdf4abe24, 2a1bbf3d),
+     V8_2PART_UINT64_C(0xaddcb9e8, 3c6b1793)},
+    {V8_2PART_UINT64_C(0xd71d6dad, 34a2af0d),
+     V8_2PART_UINT64_C(0xd953e862, 4b85dd78)},  // 10^-330
+    {V8_2PART_UINT64_C(0x8672648c, 40e5ad68),
+     V8_2PART_UINT64_C(0x87d4713d, 6f33aa6b)},
+    {V8_2PART_UINT64_C(0x680efdaf, 511f18c2),
+     V8_2PART_UINT64_C(0xa9c98d8c, cb009506)},
+    {V8_2PART_UINT64_C(0x0212bd1b, 2566def2),
+     V8_2PART_UINT64_C(0xd43bf0ef, fdc0ba48)},
+    {V8_2PART_UINT64_C(0x014bb630, f7604b57),
+     V8_2PART_UINT64_C(0x84a57695, fe98746d)},
+    {V8_2PART_UINT64_C(0x419ea3bd, 35385e2d),
+     V8_2PART_UINT64_C(0xa5ced43b, 7e3e9188)},
+    {V8_2PART_UINT64_C(0x52064cac, 828675b9),
+     V8_2PART_UINT64_C(0xcf42894a, 5dce35ea)},
+    {V8_2PART_UINT64_C(0x7343efeb, d1940993),
+     V8_2PART_UINT64_C(0x818995ce, 7aa0e1b2)},
+    {V8_2PART_UINT64_C(0x1014ebe6, c5f90bf8),
+     V8_2PART_UINT64_C(0xa1ebfb42, 19491a1f)},
+    {V8_2PART_UINT64_C(0xd41a26e0, 77774ef6),
+     V8_2PART_UINT64_C(0xca66fa12, 9f9b60a6)},
+    {V8_2PART_UINT64_C(0x8920b098, 955522b4),
+     V8_2PART_UINT64_C(0xfd00b897, 478238d0)},  // 10^-320
+    {V8_2PART_UINT64_C(0x55b46e5f, 5d5535b0),
+     V8_2PART_UINT64_C(0x9e20735e, 8cb16382)},
+    {V8_2PART_UINT64_C(0xeb2189f7, 34aa831d),
+     V8_2PART_UINT64_C(0xc5a89036, 2fddbc62)},
+    {V8_2PART_UINT64_C(0xa5e9ec75, 01d523e4),
+     V8_2PART_UINT64_C(0xf712b443, bbd52b7b)},
+    {V8_2PART_UINT64_C(0x47b233c9, 2125366e),
+     V8_2PART_UINT64_C(0x9a6bb0aa, 55653b2d)},
+    {V8_2PART_UINT64_C(0x999ec0bb, 696e840a),
+     V8_2PART_UINT64_C(0xc1069cd4, eabe89f8)},
+    {V8_2PART_UINT64_C(0xc00670ea, 43ca250d),
+     V8_2PART_UINT64_C(0xf148440a, 256e2c76)},
+    {V8_2PART_UINT64_C(0x38040692, 6a5e5728),
+     V8_2PART_UINT64_C(0x96cd2a86, 5764dbca)},
+    {V8_2PART_UINT64_C(0xc6050837, 04f5ecf2),
+     V8_2PART_UINT64_C(0xbc807527, ed3e12bc)},
+    {V8_2PART_UINT64_C(0xf7864a44, c633682e),
+     V8_2PART_UINT64_C(0xeba09271, e88d976b)},
+    {V8_2PART_UINT64_C(0x7ab3ee6a, fbe0211d),
+     V8_2PART_UINT64_C(0x93445b87, 31587ea3)},  // 10^-310
+    {V8_2PART_UINT64_C(0x5960ea05, bad82964),
+     V8_2PART_UINT64_C(0xb8157268, fdae9e4c)},
+    {V8_2PART_UINT64_C(0x6fb92487, 298e33bd),
+     V8_2PART_UINT64_C(0xe61acf03, 3d1a45df)},
+    {V8_2PART_UINT64_C(0xa5d3b6d4, 79f8e056),
+     V8_2PART_UINT64_C(0x8fd0c162, 06306bab)},
+    {V8_2PART_UINT64_C(0x8f48a489, 9877186c),
+     V8_2PART_UINT64_C(0xb3c4f1ba, 87bc8696)},
+    {V8_2PART_UINT64_C(0x331acdab, fe94de87),
+     V8_2PART_UINT64_C(0xe0b62e29, 29aba83c)},
+    {V8_2PART_UINT64_C(0x9ff0c08b, 7f1d0b14),
+     V8_2PART_UINT64_C(0x8c71dcd9, ba0b4925)},
+    {V8_2PART_UINT64_C(0x07ecf0ae, 5ee44dd9),
+     V8_2PART_UINT64_C(0xaf8e5410, 288e1b6f)},
+    {V8_2PART_UINT64_C(0xc9e82cd9, f69d6150),
+     V8_2PART_UINT64_C(0xdb71e914, 32b1a24a)},
+    {V8_2PART_UINT64_C(0xbe311c08, 3a225cd2),
+     V8_2PART_UINT64_C(0x892731ac, 9faf056e)},
+    {V8_2PART_UINT64_C(0x6dbd630a, 48aaf406),
+     V8_2PART_UINT64_C(0xab70fe17, c79ac6ca)},  // 10^-300
+    {V8_2PART_UINT64_C(0x092cbbcc, dad5b108),
+     V8_2PART_UINT64_C(0xd64d3d9d, b981787d)},
+    {V8_2PART_UINT64_C(0x25bbf560, 08c58ea5),
+     V8_2PART_UINT64_C(0x85f04682, 93f0eb4e)},
+    {V8_2PART_UINT64_C(0xaf2af2b8, 0af6f24e),
+     V8_2PART_UINT64_C(0xa76c5823, 38ed2621)},
+    {V8_2PART_UINT64_C(0x1af5af66, 0db4aee1),
+     V8_2PART_UINT64_C(0xd1476e2c, 07286faa)},
+    {V8_2PART_UINT64_C(0x50d98d9f, c890ed4d),
+     V8_2PART_UINT64_C(0x82cca4db, 847945ca)},
+    {V8_2PART_UINT64_C(0xe50ff107, bab528a0),
+     V8_2PART_UINT64_C(0xa37fce12, 6597973c)},
+    {V8_2PART_UINT64_C(0x1e53ed49, a96272c8),
+     V8_2PART_UINT64_C(0xcc5fc196, fefd7d0c)},
+    {V8_2PART_UINT64_C(0x25e8e89c, 13bb0f7a),
+     V8_2PART_UINT64_C(0xff77b1fc, bebcdc4f)},
+    {V8_2PART_UINT64_C(0x77b19161, 8c54e9ac),
+     V8_2PART_UINT64_C(0x9faacf3d, f73609b1)},
+    {V8_2PART_UINT64_C(0xd59df5b9, ef6a2417),
+     V8_2PART_UINT64_C(0xc795830d, 75038c1d)},  // 10^-290
+    {V8_2PART_UINT64_C(0x4b057328, 6b44ad1d),
+     V8_2PART_UINT64_C(0xf97ae3d0, d2446f25)},
+    {V8_2PART_UINT64_C(0x4ee367f9, 430aec32),
+     V8_2PART_UINT64_C(0x9becce62, 836ac577)},
+    {V8_2PART_UINT64_C(0x229c41f7, 93cda73f),
+     V8_2PART_UINT64_C(0xc2e801fb, 244576d5)},
+    {V8_2PART_UINT64_C(0x6b435275, 78c1110f),
+     V8_2PART_UINT64_C(0xf3a20279, ed56d48a)},
+    {V8_2PART_UINT64_C(0x830a1389, 6b78aaa9),
+     V8_2PART_UINT64_C(0x9845418c, 345644d6)},
+    {V8_2PART_UINT64_C(0x23cc986b, c656d553),
+     V8_2PART_UINT64_C(0xbe5691ef, 416bd60c)},
+    {V8_2PART_UINT64_C(0x2cbfbe86, b7ec8aa8),
+     V8_2PART_UINT64_C(0xedec366b, 11c6cb8f)},
+    {V8_2PART_UINT64_C(0x7bf7d714, 32f3d6a9),
+     V8_2PART_UINT64_C(0x94b3a202, eb1c3f39)},
+    {V8_2PART_UINT64_C(0xdaf5ccd9, 3fb0cc53),
+     V8_2PART_UINT64_C(0xb9e08a83, a5e34f07)},
+    {V8_2PART_UINT64_C(0xd1b3400f, 8f9cff68),
+     V8_2PART_UINT64_C(0xe858ad24, 8f5c22c9)},  // 10^-280
+    {V8_2PART_UINT64_C(0x23100809, b9c21fa1),
+     V8_2PART_UINT64_C(0x91376c36, d99995be)},
+    {V8_2PART_UINT64_C(0xabd40a0c, 2832a78a),
+     V8_2PART_UINT64_C(0xb5854744, 8ffffb2d)},
+    {V8_2PART_UINT64_C(0x16c90c8f, 323f516c),
+     V8_2PART_UINT64_C(0xe2e69915, b3fff9f9)},
+    {V8_2PART_UINT64_C(0xae3da7d9, 7f6792e3),
+     V8_2PART_UINT64_C(0x8dd01fad, 907ffc3b)},
+    {V8_2PART_UINT64_C(0x99cd11cf, df41779c),
+     V8_2PART_UINT64_C(0xb1442798, f49ffb4a)},
+    {V8_2PART_UINT64_C(0x40405643, d711d583),
+     V8_2PART_UINT64_C(0xdd95317f, 31c7fa1d)},
+    {V8_2PART_UINT64_C(0x482835ea, 666b2572),
+     V8_2PART_UINT64_C(0x8a7d3eef, 7f1cfc52)},
+    {V8_2PART_UINT64_C(0xda324365, 0005eecf),
+     V8_2PART_UINT64_C(0xad1c8eab, 5ee43b66)},
+    {V8_2PART_UINT64_C(0x90bed43e, 40076a82),
+     V8_2PART_UINT64_C(0xd863b256, 369d4a40)},
+    {V8_2PART_UINT64_C(0x5a7744a6, e804a291),
+     V8_2PART_UINT64_C(0x873e4f75, e2224e68)},  // 10^-270
+    {V8_2PART_UINT64_C(0x711515d0, a205cb36),
+     V8_2PART_UINT64_C(0xa90de353, 5aaae202)},
+    {V8_2PART_UINT64_C(0x0d5a5b44, ca873e03),
+     V8_2PART_UINT64_C(0xd3515c28, 31559a83)},
+    {V8_2PART_UINT64_C(0xe858790a, fe9486c2),
+     V8_2PART_UINT64_C(0x8412d999, 1ed58091)},
+    {V8_2PART_UINT64_C(0x626e974d, be39a872),
+     V8_2PART_UINT64_C(0xa5178fff, 668ae0b6)},
+    {V8_2PART_UINT64_C(0xfb0a3d21, 2dc8128f),
+     V8_2PART_UINT64_C(0xce5d73ff, 402d98e3)},
+    {V8_2PART_UINT64_C(0x7ce66634, bc9d0b99),
+     V8_2PART_UINT64_C(0x80fa687f, 881c7f8e)},
+    {V8_2PART_UINT64_C(0x1c1fffc1, ebc44e80),
+     V8_2PART_UINT64_C(0xa139029f, 6a239f72)},
+    {V8_2PART_UINT64_C(0xa327ffb2, 66b56220),
+     V8_2PART_UINT64_C(0xc9874347, 44ac874e)},
+    {V8_2PART_UINT64_C(0x4bf1ff9f, 0062baa8),
+     V8_2PART_UINT64_C(0xfbe91419, 15d7a922)},
+    {V8_2PART_UINT64_C(0x6f773fc3, 603db4a9),
+     V8_2PART_UINT64_C(0x9d71ac8f, ada6c9b5)},  // 10^-260
+    {V8_2PART_UINT64_C(0xcb550fb4, 384d21d3),
+     V8_2PART_UINT64_C(0xc4ce17b3, 99107c22)},
+    {V8_2PART_UINT64_C(0x7e2a53a1, 46606a48),
+     V8_2PART_UINT64_C(0xf6019da0, 7f549b2b)},
+    {V8_2PART_UINT64_C(0x2eda7444, cbfc426d),
+     V8_2PART_UINT64_C(0x99c10284, 4f94e0fb)},
+    {V8_2PART_UINT64_C(0xfa911155, fefb5308),
+     V8_2PART_UINT64_C(0xc0314325, 637a1939)},
+    {V8_2PART_UINT64_C(0x793555ab, 7eba27ca),
+     V8_2PART_UINT64_C(0xf03d93ee, bc589f88)},
+    {V8_2PART_UINT64_C(0x4bc1558b, 2f3458de),
+     V8_2PART_UINT64_C(0x96267c75, 35b763b5)},
+    {V8_2PART_UINT64_C(0x9eb1aaed, fb016f16),
+     V8_2PART_UINT64_C(0xbbb01b92, 83253ca2)},
+    {V8_2PART_UINT64_C(0x465e15a9, 79c1cadc),
+     V8_2PART_UINT64_C(0xea9c2277, 23ee8bcb)},
+    {V8_2PART_UINT64_C(0x0bfacd89, ec191ec9),
+     V8_2PART_UINT64_C(0x92a1958a, 7675175f)},
+    {V8_2PART_UINT64_C(0xcef980ec, 671f667b),
+     V8_2PART_UINT64_C(0xb749faed, 14125d36)},  // 10^-250
+    {V8_2PART_UINT64_C(0x82b7e127, 80e7401a),
+     V8_2PART_UINT64_C(0xe51c79a8, 5916f484)},
+    {V8_2PART_UINT64_C(0xd1b2ecb8, b0908810),
+     V8_2PART_UINT64_C(0x8f31cc09, 37ae58d2)},
+    {V8_2PART_UINT64_C(0x861fa7e6, dcb4aa15),
+     V8_2PART_UINT64_C(0xb2fe3f0b, 8599ef07)},
+    {V8_2PART_UINT64_C(0x67a791e0, 93e1d49a),
+     V8_2PART_UINT64_C(0xdfbdcece, 67006ac9)},
+    {V8_2PART_UINT64_C(0xe0c8bb2c, 5c6d24e0),
+     V8_2PART_UINT64_C(0x8bd6a141, 006042bd)},
+    {V8_2PART_UINT64_C(0x58fae9f7, 73886e18),
+     V8_2PART_UINT64_C(0xaecc4991, 4078536d)},
+    {V8_2PART_UINT64_C(0xaf39a475, 506a899e),
+     V8_2PART_UINT64_C(0xda7f5bf5, 90966848)},
+    {V8_2PART_UINT64_C(0x6d8406c9, 52429603),
+     V8_2PART_UINT64_C(0x888f9979, 7a5e012d)},
+    {V8_2PART_UINT64_C(0xc8e5087b, a6d33b83),
+     V8_2PART_UINT64_C(0xaab37fd7, d8f58178)},
+    {V8_2PART_UINT64_C(0xfb1e4a9a, 90880a64),
+     V8_2PART_UINT64_C(0xd5605fcd, cf32e1d6)},  // 10^-240
+    {V8_2PART_UINT64_C(0x5cf2eea0, 9a55067f),
+     V8_2PART_UINT64_C(0x855c3be0, a17fcd26)},
+    {V8_2PART_UINT64_C(0xf42faa48, c0ea481e),
+     V8_2PART_UINT64_C(0xa6b34ad8, c9dfc06f)},
+    {V8_2PART_UINT64_C(0xf13b94da, f124da26),
+     V8_2PART_UINT64_C(0xd0601d8e, fc57b08b)},
+    {V8_2PART_UINT64_C(0x76c53d08, d6b70858),
+     V8_2PART_UINT64_C(0x823c1279, 5db6ce57)},
+    {V8_2PART_UINT64_C(0x54768c4b, 0c64ca6e),
+     V8_2PART_UINT64_C(0xa2cb1717, b52481ed)},
+    {V8_2PART_UINT64_C(0xa9942f5d, cf7dfd09),
+     V8_2PART_UINT64_C(0xcb7ddcdd, a26da268)},
+    {V8_2PART_UINT64_C(0xd3f93b35, 435d7c4c),
+     V8_2PART_UINT64_C(0xfe5d5415, 0b090b02)},
+    {V8_2PART_UINT64_C(0xc47bc501, 4a1a6daf),
+     V8_2PART_UINT64_C(0x9efa548d, 26e5a6e1)},
+    {V8_2PART_UINT64_C(0x359ab641, 9ca1091b),
+     V8_2PART_UINT64_C(0xc6b8e9b0, 709f109a)},
+    {V8_2PART_UINT64_C(0xc30163d2, 03c94b62),
+     V8_2PART_UINT64_C(0xf867241c, 8cc6d4c0)},  // 10^-230
+    {V8_2PART_UINT64_C(0x79e0de63, 425dcf1d),
+     V8_2PART_UINT64_C(0x9b407691, d7fc44f8)},
+    {V8_2PART_UINT64_C(0x985915fc, 12f542e4),
+     V8_2PART_UINT64_C(0xc2109436, 4dfb5636)},
+    {V8_2PART_UINT64_C(0x3e6f5b7b, 17b2939d),
+     V8_2PART_UINT64_C(0xf294b943, e17a2bc4)},
+    {V8_2PART_UINT64_C(0xa705992c, eecf9c42),
+     V8_2PART_UINT64_C(0x979cf3ca, 6cec5b5a)},
+    {V8_2PART_UINT64_C(0x50c6ff78, 2a838353),
+     V8_2PART_UINT64_C(0xbd8430bd, 08277231)},
+    {V8_2PART_UINT64_C(0xa4f8bf56, 35246428),
+     V8_2PART_UINT64_C(0xece53cec, 4a314ebd)},
+    {V8_2PART_UINT64_C(0x871b7795, e136be99),
+     V8_2PART_UINT64_C(0x940f4613, ae5ed136)},
+    {V8_2PART_UINT64_C(0x28e2557b, 59846e3f),
+     V8_2PART_UINT64_C(0xb9131798, 99f68584)},
+    {V8_2PART_UINT64_C(0x331aeada, 2fe589cf),
+     V8_2PART_UINT64_C(0xe757dd7e, c07426e5)},
+    {V8_2PART_UINT64_C(0x3ff0d2c8, 5def7621),
+     V8_2PART_UINT64_C(0x9096ea6f, 3848984f)},  // 10^-220
+    {V8_2PART_UINT64_C(0x0fed077a, 756b53a9),
+     V8_2PART_UINT64_C(0xb4bca50b, 065abe63)},
+    {V8_2PART_UINT64_C(0xd3e84959, 12c62894),
+     V8_2PART_UINT64_C(0xe1ebce4d, c7f16dfb)},
+    {V8_2PART_UINT64_C(0x64712dd7, abbbd95c),
+     V8_2PART_UINT64_C(0x8d3360f0, 9cf6e4bd)},
+    {V8_2PART_UINT64_C(0xbd8d794d, 96aacfb3),
+     V8_2PART_UINT64_C(0xb080392c, c4349dec)},
+    {V8_2PART_UINT64_C(0xecf0d7a0, fc5583a0),
+     V8_2PART_UINT64_C(0xdca04777, f541c567)},
+    {V8_2PART_UINT64_C(0xf41686c4, 9db57244),
+     V8_2PART_UINT64_C(0x89e42caa, f9491b60)},
+    {V8_2PART_UINT64_C(0x311c2875, c522ced5),
+     V8_2PART_UINT64_C(0xac5d37d5, b79b6239)},
+    {V8_2PART_UINT64_C(0x7d633293, 366b828b),
+     V8_2PART_UINT64_C(0xd77485cb, 25823ac7)},
+    {V8_2PART_UINT64_C(0xae5dff9c, 02033197),
+     V8_2PART_UINT64_C(0x86a8d39e, f77164bc)},
+    {V8_2PART_UINT64_C(0xd9f57f83, 0283fdfc),
+     V8_2PART_UINT64_C(0xa8530886, b54dbdeb)},  // 10^-210
+    {V8_2PART_UINT64_C(0xd072df63, c324fd7b),
+     V8_2PART_UINT64_C(0xd267caa8, 62a12d66)},
+    {V8_2PART_UINT64_C(0x4247cb9e, 59f71e6d),
+     V8_2PART_UINT64_C(0x8380dea9, 3da4bc60)},
+    {V8_2PART_UINT64_C(0x52d9be85, f074e608),
+     V8_2PART_UINT64_C(0xa4611653, 8d0deb78)},
+    {V8_2PART_UINT64_C(0x67902e27, 6c921f8b),
+     V8_2PART_UINT64_C(0xcd795be8, 70516656)},
+    {V8_2PART_UINT64_C(0x00ba1cd8, a3db53b6),
+     V8_2PART_UINT64_C(0x806bd971, 4632dff6)},
+    {V8_2PART_UINT64_C(0x80e8a40e, ccd228a4),
+     V8_2PART_UINT64_C(0xa086cfcd, 97bf97f3)},
+    {V8_2PART_UINT64_C(0x6122cd12, 8006b2cd),
+     V8_2PART_UINT64_C(0xc8a883c0, fdaf7df0)},
+    {V8_2PART_UINT64_C(0x796b8057, 20085f81),
+     V8_2PART_UINT64_C(0xfad2a4b1, 3d1b5d6c)},
+    {V8_2PART_UINT64_C(0xcbe33036, 74053bb0),
+     V8_2PART_UINT64_C(0x9cc3a6ee, c6311a63)},
+    {V8_2PART_UINT64_C(0xbedbfc44, 11068a9c),
+     V8_2PART_UINT64_C(0xc3f490aa, 77bd60fc)},  // 10^-200
+    {V8_2PART_UINT64_C(0xee92fb55, 15482d44),
+     V8_2PART_UINT64_C(0xf4f1b4d5, 15acb93b)},
+    {V8_2PART_UINT64_C(0x751bdd15, 2d4d1c4a),
+     V8_2PART_UINT64_C(0x99171105, 2d8bf3c5)},
+    {V8_2PART_UINT64_C(0xd262d45a, 78a0635d),
+     V8_2PART_UINT64_C(0xbf5cd546, 78eef0b6)},
+    {V8_2PART_UINT64_C(0x86fb8971, 16c87c34),
+     V8_2PART_UINT64_C(0xef340a98, 172aace4)},
+    {V8_2PART_UINT64_C(0xd45d35e6, ae3d4da0),
+     V8_2PART_UINT64_C(0x9580869f, 0e7aac0e)},
+    {V8_2PART_UINT64_C(0x89748360, 59cca109),
+     V8_2PART_UINT64_C(0xbae0a846, d2195712)},
+    {V8_2PART_UINT64_C(0x2bd1a438, 703fc94b),
+     V8_2PART_UINT64_C(0xe998d258, 869facd7)},
+    {V8_2PART_UINT64_C(0x7b6306a3, 4627ddcf),
+     V8_2PART_UINT64_C(0x91ff8377, 5423cc06)},
+    {V8_2PART_UINT64_C(0x1a3bc84c, 17b1d542),
+     V8_2PART_UINT64_C(0xb67f6455, 292cbf08)},
+    {V8_2PART_UINT64_C(0x20caba5f, 1d9e4a93),
+     V8_2PART_UINT64_C(0xe41f3d6a, 7377eeca)},  // 10^-190
+    {V8_2PART_UINT64_C(0x547eb47b, 7282ee9c),
+     V8_2PART_UINT64_C(0x8e938662, 882af53e)},
+    {V8_2PART_UINT64_C(0xe99e619a, 4f23aa43),
+     V8_2PART_UINT64_C(0xb23867fb, 2a35b28d)},
+    {V8_2PART_UINT64_C(0x6405fa00, e2ec94d4),
+     V8_2PART_UINT64_C(0xdec681f9, f4c31f31)},
+    {V8_2PART_UINT64_C(0xde83bc40, 8dd3dd04),
+     V8_2PART_UINT64_C(0x8b3c113c, 38f9f37e)},
+    {V8_2PART_UINT64_C(0x9624ab50, b148d445),
+     V8_2PART_UINT64_C(0xae0b158b, 4738705e)},
+    {V8_2PART_UINT64_C(0x3badd624, dd9b0957),
+     V8_2PART_UINT64_C(0xd98ddaee, 19068c76)},
+    {V8_2PART_UINT64_C(0xe54ca5d7, 0a80e5d6),
+     V8_2PART_UINT64_C(0x87f8a8d4, cfa417c9)},
+    {V8_2PART_UINT64_C(0x5e9fcf4c, cd211f4c),
+     V8_2PART_UINT64_C(0xa9f6d30a, 038d1dbc)},
+    {V8_2PART_UINT64_C(0x7647c320, 0069671f),
+     V8_2PART_UINT64_C(0xd47487cc, 8470652b)},
+    {V8_2PART_UINT64_C(0x29ecd9f4, 0041e073),
+     V8_2PART_UINT64_C(0x84c8d4df, d2c63f3b)},  // 10^-180
+    {V8_2PART_UINT64_C(0xf4681071, 00525890),
+     V8_2PART_UINT64_C(0xa5fb0a17, c777cf09)},
+    {V8_2PART_UINT64_C(0x7182148d, 4066eeb4),
+     V8_2PART_UINT64_C(0xcf79cc9d, b955c2cc)},
+    {V8_2PART_UINT64_C(0xc6f14cd8, 48405530),
+     V8_2PART_UINT64_C(0x81ac1fe2, 93d599bf)},
+    {V8_2PART_UINT64_C(0xb8ada00e, 5a506a7c),
+     V8_2PART_UINT64_C(0xa21727db, 38cb002f)},
+    {V8_2PART_UINT64_C(0xa6d90811, f0e4851c),
+     V8_2PART_UINT64_C(0xca9cf1d2, 06fdc03b)},
+    {V8_2PART_UINT64_C(0x908f4a16, 6d1da663),
+     V8_2PART_UINT64_C(0xfd442e46, 88bd304a)},
+    {V8_2PART_UINT64_C(0x9a598e4e, 043287fe),
+     V8_2PART_UINT64_C(0x9e4a9cec, 15763e2e)},
+    {V8_2PART_UINT64_C(0x40eff1e1, 853f29fd),
+     V8_2PART_UINT64_C(0xc5dd4427, 1ad3cdba)},
+    {V8_2PART_UINT64_C(0xd12bee59, e68ef47c),
+     V8_2PART_UINT64_C(0xf7549530, e188c128)},
+    {V8_2PART_UINT64_C(0x82bb74f8, 301958ce),
+     V8_2PART_UINT64_C(0x9a94dd3e, 8cf578b9)},  // 10^-170
+    {V8_2PART_UINT64_C(0xe36a5236, 3c1faf01),
+     V8_2PART_UINT64_C(0xc13a148e, 3032d6e7)},
+    {V8_2PART_UINT64_C(0xdc44e6c3, cb279ac1),
+     V8_2PART_UINT64_C(0xf18899b1, bc3f8ca1)},
+    {V8_2PART_UINT64_C(0x29ab103a, 5ef8c0b9),
+     V8_2PART_UINT64_C(0x96f5600f, 15a7b7e5)},
+    {V8_2PART_UINT64_C(0x7415d448, f6b6f0e7),
+     V8_2PART_UINT64_C(0xbcb2b812, db11a5de)},
+    {V8_2PART_UINT64_C(0x111b495b, 3464ad21),
+     V8_2PART_UINT64_C(0xebdf6617, 91d60f56)},
+    {V8_2PART_UINT64_C(0xcab10dd9, 00beec34),
+     V8_2PART_UINT64_C(0x936b9fce, bb25c995)},
+    {V8_2PART_UINT64_C(0x3d5d514f, 40eea742),
+     V8_2PART_UINT64_C(0xb84687c2, 69ef3bfb)},
+    {V8_2PART_UINT64_C(0x0cb4a5a3, 112a5112),
+     V8_2PART_UINT64_C(0xe65829b3, 046b0afa)},
+    {V8_2PART_UINT64_C(0x47f0e785, eaba72ab),
+     V8_2PART_UINT64_C(0x8ff71a0f, e2c2e6dc)},
+    {V8_2PART_UINT64_C(0x59ed2167, 65690f56),
+     V8_2PART_UINT64_C(0xb3f4e093, db73a093)},  // 10^-160
+    {V8_2PART_UINT64_C(0x306869c1, 3ec3532c),
+     V8_2PART_UINT64_C(0xe0f218b8, d25088b8)},
+    {V8_2PART_UINT64_C(0x1e414218, c73a13fb),
+     V8_2PART_UINT64_C(0x8c974f73, 83725573)},
+    {V8_2PART_UINT64_C(0xe5d1929e, f90898fa),
+     V8_2PART_UINT64_C(0xafbd2350, 644eeacf)},
+    {V8_2PART_UINT64_C(0xdf45f746, b74abf39),
+     V8_2PART_UINT64_C(0xdbac6c24, 7d62a583)},
+    {V8_2PART_UINT64_C(0x6b8bba8c, 328eb783),
+     V8_2PART_UINT64_C(0x894bc396, ce5da772)},
+    {V8_2PART_UINT64_C(0x066ea92f, 3f326564),
+     V8_2PART_UINT64_C(0xab9eb47c, 81f5114f)},
+    {V8_2PART_UINT64_C(0xc80a537b, 0efefebd),
+     V8_2PART_UINT64_C(0xd686619b, a27255a2)},
+    {V8_2PART_UINT64_C(0xbd06742c, e95f5f36),
+     V8_2PART_UINT64_C(0x8613fd01, 45877585)},
+    {V8_2PART_UINT64_C(0x2c481138, 23b73704),
+     V8_2PART_UINT64_C(0xa798fc41, 96e952e7)},
+    {V8_2PART_UINT64_C(0xf75a1586, 2ca504c5),
+     V8_2PART_UINT64_C(0xd17f3b51, fca3a7a0)},  // 10^-150
+    {V8_2PART_UINT64_C(0x9a984d73, dbe722fb),
+     V8_2PART_UINT64_C(0x82ef8513, 3de648c4)},
+    {V8_2PART_UINT64_C(0xc13e60d0, d2e0ebba),
+     V8_2PART_UINT64_C(0xa3ab6658, 0d5fdaf5)},
+    {V8_2PART_UINT64_C(0x318df905, 079926a8),
+     V8_2PART_UINT64_C(0xcc963fee, 10b7d1b3)},
+    {V8_2PART_UINT64_C(0xfdf17746, 497f7052),
+     V8_2PART_UINT64_C(0xffbbcfe9, 94e5c61f)},
+    {V8_2PART_UINT64_C(0xfeb6ea8b, edefa633),
+     V8_2PART_UINT64_C(0x9fd561f1, fd0f9bd3)},
+    {V8_2PART_UINT64_C(0xfe64a52e, e96b8fc0),
+     V8_2PART_UINT64_C(0xc7caba6e, 7c5382c8)},
+    {V8_2PART_UINT64_C(0x3dfdce7a, a3c673b0),
+     V8_2PART_UINT64_C(0xf9bd690a, 1b68637b)},
+    {V8_2PART_UINT64_C(0x06bea10c, a65c084e),
+     V8_2PART_UINT64_C(0x9c1661a6, 51213e2d)},
+    {V8_2PART_UINT64_C(0x486e494f, cff30a62),
+     V8_2PART_UINT64_C(0xc31bfa0f, e5698db8)},
+    {V8_2PART_UINT64_C(0x5a89dba3, c3efccfa),
+     V8_2PART_UINT64_C(0xf3e2f893, dec3f126)},  // 10^-140
+    {V8_2PART_UINT64_C(0xf8962946, 5a75e01c),
+     V8_2PART_UINT64_C(0x986ddb5c, 6b3a76b7)},
+    {V8_2PART_UINT64_C(0xf6bbb397, f1135823),
+     V8_2PART_UINT64_C(0xbe895233, 86091465)},
+    {V8_2PART_UINT64_C(0x746aa07d, ed582e2c),
+     V8_2PART_UINT64_C(0xee2ba6c0, 678b597f)},
+    {V8_2PART_UINT64_C(0xa8c2a44e, b4571cdc),
+     V8_2PART_UINT64_C(0x94db4838, 40b717ef)},
+    {V8_2PART_UINT64_C(0x92f34d62, 616ce413),
+     V8_2PART_UINT64_C(0xba121a46, 50e4ddeb)},
+    {V8_2PART_UINT64_C(0x77b020ba, f9c81d17),
+     V8_2PART_UINT64_C(0xe896a0d7, e51e1566)},
+    {V8_2PART_UINT64_C(0x0ace1474, dc1d122e),
+     V8_2PART_UINT64_C(0x915e2486, ef32cd60)},
+    {V8_2PART_UINT64_C(0x0d819992, 132456ba),
+     V8_2PART_UINT64_C(0xb5b5ada8, aaff80b8)},
+    {V8_2PART_UINT64_C(0x10e1fff6, 97ed6c69),
+     V8_2PART_UINT64_C(0xe3231912, d5bf60e6)},
+    {V8_2PART_UINT64_C(0xca8d3ffa, 1ef463c1),
+     V8_2PART_UINT64_C(0x8df5efab, c5979c8f)},  // 10^-130
+    {V8_2PART_UINT64_C(0xbd308ff8, a6b17cb2),
+     V8_2PART_UINT64_C(0xb1736b96, b6fd83b3)},
+    {V8_2PART_UINT64_C(0xac7cb3f6, d05ddbde),
+     V8_2PART_UINT64_C(0xddd0467c, 64bce4a0)},
+    {V8_2PART_UINT64_C(0x6bcdf07a, 423aa96b),
+     V8_2PART_UINT64_C(0x8aa22c0d, bef60ee4)},
+    {V8_2PART_UINT64_C(0x86c16c98, d2c953c6),
+     V8_2PART_UINT64_C(0xad4ab711, 2eb3929d)},
+    {V8_2PART_UINT64_C(0xe871c7bf, 077ba8b7),
+     V8_2PART_UINT64_C(0xd89d64d5, 7a607744)},
+    {V8_2PART_UINT64_C(0x11471cd7, 64ad4972),
+     V8_2PART_UINT64_C(0x87625f05, 6c7c4a8b)},
+    {V8_2PART_UINT64_C(0xd598e40d, 3dd89bcf),
+     V8_2PART_UINT64_C(0xa93af6c6, c79b5d2d)},
+    {V8_2PART_UINT64_C(0x4aff1d10, 8d4ec2c3),
+     V8_2PART_UINT64_C(0xd389b478, 79823479)},
+    {V8_2PART_UINT64_C(0xcedf722a, 585139ba),
+     V8_2PART_UINT64_C(0x843610cb, 4bf160cb)},
+    {V8_2PART_UINT64_C(0xc2974eb4, ee658828),
+     V8_2PART_UINT64_C(0xa54394fe, 1eedb8fe)},  // 10^-120
+    {V8_2PART_UINT64_C(0x733d2262, 29feea32),
+     V8_2PART_UINT64_C(0xce947a3d, a6a9273e)},
+    {V8_2PART_UINT64_C(0x0806357d, 5a3f525f),
+     V8_2PART_UINT64_C(0x811ccc66, 8829b887)},
+    {V8_2PART_UINT64_C(0xca07c2dc, b0cf26f7),
+     V8_2PART_UINT64_C(0xa163ff80, 2a3426a8)},
+    {V8_2PART_UINT64_C(0xfc89b393, dd02f0b5),
+     V8_2PART_UINT64_C(0xc9bcff60, 34c13052)},
+    {V8_2PART_UINT64_C(0xbbac2078, d443ace2),
+     V8_2PART_UINT64_C(0xfc2c3f38, 41f17c67)},
+    {V8_2PART_UINT64_C(0xd54b944b, 84aa4c0d),
+     V8_2PART_UINT64_C(0x9d9ba783, 2936edc0)},
+    {V8_2PART_UINT64_C(0x0a9e795e, 65d4df11),
+     V8_2PART_UINT64_C(0xc5029163, f384a931)},
+    {V8_2PART_UINT64_C(0x4d4617b5, ff4a16d5),
+     V8_2PART_UINT64_C(0xf64335bc, f065d37d)},
+    {V8_2PART_UINT64_C(0x504bced1, bf8e4e45),
+     V8_2PART_UINT64_C(0x99ea0196, 163fa42e)},
+    {V8_2PART_UINT64_C(0xe45ec286, 2f71e1d6),
+     V8_2PART_UINT64_C(0xc06481fb, 9bcf8d39)},  // 10^-110
+    {V8_2PART_UINT64_C(0x5d767327, bb4e5a4c),
+     V8_2PART_UINT64_C(0xf07da27a, 82c37088)},
+    {V8_2PART_UINT64_C(0x3a6a07f8, d510f86f),
+     V8_2PART_UINT64_C(0x964e858c, 91ba2655)},
+    {V8_2PART_UINT64_C(0x890489f7, 0a55368b),
+     V8_2PART_UINT64_C(0xbbe226ef, b628afea)},
+    {V8_2PART_UINT64_C(0x2b45ac74, ccea842e),
+     V8_2PART_UINT64_C(0xeadab0ab, a3b2dbe5)},
+    {V8_2PART_UINT64_C(0x3b0b8bc9, 0012929d),
+     V8_2PART_UINT64_C(0x92c8ae6b, 464fc96f)},
+    {V8_2PART_UINT64_C(0x09ce6ebb, 40173744),
+     V8_2PART_UINT64_C(0xb77ada06, 17e3bbcb)},
+    {V8_2PART_UINT64_C(0xcc420a6a, 101d0515),
+     V8_2PART_UINT64_C(0xe5599087, 9ddcaabd)},
+    {V8_2PART_UINT64_C(0x9fa94682, 4a12232d),
+     V8_2PART_UINT64_C(0x8f57fa54, c2a9eab6)},
+    {V8_2PART_UINT64_C(0x47939822, dc96abf9),
+     V8_2PART_UINT64_C(0xb32df8e9, f3546564)},
+    {V8_2PART_UINT64_C(0x59787e2b, 93bc56f7),
+     V8_2PART_UINT64_C(0xdff97724, 70297ebd)},  // 10^-100
+    {V8_2PART_UINT64_C(0x57eb4edb, 3c55b65a),
+     V8_2PART_UINT64_C(0x8bfbea76, c619ef36)},
+    {V8_2PART_UINT64_C(0xede62292, 0b6b23f1),
+     V8_2PART_UINT64_C(0xaefae514, 77a06b03)},
+    {V8_2PART_UINT64_C(0xe95fab36, 8e45eced),
+     V8_2PART_UINT64_C(0xdab99e59, 958885c4)},
+    {V8_2PART_UINT64_C(0x11dbcb02, 18ebb414),
+     V8_2PART_UINT64_C(0x88b402f7, fd75539b)},
+    {V8_2PART_UINT64_C(0xd652bdc2, 9f26a119),
+     V8_2PART_UINT64_C(0xaae103b5, fcd2a881)},
+    {V8_2PART_UINT64_C(0x4be76d33, 46f0495f),
+     V8_2PART_UINT64_C(0xd59944a3, 7c0752a2)},
+    {V8_2PART_UINT64_C(0x6f70a440, 0c562ddb),
+     V8_2PART_UINT64_C(0x857fcae6, 2d8493a5)},
+    {V8_2PART_UINT64_C(0xcb4ccd50, 0f6bb952),
+     V8_2PART_UINT64_C(0xa6dfbd9f, b8e5b88e)},
+    {V8_2PART_UINT64_C(0x7e2000a4, 1346a7a7),
+     V8_2PART_UINT64_C(0xd097ad07, a71f26b2)},
+    {V8_2PART_UINT64_C(0x8ed40066, 8c0c28c8),
+     V8_2PART_UINT64_C(0x825ecc24, c873782f)},  // 10^-90
+    {V8_2PART_UINT64_C(0x72890080, 2f0f32fa),
+     V8_2PART_UINT64_C(0xa2f67f2d, fa90563b)},
+    {V8_2PART_UINT64_C(0x4f2b40a0, 3ad2ffb9),
+     V8_2PART_UINT64_C(0xcbb41ef9, 79346bca)},
+    {V8_2PART_UINT64_C(0xe2f610c8, 4987bfa8),
+     V8_2PART_UINT64_C(0xfea126b7, d78186bc)},
+    {V8_2PART_UINT64_C(0x0dd9ca7d, 2df4d7c9),
+     V8_2PART_UINT64_C(0x9f24b832, e6b0f436)},
+    {V8_2PART_UINT64_C(0x91503d1c, 79720dbb),
+     V8_2PART_UINT64_C(0xc6ede63f, a05d3143)},
+    {V8_2PART_UINT64_C(0x75a44c63, 97ce912a),
+     V8_2PART_UINT64_C(0xf8a95fcf, 88747d94)},
+    {V8_2PART_UINT64_C(0xc986afbe, 3ee11aba),
+     V8_2PART_UINT64_C(0x9b69dbe1, b548ce7c)},
+    {V8_2PART_UINT64_C(0xfbe85bad, ce996168),
+     V8_2PART_UINT64_C(0xc24452da, 229b021b)},
+    {V8_2PART_UINT64_C(0xfae27299, 423fb9c3),
+     V8_2PART_UINT64_C(0xf2d56790, ab41c2a2)},
+    {V8_2PART_UINT64_C(0xdccd879f, c967d41a),
+     V8_2PART_UINT64_C(0x97c560ba, 6b0919a5)},  // 10^-80
+    {V8_2PART_UINT64_C(0x5400e987, bbc1c920),
+     V8_2PART_UINT64_C(0xbdb6b8e9, 05cb600f)},
+    {V8_2PART_UINT64_C(0x290123e9, aab23b68),
+     V8_2PART_UINT64_C(0xed246723, 473e3813)},
+    {V8_2PART_UINT64_C(0xf9a0b672, 0aaf6521),
+     V8_2PART_UINT64_C(0x9436c076, 0c86e30b)},
+    {V8_2PART_UINT64_C(0xf808e40e, 8d5b3e69),
+     V8_2PART_UINT64_C(0xb9447093, 8fa89bce)},
+    {V8_2PART_UINT64_C(0xb60b1d12, 30b20e04),
+     V8_2PART_UINT64_C(0xe7958cb8, 7392c2c2)},
+    {V8_2PART_UINT64_C(0xb1c6f22b, 5e6f48c2),
+     V8_2PART_UINT64_C(0x90bd77f3, 483bb9b9)},
+    {V8_2PART_UINT64_C(0x1e38aeb6, 360b1af3),
+     V8_2PART_UINT64_C(0xb4ecd5f0, 1a4aa828)},
+    {V8_2PART_UINT64_C(0x25c6da63, c38de1b0),
+     V8_2PART_UINT64_C(0xe2280b6c, 20dd5232)},
+    {V8_2PART_UINT64_C(0x579c487e, 5a38ad0e),
+     V8_2PART_UINT64_C(0x8d590723, 948a535f)},
+    {V8_2PART_UINT64_C(0x2d835a9d, f0c6d851),
+     V8_2PART_UINT64_C(0xb0af48ec, 79ace837)},  // 10^-70
+    {V8_2PART_UINT64_C(0xf8e43145, 6cf88e65),
+     V8_2PART_UINT64_C(0xdcdb1b27, 98182244)},
+    {V8_2PART_UINT64_C(0x1b8e9ecb, 641b58ff),
+     V8_2PART_UINT64_C(0x8a08f0f8, bf0f156b)},
+    {V8_2PART_UINT64_C(0xe272467e, 3d222f3f),
+     V8_2PART_UINT64_C(0xac8b2d36, eed2dac5)},
+    {V8_2PART_UINT64_C(0x5b0ed81d, cc6abb0f),
+     V8_2PART_UINT64_C(0xd7adf884, aa879177)},
+    {V8_2PART_UINT64_C(0x98e94712, 9fc2b4e9),
+     V8_2PART_UINT64_C(0x86ccbb52, ea94baea)},
+    {V8_2PART_UINT64_C(0x3f2398d7, 47b36224),
+     V8_2PART_UINT64_C(0xa87fea27, a539e9a5)},
+    {V8_2PART_UINT64_C(0x8eec7f0d, 19a03aad),
+     V8_2PART_UINT64_C(0xd29fe4b1, 8e88640e)},
+    {V8_2PART_UINT64_C(0x1953cf68, 300424ac),
+     V8_2PART_UINT64_C(0x83a3eeee, f9153e89)},
+    {V8_2PART_UINT64_C(0x5fa8c342, 3c052dd7),
+     V8_2PART_UINT64_C(0xa48ceaaa, b75a8e2b)},
+    {V8_2PART_UINT64_C(0x3792f412, cb06794d),
+     V8_2PART_UINT64_C(0xcdb02555, 653131b6)},  // 10^-60
+    {V8_2PART_UINT64_C(0xe2bbd88b, bee40bd0),
+     V8_2PART_UINT64_C(0x808e1755, 5f3ebf11)},
+    {V8_2PART_UINT64_C(0x5b6aceae, ae9d0ec4),
+     V8_2PART_UINT64_C(0xa0b19d2a, b70e6ed6)},
+    {V8_2PART_UINT64_C(0xf245825a, 5a445275),
+     V8_2PART_UINT64_C(0xc8de0475, 64d20a8b)},
+    {V8_2PART_UINT64_C(0xeed6e2f0, f0d56712),
+     V8_2PART_UINT64_C(0xfb158592, be068d2e)},
+    {V8_2PART_UINT64_C(0x55464dd6, 9685606b),
+     V8_2PART_UINT64_C(0x9ced737b, b6c4183d)},
+    {V8_2PART_UINT64_C(0xaa97e14c, 3c26b886),
+     V8_2PART_UINT64_C(0xc428d05a, a4751e4c)},
+    {V8_2PART_UINT64_C(0xd53dd99f, 4b3066a8),
+     V8_2PART_UINT64_C(0xf5330471, 4d9265df)},
+    {V8_2PART_UINT64_C(0xe546a803, 8efe4029),
+     V8_2PART_UINT64_C(0x993fe2c6, d07b7fab)},
+    {V8_2PART_UINT64_C(0xde985204, 72bdd033),
+     V8_2PART_UINT64_C(0xbf8fdb78, 849a5f96)},
+    {V8_2PART_UINT64_C(0x963e6685, 8f6d4440),
+     V8_2PART_UINT64_C(0xef73d256, a5c0f77c)},  // 10^-50
+    {V8_2PART_UINT64_C(0xdde70013, 79a44aa8),
+     V8_2PART_UINT64_C(0x95a86376, 27989aad)},
+    {V8_2PART_UINT64_C(0x5560c018, 580d5d52),
+     V8_2PART_UINT64_C(0xbb127c53, b17ec159)},
+    {V8_2PART_UINT64_C(0xaab8f01e, 6e10b4a6),
+     V8_2PART_UINT64_C(0xe9d71b68, 9dde71af)},
+    {V8_2PART_UINT64_C(0xcab39613, 04ca70e8),
+     V8_2PART_UINT64_C(0x92267121, 62ab070d)},
+    {V8_2PART_UINT64_C(0x3d607b97, c5fd0d22),
+     V8_2PART_UINT64_C(0xb6b00d69, bb55c8d1)},
+    {V8_2PART_UINT64_C(0x8cb89a7d, b77c506a),
+     V8_2PART_UINT64_C(0xe45c10c4, 2a2b3b05)},
+    {V8_2PART_UINT64_C(0x77f3608e, 92adb242),
+     V8_2PART_UINT64_C(0x8eb98a7a, 9a5b04e3)},
+    {V8_2PART_UINT64_C(0x55f038b2, 37591ed3),
+     V8_2PART_UINT64_C(0xb267ed19, 40f1c61c)},
+    {V8_2PART_UINT64_C(0x6b6c46de, c52f6688),
+     V8_2PART_UINT64_C(0xdf01e85f, 912e37a3)},
+    {V8_2PART_UINT64_C(0x2323ac4b, 3b3da015),
+     V8_2PART_UINT64_C(0x8b61313b, babce2c6)},  // 10^-40
+    {V8_2PART_UINT64_C(0xabec975e, 0a0d081a),
+     V8_2PART_UINT64_C(0xae397d8a, a96c1b77)},
+    {V8_2PART_UINT64_C(0x96e7bd35, 8c904a21),
+     V8_2PART_UINT64_C(0xd9c7dced, 53c72255)},
+    {V8_2PART_UINT64_C(0x7e50d641, 77da2e54),
+     V8_2PART_UINT64_C(0x881cea14, 545c7575)},
+    {V8_2PART_UINT64_C(0xdde50bd1, d5d0b9e9),
+     V8_2PART_UINT64_C(0xaa242499, 697392d2)},
+    {V8_2PART_UINT64_C(0x955e4ec6, 4b44e864),
+     V8_2PART_UINT64_C(0xd4ad2dbf, c3d07787)},
+    {V8_2PART_UINT64_C(0xbd5af13b, ef0b113e),
+     V8_2PART_UINT64_C(0x84ec3c97, da624ab4)},
+    {V8_2PART_UINT64_C(0xecb1ad8a, eacdd58e),
+     V8_2PART_UINT64_C(0xa6274bbd, d0fadd61)},
+    {V8_2PART_UINT64_C(0x67de18ed, a5814af2),
+     V8_2PART_UINT64_C(0xcfb11ead, 453994ba)},
+    {V8_2PART_UINT64_C(0x80eacf94, 8770ced7),
+     V8_2PART_UINT64_C(0x81ceb32c, 4b43fcf4)},
+    {V8_2PART_UINT64_C(0xa1258379, a94d028d),
+     V8_2PART_UINT64_C(0xa2425ff7, 5e14fc31)},  // 10^-30
+    {V8_2PART_UINT64_C(0x096ee458, 13a04330),
+     V8_2PART_UINT64_C(0xcad2f7f5, 359a3b3e)},
+    {V8_2PART_UINT64_C(0x8bca9d6e, 188853fc),
+     V8_2PART_UINT64_C(0xfd87b5f2, 8300ca0d)},
+    {V8_2PART_UINT64_C(0x775ea264, cf55347d),
+     V8_2PART_UINT64_C(0x9e74d1b7, 91e07e48)},
+    {V8_2PART_UINT64_C(0x95364afe, 032a819d),
+     V8_2PART_UINT64_C(0xc6120625, 76589dda)},
+    {V8_2PART_UINT64_C(0x3a83ddbd, 83f52204),
+     V8_2PART_UINT64_C(0xf79687ae, d3eec551)},
+    {V8_2PART_UINT64_C(0xc4926a96, 72793542),
+     V8_2PART_UINT64_C(0x9abe14cd, 44753b52)},
+    {V8_2PART_UINT64_C(0x75b7053c, 0f178293),
+     V8_2PART_UINT64_C(0xc16d9a00, 95928a27)},
+    {V8_2PART_UINT64_C(0x5324c68b, 12dd6338),
+     V8_2PART_UINT64_C(0xf1c90080, baf72cb1)},
+    {V8_2PART_UINT64_C(0xd3f6fc16, ebca5e03),
+     V8_2PART_UINT64_C(0x971da050, 74da7bee)},
+    {V8_2PART_UINT64_C(0x88f4bb1c, a6bcf584),
+     V8_2PART_UINT64_C(0xbce50864, 92111aea)},  // 10^-20
+    {V8_2PART_UINT64_C(0x2b31e9e3, d06c32e5),
+     V8_2PART_UINT64_C(0xec1e4a7d, b69561a5)},
+    {V8_2PART_UINT64_C(0x3aff322e, 62439fcf),
+     V8_2PART_UINT64_C(0x9392ee8e, 921d5d07)},
+    {V8_2PART_UINT64_C(0x09befeb9, fad487c2),
+     V8_2PART_UINT64_C(0xb877aa32, 36a4b449)},
+    {V8_2PART_UINT64_C(0x4c2ebe68, 7989a9b3),
+     V8_2PART_UINT64_C(0xe69594be, c44de15b)},
+    {V8_2PART_UINT64_C(0x0f9d3701, 4bf60a10),
+     V8_2PART_UINT64_C(0x901d7cf7, 3ab0acd9)},
+    {V8_2PART_UINT64_C(0x538484c1, 9ef38c94),
+     V8_2PART_UINT64_C(0xb424dc35, 095cd80f)},
+    {V8_2PART_UINT64_C(0x2865a5f2, 06b06fb9),
+     V8_2PART_UINT64_C(0xe12e1342, 4bb40e13)},
+    {V8_2PART_UINT64_C(0xf93f87b7, 442e45d3),
+     V8_2PART_UINT64_C(0x8cbccc09, 6f5088cb)},
+    {V8_2PART_UINT64_C(0xf78f69a5, 1539d748),
+     V8_2PART_UINT64_C(0xafebff0b, cb24aafe)},
+    {V8_2PART_UINT64_C(0xb573440e, 5a884d1b),
+     V8_2PART_UINT64_C(0xdbe6fece, bdedd5be)},  // 10^-10
+    {V8_2PART_UINT64_C(0x31680a88, f8953030),
+     V8_2PART_UINT64_C(0x89705f41, 36b4a597)},
+    {V8_2PART_UINT64_C(0xfdc20d2b, 36ba7c3d),
+     V8_2PART_UINT64_C(0xabcc7711, 8461cefc)},
+    {V8_2PART_UINT64_C(0x3d329076, 04691b4c),
+     V8_2PART_UINT64_C(0xd6bf94d5, e57a42bc)},
+    {V8_2PART_UINT64_C(0xa63f9a49, c2c1b10f),
+     V8_2PART_UINT64_C(0x8637bd05, af6c69b5)},
+    {V8_2PART_UINT64_C(0x0fcf80dc, 33721d53),
+     V8_2PART_UINT64_C(0xa7c5ac47, 1b478423)},
+    {V8_2PART_UINT64_C(0xd3c36113, 404ea4a8),
+     V8_2PART_UINT64_C(0xd1b71758, e219652b)},
+    {V8_2PART_UINT64_C(0x645a1cac, 083126e9),
+     V8_2PART_UINT64_C(0x83126e97, 8d4fdf3b)},
+    {V8_2PART_UINT64_C(0x3d70a3d7, 0a3d70a3),
+     V8_2PART_UINT64_C(0xa3d70a3d, 70a3d70a)},
+    {V8_2PART_UINT64_C(0xcccccccc, cccccccc),
+     V8_2PART_UINT64_C(0xcccccccc, cccccccc)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x80000000, 00000000)},  // 10^0
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xa0000000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xc8000000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xfa000000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x9c400000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xc3500000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xf4240000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x98968000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xbebc2000, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xee6b2800, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x9502f900, 00000000)},  // 10^10
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xba43b740, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xe8d4a510, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x9184e72a, 00000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xb5e620f4, 80000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xe35fa931, a0000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x8e1bc9bf, 04000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xb1a2bc2e, c5000000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xde0b6b3a, 76400000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x8ac72304, 89e80000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xad78ebc5, ac620000)},  // 10^20
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xd8d726b7, 177a8000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x87867832, 6eac9000)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xa968163f, 0a57b400)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xd3c21bce, cceda100)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0x84595161, 401484a0)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xa56fa5b9, 9019a5c8)},
+    {V8_2PART_UINT64_C(0x00000000, 00000000),
+     V8_2PART_UINT64_C(0xcecb8f27, f4200f3a)},
+    {V8_2PART_UINT64_C(0x40000000, 00000000),
+     V8_2PART_UINT64_C(0x813f3978, f8940984)},
+    {V8_2PART_UINT64_C(0x50000000, 00000000),
+     V8_2PART_UINT64_C(0xa18f07d7, 36b90be5)},
+    {V8_2PART_UINT64_C(0xa4000000, 00000000),
+     V8_2PART_UINT64_C(0xc9f2c9cd, 04674ede)},  // 10^30
+    {V8_2PART_UINT64_C(0x4d000000, 00000000),
+     V8_2PART_UINT64_C(0xfc6f7c40, 45812296)},
+    {V8_2PART_UINT64_C(0xf0200000, 00000000),
+     V8_2PART_UINT64_C(0x9dc5ada8, 2b70b59d)},
+    {V8_2PART_UINT64_C(0x6c280000, 00000000),
+     V8_2PART_UINT64_C(0xc5371912, 364ce305)},
+    {V8_2PART_UINT64_C(0xc7320000, 00000000),
+     V8_2PART_UINT64_C(0xf684df56, c3e01bc6)},
+    {V8_2PART_UINT64_C(0x3c7f4000, 00000000),
+     V8_2PART_UINT64_C(0x9a130b96, 3a6c115c)},
+    {V8_2PART_UINT64_C(0x4b9f1000, 00000000),
+     V8_2PART_UINT64_C(0xc097ce7b, c90715b3)},
+    {V8_2PART_UINT64_C(0x1e86d400, 00000000),
+     V8_2PART_UINT64_C(0xf0bdc21a, bb48db20)},
+    {V8_2PART_UINT64_C(0x13144480, 00000000),
+     V8_2PART_UINT64_C(0x96769950, b50d88f4)},
+    {V8_2PART_UINT64_C(0x17d955a0, 00000000),
+     V8_2PART_UINT64_C(0xbc143fa4, e250eb31)},
+    {V8_2PART_UINT64_C(0x5dcfab08, 00000000),
+     V8_2PART_UINT64_C(0xeb194f8e, 1ae525fd)},  // 10^40
+    {V8_2PART_UINT64_C(0x5aa1cae5, 00000000),
+     V8_2PART_UINT64_C(0x92efd1b8, d0cf37be)},
+    {V8_2PART_UINT64_C(0xf14a3d9e, 40000000),
+     V8_2PART_UINT64_C(0xb7abc627, 050305ad)},
+    {V8_2PART_UINT64_C(0x6d9ccd05, d0000000),
+     V8_2PART_UINT64_C(0xe596b7b0, c643c719)},
+    {V8_2PART_UINT64_C(0xe4820023, a2000000),
+     V8_2PART_UINT64_C(0x8f7e32ce, 7bea5c6f)},
+    {V8_2PART_UINT64_C(0xdda2802c, 8a800000),
+     V8_2PART_UINT64_C(0xb35dbf82, 1ae4f38b)},
+    {V8_2PART_UINT64_C(0xd50b2037, ad200000),
+     V8_2PART_UINT64_C(0xe0352f62, a19e306e)},
+    {V8_2PART_UINT64_C(0x4526f422, cc340000),
+     V8_2PART_UINT64_C(0x8c213d9d, a502de45)},
+    {V8_2PART_UINT64_C(0x9670b12b, 7f410000),
+     V8_2PART_UINT64_C(0xaf298d05, 0e4395d6)},
+    {V8_2PART_UINT64_C(0x3c0cdd76, 5f114000),
+     V8_2PART_UINT64_C(0xdaf3f046, 51d47b4c)},
+    {V8_2PART_UINT64_C(0xa5880a69, fb6ac800),
+     V8_2PART_UINT64_C(0x88d8762b, f324cd0f)},  // 10^50
+    {V8_2PART_UINT64_C(0x8eea0d04, 7a457a00),
+     V8_2PART_UINT64_C(0xab0e93b6, efee0053)},
+    {V8_2PART_UINT64_C(0x72a49045, 98d6d880),
+     V8_2PART_UINT64_C(0xd5d238a4, abe98068)},
+    {V8_2PART_UINT64_C(0x47a6da2b, 7f864750),
+     V8_2PART_UINT64_C(0x85a36366, eb71f041)},
+    {V8_2PART_UINT64_C(0x999090b6, 5f67d924),
+     V8_2PART_UINT64_C(0xa70c3c40, a64e6c51)},
+    {V8_2PART_UINT64_C(0xfff4b4e3, f741cf6d),
+     V8_2PART_UINT64_C(0xd0cf4b50, cfe20765)},
+    {V8_2PART_UINT64_C(0xbff8f10e, 7a8921a4),
+     V8_2PART_UINT64_C(0x82818f12, 81ed449f)},
+    {V8_2PART_UINT64_C(0xaff72d52, 192b6a0d),
+     V8_2PART_UINT64_C(0xa321f2d7, 226895c7)},
+    {V8_2PART_UINT64_C(0x9bf4f8a6, 9f764490),
+     V8_2PART_UINT64_C(0xcbea6f8c, eb02bb39)},
+    {V8_2PART_UINT64_C(0x02f236d0, 4753d5b4),
+     V8_2PART_UINT64_C(0xfee50b70, 25c36a08)},
+    {V8_2PART_UINT64_C(0x01d76242, 2c946590),
+     V8_2PART_UINT64_C(0x9f4f2726, 179a2245)},  // 10^60
+    {V8_2PART_UINT64_C(0x424d3ad2, b7b97ef5),
+     V8_2PART_UINT64_C(0xc722f0ef, 9d80aad6)},
+    {V8_2PART_UINT64_C(0xd2e08987, 65a7deb2),
+     V8_2PART_UINT64_C(0xf8ebad2b, 84e0d58b)},
+    {V8_2PART_UINT64_C(0x63cc55f4, 9f88eb2f),
+     V8_2PART_UINT64_C(0x9b934c3b, 330c8577)},
+    {V8_2PART_UINT64_C(0x3cbf6b71, c76b25fb),
+     V8_2PART_UINT64_C(0xc2781f49, ffcfa6d5)},
+    {V8_2PART_UINT64_C(0x8bef464e, 3945ef7a),
+     V8_2PART_UINT64_C(0xf316271c, 7fc3908a)},
+    {V8_2PART_UINT64_C(0x97758bf0, e3cbb5ac),
+     V8_2PART_UINT64_C(0x97edd871, cfda3a56)},
+    {V8_2PART_UINT64_C(0x3d52eeed, 1cbea317),
+     V8_2PART_UINT64_C(0xbde94e8e, 43d0c8ec)},
+    {V8_2PART_UINT64_C(0x4ca7aaa8, 63ee4bdd),
+     V8_2PART_UINT64_C(0xed63a231, d4c4fb27)},
+    {V8_2PART_UINT64_C(0x8fe8caa9, 3e74ef6a),
+     V8_2PART_UINT64_C(0x945e455f, 24fb1cf8)},
+    {V8_2PART_UINT64_C(0xb3e2fd53, 8e122b44),
+     V8_2PART_UINT64_C(0xb975d6b6, ee39e436)},  // 10^70
+    {V8_2PART_UINT64_C(0x60dbbca8, 7196b616),
+     V8_2PART_UINT64_C(0xe7d34c64, a9c85d44)},
+    {V8_2PART_UINT64_C(0xbc8955e9, 46fe31cd),
+     V8_2PART_UINT64_C(0x90e40fbe, ea1d3a4a)},
+    {V8_2PART_UINT64_C(0x6babab63, 98bdbe41),
+     V8_2PART_UINT64_C(0xb51d13ae, a4a488dd)},
+    {V8_2PART_UINT64_C(0xc696963c, 7eed2dd1),
+     V8_2PART_UINT64_C(0xe264589a, 4dcdab14)},
+    {V8_2PART_UINT64_C(0xfc1e1de5, cf543ca2),
+     V8_2PART_UINT64_C(0x8d7eb760, 70a08aec)},
+    {V8_2PART_UINT64_C(0x3b25a55f, 43294bcb),
+     V8_2PART_UINT64_C(0xb0de6538, 8cc8ada8)},
+    {V8_2PART_UINT64_C(0x49ef0eb7, 13f39ebe),
+     V8_2PART_UINT64_C(0xdd15fe86, affad912)},
+    {V8_2PART_UINT64_C(0x6e356932, 6c784337),
+     V8_2PART_UINT64_C(0x8a2dbf14, 2dfcc7ab)},
+    {V8_2PART_UINT64_C(0x49c2c37f, 07965404),
+     V8_2PART_UINT64_C(0xacb92ed9, 397bf996)},
+    {V8_2PART_UINT64_C(0xdc33745e, c97be906),
+     V8_2PART_UINT64_C(0xd7e77a8f, 87daf7fb)},  // 10^80
+    {V8_2PART_UINT64_C(0x69a028bb, 3ded71a3),
+     V8_2PART_UINT64_C(0x86f0ac99, b4e8dafd)},
+    {V8_2PART_UINT64_C(0xc40832ea, 0d68ce0c),
+     V8_2PART_UINT64_C(0xa8acd7c0, 222311bc)},
+    {V8_2PART_UINT64_C(0xf50a3fa4, 90c30190),
+     V8_2PART_UINT64_C(0xd2d80db0, 2aabd62b)},
+    {V8_2PART_UINT64_C(0x792667c6, da79e0fa),
+     V8_2PART_UINT64_C(0x83c7088e, 1aab65db)},
+    {V8_2PART_UINT64_C(0x577001b8, 91185938),
+     V8_2PART_UINT64_C(0xa4b8cab1, a1563f52)},
+    {V8_2PART_UINT64_C(0xed4c0226, b55e6f86),
+     V8_2PART_UINT64_C(0xcde6fd5e, 09abcf26)},
+    {V8_2PART_UINT64_C(0x544f8158, 315b05b4),
+     V8_2PART_UINT64_C(0x80b05e5a, c60b6178)},
+    {V8_2PART_UINT64_C(0x696361ae, 3db1c721),
+     V8_2PART_UINT64_C(0xa0dc75f1, 778e39d6)},
+    {V8_2PART_UINT64_C(0x03bc3a19, cd1e38e9),
+     V8_2PART_UINT64_C(0xc913936d, d571c84c)},
+    {V8_2PART_UINT64_C(0x04ab48a0, 4065c723),
+     V8_2PART_UINT64_C(0xfb587849, 4ace3a5f)},  // 10^90
+    {V8_2PART_UINT64_C(0x62eb0d64, 283f9c76),
+     V8_2PART_UINT64_C(0x9d174b2d, cec0e47b)},
+    {V8_2PART_UINT64_C(0x3ba5d0bd, 324f8394),
+     V8_2PART_UINT64_C(0xc45d1df9, 42711d9a)},
+    {V8_2PART_UINT64_C(0xca8f44ec, 7ee36479),
+     V8_2PART_UINT64_C(0xf5746577, 930d6500)},
+    {V8_2PART_UINT64_C(0x7e998b13, cf4e1ecb),
+     V8_2PART_UINT64_C(0x9968bf6a, bbe85f20)},
+    {V8_2PART_UINT64_C(0x9e3fedd8, c321a67e),
+     V8_2PART_UINT64_C(0xbfc2ef45, 6ae276e8)},
+    {V8_2PART_UINT64_C(0xc5cfe94e, f3ea101e),
+     V8_2PART_UINT64_C(0xefb3ab16, c59b14a2)},
+    {V8_2PART_UINT64_C(0xbba1f1d1, 58724a12),
+     V8_2PART_UINT64_C(0x95d04aee, 3b80ece5)},
+    {V8_2PART_UINT64_C(0x2a8a6e45, ae8edc97),
+     V8_2PART_UINT64_C(0xbb445da9, ca61281f)},
+    {V8_2PART_UINT64_C(0xf52d09d7, 1a3293bd),
+     V8_2PART_UINT64_C(0xea157514, 3cf97226)},
+    {V8_2PART_UINT64_C(0x593c2626, 705f9c56),
+     V8_2PART_UINT64_C(0x924d692c, a61be758)},  // 10^100
+    {V8_2PART_UINT64_C(0x6f8b2fb0, 0c77836c),
+     V8_2PART_UINT64_C(0xb6e0c377, cfa2e12e)},
+    {V8_2PART_UINT64_C(0x0b6dfb9c, 0f956447),
+     V8_2PART_UINT64_C(0xe498f455, c38b997a)},
+    {V8_2PART_UINT64_C(0x4724bd41, 89bd5eac),
+     V8_2PART_UINT64_C(0x8edf98b5, 9a373fec)},
+    {V8_2PART_UINT64_C(0x58edec91, ec2cb657),
+     V8_2PART_UINT64_C(0xb2977ee3, 00c50fe7)},
+    {V8_2PART_UINT64_C(0x2f2967b6, 6737e3ed),
+     V8_2PART_UINT64_C(0xdf3d5e9b, c0f653e1)},
+    {V8_2PART_UINT64_C(0xbd79e0d2, 0082ee74),
+     V8_2PART_UINT64_C(0x8b865b21, 5899f46c)},
+    {V8_2PART_UINT64_C(0xecd85906, 80a3aa11),
+     V8_2PART_UINT64_C(0xae67f1e9, aec07187)},
+    {V8_2PART_UINT64_C(0xe80e6f48, 20cc9495),
+     V8_2PART_UINT64_C(0xda01ee64, 1a708de9)},
+    {V8_2PART_UINT64_C(0x3109058d, 147fdcdd),
+     V8_2PART_UINT64_C(0x884134fe, 908658b2)},
+    {V8_2PART_UINT64_C(0xbd4b46f0, 599fd415),
+     V8_2PART_UINT64_C(0xaa51823e, 34a7eede)},  // 10^110
+    {V8_2PART_UINT64_C(0x6c9e18ac, 7007c91a),
+     V8_2PART_UINT64_C(0xd4e5e2cd, c1d1ea96)},
+    {V8_2PART_UINT64_C(0x03e2cf6b, c604ddb0),
+     V8_2PART_UINT64_C(0x850fadc0, 9923329e)},
+    {V8_2PART_UINT64_C(0x84db8346, b786151c),
+     V8_2PART_UINT64_C(0xa6539930, bf6bff45)},
+    {V8_2PART_UINT64_C(0xe6126418, 65679a63),
+     V8_2PART_UINT64_C(0xcfe87f7c, ef46ff16)},
+    {V8_2PART_UINT64_C(0x4fcb7e8f, 3f60c07e),
+     V8_2PART_UINT64_C(0x81f14fae, 158c5f6e)},
+    {V8_2PART_UINT64_C(0xe3be5e33, 0f38f09d),
+     V8_2PART_UINT64_C(0xa26da399, 9aef7749)},
+    {V8_2PART_UINT64_C(0x5cadf5bf, d3072cc5),
+     V8_2PART_UINT64_C(0xcb090c80, 01ab551c)},
+    {V8_2PART_UINT64_C(0x73d9732f, c7c8f7f6),
+     V8_2PART_UINT64_C(0xfdcb4fa0, 02162a63)},
+    {V8_2PART_UINT64_C(0x2867e7fd, dcdd9afa),
+     V8_2PART_UINT64_C(0x9e9f11c4, 014dda7e)},
+    {V8_2PART_UINT64_C(0xb281e1fd, 541501b8),
+     V8_2PART_UINT64_C(0xc646d635, 01a1511d)},  // 10^120
+    {V8_2PART_UINT64_C(0x1f225a7c, a91a4226),
+     V8_2PART_UINT64_C(0xf7d88bc2, 4209a565)},
+    {V8_2PART_UINT64_C(0x3375788d, e9b06958),
+     V8_2PART_UINT64_C(0x9ae75759, 6946075f)},
+    {V8_2PART_UINT64_C(0x0052d6b1, 641c83ae),
+     V8_2PART_UINT64_C(0xc1a12d2f, c3978937)},
+    {V8_2PART_UINT64_C(0xc0678c5d, bd23a49a),
+     V8_2PART_UINT64_C(0xf209787b, b47d6b84)},
+    {V8_2PART_UINT64_C(0xf840b7ba, 963646e0),
+     V8_2PART_UINT64_C(0x9745eb4d, 50ce6332)},
+    {V8_2PART_UINT64_C(0xb650e5a9, 3bc3d898),
+     V8_2PART_UINT64_C(0xbd176620, a501fbff)},
+    {V8_2PART_UINT64_C(0xa3e51f13, 8ab4cebe),
+     V8_2PART_UINT64_C(0xec5d3fa8, ce427aff)},
+    {V8_2PART_UINT64_C(0xc66f336c, 36b10137),
+     V8_2PART_UINT64_C(0x93ba47c9, 80e98cdf)},
+    {V8_2PART_UINT64_C(0xb80b0047, 445d4184),
+     V8_2PART_UINT64_C(0xb8a8d9bb, e123f017)},
+    {V8_2PART_UINT64_C(0xa60dc059, 157491e5),
+     V8_2PART_UINT64_C(0xe6d3102a, d96cec1d)},  // 10^130
+    {V8_2PART_UINT64_C(0x87c89837, ad68db2f),
+     V8_2PART_UINT64_C(0x9043ea1a, c7e41392)},
+    {V8_2PART_UINT64_C(0x29babe45, 98c311fb),
+     V8_2PART_UINT64_C(0xb454e4a1, 79dd1877)},
+    {V8_2PART_UINT64_C(0xf4296dd6, fef3d67a),
+     V8_2PART_UINT64_C(0xe16a1dc9, d8545e94)},
+    {V8_2PART_UINT64_C(0x1899e4a6, 5f58660c),
+     V8_2PART_UINT64_C(0x8ce2529e, 2734bb1d)},
+    {V8_2PART_UINT64_C(0x5ec05dcf, f72e7f8f),
+     V8_2PART_UINT64_C(0xb01ae745, b101e9e4)},
+    {V8_2PART_UINT64_C(0x76707543, f4fa1f73),
+     V8_2PART_UINT64_C(0xdc21a117, 1d42645d)},
+    {V8_2PART_UINT64_C(0x6a06494a, 791c53a8),
+     V8_2PART_UINT64_C(0x899504ae, 72497eba)},
+    {V8_2PART_UINT64_C(0x0487db9d, 17636892),
+     V8_2PART_UINT64_C(0xabfa45da, 0edbde69)},
+    {V8_2PART_UINT64_C(0x45a9d284, 5d3c42b6),
+     V8_2PART_UINT64_C(0xd6f8d750, 9292d603)},
+    {V8_2PART_UINT64_C(0x0b8a2392, ba45a9b2),
+     V8_2PART_UINT64_C(0x865b8692, 5b9bc5c2)},  // 10^140
+    {V8_2PART_UINT64_C(0x8e6cac77, 68d7141e),
+     V8_2PART_UINT64_C(0xa7f26836, f282b732)},
+    {V8_2PART_UINT64_C(0x3207d795, 430cd926),
+     V8_2PART_UINT64_C(0xd1ef0244, af2364ff)},
+    {V8_2PART_UINT64_C(0x7f44e6bd, 49e807b8),
+     V8_2PART_UINT64_C(0x8335616a, ed761f1f)},
+    {V8_2PART_UINT64_C(0x5f16206c, 9c6209a6),
+     V8_2PART_UINT64_C(0xa402b9c5, a8d3a6e7)},
+    {V8_2PART_UINT64_C(0x36dba887, c37a8c0f),
+     V8_2PART_UINT64_C(0xcd036837, 130890a1)},
+    {V8_2PART_UINT64_C(0xc2494954, da2c9789),
+     V8_2PART_UINT64_C(0x80222122, 6be55a64)},
+    {V8_2PART_UINT64_C(0xf2db9baa, 10b7bd6c),
+     V8_2PART_UINT64_C(0xa02aa96b, 06deb0fd)},
+    {V8_2PART_UINT64_C(0x6f928294, 94e5acc7),
+     V8_2PART_UINT64_C(0xc83553c5, c8965d3d)},
+    {V8_2PART_UINT64_C(0xcb772339, ba1f17f9),
+     V8_2PART_UINT64_C(0xfa42a8b7, 3abbf48c)},
+    {V8_2PART_UINT64_C(0xff2a7604, 14536efb),
+     V8_2PART_UINT64_C(0x9c69a972, 84b578d7)},  // 10^150
+    {V8_2PART_UINT64_C(0xfef51385, 19684aba),
+     V8_2PART_UINT64_C(0xc38413cf, 25e2d70d)},
+    {V8_2PART_UINT64_C(0x7eb25866, 5fc25d69),
+     V8_2PART_UINT64_C(0xf46518c2, ef5b8cd1)},
+    {V8_2PART_UINT64_C(0xef2f773f, fbd97a61),
+     V8_2PART_UINT64_C(0x98bf2f79, d5993802)},
+    {V8_2PART_UINT64_C(0xaafb550f, facfd8fa),
+     V8_2PART_UINT64_C(0xbeeefb58, 4aff8603)},
+    {V8_2PART_UINT64_C(0x95ba2a53, f983cf38),
+     V8_2PART_UINT64_C(0xeeaaba2e, 5dbf6784)},
+    {V8_2PART_UINT64_C(0xdd945a74, 7bf26183),
+     V8_2PART_UINT64_C(0x952ab45c, fa97a0b2)},
+    {V8_2PART_UINT64_C(0x94f97111, 9aeef9e4),
+     V8_2PART_UINT64_C(0xba756174, 393d88df)},
+    {V8_2PART_UINT64_C(0x7a37cd56, 01aab85d),
+     V8_2PART_UINT64_C(0xe912b9d1, 478ceb17)},
+    {V8_2PART_UINT64_C(0xac62e055, c10ab33a),
+     V8_2PART_UINT64_C(0x91abb422, ccb812ee)},
+    {V8_2PART_UINT64_C(0x577b986b, 314d6009),
+     V8_2PART_UINT64_C(0xb616a12b, 7fe617aa)},  // 10^160
+    {V8_2PART_UINT64_C(0xed5a7e85, fda0b80b),
+     V8_2PART_UINT64_C(0xe39c4976, 5fdf9d94)},
+    {V8_2PART_UINT64_C(0x14588f13, be847307),
+     V8_2PART_UINT64_C(0x8e41ade9, fbebc27d)},
+    {V8_2PART_UINT64_C(0x596eb2d8, ae258fc8),
+     V8_2PART_UINT64_C(0xb1d21964, 7ae6b31c)},
+    {V8_2PART_UINT64_C(0x6fca5f8e, d9aef3bb),
+     V8_2PART_UINT64_C(0xde469fbd, 99a05fe3)},
+    {V8_2PART_UINT64_C(0x25de7bb9, 480d5854),
+     V8_2PART_UINT64_C(0x8aec23d6, 80043bee)},
+    {V8_2PART_UINT64_C(0xaf561aa7, 9a10ae6a),
+     V8_2PART_UINT64_C(0xada72ccc, 20054ae9)},
+    {V8_2PART_UINT64_C(0x1b2ba151, 8094da04),
+     V8_2PART_UINT64_C(0xd910f7ff, 28069da4)},
+    {V8_2PART_UINT64_C(0x90fb44d2, f05d0842),
+     V8_2PART_UINT64_C(0x87aa9aff, 79042286)},
+    {V8_2PART_UINT64_C(0x353a1607, ac744a53),
+     V8_2PART_UINT64_C(0xa99541bf, 57452b28)},
+    {V8_2PART_UINT64_C(0x42889b89, 97915ce8),
+     V8_2PART_UINT64_C(0xd3fa922f, 2d1675f2)},  // 10^170
+    {V8_2PART_UINT64_C(0x69956135, febada11),
+     V8_2PART_UINT64_C(0x847c9b5d, 7c2e09b7)},
+    {V8_2PART_UINT64_C(0x43fab983, 7e699095),
+     V8_2PART_UINT64_C(0xa59bc234, db398c25)},
+    {V8_2PART_UINT64_C(0x94f967e4, 5e03f4bb),
+     V8_2PART_UINT64_C(0xcf02b2c2, 1207ef2e)},
+    {V8_2PART_UINT64_C(0x1d1be0ee, bac278f5),
+     V8_2PART_UINT64_C(0x8161afb9, 4b44f57d)},
+    {V8_2PART_UINT64_C(0x6462d92a, 69731732),
+     V8_2PART_UINT64_C(0xa1ba1ba7, 9e1632dc)},
+    {V8_2PART_UINT64_C(0x7d7b8f75, 03cfdcfe),
+     V8_2PART_UINT64_C(0xca28a291, 859bbf93)},
+    {V8_2PART_UINT64_C(0x5cda7352, 44c3d43e),
+     V8_2PART_UINT64_C(0xfcb2cb35, e702af78)},
+    {V8_2PART_UINT64_C(0x3a088813, 6afa64a7),
+     V8_2PART_UINT64_C(0x9defbf01, b061adab)},
+    {V8_2PART_UINT64_C(0x088aaa18, 45b8fdd0),
+     V8_2PART_UINT64_C(0xc56baec2, 1c7a1916)},
+    {V8_2PART_UINT64_C(0x8aad549e, 57273d45),
+     V8_2PART_UINT64_C(0xf6c69a72, a3989f5b)},  // 10^180
+    {V8_2PART_UINT64_C(0x36ac54e2, f678864b),
+     V8_2PART_UINT64_C(0x9a3c2087, a63f6399)},
+    {V8_2PART_UINT64_C(0x84576a1b, b416a7dd),
+     V8_2PART_UINT64_C(0xc0cb28a9, 8fcf3c7f)},
+    {V8_2PART_UINT64_C(0x656d44a2, a11c51d5),
+     V8_2PART_UINT64_C(0xf0fdf2d3, f3c30b9f)},
+    {V8_2PART_UINT64_C(0x9f644ae5, a4b1b325),
+     V8_2PART_UINT64_C(0x969eb7c4, 7859e743)},
+    {V8_2PART_UINT64_C(0x873d5d9f, 0dde1fee),
+     V8_2PART_UINT64_C(0xbc4665b5, 96706114)},
+    {V8_2PART_UINT64_C(0xa90cb506, d155a7ea),
+     V8_2PART_UINT64_C(0xeb57ff22, fc0c7959)},
+    {V8_2PART_UINT64_C(0x09a7f124, 42d588f2),
+     V8_2PART_UINT64_C(0x9316ff75, dd87cbd8)},
+    {V8_2PART_UINT64_C(0x0c11ed6d, 538aeb2f),
+     V8_2PART_UINT64_C(0xb7dcbf53, 54e9bece)},
+    {V8_2PART_UINT64_C(0x8f1668c8, a86da5fa),
+     V8_2PART_UINT64_C(0xe5d3ef28, 2a242e81)},
+    {V8_2PART_UINT64_C(0xf96e017d, 694487bc),
+     V8_2PART_UINT64_C(0x8fa47579, 1a569d10)},  // 10^190
+    {V8_2PART_UINT64_C(0x37c981dc, c395a9ac),
+     V8_2PART_UINT64_C(0xb38d92d7, 60ec4455)},
+    {V8_2PART_UINT64_C(0x85bbe253, f47b1417),
+     V8_2PART_UINT64_C(0xe070f78d, 3927556a)},
+    {V8_2PART_UINT64_C(0x93956d74, 78ccec8e),
+     V8_2PART_UINT64_C(0x8c469ab8, 43b89562)},
+    {V8_2PART_UINT64_C(0x387ac8d1, 970027b2),
+     V8_2PART_UINT64_C(0xaf584166, 54a6babb)},
+    {V8_2PART_UINT64_C(0x06997b05, fcc0319e),
+     V8_2PART_UINT64_C(0xdb2e51bf, e9d0696a)},
+    {V8_2PART_UINT64_C(0x441fece3, bdf81f03),
+     V8_2PART_UINT64_C(0x88fcf317, f22241e2)},
+    {V8_2PART_UINT64_C(0xd527e81c, ad7626c3),
+     V8_2PART_UINT64_C(0xab3c2fdd, eeaad25a)},
+    {V8_2PART_UINT64_C(0x8a71e223, d8d3b074),
+     V8_2PART_UINT64_C(0xd60b3bd5, 6a5586f1)},
+    {V8_2PART_UINT64_C(0xf6872d56, 67844e49),
+     V8_2PART_UINT64_C(0x85c70565, 62757456)},
+    {V8_2PART_UINT64_C(0xb428f8ac, 016561db),
+     V8_2PART_UINT64_C(0xa738c6be, bb12d16c)},  // 10^200
+    {V8_2PART_UINT64_C(0xe13336d7, 01beba52),
+     V8_2PART_UINT64_C(0xd106f86e, 69d785c7)},
+    {V8_2PART_UINT64_C(0xecc00246, 61173473),
+     V8_2PART_UINT64_C(0x82a45b45, 0226b39c)},
+    {V8_2PART_UINT64_C(0x27f002d7, f95d0190),
+     V8_2PART_UINT64_C(0xa34d7216, 42b06084)},
+    {V8_2PART_UINT64_C(0x31ec038d, f7b441f4),
+     V8_2PART_UINT64_C(0xcc20ce9b, d35c78a5)},
+    {V8_2PART_UINT64_C(0x7e670471, 75a15271),
+     V8_2PART_UINT64_C(0xff290242, c83396ce)},
+    {V8_2PART_UINT64_C(0x0f0062c6, e984d386),
+     V8_2PART_UINT64_C(0x9f79a169, bd203e41)},
+    {V8_2PART_UINT64_C(0x52c07b78, a3e60868),
+     V8_2PART_UINT64_C(0xc75809c4, 2c684dd1)},
+    {V8_2PART_UINT64_C(0xa7709a56, ccdf8a82),
+     V8_2PART_UINT64_C(0xf92e0c35, 37826145)},
+    {V8_2PART_UINT64_C(0x88a66076, 400bb691),
+     V8_2PART_UINT64_C(0x9bbcc7a1, 42b17ccb)},
+    {V8_2PART_UINT64_C(0x6acff893, d00ea435),
+     V8_2PART_UINT64_C(0xc2abf989, 935ddbfe)},  // 10^210
+    {V8_2PART_UINT64_C(0x0583f6b8, c4124d43),
+     V8_2PART_UINT64_C(0xf356f7eb, f83552fe)},
+    {V8_2PART_UINT64_C(0xc3727a33, 7a8b704a),
+     V8_2PART_UINT64_C(0x98165af3, 7b2153de)},
+    {V8_2PART_UINT64_C(0x744f18c0, 592e4c5c),
+     V8_2PART_UINT64_C(0xbe1bf1b0, 59e9a8d6)},
+    {V8_2PART_UINT64_C(0x1162def0, 6f79df73),
+     V8_2PART_UINT64_C(0xeda2ee1c, 7064130c)},
+    {V8_2PART_UINT64_C(0x8addcb56, 45ac2ba8),
+     V8_2PART_UINT64_C(0x9485d4d1, c63e8be7)},
+    {V8_2PART_UINT64_C(0x6d953e2b, d7173692),
+     V8_2PART_UINT64_C(0xb9a74a06, 37ce2ee1)},
+    {V8_2PART_UINT64_C(0xc8fa8db6, ccdd0437),
+     V8_2PART_UINT64_C(0xe8111c87, c5c1ba99)},
+    {V8_2PART_UINT64_C(0x1d9c9892, 400a22a2),
+     V8_2PART_UINT64_C(0x910ab1d4, db9914a0)},
+    {V8_2PART_UINT64_C(0x2503beb6, d00cab4b),
+     V8_2PART_UINT64_C(0xb54d5e4a, 127f59c8)},
+    {V8_2PART_UINT64_C(0x2e44ae64, 840fd61d),
+     V8_2PART_UINT64_C(0xe2a0b5dc, 971f303a)},  // 10^220
+    {V8_2PART_UINT64_C(0x5ceaecfe, d289e5d2),
+     V8_2PART_UINT64_C(0x8da471a9, de737e24)},
+    {V8_2PART_UINT64_C(0x7425a83e, 872c5f47),
+     V8_2PART_UINT64_C(0xb10d8e14, 56105dad)},
+    {V8_2PART_UINT64_C(0xd12f124e, 28f77719),
+     V8_2PART_UINT64_C(0xdd50f199, 6b947518)},
+    {V8_2PART_UINT64_C(0x82bd6b70, d99aaa6f),
+     V8_2PART_UINT64_C(0x8a5296ff, e33cc92f)},
+    {V8_2PART_UINT64_C(0x636cc64d, 1001550b),
+     V8_2PART_UINT64_C(0xace73cbf, dc0bfb7b)},
+    {V8_2PART_UINT64_C(0x3c47f7e0, 5401aa4e),
+     V8_2PART_UINT64_C(0xd8210bef, d30efa5a)},
+    {V8_2PART_UINT64_C(0x65acfaec, 34810a71),
+     V8_2PART_UINT64_C(0x8714a775, e3e95c78)},
+    {V8_2PART_UINT64_C(0x7f1839a7, 41a14d0d),
+     V8_2PART_UINT64_C(0xa8d9d153, 5ce3b396)},
+    {V8_2PART_UINT64_C(0x1ede4811, 1209a050),
+     V8_2PART_UINT64_C(0xd31045a8, 341ca07c)},
+    {V8_2PART_UINT64_C(0x934aed0a, ab460432),
+     V8_2PART_UINT64_C(0x83ea2b89, 2091e44d)},  // 10^230
+    {V8_2PART_UINT64_C(0xf81da84d, 5617853f),
+     V8_2PART_UINT64_C(0xa4e4b66b, 68b65d60)},
+    {V8_2PART_UINT64_C(0x36251260, ab9d668e),
+     V8_2PART_UINT64_C(0xce1de406, 42e3f4b9)},
+    {V8_2PART_UINT64_C(0xc1d72b7c, 6b426019),
+     V8_2PART_UINT64_C(0x80d2ae83, e9ce78f3)},
+    {V8_2PART_UINT64_C(0xb24cf65b, 8612f81f),
+     V8_2PART_UINT64_C(0xa1075a24, e4421730)},
+    {V8_2PART_UINT64_C(0xdee033f2, 6797b627),
+     V8_2PART_UINT64_C(0xc94930ae, 1d529cfc)},
+    {V8_2PART_UINT64_C(0x169840ef, 017da3b1),
+     V8_2PART_UINT64_C(0xfb9b7cd9, a4a7443c)},
+    {V8_2PART_UINT64_C(0x8e1f2895, 60ee864e),
+     V8_2PART_UINT64_C(0x9d412e08, 06e88aa5)},
+    {V8_2PART_UINT64_C(0xf1a6f2ba, b92a27e2),
+     V8_2PART_UINT64_C(0xc491798a, 08a2ad4e)},
+    {V8_2PART_UINT64_C(0xae10af69, 6774b1db),
+     V8_2PART_UINT64_C(0xf5b5d7ec, 8acb58a2)},
+    {V8_2PART_UINT64_C(0xacca6da1, e0a8ef29),
+     V8_2PART_UINT64_C(0x9991a6f3, d6bf1765)},  // 10^240
+    {V8_2PART_UINT64_C(0x17fd090a, 58d32af3),
+     V8_2PART_UINT64_C(0xbff610b0, cc6edd3f)},
+    {V8_2PART_UINT64_C(0xddfc4b4c, ef07f5b0),
+     V8_2PART_UINT64_C(0xeff394dc, ff8a948e)},
+    {V8_2PART_UINT64_C(0x4abdaf10, 1564f98e),
+     V8_2PART_UINT64_C(0x95f83d0a, 1fb69cd9)},
+    {V8_2PART_UINT64_C(0x9d6d1ad4, 1abe37f1),
+     V8_2PART_UINT64_C(0xbb764c4c, a7a4440f)},
+    {V8_2PART_UINT64_C(0x84c86189, 216dc5ed),
+     V8_2PART_UINT64_C(0xea53df5f, d18d5513)},
+    {V8_2PART_UINT64_C(0x32fd3cf5, b4e49bb4),
+     V8_2PART_UINT64_C(0x92746b9b, e2f8552c)},
+    {V8_2PART_UINT64_C(0x3fbc8c33, 221dc2a1),
+     V8_2PART_UINT64_C(0xb7118682, dbb66a77)},
+    {V8_2PART_UINT64_C(0x0fabaf3f, eaa5334a),
+     V8_2PART_UINT64_C(0xe4d5e823, 92a40515)},
+    {V8_2PART_UINT64_C(0x29cb4d87, f2a7400e),
+     V8_2PART_UINT64_C(0x8f05b116, 3ba6832d)},
+    {V8_2PART_UINT64_C(0x743e20e9, ef511012),
+     V8_2PART_UINT64_C(0xb2c71d5b, ca9023f8)},  // 10^250
+    {V8_2PART_UINT64_C(0x914da924, 6b255416),
+     V8_2PART_UINT64_C(0xdf78e4b2, bd342cf6)},
+    {V8_2PART_UINT64_C(0x1ad089b6, c2f7548e),
+     V8_2PART_UINT64_C(0x8bab8eef, b6409c1a)},
+    {V8_2PART_UINT64_C(0xa184ac24, 73b529b1),
+     V8_2PART_UINT64_C(0xae9672ab, a3d0c320)},
+    {V8_2PART_UINT64_C(0xc9e5d72d, 90a2741e),
+     V8_2PART_UINT64_C(0xda3c0f56, 8cc4f3e8)},
+    {V8_2PART_UINT64_C(0x7e2fa67c, 7a658892),
+     V8_2PART_UINT64_C(0x88658996, 17fb1871)},
+    {V8_2PART_UINT64_C(0xddbb901b, 98feeab7),
+     V8_2PART_UINT64_C(0xaa7eebfb, 9df9de8d)},
+    {V8_2PART_UINT64_C(0x552a7422, 7f3ea565),
+     V8_2PART_UINT64_C(0xd51ea6fa, 85785631)},
+    {V8_2PART_UINT64_C(0xd53a8895, 8f87275f),
+     V8_2PART_UINT64_C(0x8533285c, 936b35de)},
+    {V8_2PART_UINT64_C(0x8a892aba, f368f137),
+     V8_2PART_UINT64_C(0xa67ff273, b8460356)},
+    {V8_2PART_UINT64_C(0x2d2b7569, b0432d85),
+     V8_2PART_UINT64_C(0xd01fef10, a657842c)},  // 10^260
+    {V8_2PART_UINT64_C(0x9c3b2962, 0e29fc73),
+     V8_2PART_UINT64_C(0x8213f56a, 67f6b29b)},
+    {V8_2PART_UINT64_C(0x8349f3ba, 91b47b8f),
+     V8_2PART_UINT64_C(0xa298f2c5, 01f45f42)},
+    {V8_2PART_UINT64_C(0x241c70a9, 36219a73),
+     V8_2PART_UINT64_C(0xcb3f2f76, 42717713)},
+    {V8_2PART_UINT64_C(0xed238cd3, 83aa0110),
+     V8_2PART_UINT64_C(0xfe0efb53, d30dd4d7)},
+    {V8_2PART_UINT64_C(0xf4363804, 324a40aa),
+     V8_2PART_UINT64_C(0x9ec95d14, 63e8a506)},
+    {V8_2PART_UINT64_C(0xb143c605, 3edcd0d5),
+     V8_2PART_UINT64_C(0xc67bb459, 7ce2ce48)},
+    {V8_2PART_UINT64_C(0xdd94b786, 8e94050a),
+     V8_2PART_UINT64_C(0xf81aa16f, dc1b81da)},
+    {V8_2PART_UINT64_C(0xca7cf2b4, 191c8326),
+     V8_2PART_UINT64_C(0x9b10a4e5, e9913128)},
+    {V8_2PART_UINT64_C(0xfd1c2f61, 1f63a3f0),
+     V8_2PART_UINT64_C(0xc1d4ce1f, 63f57d72)},
+    {V8_2PART_UINT64_C(0xbc633b39, 673c8cec),
+     V8_2PART_UINT64_C(0xf24a01a7, 3cf2dccf)},  // 10^270
+    {V8_2PART_UINT64_C(0xd5be0503, e085d813),
+     V8_2PART_UINT64_C(0x976e4108, 8617ca01)},
+    {V8_2PART_UINT64_C(0x4b2d8644, d8a74e18),
+     V8_2PART_UINT64_C(0xbd49d14a, a79dbc82)},
+    {V8_2PART_UINT64_C(0xddf8e7d6, 0ed1219e),
+     V8_2PART_UINT64_C(0xec9c459d, 51852ba2)},
+    {V8_2PART_UINT64_C(0xcabb90e5, c942b503),
+     V8_2PART_UINT64_C(0x93e1ab82, 52f33b45)},
+    {V8_2PART_UINT64_C(0x3d6a751f, 3b936243),
+     V8_2PART_UINT64_C(0xb8da1662, e7b00a17)},
+    {V8_2PART_UINT64_C(0x0cc51267, 0a783ad4),
+     V8_2PART_UINT64_C(0xe7109bfb, a19c0c9d)},
+    {V8_2PART_UINT64_C(0x27fb2b80, 668b24c5),
+     V8_2PART_UINT64_C(0x906a617d, 450187e2)},
+    {V8_2PART_UINT64_C(0xb1f9f660, 802dedf6),
+     V8_2PART_UINT64_C(0xb484f9dc, 9641e9da)},
+    {V8_2PART_UINT64_C(0x5e7873f8, a0396973),
+     V8_2PART_UINT64_C(0xe1a63853, bbd26451)},
+    {V8_2PART_UINT64_C(0xdb0b487b, 6423e1e8),
+     V8_2PART_UINT64_C(0x8d07e334, 55637eb2)},  // 10^280
+    {V8_2PART_UINT64_C(0x91ce1a9a, 3d2cda62),
+     V8_2PART_UINT64_C(0xb049dc01, 6abc5e5f)},
+    {V8_2PART_UINT64_C(0x7641a140, cc7810fb),
+     V8_2PART_UINT64_C(0xdc5c5301, c56b75f7)},
+    {V8_2PART_UINT64_C(0xa9e904c8, 7fcb0a9d),
+     V8_2PART_UINT64_C(0x89b9b3e1, 1b6329ba)},
+    {V8_2PART_UINT64_C(0x546345fa, 9fbdcd44),
+     V8_2PART_UINT64_C(0xac2820d9, 623bf429)},
+    {V8_2PART_UINT64_C(0xa97c1779, 47ad4095),
+     V8_2PART_UINT64_C(0xd732290f, bacaf133)},
+    {V8_2PART_UINT64_C(0x49ed8eab, cccc485d),
+     V8_2PART_UINT64_C(0x867f59a9, d4bed6c0)},
+    {V8_2PART_UINT64_C(0x5c68f256, bfff5a74),
+     V8_2PART_UINT64_C(0xa81f3014, 49ee8c70)},
+    {V8_2PART_UINT64_C(0x73832eec, 6fff3111),
+     V8_2PART_UINT64_C(0xd226fc19, 5c6a2f8c)},
+    {V8_2PART_UINT64_C(0xc831fd53, c5ff7eab),
+     V8_2PART_UINT64_C(0x83585d8f, d9c25db7)},
+    {V8_2PART_UINT64_C(0xba3e7ca8, b77f5e55),
+     V8_2PART_UINT64_C(0xa42e74f3, d032f525)},  // 10^290
+    {V8_2PART_UINT64_C(0x28ce1bd2, e55f35eb),
+     V8_2PART_UINT64_C(0xcd3a1230, c43fb26f)},
+    {V8_2PART_UINT64_C(0x7980d163, cf5b81b3),
+     V8_2PART_UINT64_C(0x80444b5e, 7aa7cf85)},
+    {V8_2PART_UINT64_C(0xd7e105bc, c332621f),
+     V8_2PART_UINT64_C(0xa0555e36, 1951c366)},
+    {V8_2PART_UINT64_C(0x8dd9472b, f3fefaa7),
+     V8_2PART_UINT64_C(0xc86ab5c3, 9fa63440)},
+    {V8_2PART_UINT64_C(0xb14f98f6, f0feb951),
+     V8_2PART_UINT64_C(0xfa856334, 878fc150)},
+    {V8_2PART_UINT64_C(0x6ed1bf9a, 569f33d3),
+     V8_2PART_UINT64_C(0x9c935e00, d4b9d8d2)},
+    {V8_2PART_UINT64_C(0x0a862f80, ec4700c8),
+     V8_2PART_UINT64_C(0xc3b83581, 09e84f07)},
+    {V8_2PART_UINT64_C(0xcd27bb61, 2758c0fa),
+     V8_2PART_UINT64_C(0xf4a642e1, 4c6262c8)},
+    {V8_2PART_UINT64_C(0x8038d51c, b897789c),
+     V8_2PART_UINT64_C(0x98e7e9cc, cfbd7dbd)},
+    {V8_2PART_UINT64_C(0xe0470a63, e6bd56c3),
+     V8_2PART_UINT64_C(0xbf21e440, 03acdd2c)},  // 10^300
+    {V8_2PART_UINT64_C(0x1858ccfc, e06cac74),
+     V8_2PART_UINT64_C(0xeeea5d50, 04981478)},
+    {V8_2PART_UINT64_C(0x0f37801e, 0c43ebc8),
+     V8_2PART_UINT64_C(0x95527a52, 02df0ccb)},
+    {V8_2PART_UINT64_C(0xd3056025, 8f54e6ba),
+     V8_2PART_UINT64_C(0xbaa718e6, 8396cffd)},
+    {V8_2PART_UINT64_C(0x47c6b82e, f32a2069),
+     V8_2PART_UINT64_C(0xe950df20, 247c83fd)},
+    {V8_2PART_UINT64_C(0x4cdc331d, 57fa5441),
+     V8_2PART_UINT64_C(0x91d28b74, 16cdd27e)},
+    {V8_2PART_UINT64_C(0xe0133fe4, adf8e952),
+     V8_2PART_UINT64_C(0xb6472e51, 1c81471d)},
+    {V8_2PART_UINT64_C(0x58180fdd, d97723a6),
+     V8_2PART_UINT64_C(0xe3d8f9e5, 63a198e5)},
+    {V8_2PART_UINT64_C(0x570f09ea, a7ea7648),
+     V8_2PART_UINT64_C(0x8e679c2f, 5e44ff8f)},
+};
+// clang-format on
+STATIC_ASSERT(arraysize(kPowersOfTen128) ==
+              kMaxPowerOfTen128Exponent - kMinPowerOfTen128Exponent + 1);
+
 // Maximum number of significant digits in the decimal representation.
 // In fact the value is 772 (see conversions.cc), but to give us some margin
 // we round up to 780.
@@ -209,6 +1528,97 @@ static bool DoubleStrtod(Vector<const char> trimmed,
 }
 
 
+// Computes significand * 10^exponent with the algorithm by Michael Eisel and
+// Daniel Lemire ("Number Parsing at a Gigabyte per Second", 2021): the
+// normalized significand is multiplied with a truncated 128-bit approximation
+// of 10^exponent. Since the approximation is truncated, the upper 128 bits of
+// the exact product exceed the computed ones by less than the significand.
+// That only matters if the bits below the 54 most significant ones are all
+// set, in which case the lower half of the approximation is used as well.
+// Returns false if the truncation could still change the result, if the
+// exact product could be half-way between two doubles, or if the result is
+// not a normal double. In that case the caller has to fall back to a slower
+// algorithm.
+static bool EiselLemire(uint64_t significand, int exponent, double* result) {
+  DCHECK_NE(0, significand);
+  if (exponent < kMinPowerOfTen128Exponent ||
+      exponent > kMaxPowerOfTen128Exponent) {
+    return false;
+  }
+  const uint64_t* power =
+      kPowersOfTen128[exponent - kMinPowerOfTen128Exponent];
+
+  int leading_zeros = base::bits::CountLeadingZeros64(significand);
+  significand <<= leading_zeros;
+  // 217706 / 2^16 approximates log2(10) closely enough to compute
+  // floor(log2(10^exponent)) for all exponents in the table.
+  int biased_exponent = ((217706 * exponent) >> 16) + 64 +
+                        kDoubleExponentBias - leading_zeros;
+
+  uint64_t high;
+  uint64_t low = base::bits::UnsignedMul128(significand, power[1], &high);
+  if ((high & 0x1FF) == 0x1FF && low + significand < significand) {
+    // Adding the missing part of the product could carry into the 54 bits
+    // we are interested in. Take the lower half of the power into account.
+    uint64_t lower_high;
+    uint64_t lower_low =
+        base::bits::UnsignedMul128(significand, power[0], &lower_high);
+    uint64_t merged_high = high;
+    uint64_t merged_low = low + lower_high;
+    if (merged_low < low) merged_high++;
+    if ((merged_high & 0x1FF) == 0x1FF && merged_low + 1 == 0 &&
+        lower_low + significand < significand) {
+      return false;
+    }
+    high = merged_high;
+    low = merged_low;
+  }
+
+  // Keep the 54 most significant bits: one more than a double has, so that
+  // we can round.
+  int top_bit = static_cast<int>(high >> 63);
+  uint64_t mantissa = high >> (top_bit + 9);
+  biased_exponent -= 1 ^ top_bit;
+
+  // If all the dropped bits are zero and the rounding bit is set, the exact
+  // value could be half-way between two doubles. Rounding to even would need
+  // the exact product, so give up.
+  if (low == 0 && (high & 0x1FF) == 0 && (mantissa & 3) == 1) return false;
+
+  mantissa += mantissa & 1;
+  mantissa >>= 1;
+  if ((mantissa >> Double::kSignificandSize) != 0) {
+    // Rounding overflowed into the next binade.
+    mantissa >>= 1;
+    biased_exponent++;
+  }
+  // Denormals and infinity are left to the slow path.
+  if (biased_exponent <= 0 || biased_exponent >= 0x7FF) return false;
+  *result = Double(DiyFp(mantissa, biased_exponent - kDoubleExponentBias -
+                                       Double::kPhysicalSignificandSize))
+                .value();
+  return true;
+}
+
+
+// Reads the first digits of the buffer into a uint64 and uses EiselLemire to
+// compute the double. If digits had to be dropped the exact value lies
+// strictly between the significand and the significand + 1 (the buffer does
+// not end with '0'), and the result is only accurate if both bounds convert
+// to the same double.
+static bool EiselLemireStrtod(Vector<const char> trimmed, int exponent,
+                              double* result) {
+  int read_digits;
+  uint64_t significand = ReadUint64(trimmed, &read_digits);
+  int remaining_digits = trimmed.length() - read_digits;
+  exponent += remaining_digits;
+  if (!EiselLemire(significand, exponent, result)) return false;
+  if (remaining_digits == 0) return true;
+  double upper;
+  return EiselLemire(significand + 1, exponent, &upper) && upper == *result;
+}
+
+
 // Returns 10^exponent as an exact DiyFp.
 // The given exponent must be in the range [1; kDecimalExponentDistance[.
 static DiyFp AdjustmentPowerOfTen(int exponent) {
@@ -422,6 +1832,7 @@ double Strtod(Vector<const char> buffer, int exponent) {
 
   double guess;
   if (DoubleStrtod(trimmed, exponent, &guess) ||
+      EiselLemireStrtod(trimmed, exponent, &guess) ||
       DiyFpStrtod(trimmed, exponent, &guess)) {
     return guess;
   }
@@ -25,6 +25,7 @@ class Object;
   V(kDebug, "(Debugger)")                              \
   V(kCompilationCache, "(Compilation cache)")          \
   V(kHandleScope, "(Handle scope)")                    \
+  V(kMicroTasks, "(Micro tasks)")                      \
   V(kDispatchTable, "(Dispatch table)")                \
   V(kBuiltins, "(Builtins)")                           \
   V(kGlobalHandles, "(Global handles)")                \
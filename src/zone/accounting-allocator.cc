@@ -11,19 +11,41 @@
 #endif
 
 #include "src/allocation.h"
+#include "src/base/atomicops.h"
+#include "src/base/bits.h"
+#include "src/base/lazy-instance.h"
+#include "src/base/platform/platform.h"
 
 namespace v8 {
 namespace internal {
 
-AccountingAllocator::AccountingAllocator() : unused_segments_mutex_() {
-  static const size_t kDefaultBucketMaxSize = 5;
+namespace {
 
+struct ShardKeyConstructTrait final {
+  static void Construct(void* key_arg) {
+    auto key = reinterpret_cast<base::Thread::LocalStorageKey*>(key_arg);
+    *key = base::Thread::CreateThreadLocalKey();
+  }
+};
+
+// Holds one more than the shard of the current thread, or 0 if the thread
+// has not picked one yet.
+typedef base::LazyStaticInstance<base::Thread::LocalStorageKey,
+                                 ShardKeyConstructTrait>::type ShardKey;
+
+ShardKey shard_key = LAZY_STATIC_INSTANCE_INITIALIZER;
+
+base::Atomic32 next_shard = 0;
+
+}  // namespace
+
+AccountingAllocator::AccountingAllocator() {
   memory_pressure_level_.SetValue(MemoryPressureLevel::kNone);
-  std::fill(unused_segments_heads_, unused_segments_heads_ + kNumberBuckets,
-            nullptr);
+  for (SegmentPoolShard& shard : shards_) {
+    std::fill(shard.heads, shard.heads + kNumberBuckets, nullptr);
+  }
   std::fill(unused_segments_sizes_, unused_segments_sizes_ + kNumberBuckets, 0);
-  std::fill(unused_segments_max_sizes_,
-            unused_segments_max_sizes_ + kNumberBuckets, kDefaultBucketMaxSize);
+  ConfigureSegmentPool(kMaxPoolSize);
 }
 
 AccountingAllocator::~AccountingAllocator() { ClearPool(); }
@@ -43,8 +65,6 @@ void AccountingAllocator::ConfigureSegmentPool(const size_t max_pool_size) {
                                   (size_t(1) << kMinSegmentSizePower);
   size_t fits_fully = max_pool_size / full_size;
 
-  base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
-
   // We assume few zones (less than 'fits_fully' many) to be active at the same
   // time. When zones grow regularly, they will keep requesting segments of
   // increasing size each time. Therefore we try to get as many segments with an
@@ -61,13 +81,14 @@ void AccountingAllocator::ConfigureSegmentPool(const size_t max_pool_size) {
   size_t total_size = fits_fully * full_size;
 
   for (size_t power = 0; power < kNumberBuckets; ++power) {
-    if (total_size + (size_t(1) << (power + kMinSegmentSizePower)) <=
-        max_pool_size) {
-      unused_segments_max_sizes_[power] = fits_fully + 1;
-      total_size += size_t(1) << power;
-    } else {
-      unused_segments_max_sizes_[power] = fits_fully;
+    size_t segment_size = size_t(1) << (power + kMinSegmentSizePower);
+    size_t max_size = fits_fully;
+    if (total_size + segment_size <= max_pool_size) {
+      max_size++;
+      total_size += segment_size;
     }
+    base::Relaxed_Store(&unused_segments_max_sizes_[power],
+                        static_cast<base::AtomicWord>(max_size));
   }
 }
 
@@ -125,8 +146,36 @@ size_t AccountingAllocator::GetCurrentPoolSize() const {
   return base::Relaxed_Load(&current_pool_size_);
 }
 
+// static
+size_t AccountingAllocator::CurrentShard() {
+  // Looking up the thread id is a system call on some platforms, so every
+  // thread picks its shard once. Handing out the shards in turn spreads the
+  // threads evenly.
+  base::Thread::LocalStorageKey key = shard_key.Get();
+  int shard_plus_one = base::Thread::GetThreadLocalInt(key);
+  if (shard_plus_one == 0) {
+    shard_plus_one = static_cast<int>(
+        static_cast<uint32_t>(base::Relaxed_AtomicIncrement(&next_shard, 1)) %
+            kNumberShards +
+        1);
+    base::Thread::SetThreadLocalInt(key, shard_plus_one);
+  }
+  return static_cast<size_t>(shard_plus_one - 1);
+}
+
+Segment* AccountingAllocator::TakeSegmentFromShard(size_t shard,
+                                                   size_t bucket) {
+  base::LockGuard<base::Mutex> lock_guard(&shards_[shard].mutex);
+  Segment* segment = shards_[shard].heads[bucket];
+  if (segment != nullptr) {
+    shards_[shard].heads[bucket] = segment->next();
+    segment->set_next(nullptr);
+  }
+  return segment;
+}
+
 Segment* AccountingAllocator::GetSegmentFromPool(size_t requested_size) {
-  if (requested_size > (1 << kMaxSegmentSizePower)) {
+  if (requested_size > (size_t(1) << kMaxSegmentSizePower)) {
     return nullptr;
   }
 
@@ -136,24 +185,21 @@ Segment* AccountingAllocator::GetSegmentFromPool(size_t requested_size) {
   DCHECK_GE(power, kMinSegmentSizePower + 0);
   power -= kMinSegmentSizePower;
 
-  Segment* segment;
-  {
-    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
-
-    segment = unused_segments_heads_[power];
-
-    if (segment != nullptr) {
-      unused_segments_heads_[power] = segment->next();
-      segment->set_next(nullptr);
+  if (base::Relaxed_Load(&unused_segments_sizes_[power]) == 0) return nullptr;
 
-      unused_segments_sizes_[power]--;
-      base::Relaxed_AtomicIncrement(
-          &current_pool_size_, -static_cast<base::AtomicWord>(segment->size()));
-    }
+  // Prefer the shard of the current thread, but take a segment from any other
+  // shard before falling back to malloc.
+  size_t first_shard = CurrentShard();
+  Segment* segment = nullptr;
+  for (size_t i = 0; i < kNumberShards && segment == nullptr; i++) {
+    segment = TakeSegmentFromShard((first_shard + i) % kNumberShards, power);
   }
 
   if (segment) {
     DCHECK_GE(segment->size(), requested_size);
+    base::Relaxed_AtomicIncrement(&unused_segments_sizes_[power], -1);
+    base::Relaxed_AtomicIncrement(
+        &current_pool_size_, -static_cast<base::AtomicWord>(segment->size()));
   }
   return segment;
 }
@@ -161,9 +207,13 @@ Segment* AccountingAllocator::GetSegmentFromPool(size_t requested_size) {
 bool AccountingAllocator::AddSegmentToPool(Segment* segment) {
   size_t size = segment->size();
 
-  if (size >= (1 << (kMaxSegmentSizePower + 1))) return false;
+  if (size > (size_t(1) << kMaxSegmentSizePower)) return false;
 
-  if (size < (1 << kMinSegmentSizePower)) return false;
+  if (size < (size_t(1) << kMinSegmentSizePower)) return false;
+
+  // Segments of other sizes would occupy a size class without being able to
+  // serve every request of that class.
+  if (!base::bits::IsPowerOfTwo(size)) return false;
 
   size_t power = kMaxSegmentSizePower;
 
@@ -172,34 +222,48 @@ bool AccountingAllocator::AddSegmentToPool(Segment* segment) {
   DCHECK_GE(power, kMinSegmentSizePower + 0);
   power -= kMinSegmentSizePower;
 
-  {
-    base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
-
-    if (unused_segments_sizes_[power] >= unused_segments_max_sizes_[power]) {
+  // Reserve a slot in the size class before publishing the segment, so the
+  // pool never exceeds its limits no matter which shard the segment goes to.
+  base::AtomicWord current = base::Relaxed_Load(&unused_segments_sizes_[power]);
+  while (true) {
+    if (current >= base::Relaxed_Load(&unused_segments_max_sizes_[power])) {
       return false;
     }
+    base::AtomicWord previous = base::Relaxed_CompareAndSwap(
+        &unused_segments_sizes_[power], current, current + 1);
+    if (previous == current) break;
+    current = previous;
+  }
+
+  {
+    SegmentPoolShard& shard = shards_[CurrentShard()];
+    base::LockGuard<base::Mutex> lock_guard(&shard.mutex);
 
-    segment->set_next(unused_segments_heads_[power]);
-    unused_segments_heads_[power] = segment;
+    segment->set_next(shard.heads[power]);
+    shard.heads[power] = segment;
     base::Relaxed_AtomicIncrement(&current_pool_size_, size);
-    unused_segments_sizes_[power]++;
   }
 
   return true;
 }
 
 void AccountingAllocator::ClearPool() {
-  base::LockGuard<base::Mutex> lock_guard(&unused_segments_mutex_);
-
-  for (size_t power = 0; power <= kMaxSegmentSizePower - kMinSegmentSizePower;
-       power++) {
-    Segment* current = unused_segments_heads_[power];
-    while (current) {
-      Segment* next = current->next();
-      FreeSegment(current);
-      current = next;
+  for (SegmentPoolShard& shard : shards_) {
+    base::LockGuard<base::Mutex> lock_guard(&shard.mutex);
+
+    for (size_t power = 0; power < kNumberBuckets; power++) {
+      Segment* current = shard.heads[power];
+      while (current) {
+        Segment* next = current->next();
+        base::Relaxed_AtomicIncrement(&unused_segments_sizes_[power], -1);
+        base::Relaxed_AtomicIncrement(
+            &current_pool_size_,
+            -static_cast<base::AtomicWord>(current->size()));
+        FreeSegment(current);
+        current = next;
+      }
+      shard.heads[power] = nullptr;
     }
-    unused_segments_heads_[power] = nullptr;
   }
 }
 
@@ -21,7 +21,7 @@ namespace internal {
 
 class V8_EXPORT_PRIVATE AccountingAllocator {
  public:
-  static const size_t kMaxPoolSize = 8ul * KB;
+  static const size_t kMaxPoolSize = 4ul * MB;
 
   AccountingAllocator();
   virtual ~AccountingAllocator();
@@ -39,9 +39,8 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
 
   void MemoryPressureNotification(MemoryPressureLevel level);
   // Configures the zone segment pool size limits so the pool does not
-  // grow bigger than max_pool_size.
-  // TODO(heimbuef): Do not accept segments to pool that are larger than
-  // their size class requires. Sometimes the zones generate weird segments.
+  // grow bigger than max_pool_size. The limits apply to the pool as a whole,
+  // independent of the shard a segment is kept in.
   void ConfigureSegmentPool(const size_t max_pool_size);
 
   virtual void ZoneCreation(const Zone* zone) {}
@@ -49,15 +48,28 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
 
  private:
   FRIEND_TEST(Zone, SegmentPoolConstraints);
+  FRIEND_TEST(Zone, SegmentPoolSharding);
 
+  // Size classes cover Zone::kMinimumSegmentSize to Zone::kMaximumSegmentSize.
+  // Only segments whose size is exactly a power of two are pooled.
   static const size_t kMinSegmentSizePower = 13;
-  static const size_t kMaxSegmentSizePower = 18;
+  static const size_t kMaxSegmentSizePower = 20;
 
   STATIC_ASSERT(kMinSegmentSizePower <= kMaxSegmentSizePower);
 
   static const size_t kNumberBuckets =
       1 + kMaxSegmentSizePower - kMinSegmentSizePower;
 
+  // The pool is split into shards to reduce lock contention between threads
+  // that compile concurrently. A thread returns segments to, and first looks
+  // for segments in, the shard it picked when it first used the pool.
+  static const size_t kNumberShards = 8;
+
+  struct SegmentPoolShard {
+    base::Mutex mutex;
+    Segment* heads[kNumberBuckets];
+  };
+
   // Allocates a new segment. Returns nullptr on failed allocation.
   Segment* AllocateSegment(size_t bytes);
   void FreeSegment(Segment* memory);
@@ -67,15 +79,19 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
   // Trys to add a segment to the pool. Returns false if the pool is full.
   bool AddSegmentToPool(Segment* segment);
 
-  // Empties the pool and puts all its contents onto the garbage stack.
+  // Empties the pool and frees all its contents.
   void ClearPool();
 
-  Segment* unused_segments_heads_[kNumberBuckets];
+  static size_t CurrentShard();
+  Segment* TakeSegmentFromShard(size_t shard, size_t bucket);
 
-  size_t unused_segments_sizes_[kNumberBuckets];
-  size_t unused_segments_max_sizes_[kNumberBuckets];
+  SegmentPoolShard shards_[kNumberShards];
 
-  base::Mutex unused_segments_mutex_;
+  // Number of pooled segments and the limit per size class, summed over all
+  // shards. A slot is reserved in unused_segments_sizes_ before a segment is
+  // pushed to a shard and released after it was taken off again.
+  base::AtomicWord unused_segments_sizes_[kNumberBuckets];
+  base::AtomicWord unused_segments_max_sizes_[kNumberBuckets];
 
   base::AtomicWord current_memory_usage_ = 0;
   base::AtomicWord max_memory_usage_ = 0;
@@ -7,6 +7,7 @@
 #include <cstring>
 
 #include "src/asan.h"
+#include "src/base/bits.h"
 #include "src/utils.h"
 #include "src/v8.h"
 
@@ -120,18 +121,22 @@ Address Zone::NewExpand(size_t size) {
   // Compute the new segment size. We use a 'high water mark'
   // strategy, where we increase the segment size every time we expand
   // except that we employ a maximum segment size when we delete. This
-  // is to avoid excessive malloc() and free() overhead.
+  // is to avoid excessive malloc() and free() overhead. Segment sizes
+  // are powers of two up to the maximum segment size, so that segments
+  // returned to the allocator's pool can be reused by any other zone.
   Segment* head = segment_head_;
   const size_t old_size = (head == nullptr) ? 0 : head->size();
   static const size_t kSegmentOverhead = sizeof(Segment) + kAlignmentInBytes;
-  const size_t new_size_no_overhead = size + (old_size << 1);
-  size_t new_size = kSegmentOverhead + new_size_no_overhead;
   const size_t min_new_size = kSegmentOverhead + size;
   // Guard against integer overflow.
-  if (new_size_no_overhead < size || new_size < kSegmentOverhead) {
+  if (min_new_size < size) {
     V8::FatalProcessOutOfMemory(nullptr, "Zone");
     return kNullAddress;
   }
+  size_t new_size = Max(old_size << 1, min_new_size);
+  if (new_size <= kMaximumSegmentSize) {
+    new_size = base::bits::RoundUpToPowerOfTwo64(new_size);
+  }
   if (segment_size_ == SegmentSize::kLarge) {
     new_size = kMaximumSegmentSize;
   }
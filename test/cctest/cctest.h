@@ -503,6 +503,15 @@ static inline void ExpectInt32(const char* code, int expected) {
 }
 
 
+static inline void ExpectNumber(const char* code, double expected) {
+  v8::Local<v8::Value> result = CompileRun(code);
+  CHECK(result->IsNumber());
+  CHECK_EQ(expected,
+           result->NumberValue(v8::Isolate::GetCurrent()->GetCurrentContext())
+               .FromJust());
+}
+
+
 static inline void ExpectBoolean(const char* code, bool expected) {
   v8::Local<v8::Value> result = CompileRun(code);
   CHECK(result->IsBoolean());
@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "src/api-inl.h"
 #include "src/heap/factory.h"
+#include "src/heap/heap-inl.h"
 #include "src/isolate.h"
 #include "src/objects-inl.h"
 #include "test/cctest/compiler/function-tester.h"
@@ -52,6 +54,43 @@ TEST(ArgumentsRest) {
   CHECK_EQ(3, length->Number());
 }
 
+TEST(EscapeAnalysisArrayLiteralVariableIndex) {
+  FLAG_allow_natives_syntax = true;
+  FLAG_turbo_escape = true;
+  if (!FLAG_opt || FLAG_stress_incremental_marking) return;
+  CcTest::InitializeVM();
+  v8::HandleScope scope(CcTest::isolate());
+  Heap* heap = CcTest::heap();
+
+  // The array literal is scalar replaced even though it is indexed by a
+  // non-constant key, so the optimized {foo} does not allocate it.
+  CompileRun(
+      "function foo(i) {"
+      "  const a = [i + 1, i + 2];"
+      "  return a[i & 1];"
+      "}"
+      "function run(n) {"
+      "  var sum = 0;"
+      "  for (var i = 0; i < n; ++i) sum += foo(i);"
+      "  return sum;"
+      "}"
+      "%NeverOptimizeFunction(run);"
+      "foo(0);"
+      "foo(1);"
+      "%OptimizeFunctionOnNextCall(foo);"
+      "run(2);");
+  Handle<JSFunction> foo =
+      Handle<JSFunction>::cast(v8::Utils::OpenHandle(*CompileRun("foo")));
+  CHECK(foo->IsOptimized());
+
+  const int kCalls = 1000;
+  size_t before = heap->NewSpaceAllocationCounter();
+  CompileRun("run(1000)");
+  size_t allocated = heap->NewSpaceAllocationCounter() - before;
+  CHECK_LT(allocated, static_cast<size_t>(kCalls * JSArray::kSize));
+  CHECK(foo->IsOptimized());
+}
+
 }  // namespace compiler
 }  // namespace internal
 }  // namespace v8
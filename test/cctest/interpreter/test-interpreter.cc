@@ -2,7 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <sstream>
 #include <tuple>
+#include <unordered_set>
 
 #include "src/v8.h"
 
@@ -5046,6 +5048,60 @@ TEST(InterpreterWithNativeStack) {
            interpreter_entry_trampoline->InstructionStart());
 }
 
+TEST(InterpreterWithNativeStackSharesTrampolines) {
+  i::FLAG_interpreted_frames_native_stack = true;
+
+  HandleAndZoneScope handles;
+  i::Isolate* isolate = handles.main_isolate();
+  v8::Isolate* v8_isolate = reinterpret_cast<v8::Isolate*>(isolate);
+
+  // Load the same functions in several contexts, like an embedder that runs
+  // a script in many frames. The scripts differ, so each context compiles
+  // its own functions.
+  const int kFunctions = 50;
+  const int kContexts = 4;
+  std::vector<v8::Local<v8::Context>> contexts;
+  std::vector<Handle<Code>> trampolines;
+  for (int c = 0; c < kContexts; c++) {
+    std::ostringstream source;
+    for (int f = 0; f < kFunctions; f++) {
+      source << "function testSharesTrampoline" << f << "() { return " << f
+             << "; }\n";
+    }
+    for (int f = 0; f < kFunctions; f++) {
+      source << "testSharesTrampoline" << f << "();\n";
+    }
+    source << "// Context " << c << "\n";
+
+    contexts.push_back(v8::Context::New(v8_isolate));
+    v8::Context::Scope context_scope(contexts.back());
+    CompileRun(source.str().c_str());
+    for (int f = 0; f < kFunctions; f++) {
+      std::string name = "testSharesTrampoline" + std::to_string(f);
+      Handle<JSFunction> function = Handle<JSFunction>::cast(
+          v8::Utils::OpenHandle(*CompileRun(name.c_str())));
+      trampolines.push_back(handle(function->shared()->GetCode(), isolate));
+    }
+  }
+
+  // Functions with the same name share their trampoline copy.
+  DisallowHeapAllocation no_gc;
+  std::unordered_set<Code*> copies;
+  int copies_size = 0;
+  for (size_t i = 0; i < trampolines.size(); i++) {
+    Code* code = *trampolines[i];
+    CHECK(code->is_interpreter_trampoline_builtin());
+    CHECK_EQ(code, *trampolines[i % kFunctions]);
+    if (copies.insert(code).second) copies_size += code->Size();
+  }
+  CHECK_EQ(static_cast<size_t>(kFunctions), copies.size());
+
+  Code* interpreter_entry_trampoline =
+      isolate->builtins()->builtin(Builtins::kInterpreterEntryTrampoline);
+  CHECK_EQ(0u, copies.count(interpreter_entry_trampoline));
+  CHECK_EQ(kFunctions * interpreter_entry_trampoline->Size(), copies_size);
+}
+
 }  // namespace interpreter
 }  // namespace internal
 }  // namespace v8
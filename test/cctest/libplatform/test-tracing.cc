@@ -2,9 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 #include <limits>
+#include <map>
 
 #include "include/libplatform/v8-tracing.h"
+#include "src/base/platform/semaphore.h"
 #include "src/libplatform/default-platform.h"
+#include "src/libplatform/tracing/trace-writer.h"
 #include "src/tracing/trace-event.h"
 #include "test/cctest/cctest.h"
 
@@ -128,6 +131,250 @@ TEST(TestTraceBufferRingBuffer) {
   delete ring_buffer;
 }
 
+TEST(TestThreadLocalTraceBuffer) {
+  // Chunks are not overwritten, so all events stay retrievable until they
+  // are written.
+  const int HANDLES_COUNT = TraceBufferChunk::kChunkSize * 2 + 1;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(4, writer);
+  std::string names[HANDLES_COUNT];
+  for (int i = 0; i < HANDLES_COUNT; ++i) {
+    names[i] = "Test.EventNo" + std::to_string(i);
+  }
+
+  std::vector<uint64_t> handles(HANDLES_COUNT);
+  uint8_t category_enabled_flag = 41;
+  for (size_t i = 0; i < handles.size(); ++i) {
+    TraceObject* trace_object = buffer->AddTraceEvent(&handles[i]);
+    CHECK_NOT_NULL(trace_object);
+    trace_object->Initialize('X', &category_enabled_flag, names[i].c_str(),
+                             "Test.Scope", 42, 123, 0, nullptr, nullptr,
+                             nullptr, nullptr, 0, 1729, 4104);
+  }
+  for (size_t i = 0; i < handles.size(); ++i) {
+    TraceObject* trace_object = buffer->GetEventByHandle(handles[i]);
+    CHECK_NOT_NULL(trace_object);
+    CHECK_EQ(names[i], std::string(trace_object->name()));
+  }
+
+  // Flush() writes all events, including those in the chunk this thread
+  // still owns, and releases the full chunks.
+  buffer->Flush();
+  auto events = writer->events();
+  CHECK_EQ(handles.size(), events.size());
+  for (size_t i = 0; i < handles.size(); ++i) {
+    CHECK_EQ(names[i], events[i]);
+  }
+  for (size_t i = 0; i < 2 * TraceBufferChunk::kChunkSize; ++i) {
+    CHECK_NULL(buffer->GetEventByHandle(handles[i]));
+  }
+  CHECK_NOT_NULL(buffer->GetEventByHandle(handles.back()));
+
+  // Events of the owned chunk are not written twice.
+  buffer->Flush();
+  CHECK_EQ(handles.size(), writer->events().size());
+  delete buffer;
+}
+
+namespace {
+
+class IdRecordingTraceWriter : public TraceWriter {
+ public:
+  void AppendTraceEvent(TraceObject* trace_event) override {
+    events_.push_back(std::make_pair(trace_event->name(), trace_event->id()));
+  }
+
+  void Flush() override {}
+
+  const std::vector<std::pair<std::string, uint64_t>>& events() {
+    return events_;
+  }
+
+ private:
+  std::vector<std::pair<std::string, uint64_t>> events_;
+};
+
+class TraceEventThread : public v8::base::Thread {
+ public:
+  TraceEventThread(TraceBuffer* buffer, const char* name, int count)
+      : v8::base::Thread(Options(name)),
+        buffer_(buffer),
+        name_(name),
+        count_(count) {}
+
+  void Run() override {
+    uint8_t category_enabled_flag = 41;
+    for (int i = 0; i < count_; ++i) {
+      uint64_t handle;
+      TraceObject* trace_object = buffer_->AddTraceEvent(&handle);
+      if (!trace_object) {
+        ++dropped_;
+        continue;
+      }
+      trace_object->Initialize('X', &category_enabled_flag, name_, nullptr, i,
+                               0, 0, nullptr, nullptr, nullptr, nullptr, 0,
+                               1729, 4104);
+      buffer_->CompleteTraceEvent(handle);
+      CHECK_EQ(trace_object, buffer_->GetEventByHandle(handle));
+    }
+  }
+
+  int dropped() const { return dropped_; }
+
+ private:
+  TraceBuffer* buffer_;
+  const char* name_;
+  int count_;
+  int dropped_ = 0;
+};
+
+// Adds events, then pins the first one and waits until it is told to make
+// another call into the buffer and exit. Unless {complete} is false, every
+// event is completed once it is initialized.
+class PinningTraceEventThread : public v8::base::Thread {
+ public:
+  PinningTraceEventThread(TraceBuffer* buffer, size_t count,
+                          bool complete = true)
+      : v8::base::Thread(Options("PinningTraceEventThread")),
+        buffer_(buffer),
+        handles_(count),
+        complete_(complete),
+        added_(0),
+        resume_(0) {}
+
+  void Run() override {
+    uint8_t category_enabled_flag = 41;
+    for (size_t i = 0; i < handles_.size(); ++i) {
+      TraceObject* trace_object = buffer_->AddTraceEvent(&handles_[i]);
+      CHECK_NOT_NULL(trace_object);
+      trace_object->Initialize('X', &category_enabled_flag, "Pinned", nullptr,
+                               i, 0, 0, nullptr, nullptr, nullptr, nullptr,
+                               0, 1729, 4104);
+      if (complete_) buffer_->CompleteTraceEvent(handles_[i]);
+    }
+    CHECK_NOT_NULL(buffer_->GetEventByHandle(handles_[0]));
+    added_.Signal();
+    resume_.Wait();
+    buffer_->GetEventByHandle(handles_.back());
+  }
+
+  const std::vector<uint64_t>& handles() const { return handles_; }
+  void WaitUntilAdded() { added_.Wait(); }
+  void Resume() { resume_.Signal(); }
+
+ private:
+  TraceBuffer* buffer_;
+  std::vector<uint64_t> handles_;
+  bool complete_;
+  v8::base::Semaphore added_;
+  v8::base::Semaphore resume_;
+};
+
+}  // namespace
+
+TEST(TestThreadLocalTraceBufferLiveThread) {
+  // The completed events of a thread that keeps running are all written,
+  // including the last one.
+  const size_t kEvents = 3;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(4, writer);
+  PinningTraceEventThread thread(buffer, kEvents);
+  thread.Start();
+  thread.WaitUntilAdded();
+  buffer->Flush();
+  CHECK_EQ(kEvents, writer->events().size());
+
+  // They are not written again once the thread has exited.
+  thread.Resume();
+  thread.Join();
+  buffer->Flush();
+  CHECK_EQ(kEvents, writer->events().size());
+  delete buffer;
+}
+
+TEST(TestThreadLocalTraceBufferThreadExit) {
+  // A single chunk, which the thread owns until it exits.
+  const size_t kEvents = 3;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(1, writer);
+  PinningTraceEventThread thread(buffer, kEvents, false);
+  thread.Start();
+  thread.WaitUntilAdded();
+
+  // The last event of the other thread is not complete, so it may not be
+  // initialized yet.
+  buffer->Flush();
+  CHECK_EQ(kEvents - 1, writer->events().size());
+
+  // The chunk is published when the thread exits, and is free again once it
+  // has been written.
+  thread.Resume();
+  thread.Join();
+  buffer->Flush();
+  CHECK_EQ(kEvents, writer->events().size());
+  CHECK_NULL(buffer->GetEventByHandle(thread.handles()[0]));
+  uint64_t handle;
+  CHECK_NOT_NULL(buffer->AddTraceEvent(&handle));
+  delete buffer;
+}
+
+TEST(TestThreadLocalTraceBufferPinning) {
+  // A full chunk and one event in the next, in a buffer large enough that
+  // the background thread does not write chunks.
+  const size_t kEvents = TraceBufferChunk::kChunkSize + 1;
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(8, writer);
+  PinningTraceEventThread thread(buffer, kEvents);
+  thread.Start();
+  thread.WaitUntilAdded();
+  const std::vector<uint64_t>& handles = thread.handles();
+
+  // The full chunk is written, but not reused while the thread pins it.
+  buffer->Flush();
+  CHECK_EQ(kEvents, writer->events().size());
+  CHECK_NOT_NULL(buffer->GetEventByHandle(handles[0]));
+
+  // Once neither thread pins the chunk, the next flush frees it.
+  thread.Resume();
+  thread.Join();
+  CHECK_NOT_NULL(buffer->GetEventByHandle(handles.back()));
+  buffer->Flush();
+  CHECK_EQ(kEvents, writer->events().size());
+  CHECK_NULL(buffer->GetEventByHandle(handles[0]));
+  delete buffer;
+}
+
+TEST(TestThreadLocalTraceBufferThreads) {
+  // Enough events to fill the buffer several times over, so that the
+  // background thread has to write chunks while the threads add events.
+  const int kThreads = 4;
+  const int kEventsPerThread = 20 * TraceBufferChunk::kChunkSize;
+  const char* names[kThreads] = {"Thread0", "Thread1", "Thread2", "Thread3"};
+  IdRecordingTraceWriter* writer = new IdRecordingTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(16, writer);
+  std::vector<std::unique_ptr<TraceEventThread>> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back(
+        new TraceEventThread(buffer, names[i], kEventsPerThread));
+  }
+  for (auto& thread : threads) thread->Start();
+  for (auto& thread : threads) thread->Join();
+  buffer->Flush();
+
+  // Every event that was not dropped is written exactly once, and the events
+  // of each thread are written in the order they were added.
+  size_t dropped = 0;
+  for (auto& thread : threads) dropped += thread->dropped();
+  CHECK_EQ(kThreads * kEventsPerThread - dropped, writer->events().size());
+  std::map<std::string, int64_t> last_id;
+  for (auto& event : writer->events()) {
+    auto it = last_id.insert(std::make_pair(event.first, -1)).first;
+    CHECK_LT(it->second, static_cast<int64_t>(event.second));
+    it->second = static_cast<int64_t>(event.second);
+  }
+  delete buffer;
+}
+
 void PopulateJSONWriter(TraceWriter* writer) {
   v8::Platform* old_platform = i::V8::GetCurrentPlatform();
   std::unique_ptr<v8::Platform> default_platform(
@@ -190,6 +437,249 @@ TEST(TestJSONTraceWriterWithCustomtag) {
   CHECK_EQ(expected_trace_str, trace_str);
 }
 
+namespace {
+
+// Decodes the output of BinaryTraceWriter.
+class BinaryTraceReader {
+ public:
+  struct Arg {
+    std::string name;
+    uint8_t type;
+    uint64_t uint_value;
+    int64_t int_value;
+    double double_value;
+    std::string string_value;
+  };
+
+  struct Event {
+    char phase;
+    std::string category;
+    std::string name;
+    int64_t pid;
+    int64_t tid;
+    int64_t ts;
+    int64_t tts;
+    uint64_t duration;
+    uint64_t cpu_duration;
+    uint64_t flags;
+    std::string scope;
+    uint64_t id;
+    std::vector<Arg> args;
+  };
+
+  explicit BinaryTraceReader(const std::string& data) : data_(data) {
+    CHECK_EQ(0, data_.compare(0, sizeof(BinaryTraceWriter::kMagic),
+                              BinaryTraceWriter::kMagic,
+                              sizeof(BinaryTraceWriter::kMagic)));
+    pos_ = sizeof(BinaryTraceWriter::kMagic);
+    CHECK_EQ(static_cast<int>(BinaryTraceWriter::kVersion), ReadByte());
+    while (pos_ < data_.size()) {
+      uint8_t tag = ReadByte();
+      if (tag == BinaryTraceWriter::kString) {
+        uint64_t id = ReadVarint();
+        CHECK_EQ(strings_.size() + 1, id);
+        strings_.push_back(ReadString());
+      } else {
+        CHECK_EQ(BinaryTraceWriter::kEvent, tag);
+        events_.push_back(ReadEvent());
+      }
+    }
+  }
+
+  const std::vector<Event>& events() const { return events_; }
+  const std::vector<std::string>& strings() const { return strings_; }
+
+ private:
+  Event ReadEvent() {
+    Event event;
+    event.phase = static_cast<char>(ReadByte());
+    event.category = LookupString(ReadVarint());
+    event.name = LookupString(ReadVarint());
+    event.pid = ReadSignedVarint();
+    event.tid = ReadSignedVarint();
+    event.ts = ReadSignedVarint();
+    event.tts = ReadSignedVarint();
+    event.duration = ReadVarint();
+    event.cpu_duration = ReadVarint();
+    event.flags = ReadVarint();
+    event.id = 0;
+    if (event.flags & TRACE_EVENT_FLAG_HAS_ID) {
+      event.scope = LookupString(ReadVarint());
+      event.id = ReadVarint();
+    }
+    uint64_t num_args = ReadVarint();
+    for (uint64_t i = 0; i < num_args; ++i) {
+      Arg arg = {};
+      arg.name = LookupString(ReadVarint());
+      arg.type = ReadByte();
+      switch (arg.type) {
+        case TRACE_VALUE_TYPE_BOOL:
+          arg.uint_value = ReadByte();
+          break;
+        case TRACE_VALUE_TYPE_UINT:
+        case TRACE_VALUE_TYPE_POINTER:
+          arg.uint_value = ReadVarint();
+          break;
+        case TRACE_VALUE_TYPE_INT:
+          arg.int_value = ReadSignedVarint();
+          break;
+        case TRACE_VALUE_TYPE_DOUBLE: {
+          uint64_t bits = 0;
+          for (int shift = 0; shift < 64; shift += 8) {
+            bits |= static_cast<uint64_t>(ReadByte()) << shift;
+          }
+          memcpy(&arg.double_value, &bits, sizeof(bits));
+          break;
+        }
+        default:
+          arg.string_value = ReadString();
+          break;
+      }
+      event.args.push_back(arg);
+    }
+    return event;
+  }
+
+  std::string LookupString(uint64_t id) {
+    if (id == 0) return std::string();
+    CHECK_LE(id, strings_.size());
+    return strings_[id - 1];
+  }
+
+  uint8_t ReadByte() {
+    CHECK_LT(pos_, data_.size());
+    return static_cast<uint8_t>(data_[pos_++]);
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      uint8_t byte = ReadByte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return value;
+    }
+  }
+
+  int64_t ReadSignedVarint() {
+    uint64_t value = ReadVarint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  std::string ReadString() {
+    size_t length = static_cast<size_t>(ReadVarint());
+    CHECK_LE(pos_ + length, data_.size());
+    std::string str = data_.substr(pos_, length);
+    pos_ += length;
+    return str;
+  }
+
+  std::string data_;
+  size_t pos_ = 0;
+  std::vector<std::string> strings_;
+  std::vector<Event> events_;
+};
+
+}  // namespace
+
+TEST(TestBinaryTraceWriter) {
+  std::ostringstream stream;
+  TraceWriter* writer = TraceWriter::CreateBinaryTraceWriter(stream);
+  PopulateJSONWriter(writer);
+  std::string trace_str = stream.str();
+  BinaryTraceReader reader(trace_str);
+
+  // The category is interned once for both events.
+  CHECK_EQ(3u, reader.strings().size());
+  CHECK_EQ(2u, reader.events().size());
+  const BinaryTraceReader::Event& event0 = reader.events()[0];
+  CHECK_EQ('X', event0.phase);
+  CHECK_EQ(std::string("v8-cat"), event0.category);
+  CHECK_EQ(std::string("Test0"), event0.name);
+  CHECK_EQ(11, event0.pid);
+  CHECK_EQ(22, event0.tid);
+  CHECK_EQ(100, event0.ts);
+  CHECK_EQ(50, event0.tts);
+  CHECK_EQ(33u, event0.duration);
+  CHECK_EQ(44u, event0.cpu_duration);
+  CHECK_EQ(TRACE_EVENT_FLAG_HAS_ID, event0.flags);
+  CHECK_EQ(std::string(), event0.scope);
+  CHECK_EQ(42u, event0.id);
+  CHECK_EQ(0u, event0.args.size());
+  const BinaryTraceReader::Event& event1 = reader.events()[1];
+  CHECK_EQ('Y', event1.phase);
+  CHECK_EQ(std::string("v8-cat"), event1.category);
+  CHECK_EQ(std::string("Test1"), event1.name);
+  CHECK_EQ(55, event1.pid);
+  CHECK_EQ(66, event1.tid);
+  CHECK_EQ(110, event1.ts);
+  CHECK_EQ(55, event1.tts);
+  CHECK_EQ(77u, event1.duration);
+  CHECK_EQ(88u, event1.cpu_duration);
+  CHECK_EQ(0u, event1.flags);
+  CHECK_EQ(0u, event1.id);
+}
+
+TEST(TestBinaryTraceWriterArgs) {
+  std::ostringstream stream;
+  int64_t ee = -55;
+  double jj = -1.5;
+  std::string mm = "INIT";
+
+  {
+    v8::Platform* old_platform = i::V8::GetCurrentPlatform();
+    std::unique_ptr<v8::Platform> default_platform(
+        v8::platform::NewDefaultPlatform());
+    i::V8::SetPlatformForTesting(default_platform.get());
+
+    auto tracing =
+        base::make_unique<v8::platform::tracing::TracingController>();
+    v8::platform::tracing::TracingController* tracing_controller =
+        tracing.get();
+    static_cast<v8::platform::DefaultPlatform*>(default_platform.get())
+        ->SetTracingController(std::move(tracing));
+    TraceWriter* writer = TraceWriter::CreateBinaryTraceWriter(stream);
+
+    TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(
+        TraceBuffer::kRingBufferChunks, writer);
+    tracing_controller->Initialize(buffer);
+    TraceConfig* trace_config = new TraceConfig();
+    trace_config->AddIncludedCategory("v8");
+    tracing_controller->StartTracing(trace_config);
+
+    TRACE_EVENT2("v8", "v8.Test.args", "ee", ee, "jj", jj);
+    TRACE_EVENT2("v8", "v8.Test.args", "ii", true, "mm",
+                 TRACE_STR_COPY(mm.c_str()));
+    TRACE_EVENT_INSTANT1("v8", "v8.Test", TRACE_EVENT_SCOPE_THREAD, "a1",
+                         new ConvertableToTraceFormatMock(42));
+
+    tracing_controller->StopTracing();
+
+    i::V8::SetPlatformForTesting(old_platform);
+  }
+
+  BinaryTraceReader reader(stream.str());
+  CHECK_EQ(3u, reader.events().size());
+  const BinaryTraceReader::Event& event0 = reader.events()[0];
+  CHECK_EQ(std::string("v8.Test.args"), event0.name);
+  CHECK_EQ(2u, event0.args.size());
+  CHECK_EQ(std::string("ee"), event0.args[0].name);
+  CHECK_EQ(TRACE_VALUE_TYPE_INT, event0.args[0].type);
+  CHECK_EQ(-55, event0.args[0].int_value);
+  CHECK_EQ(std::string("jj"), event0.args[1].name);
+  CHECK_EQ(TRACE_VALUE_TYPE_DOUBLE, event0.args[1].type);
+  CHECK_EQ(-1.5, event0.args[1].double_value);
+  const BinaryTraceReader::Event& event1 = reader.events()[1];
+  CHECK_EQ(2u, event1.args.size());
+  CHECK_EQ(TRACE_VALUE_TYPE_BOOL, event1.args[0].type);
+  CHECK_EQ(1u, event1.args[0].uint_value);
+  CHECK_EQ(TRACE_VALUE_TYPE_COPY_STRING, event1.args[1].type);
+  CHECK_EQ(std::string("INIT"), event1.args[1].string_value);
+  const BinaryTraceReader::Event& event2 = reader.events()[2];
+  CHECK_EQ('I', event2.phase);
+  CHECK_EQ(TRACE_VALUE_TYPE_CONVERTABLE, event2.args[0].type);
+  CHECK_EQ(std::string("[42,42]"), event2.args[0].string_value);
+}
+
 TEST(TestTracingController) {
   v8::Platform* old_platform = i::V8::GetCurrentPlatform();
   std::unique_ptr<v8::Platform> default_platform(
@@ -222,6 +712,65 @@ TEST(TestTracingController) {
   i::V8::SetPlatformForTesting(old_platform);
 }
 
+namespace {
+
+// Adds a trace event, then keeps running until it is told to exit.
+class BackgroundTraceEventThread : public v8::base::Thread {
+ public:
+  BackgroundTraceEventThread()
+      : v8::base::Thread(Options("BackgroundTraceEventThread")),
+        added_(0),
+        resume_(0) {}
+
+  void Run() override {
+    TRACE_EVENT_INSTANT0("v8", "v8.Background", TRACE_EVENT_SCOPE_THREAD);
+    added_.Signal();
+    resume_.Wait();
+  }
+
+  void WaitUntilAdded() { added_.Wait(); }
+  void Resume() { resume_.Signal(); }
+
+ private:
+  v8::base::Semaphore added_;
+  v8::base::Semaphore resume_;
+};
+
+}  // namespace
+
+TEST(TestTracingControllerLiveThread) {
+  v8::Platform* old_platform = i::V8::GetCurrentPlatform();
+  std::unique_ptr<v8::Platform> default_platform(
+      v8::platform::NewDefaultPlatform());
+  i::V8::SetPlatformForTesting(default_platform.get());
+
+  auto tracing = base::make_unique<v8::platform::tracing::TracingController>();
+  v8::platform::tracing::TracingController* tracing_controller = tracing.get();
+  static_cast<v8::platform::DefaultPlatform*>(default_platform.get())
+      ->SetTracingController(std::move(tracing));
+
+  MockTraceWriter* writer = new MockTraceWriter();
+  TraceBuffer* buffer = TraceBuffer::CreateThreadLocalTraceBuffer(
+      TraceBuffer::kRingBufferChunks, writer);
+  tracing_controller->Initialize(buffer);
+  TraceConfig* trace_config = new TraceConfig();
+  trace_config->AddIncludedCategory("v8");
+  tracing_controller->StartTracing(trace_config);
+
+  // The latest event of a thread that is still running when tracing stops
+  // is written.
+  BackgroundTraceEventThread thread;
+  thread.Start();
+  thread.WaitUntilAdded();
+  tracing_controller->StopTracing();
+  CHECK_EQ(1u, writer->events().size());
+  CHECK_EQ(std::string("v8.Background"), writer->events()[0]);
+  thread.Resume();
+  thread.Join();
+
+  i::V8::SetPlatformForTesting(old_platform);
+}
+
 void GetJSONStrings(std::vector<std::string>& ret, std::string str,
                     std::string param, std::string start_delim,
                     std::string end_delim) {
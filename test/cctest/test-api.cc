@@ -27,6 +27,7 @@
 
 #include <climits>
 #include <csignal>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -37,6 +38,7 @@
 #include <unistd.h>  // NOLINT
 #endif
 
+#include "include/v8-fast-api-calls.h"
 #include "include/v8-util.h"
 #include "src/api-inl.h"
 #include "src/arguments.h"
@@ -50,6 +52,7 @@
 #include "src/heap/incremental-marking.h"
 #include "src/heap/local-allocator.h"
 #include "src/lookup.h"
+#include "src/microtask-queue.h"
 #include "src/objects-inl.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
@@ -22618,6 +22621,83 @@ TEST(RunMicrotasksWithoutEnteringContext) {
   isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
 }
 
+TEST(RunMicrotasksWithTimeBudget) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+  isolate->AddMicrotasksCompletedCallback(&MicrotasksCompletedCallback);
+  microtasks_completed_callback_count = 0;
+
+  CompileRun(
+      "var count = 0;"
+      "for (var i = 0; i < 1000; i++) Promise.resolve().then(() => count++);");
+
+  // Without any time left, only the first batch of microtasks runs.
+  CHECK(!isolate->RunMicrotasks(0));
+  int count = CompileRun("count")->Int32Value(env.local()).FromJust();
+  CHECK_LT(0, count);
+  CHECK_GT(1000, count);
+  CHECK_EQ(0u, microtasks_completed_callback_count);
+
+  CHECK(isolate->RunMicrotasks(std::numeric_limits<double>::infinity()));
+  CHECK_EQ(1000, CompileRun("count")->Int32Value(env.local()).FromJust());
+  CHECK_EQ(1u, microtasks_completed_callback_count);
+
+  isolate->RemoveMicrotasksCompletedCallback(&MicrotasksCompletedCallback);
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
+}
+
+TEST(PendingMicrotasksSurviveGC) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+
+  CompileRun(
+      "var results = [];"
+      "function enqueue(from, to) {"
+      "  for (var i = from; i < to; i++) {"
+      "    Promise.resolve({value: i}).then(o => results.push(o.value));"
+      "  }"
+      "}"
+      "enqueue(0, 300);");
+  // Run part of the queue, so that the microtasks enqueued next wrap around
+  // the end of the ring buffer.
+  isolate->RunMicrotasks(0);
+  CompileRun("enqueue(300, 600);");
+  CcTest::CollectAllGarbage();
+  CcTest::CollectGarbage(i::NEW_SPACE);
+  isolate->RunMicrotasks();
+
+  CHECK_EQ(600,
+           CompileRun("results.length")->Int32Value(env.local()).FromJust());
+  CHECK(CompileRun("results.every((value, i) => value === i)")
+            ->BooleanValue(env.local())
+            .FromJust());
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
+}
+
+TEST(MicrotaskQueueShrinksAfterDraining) {
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kExplicit);
+  i::MicrotaskQueue* queue =
+      reinterpret_cast<i::Isolate*>(isolate)->default_microtask_queue();
+
+  CompileRun("for (var i = 0; i < 1000; i++) Promise.resolve().then();");
+  intptr_t capacity = queue->capacity();
+  CHECK_LE(1000, capacity);
+  // Visiting the roots leaves the ring buffer alone.
+  CcTest::CollectAllGarbage();
+  CHECK_EQ(capacity, queue->capacity());
+
+  isolate->RunMicrotasks();
+  CHECK_EQ(i::MicrotaskQueue::kMinimumCapacity, queue->capacity());
+  isolate->SetMicrotasksPolicy(v8::MicrotasksPolicy::kAuto);
+}
+
 static void Regress808911_MicrotaskCallback(void* data) {
   // So here we expect "current context" to be context1 and
   // "entered or microtask context" to be context2.
@@ -28761,3 +28841,142 @@ TEST(TestSetWasmThreadsEnabledCallback) {
   i::FLAG_experimental_wasm_threads = false;
   CHECK(i_isolate->AreWasmThreadsEnabled(i_context));
 }
+
+namespace {
+
+int fast_api_call_count = 0;
+int slow_api_call_count = 0;
+
+int32_t FastApiAdd(v8::ApiObject receiver, int32_t a, int32_t b) {
+  fast_api_call_count++;
+  return a + b;
+}
+
+void SlowApiAdd(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  slow_api_call_count++;
+  Local<Context> context = info.GetIsolate()->GetCurrentContext();
+  int32_t a = info[0]->Int32Value(context).FromJust();
+  int32_t b = info[1]->Int32Value(context).FromJust();
+  info.GetReturnValue().Set(a + b);
+}
+
+double FastApiMultiplyAdd(v8::ApiObject receiver, double a, int32_t b,
+                          double c) {
+  fast_api_call_count++;
+  return a * b + c;
+}
+
+void SlowApiMultiplyAdd(const v8::FunctionCallbackInfo<v8::Value>& info) {
+  slow_api_call_count++;
+  Local<Context> context = info.GetIsolate()->GetCurrentContext();
+  double a = info[0]->NumberValue(context).FromJust();
+  int32_t b = info[1]->Int32Value(context).FromJust();
+  double c = info[2]->NumberValue(context).FromJust();
+  info.GetReturnValue().Set(a * b + c);
+}
+
+}  // namespace
+
+TEST(FastApiCalls) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<Context> context = env.local();
+
+  v8::CFunction c_function = v8::CFunction::Make(FastApiAdd);
+  Local<FunctionTemplate> add_template = FunctionTemplate::New(
+      isolate, SlowApiAdd, Local<Value>(), Local<v8::Signature>(), 2,
+      v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+      &c_function);
+  Local<ObjectTemplate> object_template = ObjectTemplate::New(isolate);
+  object_template->Set(isolate, "add", add_template);
+  CHECK(env->Global()
+            ->Set(context, v8_str("api"),
+                  object_template->NewInstance(context).ToLocalChecked())
+            .FromJust());
+
+  fast_api_call_count = 0;
+  slow_api_call_count = 0;
+  CompileRun("function f(a, b) { return api.add(a, b); }");
+  ExpectInt32("f(1, 2)", 3);
+  ExpectInt32("f(3, 4)", 7);
+  CHECK_EQ(0, fast_api_call_count);
+
+  // Optimized code calls the C function for Smi arguments.
+  ExpectInt32("%OptimizeFunctionOnNextCall(f); f(5, 6)", 11);
+  ExpectInt32("f(-7, 6)", -1);
+  bool const optimizes = i::FLAG_opt && !i::FLAG_always_opt;
+  if (optimizes) {
+    CHECK_EQ(2, fast_api_call_count);
+    CHECK_EQ(2, slow_api_call_count);
+  }
+
+  // Other arguments deoptimize and use the regular callback.
+  ExpectInt32("f(1.5, 2)", 3);
+  if (optimizes) {
+    CHECK_EQ(2, fast_api_call_count);
+    CHECK_EQ(3, slow_api_call_count);
+  }
+
+  // Once the call site deoptimized, it no longer speculates on the arguments.
+  ExpectInt32("%OptimizeFunctionOnNextCall(f); f(8, 9)", 17);
+  ExpectInt32("f(0.5, 1)", 1);
+  if (optimizes) {
+    CHECK_EQ(2, fast_api_call_count);
+    CHECK_EQ(5, slow_api_call_count);
+  }
+  CHECK_EQ(7, fast_api_call_count + slow_api_call_count);
+}
+
+TEST(FastApiCallsDouble) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::Isolate* isolate = env->GetIsolate();
+  v8::HandleScope scope(isolate);
+  Local<Context> context = env.local();
+
+  v8::CFunction c_function = v8::CFunction::Make(FastApiMultiplyAdd);
+  Local<FunctionTemplate> multiply_add_template = FunctionTemplate::New(
+      isolate, SlowApiMultiplyAdd, Local<Value>(), Local<v8::Signature>(), 3,
+      v8::ConstructorBehavior::kThrow, v8::SideEffectType::kHasSideEffect,
+      &c_function);
+  Local<ObjectTemplate> object_template = ObjectTemplate::New(isolate);
+  object_template->Set(isolate, "multiplyAdd", multiply_add_template);
+  CHECK(env->Global()
+            ->Set(context, v8_str("api"),
+                  object_template->NewInstance(context).ToLocalChecked())
+            .FromJust());
+
+  fast_api_call_count = 0;
+  slow_api_call_count = 0;
+  CompileRun("function f(a, b, c) { return api.multiplyAdd(a, b, c); }");
+  ExpectNumber("f(1.5, 2, 0.25)", 3.25);
+  ExpectNumber("f(2, 3, 4)", 10);
+  CHECK_EQ(0, fast_api_call_count);
+
+  // Optimized code calls the C function for numbers, including Smis, for
+  // the double parameters and returns a double.
+  ExpectNumber("%OptimizeFunctionOnNextCall(f); f(0.5, 3, 0.125)", 1.625);
+  ExpectNumber("f(7, -2, 1)", -13);
+  ExpectNumber("1 / f(-0, 1, -0)", -std::numeric_limits<double>::infinity());
+  ExpectNumber("f(1e308, 10, 0)", std::numeric_limits<double>::infinity());
+#if V8_TARGET_ARCH_X64
+  bool const optimizes = i::FLAG_opt && !i::FLAG_always_opt;
+#else
+  // Only x64 passes doubles to C functions.
+  bool const optimizes = false;
+#endif
+  if (optimizes) {
+    CHECK_EQ(4, fast_api_call_count);
+    CHECK_EQ(2, slow_api_call_count);
+  }
+
+  // Other arguments deoptimize and use the regular callback.
+  ExpectNumber("f('2', 2, 1)", 5);
+  if (optimizes) {
+    CHECK_EQ(4, fast_api_call_count);
+    CHECK_EQ(3, slow_api_call_count);
+  }
+  CHECK_EQ(7, fast_api_call_count + slow_api_call_count);
+}
@@ -28,7 +28,9 @@
 // Tests of profiles generator and utilities.
 
 #include <limits>
+#include <map>
 #include <memory>
+#include <string>
 
 #include "src/v8.h"
 
@@ -2544,6 +2546,199 @@ TEST(MultipleProfilers) {
   profiler2->StopProfiling("2");
 }
 
+namespace {
+
+class RecordingSink : public v8::ContinuousProfileSink {
+ public:
+  void OnChunk(const v8::ContinuousProfileChunk& chunk) override {
+    chunks_++;
+    CHECK_LE(chunk.start_time, chunk.end_time);
+    for (size_t i = 0; i < chunk.new_functions_count; i++) {
+      const v8::ContinuousProfileFunction& function = chunk.new_functions[i];
+      // Every function is described once.
+      CHECK(names_.emplace(function.id, function.name).second);
+    }
+    for (size_t i = 0; i < chunk.samples_count; i++) {
+      const v8::ContinuousProfileSample& sample = chunk.samples[i];
+      std::string stack;
+      for (size_t j = 0; j < sample.depth; j++) {
+        CHECK(names_.count(sample.function_ids[j]));
+        if (j > 0) stack += ";";
+        stack += names_[sample.function_ids[j]];
+      }
+      counts_[stack] += sample.count;
+    }
+  }
+
+  int chunks() const { return chunks_; }
+  size_t functions() const { return names_.size(); }
+  // Stacks are written leaf first, separated by semicolons.
+  int64_t count(const std::string& stack) {
+    return counts_.count(stack) ? counts_[stack] : 0;
+  }
+  const std::map<std::string, int64_t>& counts() const { return counts_; }
+
+ private:
+  int chunks_ = 0;
+  std::map<unsigned, std::string> names_;
+  std::map<std::string, int64_t> counts_;
+};
+
+}  // namespace
+
+TEST(ContinuousProfileAggregation) {
+  CodeEntry foo(CodeEventListener::FUNCTION_TAG, "foo");
+  CodeEntry bar(CodeEventListener::FUNCTION_TAG, "bar");
+  // Another code object for the same function, e.g. after optimization.
+  CodeEntry bar2(CodeEventListener::FUNCTION_TAG, bar.name());
+  CHECK(bar2.IsSameFunctionAs(&bar));
+
+  RecordingSink sink;
+  base::TimeDelta flush_interval = base::TimeDelta::FromMilliseconds(100);
+  ContinuousProfile profile(&sink, base::TimeDelta::FromMilliseconds(1),
+                            flush_interval, 1 * MB);
+  base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+  ProfileStackTrace foo_bar = {{&foo, 0}, {&bar, 0}};
+  ProfileStackTrace foo_bar2 = {{&foo, 0}, {&bar2, 0}};
+  ProfileStackTrace bar_only = {{nullptr, 0}, {&bar, 0}};
+  profile.AddPath(now, foo_bar);
+  profile.AddPath(now, foo_bar2);
+  profile.AddPath(now, bar_only);
+  profile.FlushIfDue(now);
+  CHECK_EQ(0, sink.chunks());
+
+  // The flush interval has passed, without new samples.
+  profile.FlushIfDue(now + flush_interval);
+  CHECK_EQ(1, sink.chunks());
+  CHECK_EQ(2, sink.count("foo;bar"));
+  CHECK_EQ(1, sink.count("bar"));
+
+  profile.AddPath(now + flush_interval, foo_bar);
+  profile.Flush(now + flush_interval);
+  CHECK_EQ(2, sink.chunks());
+  CHECK_EQ(3, sink.count("foo;bar"));
+  CHECK_EQ(2u, sink.counts().size());
+  // Functions are described once while they fit in the budget.
+  CHECK_EQ(2u, sink.functions());
+}
+
+TEST(ContinuousProfileMemoryBudget) {
+  std::vector<std::unique_ptr<CodeEntry>> entries;
+  for (int i = 0; i < 100; i++) {
+    entries.emplace_back(new CodeEntry(CodeEventListener::FUNCTION_TAG, "f",
+                                       CodeEntry::kEmptyResourceName, i));
+  }
+  RecordingSink sink;
+  size_t budget = 4 * KB;
+  ContinuousProfile profile(&sink, base::TimeDelta::FromMilliseconds(1),
+                            base::TimeDelta::FromSeconds(100), budget);
+  base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+  int64_t total = 0;
+  for (int i = 0; i < 100; i++) {
+    for (int j = 0; j < 100; j++) {
+      ProfileStackTrace path = {{entries[i].get(), 0},
+                                {entries[j].get(), 0}};
+      profile.AddPath(now, path);
+      total++;
+      CHECK_LE(profile.memory_usage(), budget);
+    }
+  }
+  profile.Flush(now);
+  CHECK_LT(1, sink.chunks());
+  int64_t counted = 0;
+  for (const auto& stack : sink.counts()) counted += stack.second;
+  CHECK_EQ(total, counted);
+}
+
+TEST(ContinuousProfileForgetsFunctions) {
+  // More functions than the budget can keep interned, with long names.
+  StringsStorage names;
+  std::vector<std::unique_ptr<CodeEntry>> entries;
+  std::string name(200, 'f');
+  for (int i = 0; i < 1000; i++) {
+    entries.emplace_back(
+        new CodeEntry(CodeEventListener::FUNCTION_TAG,
+                      names.GetFormatted("%s%d", name.c_str(), i)));
+  }
+  RecordingSink sink;
+  size_t budget = 16 * KB;
+  ContinuousProfile profile(&sink, base::TimeDelta::FromMilliseconds(1),
+                            base::TimeDelta::FromSeconds(100), budget);
+  base::TimeTicks now = base::TimeTicks::HighResolutionNow();
+  for (int round = 0; round < 2; round++) {
+    for (const auto& entry : entries) {
+      ProfileStackTrace path = {{entry.get(), 0}};
+      profile.AddPath(now, path);
+      CHECK_LE(profile.memory_usage(), budget);
+    }
+  }
+  profile.Flush(now);
+  // The functions seen again after being forgotten got new ids.
+  CHECK_LT(entries.size(), sink.functions());
+  int64_t counted = 0;
+  for (const auto& stack : sink.counts()) counted += stack.second;
+  CHECK_EQ(2 * static_cast<int64_t>(entries.size()), counted);
+}
+
+static const char* continuous_profiling_test_source =
+    "%NeverOptimizeFunction(loop);\n"
+    "%NeverOptimizeFunction(start);\n"
+    "function loop(n) {\n"
+    "  var s = 0;\n"
+    "  for (var i = 0; i < n; i++) s += Math.sqrt(i);\n"
+    "  return s;\n"
+    "}\n"
+    "function start(duration) {\n"
+    "  var start = Date.now();\n"
+    "  do {\n"
+    "    loop(1000);\n"
+    "  } while (Date.now() - start < duration);\n"
+    "}\n";
+
+TEST(ContinuousProfilingAPI) {
+  i::FLAG_allow_natives_syntax = true;
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  CompileRun(continuous_profiling_test_source);
+  v8::Local<v8::Function> function = GetFunction(env.local(), "start");
+
+  v8::CpuProfiler* profiler = v8::CpuProfiler::New(env->GetIsolate());
+  RecordingSink sink;
+  v8::ContinuousProfilingOptions options;
+  options.sampling_interval_us = 100;
+  options.flush_interval_ms = 20;
+  CHECK(profiler->StartContinuousProfiling(&sink, options));
+  // Only one continuous profile at a time.
+  RecordingSink other_sink;
+  CHECK(!profiler->StartContinuousProfiling(&other_sink, options));
+
+  // A regular profile can be recorded at the same time, and stopping it
+  // keeps the continuous profile going.
+  profiler->StartProfiling(v8_str("regular"));
+  v8::Local<v8::Value> args[] = {v8::Integer::New(env->GetIsolate(), 100)};
+  function->Call(env.local(), env->Global(), arraysize(args), args)
+      .ToLocalChecked();
+  profiler->StopProfiling(v8_str("regular"))->Delete();
+  function->Call(env.local(), env->Global(), arraysize(args), args)
+      .ToLocalChecked();
+  profiler->StopContinuousProfiling();
+
+  CHECK_LT(1, sink.chunks());
+  CHECK_EQ(0, other_sink.chunks());
+  int64_t loop_samples = 0;
+  for (const auto& stack : sink.counts()) {
+    if (stack.first.find("loop;start") == 0) loop_samples += stack.second;
+  }
+  CHECK_LT(0, loop_samples);
+
+  // Nothing is reported after stopping.
+  int chunks = sink.chunks();
+  function->Call(env.local(), env->Global(), arraysize(args), args)
+      .ToLocalChecked();
+  CHECK_EQ(chunks, sink.chunks());
+  profiler->Dispose();
+}
+
 }  // namespace test_cpu_profiler
 }  // namespace internal
 }  // namespace v8
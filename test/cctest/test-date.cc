@@ -167,6 +167,60 @@ TEST(DaylightSavingsTime) {
   CheckDST(august_20);
 }
 
+#ifdef V8_INTL_SUPPORT
+// With ICU, the offsets are looked up in a table of transitions. Local times
+// that are skipped or repeated by a transition use the offset before it.
+TEST(LocalTimeAroundTransitions) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  v8::HandleScope scope(isolate);
+  DateCacheMock::Rule rules[] = {
+      {0, 2, 0, 10, 0, 3600},  // DST from March to November in any year.
+  };
+
+  int local_offset_ms = -36000000;  // -10 hours.
+  const int64_t kMsPerHour = 3600 * 1000;
+
+  DateCacheMock* date_cache =
+      new DateCacheMock(local_offset_ms, rules, arraysize(rules));
+
+  reinterpret_cast<Isolate*>(isolate)->set_date_cache(date_cache);
+
+  // DST starts on March 4 and ends on November 4, at 2:00 UTC.
+  int64_t dst_start = TimeFromYearMonthDay(date_cache, 2018, 2, 4) +
+                      2 * kMsPerHour;
+  int64_t dst_end = TimeFromYearMonthDay(date_cache, 2018, 10, 4) +
+                    2 * kMsPerHour;
+
+  CHECK_EQ(local_offset_ms, date_cache->LocalOffsetInMs(dst_start - 1, true));
+  CHECK_EQ(local_offset_ms + kMsPerHour,
+           date_cache->LocalOffsetInMs(dst_start, true));
+  CHECK_EQ(local_offset_ms + kMsPerHour,
+           date_cache->LocalOffsetInMs(dst_end - 1, true));
+  CHECK_EQ(local_offset_ms, date_cache->LocalOffsetInMs(dst_end, true));
+
+  // The skipped local hour before DST starts.
+  CHECK_EQ(dst_start - 1000,
+           date_cache->ToUTC(dst_start - 10 * kMsPerHour - 1000));
+  CHECK_EQ(dst_start, date_cache->ToUTC(dst_start - 10 * kMsPerHour));
+  CHECK_EQ(dst_start + kMsPerHour - 1000,
+           date_cache->ToUTC(dst_start - 9 * kMsPerHour - 1000));
+  CHECK_EQ(dst_start, date_cache->ToUTC(dst_start - 9 * kMsPerHour));
+
+  // The repeated local hour before DST ends.
+  CHECK_EQ(dst_end - kMsPerHour,
+           date_cache->ToUTC(dst_end - 10 * kMsPerHour));
+  CHECK_EQ(dst_end - 1000, date_cache->ToUTC(dst_end - 9 * kMsPerHour - 1000));
+  CHECK_EQ(dst_end + kMsPerHour, date_cache->ToUTC(dst_end - 9 * kMsPerHour));
+
+  // Round trips, also for years that are far apart.
+  for (int year = 1800; year <= 2200; year += 7) {
+    int64_t time = TimeFromYearMonthDay(date_cache, year, year % 12, 10);
+    CHECK_EQ(time, date_cache->ToUTC(date_cache->ToLocal(time)));
+  }
+}
+#endif  // V8_INTL_SUPPORT
+
 namespace {
 int legacy_parse_count = 0;
 void DateParseLegacyCounterCallback(v8::Isolate* isolate,
@@ -28,6 +28,7 @@
 #include "src/v8.h"
 #include "test/cctest/cctest.h"
 
+#include "src/api-inl.h"
 #include "src/builtins/builtins-constructor.h"
 #include "src/debug/debug.h"
 #include "src/execution.h"
@@ -300,6 +301,186 @@ TEST(ObjectHashTableCausesGC) {
 }
 #endif
 
+static Handle<String> PropertyName(Isolate* isolate, int i) {
+  ScopedVector<char> buffer(16);
+  SNPrintF(buffer, "p%d", i);
+  return isolate->factory()->InternalizeUtf8String(buffer.start());
+}
+
+static void CheckNameDictionaryEntries(Isolate* isolate,
+                                       Handle<NameDictionary> dictionary,
+                                       int count, int deleted_every) {
+  for (int i = 0; i < count; i++) {
+    int entry = dictionary->FindEntry(isolate, PropertyName(isolate, i));
+    if (deleted_every > 0 && i % deleted_every == 0) {
+      CHECK_EQ(NameDictionary::kNotFound, entry);
+    } else {
+      CHECK_NE(NameDictionary::kNotFound, entry);
+      CHECK_EQ(Smi::FromInt(i), dictionary->ValueAt(entry));
+    }
+  }
+}
+
+TEST(NameDictionaryWithControlTable) {
+  FLAG_swiss_name_dictionary = true;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(context->GetIsolate());
+
+  // Small dictionaries keep using quadratic probing.
+  Handle<NameDictionary> dictionary = NameDictionary::New(isolate, 1);
+  CHECK(!dictionary->HasControlTable());
+
+  // Growing the dictionary switches to a control table.
+  const int kCount = 300;
+  PropertyDetails details = PropertyDetails::Empty();
+  for (int i = 0; i < kCount; i++) {
+    dictionary = NameDictionary::Add(isolate, dictionary,
+                                     PropertyName(isolate, i),
+                                     handle(Smi::FromInt(i), isolate), details);
+    if (dictionary->Capacity() >= NameDictionary::kMinControlTableCapacity) {
+      CHECK(dictionary->HasControlTable());
+    }
+  }
+  CHECK(dictionary->HasControlTable());
+  CHECK_EQ(kCount, dictionary->NumberOfElements());
+  CheckNameDictionaryEntries(isolate, dictionary, kCount, 0);
+
+  // Deleted entries are skipped, but don't terminate the probe sequences.
+  const int kDeletedEvery = 3;
+  for (int i = 0; i < kCount; i += kDeletedEvery) {
+    int entry = dictionary->FindEntry(isolate, PropertyName(isolate, i));
+    dictionary = NameDictionary::DeleteEntry(isolate, dictionary, entry);
+  }
+  CHECK(dictionary->HasControlTable());
+  CheckNameDictionaryEntries(isolate, dictionary, kCount, kDeletedEvery);
+
+  // Rehashing in place drops the deleted entries.
+  dictionary->Rehash(isolate);
+  CHECK_EQ(0, dictionary->NumberOfDeletedElements());
+  CheckNameDictionaryEntries(isolate, dictionary, kCount, kDeletedEvery);
+
+  // Copies of the backing store get their own control table.
+  Handle<NameDictionary> copy = Handle<NameDictionary>::cast(
+      isolate->factory()->CopyFixedArray(dictionary));
+  NameDictionary::CopyControlTable(isolate, copy);
+  CHECK_NE(dictionary->ControlTable(), copy->ControlTable());
+  CheckNameDictionaryEntries(isolate, copy, kCount, kDeletedEvery);
+
+  // Shrinking below the threshold goes back to quadratic probing.
+  for (int i = 0; i < kCount; i++) {
+    if (i % kDeletedEvery == 0 || i < 10) continue;
+    int entry = dictionary->FindEntry(isolate, PropertyName(isolate, i));
+    dictionary = NameDictionary::DeleteEntry(isolate, dictionary, entry);
+  }
+  CHECK(!dictionary->HasControlTable());
+  CheckNameDictionaryEntries(isolate, dictionary, 10, kDeletedEvery);
+}
+
+// Returns a name whose hash selects {slot} in a table with {capacity}
+// entries and has the H2 bits {h2}, or an empty handle.
+static Handle<String> FindNameWithHash(Isolate* isolate, int capacity,
+                                       int slot, swiss_table::ctrl_t h2,
+                                       const char* prefix) {
+  const int kMaxCandidates = 1 << 20;
+  for (int i = 0; i < kMaxCandidates; i++) {
+    HandleScope scope(isolate);
+    ScopedVector<char> buffer(32);
+    SNPrintF(buffer, "%s%d", prefix, i);
+    Handle<String> name =
+        isolate->factory()->NewStringFromAsciiChecked(buffer.start());
+    uint32_t hash = name->Hash();
+    if (static_cast<int>(hash & (capacity - 1)) == slot &&
+        swiss_table::H2(hash) == h2) {
+      return isolate->factory()->InternalizeUtf8String(buffer.start());
+    }
+  }
+  return Handle<String>();
+}
+
+TEST(NameDictionaryControlByteCollisions) {
+  FLAG_swiss_name_dictionary = true;
+  LocalContext context;
+  Isolate* isolate = CcTest::i_isolate();
+  v8::HandleScope scope(context->GetIsolate());
+
+  Handle<NameDictionary> dictionary = NameDictionary::New(isolate, 32);
+  CHECK(dictionary->HasControlTable());
+  const int capacity = dictionary->Capacity();
+
+  // Look for a {missing} name and two names in its first group: {same}, with
+  // the same control byte as {missing} in the entry where the probe sequence
+  // of {missing} starts, and {next}, in the entry after that, with a control
+  // byte that differs in the lowest bit. The portable group match reports
+  // both entries for {missing}.
+  const int kWidth = swiss_table::GroupPortableImpl::kWidth;
+  Handle<String> missing;
+  uint32_t hash;
+  int slot;
+  for (int i = 0;; i++) {
+    ScopedVector<char> buffer(16);
+    SNPrintF(buffer, "m%d", i);
+    missing = isolate->factory()->InternalizeUtf8String(buffer.start());
+    hash = missing->Hash();
+    slot = static_cast<int>(hash & (capacity - 1));
+    if (slot % kWidth != kWidth - 1) break;
+  }
+  int const first_index = slot % kWidth;
+  swiss_table::ctrl_t h2 = swiss_table::H2(hash);
+  Handle<String> same = FindNameWithHash(isolate, capacity, slot, h2, "s");
+  Handle<String> next =
+      FindNameWithHash(isolate, capacity, slot + 1, h2 ^ 1, "t");
+  CHECK(!same.is_null());
+  CHECK(!next.is_null());
+
+  PropertyDetails details = PropertyDetails::Empty();
+  dictionary = NameDictionary::Add(isolate, dictionary, same,
+                                   handle(Smi::FromInt(1), isolate), details);
+  dictionary = NameDictionary::Add(isolate, dictionary, next,
+                                   handle(Smi::FromInt(2), isolate), details);
+  CHECK(dictionary->HasControlTable());
+  CHECK_EQ(capacity, dictionary->Capacity());
+  CHECK_EQ(slot, dictionary->FindEntry(isolate, same));
+  CHECK_EQ(slot + 1, dictionary->FindEntry(isolate, next));
+
+  const swiss_table::ctrl_t* control =
+      dictionary->ControlTable()->GetDataStartAddress();
+  swiss_table::GroupPortableImpl group(control + slot - first_index);
+  auto match = group.Match(h2).ClearBelow(first_index);
+  CHECK(match.HasAny());
+  CHECK_EQ(first_index, match.LowestBitSet());
+  match.ClearLowestBit();
+  CHECK(match.HasAny());
+  CHECK_EQ(first_index + 1, match.LowestBitSet());
+
+  // The C++ runtime skips both entries.
+  CHECK_EQ(NameDictionary::kNotFound, dictionary->FindEntry(isolate, missing));
+
+  // So do the CodeStubAssembler lookups of the load ICs, which probe with the
+  // portable group match.
+  Handle<JSObject> object =
+      isolate->factory()->NewJSObject(isolate->object_function());
+  JSObject::NormalizeProperties(object, CLEAR_INOBJECT_PROPERTIES, 0, "test");
+  object->SetProperties(*dictionary);
+  CHECK(context->Global()
+            ->Set(context.local(), v8_str("o"), v8::Utils::ToLocal(object))
+            .FromJust());
+  ScopedVector<char> source(256);
+  SNPrintF(source,
+           "function load(o, key) { return o[key]; }"
+           "for (var i = 0; i < 10; i++) {"
+           "  if (load(o, '%s') !== 1) throw 'same';"
+           "  if (load(o, '%s') !== 2) throw 'next';"
+           "  if (load(o, '%s') !== undefined) throw 'missing';"
+           "  if (o.%s !== undefined) throw 'missing';"
+           "}",
+           same->ToCString().get(), next->ToCString().get(),
+           missing->ToCString().get(), missing->ToCString().get());
+  v8::TryCatch try_catch(context->GetIsolate());
+  CompileRun(source.start());
+  CHECK(!try_catch.HasCaught());
+}
+
 TEST(MaximumClonedShallowObjectProperties) {
   // Assert that a NameDictionary with kMaximumClonedShallowObjectProperties is
   // not in large-object space.
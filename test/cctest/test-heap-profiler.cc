@@ -29,6 +29,7 @@
 
 #include <ctype.h>
 
+#include <map>
 #include <memory>
 
 #include "src/v8.h"
@@ -1140,6 +1141,183 @@ TEST(HeapSnapshotJSONSerializationAborting) {
   CHECK_EQ(0, stream.eos_signaled());
 }
 
+TEST(HeapSnapshotStreaming) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "function B(x) { this.x = x; }\n"
+      "var a = new A('streamed string');\n"
+      "var b = new B(a);\n"
+      "var m = new WeakMap();\n"
+      "m.set(a, b);");
+  TestJSONStream stream;
+  CHECK(heap_profiler->StreamHeapSnapshot(&stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+
+  OneByteResource* json_res = new OneByteResource(json);
+  v8::Local<v8::String> json_string =
+      v8::String::NewExternalOneByte(env->GetIsolate(), json_res)
+          .ToLocalChecked();
+  env->Global()
+      ->Set(env.local(), v8_str("json_snapshot"), json_string)
+      .FromJust();
+  // Check that the counts are consistent, all edges point to nodes, and the
+  // string can be found through <root> -> <global>.b.x.s.
+  v8::Local<v8::Value> result = CompileRun(
+      "var parsed = JSON.parse(json_snapshot);\n"
+      "var meta = parsed.snapshot.meta;\n"
+      "var node_fields_count = meta.node_fields.length;\n"
+      "var edge_fields_count = meta.edge_fields.length;\n"
+      "var name_offset = meta.node_fields.indexOf('name');\n"
+      "var edge_count_offset = meta.node_fields.indexOf('edge_count');\n"
+      "var edge_type_offset = meta.edge_fields.indexOf('type');\n"
+      "var edge_name_offset = meta.edge_fields.indexOf('name_or_index');\n"
+      "var edge_to_node_offset = meta.edge_fields.indexOf('to_node');\n"
+      "var property_type ="
+      "    meta.edge_types[edge_type_offset].indexOf('property');\n"
+      "var nodes = parsed.nodes, edges = parsed.edges;\n"
+      "var strings = parsed.strings;\n"
+      "var node_count = nodes.length / node_fields_count;\n"
+      "var first_edge_indexes = [];\n"
+      "var edge_count = 0;\n"
+      "for (var i = 0; i < node_count; ++i) {\n"
+      "  first_edge_indexes[i] = edge_count * edge_fields_count;\n"
+      "  edge_count += nodes[i * node_fields_count + edge_count_offset];\n"
+      "  if (strings[nodes[i * node_fields_count + name_offset]] === undefined)"
+      "    throw 'bad node name';\n"
+      "}\n"
+      "first_edge_indexes[node_count] = edge_count * edge_fields_count;\n"
+      "if (node_count !== parsed.snapshot.node_count) throw 'bad nodes';\n"
+      "if (edge_count !== parsed.snapshot.edge_count) throw 'bad edge count';\n"
+      "if (edges.length !== edge_count * edge_fields_count)\n"
+      "  throw 'bad edges';\n"
+      "for (var i = 0; i < edges.length; i += edge_fields_count) {\n"
+      "  var to_node = edges[i + edge_to_node_offset];\n"
+      "  if (to_node % node_fields_count !== 0 || to_node >= nodes.length)\n"
+      "    throw 'bad to_node';\n"
+      "}\n"
+      "function GetChildPosByProperty(pos, prop_name) {\n"
+      "  var node_ordinal = pos / node_fields_count;\n"
+      "  for (var i = first_edge_indexes[node_ordinal],\n"
+      "      count = first_edge_indexes[node_ordinal + 1];\n"
+      "      i < count; i += edge_fields_count) {\n"
+      "    if (edges[i + edge_type_offset] === property_type\n"
+      "        && strings[edges[i + edge_name_offset]] === prop_name)\n"
+      "      return edges[i + edge_to_node_offset];\n"
+      "  }\n"
+      "  return null;\n"
+      "}\n"
+      "var global_pos = edges[edge_fields_count + edge_to_node_offset];\n"
+      "var s_pos = GetChildPosByProperty(GetChildPosByProperty(\n"
+      "    GetChildPosByProperty(global_pos, 'b'), 'x'), 's');\n"
+      "strings[nodes[s_pos + name_offset]];");
+  CHECK(!result.IsEmpty());
+  CHECK_EQ(0, strcmp("streamed string",
+                     *v8::String::Utf8Value(env->GetIsolate(), result)));
+}
+
+TEST(HeapSnapshotStreamingAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  TestJSONStream stream(5);
+  CHECK(!heap_profiler->StreamHeapSnapshot(&stream));
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+
+namespace {
+
+class NullJSONStream : public v8::OutputStream {
+ public:
+  NullJSONStream() : size_(0) {}
+  virtual ~NullJSONStream() {}
+  virtual void EndOfStream() {}
+  virtual WriteResult WriteAsciiChunk(char* buffer, int chars_written) {
+    size_ += chars_written;
+    return kContinue;
+  }
+  size_t size() const { return size_; }
+
+ private:
+  size_t size_;
+};
+
+}  // namespace
+
+TEST(HeapSnapshotStreamingMemoryUsage) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  i::Isolate* isolate = CcTest::i_isolate();
+
+  // A heap of half a million small objects referring to each other, each
+  // with a distinct flat string. Naming all the strings by their contents
+  // would take more memory than the rest of the streamer.
+  CompileRun(
+      "var objects = [];\n"
+      "for (var i = 0; i < 500000; i++) {\n"
+      "  var name = ['streamed string', i, 'of', 500000].join(' ');\n"
+      "  objects.push({index: i, next: objects[i - 1], data: [i], s: name});\n"
+      "}");
+  CcTest::CollectAllGarbage();
+  size_t heap_size = CcTest::heap()->SizeOfObjects();
+
+  NullJSONStream stream;
+  i::HeapSnapshotStreamer streamer(isolate->heap_profiler(), nullptr, nullptr,
+                                   CcTest::heap());
+  CHECK(streamer.StreamSnapshot(&stream));
+  // The in-memory graph of the same snapshot would take about as much
+  // memory as the heap itself. The names are counted too.
+  CHECK_GT(streamer.memory_usage(), heap_size / 32);
+  CHECK_LT(streamer.memory_usage(), heap_size / 10);
+  CHECK_GT(stream.size(), heap_size / 10);
+}
+
+static std::string SerializeToString(const v8::HeapSnapshot* snapshot) {
+  TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+  i::ScopedVector<char> json(stream.size());
+  stream.WriteTo(json);
+  return std::string(json.start(), json.length());
+}
+
+TEST(HeapSnapshotParallelExtraction) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Objects spread over several pages, with the kinds of references that
+  // workers hand back to the main thread: WeakMap keys, which are named
+  // after their entry, tags, and backing stores, which are not heap objects.
+  CompileRun(
+      "function A(s) { this.s = s; this.f = function() { return s; }; }\n"
+      "var objects = [], m = new WeakMap();\n"
+      "for (var i = 0; i < 20000; i++) {\n"
+      "  objects.push(new A('s' + i));\n"
+      "  if (i % 100 == 0) m.set(objects[i], new ArrayBuffer(i));\n"
+      "}");
+  const v8::HeapSnapshot* serial_snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(serial_snapshot));
+  std::string expected = SerializeToString(serial_snapshot);
+
+  // Taking a snapshot doesn't change the heap, so the snapshots have to be
+  // the same however many threads extract the references.
+  for (int threads : {1, 2, 4}) {
+    i::FLAG_heap_snapshot_threads = threads;
+    const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+    CHECK(ValidateSnapshot(snapshot));
+    CHECK_EQ(serial_snapshot->GetNodesCount(), snapshot->GetNodesCount());
+    CHECK(expected == SerializeToString(snapshot));
+  }
+  i::FLAG_heap_snapshot_threads = 0;
+}
+
 namespace {
 
 class TestStatsStream : public v8::OutputStream {
@@ -3736,6 +3914,109 @@ TEST(SamplingHeapProfilerSampleDuringDeopt) {
   heap_profiler->StopSamplingHeapProfiler();
 }
 
+namespace {
+
+class SampledAllocationsCollector : public v8::SampledAllocationsSink {
+ public:
+  struct Site {
+    std::vector<std::string> functions;
+    std::string type_name;
+    int64_t allocated_count;
+    int64_t live_count;
+  };
+
+  void OnChunk(const v8::SampledAllocationsChunk& chunk) override {
+    chunks_++;
+    for (size_t i = 0; i < chunk.new_functions_count; i++) {
+      const v8::ContinuousProfileFunction& function = chunk.new_functions[i];
+      functions_[function.id] = function.name;
+    }
+    for (size_t i = 0; i < chunk.sites_count; i++) {
+      const v8::SampledAllocationSite& site = chunk.sites[i];
+      Site& collected = sites_[site.id];
+      collected.functions.clear();
+      for (size_t j = 0; j < site.depth; j++) {
+        CHECK_NE(functions_.end(), functions_.find(site.function_ids[j]));
+        collected.functions.push_back(functions_[site.function_ids[j]]);
+      }
+      collected.type_name = site.type_name;
+      CHECK_LE(site.live_count, site.allocated_count);
+      CHECK_LE(site.live_bytes, site.allocated_bytes);
+      collected.allocated_count = site.allocated_count;
+      collected.live_count = site.live_count;
+    }
+  }
+
+  // Returns the site of {type_name} objects allocated in {function}.
+  const Site* FindSite(const char* function, const char* type_name) const {
+    for (const auto& entry : sites_) {
+      const Site& site = entry.second;
+      if (site.type_name != type_name) continue;
+      for (const std::string& name : site.functions) {
+        if (name == function) return &site;
+      }
+    }
+    return nullptr;
+  }
+
+  int chunks() const { return chunks_; }
+
+ private:
+  std::map<unsigned, std::string> functions_;
+  std::map<unsigned, Site> sites_;
+  int chunks_ = 0;
+};
+
+}  // namespace
+
+TEST(SamplingHeapProfilerAggregateStacks) {
+  v8::HandleScope scope(v8::Isolate::GetCurrent());
+  LocalContext env;
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+
+  // Turn off always_opt. Inlining can cause stack traces to be shorter than
+  // what we expect in this test.
+  v8::internal::FLAG_always_opt = false;
+
+  // Suppress randomness to avoid flakiness in tests.
+  v8::internal::FLAG_sampling_heap_profiler_suppress_randomness = true;
+
+  SampledAllocationsCollector collector;
+  CHECK(!heap_profiler->CollectSampledAllocations(&collector));
+
+  heap_profiler->StartSamplingHeapProfiler(
+      64, 16, v8::HeapProfiler::kSamplingAggregateStacks);
+  CHECK_NULL(heap_profiler->GetAllocationProfile());
+
+  CompileRun(
+      "function Point(x) { this.x = x; }\n"
+      "var points = [];\n"
+      "function makePoints() {\n"
+      "  for (var i = 0; i < 4096; i++) points.push(new Point(i));\n"
+      "}\n"
+      "makePoints();");
+
+  CHECK(heap_profiler->CollectSampledAllocations(&collector));
+  CHECK_EQ(1, collector.chunks());
+  const SampledAllocationsCollector::Site* site =
+      collector.FindSite("makePoints", "Point");
+  CHECK(site);
+  CHECK_GT(site->allocated_count, 0);
+  CHECK_EQ(site->allocated_count, site->live_count);
+
+  // The samples are still counted once the objects are dead.
+  CompileRun("points = null;");
+  CcTest::CollectAllGarbage();
+  CHECK(heap_profiler->CollectSampledAllocations(&collector));
+  site = collector.FindSite("makePoints", "Point");
+  CHECK(site);
+  CHECK_GT(site->allocated_count, 0);
+  CHECK_EQ(0, site->live_count);
+
+  heap_profiler->StopSamplingHeapProfiler();
+  CHECK(!heap_profiler->CollectSampledAllocations(&collector));
+}
+
 TEST(WeakReference) {
   v8::Isolate* isolate = CcTest::isolate();
   i::Isolate* i_isolate = CcTest::i_isolate();
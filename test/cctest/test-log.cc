@@ -34,6 +34,7 @@
 #include <cmath>
 #endif  // __linux__
 
+#include <sstream>
 #include <unordered_set>
 #include <vector>
 #include "src/api-inl.h"
@@ -96,6 +97,78 @@ static const char* FindLogLine(const char* start, const char* end,
   return NULL;
 }
 
+// Decodes a log written with --log-binary into the text log, see
+// BinaryLogDecoder in tools/logreader.js.
+std::string DecodeBinaryLog(const std::string& log) {
+  typedef i::BinaryLogStreamBuffer Buffer;
+  size_t pos = strlen(Buffer::kMagic);
+  CHECK_EQ(0, log.compare(0, pos, Buffer::kMagic));
+  auto read_varint = [&log, &pos]() {
+    uint64_t result = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      CHECK_LT(pos, log.size());
+      byte = static_cast<uint8_t>(log[pos++]);
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return result;
+  };
+  auto read_zigzag = [&read_varint]() {
+    uint64_t value = read_varint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  };
+  auto read_string = [&log, &pos, &read_varint]() {
+    size_t length = static_cast<size_t>(read_varint());
+    CHECK_LE(pos + length, log.size());
+    std::string string = log.substr(pos, length);
+    pos += length;
+    return string;
+  };
+  CHECK_EQ(Buffer::kVersion, read_varint());
+
+  std::vector<std::string> strings;
+  uint64_t address = 0;
+  std::ostringstream text;
+  bool first_field = true;
+  while (pos < log.size()) {
+    uint8_t tag = static_cast<uint8_t>(log[pos++]);
+    if (tag == Buffer::kEndOfRecord) {
+      text << '\n';
+      first_field = true;
+      continue;
+    }
+    if (!first_field) text << ',';
+    first_field = false;
+    switch (tag) {
+      case Buffer::kNewString:
+        strings.push_back(read_string());
+        text << strings.back();
+        break;
+      case Buffer::kString: {
+        uint64_t id = read_varint();
+        CHECK_LT(id, strings.size());
+        text << strings[id];
+        break;
+      }
+      case Buffer::kLiteralString:
+        text << read_string();
+        break;
+      case Buffer::kInteger:
+        text << read_zigzag();
+        break;
+      case Buffer::kAddress:
+        address += read_zigzag();
+        text << "0x" << std::hex << address << std::dec;
+        break;
+      default:
+        FATAL("Invalid field tag %d", tag);
+    }
+  }
+  return text.str();
+}
+
 class ScopedLoggerInitializer {
  public:
   ScopedLoggerInitializer(bool saved_log, bool saved_prof, v8::Isolate* isolate)
@@ -159,8 +232,14 @@ class ScopedLoggerInitializer {
     bool exists = false;
     log_ = i::ReadFile(StopLoggingGetTempFile(), &exists, true);
     CHECK(exists);
+    raw_log_size_ = log_.size();
+    if (i::FLAG_log_binary) log_ = DecodeBinaryLog(log_);
   }
 
+  // The size of the log file, which differs from the size of the text log
+  // with --log-binary.
+  size_t raw_log_size() const { return raw_log_size_; }
+
   const char* GetEndPosition() { return log_.c_str() + log_.size(); }
 
   const char* FindLine(const char* prefix, const char* suffix = nullptr,
@@ -207,6 +286,28 @@ class ScopedLoggerInitializer {
     }
   }
 
+  // Whether there is a code-creation event with the {tag} for the code at
+  // {address} whose name contains {name}.
+  bool FindCodeCreation(const char* tag, i::Address address,
+                        const char* name) {
+    // Make sure that StopLogging() has been called before.
+    CHECK(log_.size());
+    std::string prefix = std::string("code-creation,") + tag + ",";
+    i::EmbeddedVector<char, 32> address_field;
+    i::SNPrintF(address_field, ",0x%" V8PRIxPTR ",", address);
+    size_t position = 0;
+    while ((position = log_.find(prefix, position)) != std::string::npos) {
+      std::string line =
+          log_.substr(position, log_.find('\n', position) - position);
+      if (line.find(address_field.start()) != std::string::npos &&
+          line.find(name) != std::string::npos) {
+        return true;
+      }
+      position += prefix.size();
+    }
+    return false;
+  }
+
   void LogCompiledFunctions() { logger_->LogCompiledFunctions(); }
 
   void StringEvent(const char* name, const char* value) {
@@ -255,6 +356,7 @@ class ScopedLoggerInitializer {
   v8::Local<v8::Context> env_;
   Logger* logger_;
   std::string log_;
+  size_t raw_log_size_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(ScopedLoggerInitializer);
 };
@@ -838,6 +940,42 @@ TEST(LogAll) {
   isolate->Dispose();
 }
 
+TEST(LogBinary) {
+  SETUP_FLAGS();
+  const char* source_text =
+      "function testAddFn(a,b) { return a + b };"
+      "let result;"
+      "for (let i = 0; i < 100000; i++) { result = testAddFn(i, i); };";
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+
+  size_t log_sizes[2];
+  for (int binary = 0; binary < 2; binary++) {
+    i::FLAG_log_binary = binary;
+    v8::Isolate* isolate = v8::Isolate::New(create_params);
+    {
+      ScopedLoggerInitializer logger(saved_log, saved_prof, isolate);
+      CompileRun(source_text);
+      logger.StopLogging();
+
+      // The binary log decodes to the same lines as the text log.
+      i::EmbeddedVector<char, 100> ref_data;
+      i::SNPrintF(ref_data, "%d,%d,%d,%d,%d", i::Version::GetMajor(),
+                  i::Version::GetMinor(), i::Version::GetBuild(),
+                  i::Version::GetPatch(), i::Version::IsCandidate());
+      CHECK(logger.FindLine("v8-version,", ref_data.start()));
+      CHECK(logger.FindLine("code-creation,Script", ":1:1"));
+      CHECK(logger.FindLine("code-creation,LazyCompile,", "testAddFn"));
+      std::unordered_set<uintptr_t> code_addresses;
+      logger.ExtractAllAddresses(&code_addresses, "code-creation", 4);
+      CHECK(!code_addresses.empty());
+      log_sizes[binary] = logger.raw_log_size();
+    }
+    isolate->Dispose();
+  }
+  CHECK_LT(log_sizes[1], log_sizes[0]);
+}
+
 TEST(LogInterpretedFramesNativeStack) {
   SETUP_FLAGS();
   i::FLAG_interpreted_frames_native_stack = true;
@@ -861,6 +999,120 @@ TEST(LogInterpretedFramesNativeStack) {
   isolate->Dispose();
 }
 
+TEST(LogInterpretedFramesNativeStackSymbolization) {
+  SETUP_FLAGS();
+  i::FLAG_interpreted_frames_native_stack = true;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  {
+    ScopedLoggerInitializer logger(saved_log, saved_prof, isolate);
+
+    const char* source_text =
+        "function testSymbolizationFoo(a, b) { return a + b };"
+        "function testSymbolizationBar(a, b) { return a * b };"
+        "testSymbolizationFoo(1, 2);"
+        "testSymbolizationBar(1, 2);";
+    CompileRun(source_text);
+    i::Handle<i::JSFunction> foo = i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("testSymbolizationFoo")));
+    i::Handle<i::JSFunction> bar = i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("testSymbolizationBar")));
+
+    logger.StopLogging();
+
+    // Each function runs on its own copy of the trampoline, and the copy is
+    // logged under the name of the function, so that native profilers can
+    // attribute their samples.
+    i::Code* foo_code = foo->shared()->GetCode();
+    i::Code* bar_code = bar->shared()->GetCode();
+    i::Code* trampoline = logger.i_isolate()->builtins()->builtin(
+        i::Builtins::kInterpreterEntryTrampoline);
+    CHECK(foo_code->is_interpreter_trampoline_builtin());
+    CHECK(bar_code->is_interpreter_trampoline_builtin());
+    CHECK_NE(foo_code, trampoline);
+    CHECK_NE(bar_code, trampoline);
+    CHECK_NE(foo_code, bar_code);
+    CHECK(logger.FindCodeCreation("InterpretedFunction",
+                                  foo_code->InstructionStart(),
+                                  "testSymbolizationFoo"));
+    CHECK(logger.FindCodeCreation("InterpretedFunction",
+                                  bar_code->InstructionStart(),
+                                  "testSymbolizationBar"));
+    CHECK(!logger.FindCodeCreation("InterpretedFunction",
+                                   foo_code->InstructionStart(),
+                                   "testSymbolizationBar"));
+  }
+  isolate->Dispose();
+}
+
+TEST(PerfBasicProfInterpretedFramesNativeStack) {
+  i::FLAG_interpreted_frames_native_stack = true;
+  i::FLAG_perf_basic_prof = true;
+  i::FLAG_perf_basic_prof_only_functions = true;
+  // Keep the code where the perf map says it is.
+  i::FLAG_compact_code_space = false;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = v8::Isolate::New(create_params);
+
+  uintptr_t foo_address;
+  uintptr_t bar_address;
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    v8::HandleScope scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope context_scope(context);
+
+    CompileRun(
+        "function testPerfMapFoo(a, b) { return a + b };"
+        "function testPerfMapBar(a, b) { return a * b };"
+        "testPerfMapFoo(1, 2);"
+        "testPerfMapBar(1, 2);");
+    i::Handle<i::JSFunction> foo = i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("testPerfMapFoo")));
+    i::Handle<i::JSFunction> bar = i::Handle<i::JSFunction>::cast(
+        v8::Utils::OpenHandle(*CompileRun("testPerfMapBar")));
+    CHECK(foo->shared()->GetCode()->is_interpreter_trampoline_builtin());
+    CHECK(bar->shared()->GetCode()->is_interpreter_trampoline_builtin());
+    foo_address = foo->shared()->GetCode()->InstructionStart();
+    bar_address = bar->shared()->GetCode()->InstructionStart();
+    CHECK_NE(foo_address, bar_address);
+  }
+  // Disposing the isolate closes the perf map.
+  isolate->Dispose();
+
+  i::EmbeddedVector<char, 64> map_name;
+  i::SNPrintF(map_name, "/tmp/perf-%d.map",
+              v8::base::OS::GetCurrentProcessId());
+  bool exists = false;
+  std::string map = i::ReadFile(map_name.start(), &exists);
+  CHECK(exists);
+  remove(map_name.start());
+
+  // Linux perf symbolizes a sample by the line whose range contains it, the
+  // lines are "<hex start> <hex size> <name>". Each trampoline copy has a
+  // line under the name of its function, even with
+  // --perf-basic-prof-only-functions.
+  auto find_line = [&map](uintptr_t address, const char* name) {
+    i::EmbeddedVector<char, 32> prefix;
+    i::SNPrintF(prefix, "%" V8PRIxPTR " ", address);
+    std::istringstream lines(map);
+    std::string line;
+    while (std::getline(lines, line)) {
+      if (line.compare(0, strlen(prefix.start()), prefix.start()) == 0 &&
+          line.find(name) != std::string::npos) {
+        return true;
+      }
+    }
+    return false;
+  };
+  CHECK(find_line(foo_address, "testPerfMapFoo"));
+  CHECK(find_line(bar_address, "testPerfMapBar"));
+  CHECK(!find_line(foo_address, "testPerfMapBar"));
+}
+
 TEST(ExternalCodeEventListener) {
   i::FLAG_log = false;
   i::FLAG_prof = false;
@@ -502,7 +502,7 @@ TEST(OrderedHashTableInsertion) {
 
   Handle<OrderedHashMap> map = factory->NewOrderedHashMap();
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
 
   // Add a new key.
@@ -511,14 +511,14 @@ TEST(OrderedHashTableInsertion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
   map = OrderedHashMap::Add(isolate, map, key1, value1);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
 
   // Add existing key.
   map = OrderedHashMap::Add(isolate, map, key1, value1);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
 
@@ -527,14 +527,14 @@ TEST(OrderedHashTableInsertion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key2));
   map = OrderedHashMap::Add(isolate, map, key2, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(2, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
 
   map = OrderedHashMap::Add(isolate, map, key2, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(2, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -543,7 +543,7 @@ TEST(OrderedHashTableInsertion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key3));
   map = OrderedHashMap::Add(isolate, map, key3, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(3, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -551,7 +551,7 @@ TEST(OrderedHashTableInsertion) {
 
   map = OrderedHashMap::Add(isolate, map, key3, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(3, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -561,7 +561,7 @@ TEST(OrderedHashTableInsertion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key4));
   map = OrderedHashMap::Add(isolate, map, key4, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(4, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -570,7 +570,7 @@ TEST(OrderedHashTableInsertion) {
 
   map = OrderedHashMap::Add(isolate, map, key4, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(4, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -589,7 +589,7 @@ TEST(OrderedHashMapDuplicateHashCode) {
   Handle<JSObject> value = factory->NewJSObjectWithNullProto();
   map = OrderedHashMap::Add(isolate, map, key1, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
 
@@ -598,7 +598,7 @@ TEST(OrderedHashMapDuplicateHashCode) {
 
   map = OrderedHashMap::Add(isolate, map, key2, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(2, map->NumberOfElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -614,7 +614,7 @@ TEST(OrderedHashMapDeletion) {
 
   Handle<OrderedHashMap> map = factory->NewOrderedHashMap();
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
 
@@ -622,14 +622,14 @@ TEST(OrderedHashMapDeletion) {
   Handle<Smi> key1(Smi::FromInt(1), isolate);
   CHECK(!OrderedHashMap::Delete(isolate, *map, *key1));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
 
   map = OrderedHashMap::Add(isolate, map, key1, value1);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -637,14 +637,14 @@ TEST(OrderedHashMapDeletion) {
   // Delete single existing key
   CHECK(OrderedHashMap::Delete(isolate, *map, *key1));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
   CHECK_EQ(1, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
 
   map = OrderedHashMap::Add(isolate, map, key1, value1);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(1, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -653,7 +653,7 @@ TEST(OrderedHashMapDeletion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key2));
   map = OrderedHashMap::Add(isolate, map, key2, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(2, map->NumberOfElements());
   CHECK_EQ(1, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key2));
@@ -662,7 +662,7 @@ TEST(OrderedHashMapDeletion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key3));
   map = OrderedHashMap::Add(isolate, map, key3, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(3, map->NumberOfElements());
   CHECK_EQ(1, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -672,7 +672,7 @@ TEST(OrderedHashMapDeletion) {
   // Delete multiple existing keys
   CHECK(OrderedHashMap::Delete(isolate, *map, *key1));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(2, map->NumberOfElements());
   CHECK_EQ(2, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -681,7 +681,7 @@ TEST(OrderedHashMapDeletion) {
 
   CHECK(OrderedHashMap::Delete(isolate, *map, *key2));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(3, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -690,7 +690,7 @@ TEST(OrderedHashMapDeletion) {
 
   CHECK(OrderedHashMap::Delete(isolate, *map, *key3));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
   CHECK_EQ(4, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -700,7 +700,7 @@ TEST(OrderedHashMapDeletion) {
   // Delete non existent key from non new hash table
   CHECK(!OrderedHashMap::Delete(isolate, *map, *key3));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(0, map->NumberOfElements());
   CHECK_EQ(4, map->NumberOfDeletedElements());
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -711,7 +711,7 @@ TEST(OrderedHashMapDeletion) {
   map = OrderedHashMap::Shrink(isolate, map);
   map = OrderedHashMap::Add(isolate, map, key1, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -719,7 +719,7 @@ TEST(OrderedHashMapDeletion) {
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key3));
   CHECK(!OrderedHashMap::Delete(isolate, *map, *key2));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -860,7 +860,7 @@ TEST(OrderedHashMapDuplicateHashCodeDeletion) {
   Handle<JSObject> value = factory->NewJSObjectWithNullProto();
   map = OrderedHashMap::Add(isolate, map, key1, value);
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
@@ -871,13 +871,101 @@ TEST(OrderedHashMapDuplicateHashCodeDeletion) {
   // We shouldn't be able to delete the key!
   CHECK(!OrderedHashMap::Delete(isolate, *map, *key2));
   Verify(isolate, map);
-  CHECK_EQ(2, map->NumberOfBuckets());
+  CHECK_EQ(8, map->NumberOfBuckets());
   CHECK_EQ(1, map->NumberOfElements());
   CHECK_EQ(0, map->NumberOfDeletedElements());
   CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
   CHECK(!OrderedHashMap::HasKey(isolate, *map, *key2));
 }
 
+TEST(OrderedHashMapProbingPastDeletedEntries) {
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  Factory* factory = isolate->factory();
+  HandleScope scope(isolate);
+
+  // All keys share a hash code, so they occupy consecutive buckets.
+  Handle<OrderedHashMap> map = factory->NewOrderedHashMap();
+  Handle<JSObject> value = factory->NewJSObjectWithNullProto();
+  Handle<JSObject> key1 = factory->NewJSObjectWithNullProto();
+  map = OrderedHashMap::Add(isolate, map, key1, value);
+  Handle<JSObject> key2 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key2);
+  map = OrderedHashMap::Add(isolate, map, key2, value);
+  Handle<JSObject> key3 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key3);
+  map = OrderedHashMap::Add(isolate, map, key3, value);
+  Verify(isolate, map);
+  CHECK_EQ(8, map->NumberOfBuckets());
+  CHECK_EQ(3, map->NumberOfElements());
+
+  // The bucket of a deleted entry stays in use, so the keys after it in the
+  // probe sequence can still be found.
+  CHECK(OrderedHashMap::Delete(isolate, *map, *key2));
+  Verify(isolate, map);
+  CHECK_EQ(2, map->NumberOfElements());
+  CHECK_EQ(1, map->NumberOfDeletedElements());
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
+  CHECK(!OrderedHashMap::HasKey(isolate, *map, *key2));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key3));
+
+  Handle<JSObject> key4 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key4);
+  map = OrderedHashMap::Add(isolate, map, key4, value);
+  Verify(isolate, map);
+  CHECK_EQ(8, map->NumberOfBuckets());
+  CHECK_EQ(3, map->NumberOfElements());
+  CHECK_EQ(1, map->NumberOfDeletedElements());
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key4));
+
+  // Three quarters of the buckets can be used, the table is full after two
+  // more keys.
+  Handle<JSObject> key5 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key5);
+  map = OrderedHashMap::Add(isolate, map, key5, value);
+  Handle<JSObject> key6 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key6);
+  map = OrderedHashMap::Add(isolate, map, key6, value);
+  Verify(isolate, map);
+  CHECK_EQ(8, map->NumberOfBuckets());
+  CHECK_EQ(5, map->NumberOfElements());
+  CHECK_EQ(1, map->NumberOfDeletedElements());
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key6));
+
+  // Growing the table drops the deleted entry.
+  Handle<JSObject> key7 = factory->NewJSObjectWithNullProto();
+  CopyHashCode(key1, key7);
+  map = OrderedHashMap::Add(isolate, map, key7, value);
+  Verify(isolate, map);
+  CHECK_EQ(16, map->NumberOfBuckets());
+  CHECK_EQ(6, map->NumberOfElements());
+  CHECK_EQ(0, map->NumberOfDeletedElements());
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key1));
+  CHECK(!OrderedHashMap::HasKey(isolate, *map, *key2));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key3));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key4));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key5));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key6));
+  CHECK(OrderedHashMap::HasKey(isolate, *map, *key7));
+}
+
+TEST(OrderedHashTableCapacity) {
+  LocalContext context;
+  Isolate* isolate = GetIsolateFrom(&context);
+  HandleScope scope(isolate);
+
+  // At most three quarters of the buckets are in use.
+  for (int capacity = 1; capacity <= 1024; capacity++) {
+    Handle<OrderedHashMap> map = OrderedHashMap::Allocate(isolate, capacity);
+    int buckets = map->NumberOfBuckets();
+    CHECK(base::bits::IsPowerOfTwo(buckets));
+    CHECK_LE(4 * capacity, 3 * buckets);
+    CHECK_EQ(OrderedHashMap::kHashTableStartIndex + buckets +
+                 (buckets - buckets / 4) * OrderedHashMap::kEntrySize,
+             map->length());
+  }
+}
+
 TEST(SmallOrderedHashMapDuplicateHashCodeDeletion) {
   LocalContext context;
   Isolate* isolate = GetIsolateFrom(&context);
@@ -915,7 +1003,7 @@ TEST(OrderedHashSetDeletion) {
 
   Handle<OrderedHashSet> set = factory->NewOrderedHashSet();
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(0, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
 
@@ -923,14 +1011,14 @@ TEST(OrderedHashSetDeletion) {
   Handle<Smi> key1(Smi::FromInt(1), isolate);
   CHECK(!OrderedHashSet::Delete(isolate, *set, *key1));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(0, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
 
   set = OrderedHashSet::Add(isolate, set, key1);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -938,14 +1026,14 @@ TEST(OrderedHashSetDeletion) {
   // Delete single existing key
   CHECK(OrderedHashSet::Delete(isolate, *set, *key1));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(0, set->NumberOfElements());
   CHECK_EQ(1, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
 
   set = OrderedHashSet::Add(isolate, set, key1);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(1, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -954,7 +1042,7 @@ TEST(OrderedHashSetDeletion) {
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key2));
   set = OrderedHashSet::Add(isolate, set, key2);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(2, set->NumberOfElements());
   CHECK_EQ(1, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key2));
@@ -963,7 +1051,7 @@ TEST(OrderedHashSetDeletion) {
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key3));
   set = OrderedHashSet::Add(isolate, set, key3);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(3, set->NumberOfElements());
   CHECK_EQ(1, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -973,7 +1061,7 @@ TEST(OrderedHashSetDeletion) {
   // Delete multiple existing keys
   CHECK(OrderedHashSet::Delete(isolate, *set, *key1));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(2, set->NumberOfElements());
   CHECK_EQ(2, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -982,7 +1070,7 @@ TEST(OrderedHashSetDeletion) {
 
   CHECK(OrderedHashSet::Delete(isolate, *set, *key2));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(3, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -991,7 +1079,7 @@ TEST(OrderedHashSetDeletion) {
 
   CHECK(OrderedHashSet::Delete(isolate, *set, *key3));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(0, set->NumberOfElements());
   CHECK_EQ(4, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -1001,7 +1089,7 @@ TEST(OrderedHashSetDeletion) {
   // Delete non existent key from non new hash table
   CHECK(!OrderedHashSet::Delete(isolate, *set, *key3));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(0, set->NumberOfElements());
   CHECK_EQ(4, set->NumberOfDeletedElements());
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -1012,7 +1100,7 @@ TEST(OrderedHashSetDeletion) {
   set = OrderedHashSet::Shrink(isolate, set);
   set = OrderedHashSet::Add(isolate, set, key1);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -1020,7 +1108,7 @@ TEST(OrderedHashSetDeletion) {
   CHECK(!OrderedHashSet::HasKey(isolate, *set, *key3));
   CHECK(!OrderedHashSet::Delete(isolate, *set, *key2));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -1158,7 +1246,7 @@ TEST(OrderedHashSetDuplicateHashCodeDeletion) {
   Handle<JSObject> key1 = factory->NewJSObjectWithNullProto();
   set = OrderedHashSet::Add(isolate, set, key1);
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
@@ -1169,7 +1257,7 @@ TEST(OrderedHashSetDuplicateHashCodeDeletion) {
   // We shouldn't be able to delete the key!
   CHECK(!OrderedHashSet::Delete(isolate, *set, *key2));
   Verify(isolate, set);
-  CHECK_EQ(2, set->NumberOfBuckets());
+  CHECK_EQ(8, set->NumberOfBuckets());
   CHECK_EQ(1, set->NumberOfElements());
   CHECK_EQ(0, set->NumberOfDeletedElements());
   CHECK(OrderedHashSet::HasKey(isolate, *set, *key1));
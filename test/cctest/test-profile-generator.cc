@@ -29,6 +29,8 @@
 
 #include "include/v8-profiler.h"
 #include "src/api-inl.h"
+#include "src/base/platform/elapsed-timer.h"
+#include "src/base/utils/random-number-generator.h"
 #include "src/objects-inl.h"
 #include "src/profiler/cpu-profiler.h"
 #include "src/profiler/profile-generator-inl.h"
@@ -354,6 +356,127 @@ TEST(CodeMapMoveAndDeleteCode) {
   CHECK_EQ(entry3, code_map.FindEntry(ToAddress(0x1750)));
 }
 
+TEST(CodeMapManyEntries) {
+  // Enough entries to merge the pending updates into the main index several
+  // times, so that lookups and moves go through both of them.
+  const int kEntries = 4 * static_cast<int>(CodeMap::kMinPendingUpdates);
+  const int kSize = 0x40;
+  CodeMap code_map;
+  std::vector<CodeEntry*> entries;
+  for (int i = 0; i < kEntries; i++) {
+    CodeEntry* entry =
+        new CodeEntry(i::CodeEventListener::FUNCTION_TAG, "function");
+    entries.push_back(entry);
+    // Interleave the addresses so that insertions don't only append.
+    int slot = (i % 2) ? kEntries - i : i;
+    code_map.AddCode(ToAddress(0x10000 + slot * 2 * kSize), entry, kSize);
+  }
+  for (int i = 0; i < kEntries; i++) {
+    int slot = (i % 2) ? kEntries - i : i;
+    i::Address start = ToAddress(0x10000 + slot * 2 * kSize);
+    CHECK_EQ(entries[i], code_map.FindEntry(start));
+    CHECK_EQ(entries[i], code_map.FindEntry(start + kSize - 1));
+    CHECK(!code_map.FindEntry(start + kSize));
+  }
+
+  // Move every third entry into the gap after it, looking it up before the
+  // move so that the result is cached.
+  for (int i = 0; i < kEntries; i += 3) {
+    int slot = (i % 2) ? kEntries - i : i;
+    i::Address from = ToAddress(0x10000 + slot * 2 * kSize);
+    CHECK_EQ(entries[i], code_map.FindEntry(from));
+    code_map.MoveCode(from, from + kSize);
+    CHECK(!code_map.FindEntry(from));
+    CHECK_EQ(entries[i], code_map.FindEntry(from + kSize));
+  }
+
+  // Code added over a moved entry replaces it.
+  CodeEntry* entry = new CodeEntry(i::CodeEventListener::FUNCTION_TAG, "new");
+  code_map.AddCode(ToAddress(0x10000 + kSize / 2), entry, kSize);
+  CHECK(!code_map.FindEntry(ToAddress(0x10000)));
+  CHECK_EQ(entry, code_map.FindEntry(ToAddress(0x10000 + kSize)));
+  CHECK_EQ(entry, code_map.FindEntry(ToAddress(0x10000 + kSize * 3 / 2 - 1)));
+  CHECK(!code_map.FindEntry(ToAddress(0x10000 + kSize * 3 / 2)));
+
+  for (int i = 1; i < kEntries; i++) {
+    int slot = (i % 2) ? kEntries - i : i;
+    i::Address start = ToAddress(0x10000 + slot * 2 * kSize);
+    if (i % 3 == 0) {
+      CHECK(!code_map.FindEntry(start));
+      CHECK_EQ(entries[i], code_map.FindEntry(start + kSize));
+    } else {
+      CHECK_EQ(entries[i], code_map.FindEntry(start));
+      CHECK(!code_map.FindEntry(start + kSize));
+    }
+  }
+}
+
+TEST(CodeMapSymbolizationThroughput) {
+  // Symbolizes deep stacks the way the profiler does for every tick, with
+  // code moves mixed in as during heap compaction, and prints the time per
+  // frame. The stacks are drawn from a hot set of functions, so that the
+  // lookup cache hits as often as for a real profile.
+  const int kEntries = 20000;
+  const int kHotEntries = 500;
+  const int kStacks = 256;
+  const int kStackDepth = 32;
+  const int kTicks = 20000;
+  const int kTicksPerMove = 16;
+  v8::base::RandomNumberGenerator rng(42);
+  CodeMap code_map;
+  std::vector<i::Address> starts;
+  std::vector<int> sizes;
+  i::Address next_address = ToAddress(0x100000);
+  for (int i = 0; i < kEntries; i++) {
+    int size = 0x40 + rng.NextInt(0x400);
+    code_map.AddCode(next_address,
+                     new CodeEntry(i::CodeEventListener::FUNCTION_TAG, "f"),
+                     size);
+    starts.push_back(next_address);
+    sizes.push_back(size);
+    next_address += size + rng.NextInt(0x40);
+  }
+
+  // The frames of each stack, as an entry and an offset into its code.
+  std::vector<std::pair<int, int>> stacks;
+  for (int i = 0; i < kStacks * kStackDepth; i++) {
+    int index =
+        rng.NextInt(10) ? rng.NextInt(kHotEntries) : rng.NextInt(kEntries);
+    stacks.push_back(std::make_pair(index, rng.NextInt(sizes[index])));
+  }
+  std::vector<int> tick_stacks;
+  std::vector<int> moved_entries;
+  for (int i = 0; i < kTicks; i++) {
+    tick_stacks.push_back(rng.NextInt(kStacks));
+    moved_entries.push_back(rng.NextInt(kEntries));
+  }
+
+  int found = 0;
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  for (int tick = 0; tick < kTicks; tick++) {
+    if (tick % kTicksPerMove == 0) {
+      // Move the code to fresh addresses, so that it never overlaps.
+      int index = moved_entries[tick];
+      code_map.MoveCode(starts[index], next_address);
+      starts[index] = next_address;
+      next_address += sizes[index];
+    }
+    const std::pair<int, int>* frames =
+        &stacks[tick_stacks[tick] * kStackDepth];
+    for (int i = 0; i < kStackDepth; i++) {
+      if (code_map.FindEntry(starts[frames[i].first] + frames[i].second)) {
+        found++;
+      }
+    }
+  }
+  double elapsed_ns = timer.Elapsed().InMicroseconds() * 1000.0;
+  CHECK_EQ(kTicks * kStackDepth, found);
+  printf("CodeMap(FramesPerSecond): %.0f\n",
+         found / std::max(elapsed_ns, 1.0) * 1e9);
+  printf("CodeMap(NanosecondsPerFrame): %.1f\n", elapsed_ns / found);
+}
+
 namespace {
 
 class TestSetup {
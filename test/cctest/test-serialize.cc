@@ -3028,6 +3028,104 @@ TEST(SnapshotCreatorTemplates) {
   delete[] blob.data;
 }
 
+// Mirrors the Worker constructor of d8, which keeps a raw pointer to its
+// thread in the only internal field.
+static int shell_worker_thread = 0;
+
+static void ShellWorkerNew(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  args.Holder()->SetAlignedPointerInInternalField(0, &shell_worker_thread);
+}
+
+static void ShellWorkerAlive(const v8::FunctionCallbackInfo<v8::Value>& args) {
+  args.GetReturnValue().Set(
+      args.Holder()->GetAlignedPointerFromInternalField(0) != nullptr);
+}
+
+intptr_t shell_external_references[] = {
+    reinterpret_cast<intptr_t>(SerializedCallback),
+    reinterpret_cast<intptr_t>(ShellWorkerNew),
+    reinterpret_cast<intptr_t>(ShellWorkerAlive), 0};
+
+static v8::StartupData SerializeShellWorkerField(v8::Local<v8::Object> holder,
+                                                 int index, void* data) {
+  return {nullptr, 0};
+}
+
+static void DeserializeShellWorkerField(v8::Local<v8::Object> holder,
+                                        int index, v8::StartupData payload,
+                                        void* data) {
+  CHECK_EQ(0, payload.raw_size);
+  holder->SetAlignedPointerInInternalField(index, nullptr);
+}
+
+// The d8 startup snapshot: a context with the shell globals and the state
+// that the scripts left behind, with the pointers of live Workers cleared.
+TEST(SnapshotCreatorShellContext) {
+  DisableAlwaysOpt();
+  v8::StartupData blob;
+  {
+    v8::SnapshotCreator creator(shell_external_references);
+    v8::Isolate* isolate = creator.GetIsolate();
+    {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::ObjectTemplate> global_template =
+          v8::ObjectTemplate::New(isolate);
+      global_template->Set(
+          v8_str("print"),
+          v8::FunctionTemplate::New(isolate, SerializedCallback));
+      v8::Local<v8::FunctionTemplate> worker_template =
+          v8::FunctionTemplate::New(isolate, ShellWorkerNew);
+      worker_template->PrototypeTemplate()->Set(
+          v8_str("alive"),
+          v8::FunctionTemplate::New(isolate, ShellWorkerAlive));
+      worker_template->InstanceTemplate()->SetInternalFieldCount(1);
+      global_template->Set(v8_str("Worker"), worker_template);
+      creator.SetDefaultContext(v8::Context::New(isolate));
+
+      v8::Local<v8::Context> context =
+          v8::Context::New(isolate, nullptr, global_template);
+      v8::Context::Scope context_scope(context);
+      CompileRun(
+          "var counter = 3;"
+          "function bump() { return ++counter; }"
+          "var worker = new Worker();");
+      ExpectTrue("worker.alive()");
+      CHECK_EQ(0u, creator.AddContext(context,
+                                      v8::SerializeInternalFieldsCallback(
+                                          SerializeShellWorkerField)));
+    }
+    blob =
+        creator.CreateBlob(v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+  }
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &blob;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  params.external_references = shell_external_references;
+  // Test-appropriate equivalent of v8::Isolate::New.
+  v8::Isolate* isolate = TestIsolate::New(params);
+  {
+    v8::Isolate::Scope isolate_scope(isolate);
+    // Every context starts from the state of the scripts.
+    for (int i = 0; i < 2; i++) {
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> context =
+          v8::Context::FromSnapshot(isolate, 0,
+                                    v8::DeserializeInternalFieldsCallback(
+                                        DeserializeShellWorkerField))
+              .ToLocalChecked();
+      v8::Context::Scope context_scope(context);
+      ExpectInt32("print()", 42);
+      ExpectInt32("bump()", 4);
+      ExpectInt32("counter", 4);
+      ExpectFalse("worker.alive()");
+      ExpectTrue("new Worker().alive()");
+    }
+  }
+  isolate->Dispose();
+  delete[] blob.data;
+}
+
 TEST(SnapshotCreatorAddData) {
   DisableAlwaysOpt();
   v8::StartupData blob;
@@ -371,6 +371,20 @@ TEST(Strtod) {
                       "48794829220689472168983109969836584681402285424333066033"
                       "98508864458040010349339704275671864433837704860378616227"
                       "71738545623065874679014086723327636718751", -1076));
+
+  // 2^53 + 1 is exactly half-way between two doubles and must round to even.
+  // The 128-bit product cannot decide this, so Strtod falls back.
+  CHECK_EQ(9007199254740992.0, StrtodChar("9007199254740993", 0));
+  CHECK_EQ(9007199254740996.0, StrtodChar("9007199254740995", 0));
+  CHECK_EQ(9007199254740994.0, StrtodChar("90071992547409930001", -4));
+  // More than 19 digits: the truncated significand and its successor must
+  // give the same double.
+  CHECK_EQ(1.7976931348623157e308,
+           StrtodChar("17976931348623157081452742373170435679", 271));
+  CHECK_EQ(4.9406564584124654e-324,
+           StrtodChar("49406564584124654417656879286822137236505980", -367));
+  CHECK_EQ(1.2345678901234568e-300,
+           StrtodChar("12345678901234567890123", -322));
 }
 
 
@@ -449,6 +463,7 @@ static uint32_t DeterministicRandom() {
 static const int kBufferSize = 1024;
 static const int kShortStrtodRandomCount = 2;
 static const int kLargeStrtodRandomCount = 2;
+static const int kLongSignificandStrtodRandomCount = 1000;
 
 TEST(RandomStrtod) {
   v8::base::RandomNumberGenerator rng;
@@ -481,6 +496,28 @@ TEST(RandomStrtod) {
   }
 }
 
+
+// Significands of 16 to 20 digits are what most serialized doubles look like,
+// and take the Eisel-Lemire path unless the result is ambiguous.
+TEST(RandomStrtodLongSignificands) {
+  v8::base::RandomNumberGenerator rng;
+  char buffer[kBufferSize];
+  for (int length = 16; length <= 20; length++) {
+    for (int i = 0; i < kLongSignificandStrtodRandomCount; ++i) {
+      int pos = 0;
+      buffer[pos++] = rng.NextInt(9) + '1';
+      for (int j = 1; j < length; ++j) {
+        buffer[pos++] = rng.NextInt(10) + '0';
+      }
+      int exponent = DeterministicRandom() % (330 * 2 + 1) - 330 - length + 1;
+      buffer[pos] = '\0';
+      Vector<const char> vector(buffer, pos);
+      double strtod_result = Strtod(vector, exponent);
+      CHECK(CheckDouble(vector, exponent, strtod_result));
+    }
+  }
+}
+
 }  // namespace test_strtod
 }  // namespace internal
 }  // namespace v8
@@ -0,0 +1,59 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// ICU collators and formatters are cached per isolate. Objects created for
+// the same locale with different options must not share settings.
+
+// Number formats.
+for (var i = 0; i < 3; i++) {
+  assertEquals("1.234,5", (1234.5).toLocaleString("de-DE"));
+  assertEquals("1234,5", (1234.5).toLocaleString("de-DE",
+                                                 {useGrouping: false}));
+  assertEquals("1.234,50", (1234.5).toLocaleString("de-DE",
+                                                   {minimumFractionDigits: 2}));
+  assertEquals("1,234.5", (1234.5).toLocaleString("en-US"));
+  assertEquals("50%", (0.5).toLocaleString("en-US", {style: "percent"}));
+  assertEquals(
+      new Intl.NumberFormat("en-US", {style: "currency", currency: "EUR"})
+          .format(1),
+      (1).toLocaleString("en-US", {style: "currency", currency: "EUR"}));
+  assertFalse((1).toLocaleString("en-US", {style: "currency", currency: "EUR"})
+                  === (1).toLocaleString("en-US",
+                                         {style: "currency", currency: "USD"}));
+}
+
+var nf = new Intl.NumberFormat("en-US", {maximumSignificantDigits: 2});
+assertEquals(2, nf.resolvedOptions().maximumSignificantDigits);
+assertEquals("1,200", nf.format(1234));
+assertEquals("1,234", new Intl.NumberFormat("en-US").format(1234));
+
+// Collators. Collators with different attributes share the cached ICU
+// collator of their locale.
+for (var i = 0; i < 3; i++) {
+  assertEquals(0, new Intl.Collator("en", {sensitivity: "base"})
+                      .compare("a", "A"));
+  assertEquals(-1, new Intl.Collator("en").compare("a", "A"));
+  assertEquals(0, "a".localeCompare("A", "en", {sensitivity: "base"}));
+  assertEquals(-1, "a".localeCompare("A", "en"));
+  assertEquals(-1, "2".localeCompare("10", "en", {numeric: true}));
+  assertEquals(1, "2".localeCompare("10", "en"));
+}
+assertEquals("base", new Intl.Collator("en", {sensitivity: "base"})
+                         .resolvedOptions().sensitivity);
+assertEquals("variant", new Intl.Collator("en").resolvedOptions().sensitivity);
+
+// Date formats. Formats for different time zones must not be shared.
+var date = new Date(Date.UTC(2018, 0, 1, 12));
+for (var i = 0; i < 3; i++) {
+  var utc = date.toLocaleString("en-US", {timeZone: "UTC"});
+  var tokyo = date.toLocaleString("en-US", {timeZone: "Asia/Tokyo"});
+  assertTrue(utc.indexOf("12:00:00") != -1);
+  assertTrue(tokyo.indexOf("9:00:00") != -1);
+  assertEquals("UTC", new Intl.DateTimeFormat("en-US", {timeZone: "UTC"})
+                          .resolvedOptions().timeZone);
+  assertEquals("Asia/Tokyo",
+               new Intl.DateTimeFormat("en-US", {timeZone: "Asia/Tokyo"})
+                   .resolvedOptions().timeZone);
+  assertEquals("2018", date.toLocaleDateString("en-US", {year: "numeric"}));
+}
@@ -0,0 +1,82 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Awaiting values that are already native promises, which is what most
+// async code ends up doing (e.g. awaiting the result of another async
+// function).
+
+new BenchmarkSuite('AwaitResolvedPromise', [1000], [
+  new Benchmark('AwaitResolvedPromise', false, false, 0,
+                AwaitResolvedPromise, AwaitSetup),
+]);
+
+new BenchmarkSuite('AwaitAsyncFunction', [1000], [
+  new Benchmark('AwaitAsyncFunction', false, false, 0,
+                AwaitAsyncFunction, AwaitSetup),
+]);
+
+new BenchmarkSuite('AwaitPendingPromise', [1000], [
+  new Benchmark('AwaitPendingPromise', false, false, 0,
+                AwaitPendingPromise, AwaitSetup),
+]);
+
+var kIterations = 1000;
+var resolvedPromise;
+var awaitResult;
+
+async function AwaitLoop(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) sum += await resolvedPromise;
+  return sum;
+}
+
+async function Leaf(i) {
+  return i;
+}
+
+async function AwaitCalls(n) {
+  var sum = 0;
+  for (var i = 0; i < n; i++) sum += await Leaf(1);
+  return sum;
+}
+
+async function AwaitEach(promises) {
+  var sum = 0;
+  for (var i = 0; i < promises.length; i++) sum += await promises[i];
+  return sum;
+}
+
+function AwaitSetup() {
+  resolvedPromise = Promise.resolve(1);
+  %RunMicrotasks();
+}
+
+function Check(name) {
+  %RunMicrotasks();
+  if (awaitResult !== kIterations) throw new Error(name + ': wrong result');
+}
+
+function AwaitResolvedPromise() {
+  awaitResult = 0;
+  AwaitLoop(kIterations).then(sum => awaitResult = sum);
+  Check('AwaitResolvedPromise');
+}
+
+function AwaitAsyncFunction() {
+  awaitResult = 0;
+  AwaitCalls(kIterations).then(sum => awaitResult = sum);
+  Check('AwaitAsyncFunction');
+}
+
+function AwaitPendingPromise() {
+  awaitResult = 0;
+  var resolves = [];
+  var promises = [];
+  for (var i = 0; i < kIterations; i++) {
+    promises.push(new Promise(resolve => resolves.push(resolve)));
+  }
+  AwaitEach(promises).then(sum => awaitResult = sum);
+  for (var i = 0; i < kIterations; i++) resolves[i](1);
+  Check('AwaitPendingPromise');
+}
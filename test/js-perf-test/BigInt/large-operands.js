@@ -0,0 +1,57 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Multiplication, division, toString and parsing of BigInts with 1K, 16K
+// and 256K bits, to track how these operations scale with operand size.
+
+const kSizes = [1024, 16 * 1024, 256 * 1024];
+
+var seed = 42;
+function RandomBigInt(bits) {
+  let result = 1n;
+  for (let i = 32; i < bits; i += 32) {
+    seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+    result = (result << 32n) | BigInt(seed);
+  }
+  return result;
+}
+
+var x, y, product, decimal;
+
+function Setup(bits) {
+  return function() {
+    x = RandomBigInt(bits);
+    y = RandomBigInt(bits / 2);
+    product = x * y;
+    decimal = x.toString();
+  };
+}
+
+function Multiply() {
+  if (x * y !== product) throw new Error('Multiply: wrong result');
+}
+
+function Divide() {
+  if (product / y !== x) throw new Error('Divide: wrong result');
+}
+
+function ToString() {
+  if (x.toString().length !== decimal.length) {
+    throw new Error('ToString: wrong result');
+  }
+}
+
+function Parse() {
+  if (BigInt(decimal) !== x) throw new Error('Parse: wrong result');
+}
+
+for (let bits of kSizes) {
+  let suffix = (bits / 1024) + 'K';
+  for (let [name, fn] of [['Multiply', Multiply], ['Divide', Divide],
+                          ['ToString', ToString], ['Parse', Parse]]) {
+    new BenchmarkSuite(name + suffix, [1000], [
+      new Benchmark(name + suffix, false, false, 0, fn, Setup(bits))
+    ]);
+  }
+}
@@ -0,0 +1,81 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Keeps a sliding window of live keys in a large collection: every step
+// deletes the oldest key and inserts a new one, which exercises lookups past
+// deleted entries as well as repeated rehashing.
+
+var MapChurnBenchmark = new BenchmarkSuite('Map-Churn', [1000], [
+  new Benchmark('Smi', false, false, 0, MapChurnSmi, ChurnSetupSmi,
+                ChurnTearDown),
+  new Benchmark('Object', false, false, 0, MapChurnObject, ChurnSetupObject,
+                ChurnTearDown),
+]);
+
+var SetChurnBenchmark = new BenchmarkSuite('Set-Churn', [1000], [
+  new Benchmark('Smi', false, false, 0, SetChurnSmi, ChurnSetupSmi,
+                ChurnTearDown),
+  new Benchmark('Object', false, false, 0, SetChurnObject, ChurnSetupObject,
+                ChurnTearDown),
+]);
+
+var ChurnWindow = 1000;
+var churnMap;
+var churnSet;
+
+function ChurnSetupSmi() {
+  SetupSmiKeys(LargeN);
+  ChurnSetupCollections();
+}
+
+function ChurnSetupObject() {
+  SetupObjectKeys(LargeN);
+  ChurnSetupCollections();
+}
+
+function ChurnSetupCollections() {
+  churnMap = new Map;
+  churnSet = new Set;
+  for (var i = 0; i < ChurnWindow; i++) {
+    churnMap.set(keys[i], i);
+    churnSet.add(keys[i]);
+  }
+}
+
+function ChurnTearDown() {
+  churnMap = null;
+  churnSet = null;
+  keys = null;
+}
+
+function MapChurn() {
+  for (var i = ChurnWindow; i < keys.length; i++) {
+    churnMap.delete(keys[i - ChurnWindow]);
+    churnMap.set(keys[i], i);
+    if (!churnMap.has(keys[i - 1])) throw new Error("Map-Churn: missing key");
+  }
+  // Move the window back to the start for the next run.
+  for (var i = 0; i < ChurnWindow; i++) {
+    churnMap.delete(keys[keys.length - ChurnWindow + i]);
+    churnMap.set(keys[i], i);
+  }
+}
+
+function SetChurn() {
+  for (var i = ChurnWindow; i < keys.length; i++) {
+    churnSet.delete(keys[i - ChurnWindow]);
+    churnSet.add(keys[i]);
+    if (!churnSet.has(keys[i - 1])) throw new Error("Set-Churn: missing key");
+  }
+  // Move the window back to the start for the next run.
+  for (var i = 0; i < ChurnWindow; i++) {
+    churnSet.delete(keys[keys.length - ChurnWindow + i]);
+    churnSet.add(keys[i]);
+  }
+}
+
+function MapChurnSmi() { MapChurn(); }
+function MapChurnObject() { MapChurn(); }
+function SetChurnSmi() { SetChurn(); }
+function SetChurnObject() { SetChurn(); }
@@ -6,6 +6,7 @@
 
 load('../base.js');
 load('common.js');
+load('churn.js');
 load('map.js');
 load('set.js');
 load('weakmap.js');
@@ -0,0 +1,69 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+new BenchmarkSuite('ConcurrentRecompilation', [1000], [
+  new Benchmark('ConcurrentRecompilation', false, false, 0,
+                ConcurrentRecompilation, ConcurrentRecompilationSetup)
+]);
+
+// ----------------------------------------------------------------------------
+
+// Queues many TurboFan jobs at once and waits until all of them are done, to
+// measure compile throughput when the background compiler threads allocate
+// and release zone memory concurrently.
+
+const kNumberOfFunctions = 32;
+const kMarkedForOptimization = 1 << 7;
+const kMarkedForConcurrentOptimization = 1 << 8;
+
+var input = [];
+var counter = 0;
+
+%NeverOptimizeFunction(ConcurrentRecompilationSetup);
+function ConcurrentRecompilationSetup() {
+  for (let i = 0; i < 100; i++) input.push(i);
+}
+
+%NeverOptimizeFunction(CreateFunction);
+function CreateFunction() {
+  // A fresh source string gives every function its own SharedFunctionInfo,
+  // so each of them needs a separate TurboFan job.
+  const id = counter++;
+  return new Function('a', `
+    let sum = ${id};
+    for (let i = 0; i < a.length; i++) {
+      const o = {x: a[i], y: i + ${id}};
+      sum += o.x * o.y;
+      if (sum > 1e6) sum -= 1e6;
+    }
+    return sum;`);
+}
+
+%NeverOptimizeFunction(IsQueued);
+function IsQueued(f) {
+  return (%GetOptimizationStatus(f, 'no sync') &
+          (kMarkedForOptimization | kMarkedForConcurrentOptimization)) != 0;
+}
+
+%NeverOptimizeFunction(ConcurrentRecompilation);
+function ConcurrentRecompilation() {
+  let functions = [];
+  for (let i = 0; i < kNumberOfFunctions; i++) {
+    const f = CreateFunction();
+    f(input);
+    f(input);
+    %OptimizeFunctionOnNextCall(f, 'concurrent');
+    f(input);
+    functions.push(f);
+  }
+  // Keep calling the functions so finished jobs get installed.
+  while (functions.length > 0) {
+    functions = functions.filter(f => {
+      f(input);
+      return IsQueued(f);
+    });
+  }
+}
@@ -0,0 +1,44 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+new BenchmarkSuite('LongLoop', [1000], [
+  new Benchmark('LongLoop', false, false, 0, LongLoop, LongLoopSetup)
+]);
+
+// ----------------------------------------------------------------------------
+
+// Runs a fresh function with a single long loop once per iteration, so that
+// every iteration tiers up through OSR. With synchronous OSR the loop stalls
+// for the whole TurboFan compile, with --concurrent-osr it keeps running in
+// the interpreter until the code is ready.
+
+const kLongLoopIterations = 1e6;
+
+var long_loop_counter = 0;
+var long_loop_expected;
+
+function LongLoopBody() {
+  return `
+    let a = 0, b = 1;
+    for (let i = 0; i < n; i++) {
+      const t = (a + b) | 0;
+      a = b;
+      b = t;
+    }
+    return b;`;
+}
+
+function LongLoopSetup() {
+  long_loop_expected = new Function('n', LongLoopBody())(kLongLoopIterations);
+}
+
+function LongLoop() {
+  // A fresh source string gives every function its own SharedFunctionInfo,
+  // so no OSR code can be reused across iterations.
+  const f = new Function(
+      'n', `// ${long_loop_counter++}` + LongLoopBody());
+  if (f(kLongLoopIterations) !== long_loop_expected) {
+    throw new Error('LongLoop: wrong result');
+  }
+}
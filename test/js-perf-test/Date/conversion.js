@@ -0,0 +1,68 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Conversions between UTC and local time for dates spread over decades,
+// so consecutive dates rarely share a daylight saving time period.
+
+new BenchmarkSuite('LocalGetters', [1000], [
+  new Benchmark('LocalGetters', false, false, 0, LocalGetters),
+]);
+
+new BenchmarkSuite('LocalConstructor', [1000], [
+  new Benchmark('LocalConstructor', false, false, 0, LocalConstructor),
+]);
+
+new BenchmarkSuite('SortByLocalHour', [1000], [
+  new Benchmark('SortByLocalHour', false, false, 0, SortByLocalHour),
+]);
+
+new BenchmarkSuite('DateToString', [1000], [
+  new Benchmark('DateToString', false, false, 0, DateToString),
+]);
+
+var kDateCount = 1000;
+var times = [];
+
+(function() {
+  var seed = 49734321;
+  var start = Date.UTC(1960, 0, 1);
+  var end = Date.UTC(2040, 0, 1);
+  for (var i = 0; i < kDateCount; i++) {
+    seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+    times.push(start + (seed / 4294967296) * (end - start));
+  }
+})();
+
+function LocalGetters() {
+  var sum = 0;
+  for (var i = 0; i < kDateCount; i++) {
+    // A new Date has no cached local fields.
+    var date = new Date(times[i]);
+    sum += date.getHours() + date.getDate() + date.getTimezoneOffset();
+  }
+  return sum;
+}
+
+function LocalConstructor() {
+  var sum = 0;
+  for (var i = 0; i < kDateCount; i++) {
+    sum += new Date(1960 + i % 80, i % 12, 1 + i % 28, i % 24).getTime();
+  }
+  return sum;
+}
+
+function SortByLocalHour() {
+  var dates = times.map(function(time) { return new Date(time); });
+  return dates.sort(function(a, b) {
+    return a.getHours() - b.getHours() || a - b;
+  });
+}
+
+function DateToString() {
+  var length = 0;
+  for (var i = 0; i < kDateCount; i++) {
+    length += new Date(times[i]).toString().length;
+  }
+  return length;
+}
@@ -0,0 +1,71 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Objects used as hash maps, with enough properties to be in dictionary mode
+// and to have a large property dictionary.
+
+new BenchmarkSuite('HashMapGet', [1000], [
+  new Benchmark('HashMapGet', false, false, 0, HashMapGet, HashMapSetup,
+                HashMapTearDown),
+]);
+
+new BenchmarkSuite('HashMapHas', [1000], [
+  new Benchmark('HashMapHas', false, false, 0, HashMapHas, HashMapSetup,
+                HashMapTearDown),
+]);
+
+new BenchmarkSuite('HashMapSetDelete', [1000], [
+  new Benchmark('HashMapSetDelete', false, false, 0, HashMapSetDelete,
+                HashMapSetup, HashMapTearDown),
+]);
+
+const kKeyCount = 1000;
+var map;
+var keys;
+var missing_keys;
+var result;
+
+function HashMapSetup() {
+  map = {};
+  keys = [];
+  missing_keys = [];
+  for (var i = 0; i < kKeyCount; i++) {
+    var key = 'key' + i;
+    keys.push(key);
+    missing_keys.push('missing' + i);
+    map[key] = i;
+  }
+  result = 0;
+}
+
+function HashMapGet() {
+  var sum = 0;
+  for (var i = 0; i < keys.length; i++) {
+    sum += map[keys[i]];
+  }
+  result = sum;
+}
+
+function HashMapHas() {
+  var count = 0;
+  for (var i = 0; i < keys.length; i++) {
+    if (keys[i] in map) count++;
+    if (missing_keys[i] in map) count++;
+  }
+  result = count;
+}
+
+function HashMapSetDelete() {
+  for (var i = 0; i < keys.length; i += 2) {
+    delete map[keys[i]];
+  }
+  for (var i = 0; i < keys.length; i += 2) {
+    map[keys[i]] = i;
+  }
+  result = map[keys[0]] + map[keys[keys.length - 2]];
+}
+
+function HashMapTearDown() {
+  return result > 0;
+}
@@ -0,0 +1,58 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares calls to embedder functions with a C function for fast API calls
+// (fastApi.add, fastApi.multiplyAdd) to calls of the same functions through
+// the regular callback (fastApi.slowAdd, fastApi.slowMultiplyAdd). Requires
+// d8 --expose-fast-api.
+
+const kIterations = 1000;
+
+new BenchmarkSuite('FastInt32', [1000], [
+  new Benchmark('FastInt32', false, false, 0, FastInt32),
+]);
+
+new BenchmarkSuite('SlowInt32', [1000], [
+  new Benchmark('SlowInt32', false, false, 0, SlowInt32),
+]);
+
+new BenchmarkSuite('FastFloat64', [1000], [
+  new Benchmark('FastFloat64', false, false, 0, FastFloat64),
+]);
+
+new BenchmarkSuite('SlowFloat64', [1000], [
+  new Benchmark('SlowFloat64', false, false, 0, SlowFloat64),
+]);
+
+function FastInt32() {
+  let result = 0;
+  for (let i = 0; i < kIterations; ++i) {
+    result = fastApi.add(result, i);
+  }
+  if (result !== 499500) throw new Error('Unexpected result: ' + result);
+}
+
+function SlowInt32() {
+  let result = 0;
+  for (let i = 0; i < kIterations; ++i) {
+    result = fastApi.slowAdd(result, i);
+  }
+  if (result !== 499500) throw new Error('Unexpected result: ' + result);
+}
+
+function FastFloat64() {
+  let result = 0;
+  for (let i = 0; i < kIterations; ++i) {
+    result = fastApi.multiplyAdd(result, 0.5, i + 0.25);
+  }
+  if (!(result > 0)) throw new Error('Unexpected result: ' + result);
+}
+
+function SlowFloat64() {
+  let result = 0;
+  for (let i = 0; i < kIterations; ++i) {
+    result = fastApi.slowMultiplyAdd(result, 0.5, i + 0.25);
+  }
+  if (!(result > 0)) throw new Error('Unexpected result: ' + result);
+}
@@ -0,0 +1,30 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Builds a heap for d8 --heap-snapshot-benchmark to take a snapshot of: about
+// a million objects of the kinds a web application keeps around, spread over
+// a few hundred pages.
+
+function Item(id, parent) {
+  this.id = id;
+  this.name = 'item-' + id;
+  this.parent = parent;
+  this.children = [];
+  this.attributes = {index: id, visible: id % 2 == 0, weight: id * 0.5};
+  this.onChange = function() { return parent; };
+}
+
+var roots = [];
+var byName = new Map();
+var metadata = new WeakMap();
+for (var i = 0; i < 1000; i++) {
+  var root = new Item(i, null);
+  for (var j = 0; j < 100; j++) {
+    var child = new Item(i * 1000 + j, root);
+    root.children.push(child);
+    byName.set(child.name, child);
+    if (j % 10 == 0) metadata.set(child, {created: j, tags: ['a', 'b']});
+  }
+  roots.push(root);
+}
@@ -0,0 +1,79 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Localized formatting of a table of values, the way a page renders prices,
+// dates and sorted names. Every call passes explicit locales and options, so
+// each one constructs a new collator or formatter.
+
+new BenchmarkSuite('NumberToLocaleString', [1000], [
+  new Benchmark('NumberToLocaleString', false, false, 0,
+                NumberToLocaleString),
+]);
+
+new BenchmarkSuite('NumberToLocaleStringCurrency', [1000], [
+  new Benchmark('NumberToLocaleStringCurrency', false, false, 0,
+                NumberToLocaleStringCurrency),
+]);
+
+new BenchmarkSuite('DateToLocaleString', [1000], [
+  new Benchmark('DateToLocaleString', false, false, 0, DateToLocaleString),
+]);
+
+new BenchmarkSuite('StringLocaleCompare', [1000], [
+  new Benchmark('StringLocaleCompare', false, false, 0, StringLocaleCompare),
+]);
+
+new BenchmarkSuite('NewNumberFormat', [1000], [
+  new Benchmark('NewNumberFormat', false, false, 0, NewNumberFormat),
+]);
+
+var kRows = 100;
+var numbers = [];
+var dates = [];
+var names = [];
+for (var i = 0; i < kRows; i++) {
+  numbers.push(i * 1234.5678);
+  dates.push(new Date(Date.UTC(2018, i % 12, 1 + i % 28)));
+  names.push('name' + ((i * 7919) % kRows));
+}
+
+function NumberToLocaleString() {
+  var length = 0;
+  for (var i = 0; i < kRows; i++) {
+    length += numbers[i].toLocaleString('de-DE').length;
+  }
+  return length;
+}
+
+function NumberToLocaleStringCurrency() {
+  var length = 0;
+  for (var i = 0; i < kRows; i++) {
+    length += numbers[i].toLocaleString(
+        'en-US', {style: 'currency', currency: 'EUR'}).length;
+  }
+  return length;
+}
+
+function DateToLocaleString() {
+  var length = 0;
+  for (var i = 0; i < kRows; i++) {
+    length += dates[i].toLocaleString('en-GB', {timeZone: 'UTC'}).length;
+  }
+  return length;
+}
+
+function StringLocaleCompare() {
+  return names.slice().sort(function(a, b) {
+    return a.localeCompare(b, 'en', {sensitivity: 'base'});
+  });
+}
+
+function NewNumberFormat() {
+  var length = 0;
+  for (var i = 0; i < kRows; i++) {
+    length += new Intl.NumberFormat('fr-FR', {maximumFractionDigits: 1})
+                  .format(numbers[i]).length;
+  }
+  return length;
+}
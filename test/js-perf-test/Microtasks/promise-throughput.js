@@ -0,0 +1,57 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Measures how fast the microtask queue processes promise reactions, both
+// when many independent reactions are pending at once (which makes the
+// queue grow) and when each reaction schedules the next one.
+
+new BenchmarkSuite('PromiseFanOut', [1000], [
+  new Benchmark('FanOut', false, false, 0, FanOut, FanOutSetup),
+]);
+
+new BenchmarkSuite('PromiseChain', [1000], [
+  new Benchmark('Chain', false, false, 0, Chain),
+]);
+
+new BenchmarkSuite('AwaitLoop', [1000], [
+  new Benchmark('AwaitLoop', false, false, 0, AwaitLoop),
+]);
+
+var kFanOut = 10000;
+var kChainLength = 10000;
+var resolved;
+var counter;
+
+function Increment() { counter++; }
+
+function FanOutSetup() {
+  resolved = Promise.resolve();
+}
+
+function FanOut() {
+  counter = 0;
+  for (var i = 0; i < kFanOut; i++) resolved.then(Increment);
+  %RunMicrotasks();
+  if (counter !== kFanOut) throw new Error('FanOut: wrong count');
+}
+
+function Chain() {
+  counter = 0;
+  var p = Promise.resolve();
+  for (var i = 0; i < kChainLength; i++) p = p.then(Increment);
+  %RunMicrotasks();
+  if (counter !== kChainLength) throw new Error('Chain: wrong count');
+}
+
+async function CountUp(n) {
+  for (var i = 0; i < n; i++) await i;
+  return n;
+}
+
+function AwaitLoop() {
+  counter = 0;
+  CountUp(kChainLength).then(n => counter = n);
+  %RunMicrotasks();
+  if (counter !== kChainLength) throw new Error('AwaitLoop: wrong count');
+}
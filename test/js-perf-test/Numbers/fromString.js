@@ -0,0 +1,51 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Decimal strings with 16 to 19 significant digits, like the ones produced
+// by serializing arbitrary doubles, in a fixed pseudo-random order.
+const kStringCount = 1000;
+const strings = new Array(kStringCount);
+
+(function() {
+  let seed = 1953;
+  function random32() {
+    seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+    return seed;
+  }
+  for (let i = 0; i < kStringCount; i++) {
+    let digits = String(1 + random32() % 9);
+    const length = 16 + random32() % 4;
+    while (digits.length < length) {
+      digits += String(random32() % 10);
+    }
+    const point = 1 + random32() % 3;
+    const exponent = random32() % 80 - 40;
+    strings[i] = digits.substring(0, point) + '.' + digits.substring(point) +
+                 (i % 2 == 0 ? 'e' + exponent : '');
+  }
+})();
+const numbersJson = '[' + strings.join(',') + ']';
+
+function NumberParseFloatLong() {
+  let result = 0;
+  for (let i = 0; i < kStringCount; i++) {
+    result += parseFloat(strings[i]);
+  }
+  return result;
+}
+createSuite('ParseFloatLong', 1000, NumberParseFloatLong, ()=>{});
+
+function NumberConstructorLong() {
+  let result = 0;
+  for (let i = 0; i < kStringCount; i++) {
+    result += Number(strings[i]);
+  }
+  return result;
+}
+createSuite('ConstructorLong', 1000, NumberConstructorLong, ()=>{});
+
+function NumberJSONParse() {
+  return JSON.parse(numbersJson).length;
+}
+createSuite('JSONParse', 1000, NumberJSONParse, ()=>{});
@@ -3,6 +3,8 @@
 // found in the LICENSE file.
 load('../base.js');
 load('toNumber.js');
+load('toString.js');
+load('fromString.js');
 
 function PrintResult(name, result) {
   console.log(name);
@@ -0,0 +1,72 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Random doubles, with a fixed seed so runs are comparable. Half of them
+// are arbitrary bit patterns (17 significant digits are common), the other
+// half are short decimals like prices or coordinates.
+const kDoubleCount = 1000;
+const doubles = new Array(kDoubleCount);
+
+(function() {
+  let seed = 49734321;
+  function random32() {
+    seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+    return seed;
+  }
+  const view = new DataView(new ArrayBuffer(8));
+  for (let i = 0; i < kDoubleCount; i++) {
+    if (i % 2 == 0) {
+      let value;
+      do {
+        view.setUint32(0, random32() & 0x7FEFFFFF);
+        view.setUint32(4, random32());
+        value = view.getFloat64(0);
+      } while (value == 0);
+      doubles[i] = value;
+    } else {
+      doubles[i] = (random32() % 10000000) / 100;
+    }
+  }
+})();
+
+function NumberToString() {
+  let result = 0;
+  for (let i = 0; i < kDoubleCount; i++) {
+    result += String(doubles[i]).length;
+  }
+  return result;
+}
+createSuite('ToString', 1000, NumberToString, ()=>{});
+
+function NumberJSONStringify() {
+  return JSON.stringify(doubles).length;
+}
+createSuite('JSONStringify', 1000, NumberJSONStringify, ()=>{});
+
+function NumberToFixed() {
+  let result = 0;
+  for (let i = 1; i < kDoubleCount; i += 2) {
+    result += doubles[i].toFixed(2).length;
+  }
+  return result;
+}
+createSuite('ToFixed', 1000, NumberToFixed, ()=>{});
+
+function NumberToPrecision() {
+  let result = 0;
+  for (let i = 0; i < kDoubleCount; i++) {
+    result += doubles[i].toPrecision(12).length;
+  }
+  return result;
+}
+createSuite('ToPrecision', 1000, NumberToPrecision, ()=>{});
+
+function NumberToExponential() {
+  let result = 0;
+  for (let i = 0; i < kDoubleCount; i++) {
+    result += doubles[i].toExponential(6).length;
+  }
+  return result;
+}
+createSuite('ToExponential', 1000, NumberToExponential, ()=>{});
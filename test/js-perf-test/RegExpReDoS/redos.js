@@ -0,0 +1,80 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Regexps with catastrophic backtracking ("ReDoS"), on subjects that make
+// a backtracking engine take exponential time. Run with
+// --regexp-nfa-on-excessive-backtracks to measure the NFA fallback, and
+// without it for the baseline. The subjects are kept short enough for the
+// baseline to finish.
+
+new BenchmarkSuite('NestedQuantifiers', [1000], [
+  new Benchmark('NestedQuantifiers', false, false, 0, NestedQuantifiers),
+]);
+
+new BenchmarkSuite('OverlappingAlternatives', [1000], [
+  new Benchmark('OverlappingAlternatives', false, false, 0,
+                OverlappingAlternatives),
+]);
+
+new BenchmarkSuite('EmailValidation', [1000], [
+  new Benchmark('EmailValidation', false, false, 0, EmailValidation),
+]);
+
+new BenchmarkSuite('WordList', [1000], [
+  new Benchmark('WordList', false, false, 0, WordList),
+]);
+
+// Regexps that never reach the backtrack limit, to measure the cost of
+// counting backtracks.
+new BenchmarkSuite('NoExcessiveBacktracking', [1000], [
+  new Benchmark('NoExcessiveBacktracking', false, false, 0,
+                NoExcessiveBacktracking),
+]);
+
+var nestedSubject = 'a'.repeat(18) + '!';
+var alternativesSubject = 'a'.repeat(24) + '!';
+var emailSubject = 'a'.repeat(18) + '@';
+var emailRegExp = new RegExp(
+    '^([a-zA-Z0-9])(([\\-.]|[_]+)?([a-zA-Z0-9]+))*(@){1}[a-z0-9]+[.]{1}' +
+    '(([a-z]{2,3})|([a-z]{2,3}[.]{1}[a-z]{2,3}))$');
+var wordListSubject = 'foo bar baz qux quux corge!';
+var wellBehavedSubjects = [
+  'The quick brown fox jumps over the lazy dog.',
+  'john.doe@example.com',
+  '2018-10-01T12:34:56Z',
+  'key1=value1&key2=value2&key3=value3',
+];
+
+function NestedQuantifiers() {
+  if (/(a+)+$/.test(nestedSubject)) throw new Error('unexpected match');
+  if (/(a+)+b/.test(nestedSubject)) throw new Error('unexpected match');
+}
+
+function OverlappingAlternatives() {
+  if (/^(a|aa)+$/.test(alternativesSubject)) {
+    throw new Error('unexpected match');
+  }
+  if (/^(a|\w)+$/.test(nestedSubject)) throw new Error('unexpected match');
+}
+
+function EmailValidation() {
+  if (emailRegExp.test(emailSubject)) throw new Error('unexpected match');
+}
+
+function WordList() {
+  if (/^(\w+\s?)*$/.test(wordListSubject)) throw new Error('unexpected match');
+}
+
+function NoExcessiveBacktracking() {
+  var count = 0;
+  for (var i = 0; i < wellBehavedSubjects.length; i++) {
+    var subject = wellBehavedSubjects[i];
+    count += subject.split(/\s+/).length;
+    count += subject.replace(/[aeiou]/g, '').length;
+    if (/^\w+([.-]?\w+)*@\w+(\.\w{2,3})+$/.test(subject)) count++;
+    if (/(\d+)-(\d+)-(\d+)/.test(subject)) count++;
+    count += (subject.match(/(\w+)=(\w+)/g) || []).length;
+  }
+  if (count != 106) throw new Error('unexpected count: ' + count);
+}
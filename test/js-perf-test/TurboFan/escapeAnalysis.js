@@ -0,0 +1,49 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Each of these allocates a short-lived object per iteration that escape
+// analysis should be able to scalar replace.
+
+function pick(i, a, b) {
+  const pair = [a, b];
+  return pair[i & 1];
+}
+
+function ArrayLiteralVariableIndex() {
+  var sum = 0;
+  for (var i = 0; i < 10240; i++) {
+    sum += pick(i, i, -i);
+  }
+  if (sum !== -5120) throw new Error("Unexpected result: " + sum);
+}
+createSuite('ArrayLiteralVariableIndex', 1000, ArrayLiteralVariableIndex);
+
+function ClosureInLoop() {
+  var sum = 0;
+  for (var i = 0; i < 10240; i++) {
+    const add = (x) => x + i;
+    sum += add(1);
+  }
+  if (sum !== 10240 * 10241 / 2) throw new Error("Unexpected result: " + sum);
+}
+createSuite('ClosureInLoop', 1000, ClosureInLoop);
+
+function first(...args) {
+  return args[0];
+}
+
+function sumArguments() {
+  return arguments[0] + arguments[1];
+}
+
+function RestAndArguments() {
+  var sum = 0;
+  for (var i = 0; i < 10240; i++) {
+    sum += first(i, 1, 2) + sumArguments(i, 1);
+  }
+  if (sum !== 10240 * 10239 + 10240) {
+    throw new Error("Unexpected result: " + sum);
+  }
+}
+createSuite('RestAndArguments', 1000, RestAndArguments);
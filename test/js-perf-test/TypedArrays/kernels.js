@@ -0,0 +1,201 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Simple counted loops with unit-stride typed array accesses, as found in
+// image filters and DSP code. Add, Scale and Saxpy-Int32 are the ones that
+// --turbo-loop-vectorization handles.
+
+new BenchmarkSuite('Kernels', [1000], [
+  new Benchmark('Add-Float32', false, false, 0,
+                AddFloat32, KernelsSetup, AddFloat32TearDown),
+  new Benchmark('Scale-Float32', false, false, 0,
+                ScaleFloat32, KernelsSetup, ScaleFloat32TearDown),
+  new Benchmark('Saxpy-Int32', false, false, 0,
+                SaxpyInt32, KernelsSetup, SaxpyInt32TearDown),
+  new Benchmark('Saxpy-Float32', false, false, 0,
+                SaxpyFloat32, KernelsSetup, SaxpyFloat32TearDown),
+  new Benchmark('Saxpy-Float64', false, false, 0,
+                SaxpyFloat64, KernelsSetup, SaxpyFloat64TearDown),
+  new Benchmark('Sum-Float64', false, false, 0,
+                SumFloat64, KernelsSetup, SumFloat64TearDown),
+  new Benchmark('Sum-Int32', false, false, 0,
+                SumInt32, KernelsSetup, SumInt32TearDown),
+  new Benchmark('Clamp-Int32', false, false, 0,
+                ClampInt32, KernelsSetup, ClampInt32TearDown),
+  new Benchmark('Clamp-Float32', false, false, 0,
+                ClampFloat32, KernelsSetup, ClampFloat32TearDown),
+]);
+
+const kKernelLength = 4099;  // Not a multiple of any SIMD width.
+
+var xFloat32, yFloat32, zFloat32, xFloat64, yFloat64, xInt32, yInt32;
+var result;
+
+function KernelsSetup() {
+  xFloat32 = new Float32Array(kKernelLength);
+  yFloat32 = new Float32Array(kKernelLength);
+  zFloat32 = new Float32Array(kKernelLength);
+  xFloat64 = new Float64Array(kKernelLength);
+  yFloat64 = new Float64Array(kKernelLength);
+  xInt32 = new Int32Array(kKernelLength);
+  yInt32 = new Int32Array(kKernelLength);
+  for (var i = 0; i < kKernelLength; ++i) {
+    xFloat32[i] = xFloat64[i] = i & 0xff;
+    yFloat32[i] = yFloat64[i] = 1;
+    xInt32[i] = (i & 0x1ff) - 0x100;
+  }
+  result = undefined;
+}
+
+function add(x, y, z) {
+  for (var i = 0; i < z.length; ++i) {
+    z[i] = x[i] + y[i];
+  }
+}
+
+function AddFloat32() {
+  add(xFloat32, yFloat32, zFloat32);
+}
+
+function scale(x, y) {
+  for (var i = 0; i < y.length; ++i) {
+    y[i] = x[i] * 0.5;
+  }
+}
+
+function ScaleFloat32() {
+  scale(xFloat32, zFloat32);
+}
+
+function saxpyInt32(a, x, y, n) {
+  for (var i = 0; i < n; ++i) {
+    y[i] = Math.imul(a, x[i]) + y[i];
+  }
+}
+
+// Like SaxpyFloat32 below, the second call undoes the first one.
+function SaxpyInt32() {
+  saxpyInt32(3, xInt32, yInt32, kKernelLength);
+  saxpyInt32(-3, xInt32, yInt32, kKernelLength);
+}
+
+function saxpy(a, x, y, n) {
+  for (var i = 0; i < n; ++i) {
+    y[i] = a * x[i] + y[i];
+  }
+}
+
+// The second call undoes the first one, so {y} stays bounded and exact.
+function SaxpyFloat32() {
+  saxpy(2, xFloat32, yFloat32, kKernelLength);
+  saxpy(-2, xFloat32, yFloat32, kKernelLength);
+}
+
+function SaxpyFloat64() {
+  saxpy(2, xFloat64, yFloat64, kKernelLength);
+  saxpy(-2, xFloat64, yFloat64, kKernelLength);
+}
+
+function sum(x, n) {
+  var s = 0;
+  for (var i = 0; i < n; ++i) {
+    s += x[i];
+  }
+  return s;
+}
+
+function SumFloat64() {
+  result = sum(xFloat64, kKernelLength);
+}
+
+function SumInt32() {
+  result = sum(xInt32, kKernelLength);
+}
+
+function clamp(x, y, lo, hi, n) {
+  for (var i = 0; i < n; ++i) {
+    var v = x[i];
+    y[i] = v < lo ? lo : (v > hi ? hi : v);
+  }
+}
+
+function ClampInt32() {
+  clamp(xInt32, yInt32, -100, 100, kKernelLength);
+}
+
+function ClampFloat32() {
+  clamp(xFloat32, yFloat32, 10, 100, kKernelLength);
+}
+
+function AddFloat32TearDown() {
+  for (var i = 0; i < kKernelLength; ++i) {
+    if (zFloat32[i] !== xFloat32[i] + 1) {
+      throw new TypeError("Unexpected result!\n" + zFloat32[i]);
+    }
+  }
+}
+
+function ScaleFloat32TearDown() {
+  for (var i = 0; i < kKernelLength; ++i) {
+    if (zFloat32[i] !== xFloat32[i] / 2) {
+      throw new TypeError("Unexpected result!\n" + zFloat32[i]);
+    }
+  }
+}
+
+function SaxpyInt32TearDown() {
+  for (var i = 0; i < kKernelLength; ++i) {
+    if (yInt32[i] !== 0) {
+      throw new TypeError("Unexpected result!\n" + yInt32[i]);
+    }
+  }
+}
+
+function CheckSaxpy(y) {
+  for (var i = 0; i < kKernelLength; ++i) {
+    if (y[i] !== 1) {
+      throw new TypeError("Unexpected result!\n" + y[i]);
+    }
+  }
+}
+
+function SaxpyFloat32TearDown() {
+  CheckSaxpy(yFloat32);
+}
+
+function SaxpyFloat64TearDown() {
+  CheckSaxpy(yFloat64);
+}
+
+function CheckSum(x) {
+  var expected = 0;
+  for (var i = 0; i < kKernelLength; ++i) expected += x[i];
+  if (result !== expected) {
+    throw new TypeError("Unexpected result!\n" + result);
+  }
+}
+
+function SumFloat64TearDown() {
+  CheckSum(xFloat64);
+}
+
+function SumInt32TearDown() {
+  CheckSum(xInt32);
+}
+
+function CheckClamp(x, y, lo, hi) {
+  for (var i = 0; i < kKernelLength; ++i) {
+    if (y[i] !== Math.min(Math.max(x[i], lo), hi)) {
+      throw new TypeError("Unexpected result!\n" + y[i]);
+    }
+  }
+}
+
+function ClampInt32TearDown() {
+  CheckClamp(xInt32, yInt32, -100, 100);
+}
+
+function ClampFloat32TearDown() {
+  CheckClamp(xFloat32, yFloat32, 10, 100);
+}
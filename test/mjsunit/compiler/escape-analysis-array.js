@@ -0,0 +1,77 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --turbo-escape --opt
+
+// Test that small array literals indexed by non-constant keys still produce
+// the right values when they are scalar replaced. That the literals are not
+// allocated is checked by the EscapeAnalysisArrayLiteralVariableIndex cctest.
+(function testTwoElements() {
+  function foo(i) {
+    const a = [i + 1, i + 2];
+    return a[i];
+  }
+  assertEquals(1, foo(0));
+  assertEquals(3, foo(1));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(1, foo(0));
+  assertEquals(3, foo(1));
+  assertOptimized(foo);
+})();
+
+(function testFourElements() {
+  function foo(i, o) {
+    const a = [o, 2 * o.x, 3, "four"];
+    return a[i];
+  }
+  const o = {x: 1};
+  for (let i = 0; i < 4; ++i) foo(i, o);
+  %OptimizeFunctionOnNextCall(foo);
+  assertSame(o, foo(0, o));
+  assertEquals(2, foo(1, o));
+  assertEquals(3, foo(2, o));
+  assertEquals("four", foo(3, o));
+  assertOptimized(foo);
+})();
+
+(function testDoubleElements() {
+  function foo(i, x) {
+    const a = [x, x + 0.5, x + 1.5];
+    return a[i];
+  }
+  for (let i = 0; i < 3; ++i) foo(i, 0.25);
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(0.25, foo(0, 0.25));
+  assertEquals(0.75, foo(1, 0.25));
+  assertEquals(1.75, foo(2, 0.25));
+  assertOptimized(foo);
+})();
+
+// Test that the array is rematerialized correctly on deoptimization.
+(function testDeopt() {
+  function foo(i, deopt) {
+    const a = [i, i + 1];
+    const x = a[i & 1];
+    if (deopt) return a;
+    return x;
+  }
+  assertEquals(2, foo(0, false) + foo(1, false));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(0, foo(0, false));
+  assertEquals(2, foo(1, false));
+  assertEquals([1, 2], foo(1, true));
+})();
+
+// Test that out-of-bounds accesses are still handled correctly.
+(function testOutOfBounds() {
+  function foo(i) {
+    const a = [1, 2];
+    return a[i];
+  }
+  assertEquals(1, foo(0));
+  assertEquals(2, foo(1));
+  %OptimizeFunctionOnNextCall(foo);
+  assertEquals(2, foo(1));
+  assertEquals(undefined, foo(2));
+})();
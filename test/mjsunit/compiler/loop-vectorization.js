@@ -0,0 +1,212 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --expose-gc --turbo-loop-vectorization
+
+// Runs {kernel} optimized and {reference} unoptimized on copies of the
+// same arrays, and checks that they leave the same contents behind.
+function check(kernel, reference, make_args) {
+  %NeverOptimizeFunction(reference);
+  function run(f) {
+    var args = make_args();
+    var result = f.apply(null, args);
+    return [result].concat(args.filter(ArrayBuffer.isView).map(
+        a => Array.from(a)));
+  }
+  run(kernel);
+  run(kernel);
+  %OptimizeFunctionOnNextCall(kernel);
+  assertEquals(run(reference), run(kernel));
+}
+
+function iota(Type, n, f) {
+  var a = new Type(n);
+  for (var i = 0; i < n; ++i) a[i] = f(i);
+  return a;
+}
+
+function float32(n) {
+  return iota(Float32Array, n, i => 1 / (i + 3) + i * 0.75);
+}
+
+function int32(n) {
+  return iota(Int32Array, n, i => (i * 0x1234567) | 0);
+}
+
+// Float32 arithmetic, for lengths around multiples of the vector width.
+(function() {
+  function add(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  }
+  function addRef(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.fround(a[i] + b[i]);
+  }
+  for (var n of [0, 1, 3, 4, 5, 8, 11, 103]) {
+    check(add, addRef, () => [float32(n), float32(n).reverse(),
+                              new Float32Array(n)]);
+  }
+
+  function sub(a, b, c, n) {
+    for (var i = 0; i < n; ++i) c[i] = a[i] - b[i];
+  }
+  function subRef(a, b, c, n) {
+    for (var i = 0; i < n; ++i) c[i] = Math.fround(a[i] - b[i]);
+  }
+  check(sub, subRef, () => [float32(37), float32(37).reverse(),
+                            new Float32Array(37), 37]);
+  check(sub, subRef, () => [float32(37), float32(37).reverse(),
+                            new Float32Array(37), 30]);
+
+  function scale(a, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = a[i] * 0.5;
+  }
+  function scaleRef(a, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.fround(a[i] * 0.5);
+  }
+  check(scale, scaleRef, () => [float32(21), new Float32Array(21)]);
+
+  // 0.1 isn't a float32, so the product must not be rounded twice.
+  function scaleInexact(a, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = a[i] * 0.1;
+  }
+  function scaleInexactRef(a, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.fround(a[i] * 0.1);
+  }
+  check(scaleInexact, scaleInexactRef,
+        () => [float32(21), new Float32Array(21)]);
+
+  function copy(a, c) {
+    for (var i = 0; i < a.length; ++i) c[i] = a[i];
+  }
+  function copyRef(a, c) {
+    for (var i = 0; i < a.length; ++i) c[i] = a[i];
+  }
+  check(copy, copyRef, () => [float32(13), new Float32Array(13)]);
+
+  function fill(c, v) {
+    for (var i = 0; i < c.length; ++i) c[i] = v;
+  }
+  function fillRef(c, v) {
+    for (var i = 0; i < c.length; ++i) c[i] = v;
+  }
+  check(fill, fillRef, () => [new Float32Array(15), 0.1]);
+  check(fill, fillRef, () => [new Float32Array(15), 3]);
+})();
+
+// Int32 arithmetic wraps around like in the scalar loop.
+(function() {
+  function saxpy(a, x, y, n) {
+    for (var i = 0; i < n; ++i) y[i] = Math.imul(a, x[i]) + y[i];
+  }
+  function saxpyRef(a, x, y, n) {
+    for (var i = 0; i < n; ++i) y[i] = (Math.imul(a, x[i]) + y[i]) | 0;
+  }
+  check(saxpy, saxpyRef, () => [3, int32(27), int32(27).reverse(), 27]);
+  check(saxpy, saxpyRef, () => [-7, int32(27), int32(27).reverse(), 27]);
+
+  function mix(a, b, c) {
+    for (var i = 0; i < c.length; ++i) {
+      c[i] = ((a[i] & b[i]) ^ (a[i] | 7)) - (a[i] << 3) + (b[i] >> 2) +
+             (b[i] >>> 5);
+    }
+  }
+  function mixRef(a, b, c) {
+    for (var i = 0; i < c.length; ++i) {
+      c[i] = ((a[i] & b[i]) ^ (a[i] | 7)) - (a[i] << 3) + (b[i] >> 2) +
+             (b[i] >>> 5);
+    }
+  }
+  check(mix, mixRef, () => [int32(42), int32(42).reverse(),
+                            new Int32Array(42)]);
+
+  function mul(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.imul(a[i], b[i]);
+  }
+  function mulRef(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.imul(a[i], b[i]);
+  }
+  check(mul, mulRef, () => [int32(17), int32(17).reverse(),
+                            new Int32Array(17)]);
+
+  function fill(c, v) {
+    for (var i = 0; i < c.length; ++i) c[i] = v;
+  }
+  function fillRef(c, v) {
+    for (var i = 0; i < c.length; ++i) c[i] = v;
+  }
+  check(fill, fillRef, () => [new Uint32Array(19), 7]);
+  check(fill, fillRef, () => [new Uint32Array(19), 0xdeadbeef | 0]);
+})();
+
+// Aliasing and overlapping views on the same buffer.
+(function() {
+  function add(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  }
+  function addRef(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = Math.fround(a[i] + b[i]);
+  }
+  // The same array is read and written.
+  check(add, addRef, () => { var a = float32(30); return [a, a, a]; });
+  // Views that overlap by less than a vector, in both directions.
+  for (var d = 1; d < 8; ++d) {
+    check(add, addRef, () => {
+      var a = float32(40);
+      return [a.subarray(d), a.subarray(0, 40 - d), a.subarray(0, 40 - d)];
+    });
+    check(add, addRef, () => {
+      var a = float32(40);
+      return [a.subarray(0, 40 - d), a.subarray(0, 40 - d), a.subarray(d)];
+    });
+  }
+  // Different views on the same elements.
+  check(add, addRef, () => {
+    var a = float32(25);
+    return [new Float32Array(a.buffer), a, a.subarray(0)];
+  });
+})();
+
+// The loop bound and the start index must not take the vector loop out of
+// bounds, and the scalar loop still deoptimizes.
+(function() {
+  function add(a, b, c, start, n) {
+    for (var i = start; i < n; ++i) c[i] = a[i] + b[i];
+  }
+  function addRef(a, b, c, start, n) {
+    for (var i = start; i < n; ++i) c[i] = Math.fround(a[i] + b[i]);
+  }
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            0, 20]);
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            3, 20]);
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            5, 7]);
+  check(add, addRef, () => [float32(20), float32(12), new Float32Array(20),
+                            0, 20]);
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            0, 21]);
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            -2, 10]);
+  check(add, addRef, () => [float32(20), float32(20), new Float32Array(20),
+                            0, 10.5]);
+})();
+
+// On-heap typed arrays, which the GC moves around between the calls.
+(function() {
+  function add(a, b, c) {
+    for (var i = 0; i < c.length; ++i) c[i] = a[i] + b[i];
+  }
+  var a = iota(Int32Array, 12, i => i);
+  var b = iota(Int32Array, 12, i => 100 * i);
+  var c = new Int32Array(12);
+  add(a, b, c);
+  add(a, b, c);
+  %OptimizeFunctionOnNextCall(add);
+  for (var k = 0; k < 10; ++k) {
+    c.fill(0);
+    add(a, b, c);
+    gc();
+    for (var i = 0; i < 12; ++i) assertEquals(101 * i, c[i]);
+  }
+})();
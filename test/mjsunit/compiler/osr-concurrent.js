@@ -0,0 +1,57 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --use-osr --opt --no-always-opt
+// Flags: --concurrent-osr --concurrent-recompilation
+// Flags: --block-concurrent-recompilation
+
+if (!%IsConcurrentRecompilationSupported()) {
+  print("Concurrent recompilation is disabled. Skipping this test.");
+  quit();
+}
+
+function inOsrCode(f) {
+  return (%GetOptimizationStatus(f) &
+          V8OptimizationStatus.kTopmostFrameIsTurboFanned) !== 0;
+}
+
+// The loop keeps running in the interpreter while the OSR code is compiled
+// and enters it at a back edge once it has been installed.
+(function() {
+  function f() {
+    var sum = 0;
+    for (var i = 0; i < 1e8; i++) {
+      sum += i;
+      if (i == 10) {
+        %OptimizeOsr();
+      } else if (i == 100) {
+        // The job is blocked, so we must still be interpreting.
+        assertFalse(inOsrCode(f));
+        %UnblockConcurrentRecompilation();
+      } else if (i > 100 && inOsrCode(f)) {
+        return sum;
+      }
+    }
+    return -1;
+  }
+
+  assertTrue(f() > 0);
+})();
+
+// A job that finishes after the activation left the loop is harmless.
+(function() {
+  function g(n) {
+    var sum = 0;
+    for (var i = 0; i < n; i++) {
+      sum += i;
+      if (i == 10) %OptimizeOsr();
+    }
+    return sum;
+  }
+
+  assertEquals(190, g(20));
+  %UnblockConcurrentRecompilation();
+  assertEquals(190, g(20));
+  assertEquals(4950, g(100));
+})();
@@ -0,0 +1,66 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Deleting and re-adding keys leaves deleted entries in the probe sequences
+// of the remaining keys until the table is rehashed.
+
+function TestChurn(make_key) {
+  var keys = [];
+  for (var i = 0; i < 2000; i++) keys.push(make_key(i));
+
+  var map = new Map;
+  var set = new Set;
+  var window = 100;
+  for (var i = 0; i < keys.length; i++) {
+    map.set(keys[i], i);
+    set.add(keys[i]);
+    if (i >= window) {
+      assertTrue(map.delete(keys[i - window]));
+      assertTrue(set.delete(keys[i - window]));
+      assertFalse(map.delete(keys[i - window]));
+      assertFalse(set.delete(keys[i - window]));
+    }
+    assertEquals(Math.min(i + 1, window), map.size);
+    assertEquals(Math.min(i + 1, window), set.size);
+  }
+  for (var i = 0; i < keys.length; i++) {
+    var live = i >= keys.length - window;
+    assertEquals(live, map.has(keys[i]));
+    assertEquals(live ? i : undefined, map.get(keys[i]));
+    assertEquals(live, set.has(keys[i]));
+  }
+
+  // Shrink the tables down to a single live key.
+  for (var i = keys.length - window; i < keys.length - 1; i++) {
+    assertTrue(map.delete(keys[i]));
+    assertTrue(set.delete(keys[i]));
+  }
+  assertEquals(1, map.size);
+  assertEquals(1, set.size);
+  assertEquals(keys.length - 1, map.get(keys[keys.length - 1]));
+  assertTrue(set.has(keys[keys.length - 1]));
+  assertEquals([keys[keys.length - 1]], Array.from(set));
+}
+
+TestChurn(i => i);
+TestChurn(i => i + 0.5);
+TestChurn(i => 'key' + i);
+TestChurn(i => ({}));
+TestChurn(i => Symbol());
+
+function TestOptimizedLookup() {
+  function lookup(map, key) { return map.get(key); }
+  var map = new Map;
+  for (var i = 0; i < 64; i++) map.set(i, i);
+  for (var i = 0; i < 48; i++) map.delete(i * 2 % 64);
+  lookup(map, 1);
+  lookup(map, 3);
+  %OptimizeFunctionOnNextCall(lookup);
+  for (var i = 0; i < 64; i++) {
+    assertEquals(map.has(i) ? i : undefined, lookup(map, i));
+  }
+}
+TestOptimizedLookup();
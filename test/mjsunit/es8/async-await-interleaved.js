@@ -33,15 +33,9 @@
 
   async function check(v) {
     awaitCounter = v;
-    // The following checks ensure that "await" takes 3 ticks on the
-    // microtask queue. Note: this will change in the future
-    if (awaitCounter === 0) {
-      assertEquals(iterations, promiseCounter);
-    } else if (awaitCounter <= Math.floor(iterations / 3)) {
-      assertEquals(iterations - awaitCounter * 3, promiseCounter);
-    } else {
-      assertEquals(0, promiseCounter);
-    }
+    // The following checks ensure that "await" takes 1 tick on the
+    // microtask queue when awaiting a native promise.
+    assertEquals(iterations - awaitCounter, promiseCounter);
   }
 
   async function f() {
@@ -0,0 +1,101 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Awaiting a native, unmodified promise resumes the async function one tick
+// after the promise settles, i.e. before reactions registered after the await.
+(function TestAwaitResolvedPromise() {
+  const log = [];
+  async function f(p) {
+    log.push(await p);
+  }
+  const p = Promise.resolve('await');
+  f(p);
+  p.then(() => log.push('then'));
+  %RunMicrotasks();
+  assertEquals(['await', 'then'], log);
+})();
+
+(function TestAwaitRejectedPromise() {
+  const log = [];
+  async function f(p) {
+    try {
+      await p;
+    } catch (e) {
+      log.push(e);
+    }
+  }
+  const p = Promise.reject('await');
+  f(p);
+  p.catch(() => log.push('catch'));
+  %RunMicrotasks();
+  assertEquals(['await', 'catch'], log);
+})();
+
+(function TestAwaitPendingPromise() {
+  const log = [];
+  let resolve;
+  const p = new Promise(r => resolve = r);
+  async function f() {
+    log.push(await p);
+  }
+  f();
+  p.then(() => log.push('then'));
+  resolve('await');
+  %RunMicrotasks();
+  assertEquals(['await', 'then'], log);
+})();
+
+// The awaited promise is reused as is, so a patched "then" is not called.
+(function TestAwaitDoesNotCallThen() {
+  const p = Promise.resolve(1);
+  let called = false;
+  p.then = function(...args) {
+    called = true;
+    return Promise.prototype.then.apply(this, args);
+  };
+  let result;
+  (async () => result = await p)();
+  %RunMicrotasks();
+  assertEquals(1, result);
+  assertFalse(called);
+})();
+
+// Promise subclasses are wrapped in a new promise, which does call "then".
+(function TestAwaitPromiseSubclass() {
+  let called = 0;
+  class MyPromise extends Promise {
+    then(...args) {
+      called++;
+      return super.then(...args);
+    }
+  }
+  let result;
+  (async () => result = await MyPromise.resolve(2))();
+  %RunMicrotasks();
+  assertEquals(2, result);
+  assertEquals(1, called);
+})();
+
+// Same in optimized code, where the value of the await is known to be a
+// native promise.
+(function TestAwaitOptimized() {
+  const log = [];
+  async function f(p) {
+    p.x;
+    log.push(await p);
+  }
+  function run(value) {
+    const p = Promise.resolve(value);
+    f(p);
+    p.then(() => log.push('then'));
+    %RunMicrotasks();
+  }
+  run(1);
+  run(2);
+  %OptimizeFunctionOnNextCall(f);
+  run(3);
+  assertEquals([1, 'then', 2, 'then', 3, 'then'], log);
+})();
@@ -0,0 +1,107 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --harmony-bigint
+
+// Operands large enough to take the sub-quadratic code paths (Karatsuba
+// multiplication, Burnikel-Ziegler division, divide-and-conquer toString
+// and parsing), checked against results computed in other ways.
+
+var seed = 1234;
+function random32() {
+  seed = (Math.imul(seed, 1103515245) + 12345) >>> 0;
+  return seed;
+}
+
+// Returns [value, hex string], building the value with shifts only.
+function randomBigInt(words) {
+  var value = 0n;
+  var hex = "";
+  for (var i = 0; i < words; i++) {
+    var word = random32();
+    if (i === 0 && word === 0) word = 1;
+    value = (value << 32n) | BigInt(word);
+    var s = word.toString(16);
+    hex += i === 0 ? s : "00000000".substring(s.length) + s;
+  }
+  return [value, hex];
+}
+
+// Schoolbook product, one 32-bit word of {y} at a time.
+function slowMultiply(x, y) {
+  var result = 0n;
+  for (var shift = 0n; y !== 0n; shift += 32n, y >>= 32n) {
+    result += (x * (y & 0xFFFFFFFFn)) << shift;
+  }
+  return result;
+}
+
+var [x, x_hex] = randomBigInt(400);
+var [y, y_hex] = randomBigInt(170);
+var [r] = randomBigInt(150);
+
+(function TestParseAndPrintHex() {
+  assertEquals(x_hex, x.toString(16));
+  assertEquals(x, BigInt("0x" + x_hex));
+  assertEquals(y, BigInt("0x" + y_hex));
+})();
+
+(function TestMultiply() {
+  var product = x * y;
+  assertEquals(slowMultiply(x, y), product);
+  assertEquals(slowMultiply(y, x), y * x);
+  assertEquals(-product, -x * y);
+  assertEquals(product, -x * -y);
+  assertEquals(x * x, slowMultiply(x, x));
+  // Unbalanced operands.
+  var [small] = randomBigInt(40);
+  assertEquals(slowMultiply(x, small), x * small);
+})();
+
+(function TestDivide() {
+  var product = x * y;
+  assertEquals(x, product / y);
+  assertEquals(y, product / x);
+  assertEquals(0n, product % y);
+  assertEquals(x, (product + r) / y);
+  assertEquals(r, (product + r) % y);
+  assertEquals(-x, (-product - r) / y);
+  assertEquals(-r, (-product - r) % y);
+  var q = x / y;
+  var m = x % y;
+  assertTrue(m < y);
+  assertEquals(x, q * y + m);
+})();
+
+(function TestToStringAndParse() {
+  var big = 10n ** 5000n;
+  assertEquals("1" + "0".repeat(5000), big.toString());
+  assertEquals(big, BigInt("1" + "0".repeat(5000)));
+  assertEquals("9".repeat(5000), (big - 1n).toString());
+  assertEquals(big - 1n, BigInt("9".repeat(5000)));
+  var values = [x, y, x * y, -x, x * y * x];
+  for (var radix of [3, 7, 10, 36]) {
+    for (var value of values) {
+      var s = value.toString(radix);
+      if (radix === 10) {
+        assertEquals(value, BigInt(s));
+      } else {
+        var negative = s[0] === "-";
+        var parsed = 0n;
+        var digits = negative ? s.substring(1) : s;
+        // Reparse in chunks of 8 characters for an independent check.
+        var chunk_factor = BigInt(radix) ** 8n;
+        var first = digits.length % 8;
+        if (first > 0) {
+          parsed = BigInt(parseInt(digits.substring(0, first), radix));
+        }
+        for (var i = first; i < digits.length; i += 8) {
+          parsed = parsed * chunk_factor +
+                   BigInt(parseInt(digits.substring(i, i + 8), radix));
+        }
+        assertEquals(value, negative ? -parsed : parsed);
+      }
+    }
+  }
+})();
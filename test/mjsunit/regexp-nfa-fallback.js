@@ -0,0 +1,73 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --regexp-nfa-on-excessive-backtracks
+// Flags: --regexp-backtracks-before-fallback=100
+
+// Regexps that backtrack too much are matched again on the NFA engine,
+// which must find the match the backtracking engine would have found.
+
+var s = "a".repeat(50);
+
+// These would take exponential time without the fallback.
+assertNull(/(a+)+$/.exec(s + "!"));
+assertNull(/^(a|aa)+$/.exec(s + "!"));
+assertNull(/^(\w+\s?)*$/.exec("a".repeat(30) + "!"));
+assertFalse(/^(([a-z])+.)+[A-Z]([a-z])+$/.test(s));
+assertEquals(s, /(a+)+b|a+/.exec(s)[0]);
+
+// Captures, alternation order and lazy quantifiers after the fallback.
+var m = /(a+)+(b|c)/.exec(s + "c");
+assertEquals(s + "c", m[0]);
+assertEquals(s, m[1]);
+assertEquals("c", m[2]);
+m = /(a|aa)+?(b)/.exec(s + "b");
+assertEquals(s + "b", m[0]);
+assertEquals("a", m[1]);
+m = /((a|aa)+)x|(a+)$/.exec(s);
+assertEquals([s, undefined, undefined, s], Array.from(m));
+m = /(?<all>(a|aa)+)!/.exec(s + "!");
+assertEquals(s, m.groups.all);
+assertEquals(s, RegExp.$1);
+assertEquals(s + "!", RegExp.lastMatch);
+
+// Global and sticky regexps.
+var subject = (s + "! ").repeat(3);
+assertEquals(3, subject.match(/(a|aa)+!/g).length);
+assertEquals("X X X ", subject.replace(/(a|aa)+!/g, "X"));
+assertEquals("X X X ", subject.replace(/(a|aa)+!/g, () => "X"));
+var re = /(a|aa)+!\s/y;
+assertEquals(s + "! ", re.exec(subject)[0]);
+assertEquals(s.length + 2, re.lastIndex);
+assertEquals(s + "! ", re.exec(subject)[0]);
+re.lastIndex = subject.length - 1;
+assertNull(re.exec(subject));
+assertEquals(0, re.lastIndex);
+assertNull(/(a|aa)+b/y.exec(s));
+
+// The limit applies to each match of a global regexp, not to all of them.
+// Every match backtracks a few dozen times, first over the failed attempts
+// in "bbbb!" and then to end the loop at ";".
+subject = "bbbb!bbb;".repeat(100);
+re = /(b|bb)+;/g;
+assertFalse(%RegExpHasNfaProgram(re));
+assertEquals(Array(100).fill("bbb;"), subject.match(re));
+assertEquals("bbbb!X".repeat(100), subject.replace(re, "X"));
+assertFalse(%RegExpHasNfaProgram(re));
+re = /(b|bb)+!/g;
+assertNull(("b".repeat(50) + ";").match(re));
+assertTrue(%RegExpHasNfaProgram(re));
+
+// Two-byte subjects.
+var t = "α".repeat(40);
+assertNull(/(α+)+$/.exec(t + "!"));
+assertEquals(t, /(α|αα)+/.exec(t)[0]);
+
+// Regexps that the NFA engine does not support keep backtracking.
+assertNull(/^(a+)+\1$/.exec("a".repeat(15) + "!"));
+assertNull(/^(a+)+$/i.exec("a".repeat(15) + "!"));
+
+// Regexps that do not backtrack much are unaffected.
+assertEquals(["abc", "b"], Array.from(/a(b)c/.exec("xabc")));
+assertEquals("a-b-c", "a b c".split(/\s+/).join("-"));
@@ -0,0 +1,97 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --regexp-nfa
+
+// Regexps without backreferences and lookarounds run on the NFA engine, and
+// must find the same matches as the backtracking engine.
+
+function test(re, subject, expected) {
+  assertEquals(expected, re.exec(subject), re + " on " + subject);
+}
+
+// Simple patterns and character classes.
+test(/abc/, "xxabcxx", ["abc"]);
+test(/a[bc]d/, "abd acd", ["abd"]);
+test(/[^a-c]+/, "abcdefabc", ["def"]);
+test(/\d+\.\d*/, "pi is 3.14159", ["3.14159"]);
+test(/\w+@\w+\.com/, "mail: foo@bar.com.", ["foo@bar.com"]);
+test(/\s\S/, "ab  cd", [" c"]);
+test(/a.c/, "a\nc abc", ["abc"]);
+test(/a.c/s, "a\nc abc", ["a\nc"]);
+test(/x/, "abc", null);
+
+// Alternatives are tried in order.
+test(/a|ab/, "abc", ["a"]);
+test(/ab|a/, "abc", ["ab"]);
+test(/(a|ab)(c|bcd)/, "abcd", ["abcd", "a", "bcd"]);
+
+// Greedy and lazy quantifiers.
+test(/a*/, "aaab", ["aaa"]);
+test(/a*?/, "aaab", [""]);
+test(/a+?b/, "aaab", ["aaab"]);
+test(/<.*>/, "<a><b>", ["<a><b>"]);
+test(/<.*?>/, "<a><b>", ["<a>"]);
+test(/a{2,3}/, "aaaa", ["aaa"]);
+test(/a{2,3}?/, "aaaa", ["aa"]);
+test(/a{2}/, "abaab", ["aa"]);
+test(/(ab){2,}/, "abababx", ["ababab", "ab"]);
+test(/x(ab)?y/, "xy", ["xy", undefined]);
+
+// Captures are reset on each iteration of a quantifier.
+test(/(?:(a)|b)+/, "ab", ["ab", undefined]);
+test(/(?:(a)|(b))+/, "ab", ["ab", undefined, "b"]);
+test(/((a)|(b))*c/, "abac", ["abac", "a", "a", undefined]);
+test(/(z)((a+)?(b+)?(c))*/, "zaacbbbcac",
+     ["zaacbbbcac", "z", "ac", "a", undefined, "c"]);
+
+// Named captures.
+var m = /(?<year>\d{4})-(?<month>\d{2})/.exec("on 2018-10-01");
+assertEquals("2018", m.groups.year);
+assertEquals("10", m.groups.month);
+assertEquals("10/2018", "2018-10".replace(/(?<y>\d+)-(?<m>\d+)/, "$<m>/$<y>"));
+
+// Assertions.
+test(/^abc$/, "abc", ["abc"]);
+test(/^b/, "ab", null);
+test(/^b/m, "a\nb", ["b"]);
+test(/a$/m, "a\nb", ["a"]);
+test(/\bfoo\b/, "foobar foo", ["foo"]);
+test(/\Boo\B/, "foo fooo", ["oo"]);
+
+// Global and sticky regexps.
+assertEquals(["a1", "a2", "a3"], "a1 a2 a3".match(/a\d/g));
+assertEquals(["", "", ""], "ab".match(/x*/g));
+assertEquals("-a-b-", "ab".replace(/x*/g, "-"));
+assertEquals(["a", "b", "c"], "a,b,c".split(/,/));
+var re = /a/y;
+assertEquals(["a"], re.exec("aab"));
+assertEquals(["a"], re.exec("aab"));
+assertEquals(null, re.exec("aab"));
+assertEquals(0, re.lastIndex);
+re = /\d/g;
+re.lastIndex = 2;
+assertEquals(["3"], re.exec("1a3"));
+assertEquals(3, re.lastIndex);
+assertEquals(["1", "22", "333"], "x1y22z333".match(/\d+/g));
+
+// Two-byte subjects.
+test(/α+/, "xxααy", ["αα"]);
+test(/[Ā-ǿ]/, "abcģ", ["ģ"]);
+
+// Patterns that take exponential time with backtracking.
+var s = "a".repeat(40);
+test(/(a+)+$/, s + "!", null);
+test(/^(a|a)*$/, s + "!", null);
+test(/(a|aa)+b/, s, null);
+test(/^(\w+\s?)*$/, "an example sentence that does not match!", null);
+test(/(a+)+$/, s, [s, s]);
+
+// Regexps the NFA engine does not support still work.
+test(/(a)\1/, "aa", ["aa", "a"]);
+test(/a(?=b)/, "acab", ["a"]);
+test(/(?<=a)b/, "bab", ["b"]);
+test(/ABC/i, "xabc", ["abc"]);
+test(/\u{1F600}/u, "\u{1F600}", ["\u{1F600}"]);
+test(/(a*)*b/, "aab", ["aab", "aa"]);
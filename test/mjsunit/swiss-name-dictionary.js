@@ -0,0 +1,101 @@
+// Copyright 2018 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax --swiss-name-dictionary
+
+// Large property dictionaries use linear probing with a control table. Test
+// the lookups, insertions and deletions done by the runtime, the ICs and the
+// builtins on them.
+
+const kCount = 500;
+
+function MakeMap(count) {
+  var map = {};
+  for (var i = 0; i < count; i++) map["key" + i] = i;
+  assertFalse(%HasFastProperties(map));
+  return map;
+}
+
+function Load(map, key) {
+  return map[key];
+}
+
+function Store(map, key, value) {
+  map[key] = value;
+}
+
+function Has(map, key) {
+  return key in map;
+}
+
+(function TestLookup() {
+  var map = MakeMap(kCount);
+  for (var i = 0; i < kCount; i++) {
+    assertEquals(i, Load(map, "key" + i));
+    assertTrue(Has(map, "key" + i));
+    assertFalse(Has(map, "other" + i));
+    assertEquals(undefined, Load(map, "other" + i));
+  }
+  assertEquals(kCount, Object.keys(map).length);
+})();
+
+(function TestDeleteAndReAdd() {
+  var map = MakeMap(kCount);
+  for (var i = 0; i < kCount; i += 3) delete map["key" + i];
+  for (var i = 0; i < kCount; i++) {
+    assertEquals(i % 3 != 0, Has(map, "key" + i));
+  }
+  // Reuse the deleted entries.
+  for (var i = 0; i < kCount; i += 3) Store(map, "key" + i, -i);
+  for (var i = 0; i < kCount; i++) {
+    assertEquals(i % 3 == 0 ? -i : i, Load(map, "key" + i));
+  }
+  // Many deletions and insertions force in-place rehashing.
+  for (var round = 0; round < 10; round++) {
+    for (var i = 0; i < kCount; i += 2) delete map["key" + i];
+    for (var i = 0; i < kCount; i += 2) Store(map, "key" + i, round);
+  }
+  for (var i = 0; i < kCount; i++) {
+    assertEquals(i % 2 == 0 ? 9 : (i % 3 == 0 ? -i : i), Load(map, "key" + i));
+  }
+  var keys = Object.keys(map);
+  assertEquals(kCount, keys.length);
+})();
+
+(function TestShrinkAndGrow() {
+  var map = MakeMap(kCount);
+  for (var i = 10; i < kCount; i++) delete map["key" + i];
+  assertEquals(["key0", "key1", "key2", "key3", "key4", "key5", "key6", "key7",
+                "key8", "key9"], Object.keys(map));
+  for (var i = 10; i < kCount; i++) Store(map, "key" + i, i);
+  for (var i = 0; i < kCount; i++) assertEquals(i, Load(map, "key" + i));
+})();
+
+(function TestSymbolsAndPrivateSymbols() {
+  var map = MakeMap(kCount);
+  var symbols = [];
+  for (var i = 0; i < 100; i++) {
+    var symbol = Symbol("symbol" + i);
+    symbols.push(symbol);
+    Store(map, symbol, i);
+  }
+  for (var i = 0; i < 100; i++) assertEquals(i, Load(map, symbols[i]));
+  assertEquals(100, Object.getOwnPropertySymbols(map).length);
+})();
+
+(function TestBoilerplateCopies() {
+  // Object literals with dictionary-mode boilerplates are copied from the
+  // boilerplate, copies must not share the control table.
+  var source = "(function() { return {";
+  for (var i = 0; i < 200; i++) source += "p" + i + ": " + i + ", ";
+  source += "__proto__: null}; })";
+  var create = eval(source);
+  var objects = [];
+  for (var n = 0; n < 5; n++) objects.push(create());
+  for (var i = 0; i < 200; i += 2) delete objects[0]["p" + i];
+  for (var i = 0; i < 200; i++) {
+    assertEquals(i % 2 != 0, Has(objects[0], "p" + i));
+    for (var n = 1; n < 5; n++) assertEquals(i, Load(objects[n], "p" + i));
+  }
+})();
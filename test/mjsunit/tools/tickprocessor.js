@@ -30,6 +30,7 @@
 // Files: tools/consarray.js tools/profile.js tools/profile_view.js
 // Files: tools/logreader.js tools/arguments.js tools/tickprocessor.js
 // Resources: test/mjsunit/tools/tickprocessor-test-func-info.log
+// Resources: test/mjsunit/tools/tickprocessor-test.binary-log
 // Resources: test/mjsunit/tools/tickprocessor-test.default
 // Resources: test/mjsunit/tools/tickprocessor-test.func-info
 // Resources: test/mjsunit/tools/tickprocessor-test.gc-state
@@ -69,6 +70,12 @@
   assertEquals('mn', p_nmAndLog.result().nm);
   assertEquals('nmlog.log', p_nmAndLog.result().logFileName);
 
+  var p_binaryLog = new ArgumentsProcessor(['--binary-log', 'binary.log']);
+  assertTrue(p_binaryLog.parse());
+  assertTrue(p_binaryLog.result().binaryLog);
+  assertEquals('binary.log', p_binaryLog.result().logFileName);
+  assertFalse(p_default.result().binaryLog);
+
   var p_bad = new ArgumentsProcessor(['--unknown', 'badlog.log']);
   assertFalse(p_bad.parse());
 })();
@@ -389,9 +396,7 @@ PrintMonitor.prototype.finish = function() {
 };
 
 
-function driveTickProcessorTest(
-    separateIc, separateBytecodes, separateBuiltins, separateStubs,
-    ignoreUnknown, stateFilter, logInput, refOutput, onlySummary) {
+function getTestsPath() {
   // TEST_FILE_NAME must be provided by test runner.
   assertEquals('string', typeof TEST_FILE_NAME);
   var pathLen = TEST_FILE_NAME.lastIndexOf('/');
@@ -399,7 +404,41 @@ function driveTickProcessorTest(
     pathLen = TEST_FILE_NAME.lastIndexOf('\\');
   }
   assertTrue(pathLen != -1);
-  var testsPath = TEST_FILE_NAME.substr(0, pathLen + 1);
+  return TEST_FILE_NAME.substr(0, pathLen + 1);
+};
+
+
+(function testBinaryLogDecoder() {
+  // The binary log was recorded from the same lines as the text log.
+  var testsPath = getTestsPath();
+  var buffer = readbuffer(testsPath + 'tickprocessor-test.binary-log');
+  assertTrue(BinaryLogDecoder.isBinaryLog(buffer));
+  var decoder = new BinaryLogDecoder(buffer);
+  var lines = [];
+  var line;
+  while ((line = decoder.nextLine()) !== null) {
+    lines.push(line);
+  }
+  var expected = readFile(testsPath + 'tickprocessor-test.log').split('\n');
+  assertEquals('', expected.pop());
+  assertEquals(expected, lines);
+
+  // A truncated last record is dropped.
+  var truncated = new BinaryLogDecoder(buffer.slice(0, buffer.byteLength - 1));
+  var count = 0;
+  while (truncated.nextLine() !== null) count++;
+  assertEquals(expected.length - 1, count);
+
+  var text = readbuffer(testsPath + 'tickprocessor-test.log');
+  assertFalse(BinaryLogDecoder.isBinaryLog(text));
+  assertThrows(function() { new BinaryLogDecoder(text); });
+})();
+
+
+function driveTickProcessorTest(
+    separateIc, separateBytecodes, separateBuiltins, separateStubs,
+    ignoreUnknown, stateFilter, logInput, refOutput, onlySummary) {
+  var testsPath = getTestsPath();
   var tp = new TickProcessor(new CppEntriesProviderMock(),
                              separateIc,
                              separateBytecodes,
@@ -415,7 +454,11 @@ function driveTickProcessorTest(
                              false,
                              onlySummary);
   var pm = new PrintMonitor(testsPath + refOutput);
-  tp.processLogFileInTest(testsPath + logInput);
+  if (logInput.endsWith('.binary-log')) {
+    tp.processBinaryLogFileInTest(testsPath + logInput);
+  } else {
+    tp.processLogFileInTest(testsPath + logInput);
+  }
   tp.printStatistics();
   pm.finish();
 };
@@ -441,7 +484,10 @@ function driveTickProcessorTest(
       false],
     'OnlySummary': [
       false, false, true, true, false, null,
-      'tickprocessor-test.log', 'tickprocessor-test.only-summary', true]
+      'tickprocessor-test.log', 'tickprocessor-test.only-summary', true],
+    'BinaryLog': [
+      false, false, true, true, false, null,
+      'tickprocessor-test.binary-log', 'tickprocessor-test.default', false]
   };
   for (var testName in testData) {
     print('=== testProcessing-' + testName + ' ===');
@@ -83,5 +83,46 @@ TEST_F(ThreadLocalStorageTest, DoTest) {
   Join();
 }
 
+namespace {
+
+int destructed_value = 0;
+
+void DestructValue(void* value) {
+  CHECK_EQ(0, destructed_value);
+  destructed_value = *static_cast<int*>(value);
+}
+
+class ThreadLocalDestructorThread : public Thread {
+ public:
+  explicit ThreadLocalDestructorThread(Thread::LocalStorageKey key)
+      : Thread(Options("ThreadLocalDestructorThread")), key_(key) {}
+
+  void Run() final {
+    Thread::SetThreadLocal(key_, &value_);
+    CHECK_EQ(&value_, Thread::GetThreadLocal(key_));
+  }
+
+ private:
+  Thread::LocalStorageKey key_;
+  int value_ = 42;
+};
+
+}  // namespace
+
+TEST(ThreadLocalStorage, DestructorOnThreadExit) {
+  Thread::LocalStorageKey key = Thread::CreateThreadLocalKey(DestructValue);
+  CHECK(!Thread::HasThreadLocal(key));
+  ThreadLocalDestructorThread thread(key);
+  thread.Start();
+  thread.Join();
+  CHECK_EQ(42, destructed_value);
+  // Not called for threads that reset the value.
+  int value = 7;
+  Thread::SetThreadLocal(key, &value);
+  Thread::SetThreadLocal(key, nullptr);
+  Thread::DeleteThreadLocalKey(key);
+  CHECK_EQ(42, destructed_value);
+}
+
 }  // namespace base
 }  // namespace v8
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
+#include <map>
+#include <string>
 #include <vector>
 
 #include "src/api-inl.h"
@@ -765,5 +768,112 @@ TEST_F(RuntimeCallStatsTest, ApiGetter) {
   PrintStats();
 }
 
+class HotPathCountersTest : public TestWithNativeContext {
+ public:
+  HotPathCountersTest() {
+    FLAG_hot_path_counters = true;
+    counters_.clear();
+    max_counters_ = std::numeric_limits<size_t>::max();
+    v8_isolate()->SetCounterFunction(LookupCounter);
+  }
+
+  ~HotPathCountersTest() { v8_isolate()->SetCounterFunction(nullptr); }
+
+  HotPathCounters* hot_path_counters() {
+    return isolate()->counters()->hot_path_counters();
+  }
+
+  SharedFunctionInfo* Shared(const char* source) {
+    return RunJS<JSFunction>(source)->shared();
+  }
+
+  // Sums up the counters whose names start with {prefix}.
+  int Sum(const std::string& prefix) {
+    int sum = 0;
+    for (auto& counter : counters_) {
+      if (counter.first.compare(0, prefix.size(), prefix) == 0) {
+        sum += counter.second;
+      }
+    }
+    return sum;
+  }
+
+  // Makes the counter function fail once {count} more counters are used.
+  void LimitCounters(size_t count) { max_counters_ = counters_.size() + count; }
+
+ private:
+  static int* LookupCounter(const char* name) {
+    if (counters_.count(name) == 0 && counters_.size() >= max_counters_) {
+      return nullptr;
+    }
+    return &counters_[name];
+  }
+
+  static std::map<std::string, int> counters_;
+  static size_t max_counters_;
+  SaveFlags save_flags_;
+};
+
+std::map<std::string, int> HotPathCountersTest::counters_;
+size_t HotPathCountersTest::max_counters_;
+
+TEST_F(HotPathCountersTest, InterpreterTicks) {
+  SharedFunctionInfo* f = Shared("(function f() {})");
+  SharedFunctionInfo* g = Shared("(function g() {})");
+  hot_path_counters()->CountInterpreterTick(f);
+  hot_path_counters()->CountInterpreterTick(f);
+  hot_path_counters()->CountInterpreterTick(g);
+  EXPECT_EQ(2, Sum("c:V8.InterpreterTicks:f@"));
+  EXPECT_EQ(1, Sum("c:V8.InterpreterTicks:g@"));
+  EXPECT_EQ(0, Sum("c:V8.HotPathCountersDropped"));
+}
+
+TEST_F(HotPathCountersTest, ICMisses) {
+  RunJS(
+      "function load(o) { return o.x; }"
+      "load({x: 1}); load({y: 1, x: 2}); load({z: 1, x: 3});");
+  EXPECT_LE(1, Sum("c:V8.ICMisses:load@"));
+
+  SharedFunctionInfo* load = Shared("load");
+  int misses = Sum("c:V8.ICMisses:load@");
+  hot_path_counters()->CountICMiss(load, 0);
+  EXPECT_EQ(misses + 1, Sum("c:V8.ICMisses:load@"));
+}
+
+TEST_F(HotPathCountersTest, Deopts) {
+  hot_path_counters()->CountDeopt(DeoptimizeReason::kNotASmi);
+  hot_path_counters()->CountDeopt(DeoptimizeReason::kNotASmi);
+  hot_path_counters()->CountDeopt(DeoptimizeReason::kHole);
+  EXPECT_EQ(2, Sum("c:V8.Deopts:NotASmi"));
+  EXPECT_EQ(1, Sum("c:V8.Deopts:Hole"));
+}
+
+TEST_F(HotPathCountersTest, Dropped) {
+  FLAG_hot_path_counters_max = 1;
+  SharedFunctionInfo* f = Shared("(function f() {})");
+  SharedFunctionInfo* g = Shared("(function g() {})");
+  hot_path_counters()->CountInterpreterTick(f);
+  hot_path_counters()->CountInterpreterTick(g);
+  hot_path_counters()->CountInterpreterTick(g);
+  EXPECT_EQ(1, Sum("c:V8.InterpreterTicks:f@"));
+  EXPECT_EQ(0, Sum("c:V8.InterpreterTicks:g@"));
+  EXPECT_EQ(2, Sum("c:V8.HotPathCountersDropped"));
+}
+
+TEST_F(HotPathCountersTest, EmbedderOutOfCounters) {
+  SharedFunctionInfo* f = Shared("(function f() {})");
+  SharedFunctionInfo* g = Shared("(function g() {})");
+  // Room for the dropped counter and the one of {f}.
+  LimitCounters(2);
+  hot_path_counters()->CountInterpreterTick(f);
+  hot_path_counters()->CountInterpreterTick(g);
+  hot_path_counters()->CountInterpreterTick(g);
+  hot_path_counters()->CountDeopt(DeoptimizeReason::kHole);
+  EXPECT_EQ(1, Sum("c:V8.InterpreterTicks:f@"));
+  EXPECT_EQ(0, Sum("c:V8.InterpreterTicks:g@"));
+  EXPECT_EQ(0, Sum("c:V8.Deopts:"));
+  EXPECT_EQ(3, Sum("c:V8.HotPathCountersDropped"));
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -108,5 +108,19 @@ TEST_F(StringsStorageWithIsolate, FormatAndGetShareStorage) {
   CHECK_EQ(stored_str, formatted_str);
 }
 
+TEST_F(StringsStorageWithIsolate, UsedMemorySize) {
+  StringsStorage storage;
+  size_t table_size = storage.GetUsedMemorySize();
+
+  storage.GetCopy("xy");
+  CHECK_EQ(table_size + 3, storage.GetUsedMemorySize());
+  // Formatted strings take no more than their length.
+  storage.GetFormatted("%s / %s", "xy", "xy");
+  CHECK_EQ(table_size + 3 + 8, storage.GetUsedMemorySize());
+  // Stored strings are not counted again.
+  storage.GetFormatted("%s", "xy");
+  CHECK_EQ(table_size + 3 + 8, storage.GetUsedMemorySize());
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -2,7 +2,11 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
+#include "src/base/platform/platform.h"
 #include "src/zone/accounting-allocator.h"
+#include "src/zone/zone.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace v8 {
@@ -22,11 +26,119 @@ TEST(Zone, SegmentPoolConstraints) {
     for (size_t power = 0; power < AccountingAllocator::kNumberBuckets;
          ++power) {
       total_size +=
-          allocator.unused_segments_max_sizes_[power] * (size_t(1) << power);
+          allocator.unused_segments_max_sizes_[power] *
+          (size_t(1) << (power + AccountingAllocator::kMinSegmentSizePower));
     }
     EXPECT_LE(total_size, size);
   }
 }
 
+TEST(Zone, SegmentPoolReuse) {
+  AccountingAllocator allocator;
+  Segment* segment = allocator.GetSegment(16 * KB);
+  ASSERT_NE(nullptr, segment);
+  allocator.ReturnSegment(segment);
+  EXPECT_EQ(16 * KB, allocator.GetCurrentPoolSize());
+
+  // A smaller request is served by the pooled segment.
+  EXPECT_EQ(segment, allocator.GetSegment(12 * KB));
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  allocator.ReturnSegment(segment);
+
+  // Segments that are not a power of two in size are not pooled.
+  Segment* odd_segment = allocator.GetSegment(20 * KB);
+  allocator.ReturnSegment(odd_segment);
+  EXPECT_EQ(16 * KB, allocator.GetCurrentPoolSize());
+}
+
+TEST(Zone, SegmentPoolLimit) {
+  AccountingAllocator allocator;
+  allocator.ConfigureSegmentPool(0);
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+
+  allocator.ConfigureSegmentPool(8 * KB);
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  EXPECT_EQ(8 * KB, allocator.GetCurrentPoolSize());
+}
+
+TEST(Zone, SegmentPoolMemoryPressure) {
+  AccountingAllocator allocator;
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  allocator.ReturnSegment(allocator.GetSegment(64 * KB));
+  EXPECT_EQ(72 * KB, allocator.GetCurrentPoolSize());
+
+  allocator.MemoryPressureNotification(MemoryPressureLevel::kCritical);
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  EXPECT_EQ(0u, allocator.GetCurrentPoolSize());
+
+  allocator.MemoryPressureNotification(MemoryPressureLevel::kNone);
+  allocator.ReturnSegment(allocator.GetSegment(8 * KB));
+  EXPECT_EQ(8 * KB, allocator.GetCurrentPoolSize());
+}
+
+TEST(Zone, ZoneSegmentsArePooled) {
+  AccountingAllocator allocator;
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    for (int i = 0; i < 1000; i++) zone.New(100);
+  }
+  size_t pooled = allocator.GetCurrentPoolSize();
+  EXPECT_LT(0u, pooled);
+  size_t memory_usage = allocator.GetCurrentMemoryUsage();
+  {
+    // The second zone is built entirely from pooled segments.
+    Zone zone(&allocator, ZONE_NAME);
+    for (int i = 0; i < 1000; i++) zone.New(100);
+    EXPECT_EQ(memory_usage, allocator.GetCurrentMemoryUsage());
+  }
+  EXPECT_EQ(pooled, allocator.GetCurrentPoolSize());
+}
+
+namespace {
+
+class ZoneThread final : public base::Thread {
+ public:
+  explicit ZoneThread(AccountingAllocator* allocator)
+      : base::Thread(base::Thread::Options("ZoneThread")),
+        allocator_(allocator) {}
+
+  void Run() override {
+    for (int i = 0; i < 100; i++) {
+      Zone zone(allocator_, ZONE_NAME);
+      for (int j = 0; j < 500; j++) zone.New(128 + j);
+    }
+  }
+
+ private:
+  AccountingAllocator* allocator_;
+};
+
+}  // namespace
+
+TEST(Zone, SegmentPoolSharding) {
+  AccountingAllocator allocator;
+  std::vector<std::unique_ptr<ZoneThread>> threads;
+  for (size_t i = 0; i < 2 * AccountingAllocator::kNumberShards; i++) {
+    threads.emplace_back(new ZoneThread(&allocator));
+  }
+  for (auto& thread : threads) thread->Start();
+  for (auto& thread : threads) thread->Join();
+
+  // Every segment is either pooled or freed, and the pool respects its
+  // limits no matter how the segments are spread over the shards.
+  EXPECT_EQ(allocator.GetCurrentPoolSize(), allocator.GetCurrentMemoryUsage());
+  size_t max_pool_size = AccountingAllocator::kMaxPoolSize;
+  EXPECT_LE(allocator.GetCurrentPoolSize(), max_pool_size);
+  for (size_t power = 0; power < AccountingAllocator::kNumberBuckets;
+       ++power) {
+    EXPECT_LE(allocator.unused_segments_sizes_[power],
+              allocator.unused_segments_max_sizes_[power]);
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -136,6 +136,20 @@ LogReader.prototype.processLogLine = function(line) {
 };
 
 
+/**
+ * Processes a log written with --log-binary.
+ *
+ * @param {ArrayBuffer} buffer The contents of the log file.
+ */
+LogReader.prototype.processBinaryLog = function(buffer) {
+  var decoder = new BinaryLogDecoder(buffer);
+  var line;
+  while ((line = decoder.nextLine()) !== null) {
+    this.processLogLine(line);
+  }
+};
+
+
 /**
  * Processes stack record.
  *
@@ -246,3 +260,150 @@ LogReader.prototype.processLogLine_ = function(line) {
   }
   this.lineNum_++;
 };
+
+
+/**
+ * Decodes a log written with --log-binary into the lines of the text log.
+ * See BinaryLogStreamBuffer in src/log-utils.h for the format.
+ *
+ * @param {ArrayBuffer} buffer The contents of the log file.
+ * @constructor
+ */
+function BinaryLogDecoder(buffer) {
+  if (!BinaryLogDecoder.isBinaryLog(buffer)) {
+    throw new Error('Not a binary V8 log');
+  }
+  this.bytes_ = new Uint8Array(buffer);
+  this.pos_ = BinaryLogDecoder.MAGIC.length;
+  var version = this.readVarint_();
+  if (version != BinaryLogDecoder.VERSION) {
+    throw new Error('Unsupported binary log version ' + version);
+  }
+  this.strings_ = [];
+  this.previousAddress_ = 0;
+};
+
+
+BinaryLogDecoder.MAGIC = 'V8LB';
+BinaryLogDecoder.VERSION = 1;
+
+
+/**
+ * The tags of the fields, see BinaryLogStreamBuffer::FieldTag.
+ * @enum {number}
+ */
+BinaryLogDecoder.Tag = {
+  END_OF_RECORD: 0,
+  NEW_STRING: 1,
+  STRING: 2,
+  LITERAL_STRING: 3,
+  INTEGER: 4,
+  ADDRESS: 5
+};
+
+
+/**
+ * Returns whether the log in the buffer was written with --log-binary.
+ *
+ * @param {ArrayBuffer} buffer The contents of the log file.
+ * @return {boolean}
+ */
+BinaryLogDecoder.isBinaryLog = function(buffer) {
+  var magic = BinaryLogDecoder.MAGIC;
+  if (buffer.byteLength < magic.length) return false;
+  var bytes = new Uint8Array(buffer, 0, magic.length);
+  for (var i = 0; i < magic.length; i++) {
+    if (bytes[i] != magic.charCodeAt(i)) return false;
+  }
+  return true;
+};
+
+
+/**
+ * Returns the next line of the text log, or null at the end of the log.
+ * A truncated last record is dropped.
+ *
+ * @return {?string}
+ */
+BinaryLogDecoder.prototype.nextLine = function() {
+  var Tag = BinaryLogDecoder.Tag;
+  var fields = [];
+  while (this.pos_ < this.bytes_.length) {
+    var tag = this.bytes_[this.pos_++];
+    switch (tag) {
+      case Tag.END_OF_RECORD:
+        return fields.join(',');
+      case Tag.NEW_STRING:
+        var string = this.readString_();
+        this.strings_.push(string);
+        fields.push(string);
+        break;
+      case Tag.STRING:
+        fields.push(this.strings_[this.readVarint_()]);
+        break;
+      case Tag.LITERAL_STRING:
+        fields.push(this.readString_());
+        break;
+      case Tag.INTEGER:
+        fields.push(String(this.readZigZag_()));
+        break;
+      case Tag.ADDRESS:
+        this.previousAddress_ += this.readZigZag_();
+        fields.push('0x' + this.previousAddress_.toString(16));
+        break;
+      default:
+        throw new Error('Invalid field tag ' + tag + ' at ' + (this.pos_ - 1));
+    }
+  }
+  return null;
+};
+
+
+/**
+ * Reads an unsigned LEB128 value. Values up to 2^53 are exact.
+ *
+ * @return {number}
+ * @private
+ */
+BinaryLogDecoder.prototype.readVarint_ = function() {
+  var result = 0;
+  var multiplier = 1;
+  var byte;
+  do {
+    byte = this.bytes_[this.pos_++];
+    result += (byte & 0x7f) * multiplier;
+    multiplier *= 128;
+  } while (byte & 0x80);
+  return result;
+};
+
+
+/**
+ * @return {number}
+ * @private
+ */
+BinaryLogDecoder.prototype.readZigZag_ = function() {
+  var value = this.readVarint_();
+  return value % 2 ? -(value + 1) / 2 : value / 2;
+};
+
+
+/**
+ * The logged strings are escaped to printable ASCII.
+ *
+ * @return {string}
+ * @private
+ */
+BinaryLogDecoder.prototype.readString_ = function() {
+  var length = this.readVarint_();
+  var end = this.pos_ + length;
+  var result = '';
+  // Convert in chunks to stay below the argument count limit of apply().
+  var kChunkSize = 4096;
+  for (var start = this.pos_; start < end; start += kChunkSize) {
+    var chunk = this.bytes_.subarray(start, Math.min(start + kChunkSize, end));
+    result += String.fromCharCode.apply(null, chunk);
+  }
+  this.pos_ = end;
+  return result;
+};
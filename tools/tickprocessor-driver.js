@@ -78,5 +78,9 @@ var tickProcessor = new TickProcessor(
   params.onlySummary,
   params.runtimeTimerFilter,
   params.preprocessJson);
-tickProcessor.processLogFile(params.logFileName);
+if (params.binaryLog) {
+  tickProcessor.processBinaryLogFile(params.logFileName);
+} else {
+  tickProcessor.processLogFile(params.logFileName);
+}
 tickProcessor.printStatistics();
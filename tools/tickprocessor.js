@@ -274,6 +274,12 @@ TickProcessor.prototype.processLogFile = function(fileName) {
 };
 
 
+TickProcessor.prototype.processBinaryLogFile = function(fileName) {
+  this.lastLogFileName_ = fileName;
+  this.processBinaryLog(readbuffer(fileName));
+};
+
+
 TickProcessor.prototype.processLogFileInTest = function(fileName) {
    // Hack file name to avoid dealing with platform specifics.
   this.lastLogFileName_ = 'v8.log';
@@ -282,6 +288,13 @@ TickProcessor.prototype.processLogFileInTest = function(fileName) {
 };
 
 
+TickProcessor.prototype.processBinaryLogFileInTest = function(fileName) {
+  // Hack file name to avoid dealing with platform specifics.
+  this.lastLogFileName_ = 'v8.log';
+  this.processBinaryLog(readbuffer(fileName));
+};
+
+
 TickProcessor.prototype.processSharedLibrary = function(
     name, startAddr, endAddr, aslrSlide) {
   var entry = this.profile_.addLibrary(name, startAddr, endAddr, aslrSlide);
@@ -895,7 +908,9 @@ class ArgumentsProcessor extends BaseArgumentsProcessor {
       '--only-summary': ['onlySummary', true,
           'Print only tick summary, exclude other information'],
       '--preprocess': ['preprocessJson', true,
-          'Preprocess for consumption with web interface']
+          'Preprocess for consumption with web interface'],
+      '--binary-log': ['binaryLog', true,
+          'Read a log file written with --log-binary']
     };
     dispatch['--js'] = dispatch['-j'];
     dispatch['--gc'] = dispatch['-g'];
@@ -926,6 +941,7 @@ class ArgumentsProcessor extends BaseArgumentsProcessor {
       pairwiseTimedRange: false,
       onlySummary: false,
       runtimeTimerFilter: null,
+      binaryLog: false,
     };
   }
 }